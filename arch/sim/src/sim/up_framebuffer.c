@@ -42,9 +42,11 @@
 #include <stdint.h>
 #include <string.h>
 #include <errno.h>
+#include <syslog.h>
 #include <debug.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/nx/nx.h>
 #include <nuttx/nx/nxglib.h>
@@ -90,6 +92,34 @@
 #define FB_WIDTH ((CONFIG_SIM_FBWIDTH * CONFIG_SIM_FBBPP + 7) / 8)
 #define FB_SIZE  (FB_WIDTH * CONFIG_SIM_FBHEIGHT)
 
+/* Raster benchmark */
+
+#ifdef CONFIG_SIM_FBBENCH
+#  ifndef CONFIG_SIM_FBBENCH_NFRAMES
+#    define CONFIG_SIM_FBBENCH_NFRAMES 100
+#  endif
+
+#  define FBBENCH_NPIXELS \
+     ((uint64_t)CONFIG_SIM_FBWIDTH * CONFIG_SIM_FBHEIGHT * \
+      CONFIG_SIM_FBBENCH_NFRAMES)
+
+#  define _FBBENCH_FUNC(a,b)  a ## _ ## b ## bpp
+#  define FBBENCH_FUNC(a,b)   _FBBENCH_FUNC(a,b)
+#  define FBBENCH_OP(op)      FBBENCH_FUNC(op, CONFIG_SIM_FBBPP)
+
+#  if CONFIG_SIM_FBBPP <= 8
+#    define FBBENCH_PIXEL_T   uint8_t
+#  elif CONFIG_SIM_FBBPP == 16
+#    define FBBENCH_PIXEL_T   uint16_t
+#  else
+#    define FBBENCH_PIXEL_T   uint32_t
+#  endif
+
+#  if defined(CONFIG_NX_ALPHABLEND) && CONFIG_SIM_FBBPP >= 16
+#    define FBBENCH_BLEND 1
+#  endif
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -124,6 +154,34 @@ static int up_setcursor(FAR struct fb_vtable_s *vtable,
                         FAR struct fb_setcursor_s *settings);
 #endif
 
+#ifdef CONFIG_SIM_FBBENCH
+/* The benchmark drives the nxglib framebuffer rasterizers directly.  Their
+ * prototypes live in graphics/nxglib/nxglib.h which is not visible here.
+ */
+
+void FBBENCH_OP(nxgl_fillrectangle)(FAR struct fb_planeinfo_s *pinfo,
+                                    FAR const struct nxgl_rect_s *rect,
+                                    FBBENCH_PIXEL_T color);
+void FBBENCH_OP(nxgl_moverectangle)(FAR struct fb_planeinfo_s *pinfo,
+                                    FAR const struct nxgl_rect_s *rect,
+                                    FAR struct nxgl_point_s *offset);
+void FBBENCH_OP(nxgl_copyrectangle)(FAR struct fb_planeinfo_s *pinfo,
+                                    FAR const struct nxgl_rect_s *dest,
+                                    FAR const void *src,
+                                    FAR const struct nxgl_point_s *origin,
+                                    unsigned int srcstride);
+#ifdef FBBENCH_BLEND
+void FBBENCH_OP(nxgl_blendrectangle)(FAR struct fb_planeinfo_s *pinfo,
+                                     FAR const struct nxgl_rect_s *rect,
+                                     FBBENCH_PIXEL_T color, uint8_t alpha);
+void FBBENCH_OP(nxgl_blendbitmap)(FAR struct fb_planeinfo_s *pinfo,
+                                  FAR const struct nxgl_rect_s *dest,
+                                  FAR const void *src,
+                                  FAR const struct nxgl_point_s *origin,
+                                  unsigned int srcstride, uint8_t alpha);
+#endif
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -375,6 +433,135 @@ static void up_updatework(FAR void *arg)
 }
 #endif
 
+/****************************************************************************
+ * Name: up_fbbench_report
+ *
+ * Description:
+ *   Report the throughput of one raster operation in Mpixels/second.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_FBBENCH
+static void up_fbbench_report(FAR const char *name, uint64_t start)
+{
+  uint64_t elapsed = host_gettime(false) - start;
+  uint64_t rate;
+
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  /* Pixels per nanosecond * 1000 is Mpixels per second; keep one decimal */
+
+  rate = FBBENCH_NPIXELS * 10000 / elapsed;
+  syslog(LOG_INFO, "fbbench: %-10s %5u.%u Mpix/s\n", name,
+         (unsigned int)(rate / 10), (unsigned int)(rate % 10));
+}
+
+/****************************************************************************
+ * Name: up_fbbench
+ *
+ * Description:
+ *   Time full-screen fills, copies and moves (and blends, if enabled)
+ *   through the same nxglib rasterizers that NX uses on this framebuffer.
+ *   The results are reported to the system log.  The framebuffer contents
+ *   are overwritten.  This is run on request by the board logic, never at
+ *   initialization.
+ *
+ ****************************************************************************/
+
+int up_fbbench(void)
+{
+  struct fb_planeinfo_s pinfo;
+  struct nxgl_rect_s rect;
+  struct nxgl_rect_s srect;
+  struct nxgl_point_s origin;
+  struct nxgl_point_s offset;
+  FAR uint8_t *bitmap;
+  uint64_t start;
+  int i;
+
+  memcpy(&pinfo, &g_planeinfo, sizeof(struct fb_planeinfo_s));
+
+  rect.pt1.x = 0;
+  rect.pt1.y = 0;
+  rect.pt2.x = CONFIG_SIM_FBWIDTH - 1;
+  rect.pt2.y = CONFIG_SIM_FBHEIGHT - 1;
+
+  origin.x   = 0;
+  origin.y   = 0;
+
+  if (pinfo.fbmem == NULL)
+    {
+      return -ENODEV;
+    }
+
+  bitmap = (FAR uint8_t *)kmm_malloc(pinfo.fblen);
+  if (bitmap == NULL)
+    {
+      gerr("ERROR: Failed to allocate the benchmark bitmap\n");
+      return -ENOMEM;
+    }
+
+  memset(bitmap, 0x5a, pinfo.fblen);
+
+  start = host_gettime(false);
+  for (i = 0; i < CONFIG_SIM_FBBENCH_NFRAMES; i++)
+    {
+      FBBENCH_OP(nxgl_fillrectangle)(&pinfo, &rect, i);
+    }
+
+  up_fbbench_report("fill", start);
+
+  start = host_gettime(false);
+  for (i = 0; i < CONFIG_SIM_FBBENCH_NFRAMES; i++)
+    {
+      FBBENCH_OP(nxgl_copyrectangle)(&pinfo, &rect, bitmap, &origin,
+                                     pinfo.stride);
+    }
+
+  up_fbbench_report("copy", start);
+
+  /* Scroll all but the top row up by one row, as a text console would */
+
+  srect         = rect;
+  srect.pt1.y   = 1;
+  offset.x      = 0;
+  offset.y      = 0;
+
+  start = host_gettime(false);
+  for (i = 0; i < CONFIG_SIM_FBBENCH_NFRAMES; i++)
+    {
+      FBBENCH_OP(nxgl_moverectangle)(&pinfo, &srect, &offset);
+    }
+
+  up_fbbench_report("move", start);
+
+#ifdef FBBENCH_BLEND
+  start = host_gettime(false);
+  for (i = 0; i < CONFIG_SIM_FBBENCH_NFRAMES; i++)
+    {
+      FBBENCH_OP(nxgl_blendrectangle)(&pinfo, &rect, i, 128);
+    }
+
+  up_fbbench_report("blendfill", start);
+
+  start = host_gettime(false);
+  for (i = 0; i < CONFIG_SIM_FBBENCH_NFRAMES; i++)
+    {
+      FBBENCH_OP(nxgl_blendbitmap)(&pinfo, &rect, bitmap, &origin,
+                                   pinfo.stride, 128);
+    }
+
+  up_fbbench_report("blendcopy", start);
+#endif
+
+  kmm_free(bitmap);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
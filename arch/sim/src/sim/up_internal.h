@@ -289,6 +289,12 @@ int up_x11cmap(unsigned short first, unsigned short len,
 #endif
 #endif
 
+/* up_framebuffer.c *********************************************************/
+
+#ifdef CONFIG_SIM_FBBENCH
+int up_fbbench(void);
+#endif
+
 /* up_touchscreen.c *********************************************************/
 
 #ifdef CONFIG_SIM_TOUCHSCREEN
@@ -0,0 +1,76 @@
+/****************************************************************************
+ * boards/sim/sim/sim/include/boardctl.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __BOARDS_SIM_SIM_SIM_INCLUDE_BOARDCTL_H
+#define __BOARDS_SIM_SIM_SIM_INCLUDE_BOARDCTL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/boardctl.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Board-specific boardctl() commands of the simulator.  The benchmarks
+ * report their results with syslog.
+ *
+ * BIOC_SIM_FTLBENCH - Run the FTL write amplification benchmark
+ *                     (CONFIG_SIM_FTLBENCH).  The argument is unused.
+ * BIOC_SIM_PKTBENCH - Run the packet socket ring benchmark
+ *                     (CONFIG_SIM_PKTBENCH).  A zero argument selects the
+ *                     transmit benchmark and a non-zero one the receive
+ *                     benchmark.
+ * BIOC_SIM_FBBENCH  - Run the framebuffer raster benchmark
+ *                     (CONFIG_SIM_FBBENCH).  The argument is unused.
+ * BIOC_SIM_LOCALBENCH - Run the Unix domain socket benchmark
+ *                     (CONFIG_SIM_LOCALBENCH).  The argument is unused.
+ * BIOC_SIM_ROUTEBENCH - Run the IPv4 route lookup benchmark
+ *                     (CONFIG_SIM_ROUTEBENCH).  The argument is unused.
+ * BIOC_SIM_USRSOCKBENCH - Run the usrsock transport benchmark
+ *                     (CONFIG_SIM_USRSOCKBENCH).  The argument is unused.
+ * BIOC_SIM_INODEBENCH - Run the inode lookup cache benchmark
+ *                     (CONFIG_SIM_INODEBENCH).  The argument is unused.
+ * BIOC_SIM_TXBENCH  - Run the packet rate versus idle connections
+ *                     benchmark (CONFIG_SIM_TXBENCH).  The argument is
+ *                     unused.
+ * BIOC_SIM_MUTEXBENCH - Run the pthread mutex benchmark and stress test
+ *                     (CONFIG_SIM_MUTEXBENCH).  The argument is unused.
+ * BIOC_SIM_CRCBENCH - Run the CRC self-test and benchmark
+ *                     (CONFIG_SIM_CRCBENCH).  The argument is unused.
+ * BIOC_SIM_HOSTFSBENCH - Run the hostfs throughput benchmark
+ *                     (CONFIG_SIM_HOSTFSBENCH).  The argument is unused.
+ */
+
+#define BIOC_SIM_FTLBENCH   (BOARDIOC_USER + 1)
+#define BIOC_SIM_PKTBENCH   (BOARDIOC_USER + 2)
+#define BIOC_SIM_FBBENCH    (BOARDIOC_USER + 3)
+#define BIOC_SIM_LOCALBENCH (BOARDIOC_USER + 4)
+#define BIOC_SIM_ROUTEBENCH (BOARDIOC_USER + 5)
+#define BIOC_SIM_USRSOCKBENCH (BOARDIOC_USER + 6)
+#define BIOC_SIM_INODEBENCH (BOARDIOC_USER + 7)
+#define BIOC_SIM_TXBENCH    (BOARDIOC_USER + 8)
+#define BIOC_SIM_MUTEXBENCH (BOARDIOC_USER + 9)
+#define BIOC_SIM_CRCBENCH   (BOARDIOC_USER + 10)
+#define BIOC_SIM_HOSTFSBENCH (BOARDIOC_USER + 11)
+
+#endif /* __BOARDS_SIM_SIM_SIM_INCLUDE_BOARDCTL_H */
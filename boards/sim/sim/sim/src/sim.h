@@ -42,6 +42,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -112,6 +114,141 @@ int sim_bringup(void);
 int sim_zoneinfo(int minor);
 #endif
 
+/****************************************************************************
+ * Name: sim_ftlbench
+ *
+ * Description:
+ *   Report the write amplification of the FTL on a RAM MTD device.  Run
+ *   with the BIOC_SIM_FTLBENCH boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_FTLBENCH
+int sim_ftlbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_pktbench
+ *
+ * Description:
+ *   Compare per-frame socket calls with the frame rings of a packet socket.
+ *   Run with the BIOC_SIM_PKTBENCH boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_PKTBENCH
+int sim_pktbench(bool rx);
+#endif
+
+/****************************************************************************
+ * Name: sim_localbench
+ *
+ * Description:
+ *   Measure the connect/accept rate and stream throughput of Unix domain
+ *   sockets.  Run with the BIOC_SIM_LOCALBENCH boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_LOCALBENCH
+int sim_localbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_routebench
+ *
+ * Description:
+ *   Compare the IPv4 route lookup rate of the prefix trie and its cache
+ *   with a linear walk of the routing table.  Run with the
+ *   BIOC_SIM_ROUTEBENCH boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_ROUTEBENCH
+int sim_routebench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_usrsockbench
+ *
+ * Description:
+ *   Measure the socket operation rate of the usrsock transports with an
+ *   in-kernel stand-in for the daemon.  Run with the BIOC_SIM_USRSOCKBENCH
+ *   boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_USRSOCKBENCH
+int sim_usrsockbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_inodebench
+ *
+ * Description:
+ *   Compare the pseudo-filesystem path lookup rate with the inode lookup
+ *   cache off and on.  Run with the BIOC_SIM_INODEBENCH boardctl()
+ *   command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_INODEBENCH
+int sim_inodebench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_txbench
+ *
+ * Description:
+ *   Measure the loopback packet rate against the number of idle TCP
+ *   connections.  Run with the BIOC_SIM_TXBENCH boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_TXBENCH
+int sim_txbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_mutexbench
+ *
+ * Description:
+ *   Measure the pthread mutex lock/unlock latency and stress the mutex
+ *   with several threads.  Run with the BIOC_SIM_MUTEXBENCH boardctl()
+ *   command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_MUTEXBENCH
+int sim_mutexbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_crcbench
+ *
+ * Description:
+ *   Check the CRC functions of the C library against their check values
+ *   and measure their throughput.  Run with the BIOC_SIM_CRCBENCH
+ *   boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_CRCBENCH
+int sim_crcbench(void);
+#endif
+
+/****************************************************************************
+ * Name: sim_hostfsbench
+ *
+ * Description:
+ *   Measure the write and read throughput of a file on hostfs.  Run with
+ *   the BIOC_SIM_HOSTFSBENCH boardctl() command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_HOSTFSBENCH
+int sim_hostfsbench(void);
+#endif
+
 /****************************************************************************
  * Name: sim_gpio_initialize
  *
@@ -0,0 +1,329 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_crcbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <crc8.h>
+#include <crc16.h>
+#include <crc32.h>
+#include <crc64.h>
+
+#include <nuttx/kmalloc.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_CRCBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CRCBENCH_SIZE      (CONFIG_SIM_CRCBENCH_SIZE * 1024)
+#define CRCBENCH_NLOOPS    CONFIG_SIM_CRCBENCH_NLOOPS
+#define CRCBENCH_ALIGN     8  /* Offsets tried for the check value */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One CRC variant.  The CRC of a buffer is part(src, len, init) ^ xorout
+ * and that of "123456789" must be equal to check.
+ */
+
+struct crcbench_variant_s
+{
+  FAR const char *name;
+  CODE uint64_t (*part)(FAR const uint8_t *src, size_t len, uint64_t crc);
+  uint64_t init;
+  uint64_t xorout;
+  uint64_t check;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint64_t crcbench_crc8(FAR const uint8_t *src, size_t len,
+                              uint64_t crc);
+static uint64_t crcbench_crc8ccitt(FAR const uint8_t *src, size_t len,
+                                   uint64_t crc);
+static uint64_t crcbench_crc16(FAR const uint8_t *src, size_t len,
+                               uint64_t crc);
+static uint64_t crcbench_crc32(FAR const uint8_t *src, size_t len,
+                               uint64_t crc);
+static uint64_t crcbench_crc32c(FAR const uint8_t *src, size_t len,
+                                uint64_t crc);
+#ifdef CONFIG_HAVE_LONG_LONG
+static uint64_t crcbench_crc64(FAR const uint8_t *src, size_t len,
+                               uint64_t crc);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char g_crcbench_checkstr[] = "123456789";
+
+/* The check values are those of the CRC catalogue where the libc function
+ * implements a catalogued CRC.  crc8() (polynomial 0xa6 in Koopman
+ * notation, no inversion) and crc32() (no inversion) have no catalogue
+ * entry, so their values were taken from the byte-wise implementation.
+ * crc32part() is also checked as the inverted CRC-32 that is commonly
+ * used.
+ */
+
+static const struct crcbench_variant_s g_crcbench_variants[] =
+{
+  {
+    "crc8",      crcbench_crc8,      0, 0, 0xd8
+  },
+  {
+    "crc8ccitt", crcbench_crc8ccitt, 0, 0, 0xf4         /* CRC-8/SMBUS */
+  },
+  {
+    "crc16",     crcbench_crc16,     0, 0, 0x31c3       /* CRC-16/XMODEM */
+  },
+  {
+    "crc32",     crcbench_crc32,     0, 0, 0x2dfd2d88
+  },
+  {
+    "crc32/inv", crcbench_crc32, 0xffffffff, 0xffffffff,
+    0xcbf43926                                          /* CRC-32 */
+  },
+  {
+    "crc32c",    crcbench_crc32c,    CRC32C_INIT, CRC32C_XOROUT,
+    CRC32C_CHECK                                        /* CRC-32/ISCSI */
+  },
+#ifdef CONFIG_HAVE_LONG_LONG
+  {
+    "crc64",     crcbench_crc64,     CRC64_INIT, CRC64_XOROUT,
+    CRC64_CHECK                                         /* CRC-64/XZ */
+  },
+#endif
+};
+
+#define CRCBENCH_NVARIANTS \
+  (sizeof(g_crcbench_variants) / sizeof(struct crcbench_variant_s))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t crcbench_crc8(FAR const uint8_t *src, size_t len,
+                              uint64_t crc)
+{
+  return crc8part(src, len, (uint8_t)crc);
+}
+
+static uint64_t crcbench_crc8ccitt(FAR const uint8_t *src, size_t len,
+                                   uint64_t crc)
+{
+  return crc8ccittpart(src, len, (uint8_t)crc);
+}
+
+static uint64_t crcbench_crc16(FAR const uint8_t *src, size_t len,
+                               uint64_t crc)
+{
+  return crc16part(src, len, (uint16_t)crc);
+}
+
+static uint64_t crcbench_crc32(FAR const uint8_t *src, size_t len,
+                               uint64_t crc)
+{
+  return crc32part(src, len, (uint32_t)crc);
+}
+
+static uint64_t crcbench_crc32c(FAR const uint8_t *src, size_t len,
+                                uint64_t crc)
+{
+  return crc32cpart(src, len, (uint32_t)crc);
+}
+
+#ifdef CONFIG_HAVE_LONG_LONG
+static uint64_t crcbench_crc64(FAR const uint8_t *src, size_t len,
+                               uint64_t crc)
+{
+  return crc64part(src, len, crc);
+}
+#endif
+
+/****************************************************************************
+ * Name: crcbench_check
+ *
+ * Description:
+ *   Check one CRC variant.  The check string is placed at every offset
+ *   from 0 to CRCBENCH_ALIGN - 1 so that the unaligned head and tail of
+ *   the slice-by-8 loop are covered.  The CRC of the whole buffer must also
+ *   be the same when it is computed in two parts, for split points on and
+ *   around the 8-byte boundaries.
+ *
+ ****************************************************************************/
+
+static int crcbench_check(FAR const struct crcbench_variant_s *variant,
+                          FAR uint8_t *buffer)
+{
+  static const size_t splits[] =
+  {
+    1, 7, 8, 9, 15, 17, CRCBENCH_SIZE / 2 + 3, CRCBENCH_SIZE - 5
+  };
+
+  uint8_t check[sizeof(g_crcbench_checkstr) - 1 + CRCBENCH_ALIGN];
+  uint64_t whole;
+  uint64_t crc;
+  size_t len = sizeof(g_crcbench_checkstr) - 1;
+  unsigned int i;
+
+  for (i = 0; i < CRCBENCH_ALIGN; i++)
+    {
+      memcpy(&check[i], g_crcbench_checkstr, len);
+      crc = variant->part(&check[i], len, variant->init) ^ variant->xorout;
+      if (crc != variant->check)
+        {
+          syslog(LOG_ERR, "ERROR: %s check value at offset %u is "
+                 "0x%08lx%08lx, expected 0x%08lx%08lx\n",
+                 variant->name, i, (unsigned long)(crc >> 32),
+                 (unsigned long)(crc & 0xffffffff),
+                 (unsigned long)(variant->check >> 32),
+                 (unsigned long)(variant->check & 0xffffffff));
+          return -EIO;
+        }
+    }
+
+  whole = variant->part(buffer, CRCBENCH_SIZE, variant->init);
+  for (i = 0; i < sizeof(splits) / sizeof(splits[0]); i++)
+    {
+      if (splits[i] >= CRCBENCH_SIZE)
+        {
+          continue;
+        }
+
+      crc = variant->part(buffer, splits[i], variant->init);
+      crc = variant->part(buffer + splits[i], CRCBENCH_SIZE - splits[i],
+                          crc);
+      if (crc != whole)
+        {
+          syslog(LOG_ERR, "ERROR: %s differs when split at %lu\n",
+                 variant->name, (unsigned long)splits[i]);
+          return -EIO;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crcbench_measure
+ *
+ * Description:
+ *   Compute the CRC of the buffer CONFIG_SIM_CRCBENCH_NLOOPS times and log
+ *   the throughput.
+ *
+ ****************************************************************************/
+
+static void crcbench_measure(FAR const struct crcbench_variant_s *variant,
+                             FAR const uint8_t *buffer)
+{
+  volatile uint64_t crc = 0;
+  uint64_t elapsed;
+  uint64_t start;
+  unsigned int i;
+
+  start = host_gettime(false);
+  for (i = 0; i < CRCBENCH_NLOOPS; i++)
+    {
+      crc ^= variant->part(buffer, CRCBENCH_SIZE, variant->init);
+    }
+
+  elapsed = host_gettime(false) - start;
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  syslog(LOG_INFO, "crcbench: %-9s check ok, %8lu KiB in %7lu us, "
+         "%6lu MB/s\n",
+         variant->name,
+         (unsigned long)CONFIG_SIM_CRCBENCH_SIZE * CRCBENCH_NLOOPS,
+         (unsigned long)(elapsed / 1000),
+         (unsigned long)((uint64_t)CRCBENCH_SIZE * CRCBENCH_NLOOPS *
+                         1000 / elapsed));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_crcbench
+ *
+ * Description:
+ *   Check every CRC variant of the C library against its check value and
+ *   against itself when the buffer is split, then log its throughput over
+ *   a CONFIG_SIM_CRCBENCH_SIZE KiB buffer.  Returns -EIO if any variant
+ *   gives a wrong result.
+ *
+ ****************************************************************************/
+
+int sim_crcbench(void)
+{
+  FAR uint8_t *buffer;
+  uint32_t seed = 1;
+  int ret = OK;
+  unsigned int i;
+
+  buffer = (FAR uint8_t *)kmm_malloc(CRCBENCH_SIZE);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < CRCBENCH_SIZE; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      buffer[i] = (uint8_t)(seed >> 16);
+    }
+
+  for (i = 0; i < CRCBENCH_NVARIANTS; i++)
+    {
+      ret = crcbench_check(&g_crcbench_variants[i], buffer);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      crcbench_measure(&g_crcbench_variants[i], buffer);
+    }
+
+  kmm_free(buffer);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_CRCBENCH */
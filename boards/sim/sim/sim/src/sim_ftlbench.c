@@ -0,0 +1,434 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_ftlbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <syslog.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/mtd/mtd.h>
+
+#include "sim.h"
+
+#ifdef CONFIG_SIM_FTLBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FTLBENCH_PATH   "/dev/ftlbench"
+#define FTLBENCH_SIZE   (CONFIG_SIM_FTLBENCH_SIZE * 1024)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* An MTD device that counts the erases and block writes that the FTL
+ * issues to the RAM MTD beneath it.  Counting below the FTL gives the same
+ * numbers for every FTL implementation.
+ */
+
+struct ftlbench_mtd_s
+{
+  struct mtd_dev_s mtd;         /* MTD device */
+  FAR struct mtd_dev_s *lower;  /* The RAM MTD device */
+  FAR uint32_t *erasecount;     /* Erase count of each erase block */
+  uint32_t neraseblocks;        /* Number of erase blocks */
+  uint32_t writes;              /* Blocks written */
+  uint32_t erases;              /* Erase blocks erased */
+};
+
+struct ftlbench_count_s
+{
+  uint32_t host;                /* Sectors written through the FTL */
+  uint32_t writes;              /* Blocks written to the MTD */
+  uint32_t erases;              /* Erase blocks erased */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftlbench_erase, ftlbench_bread, ftlbench_bwrite, ftlbench_read,
+ *       ftlbench_ioctl
+ *
+ * Description:
+ *   MTD methods of the counting device.  Everything is passed on to the
+ *   RAM MTD device.
+ *
+ ****************************************************************************/
+
+static int ftlbench_erase(FAR struct mtd_dev_s *dev, off_t startblock,
+                          size_t nblocks)
+{
+  FAR struct ftlbench_mtd_s *priv = (FAR struct ftlbench_mtd_s *)dev;
+  size_t i;
+  int ret;
+
+  ret = MTD_ERASE(priv->lower, startblock, nblocks);
+  if (ret >= 0)
+    {
+      for (i = 0; i < nblocks && startblock + i < priv->neraseblocks; i++)
+        {
+          priv->erasecount[startblock + i]++;
+        }
+
+      priv->erases += nblocks;
+    }
+
+  return ret;
+}
+
+static ssize_t ftlbench_bread(FAR struct mtd_dev_s *dev, off_t startblock,
+                              size_t nblocks, FAR uint8_t *buffer)
+{
+  FAR struct ftlbench_mtd_s *priv = (FAR struct ftlbench_mtd_s *)dev;
+
+  return MTD_BREAD(priv->lower, startblock, nblocks, buffer);
+}
+
+static ssize_t ftlbench_bwrite(FAR struct mtd_dev_s *dev, off_t startblock,
+                               size_t nblocks, FAR const uint8_t *buffer)
+{
+  FAR struct ftlbench_mtd_s *priv = (FAR struct ftlbench_mtd_s *)dev;
+  ssize_t nwritten;
+
+  nwritten = MTD_BWRITE(priv->lower, startblock, nblocks, buffer);
+  if (nwritten > 0)
+    {
+      priv->writes += nwritten;
+    }
+
+  return nwritten;
+}
+
+static ssize_t ftlbench_read(FAR struct mtd_dev_s *dev, off_t offset,
+                             size_t nbytes, FAR uint8_t *buffer)
+{
+  FAR struct ftlbench_mtd_s *priv = (FAR struct ftlbench_mtd_s *)dev;
+
+  return MTD_READ(priv->lower, offset, nbytes, buffer);
+}
+
+static int ftlbench_ioctl(FAR struct mtd_dev_s *dev, int cmd,
+                          unsigned long arg)
+{
+  FAR struct ftlbench_mtd_s *priv = (FAR struct ftlbench_mtd_s *)dev;
+
+  return MTD_IOCTL(priv->lower, cmd, arg);
+}
+
+/****************************************************************************
+ * Name: ftlbench_random
+ *
+ * Description:
+ *   A small linear congruential generator so that runs are repeatable.
+ *
+ ****************************************************************************/
+
+static uint32_t ftlbench_random(FAR uint32_t *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return *seed >> 8;
+}
+
+/****************************************************************************
+ * Name: ftlbench_sample
+ ****************************************************************************/
+
+static void ftlbench_sample(FAR const struct ftlbench_mtd_s *priv,
+                            uint32_t host,
+                            FAR struct ftlbench_count_s *count)
+{
+  count->host   = host;
+  count->writes = priv->writes;
+  count->erases = priv->erases;
+}
+
+/****************************************************************************
+ * Name: ftlbench_report
+ ****************************************************************************/
+
+static void ftlbench_report(FAR const char *phase,
+                            FAR const struct ftlbench_count_s *before,
+                            FAR const struct ftlbench_count_s *after)
+{
+  uint32_t host  = after->host - before->host;
+  uint32_t flash = after->writes - before->writes;
+  uint32_t wa100 = host > 0 ? (uint32_t)((uint64_t)flash * 100 / host) : 0;
+
+  syslog(LOG_INFO,
+         "ftlbench: %-10s host %6lu flash %7lu WA %lu.%02lu erases %6lu\n",
+         phase, (unsigned long)host, (unsigned long)flash,
+         (unsigned long)(wa100 / 100), (unsigned long)(wa100 % 100),
+         (unsigned long)(after->erases - before->erases));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_ftlbench
+ *
+ * Description:
+ *   Measure the write amplification and wear spread of the configured FTL
+ *   on a RAM MTD device.  The device is filled sequentially once and then
+ *   rewritten one sector at a time with 80% of the writes going to 20% of
+ *   the sectors, a common file system pattern.  Flash writes and erases
+ *   are counted at the MTD interface, so the legacy read-erase-write FTL
+ *   and the log-structured FTL report comparable numbers for the same
+ *   workload.
+ *
+ *   Everything that is created here is released again before returning.
+ *
+ ****************************************************************************/
+
+int sim_ftlbench(void)
+{
+  FAR struct ftlbench_mtd_s *priv;
+  FAR struct mtd_dev_s *rammtd;
+  FAR struct inode *inode;
+  FAR uint8_t *ramstart;
+  FAR uint8_t *buffer;
+  struct ftlbench_count_s count[3];
+  struct mtd_geometry_s mgeo;
+  struct geometry geo;
+  uint32_t minerase;
+  uint32_t maxerase;
+  uint32_t host = 0;
+  uint32_t seed = 1;
+  uint32_t sector;
+  uint32_t hot;
+  uint32_t i;
+#ifdef CONFIG_FTL_LOG
+  struct ftl_stats_s stats;
+#endif
+  int ret;
+
+  ramstart = (FAR uint8_t *)kmm_malloc(FTLBENCH_SIZE);
+  if (ramstart == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  rammtd = rammtd_initialize(ramstart, FTLBENCH_SIZE);
+  if (rammtd == NULL)
+    {
+      ret = -ENODEV;
+      goto errout_with_ram;
+    }
+
+  MTD_IOCTL(rammtd, MTDIOC_BULKERASE, 0);
+  ret = MTD_IOCTL(rammtd, MTDIOC_GEOMETRY,
+                  (unsigned long)((uintptr_t)&mgeo));
+  if (ret < 0)
+    {
+      goto errout_with_rammtd;
+    }
+
+  /* Put the counting device between the FTL and the RAM MTD device */
+
+  priv = (FAR struct ftlbench_mtd_s *)
+    kmm_zalloc(sizeof(struct ftlbench_mtd_s));
+  if (priv == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_rammtd;
+    }
+
+  priv->erasecount = (FAR uint32_t *)
+    kmm_zalloc(mgeo.neraseblocks * sizeof(uint32_t));
+  if (priv->erasecount == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_priv;
+    }
+
+  priv->mtd.erase    = ftlbench_erase;
+  priv->mtd.bread    = ftlbench_bread;
+  priv->mtd.bwrite   = ftlbench_bwrite;
+  priv->mtd.read     = rammtd->read != NULL ? ftlbench_read : NULL;
+  priv->mtd.ioctl    = ftlbench_ioctl;
+  priv->mtd.name     = "ftlbench";
+  priv->lower        = rammtd;
+  priv->neraseblocks = mgeo.neraseblocks;
+
+  ret = ftl_initialize_by_path(FTLBENCH_PATH, &priv->mtd);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: ftl_initialize_by_path failed: %d\n", ret);
+      goto errout_with_erasecount;
+    }
+
+  ret = open_blockdriver(FTLBENCH_PATH, 0, &inode);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: open_blockdriver failed: %d\n", ret);
+      goto errout_with_driver;
+    }
+
+  ret = inode->u.i_bops->geometry(inode, &geo);
+  if (ret < 0)
+    {
+      goto errout_with_inode;
+    }
+
+  if (geo.geo_nsectors < 5)
+    {
+      ret = -EINVAL;
+      goto errout_with_inode;
+    }
+
+  buffer = (FAR uint8_t *)kmm_malloc(geo.geo_sectorsize);
+  if (buffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_inode;
+    }
+
+  memset(buffer, 0x5a, geo.geo_sectorsize);
+  ftlbench_sample(priv, host, &count[0]);
+
+  /* Sequential fill */
+
+  for (sector = 0; sector < geo.geo_nsectors; sector++)
+    {
+      ret = inode->u.i_bops->write(inode, buffer, sector, 1);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: write failed: %d\n", ret);
+          goto errout_with_buffer;
+        }
+
+      host++;
+    }
+
+  ftlbench_sample(priv, host, &count[1]);
+
+  /* Skewed random single-sector rewrites */
+
+  hot = geo.geo_nsectors / 5;
+  for (i = 0; i < CONFIG_SIM_FTLBENCH_NWRITES; i++)
+    {
+      if (ftlbench_random(&seed) % 10 < 8)
+        {
+          sector = ftlbench_random(&seed) % hot;
+        }
+      else
+        {
+          sector = ftlbench_random(&seed) % geo.geo_nsectors;
+        }
+
+      ret = inode->u.i_bops->write(inode, buffer, sector, 1);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: write failed: %d\n", ret);
+          goto errout_with_buffer;
+        }
+
+      host++;
+    }
+
+  ftlbench_sample(priv, host, &count[2]);
+
+  minerase = UINT32_MAX;
+  maxerase = 0;
+
+  for (i = 0; i < priv->neraseblocks; i++)
+    {
+      if (priv->erasecount[i] < minerase)
+        {
+          minerase = priv->erasecount[i];
+        }
+
+      if (priv->erasecount[i] > maxerase)
+        {
+          maxerase = priv->erasecount[i];
+        }
+    }
+
+#ifdef CONFIG_FTL_LOG
+  syslog(LOG_INFO, "ftlbench: log-structured FTL, %lu sectors of %lu "
+         "bytes, %lu per erase block\n", (unsigned long)geo.geo_nsectors,
+#else
+  syslog(LOG_INFO, "ftlbench: read-erase-write FTL, %lu sectors of %lu "
+         "bytes, %lu per erase block\n", (unsigned long)geo.geo_nsectors,
+#endif
+         (unsigned long)geo.geo_sectorsize,
+         (unsigned long)(mgeo.erasesize / mgeo.blocksize));
+  ftlbench_report("sequential", &count[0], &count[1]);
+  ftlbench_report("random", &count[1], &count[2]);
+  syslog(LOG_INFO, "ftlbench: erase counts %lu..%lu\n",
+         (unsigned long)minerase, (unsigned long)maxerase);
+
+#ifdef CONFIG_FTL_LOG
+  ret = inode->u.i_bops->ioctl(inode, BIOC_FTLSTATS,
+                               (unsigned long)((uintptr_t)&stats));
+  if (ret >= 0)
+    {
+      syslog(LOG_INFO, "ftlbench: gc %lu wl %lu checkpoints %lu\n",
+             (unsigned long)stats.collections,
+             (unsigned long)stats.wlmoves,
+             (unsigned long)stats.checkpoints);
+    }
+#endif
+
+  ret = OK;
+
+errout_with_buffer:
+  kmm_free(buffer);
+
+errout_with_inode:
+  close_blockdriver(inode);
+
+errout_with_driver:
+
+  /* Unlinking the block driver also makes the FTL free its state */
+
+  unlink(FTLBENCH_PATH);
+
+errout_with_erasecount:
+  kmm_free(priv->erasecount);
+
+errout_with_priv:
+  kmm_free(priv);
+
+errout_with_rammtd:
+  kmm_free(rammtd);
+
+errout_with_ram:
+  kmm_free(ramstart);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_FTLBENCH */
@@ -0,0 +1,276 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_hostfsbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_HOSTFSBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HOSTFSBENCH_PATH     CONFIG_SIM_HOSTFSBENCH_PATH
+#define HOSTFSBENCH_SIZE     (CONFIG_SIM_HOSTFSBENCH_SIZE * 1024)
+#define HOSTFSBENCH_MAXCHUNK 32768
+
+#ifndef MIN
+#  define MIN(a,b)           ((a) < (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The transfer sizes that are measured */
+
+static const size_t g_hostfsbench_chunks[] =
+{
+  512, 4096, HOSTFSBENCH_MAXCHUNK
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: hostfsbench_fill
+ *
+ * Description:
+ *   Fill the buffer with the data expected at the given file offset.
+ *
+ ****************************************************************************/
+
+static void hostfsbench_fill(FAR uint8_t *buffer, size_t len, size_t pos)
+{
+  size_t i;
+
+  for (i = 0; i < len; i++)
+    {
+      buffer[i] = (uint8_t)((pos + i) ^ ((pos + i) >> 8));
+    }
+}
+
+/****************************************************************************
+ * Name: hostfsbench_rate
+ ****************************************************************************/
+
+static void hostfsbench_rate(FAR const char *op, size_t chunk,
+                             uint64_t elapsed)
+{
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  syslog(LOG_INFO, "hostfsbench: %-5s %5lu byte chunks: %6lu KiB in "
+         "%7lu us, %6lu KiB/s\n",
+         op, (unsigned long)chunk,
+         (unsigned long)CONFIG_SIM_HOSTFSBENCH_SIZE,
+         (unsigned long)(elapsed / 1000),
+         (unsigned long)((uint64_t)CONFIG_SIM_HOSTFSBENCH_SIZE *
+                         1000000000 / elapsed));
+}
+
+/****************************************************************************
+ * Name: hostfsbench_write
+ *
+ * Description:
+ *   Write CONFIG_SIM_HOSTFSBENCH_SIZE KiB to a new file in chunks of the
+ *   given size and log the rate.  The data is generated before the timer
+ *   starts.
+ *
+ ****************************************************************************/
+
+static int hostfsbench_write(FAR uint8_t *buffer, size_t chunk)
+{
+  struct file filep;
+  uint64_t elapsed;
+  uint64_t start;
+  ssize_t nwritten;
+  size_t pos;
+  int ret;
+
+  ret = file_open(&filep, HOSTFSBENCH_PATH, O_WRONLY | O_CREAT | O_TRUNC,
+                  0644);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to create %s: %d\n",
+             HOSTFSBENCH_PATH, ret);
+      return ret;
+    }
+
+  hostfsbench_fill(buffer, HOSTFSBENCH_SIZE, 0);
+
+  start = host_gettime(false);
+  for (pos = 0; pos < HOSTFSBENCH_SIZE; pos += nwritten)
+    {
+      nwritten = file_write(&filep, buffer + pos,
+                            MIN(chunk, HOSTFSBENCH_SIZE - pos));
+      if (nwritten <= 0)
+        {
+          ret = nwritten < 0 ? nwritten : -EIO;
+          syslog(LOG_ERR, "ERROR: file_write failed: %d\n", ret);
+          break;
+        }
+    }
+
+  elapsed = host_gettime(false) - start;
+  file_close(&filep);
+
+  if (ret >= 0)
+    {
+      hostfsbench_rate("write", chunk, elapsed);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: hostfsbench_read
+ *
+ * Description:
+ *   Read the file back in chunks of the given size, log the rate and then
+ *   check the data.
+ *
+ ****************************************************************************/
+
+static int hostfsbench_read(FAR uint8_t *buffer, FAR uint8_t *expect,
+                            size_t chunk)
+{
+  struct file filep;
+  uint64_t elapsed;
+  uint64_t start;
+  ssize_t nread;
+  size_t pos;
+  int ret;
+
+  ret = file_open(&filep, HOSTFSBENCH_PATH, O_RDONLY);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to open %s: %d\n",
+             HOSTFSBENCH_PATH, ret);
+      return ret;
+    }
+
+  memset(buffer, 0, HOSTFSBENCH_SIZE);
+
+  start = host_gettime(false);
+  for (pos = 0; pos < HOSTFSBENCH_SIZE; pos += nread)
+    {
+      nread = file_read(&filep, buffer + pos,
+                        MIN(chunk, HOSTFSBENCH_SIZE - pos));
+      if (nread <= 0)
+        {
+          ret = nread < 0 ? nread : -EIO;
+          syslog(LOG_ERR, "ERROR: file_read failed at %lu: %d\n",
+                 (unsigned long)pos, ret);
+          break;
+        }
+    }
+
+  elapsed = host_gettime(false) - start;
+  file_close(&filep);
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  hostfsbench_fill(expect, HOSTFSBENCH_SIZE, 0);
+  if (memcmp(buffer, expect, HOSTFSBENCH_SIZE) != 0)
+    {
+      syslog(LOG_ERR, "ERROR: Data read back with %lu byte chunks "
+             "differs\n", (unsigned long)chunk);
+      return -EIO;
+    }
+
+  hostfsbench_rate("read", chunk, elapsed);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_hostfsbench
+ *
+ * Description:
+ *   Write a CONFIG_SIM_HOSTFSBENCH_SIZE KiB file to
+ *   CONFIG_SIM_HOSTFSBENCH_PATH and read it back, with transfers of 512
+ *   bytes to 32 KiB, and log the rates.  The data read back is checked.
+ *   The file is removed afterwards.
+ *
+ ****************************************************************************/
+
+int sim_hostfsbench(void)
+{
+  FAR uint8_t *buffer;
+  FAR uint8_t *expect;
+  unsigned int i;
+  int ret = OK;
+
+  buffer = (FAR uint8_t *)kmm_malloc(2 * HOSTFSBENCH_SIZE);
+  if (buffer == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  expect = buffer + HOSTFSBENCH_SIZE;
+
+  for (i = 0; i < sizeof(g_hostfsbench_chunks) / sizeof(size_t); i++)
+    {
+      ret = hostfsbench_write(buffer, g_hostfsbench_chunks[i]);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      ret = hostfsbench_read(buffer, expect, g_hostfsbench_chunks[i]);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  unlink(HOSTFSBENCH_PATH);
+  kmm_free(buffer);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_HOSTFSBENCH */
@@ -0,0 +1,188 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_inodebench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_INODEBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODEBENCH_NNODES   CONFIG_SIM_INODEBENCH_NNODES
+#define INODEBENCH_NLOOKUPS CONFIG_SIM_INODEBENCH_NLOOKUPS
+#define INODEBENCH_PATHLEN  32
+#define INODEBENCH_PATH(p,i) ((p) + (i) * INODEBENCH_PATHLEN)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The benchmark device nodes are only looked up, never opened */
+
+static const struct file_operations g_inodebench_fops;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inodebench_run
+ *
+ * Description:
+ *   Time CONFIG_SIM_INODEBENCH_NLOOKUPS lookups of pseudo-random benchmark
+ *   nodes with the lookup cache on or off.
+ *
+ ****************************************************************************/
+
+static int inodebench_run(FAR const char *paths, bool cache)
+{
+  struct inode_search_s desc;
+  uint32_t hits = g_inode_cachestats.hits;
+  uint32_t seed = 1;
+  uint64_t elapsed;
+  uint64_t start;
+  uint32_t i;
+  int ret = OK;
+
+  inode_cache_enable(cache);
+
+  start = host_gettime(false);
+  for (i = 0; i < INODEBENCH_NLOOKUPS; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+
+      SETUP_SEARCH(&desc,
+                   INODEBENCH_PATH(paths, (seed >> 16) % INODEBENCH_NNODES),
+                   false);
+
+      ret = inode_find(&desc);
+      if (ret >= 0)
+        {
+          inode_release(desc.node);
+        }
+
+      RELEASE_SEARCH(&desc);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: inode_find failed: %d\n", ret);
+          break;
+        }
+    }
+
+  elapsed = host_gettime(false) - start;
+  inode_cache_enable(true);
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  syslog(LOG_INFO, "inodebench: cache %-3s %7lu lookups in %7lu us, "
+         "%8lu lookups/s, %lu cache hits\n",
+         cache ? "on" : "off", (unsigned long)INODEBENCH_NLOOKUPS,
+         (unsigned long)(elapsed / 1000),
+         (unsigned long)((uint64_t)INODEBENCH_NLOOKUPS * 1000000000 /
+                         elapsed),
+         (unsigned long)(g_inode_cachestats.hits - hits));
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_inodebench
+ *
+ * Description:
+ *   Register CONFIG_SIM_INODEBENCH_NNODES device nodes in one directory of
+ *   the pseudo-filesystem and compare the path lookup rate with the inode
+ *   lookup cache off and on.  The nodes are removed again afterwards.
+ *
+ ****************************************************************************/
+
+int sim_inodebench(void)
+{
+  FAR char *paths;
+  uint32_t nregistered;
+  int ret = OK;
+
+  paths = (FAR char *)kmm_malloc(INODEBENCH_NNODES * INODEBENCH_PATHLEN);
+  if (paths == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (nregistered = 0; nregistered < INODEBENCH_NNODES; nregistered++)
+    {
+      snprintf(INODEBENCH_PATH(paths, nregistered), INODEBENCH_PATHLEN,
+               "/dev/inodebench/node%04lu", (unsigned long)nregistered);
+
+      ret = register_driver(INODEBENCH_PATH(paths, nregistered),
+                            &g_inodebench_fops, 0444, NULL);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: register_driver failed: %d\n", ret);
+          goto errout_with_nodes;
+        }
+    }
+
+  ret = inodebench_run(paths, false);
+  if (ret >= 0)
+    {
+      ret = inodebench_run(paths, true);
+    }
+
+errout_with_nodes:
+  while (nregistered > 0)
+    {
+      nregistered--;
+      unregister_driver(INODEBENCH_PATH(paths, nregistered));
+    }
+
+  kmm_free(paths);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_INODEBENCH */
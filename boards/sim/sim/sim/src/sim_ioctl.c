@@ -0,0 +1,126 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_ioctl.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <errno.h>
+
+#include <nuttx/board.h>
+#include <arch/board/boardctl.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_BOARDCTL_IOCTL
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: board_ioctl
+ *
+ * Description:
+ *   Handle the board-specific boardctl() commands of the simulator.  The
+ *   commands are listed in arch/board/boardctl.h.
+ *
+ * Input Parameters:
+ *   cmd - The BIOC_SIM_* command.
+ *   arg - The command argument.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int board_ioctl(unsigned int cmd, uintptr_t arg)
+{
+  switch (cmd)
+    {
+#ifdef CONFIG_SIM_FTLBENCH
+      case BIOC_SIM_FTLBENCH:
+        return sim_ftlbench();
+#endif
+
+#ifdef CONFIG_SIM_FBBENCH
+      case BIOC_SIM_FBBENCH:
+        return up_fbbench();
+#endif
+
+#ifdef CONFIG_SIM_PKTBENCH
+      case BIOC_SIM_PKTBENCH:
+        return sim_pktbench(arg != 0);
+#endif
+
+#ifdef CONFIG_SIM_LOCALBENCH
+      case BIOC_SIM_LOCALBENCH:
+        return sim_localbench();
+#endif
+
+#ifdef CONFIG_SIM_ROUTEBENCH
+      case BIOC_SIM_ROUTEBENCH:
+        return sim_routebench();
+#endif
+
+#ifdef CONFIG_SIM_USRSOCKBENCH
+      case BIOC_SIM_USRSOCKBENCH:
+        return sim_usrsockbench();
+#endif
+
+#ifdef CONFIG_SIM_INODEBENCH
+      case BIOC_SIM_INODEBENCH:
+        return sim_inodebench();
+#endif
+
+#ifdef CONFIG_SIM_TXBENCH
+      case BIOC_SIM_TXBENCH:
+        return sim_txbench();
+#endif
+
+#ifdef CONFIG_SIM_MUTEXBENCH
+      case BIOC_SIM_MUTEXBENCH:
+        return sim_mutexbench();
+#endif
+
+#ifdef CONFIG_SIM_CRCBENCH
+      case BIOC_SIM_CRCBENCH:
+        return sim_crcbench();
+#endif
+
+#ifdef CONFIG_SIM_HOSTFSBENCH
+      case BIOC_SIM_HOSTFSBENCH:
+        return sim_hostfsbench();
+#endif
+
+      default:
+        return -ENOTTY;
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_BOARDCTL_IOCTL */
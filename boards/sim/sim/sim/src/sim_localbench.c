@@ -0,0 +1,361 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_localbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <stdint.h>
+#include <string.h>
+#include <syslog.h>
+#include <sched.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_LOCALBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOCALBENCH_PATH     "/var/localbench"
+#define LOCALBENCH_NCONNS   CONFIG_SIM_LOCALBENCH_NCONNS
+#define LOCALBENCH_NBYTES   (CONFIG_SIM_LOCALBENCH_SIZE * 1024)
+#define LOCALBENCH_CHUNK    1024
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* State shared with the server thread */
+
+struct localbench_s
+{
+  struct socket listener;       /* Listening socket */
+  sem_t done;                   /* Posted when the server thread exits */
+  uint32_t nbytes;              /* Bytes received by the server */
+  int result;                   /* Result of the server thread */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct localbench_s g_localbench;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: localbench_report
+ ****************************************************************************/
+
+static void localbench_report(FAR const char *name, FAR const char *unit,
+                              uint32_t count, uint64_t start)
+{
+  uint64_t elapsed = host_gettime(false) - start;
+  uint64_t rate;
+
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  rate = (uint64_t)count * 1000000000 / elapsed;
+  syslog(LOG_INFO, "localbench: %-8s %8lu %s in %7lu us, %8lu %s/s\n",
+         name, (unsigned long)count, unit, (unsigned long)(elapsed / 1000),
+         (unsigned long)rate, unit);
+}
+
+/****************************************************************************
+ * Name: localbench_server
+ *
+ * Description:
+ *   Accept and close CONFIG_SIM_LOCALBENCH_NCONNS connections, then accept
+ *   one more connection and drain it until the client closes it.
+ *
+ ****************************************************************************/
+
+static int localbench_server(int argc, FAR char *argv[])
+{
+  FAR struct localbench_s *bench = &g_localbench;
+  struct socket sock;
+  FAR uint8_t *buffer;
+  ssize_t nread;
+  uint32_t i;
+  int ret;
+
+  buffer = (FAR uint8_t *)kmm_malloc(LOCALBENCH_CHUNK);
+  if (buffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  for (i = 0; i < LOCALBENCH_NCONNS; i++)
+    {
+      ret = psock_accept(&bench->listener, NULL, NULL, &sock);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_accept failed: %d\n", ret);
+          goto errout_with_buffer;
+        }
+
+      psock_close(&sock);
+    }
+
+  ret = psock_accept(&bench->listener, NULL, NULL, &sock);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_accept failed: %d\n", ret);
+      goto errout_with_buffer;
+    }
+
+  do
+    {
+      nread = psock_recv(&sock, buffer, LOCALBENCH_CHUNK, 0);
+      if (nread > 0)
+        {
+          bench->nbytes += nread;
+        }
+    }
+  while (nread > 0);
+
+  if (nread < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_recv failed: %d\n", (int)nread);
+      ret = nread;
+    }
+
+  psock_close(&sock);
+
+errout_with_buffer:
+  kmm_free(buffer);
+
+errout:
+  bench->result = ret;
+  nxsem_post(&bench->done);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: localbench_connect
+ ****************************************************************************/
+
+static int localbench_connect(FAR struct socket *psock)
+{
+  struct sockaddr_un addr;
+  int ret;
+
+  ret = psock_socket(AF_LOCAL, SOCK_STREAM, 0, psock);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_socket failed: %d\n", ret);
+      return ret;
+    }
+
+  memset(&addr, 0, sizeof(struct sockaddr_un));
+  addr.sun_family = AF_LOCAL;
+  strncpy(addr.sun_path, LOCALBENCH_PATH, UNIX_PATH_MAX - 1);
+
+  ret = psock_connect(psock, (FAR const struct sockaddr *)&addr,
+                      sizeof(struct sockaddr_un));
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_connect failed: %d\n", ret);
+      psock_close(psock);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: localbench_client
+ *
+ * Description:
+ *   Time the connect/accept loop and then the transfer of
+ *   CONFIG_SIM_LOCALBENCH_SIZE KiB over one stream connection.  The
+ *   transfer is complete when the server thread has read all of the data.
+ *
+ ****************************************************************************/
+
+static int localbench_client(pid_t pid)
+{
+  FAR struct localbench_s *bench = &g_localbench;
+  struct socket sock;
+  FAR uint8_t *buffer;
+  uint64_t start;
+  uint32_t nsent;
+  uint32_t i;
+  ssize_t ret;
+
+  buffer = (FAR uint8_t *)kmm_zalloc(LOCALBENCH_CHUNK);
+  if (buffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_server;
+    }
+
+  start = host_gettime(false);
+  for (i = 0; i < LOCALBENCH_NCONNS; i++)
+    {
+      ret = localbench_connect(&sock);
+      if (ret < 0)
+        {
+          goto errout_with_buffer;
+        }
+
+      psock_close(&sock);
+    }
+
+  localbench_report("connect", "conns", i, start);
+
+  ret = localbench_connect(&sock);
+  if (ret < 0)
+    {
+      goto errout_with_buffer;
+    }
+
+  /* Closing the socket ends the server thread even if a send fails */
+
+  start = host_gettime(false);
+  for (nsent = 0; nsent < LOCALBENCH_NBYTES; nsent += ret)
+    {
+      ret = psock_send(&sock, buffer, LOCALBENCH_CHUNK, 0);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_send failed: %d\n", (int)ret);
+          break;
+        }
+    }
+
+  psock_close(&sock);
+  kmm_free(buffer);
+
+  nxsem_wait_uninterruptible(&bench->done);
+  if (ret >= 0 && bench->result >= 0)
+    {
+      localbench_report("stream", "KiB", bench->nbytes / 1024, start);
+    }
+
+  return ret < 0 ? ret : bench->result;
+
+errout_with_buffer:
+  kmm_free(buffer);
+
+errout_with_server:
+
+  /* The server thread may be waiting for a connection that will never
+   * come.
+   */
+
+  kthread_delete(pid);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_localbench
+ *
+ * Description:
+ *   Measure the connect/accept rate and the stream throughput of Unix
+ *   domain sockets.  A kernel thread accepts the connections while the
+ *   caller connects, so both sides of every operation are timed.
+ *
+ ****************************************************************************/
+
+int sim_localbench(void)
+{
+  FAR struct localbench_s *bench = &g_localbench;
+  struct sockaddr_un addr;
+  pid_t pid;
+  int ret;
+
+  memset(bench, 0, sizeof(struct localbench_s));
+
+  ret = psock_socket(AF_LOCAL, SOCK_STREAM, 0, &bench->listener);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_socket failed: %d\n", ret);
+      return ret;
+    }
+
+  memset(&addr, 0, sizeof(struct sockaddr_un));
+  addr.sun_family = AF_LOCAL;
+  strncpy(addr.sun_path, LOCALBENCH_PATH, UNIX_PATH_MAX - 1);
+
+  ret = psock_bind(&bench->listener, (FAR const struct sockaddr *)&addr,
+                   sizeof(struct sockaddr_un));
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_bind failed: %d\n", ret);
+      goto errout_with_listener;
+    }
+
+  ret = psock_listen(&bench->listener, 1);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_listen failed: %d\n", ret);
+      goto errout_with_listener;
+    }
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&bench->done, 0, 0);
+  nxsem_set_protocol(&bench->done, SEM_PRIO_NONE);
+
+  pid = kthread_create("localbench", SCHED_PRIORITY_DEFAULT,
+                       CONFIG_DEFAULT_TASK_STACKSIZE, localbench_server,
+                       NULL);
+  if (pid < 0)
+    {
+      ret = pid;
+      goto errout_with_sem;
+    }
+
+  ret = localbench_client(pid);
+
+errout_with_sem:
+  nxsem_destroy(&bench->done);
+
+errout_with_listener:
+  psock_close(&bench->listener);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_LOCALBENCH */
@@ -0,0 +1,476 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_mutexbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/semaphore.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_MUTEXBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MUTEXBENCH_NPAIRS    CONFIG_SIM_MUTEXBENCH_NPAIRS
+#define MUTEXBENCH_NTHREADS  CONFIG_SIM_MUTEXBENCH_NTHREADS
+#define MUTEXBENCH_NLOOPS    CONFIG_SIM_MUTEXBENCH_NLOOPS
+#define MUTEXBENCH_TIMEOUT   10000000 /* pthread_mutex_timedlock(), in ns */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The statistics of one thread of the stress test */
+
+struct mutexbench_thread_s
+{
+  pthread_t thread;             /* The thread */
+  uint32_t nlocked;             /* Number of times the mutex was taken */
+  uint32_t nbusy;               /* Number of pthread_mutex_trylock() EBUSY */
+  uint32_t ntimedout;           /* Number of pthread_mutex_timedlock()
+                                 * ETIMEDOUT */
+  int errcode;                  /* First unexpected error */
+};
+
+/* The state shared by the threads of the stress test */
+
+struct mutexbench_s
+{
+  pthread_mutex_t mutex;        /* The mutex under test */
+  volatile uint32_t counter;    /* Incremented with the mutex held */
+  volatile bool inside;         /* A thread holds the mutex */
+  bool recursive;               /* The mutex is PTHREAD_MUTEX_RECURSIVE */
+  struct mutexbench_thread_s threads[MUTEXBENCH_NTHREADS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct mutexbench_s g_mutexbench;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mutexbench_init
+ ****************************************************************************/
+
+static int mutexbench_init(FAR pthread_mutex_t *mutex, int type)
+{
+  pthread_mutexattr_t attr;
+  int ret;
+
+  ret = pthread_mutexattr_init(&attr);
+  if (ret != 0)
+    {
+      return -ret;
+    }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  ret = pthread_mutexattr_settype(&attr, type);
+  if (ret == 0)
+#endif
+    {
+      ret = pthread_mutex_init(mutex, &attr);
+    }
+
+  pthread_mutexattr_destroy(&attr);
+  return -ret;
+}
+
+/****************************************************************************
+ * Name: mutexbench_latency
+ *
+ * Description:
+ *   Time CONFIG_SIM_MUTEXBENCH_NPAIRS uncontended lock/unlock pairs on a
+ *   mutex of the given type and log the time per pair.
+ *
+ ****************************************************************************/
+
+static int mutexbench_latency(int type, FAR const char *name)
+{
+  pthread_mutex_t mutex;
+  uint64_t elapsed;
+  uint64_t start;
+  uint32_t i;
+  int ret;
+
+  ret = mutexbench_init(&mutex, type);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  start = host_gettime(false);
+  for (i = 0; i < MUTEXBENCH_NPAIRS; i++)
+    {
+      ret = pthread_mutex_lock(&mutex);
+      if (ret == 0)
+        {
+          ret = pthread_mutex_unlock(&mutex);
+        }
+
+      if (ret != 0)
+        {
+          syslog(LOG_ERR, "ERROR: %s lock/unlock failed: %d\n", name, ret);
+          pthread_mutex_destroy(&mutex);
+          return -ret;
+        }
+    }
+
+  elapsed = host_gettime(false) - start;
+  pthread_mutex_destroy(&mutex);
+
+  syslog(LOG_INFO, "mutexbench: %-9s %8lu lock/unlock pairs in %7lu us, "
+         "%5lu ns per pair\n",
+         name, (unsigned long)MUTEXBENCH_NPAIRS,
+         (unsigned long)(elapsed / 1000),
+         (unsigned long)(elapsed / MUTEXBENCH_NPAIRS));
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mutexbench_take
+ *
+ * Description:
+ *   Take the shared mutex in the way selected by the loop count:  with
+ *   pthread_mutex_lock(), with pthread_mutex_trylock() falling back to
+ *   pthread_mutex_lock(), or with pthread_mutex_timedlock().  Returns
+ *   ETIMEDOUT if the timed lock gave up.
+ *
+ ****************************************************************************/
+
+static int mutexbench_take(FAR struct mutexbench_thread_s *self,
+                           uint32_t loop)
+{
+  FAR pthread_mutex_t *mutex = &g_mutexbench.mutex;
+  struct timespec abstime;
+  int ret;
+
+  switch (loop % 3)
+    {
+      case 0:
+        return pthread_mutex_lock(mutex);
+
+      case 1:
+        ret = pthread_mutex_trylock(mutex);
+        if (ret == EBUSY)
+          {
+            self->nbusy++;
+            ret = pthread_mutex_lock(mutex);
+          }
+
+        return ret;
+
+      default:
+        clock_gettime(CLOCK_REALTIME, &abstime);
+        abstime.tv_nsec += MUTEXBENCH_TIMEOUT;
+        if (abstime.tv_nsec >= NSEC_PER_SEC)
+          {
+            abstime.tv_sec++;
+            abstime.tv_nsec -= NSEC_PER_SEC;
+          }
+
+        ret = pthread_mutex_timedlock(mutex, &abstime);
+        if (ret == ETIMEDOUT)
+          {
+            self->ntimedout++;
+          }
+
+        return ret;
+    }
+}
+
+/****************************************************************************
+ * Name: mutexbench_thread
+ *
+ * Description:
+ *   One thread of the stress test.  Each pass takes the shared mutex,
+ *   checks that no other thread holds it and increments the shared
+ *   counter.  Every few passes the thread yields with the mutex held so
+ *   that the other threads find it taken.
+ *
+ ****************************************************************************/
+
+static FAR void *mutexbench_thread(FAR void *arg)
+{
+  FAR struct mutexbench_thread_s *self = arg;
+  FAR pthread_mutex_t *mutex = &g_mutexbench.mutex;
+  uint32_t i;
+  int ret;
+
+  for (i = 0; i < MUTEXBENCH_NLOOPS; i++)
+    {
+      ret = mutexbench_take(self, i);
+      if (ret == ETIMEDOUT)
+        {
+          continue;
+        }
+      else if (ret != 0)
+        {
+          self->errcode = ret;
+          break;
+        }
+
+      if (g_mutexbench.inside)
+        {
+          self->errcode = EDEADLK;
+          pthread_mutex_unlock(mutex);
+          break;
+        }
+
+      g_mutexbench.inside = true;
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      if (g_mutexbench.recursive)
+        {
+          ret = pthread_mutex_lock(mutex);
+          if (ret == 0)
+            {
+              ret = pthread_mutex_unlock(mutex);
+            }
+
+          if (ret != 0)
+            {
+              self->errcode = ret;
+              g_mutexbench.inside = false;
+              pthread_mutex_unlock(mutex);
+              break;
+            }
+        }
+#endif
+
+      g_mutexbench.counter++;
+      self->nlocked++;
+
+      if ((i & 15) == 0)
+        {
+          sched_yield();
+        }
+
+      g_mutexbench.inside = false;
+
+      ret = pthread_mutex_unlock(mutex);
+      if (ret != 0)
+        {
+          self->errcode = ret;
+          break;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: mutexbench_stress
+ *
+ * Description:
+ *   Run the stress test with 1 to CONFIG_SIM_MUTEXBENCH_NTHREADS threads on
+ *   a mutex of the given type.  Afterwards, the shared counter must match
+ *   the number of times that the threads took the mutex, and the mutex
+ *   must be free again with a semaphore count of one.
+ *
+ ****************************************************************************/
+
+static int mutexbench_stress(int type, FAR const char *name,
+                             int nthreads)
+{
+  FAR struct mutexbench_thread_s *thread;
+  uint32_t nlocked = 0;
+  uint32_t nbusy = 0;
+  uint32_t ntimedout = 0;
+  uint64_t elapsed;
+  uint64_t start;
+  int semcount;
+  int errcode = 0;
+  int ncreated;
+  int ret;
+
+  memset(&g_mutexbench, 0, sizeof(struct mutexbench_s));
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  g_mutexbench.recursive = (type == PTHREAD_MUTEX_RECURSIVE);
+#endif
+
+  ret = mutexbench_init(&g_mutexbench.mutex, type);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  start = host_gettime(false);
+  for (ncreated = 0; ncreated < nthreads; ncreated++)
+    {
+      thread = &g_mutexbench.threads[ncreated];
+      ret = pthread_create(&thread->thread, NULL, mutexbench_thread,
+                           thread);
+      if (ret != 0)
+        {
+          syslog(LOG_ERR, "ERROR: pthread_create failed: %d\n", ret);
+          errcode = ret;
+          break;
+        }
+    }
+
+  while (ncreated > 0)
+    {
+      thread = &g_mutexbench.threads[--ncreated];
+      pthread_join(thread->thread, NULL);
+
+      nlocked   += thread->nlocked;
+      nbusy     += thread->nbusy;
+      ntimedout += thread->ntimedout;
+      if (errcode == 0)
+        {
+          errcode = thread->errcode;
+        }
+    }
+
+  elapsed = host_gettime(false) - start;
+
+  if (errcode == 0 && g_mutexbench.counter != nlocked)
+    {
+      syslog(LOG_ERR, "ERROR: %s counter is %lu, expected %lu\n",
+             name, (unsigned long)g_mutexbench.counter,
+             (unsigned long)nlocked);
+      errcode = EIO;
+    }
+
+  /* The mutex must be free and nobody may be left on its semaphore */
+
+  if (errcode == 0)
+    {
+      ret = pthread_mutex_trylock(&g_mutexbench.mutex);
+      if (ret == 0)
+        {
+          ret = pthread_mutex_unlock(&g_mutexbench.mutex);
+        }
+
+      nxsem_get_value(&g_mutexbench.mutex.sem, &semcount);
+      if (ret != 0 || semcount != 1)
+        {
+          syslog(LOG_ERR, "ERROR: %s mutex not free: %d, count %d\n",
+                 name, ret, semcount);
+          errcode = EIO;
+        }
+    }
+
+  ret = pthread_mutex_destroy(&g_mutexbench.mutex);
+  if (errcode == 0)
+    {
+      errcode = ret;
+    }
+
+  if (errcode != 0)
+    {
+      syslog(LOG_ERR, "ERROR: %s stress test with %d threads failed: %d\n",
+             name, nthreads, errcode);
+      return -errcode;
+    }
+
+  syslog(LOG_INFO, "mutexbench: %-9s %d threads: %7lu locks in %7lu us, "
+         "%lu busy, %lu timed out\n",
+         name, nthreads, (unsigned long)nlocked,
+         (unsigned long)(elapsed / 1000), (unsigned long)nbusy,
+         (unsigned long)ntimedout);
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mutexbench_run
+ ****************************************************************************/
+
+static int mutexbench_run(int type, FAR const char *name)
+{
+  int nthreads;
+  int ret;
+
+  ret = mutexbench_latency(type, name);
+  for (nthreads = 1; nthreads <= MUTEXBENCH_NTHREADS && ret >= 0;
+       nthreads++)
+    {
+      ret = mutexbench_stress(type, name, nthreads);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_mutexbench
+ *
+ * Description:
+ *   Log the cost of an uncontended pthread mutex lock/unlock pair, then
+ *   stress the mutex with 1 to CONFIG_SIM_MUTEXBENCH_NTHREADS threads that
+ *   mix pthread_mutex_lock(), pthread_mutex_trylock() and
+ *   pthread_mutex_timedlock().  This is done for NORMAL and, with
+ *   CONFIG_PTHREAD_MUTEX_TYPES, for RECURSIVE mutexes.  Returns a negated
+ *   errno value if mutual exclusion was broken or the mutex was not left
+ *   free.
+ *
+ ****************************************************************************/
+
+int sim_mutexbench(void)
+{
+  int ret;
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+  ret = mutexbench_run(PTHREAD_MUTEX_NORMAL, "normal");
+  if (ret >= 0)
+    {
+      ret = mutexbench_run(PTHREAD_MUTEX_RECURSIVE, "recursive");
+    }
+#else
+  ret = mutexbench_run(0, "default");
+#endif
+
+  if (ret >= 0)
+    {
+      syslog(LOG_INFO, "mutexbench: passed\n");
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_SIM_MUTEXBENCH */
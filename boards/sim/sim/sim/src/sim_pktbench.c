@@ -0,0 +1,353 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_pktbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <poll.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <net/if.h>
+#include <netpacket/packet.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_PKTBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PKTBENCH_IFNAME     "eth0"
+#define PKTBENCH_NFRAMES    CONFIG_SIM_PKTBENCH_NFRAMES
+#define PKTBENCH_NSLOTS     64
+#define PKTBENCH_MAXFRAME   1514
+#define PKTBENCH_SLOTSIZE   TPACKET_ALIGN(TPACKET_HDRLEN + PKTBENCH_MAXFRAME)
+#define PKTBENCH_FRAMELEN   60
+#define PKTBENCH_ETHERTYPE  0x88b5  /* Local experimental */
+
+#define PKTBENCH_SLOT(r,i) \
+  ((FAR struct tpacket_hdr *)((r) + (i) * PKTBENCH_SLOTSIZE))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pktbench_report
+ ****************************************************************************/
+
+static void pktbench_report(FAR const char *name, uint32_t nframes,
+                            uint64_t start)
+{
+  uint64_t elapsed = host_gettime(false) - start;
+  uint64_t rate;
+
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  rate = (uint64_t)nframes * 1000000000 / elapsed;
+  syslog(LOG_INFO, "pktbench: %-10s %6lu frames in %7lu us, %7lu frames/s\n",
+         name, (unsigned long)nframes, (unsigned long)(elapsed / 1000),
+         (unsigned long)rate);
+}
+
+/****************************************************************************
+ * Name: pktbench_setring
+ ****************************************************************************/
+
+static int pktbench_setring(FAR struct socket *psock, int option,
+                            FAR uint8_t *ring)
+{
+  struct tpacket_req req;
+
+  req.tp_ring       = ring;
+  req.tp_frame_size = PKTBENCH_SLOTSIZE;
+  req.tp_frame_nr   = ring != NULL ? PKTBENCH_NSLOTS : 0;
+
+  return psock_setsockopt(psock, SOL_PACKET, option, &req,
+                          sizeof(struct tpacket_req));
+}
+
+/****************************************************************************
+ * Name: pktbench_send
+ *
+ * Description:
+ *   Send the same number of small broadcast frames with one send() per
+ *   frame and then in batches through the transmit ring.
+ *
+ ****************************************************************************/
+
+static int pktbench_send(FAR struct socket *psock, FAR uint8_t *ring)
+{
+  FAR struct tpacket_hdr *hdr;
+  uint8_t frame[PKTBENCH_FRAMELEN];
+  uint64_t start;
+  uint32_t nsent;
+  uint32_t batch;
+  uint32_t i;
+  ssize_t ret;
+
+  memset(frame, 0, sizeof(frame));
+  memset(frame, 0xff, 6);
+  frame[6]  = 0x02;
+  frame[11] = 0x01;
+  frame[12] = PKTBENCH_ETHERTYPE >> 8;
+  frame[13] = PKTBENCH_ETHERTYPE & 0xff;
+
+  start = host_gettime(false);
+  for (nsent = 0; nsent < PKTBENCH_NFRAMES; nsent++)
+    {
+      ret = psock_send(psock, frame, sizeof(frame), 0);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_send failed: %d\n", (int)ret);
+          return ret;
+        }
+    }
+
+  pktbench_report("send", nsent, start);
+
+  ret = pktbench_setring(psock, PACKET_TX_RING, ring);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  start = host_gettime(false);
+  for (nsent = 0; nsent < PKTBENCH_NFRAMES; nsent += batch)
+    {
+      batch = PKTBENCH_NFRAMES - nsent;
+      if (batch > PKTBENCH_NSLOTS)
+        {
+          batch = PKTBENCH_NSLOTS;
+        }
+
+      for (i = 0; i < batch; i++)
+        {
+          hdr = PKTBENCH_SLOT(ring, i);
+          memcpy((FAR uint8_t *)hdr + TPACKET_HDRLEN, frame, sizeof(frame));
+          hdr->tp_len = sizeof(frame);
+          __atomic_store_n(&hdr->tp_status, TP_STATUS_SEND_REQUEST,
+                           __ATOMIC_RELEASE);
+        }
+
+      ret = psock_send(psock, frame, 0, 0);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: ring send failed: %d\n", (int)ret);
+          break;
+        }
+    }
+
+  if (ret >= 0)
+    {
+      pktbench_report("tx ring", nsent, start);
+    }
+
+  pktbench_setring(psock, PACKET_TX_RING, NULL);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Name: pktbench_recv
+ *
+ * Description:
+ *   Receive the same number of frames with one recvfrom() per frame and
+ *   then through the receive ring.  The frames have to be generated on the
+ *   host side of the interface.
+ *
+ ****************************************************************************/
+
+static int pktbench_recv(FAR struct socket *psock, FAR uint8_t *ring)
+{
+  FAR struct tpacket_hdr *hdr;
+  struct pollfd fds;
+  sem_t sem;
+  uint64_t start;
+  uint32_t nrecvd;
+  uint32_t nlosing = 0;
+  uint16_t head = 0;
+  ssize_t ret;
+
+  start = host_gettime(false);
+  for (nrecvd = 0; nrecvd < PKTBENCH_NFRAMES; nrecvd++)
+    {
+      ret = psock_recvfrom(psock, ring, PKTBENCH_MAXFRAME, 0, NULL, NULL);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_recvfrom failed: %d\n", (int)ret);
+          return ret;
+        }
+    }
+
+  pktbench_report("recvfrom", nrecvd, start);
+
+  ret = pktbench_setring(psock, PACKET_RX_RING, ring);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&sem, 0, 0);
+  nxsem_set_protocol(&sem, SEM_PRIO_NONE);
+
+  start  = host_gettime(false);
+  nrecvd = 0;
+
+  while (nrecvd < PKTBENCH_NFRAMES)
+    {
+      hdr = PKTBENCH_SLOT(ring, head);
+      if ((__atomic_load_n(&hdr->tp_status, __ATOMIC_ACQUIRE) &
+           TP_STATUS_USER) != 0)
+        {
+          if ((hdr->tp_status & TP_STATUS_LOSING) != 0)
+            {
+              nlosing++;
+            }
+
+          __atomic_store_n(&hdr->tp_status, TP_STATUS_KERNEL,
+                           __ATOMIC_RELEASE);
+          head = (head + 1) % PKTBENCH_NSLOTS;
+          nrecvd++;
+          continue;
+        }
+
+      /* Nothing in the ring, wait for the next frame */
+
+      memset(&fds, 0, sizeof(struct pollfd));
+      fds.events = POLLIN;
+      fds.sem    = &sem;
+
+      ret = psock_poll(psock, &fds, true);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      if (fds.revents == 0)
+        {
+          ret = nxsem_wait(&sem);
+        }
+
+      psock_poll(psock, &fds, false);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  if (ret >= 0)
+    {
+      pktbench_report("rx ring", nrecvd, start);
+      syslog(LOG_INFO, "pktbench: rx ring lost frames %lu times\n",
+             (unsigned long)nlosing);
+    }
+
+  nxsem_destroy(&sem);
+  pktbench_setring(psock, PACKET_RX_RING, NULL);
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_pktbench
+ *
+ * Description:
+ *   Compare the per-frame socket calls of a packet socket with its frame
+ *   rings on the simulated Ethernet device.  The transmit benchmark sends
+ *   CONFIG_SIM_PKTBENCH_NFRAMES frames each way.  The receive benchmark,
+ *   selected by a non-zero 'rx', waits for the same number of frames each
+ *   way and so needs a traffic source on the host, such as a flood ping
+ *   to the tap interface.
+ *
+ ****************************************************************************/
+
+int sim_pktbench(bool rx)
+{
+  struct sockaddr_ll addr;
+  struct socket sock;
+  FAR uint8_t *ring;
+  int ret;
+
+  ring = (FAR uint8_t *)kmm_malloc(PKTBENCH_NSLOTS * PKTBENCH_SLOTSIZE);
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = psock_socket(AF_PACKET, SOCK_RAW, 0, &sock);
+  if (ret < 0)
+    {
+      goto errout_with_ring;
+    }
+
+  memset(&addr, 0, sizeof(struct sockaddr_ll));
+  addr.sll_family  = AF_PACKET;
+  addr.sll_ifindex = if_nametoindex(PKTBENCH_IFNAME);
+
+  ret = psock_bind(&sock, (FAR const struct sockaddr *)&addr,
+                   sizeof(struct sockaddr_ll));
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_bind failed: %d\n", ret);
+      goto errout_with_socket;
+    }
+
+  if (rx)
+    {
+      ret = pktbench_recv(&sock, ring);
+    }
+  else
+    {
+      ret = pktbench_send(&sock, ring);
+    }
+
+errout_with_socket:
+  psock_close(&sock);
+
+errout_with_ring:
+  kmm_free(ring);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_PKTBENCH */
@@ -0,0 +1,242 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_routebench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/net/ip.h>
+
+#include "route/route.h"
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_ROUTEBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ROUTEBENCH_NROUTES  CONFIG_SIM_ROUTEBENCH_NROUTES
+#define ROUTEBENCH_NLOOKUPS CONFIG_SIM_ROUTEBENCH_NLOOKUPS
+#define ROUTEBENCH_NHOT     8
+
+/* The benchmark routes are 10.x.y.0/24 via 192.168.0.1 */
+
+#define ROUTEBENCH_NET(i)   HTONL(0x0a000000 | ((uint32_t)(i) << 8))
+#define ROUTEBENCH_MASK     HTONL(0xffffff00)
+#define ROUTEBENCH_ROUTER   HTONL(0xc0a80001)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct routebench_match_s
+{
+  in_addr_t target;             /* Address being looked up */
+  in_addr_t router;             /* Router of the first matching route */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: routebench_report
+ ****************************************************************************/
+
+static void routebench_report(FAR const char *name, uint32_t nmisses,
+                              uint64_t start)
+{
+  uint64_t elapsed = host_gettime(false) - start;
+  uint64_t rate;
+
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  rate = (uint64_t)ROUTEBENCH_NLOOKUPS * 1000000000 / elapsed;
+  syslog(LOG_INFO, "routebench: %-12s %7lu lookups in %7lu us, "
+         "%8lu lookups/s, %lu misses\n",
+         name, (unsigned long)ROUTEBENCH_NLOOKUPS,
+         (unsigned long)(elapsed / 1000), (unsigned long)rate,
+         (unsigned long)nmisses);
+}
+
+/****************************************************************************
+ * Name: routebench_target
+ *
+ * Description:
+ *   Return the destination of lookup 'n'.  A hot workload cycles through
+ *   a few hosts on the last networks in the table, which are the most
+ *   expensive ones for a linear walk.  A cold workload picks a pseudo-
+ *   random host on a pseudo-random network so that the destination cache
+ *   rarely hits.
+ *
+ ****************************************************************************/
+
+static in_addr_t routebench_target(FAR uint32_t *seed, uint32_t n,
+                                   bool hot)
+{
+  uint32_t net;
+  uint32_t host;
+
+  if (hot)
+    {
+      net  = ROUTEBENCH_NROUTES - 1 -
+             (n % ROUTEBENCH_NHOT) % ROUTEBENCH_NROUTES;
+      host = 1;
+    }
+  else
+    {
+      *seed = *seed * 1103515245 + 12345;
+      net   = (*seed >> 16) % ROUTEBENCH_NROUTES;
+      host  = (*seed >> 8) & 0xff;
+    }
+
+  return ROUTEBENCH_NET(net) | HTONL(host);
+}
+
+/****************************************************************************
+ * Name: routebench_match
+ *
+ * Description:
+ *   Take the first route whose network contains the target, as the
+ *   routing table lookup did before the prefix trie.
+ *
+ ****************************************************************************/
+
+static int routebench_match(FAR struct net_route_ipv4_s *route,
+                            FAR void *arg)
+{
+  FAR struct routebench_match_s *match = arg;
+
+  if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask))
+    {
+      net_ipv4addr_copy(match->router, route->router);
+      return 1;
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Name: routebench_run
+ ****************************************************************************/
+
+static void routebench_run(bool hot)
+{
+  struct routebench_match_s match;
+  in_addr_t router;
+  uint64_t start;
+  uint32_t nmisses;
+  uint32_t seed;
+  uint32_t i;
+
+  /* The linear walk of the routing table */
+
+  seed    = 1;
+  nmisses = 0;
+  start   = host_gettime(false);
+
+  for (i = 0; i < ROUTEBENCH_NLOOKUPS; i++)
+    {
+      match.target = routebench_target(&seed, i, hot);
+      if (net_foreachroute_ipv4(routebench_match, &match) <= 0)
+        {
+          nmisses++;
+        }
+    }
+
+  routebench_report(hot ? "linear hot" : "linear cold", nmisses, start);
+
+  /* The prefix trie behind the destination cache */
+
+  seed    = 1;
+  nmisses = 0;
+  start   = host_gettime(false);
+
+  for (i = 0; i < ROUTEBENCH_NLOOKUPS; i++)
+    {
+      if (net_ipv4_router(routebench_target(&seed, i, hot), &router) < 0)
+        {
+          nmisses++;
+        }
+    }
+
+  routebench_report(hot ? "trie hot" : "trie cold", nmisses, start);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_routebench
+ *
+ * Description:
+ *   Add CONFIG_SIM_ROUTEBENCH_NROUTES /24 routes to the IPv4 routing table
+ *   and compare the lookup rate of a linear first-match walk of the table
+ *   with net_ipv4_router(), which uses the prefix trie and its destination
+ *   cache.  Each is timed with a cache-friendly and a cache-hostile set of
+ *   destinations.  The routes are removed again afterwards.
+ *
+ ****************************************************************************/
+
+int sim_routebench(void)
+{
+  uint32_t nadded;
+  int ret = OK;
+
+  for (nadded = 0; nadded < ROUTEBENCH_NROUTES; nadded++)
+    {
+      ret = net_addroute_ipv4(ROUTEBENCH_NET(nadded), ROUTEBENCH_MASK,
+                              ROUTEBENCH_ROUTER);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: net_addroute_ipv4 failed: %d\n", ret);
+          goto errout_with_routes;
+        }
+    }
+
+  routebench_run(true);
+  routebench_run(false);
+
+errout_with_routes:
+  while (nadded > 0)
+    {
+      nadded--;
+      net_delroute_ipv4(ROUTEBENCH_NET(nadded), ROUTEBENCH_MASK);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_SIM_ROUTEBENCH */
@@ -0,0 +1,335 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_txbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_TXBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TXBENCH_NPAIRS      CONFIG_SIM_TXBENCH_NPAIRS
+#define TXBENCH_NPACKETS    CONFIG_SIM_TXBENCH_NPACKETS
+#define TXBENCH_NSTEPS      4
+#define TXBENCH_TCPPORT     5471
+#define TXBENCH_UDPPORT     5472
+#define TXBENCH_DATALEN     64
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct txbench_s
+{
+  struct socket listener;       /* Listens for the idle TCP connections */
+  struct socket tx;             /* Sends the measured UDP packets */
+  struct socket rx;             /* Receives the measured UDP packets */
+  FAR struct socket *idle;      /* Both ends of each idle TCP connection */
+  unsigned int npairs;          /* Number of idle TCP connections */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: txbench_addr
+ ****************************************************************************/
+
+static void txbench_addr(FAR struct sockaddr_in *addr, uint16_t port)
+{
+  memset(addr, 0, sizeof(struct sockaddr_in));
+  addr->sin_family      = AF_INET;
+  addr->sin_port        = HTONS(port);
+  addr->sin_addr.s_addr = HTONL(INADDR_LOOPBACK);
+}
+
+/****************************************************************************
+ * Name: txbench_addpair
+ *
+ * Description:
+ *   Open one more TCP connection over the loopback device and leave both
+ *   ends of it idle.  The connection is completed in the backlog of the
+ *   listener, so it can be accepted after connect() has returned.
+ *
+ ****************************************************************************/
+
+static int txbench_addpair(FAR struct txbench_s *bench)
+{
+  FAR struct socket *client = &bench->idle[2 * bench->npairs];
+  FAR struct socket *server = client + 1;
+  struct sockaddr_in addr;
+  int ret;
+
+  ret = psock_socket(AF_INET, SOCK_STREAM, 0, client);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  txbench_addr(&addr, TXBENCH_TCPPORT);
+  ret = psock_connect(client, (FAR const struct sockaddr *)&addr,
+                      sizeof(struct sockaddr_in));
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_connect failed: %d\n", ret);
+      goto errout_with_client;
+    }
+
+  ret = psock_accept(&bench->listener, NULL, NULL, server);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_accept failed: %d\n", ret);
+      goto errout_with_client;
+    }
+
+  bench->npairs++;
+  return OK;
+
+errout_with_client:
+  psock_close(client);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: txbench_measure
+ *
+ * Description:
+ *   Send CONFIG_SIM_TXBENCH_NPACKETS UDP packets over the loopback device,
+ *   receiving each one before the next is sent, and log the packet rate.
+ *
+ ****************************************************************************/
+
+static int txbench_measure(FAR struct txbench_s *bench)
+{
+  uint8_t data[TXBENCH_DATALEN];
+  struct sockaddr_in addr;
+  uint64_t elapsed;
+  uint64_t start;
+  uint32_t i;
+  ssize_t ret;
+
+  memset(data, 0x5a, sizeof(data));
+  txbench_addr(&addr, TXBENCH_UDPPORT);
+
+  start = host_gettime(false);
+  for (i = 0; i < TXBENCH_NPACKETS; i++)
+    {
+      ret = psock_sendto(&bench->tx, data, sizeof(data), 0,
+                         (FAR const struct sockaddr *)&addr,
+                         sizeof(struct sockaddr_in));
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_sendto failed: %d\n", (int)ret);
+          return ret;
+        }
+
+      ret = psock_recvfrom(&bench->rx, data, sizeof(data), 0, NULL, NULL);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_recvfrom failed: %d\n", (int)ret);
+          return ret;
+        }
+    }
+
+  elapsed = host_gettime(false) - start;
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  syslog(LOG_INFO, "txbench: %4u idle connections: %6lu packets in "
+         "%7lu us, %7lu packets/s\n",
+         2 * bench->npairs, (unsigned long)TXBENCH_NPACKETS,
+         (unsigned long)(elapsed / 1000),
+         (unsigned long)((uint64_t)TXBENCH_NPACKETS * 1000000000 /
+                         elapsed));
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: txbench_open
+ *
+ * Description:
+ *   Open the TCP listener and the pair of UDP sockets.
+ *
+ ****************************************************************************/
+
+static int txbench_open(FAR struct txbench_s *bench)
+{
+  struct sockaddr_in addr;
+  int ret;
+
+  ret = psock_socket(AF_INET, SOCK_STREAM, 0, &bench->listener);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  txbench_addr(&addr, TXBENCH_TCPPORT);
+  ret = psock_bind(&bench->listener, (FAR const struct sockaddr *)&addr,
+                   sizeof(struct sockaddr_in));
+  if (ret >= 0)
+    {
+      ret = psock_listen(&bench->listener, TXBENCH_NPAIRS);
+    }
+
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: TCP listener setup failed: %d\n", ret);
+      goto errout_with_listener;
+    }
+
+  ret = psock_socket(AF_INET, SOCK_DGRAM, 0, &bench->rx);
+  if (ret < 0)
+    {
+      goto errout_with_listener;
+    }
+
+  txbench_addr(&addr, TXBENCH_UDPPORT);
+  ret = psock_bind(&bench->rx, (FAR const struct sockaddr *)&addr,
+                   sizeof(struct sockaddr_in));
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_bind failed: %d\n", ret);
+      goto errout_with_rx;
+    }
+
+  ret = psock_socket(AF_INET, SOCK_DGRAM, 0, &bench->tx);
+  if (ret < 0)
+    {
+      goto errout_with_rx;
+    }
+
+  return OK;
+
+errout_with_rx:
+  psock_close(&bench->rx);
+
+errout_with_listener:
+  psock_close(&bench->listener);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_txbench
+ *
+ * Description:
+ *   Measure the UDP packet rate over the loopback device as up to
+ *   CONFIG_SIM_TXBENCH_NPAIRS idle TCP connections are added, in
+ *   TXBENCH_NSTEPS steps.  Every packet gives the device a transmit
+ *   opportunity, so the rate shows how the cost of devif_poll() grows
+ *   with the number of idle connections.  All sockets are closed again
+ *   afterwards.
+ *
+ ****************************************************************************/
+
+int sim_txbench(void)
+{
+  struct txbench_s bench;
+  unsigned int target;
+  unsigned int step;
+  int ret;
+
+  memset(&bench, 0, sizeof(struct txbench_s));
+
+  bench.idle = (FAR struct socket *)
+    kmm_malloc(2 * TXBENCH_NPAIRS * sizeof(struct socket));
+  if (bench.idle == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ret = txbench_open(&bench);
+  if (ret < 0)
+    {
+      goto errout_with_idle;
+    }
+
+  step = (TXBENCH_NPAIRS + TXBENCH_NSTEPS - 1) / TXBENCH_NSTEPS;
+
+  for (; ; )
+    {
+      ret = txbench_measure(&bench);
+      if (ret < 0 || bench.npairs >= TXBENCH_NPAIRS)
+        {
+          break;
+        }
+
+      target = bench.npairs + step;
+      if (target > TXBENCH_NPAIRS)
+        {
+          target = TXBENCH_NPAIRS;
+        }
+
+      while (bench.npairs < target && ret >= 0)
+        {
+          ret = txbench_addpair(&bench);
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+    }
+
+  while (bench.npairs > 0)
+    {
+      bench.npairs--;
+      psock_close(&bench.idle[2 * bench.npairs + 1]);
+      psock_close(&bench.idle[2 * bench.npairs]);
+    }
+
+  psock_close(&bench.tx);
+  psock_close(&bench.rx);
+  psock_close(&bench.listener);
+
+errout_with_idle:
+  kmm_free(bench.idle);
+  return ret;
+}
+
+#endif /* CONFIG_SIM_TXBENCH */
@@ -0,0 +1,518 @@
+/****************************************************************************
+ * boards/sim/sim/sim/src/sim_usrsockbench.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <syslog.h>
+#include <errno.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/usrsock.h>
+
+#include "up_internal.h"
+#include "sim.h"
+
+#ifdef CONFIG_SIM_USRSOCKBENCH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define USRSOCKBENCH_NOPS     CONFIG_SIM_USRSOCKBENCH_NOPS
+#define USRSOCKBENCH_DATALEN  16
+#define USRSOCKBENCH_MSGSIZE  128
+#define USRSOCKBENCH_NSLOTS   16
+#define USRSOCKBENCH_SLOTSIZE (sizeof(struct usrsock_ringslot_s) + \
+                               USRSOCKBENCH_MSGSIZE)
+
+/* The benchmark daemon hands out a single socket */
+
+#define USRSOCKBENCH_USOCKID  0
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* State shared with the daemon thread */
+
+struct usrsockbench_s
+{
+  struct file filep;            /* /dev/usrsock */
+  sem_t pollsem;                /* Wakes up the daemon */
+  sem_t done;                   /* Posted when the daemon thread exits */
+  FAR uint8_t *sq;              /* Submission ring (NULL: read/write) */
+  FAR uint8_t *cq;              /* Completion ring */
+  uint16_t sqtail;              /* Next submission slot to take */
+  uint16_t cqhead;              /* Next completion slot to fill */
+  volatile bool stop;           /* Tells the daemon thread to exit */
+  int result;                   /* Result of the daemon thread */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct usrsockbench_s g_usrsockbench;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: usrsockbench_report
+ ****************************************************************************/
+
+static void usrsockbench_report(FAR const char *name, uint32_t nops,
+                                uint64_t start)
+{
+  uint64_t elapsed = host_gettime(false) - start;
+  uint64_t rate;
+
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  rate = (uint64_t)nops * 1000000000 / elapsed;
+  syslog(LOG_INFO, "usrsockbench: %-10s %7lu ops in %7lu us, %7lu ops/s\n",
+         name, (unsigned long)nops, (unsigned long)(elapsed / 1000),
+         (unsigned long)rate);
+}
+
+/****************************************************************************
+ * Name: usrsockbench_reply
+ *
+ * Description:
+ *   Pass one message to the kernel, either with write() or through the
+ *   completion ring.  A full completion ring is handed to the kernel first.
+ *
+ ****************************************************************************/
+
+static int usrsockbench_reply(FAR struct usrsockbench_s *bench,
+                              FAR const void *msg, size_t len)
+{
+  FAR struct usrsock_ringslot_s *slot;
+  ssize_t ret;
+
+  if (bench->cq == NULL)
+    {
+      ret = file_write(&bench->filep, msg, len);
+      return ret < 0 ? ret : OK;
+    }
+
+  slot = USRSOCK_RING_SLOT(bench->cq, USRSOCKBENCH_SLOTSIZE, bench->cqhead);
+  if (__atomic_load_n(&slot->status, __ATOMIC_ACQUIRE) != USRSOCK_SLOT_FREE)
+    {
+      ret = file_ioctl(&bench->filep, USRSOCKIOC_KICK, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  memcpy(slot + 1, msg, len);
+  slot->len = len;
+  __atomic_store_n(&slot->status, USRSOCK_SLOT_READY, __ATOMIC_RELEASE);
+
+  if (++bench->cqhead >= USRSOCKBENCH_NSLOTS)
+    {
+      bench->cqhead = 0;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: usrsockbench_handle
+ *
+ * Description:
+ *   Answer one request.  Every socket() gets the same socket, every
+ *   sendto() sinks all of its data and is followed by a send-ready event,
+ *   and everything else fails with ENOTSUP.
+ *
+ ****************************************************************************/
+
+static int usrsockbench_handle(FAR struct usrsockbench_s *bench,
+                               FAR const uint8_t *req, size_t len)
+{
+  FAR const struct usrsock_request_common_s *head;
+  FAR const struct usrsock_request_sendto_s *sendreq;
+  struct usrsock_message_socket_event_s event;
+  struct usrsock_message_req_ack_s ack;
+  bool ready = false;
+  int ret;
+
+  if (len < sizeof(struct usrsock_request_common_s))
+    {
+      return -EINVAL;
+    }
+
+  head = (FAR const struct usrsock_request_common_s *)req;
+
+  memset(&ack, 0, sizeof(struct usrsock_message_req_ack_s));
+  ack.head.msgid = USRSOCK_MESSAGE_RESPONSE_ACK;
+  ack.xid        = head->xid;
+
+  switch (head->reqid)
+    {
+      case USRSOCK_REQUEST_SOCKET:
+        ack.result = USRSOCKBENCH_USOCKID;
+        ready      = true;
+        break;
+
+      case USRSOCK_REQUEST_SENDTO:
+        if (len < sizeof(struct usrsock_request_sendto_s))
+          {
+            return -EINVAL;
+          }
+
+        sendreq    = (FAR const struct usrsock_request_sendto_s *)req;
+        ack.result = sendreq->buflen;
+        ready      = true;
+        break;
+
+      case USRSOCK_REQUEST_CLOSE:
+        ack.result = OK;
+        break;
+
+      default:
+        ack.result = -ENOTSUP;
+        break;
+    }
+
+  ret = usrsockbench_reply(bench, &ack, sizeof(ack));
+  if (ret < 0 || !ready)
+    {
+      return ret;
+    }
+
+  memset(&event, 0, sizeof(struct usrsock_message_socket_event_s));
+  event.head.msgid = USRSOCK_MESSAGE_SOCKET_EVENT;
+  event.head.flags = USRSOCK_MESSAGE_FLAG_EVENT;
+  event.usockid    = USRSOCKBENCH_USOCKID;
+  event.events     = USRSOCK_EVENT_SENDTO_READY;
+
+  return usrsockbench_reply(bench, &event, sizeof(event));
+}
+
+/****************************************************************************
+ * Name: usrsockbench_serve
+ *
+ * Description:
+ *   Answer all pending requests.
+ *
+ ****************************************************************************/
+
+static int usrsockbench_serve(FAR struct usrsockbench_s *bench)
+{
+  FAR struct usrsock_ringslot_s *slot;
+  uint8_t buffer[USRSOCKBENCH_MSGSIZE];
+  ssize_t nread;
+  int nhandled = 0;
+  int ret;
+
+  if (bench->sq == NULL)
+    {
+      nread = file_read(&bench->filep, buffer, sizeof(buffer));
+      if (nread <= 0)
+        {
+          return nread;
+        }
+
+      return usrsockbench_handle(bench, buffer, nread);
+    }
+
+  /* Take the whole batch of requests, then hand all of the responses to
+   * the kernel with a single kick.
+   */
+
+  for (; ; )
+    {
+      slot = USRSOCK_RING_SLOT(bench->sq, USRSOCKBENCH_SLOTSIZE,
+                               bench->sqtail);
+      if (__atomic_load_n(&slot->status, __ATOMIC_ACQUIRE) !=
+          USRSOCK_SLOT_READY)
+        {
+          break;
+        }
+
+      ret = usrsockbench_handle(bench, (FAR const uint8_t *)(slot + 1),
+                                slot->len);
+
+      __atomic_store_n(&slot->status, USRSOCK_SLOT_FREE, __ATOMIC_RELEASE);
+      if (++bench->sqtail >= USRSOCKBENCH_NSLOTS)
+        {
+          bench->sqtail = 0;
+        }
+
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      nhandled++;
+    }
+
+  if (nhandled > 0)
+    {
+      ret = file_ioctl(&bench->filep, USRSOCKIOC_KICK, 0);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: usrsockbench_daemon
+ *
+ * Description:
+ *   A stand-in for the usrsock daemon that answers requests as soon as
+ *   /dev/usrsock reports them.
+ *
+ ****************************************************************************/
+
+static int usrsockbench_daemon(int argc, FAR char *argv[])
+{
+  FAR struct usrsockbench_s *bench = &g_usrsockbench;
+  struct pollfd fds;
+  int ret = OK;
+
+  while (!bench->stop)
+    {
+      memset(&fds, 0, sizeof(struct pollfd));
+      fds.events = POLLIN;
+      fds.sem    = &bench->pollsem;
+
+      ret = file_poll(&bench->filep, &fds, true);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      if (fds.revents == 0)
+        {
+          ret = nxsem_wait(&bench->pollsem);
+        }
+
+      file_poll(&bench->filep, &fds, false);
+      if (ret < 0 || bench->stop)
+        {
+          break;
+        }
+
+      ret = usrsockbench_serve(bench);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: usrsockbench daemon failed: %d\n", ret);
+          break;
+        }
+    }
+
+  bench->result = ret;
+  nxsem_post(&bench->done);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: usrsockbench_run
+ *
+ * Description:
+ *   Start the daemon thread on /dev/usrsock, with or without the
+ *   shared-memory rings, and time CONFIG_SIM_USRSOCKBENCH_NOPS send()
+ *   calls on a usrsock datagram socket.
+ *
+ ****************************************************************************/
+
+static int usrsockbench_run(bool ring)
+{
+  FAR struct usrsockbench_s *bench = &g_usrsockbench;
+  uint8_t data[USRSOCKBENCH_DATALEN];
+  FAR uint8_t *rings = NULL;
+  struct socket sock;
+  uint64_t start;
+  uint32_t nops;
+  pid_t pid;
+  ssize_t ret;
+
+  memset(bench, 0, sizeof(struct usrsockbench_s));
+  memset(data, 0x5a, sizeof(data));
+
+  ret = file_open(&bench->filep, "/dev/usrsock", O_RDWR);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: Failed to open /dev/usrsock: %d\n",
+             (int)ret);
+      return ret;
+    }
+
+#ifdef CONFIG_NET_USRSOCK_RING
+  if (ring)
+    {
+      struct usrsock_ring_s setring;
+
+      rings = (FAR uint8_t *)
+        kmm_malloc(2 * USRSOCKBENCH_NSLOTS * USRSOCKBENCH_SLOTSIZE);
+      if (rings == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_file;
+        }
+
+      bench->sq = rings;
+      bench->cq = rings + USRSOCKBENCH_NSLOTS * USRSOCKBENCH_SLOTSIZE;
+
+      setring.sq       = bench->sq;
+      setring.cq       = bench->cq;
+      setring.slotsize = USRSOCKBENCH_SLOTSIZE;
+      setring.nslots   = USRSOCKBENCH_NSLOTS;
+
+      ret = file_ioctl(&bench->filep, USRSOCKIOC_SETRING,
+                       (unsigned long)((uintptr_t)&setring));
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: USRSOCKIOC_SETRING failed: %d\n",
+                 (int)ret);
+          goto errout_with_file;
+        }
+    }
+#endif
+
+  /* These semaphores are used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&bench->pollsem, 0, 0);
+  nxsem_set_protocol(&bench->pollsem, SEM_PRIO_NONE);
+  nxsem_init(&bench->done, 0, 0);
+  nxsem_set_protocol(&bench->done, SEM_PRIO_NONE);
+
+  pid = kthread_create("usrsockbench", SCHED_PRIORITY_DEFAULT,
+                       CONFIG_DEFAULT_TASK_STACKSIZE, usrsockbench_daemon,
+                       NULL);
+  if (pid < 0)
+    {
+      ret = pid;
+      goto errout_with_sem;
+    }
+
+  ret = psock_socket(AF_INET, SOCK_DGRAM, 0, &sock);
+  if (ret < 0)
+    {
+      syslog(LOG_ERR, "ERROR: psock_socket failed: %d\n", (int)ret);
+      goto errout_with_daemon;
+    }
+
+  start = host_gettime(false);
+  for (nops = 0; nops < USRSOCKBENCH_NOPS; nops++)
+    {
+      ret = psock_send(&sock, data, sizeof(data), 0);
+      if (ret < 0)
+        {
+          syslog(LOG_ERR, "ERROR: psock_send failed: %d\n", (int)ret);
+          break;
+        }
+    }
+
+  if (ret >= 0)
+    {
+      usrsockbench_report(ring ? "ring" : "read/write", nops, start);
+    }
+
+  psock_close(&sock);
+
+errout_with_daemon:
+  bench->stop = true;
+  nxsem_post(&bench->pollsem);
+  nxsem_wait_uninterruptible(&bench->done);
+
+  if (ret >= 0 && bench->result < 0)
+    {
+      ret = bench->result;
+    }
+
+errout_with_sem:
+  nxsem_destroy(&bench->done);
+  nxsem_destroy(&bench->pollsem);
+
+#ifdef CONFIG_NET_USRSOCK_RING
+errout_with_file:
+#endif
+
+  /* Closing /dev/usrsock also detaches the rings */
+
+  file_close(&bench->filep);
+  if (rings != NULL)
+    {
+      kmm_free(rings);
+    }
+
+  return ret < 0 ? ret : OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sim_usrsockbench
+ *
+ * Description:
+ *   Measure the rate of socket operations through the usrsock protocol
+ *   with an in-kernel stand-in for the daemon, first with read() and
+ *   write() on /dev/usrsock and then, if NET_USRSOCK_RING is enabled,
+ *   with the shared-memory request rings.  No other usrsock daemon may be
+ *   running.
+ *
+ ****************************************************************************/
+
+int sim_usrsockbench(void)
+{
+  int ret;
+
+  ret = usrsockbench_run(false);
+#ifdef CONFIG_NET_USRSOCK_RING
+  if (ret >= 0)
+    {
+      ret = usrsockbench_run(true);
+    }
+#endif
+
+  return ret;
+}
+
+#endif /* CONFIG_SIM_USRSOCKBENCH */
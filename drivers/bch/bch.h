@@ -56,6 +56,16 @@
 #define bchlib_semgive(d) nxsem_post(&(d)->sem)  /* To match bchlib_semtake */
 #define MAX_OPENCNT       (255)                  /* Limit of uint8_t */
 
+#ifndef CONFIG_BCH_CACHE_NSECTORS
+#  define CONFIG_BCH_CACHE_NSECTORS 1
+#endif
+
+/* Return the address of a cached sector.  The sector must have been brought
+ * into the cache by bchlib_readsector() or bchlib_writesector().
+ */
+
+#define BCH_SECTBUF(b,s)  (&(b)->buffer[((s) - (b)->sector) * (b)->sectsize])
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -65,13 +75,16 @@ struct bchlib_s
   FAR struct inode *inode; /* I-node of the block driver */
   uint32_t sectsize;       /* The size of one sector on the device */
   size_t nsectors;         /* Number of sectors supported by the device */
-  size_t sector;           /* The current sector in the buffer */
+  size_t sector;           /* The first sector in the buffer */
+  size_t seqnext;          /* Next sector of a sequential access */
   sem_t sem;               /* For atomic accesses to this structure */
+  uint16_t ncached;        /* Number of valid sectors in the buffer */
+  uint16_t dirtyfirst;     /* Index of the first dirty sector in the buffer */
+  uint16_t dirtycount;     /* Number of dirty sectors (0: buffer is clean) */
   uint8_t refs;            /* Number of references */
-  bool dirty;              /* true: Data has been written to the buffer */
   bool readonly;           /* true: Only read operations are supported */
   bool unlinked;           /* true: The driver has been unlinked */
-  FAR uint8_t *buffer;     /* One sector buffer */
+  FAR uint8_t *buffer;     /* CONFIG_BCH_CACHE_NSECTORS sector buffer */
 
 #if defined(CONFIG_BCH_ENCRYPTION)
   uint8_t key[CONFIG_BCH_ENCRYPTION_KEY_SIZE];  /* Encryption key */
@@ -100,6 +113,15 @@ EXTERN const struct file_operations bch_fops;
 EXTERN int  bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN int  bchlib_writesector(FAR struct bchlib_s *bch, size_t sector,
+                               uint16_t sectoffset, FAR const char *buffer,
+                               size_t len);
+EXTERN int  bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector,
+                              size_t nsectors);
+#if defined(CONFIG_BCH_ENCRYPTION)
+EXTERN void bchlib_cypher(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                          size_t sector, size_t nsectors, int encrypt);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
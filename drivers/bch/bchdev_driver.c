@@ -437,6 +437,30 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      /* Write back any sectors held in the sector buffer before passing
+       * the flush request on to the contained block driver.
+       */
+
+      case BIOC_FLUSH:
+        {
+          FAR struct inode *bchinode = bch->inode;
+
+          ret = bchlib_semtake(bch);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ret = bchlib_flushsector(bch);
+          bchlib_semgive(bch);
+
+          if (ret >= 0 && bchinode->u.i_bops->ioctl != NULL)
+            {
+              ret = bchinode->u.i_bops->ioctl(bchinode, cmd, arg);
+            }
+        }
+        break;
+
 #ifdef CONFIG_BCH_ENCRYPTION
       /* This is a request to set the encryption key? */
 
@@ -40,7 +40,9 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -70,48 +72,58 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
 #endif
 
 /****************************************************************************
- * Name: bch_cypher
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bchlib_cypher
+ *
+ * Description:
+ *   Encrypt or decrypt 'nsectors' consecutive sectors in 'buffer' that
+ *   correspond to the media beginning at 'sector'.
+ *
  ****************************************************************************/
 
 #if defined(CONFIG_BCH_ENCRYPTION)
-static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
+void bchlib_cypher(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                   size_t sector, size_t nsectors, int encrypt)
 {
   int blocks = bch->sectsize / 16;
-  FAR uint32_t *buffer = (FAR uint32_t *)bch->buffer;
+  FAR uint32_t *block = (FAR uint32_t *)buffer;
   int i;
 
-  for (i = 0; i < blocks; i++, buffer += 16 / sizeof(uint32_t) )
+  for (; nsectors > 0; nsectors--, sector++)
     {
-      uint32_t T[4];
-      uint32_t X[4] =
-      {
-        bch->sector, 0, 0, i
-      };
-
-      aes_cypher(X, X, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
-                 AES_MODE_ECB, CYPHER_ENCRYPT);
-
-      /* Xor-Encrypt-Xor */
-
-      bch_xor(T, X, buffer);
-      aes_cypher(T, T, 16, NULL, bch->key, CONFIG_BCH_ENCRYPTION_KEY_SIZE,
-                 AES_MODE_ECB, encrypt);
-      bch_xor(buffer, X, T);
+      for (i = 0; i < blocks; i++, block += 16 / sizeof(uint32_t))
+        {
+          uint32_t T[4];
+          uint32_t X[4] =
+          {
+            sector, 0, 0, i
+          };
+
+          aes_cypher(X, X, 16, NULL, bch->key,
+                     CONFIG_BCH_ENCRYPTION_KEY_SIZE,
+                     AES_MODE_ECB, CYPHER_ENCRYPT);
+
+          /* Xor-Encrypt-Xor */
+
+          bch_xor(T, X, block);
+          aes_cypher(T, T, 16, NULL, bch->key,
+                     CONFIG_BCH_ENCRYPTION_KEY_SIZE,
+                     AES_MODE_ECB, encrypt);
+          bch_xor(block, X, T);
+        }
     }
-
-  return OK;
 }
 #endif
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
 /****************************************************************************
  * Name: bchlib_flushsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Flush the current contents of the sector buffer (if dirty).  All dirty
+ *   sectors are written back with a single driver write.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -121,41 +133,51 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 int bchlib_flushsector(FAR struct bchlib_s *bch)
 {
   FAR struct inode *inode;
+  FAR uint8_t *buffer;
+  size_t sector;
   ssize_t ret = OK;
 
   /* Check if the sector has been modified and is out of synch with the
    * media.
    */
 
-  if (bch->dirty)
+  if (bch->dirtycount > 0)
     {
-      inode = bch->inode;
+      inode  = bch->inode;
+      buffer = &bch->buffer[bch->dirtyfirst * bch->sectsize];
+      sector = bch->sector + bch->dirtyfirst;
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Encrypt data as necessary */
 
-      bch_cypher(bch, CYPHER_ENCRYPT);
+      bchlib_cypher(bch, buffer, sector, bch->dirtycount, CYPHER_ENCRYPT);
 #endif
 
-      /* Write the sector to the media */
+      /* Write the sectors to the media */
 
-      ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
-      if (ret < 0)
-        {
-          ferr("Write failed: %d\n");
-        }
+      ret = inode->u.i_bops->write(inode, buffer, sector, bch->dirtycount);
 
 #if defined(CONFIG_BCH_ENCRYPTION)
       /* Computation overhead to save memory for extra sector buffer
        * TODO: Add configuration switch for extra sector buffer
        */
 
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bchlib_cypher(bch, buffer, sector, bch->dirtycount, CYPHER_DECRYPT);
 #endif
 
-      /* The sector is now in sync with the media */
+      if (ret < 0)
+        {
+          /* Leave the range dirty so that the data is not lost and the
+           * write can be retried by the next flush.
+           */
+
+          ferr("Write failed: %d\n", (int)ret);
+          return (int)ret;
+        }
+
+      /* The sectors are now in sync with the media */
 
-      bch->dirty = false;
+      bch->dirtycount = 0;
     }
 
   return (int)ret;
@@ -165,7 +187,10 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
  * Name: bchlib_readsector
  *
  * Description:
- *   Flush the current contents of the sector buffer (if dirty)
+ *   Make sure that 'sector' is in the sector buffer.  If the sector must be
+ *   read and the access continues a sequential run, then up to
+ *   CONFIG_BCH_CACHE_NSECTORS sectors are read ahead with a single driver
+ *   read.
  *
  * Assumptions:
  *   Caller must assume mutual exclusion
@@ -175,26 +200,184 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
   FAR struct inode *inode;
+  size_t nsectors;
   ssize_t ret = OK;
 
-  if (bch->sector != sector)
+  if (sector < bch->sector || sector >= bch->sector + bch->ncached)
     {
       inode = bch->inode;
 
-      bchlib_flushsector(bch);
-      bch->sector = (size_t)-1;
+      /* Write back any dirty sectors before the buffer is reused.  On
+       * failure the buffer is left intact so that the data is not lost.
+       */
+
+      ret = bchlib_flushsector(bch);
+      if (ret < 0)
+        {
+          return (int)ret;
+        }
+
+      bch->sector  = (size_t)-1;
+      bch->ncached = 0;
+
+      /* Only read ahead if this access follows on from the last one */
 
-      ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+      nsectors = 1;
+      if (sector == bch->seqnext)
+        {
+          nsectors = bch->nsectors - sector;
+          if (nsectors > CONFIG_BCH_CACHE_NSECTORS)
+            {
+              nsectors = CONFIG_BCH_CACHE_NSECTORS;
+            }
+        }
+
+      ret = inode->u.i_bops->read(inode, bch->buffer, sector, nsectors);
       if (ret < 0)
         {
-          ferr("Read failed: %d\n");
+          ferr("Read failed: %d\n", (int)ret);
+          return (int)ret;
+        }
+
+      /* The driver may have returned fewer sectors than requested */
+
+      if (ret > 0 && (size_t)ret < nsectors)
+        {
+          nsectors = ret;
         }
 
-      bch->sector = sector;
+      bch->sector  = sector;
+      bch->ncached = nsectors;
 #if defined(CONFIG_BCH_ENCRYPTION)
-      bch_cypher(bch, CYPHER_DECRYPT);
+      bchlib_cypher(bch, bch->buffer, sector, nsectors, CYPHER_DECRYPT);
 #endif
     }
 
+  bch->seqnext = sector + 1;
   return (int)ret;
 }
+
+/****************************************************************************
+ * Name: bchlib_writesector
+ *
+ * Description:
+ *   Write 'len' bytes at 'sectoffset' into the cached copy of 'sector' and
+ *   mark it dirty.  The sector is not read from the media if it is being
+ *   completely overwritten.  Consecutive sectors are accumulated in the
+ *   sector buffer so that they are written back with a single driver write
+ *   by bchlib_flushsector().
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_writesector(FAR struct bchlib_s *bch, size_t sector,
+                       uint16_t sectoffset, FAR const char *buffer,
+                       size_t len)
+{
+  uint16_t index;
+  uint16_t last;
+  int ret;
+
+  DEBUGASSERT(sectoffset + len <= bch->sectsize);
+
+  if (sector >= bch->sector && sector < bch->sector + bch->ncached)
+    {
+      /* The sector is already in the sector buffer */
+    }
+  else if (len < bch->sectsize)
+    {
+      /* Read-modify-write of a partial sector */
+
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+  else if (bch->ncached > 0 && bch->ncached < CONFIG_BCH_CACHE_NSECTORS &&
+           sector == bch->sector + bch->ncached)
+    {
+      /* Append a new sector to the sector buffer */
+
+      bch->ncached++;
+    }
+  else
+    {
+      /* Start a new run in the sector buffer */
+
+      ret = bchlib_flushsector(bch);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      bch->sector  = sector;
+      bch->ncached = 1;
+    }
+
+  memcpy(BCH_SECTBUF(bch, sector) + sectoffset, buffer, len);
+
+  /* Extend the dirty range to include this sector */
+
+  index = sector - bch->sector;
+  if (bch->dirtycount == 0)
+    {
+      bch->dirtyfirst = index;
+      bch->dirtycount = 1;
+    }
+  else
+    {
+      last = bch->dirtyfirst + bch->dirtycount;
+      if (index < bch->dirtyfirst)
+        {
+          bch->dirtyfirst = index;
+        }
+
+      if (index >= last)
+        {
+          last = index + 1;
+        }
+
+      bch->dirtycount = last - bch->dirtyfirst;
+    }
+
+  bch->seqnext = sector + 1;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bchlib_invalidate
+ *
+ * Description:
+ *   Flush and discard the sector buffer if it holds any of the 'nsectors'
+ *   sectors beginning at 'sector'.  This must be called before the media
+ *   is accessed directly, bypassing the sector buffer.
+ *
+ * Assumptions:
+ *   Caller must assume mutual exclusion
+ *
+ ****************************************************************************/
+
+int bchlib_invalidate(FAR struct bchlib_s *bch, size_t sector,
+                      size_t nsectors)
+{
+  int ret = OK;
+
+  if (bch->ncached > 0 && sector < bch->sector + bch->ncached &&
+      sector + nsectors > bch->sector)
+    {
+      ret = bchlib_flushsector(bch);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      bch->sector  = (size_t)-1;
+      bch->ncached = 0;
+    }
+
+  bch->seqnext = sector + nsectors;
+  return ret;
+}
@@ -48,6 +48,10 @@
 
 #include "bch.h"
 
+#if defined(CONFIG_BCH_ENCRYPTION)
+#  include <crypto/crypto.h>
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -86,6 +90,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
   uint16_t sectoffset;
   size_t   nbytes;
   size_t   bytesread;
+  size_t   i;
   int      ret;
 
   /* Get rid of this special case right away */
@@ -114,7 +119,11 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
     {
       /* Read the sector into the sector buffer */
 
-      bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Copy the tail end of the sector to the user buffer */
 
@@ -127,7 +136,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
           nbytes = len;
         }
 
-      memcpy(buffer, &bch->buffer[sectoffset], nbytes);
+      memcpy(buffer, BCH_SECTBUF(bch, sector) + sectoffset, nbytes);
 
       /* Adjust pointers and counts */
 
@@ -143,8 +152,9 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
       len       -= nbytes;
     }
 
-  /* Then read all of the full sectors following the partial sector directly
-   * into the user buffer.
+  /* Then read all of the full sectors following the partial sector.  Runs
+   * at least as large as the sector buffer are read directly into the user
+   * buffer; shorter runs are satisfied from the (read-ahead) sector buffer.
    */
 
   if (len >= bch->sectsize)
@@ -155,12 +165,43 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-                                       sector, nsectors);
-      if (ret < 0)
+      if (nsectors >= CONFIG_BCH_CACHE_NSECTORS)
         {
-          ferr("ERROR: Read failed: %d\n");
-          return ret;
+          /* Make sure that no dirty data is pending for these sectors */
+
+          ret = bchlib_invalidate(bch, sector, nsectors);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ret = bch->inode->u.i_bops->read(bch->inode,
+                                           (FAR uint8_t *)buffer,
+                                           sector, nsectors);
+          if (ret < 0)
+            {
+              ferr("ERROR: Read failed: %d\n", ret);
+              return ret;
+            }
+
+#if defined(CONFIG_BCH_ENCRYPTION)
+          bchlib_cypher(bch, (FAR uint8_t *)buffer, sector, nsectors,
+                        CYPHER_DECRYPT);
+#endif
+        }
+      else
+        {
+          for (i = 0; i < nsectors; i++)
+            {
+              ret = bchlib_readsector(bch, sector + i);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              memcpy(buffer + i * bch->sectsize,
+                     BCH_SECTBUF(bch, sector + i), bch->sectsize);
+            }
         }
 
       /* Adjust pointers and counts */
@@ -184,11 +225,15 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset,
     {
       /* Read the sector into the sector buffer */
 
-      bchlib_readsector(bch, sector);
+      ret = bchlib_readsector(bch, sector);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Copy the head end of the sector to the user buffer */
 
-      memcpy(buffer, bch->buffer, len);
+      memcpy(buffer, BCH_SECTBUF(bch, sector), len);
 
       /* Adjust counts */
 
@@ -73,6 +73,8 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
   uint16_t sectoffset;
   size_t   nbytes;
   size_t   byteswritten;
+  size_t   i;
+  bool     direct;
   int      ret;
 
   /* Get rid of this special case right away */
@@ -97,10 +99,6 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
   byteswritten = 0;
   if (sectoffset > 0)
     {
-      /* Read the full sector into the sector buffer */
-
-      bchlib_readsector(bch, sector);
-
       /* Copy the tail end of the sector from the user buffer */
 
       if (sectoffset + len > bch->sectsize)
@@ -112,25 +110,29 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           nbytes = len;
         }
 
-      memcpy(&bch->buffer[sectoffset], buffer, nbytes);
-      bch->dirty = true;
+      ret = bchlib_writesector(bch, sector, sectoffset, buffer, nbytes);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Adjust pointers and counts */
 
       sector++;
+      byteswritten = nbytes;
 
       if (sector >= bch->nsectors)
         {
-          return nbytes;
+          goto flush;
         }
 
-      byteswritten  = nbytes;
       buffer       += nbytes;
       len          -= nbytes;
     }
 
-  /* Then write all of the full sectors following the partial sector
-   * directly from the user buffer.
+  /* Then write all of the full sectors following the partial sector.  Runs
+   * at least as large as the sector buffer are written directly from the
+   * user buffer; shorter runs are coalesced in the sector buffer.
    */
 
   if (len >= bch->sectsize)
@@ -141,14 +143,47 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      /* Write the contiguous sectors */
+#if defined(CONFIG_BCH_ENCRYPTION)
+      /* The user buffer cannot be encrypted in place */
 
-      ret = bch->inode->u.i_bops->write(bch->inode, (FAR uint8_t *)buffer,
-                                        sector, nsectors);
-      if (ret < 0)
+      direct = false;
+#else
+      direct = (nsectors >= CONFIG_BCH_CACHE_NSECTORS);
+#endif
+
+      if (direct)
         {
-          ferr("ERROR: Write failed: %d\n", ret);
-          return ret;
+          /* Write back and discard any cached copy of these sectors */
+
+          ret = bchlib_invalidate(bch, sector, nsectors);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          /* Write the contiguous sectors */
+
+          ret = bch->inode->u.i_bops->write(bch->inode,
+                                            (FAR uint8_t *)buffer,
+                                            sector, nsectors);
+          if (ret < 0)
+            {
+              ferr("ERROR: Write failed: %d\n", ret);
+              return ret;
+            }
+        }
+      else
+        {
+          for (i = 0; i < nsectors; i++)
+            {
+              ret = bchlib_writesector(bch, sector + i, 0,
+                                       buffer + i * bch->sectsize,
+                                       bch->sectsize);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+            }
         }
 
       /* Adjust pointers and counts */
@@ -159,7 +194,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
       if (sector >= bch->nsectors)
         {
-          return byteswritten;
+          goto flush;
         }
 
       buffer    += nbytes;
@@ -170,20 +205,21 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
 
   if (len > 0)
     {
-      /* Read the sector into the sector buffer */
-
-      bchlib_readsector(bch, sector);
-
       /* Copy the head end of the sector from the user buffer */
 
-      memcpy(bch->buffer, buffer, len);
-      bch->dirty = true;
+      ret = bchlib_writesector(bch, sector, 0, buffer, len);
+      if (ret < 0)
+        {
+          return ret;
+        }
 
       /* Adjust counts */
 
       byteswritten += len;
     }
 
+flush:
+#ifndef CONFIG_BCH_WRITEBEHIND
   /* Finally, flush any cached writes to the device as well */
 
   ret = bchlib_flushsector(bch);
@@ -192,6 +228,7 @@ ssize_t bchlib_write(FAR void *handle, FAR const char *buffer, size_t offset,
       ferr("ERROR: Flush failed: %d\n", ret);
       return ret;
     }
+#endif
 
   return byteswritten;
 }
@@ -0,0 +1,1351 @@
+/****************************************************************************
+ * drivers/mtd/ftl_log.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Log-structured FTL
+ *
+ * The exported sectors are mapped page-by-page onto the FLASH.  Each write
+ * is appended to the currently open erase block; the previous copy of the
+ * sector simply becomes stale.  When an erase block is full, a summary
+ * holding the logical sector number of each of its pages is written to the
+ * last page(s) of the block:
+ *
+ *   +--------+--------+-----+------------+---------------------------+
+ *   | page 0 | page 1 | ... | page N-1   | summary: magic, sequence, |
+ *   |        |        |     |            | erase count, LSN[N], CRC  |
+ *   +--------+--------+-----+------------+---------------------------+
+ *
+ * The logical-to-physical map is rebuilt at start-up from the summaries.
+ * When a sector appears in several blocks, the block with the highest
+ * sequence number wins.  Sectors written to the open block after the last
+ * summary are lost on power failure, but the previous copies of those
+ * sectors remain intact: an erase block that was garbage collected is only
+ * erased again after the block receiving its relocated data has been
+ * closed.  BIOC_FLUSH (and the final close) checkpoints by closing the open
+ * block early.
+ *
+ * Garbage collection picks the closed block with the fewest valid pages.
+ * Free blocks are allocated lowest erase count first (dynamic wear
+ * leveling) and, when the spread of erase counts exceeds a threshold, the
+ * least worn closed block is relocated so that its cold data stops pinning
+ * it (static wear leveling).
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <crc32.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/mtd/mtd.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FTL_LOG_RESERVE
+#  define CONFIG_FTL_LOG_RESERVE 4
+#endif
+
+#ifndef CONFIG_FTL_LOG_WLTHRESH
+#  define CONFIG_FTL_LOG_WLTHRESH 64
+#endif
+
+#ifndef CONFIG_FTL_LOG_GCDELAY
+#  define CONFIG_FTL_LOG_GCDELAY 100
+#endif
+
+#if CONFIG_FTL_LOG_RESERVE < 3
+#  error CONFIG_FTL_LOG_RESERVE must be at least 3
+#endif
+
+#if defined(CONFIG_FTL_LOG_BGGC) && !defined(CONFIG_SCHED_LPWORK)
+#  error CONFIG_FTL_LOG_BGGC requires CONFIG_SCHED_LPWORK
+#endif
+
+/* Foreground garbage collection keeps at least this many erase blocks
+ * free (or reclaimable): one to open when the current block fills and one
+ * to absorb relocated pages while collecting.  Background collection tries
+ * to keep all but one of the reserved blocks available.
+ */
+
+#define FTL_GCMIN       2
+#define FTL_GCIDLE      (CONFIG_FTL_LOG_RESERVE - 1)
+
+#define FTL_MAGIC       0x314c5446  /* "FTL1" */
+#define FTL_UNMAPPED    0xffffffff
+
+/* Erase block states */
+
+#define FTL_BLOCK_FREE   0  /* Available; erased on allocation */
+#define FTL_BLOCK_OPEN   1  /* Being written */
+#define FTL_BLOCK_CLOSED 2  /* Summary written */
+#define FTL_BLOCK_STALE  3  /* Collected; free once the open block closes */
+
+/* The maximum length of the device name paths is the maximum length of a
+ * name plus 5 for the the length of "/dev/" and a NUL terminator.
+ */
+
+#define DEV_NAME_MAX    (NAME_MAX + 5)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The summary stored at the end of each closed erase block */
+
+struct ftl_summary_s
+{
+  uint32_t magic;         /* FTL_MAGIC */
+  uint32_t seq;           /* Sequence number of the block; newer is higher */
+  uint32_t erasecount;    /* Erase count of the block */
+  uint32_t npages;        /* Number of data pages written */
+  uint32_t crc;           /* CRC32 of the above and the used lsn[] entries */
+  uint32_t lsn[1];        /* Logical sector held by each data page */
+};
+
+#define SIZEOF_FTL_SUMHDR offsetof(struct ftl_summary_s, lsn)
+
+/* RAM state of one erase block */
+
+struct ftl_block_s
+{
+  uint32_t erasecount;    /* Number of times the block has been erased */
+  uint32_t seq;           /* Sequence number of the summary */
+  uint16_t nvalid;        /* Number of pages holding current data */
+  uint8_t  state;         /* See FTL_BLOCK_* definitions */
+};
+
+struct ftl_struct_s
+{
+  FAR struct mtd_dev_s *mtd;           /* Contained MTD interface */
+  struct mtd_geometry_s geo;           /* Device geometry */
+  sem_t exclsem;                       /* Supports mutually exclusive access */
+  uint16_t blkper;                     /* R/W blocks per erase block */
+  uint16_t ndata;                      /* Data pages per erase block */
+  uint16_t nsum;                       /* Summary pages per erase block */
+  uint16_t refs;                       /* Number of references */
+  bool unlinked;                       /* The driver has been unlinked */
+  bool wlcheck;                        /* Check erase count spread */
+  uint16_t openpage;                   /* Next free page in the open block */
+  uint32_t openblk;                    /* Open erase block or FTL_UNMAPPED */
+  uint32_t nsectors;                   /* Number of exported sectors */
+  uint32_t seq;                        /* Last summary sequence number */
+  uint32_t nfree;                      /* Number of FTL_BLOCK_FREE blocks */
+  uint32_t nstale;                     /* Number of FTL_BLOCK_STALE blocks */
+  FAR uint32_t *l2p;                   /* Logical to physical page map */
+  FAR struct ftl_block_s *blocks;      /* State of each erase block */
+  FAR struct ftl_summary_s *opensum;   /* Summary of the open block */
+  FAR struct ftl_summary_s *gcsum;     /* Summary of a block being collected */
+  FAR uint8_t *page;                   /* One page buffer for relocation */
+  struct ftl_stats_s stats;            /* Write amplification and wear counters */
+#ifdef CONFIG_FTL_LOG_BGGC
+  struct work_s work;                  /* Background garbage collection */
+#endif
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     ftl_open(FAR struct inode *inode);
+static int     ftl_close(FAR struct inode *inode);
+static ssize_t ftl_read(FAR struct inode *inode, FAR unsigned char *buffer,
+                 size_t start_sector, unsigned int nsectors);
+static ssize_t ftl_write(FAR struct inode *inode,
+                 FAR const unsigned char *buffer, size_t start_sector,
+                 unsigned int nsectors);
+static int     ftl_geometry(FAR struct inode *inode,
+                 FAR struct geometry *geometry);
+static int     ftl_ioctl(FAR struct inode *inode, int cmd,
+                 unsigned long arg);
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int     ftl_unlink(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_bops =
+{
+  ftl_open,     /* open     */
+  ftl_close,    /* close    */
+  ftl_read,     /* read     */
+  ftl_write,    /* write    */
+  ftl_geometry, /* geometry */
+  ftl_ioctl     /* ioctl    */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , ftl_unlink  /* unlink   */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_summarycrc
+ *
+ * Description:
+ *   Calculate the CRC of a summary
+ *
+ ****************************************************************************/
+
+static uint32_t ftl_summarycrc(FAR const struct ftl_summary_s *sum)
+{
+  uint32_t crc;
+
+  crc = crc32part((FAR const uint8_t *)sum,
+                  offsetof(struct ftl_summary_s, crc), 0);
+  return crc32part((FAR const uint8_t *)sum->lsn,
+                   sum->npages * sizeof(uint32_t), crc);
+}
+
+/****************************************************************************
+ * Name: ftl_readsummary
+ *
+ * Description:
+ *   Read and verify the summary of an erase block.  -ENOENT is returned if
+ *   the block has no valid summary (it is erased, or it was open when power
+ *   was lost).
+ *
+ ****************************************************************************/
+
+static int ftl_readsummary(FAR struct ftl_struct_s *dev, uint32_t block,
+                           FAR struct ftl_summary_s *sum)
+{
+  ssize_t nxfrd;
+
+  nxfrd = MTD_BREAD(dev->mtd, block * dev->blkper + dev->ndata, dev->nsum,
+                    (FAR uint8_t *)sum);
+  if (nxfrd != dev->nsum)
+    {
+      ferr("ERROR: Read summary of block %lu failed: %d\n",
+           (unsigned long)block, (int)nxfrd);
+      return -EIO;
+    }
+
+  if (sum->magic != FTL_MAGIC || sum->npages > dev->ndata ||
+      sum->crc != ftl_summarycrc(sum))
+    {
+      return -ENOENT;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_closeblock
+ *
+ * Description:
+ *   Write the summary of the open block, making everything written to it
+ *   durable.  Blocks collected while it was open may then be reused.
+ *
+ ****************************************************************************/
+
+static int ftl_closeblock(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_summary_s *sum = dev->opensum;
+  FAR struct ftl_block_s *blk;
+  ssize_t nxfrd;
+  uint32_t i;
+
+  if (dev->openblk == FTL_UNMAPPED || dev->openpage == 0)
+    {
+      return OK;
+    }
+
+  blk             = &dev->blocks[dev->openblk];
+  sum->magic      = FTL_MAGIC;
+  sum->seq        = ++dev->seq;
+  sum->erasecount = blk->erasecount;
+  sum->npages     = dev->openpage;
+  sum->crc        = ftl_summarycrc(sum);
+
+  nxfrd = MTD_BWRITE(dev->mtd, dev->openblk * dev->blkper + dev->ndata,
+                     dev->nsum, (FAR const uint8_t *)sum);
+  if (nxfrd != dev->nsum)
+    {
+      ferr("ERROR: Write summary of block %lu failed: %d\n",
+           (unsigned long)dev->openblk, (int)nxfrd);
+      return -EIO;
+    }
+
+  dev->stats.flashwrites += dev->nsum;
+  if (dev->openpage < dev->ndata)
+    {
+      dev->stats.checkpoints++;
+    }
+
+  blk->seq     = sum->seq;
+  blk->state   = FTL_BLOCK_CLOSED;
+  dev->openblk = FTL_UNMAPPED;
+
+  /* The data relocated out of stale blocks is now on the media */
+
+  if (dev->nstale > 0)
+    {
+      for (i = 0; i < dev->geo.neraseblocks; i++)
+        {
+          if (dev->blocks[i].state == FTL_BLOCK_STALE)
+            {
+              dev->blocks[i].state = FTL_BLOCK_FREE;
+            }
+        }
+
+      dev->nfree  += dev->nstale;
+      dev->nstale  = 0;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_openblock
+ *
+ * Description:
+ *   Erase the least worn free block and make it the open block.
+ *
+ ****************************************************************************/
+
+static int ftl_openblock(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_block_s *blk;
+  uint32_t victim = FTL_UNMAPPED;
+  uint32_t i;
+  int ret;
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      blk = &dev->blocks[i];
+      if (blk->state == FTL_BLOCK_FREE &&
+          (victim == FTL_UNMAPPED ||
+           blk->erasecount < dev->blocks[victim].erasecount))
+        {
+          victim = i;
+        }
+    }
+
+  if (victim == FTL_UNMAPPED)
+    {
+      ferr("ERROR: No free erase blocks\n");
+      return -ENOSPC;
+    }
+
+  ret = MTD_ERASE(dev->mtd, victim, 1);
+  if (ret < 0)
+    {
+      ferr("ERROR: Erase block=%lu failed: %d\n",
+           (unsigned long)victim, ret);
+      return ret;
+    }
+
+  blk = &dev->blocks[victim];
+  blk->erasecount++;
+  blk->nvalid = 0;
+  blk->state  = FTL_BLOCK_OPEN;
+  dev->nfree--;
+  dev->stats.erases++;
+
+  memset(dev->opensum, 0xff, dev->nsum * dev->geo.blocksize);
+  dev->openblk  = victim;
+  dev->openpage = 0;
+  dev->wlcheck  = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_append
+ *
+ * Description:
+ *   Append consecutive logical sectors to the open block, opening a new
+ *   block if necessary.  Returns the number of sectors written, which may
+ *   be fewer than requested if the open block fills.
+ *
+ ****************************************************************************/
+
+static ssize_t ftl_append(FAR struct ftl_struct_s *dev, uint32_t lsn,
+                          size_t nsectors, FAR const uint8_t *buffer)
+{
+  uint32_t phys;
+  uint32_t old;
+  ssize_t nxfrd;
+  size_t i;
+  int ret;
+
+  if (dev->openblk != FTL_UNMAPPED && dev->openpage >= dev->ndata)
+    {
+      ret = ftl_closeblock(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (dev->openblk == FTL_UNMAPPED)
+    {
+      ret = ftl_openblock(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  if (nsectors > dev->ndata - dev->openpage)
+    {
+      nsectors = dev->ndata - dev->openpage;
+    }
+
+  phys  = dev->openblk * dev->blkper + dev->openpage;
+  nxfrd = MTD_BWRITE(dev->mtd, phys, nsectors, buffer);
+  if (nxfrd != nsectors)
+    {
+      ferr("ERROR: Write %lu pages at %lu failed: %d\n",
+           (unsigned long)nsectors, (unsigned long)phys, (int)nxfrd);
+
+      /* The pages may be partially programmed; don't use them again */
+
+      dev->openpage += nsectors;
+      return -EIO;
+    }
+
+  /* Update the map; the previous copies become stale */
+
+  for (i = 0; i < nsectors; i++, lsn++, phys++)
+    {
+      old = dev->l2p[lsn];
+      if (old != FTL_UNMAPPED)
+        {
+          dev->blocks[old / dev->blkper].nvalid--;
+        }
+
+      dev->l2p[lsn] = phys;
+      dev->opensum->lsn[dev->openpage + i] = lsn;
+    }
+
+  dev->blocks[dev->openblk].nvalid += nsectors;
+  dev->openpage          += nsectors;
+  dev->stats.flashwrites += nsectors;
+  return nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_collect
+ *
+ * Description:
+ *   Relocate the valid pages of one closed block to the open block.  The
+ *   block with the fewest valid pages is chosen or, for static wear
+ *   leveling, the least worn block.
+ *
+ ****************************************************************************/
+
+static int ftl_collect(FAR struct ftl_struct_s *dev, bool wearlevel)
+{
+  FAR struct ftl_block_s *blk;
+  FAR struct ftl_block_s *best;
+  uint32_t victim = FTL_UNMAPPED;
+  uint32_t phys;
+  uint32_t lsn;
+  uint32_t i;
+  ssize_t nxfrd;
+  int ret;
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      blk = &dev->blocks[i];
+      if (blk->state != FTL_BLOCK_CLOSED)
+        {
+          continue;
+        }
+
+      if (victim == FTL_UNMAPPED)
+        {
+          victim = i;
+          continue;
+        }
+
+      best = &dev->blocks[victim];
+      if (wearlevel ? blk->erasecount < best->erasecount :
+          (blk->nvalid < best->nvalid ||
+           (blk->nvalid == best->nvalid &&
+            blk->erasecount < best->erasecount)))
+        {
+          victim = i;
+        }
+    }
+
+  if (victim == FTL_UNMAPPED ||
+      (!wearlevel && dev->blocks[victim].nvalid >= dev->ndata))
+    {
+      /* Nothing to gain */
+
+      return -ENOSPC;
+    }
+
+  finfo("Collect block %lu (%u valid)\n",
+        (unsigned long)victim, dev->blocks[victim].nvalid);
+
+  if (dev->blocks[victim].nvalid > 0)
+    {
+      ret = ftl_readsummary(dev, victim, dev->gcsum);
+      if (ret < 0)
+        {
+          ferr("ERROR: Bad summary in block %lu\n", (unsigned long)victim);
+          return ret == -ENOENT ? -EIO : ret;
+        }
+
+      for (i = 0; i < dev->gcsum->npages &&
+                  dev->blocks[victim].nvalid > 0; i++)
+        {
+          lsn  = dev->gcsum->lsn[i];
+          phys = victim * dev->blkper + i;
+
+          if (lsn >= dev->nsectors || dev->l2p[lsn] != phys)
+            {
+              continue;
+            }
+
+          nxfrd = MTD_BREAD(dev->mtd, phys, 1, dev->page);
+          if (nxfrd != 1)
+            {
+              ferr("ERROR: Read page %lu failed: %d\n",
+                   (unsigned long)phys, (int)nxfrd);
+              return -EIO;
+            }
+
+          nxfrd = ftl_append(dev, lsn, 1, dev->page);
+          if (nxfrd < 0)
+            {
+              return (int)nxfrd;
+            }
+        }
+    }
+
+  /* The block may be erased once the relocated data is durable */
+
+  DEBUGASSERT(dev->blocks[victim].nvalid == 0);
+  dev->blocks[victim].state = FTL_BLOCK_STALE;
+  dev->nstale++;
+
+  if (wearlevel)
+    {
+      dev->stats.wlmoves++;
+    }
+  else
+    {
+      dev->stats.collections++;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_wearlevel
+ *
+ * Description:
+ *   Move the least worn closed block if the spread of erase counts has
+ *   grown beyond CONFIG_FTL_LOG_WLTHRESH.
+ *
+ ****************************************************************************/
+
+static void ftl_wearlevel(FAR struct ftl_struct_s *dev)
+{
+  uint32_t minerase = UINT32_MAX;
+  uint32_t maxerase = 0;
+  uint32_t i;
+
+  dev->wlcheck = false;
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      FAR struct ftl_block_s *blk = &dev->blocks[i];
+
+      if (blk->erasecount > maxerase)
+        {
+          maxerase = blk->erasecount;
+        }
+
+      if (blk->state == FTL_BLOCK_CLOSED && blk->erasecount < minerase)
+        {
+          minerase = blk->erasecount;
+        }
+    }
+
+  if (minerase != UINT32_MAX &&
+      maxerase - minerase > CONFIG_FTL_LOG_WLTHRESH)
+    {
+      ftl_collect(dev, true);
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_reserve
+ *
+ * Description:
+ *   Garbage collect until at least 'nblocks' erase blocks are free or
+ *   reclaimable.
+ *
+ ****************************************************************************/
+
+static int ftl_reserve(FAR struct ftl_struct_s *dev, uint32_t nblocks)
+{
+  uint32_t n;
+  int ret;
+
+  for (n = 0;
+       dev->nfree + dev->nstale < nblocks && n < dev->geo.neraseblocks;
+       n++)
+    {
+      ret = ftl_collect(dev, false);
+      if (ret < 0)
+        {
+          return dev->nfree + dev->nstale > 0 ? OK : ret;
+        }
+    }
+
+  if (dev->wlcheck && dev->nfree + dev->nstale >= FTL_GCMIN)
+    {
+      ftl_wearlevel(dev);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_gcworker
+ *
+ * Description:
+ *   Garbage collect in the background so that foreground writes seldom
+ *   have to.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_LOG_BGGC
+static void ftl_gcworker(FAR void *arg)
+{
+  FAR struct ftl_struct_s *dev = (FAR struct ftl_struct_s *)arg;
+
+  if (nxsem_wait_uninterruptible(&dev->exclsem) >= 0)
+    {
+      ftl_reserve(dev, FTL_GCIDLE);
+      nxsem_post(&dev->exclsem);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: ftl_mount
+ *
+ * Description:
+ *   Rebuild the RAM state from the summaries on the media.
+ *
+ ****************************************************************************/
+
+static int ftl_mount(FAR struct ftl_struct_s *dev)
+{
+  FAR struct ftl_summary_s *sum = dev->gcsum;
+  FAR struct ftl_block_s *blk;
+  uint64_t total = 0;
+  uint32_t nknown = 0;
+  uint32_t phys;
+  uint32_t lsn;
+  uint32_t cur;
+  uint32_t i;
+  uint32_t j;
+  int ret;
+
+  memset(dev->l2p, 0xff, dev->nsectors * sizeof(uint32_t));
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      blk = &dev->blocks[i];
+
+      ret = ftl_readsummary(dev, i, sum);
+      if (ret == -ENOENT)
+        {
+          blk->state      = FTL_BLOCK_FREE;
+          blk->erasecount = FTL_UNMAPPED;
+          continue;
+        }
+      else if (ret < 0)
+        {
+          return ret;
+        }
+
+      blk->state      = FTL_BLOCK_CLOSED;
+      blk->seq        = sum->seq;
+      blk->erasecount = sum->erasecount;
+      total          += sum->erasecount;
+      nknown++;
+
+      if (sum->seq > dev->seq)
+        {
+          dev->seq = sum->seq;
+        }
+
+      /* The newest copy of each sector wins.  Within one block, later pages
+       * are newer.
+       */
+
+      for (j = 0; j < sum->npages; j++)
+        {
+          lsn = sum->lsn[j];
+          if (lsn >= dev->nsectors)
+            {
+              continue;
+            }
+
+          phys = i * dev->blkper + j;
+          cur  = dev->l2p[lsn];
+          if (cur == FTL_UNMAPPED || cur / dev->blkper == i ||
+              dev->blocks[cur / dev->blkper].seq < sum->seq)
+            {
+              dev->l2p[lsn] = phys;
+            }
+        }
+    }
+
+  /* Blocks without a summary have lost their erase count; assume they have
+   * seen average wear.
+   */
+
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      blk = &dev->blocks[i];
+      if (blk->erasecount == FTL_UNMAPPED)
+        {
+          blk->erasecount = nknown > 0 ? (uint32_t)(total / nknown) : 0;
+        }
+    }
+
+  for (lsn = 0; lsn < dev->nsectors; lsn++)
+    {
+      if (dev->l2p[lsn] != FTL_UNMAPPED)
+        {
+          dev->blocks[dev->l2p[lsn] / dev->blkper].nvalid++;
+        }
+    }
+
+  /* Closed blocks with no current data may be reused right away since
+   * everything that superseded them is in closed blocks, too.
+   */
+
+  dev->nfree = 0;
+  for (i = 0; i < dev->geo.neraseblocks; i++)
+    {
+      blk = &dev->blocks[i];
+      if (blk->state == FTL_BLOCK_CLOSED && blk->nvalid == 0)
+        {
+          blk->state = FTL_BLOCK_FREE;
+        }
+
+      if (blk->state == FTL_BLOCK_FREE)
+        {
+          dev->nfree++;
+        }
+    }
+
+  dev->openblk = FTL_UNMAPPED;
+  dev->nstale  = 0;
+
+  finfo("%lu sectors, %lu free blocks, seq %lu\n",
+        (unsigned long)dev->nsectors, (unsigned long)dev->nfree,
+        (unsigned long)dev->seq);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_free
+ *
+ * Description: Free the FTL device structure
+ *
+ ****************************************************************************/
+
+static void ftl_free(FAR struct ftl_struct_s *dev)
+{
+#ifdef CONFIG_FTL_LOG_BGGC
+  work_cancel(LPWORK, &dev->work);
+#endif
+
+  if (dev->l2p)
+    {
+      kmm_free(dev->l2p);
+    }
+
+  if (dev->blocks)
+    {
+      kmm_free(dev->blocks);
+    }
+
+  if (dev->opensum)
+    {
+      kmm_free(dev->opensum);
+    }
+
+  if (dev->gcsum)
+    {
+      kmm_free(dev->gcsum);
+    }
+
+  if (dev->page)
+    {
+      kmm_free(dev->page);
+    }
+
+  nxsem_destroy(&dev->exclsem);
+  kmm_free(dev);
+}
+
+/****************************************************************************
+ * Name: ftl_open
+ *
+ * Description: Open the block device
+ *
+ ****************************************************************************/
+
+static int ftl_open(FAR struct inode *inode)
+{
+  FAR struct ftl_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_struct_s *)inode->i_private;
+
+  dev->refs++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_close
+ *
+ * Description: close the block device
+ *
+ ****************************************************************************/
+
+static int ftl_close(FAR struct inode *inode)
+{
+  FAR struct ftl_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_struct_s *)inode->i_private;
+
+  /* Checkpoint when the last user goes away */
+
+  if (--dev->refs == 0)
+    {
+      nxsem_wait_uninterruptible(&dev->exclsem);
+      ftl_closeblock(dev);
+      nxsem_post(&dev->exclsem);
+
+      if (dev->unlinked)
+        {
+          ftl_free(dev);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
+                        size_t start_sector, unsigned int nsectors)
+{
+  FAR struct ftl_struct_s *dev;
+  uint32_t phys;
+  size_t remaining;
+  size_t run;
+  ssize_t nxfrd;
+  int ret;
+
+  finfo("sector: %d nsectors: %d\n", start_sector, nsectors);
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_struct_s *)inode->i_private;
+
+  if (start_sector >= dev->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      nsectors = dev->nsectors - start_sector;
+    }
+
+  ret = nxsem_wait_uninterruptible(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (remaining = nsectors; remaining > 0; remaining -= run)
+    {
+      phys = dev->l2p[start_sector];
+
+      if (phys == FTL_UNMAPPED)
+        {
+          /* Never written: return the erased state */
+
+          memset(buffer, 0xff, dev->geo.blocksize);
+          run = 1;
+        }
+      else
+        {
+          /* Read as many physically contiguous pages as possible at once */
+
+          for (run = 1;
+               run < remaining && dev->l2p[start_sector + run] == phys + run;
+               run++);
+
+          nxfrd = MTD_BREAD(dev->mtd, phys, run, buffer);
+          if (nxfrd != run)
+            {
+              ferr("ERROR: Read %d pages at %lu failed: %d\n",
+                   (int)run, (unsigned long)phys, (int)nxfrd);
+              nxsem_post(&dev->exclsem);
+              return nxfrd < 0 ? nxfrd : -EIO;
+            }
+        }
+
+      start_sector += run;
+      buffer       += run * dev->geo.blocksize;
+    }
+
+  nxsem_post(&dev->exclsem);
+  return nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_write
+ *
+ * Description: Write the specified number of sectors out-of-place
+ *
+ ****************************************************************************/
+
+static ssize_t ftl_write(FAR struct inode *inode,
+                         FAR const unsigned char *buffer,
+                         size_t start_sector, unsigned int nsectors)
+{
+  FAR struct ftl_struct_s *dev;
+  size_t remaining;
+  ssize_t nxfrd;
+  int ret;
+
+  finfo("sector: %d nsectors: %d\n", start_sector, nsectors);
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_struct_s *)inode->i_private;
+
+  if (start_sector >= dev->nsectors)
+    {
+      return -EFBIG;
+    }
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      nsectors = dev->nsectors - start_sector;
+    }
+
+  ret = nxsem_wait_uninterruptible(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (remaining = nsectors; remaining > 0; remaining -= nxfrd)
+    {
+      ret = ftl_reserve(dev, FTL_GCMIN);
+      if (ret < 0)
+        {
+          nxsem_post(&dev->exclsem);
+          return ret;
+        }
+
+      nxfrd = ftl_append(dev, start_sector, remaining, buffer);
+      if (nxfrd < 0)
+        {
+          nxsem_post(&dev->exclsem);
+          return nxfrd;
+        }
+
+      start_sector += nxfrd;
+      buffer       += nxfrd * dev->geo.blocksize;
+    }
+
+  dev->stats.hostwrites += nsectors;
+
+#ifdef CONFIG_FTL_LOG_BGGC
+  /* Top up the free pool once the writer has gone quiet */
+
+  if (dev->nfree + dev->nstale < FTL_GCIDLE && work_available(&dev->work))
+    {
+      work_queue(LPWORK, &dev->work, ftl_gcworker, dev,
+                 MSEC2TICK(CONFIG_FTL_LOG_GCDELAY));
+    }
+#endif
+
+  nxsem_post(&dev->exclsem);
+  return nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_geometry
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int ftl_geometry(FAR struct inode *inode,
+                        FAR struct geometry *geometry)
+{
+  FAR struct ftl_struct_s *dev;
+
+  finfo("Entry\n");
+
+  DEBUGASSERT(inode);
+  if (geometry)
+    {
+      dev = (struct ftl_struct_s *)inode->i_private;
+      geometry->geo_available     = true;
+      geometry->geo_mediachanged  = false;
+      geometry->geo_writeenabled  = true;
+      geometry->geo_nsectors      = dev->nsectors;
+      geometry->geo_sectorsize    = dev->geo.blocksize;
+
+      finfo("available: true mediachanged: false writeenabled: %s\n",
+            geometry->geo_writeenabled ? "true" : "false");
+      finfo("nsectors: %d sectorsize: %d\n",
+            geometry->geo_nsectors, geometry->geo_sectorsize);
+
+      return OK;
+    }
+
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: ftl_ioctl
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  struct ftl_struct_s *dev;
+  int ret;
+
+  finfo("Entry\n");
+  DEBUGASSERT(inode && inode->i_private);
+
+  dev = (struct ftl_struct_s *)inode->i_private;
+
+  switch (cmd)
+    {
+      /* Sectors are not stored linearly, so execute-in-place is not
+       * possible.
+       */
+
+      case BIOC_XIPBASE:
+        return -ENOTTY;
+
+      /* Checkpoint: make everything written so far durable */
+
+      case BIOC_FLUSH:
+        ret = nxsem_wait_uninterruptible(&dev->exclsem);
+        if (ret >= 0)
+          {
+            ret = ftl_closeblock(dev);
+            nxsem_post(&dev->exclsem);
+          }
+
+        return ret;
+
+      case BIOC_FTLSTATS:
+        {
+          FAR struct ftl_stats_s *stats =
+            (FAR struct ftl_stats_s *)((uintptr_t)arg);
+          uint32_t i;
+
+          if (stats == NULL)
+            {
+              return -EINVAL;
+            }
+
+          ret = nxsem_wait_uninterruptible(&dev->exclsem);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          dev->stats.minerase   = UINT32_MAX;
+          dev->stats.maxerase   = 0;
+          dev->stats.freeblocks = dev->nfree + dev->nstale;
+
+          for (i = 0; i < dev->geo.neraseblocks; i++)
+            {
+              uint32_t count = dev->blocks[i].erasecount;
+
+              if (count < dev->stats.minerase)
+                {
+                  dev->stats.minerase = count;
+                }
+
+              if (count > dev->stats.maxerase)
+                {
+                  dev->stats.maxerase = count;
+                }
+            }
+
+          memcpy(stats, &dev->stats, sizeof(struct ftl_stats_s));
+          nxsem_post(&dev->exclsem);
+        }
+
+        return OK;
+
+      default:
+        break;
+    }
+
+  /* No other block driver ioctl commands are not recognized by this
+   * driver.  Other possible MTD driver ioctl commands are passed through
+   * to the MTD driver (unchanged).
+   */
+
+  ret = MTD_IOCTL(dev->mtd, cmd, arg);
+  if (ret < 0)
+    {
+      ferr("ERROR: MTD ioctl(%04x) failed: %d\n", cmd, ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_unlink
+ *
+ * Description: Unlink the device
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int ftl_unlink(FAR struct inode *inode)
+{
+  FAR struct ftl_struct_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct ftl_struct_s *)inode->i_private;
+
+  dev->unlinked = true;
+  if (dev->refs == 0)
+    {
+      ftl_free(dev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_initialize_by_path
+ *
+ * Description:
+ *   Initialize to provide a block driver wrapper around an MTD interface
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   mtd  - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
+{
+  struct ftl_struct_s *dev;
+  size_t sumsize;
+  int ret;
+
+  /* Sanity check */
+
+  if (path == NULL || mtd == NULL)
+    {
+      return -EINVAL;
+    }
+
+  finfo("path=\"%s\"\n", path);
+
+  /* Allocate a FTL device structure */
+
+  dev = (FAR struct ftl_struct_s *)kmm_zalloc(sizeof(struct ftl_struct_s));
+  if (dev == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Initialize the FTL device structure */
+
+  dev->mtd = mtd;
+  nxsem_init(&dev->exclsem, 0, 1);
+
+  /* Get the device geometry. (casting to uintptr_t first eliminates
+   * complaints on some architectures where the sizeof long is different
+   * from the size of a pointer).
+   */
+
+  ret = MTD_IOCTL(mtd, MTDIOC_GEOMETRY,
+                  (unsigned long)((uintptr_t)&dev->geo));
+  if (ret < 0)
+    {
+      ferr("ERROR: MTD ioctl(MTDIOC_GEOMETRY) failed: %d\n", ret);
+      goto errout_with_dev;
+    }
+
+  /* Get the number of R/W blocks per erase block */
+
+  dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
+  DEBUGASSERT(dev->blkper * dev->geo.blocksize == dev->geo.erasesize);
+
+  /* Find the number of pages needed at the end of each erase block to hold
+   * the summary of the remaining pages.
+   */
+
+  for (dev->nsum = 1; dev->nsum < dev->blkper; dev->nsum++)
+    {
+      sumsize = SIZEOF_FTL_SUMHDR +
+                (dev->blkper - dev->nsum) * sizeof(uint32_t);
+      if (sumsize <= dev->nsum * dev->geo.blocksize)
+        {
+          break;
+        }
+    }
+
+  if (dev->nsum >= dev->blkper ||
+      dev->geo.neraseblocks <= CONFIG_FTL_LOG_RESERVE)
+    {
+      ferr("ERROR: Geometry unsuitable for the log-structured FTL\n");
+      ret = -EINVAL;
+      goto errout_with_dev;
+    }
+
+  dev->ndata    = dev->blkper - dev->nsum;
+  dev->nsectors = (dev->geo.neraseblocks - CONFIG_FTL_LOG_RESERVE) *
+                  dev->ndata;
+
+  /* Allocate the map, the block table and the I/O buffers */
+
+  sumsize      = dev->nsum * dev->geo.blocksize;
+  dev->l2p     = (FAR uint32_t *)
+                 kmm_malloc(dev->nsectors * sizeof(uint32_t));
+  dev->blocks  = (FAR struct ftl_block_s *)
+                 kmm_zalloc(dev->geo.neraseblocks *
+                            sizeof(struct ftl_block_s));
+  dev->opensum = (FAR struct ftl_summary_s *)kmm_malloc(sumsize);
+  dev->gcsum   = (FAR struct ftl_summary_s *)kmm_malloc(sumsize);
+  dev->page    = (FAR uint8_t *)kmm_malloc(dev->geo.blocksize);
+
+  if (dev->l2p == NULL || dev->blocks == NULL || dev->opensum == NULL ||
+      dev->gcsum == NULL || dev->page == NULL)
+    {
+      ferr("ERROR: Failed to allocate FTL state\n");
+      ret = -ENOMEM;
+      goto errout_with_dev;
+    }
+
+  /* Recover the map from the media */
+
+  ret = ftl_mount(dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: ftl_mount failed: %d\n", ret);
+      goto errout_with_dev;
+    }
+
+  /* Inode private data is a reference to the FTL device structure */
+
+  ret = register_blockdriver(path, &g_bops, 0, dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: register_blockdriver failed: %d\n", -ret);
+      goto errout_with_dev;
+    }
+
+  return OK;
+
+errout_with_dev:
+  ftl_free(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_initialize
+ *
+ * Description:
+ *   Initialize to provide a block driver wrapper around an MTD interface
+ *
+ * Input Parameters:
+ *   minor - The minor device number.  The MTD block device will be
+ *           registered as as /dev/mtdblockN where N is the minor number.
+ *   mtd   - The MTD device that supports the FLASH interface.
+ *
+ ****************************************************************************/
+
+int ftl_initialize(int minor, FAR struct mtd_dev_s *mtd)
+{
+  char path[DEV_NAME_MAX];
+
+#ifdef CONFIG_DEBUG_FEATURES
+  /* Sanity check */
+
+  if (minor < 0 || minor > 255)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  /* Do the real work by ftl_initialize_by_path */
+
+  snprintf(path, DEV_NAME_MAX, "/dev/mtdblock%d", minor);
+  return ftl_initialize_by_path(path, mtd);
+}
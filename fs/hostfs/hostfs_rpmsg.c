@@ -94,6 +94,11 @@ static void hostfs_rpmsg_device_destroy(struct rpmsg_device *rdev,
 static int  hostfs_rpmsg_ept_cb(FAR struct rpmsg_endpoint *ept,
                                 FAR void *data, size_t len, uint32_t src,
                                 FAR void *priv);
+static int  hostfs_rpmsg_send(uint32_t command, bool copy,
+                              FAR struct hostfs_rpmsg_header_s *msg,
+                              int len, FAR void *data,
+                              FAR struct hostfs_rpmsg_cookie_s *cookie);
+static int  hostfs_rpmsg_wait(FAR struct hostfs_rpmsg_cookie_s *cookie);
 static int  hostfs_rpmsg_send_recv(uint32_t command, bool copy,
                                    FAR struct hostfs_rpmsg_header_s *msg,
                                    int len, FAR void *data);
@@ -160,13 +165,26 @@ static int hostfs_rpmsg_read_handler(FAR struct rpmsg_endpoint *ept,
       (struct hostfs_rpmsg_cookie_s *)(uintptr_t)header->cookie;
   FAR struct hostfs_rpmsg_read_s *rsp = data;
 
-  cookie->result = header->result;
-  if (cookie->result > 0)
+  /* The server streams a large read back in several replies.  Copy each
+   * chunk straight from the rpmsg buffer to its place in the caller's
+   * buffer and wake up the caller only after the last one.
+   */
+
+  if (header->result > 0)
+    {
+      memcpy(cookie->data, rsp->buf, B2C(header->result));
+      cookie->data    = (FAR char *)cookie->data + B2C(header->result);
+      cookie->result += header->result;
+    }
+  else if (header->result < 0 && cookie->result == 0)
     {
-      memcpy(cookie->data, rsp->buf, B2C(cookie->result));
+      cookie->result = header->result;
     }
 
-  nxsem_post(&cookie->sem);
+  if (header->result <= 0 || rsp->count == 0)
+    {
+      nxsem_post(&cookie->sem);
+    }
 
   return 0;
 }
@@ -295,30 +313,30 @@ static int hostfs_rpmsg_ept_cb(FAR struct rpmsg_endpoint *ept,
   return -EINVAL;
 }
 
-static int hostfs_rpmsg_send_recv(uint32_t command, bool copy,
-                                  FAR struct hostfs_rpmsg_header_s *msg,
-                                  int len, FAR void *data)
+static int hostfs_rpmsg_send(uint32_t command, bool copy,
+                             FAR struct hostfs_rpmsg_header_s *msg,
+                             int len, FAR void *data,
+                             FAR struct hostfs_rpmsg_cookie_s *cookie)
 {
   FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
-  FAR struct hostfs_rpmsg_cookie_s cookie;
   int ret;
 
-  memset(&cookie, 0, sizeof(cookie));
-  nxsem_init(&cookie.sem, 0, 0);
-  nxsem_set_protocol(&cookie.sem, SEM_PRIO_NONE);
+  memset(cookie, 0, sizeof(*cookie));
+  nxsem_init(&cookie->sem, 0, 0);
+  nxsem_set_protocol(&cookie->sem, SEM_PRIO_NONE);
 
   if (data)
     {
-      cookie.data = data;
+      cookie->data = data;
     }
   else if (copy)
     {
-      cookie.data = msg;
+      cookie->data = msg;
     }
 
   msg->command = command;
   msg->result  = -ENXIO;
-  msg->cookie  = (uintptr_t)&cookie;
+  msg->cookie  = (uintptr_t)cookie;
 
   if (copy)
     {
@@ -331,20 +349,42 @@ static int hostfs_rpmsg_send_recv(uint32_t command, bool copy,
 
   if (ret < 0)
     {
-      goto fail;
+      nxsem_destroy(&cookie->sem);
     }
 
-  ret = nxsem_wait_uninterruptible(&cookie.sem);
+  return ret;
+}
+
+static int hostfs_rpmsg_wait(FAR struct hostfs_rpmsg_cookie_s *cookie)
+{
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&cookie->sem);
   if (ret == 0)
     {
-      ret = cookie.result;
+      ret = cookie->result;
     }
 
-fail:
-  nxsem_destroy(&cookie.sem);
+  nxsem_destroy(&cookie->sem);
   return ret;
 }
 
+static int hostfs_rpmsg_send_recv(uint32_t command, bool copy,
+                                  FAR struct hostfs_rpmsg_header_s *msg,
+                                  int len, FAR void *data)
+{
+  struct hostfs_rpmsg_cookie_s cookie;
+  int ret;
+
+  ret = hostfs_rpmsg_send(command, copy, msg, len, data, &cookie);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return hostfs_rpmsg_wait(&cookie);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -388,68 +428,113 @@ int host_close(int fd)
 
 ssize_t host_read(int fd, FAR void *buf, size_t count)
 {
-  size_t read = 0;
-  int ret = 0;
+  struct hostfs_rpmsg_read_s msg =
+  {
+    .fd    = fd,
+    .count = C2B(count),
+  };
 
-  while (read < count)
-    {
-      struct hostfs_rpmsg_read_s msg =
-      {
-        .fd    = fd,
-        .count = C2B(count - read),
-      };
-
-      ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_READ, true,
-              (FAR struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), buf);
-      if (ret <= 0)
-        {
-          break;
-        }
+  int ret;
 
-      read += B2C(ret);
-      buf  += B2C(ret);
-    }
+  /* One request covers the whole read; the server streams the data back in
+   * as many replies as needed.
+   */
 
-  return read ? read : ret;
+  ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_READ, true,
+          (FAR struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), buf);
+
+  return ret < 0 ? ret : B2C(ret);
 }
 
 ssize_t host_write(int fd, FAR const void *buf, size_t count)
 {
   FAR struct hostfs_rpmsg_s *priv = &g_hostfs_rpmsg;
+  struct hostfs_rpmsg_cookie_s cookie[CONFIG_FS_HOSTFS_RPMSG_WRITE_WINDOW];
+  uint32_t size[CONFIG_FS_HOSTFS_RPMSG_WRITE_WINDOW];
+  bool counting = true;
+  bool stop = false;
   size_t written = 0;
+  size_t sent = 0;
+  int head = 0;
+  int nout = 0;
   int ret = 0;
 
-  while (written < count)
-    {
-      FAR struct hostfs_rpmsg_write_s *msg;
-      uint32_t space;
-
-      msg = rpmsg_get_tx_payload_buffer(&priv->ept, &space, true);
-      if (!msg)
-        {
-          ret = -ENOMEM;
-          break;
-        }
+  /* Keep up to CONFIG_FS_HOSTFS_RPMSG_WRITE_WINDOW chunks in flight instead
+   * of waiting for each one to be acknowledged.  The server handles them in
+   * order.  After an error or a short write nothing more is sent and the
+   * data of the requests behind it is not counted, but every outstanding
+   * request must still be waited for since its cookie is on this stack.
+   */
 
-      space -= sizeof(*msg);
-      if (space > count - written)
+  while ((!stop && sent < count) || nout > 0)
+    {
+      if (!stop && sent < count &&
+          nout < CONFIG_FS_HOSTFS_RPMSG_WRITE_WINDOW)
         {
-          space = count - written;
-        }
-
-      msg->fd    = fd;
-      msg->count = C2B(space);
-      memcpy(msg->buf, buf + written, space);
-
-      ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_WRITE, false,
+          FAR struct hostfs_rpmsg_write_s *msg;
+          uint32_t space;
+          int tail;
+
+          msg = rpmsg_get_tx_payload_buffer(&priv->ept, &space, true);
+          if (!msg)
+            {
+              ret  = -ENOMEM;
+              stop = true;
+              continue;
+            }
+
+          space -= sizeof(*msg);
+          if (space > count - sent)
+            {
+              space = count - sent;
+            }
+
+          msg->fd    = fd;
+          msg->count = C2B(space);
+          memcpy(msg->buf, buf + sent, space);
+
+          tail = (head + nout) % CONFIG_FS_HOSTFS_RPMSG_WRITE_WINDOW;
+          ret  = hostfs_rpmsg_send(HOSTFS_RPMSG_WRITE, false,
                                    (FAR struct hostfs_rpmsg_header_s *)msg,
-                                   sizeof(*msg) + space, NULL);
-      if (ret <= 0)
+                                   sizeof(*msg) + space, NULL,
+                                   &cookie[tail]);
+          if (ret < 0)
+            {
+              stop = true;
+              continue;
+            }
+
+          size[tail] = space;
+          sent      += space;
+          nout++;
+        }
+      else
         {
-          break;
+          /* Wait for the oldest outstanding chunk */
+
+          int result = hostfs_rpmsg_wait(&cookie[head]);
+
+          if (counting)
+            {
+              if (result <= 0)
+                {
+                  ret = result;
+                }
+              else
+                {
+                  written += B2C(result);
+                }
+
+              if (result <= 0 || (uint32_t)B2C(result) < size[head])
+                {
+                  counting = false;
+                  stop     = true;
+                }
+            }
+
+          head = (head + 1) % CONFIG_FS_HOSTFS_RPMSG_WRITE_WINDOW;
+          nout--;
         }
-
-      written += B2C(ret);
     }
 
   return written ? written : ret;
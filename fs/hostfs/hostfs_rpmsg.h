@@ -100,6 +100,10 @@ begin_packed_struct struct hostfs_rpmsg_close_s
   int32_t                      fd;
 } end_packed_struct;
 
+/* In a READ reply, 'count' is non-zero if more replies to the same request
+ * follow.
+ */
+
 begin_packed_struct struct hostfs_rpmsg_read_s
 {
   struct hostfs_rpmsg_header_s header;
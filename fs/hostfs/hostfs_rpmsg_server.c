@@ -41,6 +41,7 @@
 #include <nuttx/config.h>
 
 #include <dirent.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <fcntl.h>
@@ -227,30 +228,78 @@ static int hostfs_rpmsg_read_handler(FAR struct rpmsg_endpoint *ept,
   FAR struct hostfs_rpmsg_server_s *priv = priv_;
   FAR struct hostfs_rpmsg_read_s *msg = data;
   FAR struct hostfs_rpmsg_read_s *rsp;
-  int ret = -ENOENT;
+  uint32_t remaining = msg->count;
   uint32_t space;
+  ssize_t nread;
+  bool more;
+  int ret;
+
+  /* Stream the data back without waiting for the client to ask for the
+   * next chunk: fill one rpmsg buffer after another directly from the file
+   * until the request is satisfied, the file ends, or the read comes up
+   * short.  A non-zero count in a reply tells the client that more replies
+   * follow.
+   */
 
-  rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
-  if (!rsp)
+  do
     {
-      return -ENOMEM;
-    }
+      rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+      if (!rsp)
+        {
+          ret = -ENOMEM;
+          break;
+        }
 
-  *rsp = *msg;
+      *rsp = *msg;
 
-  space -= sizeof(*msg);
-  if (space > msg->count)
-    {
-      space = msg->count;
+      space -= sizeof(*msg);
+      if (space > remaining)
+        {
+          space = remaining;
+        }
+
+      nread = -ENOENT;
+      if (msg->fd >= 0 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
+        {
+          nread = file_read(&priv->files[msg->fd], rsp->buf, space);
+        }
+
+      more = nread > 0 && (uint32_t)nread == space &&
+             (uint32_t)nread < remaining;
+      if (more)
+        {
+          remaining -= nread;
+        }
+
+      rsp->count         = more ? remaining : 0;
+      rsp->header.result = nread;
+
+      ret = rpmsg_send_nocopy(ept, rsp,
+                              (nread < 0 ? 0 : nread) + sizeof(*rsp));
+      if (ret < 0 && nread > 0)
+        {
+          /* The client never sees this chunk, so give it back to the file
+           * to keep the file position in step with what the client got.
+           */
+
+          file_seek(&priv->files[msg->fd], -nread, SEEK_CUR);
+        }
     }
+  while (more && ret >= 0);
 
-  if (msg->fd >= 0 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
+  /* The client waits until a reply ends the stream.  If a chunk could not
+   * be sent, end it with a reply that carries the error and no data,
+   * otherwise the client would wait forever.
+   */
+
+  if (ret < 0)
     {
-      ret = file_read(&priv->files[msg->fd], rsp->buf, space);
+      msg->count         = 0;
+      msg->header.result = ret;
+      ret = rpmsg_send(ept, msg, sizeof(*msg));
     }
 
-  rsp->header.result = ret;
-  return rpmsg_send_nocopy(ept, rsp, (ret < 0 ? 0 : ret) + sizeof(*rsp));
+  return ret;
 }
 
 static int hostfs_rpmsg_write_handler(FAR struct rpmsg_endpoint *ept,
@@ -0,0 +1,219 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODE_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODE_CACHE_SIZE  (1 << CONFIG_FS_INODE_CACHE_ORDER)
+#define INODE_CACHE_MASK  (INODE_CACHE_SIZE - 1)
+
+/* FNV-1a parameters */
+
+#define INODE_HASH_BASIS  2166136261u
+#define INODE_HASH_PRIME  16777619u
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One entry in the direct-mapped lookup cache.  An entry is valid only if
+ * its generation matches the current cache generation; any modification of
+ * the tree bumps the generation and so discards all entries at once.
+ */
+
+struct inode_cache_s
+{
+  FAR struct inode *parent;  /* Directory searched (NULL for the top level) */
+  FAR struct inode *node;    /* The inode that was found */
+  FAR struct inode *left;    /* The inode to the "left" of node */
+  uint32_t hash;             /* Hash of (parent, name) */
+  uint32_t gen;              /* Cache generation when the entry was added */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_cache_s g_inode_cache[INODE_CACHE_SIZE];
+static uint32_t g_inode_cachegen = 1;
+static bool g_inode_cacheoff;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+struct inode_cachestats_s g_inode_cachestats;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_match
+ *
+ * Description:
+ *   Return true if the first path segment of 'name' is exactly the name of
+ *   'node'.
+ *
+ ****************************************************************************/
+
+static bool inode_cache_match(FAR const char *name, FAR struct inode *node)
+{
+  FAR const char *nname = node->i_name;
+
+  while (*nname != '\0' && *nname == *name)
+    {
+      nname++;
+      name++;
+    }
+
+  return *nname == '\0' && (*name == '\0' || *name == '/');
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cache_hash
+ ****************************************************************************/
+
+uint32_t inode_cache_hash(FAR struct inode *parent, FAR const char *name)
+{
+  uintptr_t key = (uintptr_t)parent;
+  uint32_t hash = INODE_HASH_BASIS;
+
+  /* Hash the name segment... */
+
+  for (; *name != '\0' && *name != '/'; name++)
+    {
+      hash = (hash ^ (uint8_t)*name) * INODE_HASH_PRIME;
+    }
+
+  /* ...then fold in the address of the directory */
+
+  while (key != 0)
+    {
+      hash = (hash ^ (uint8_t)key) * INODE_HASH_PRIME;
+      key >>= 8;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ ****************************************************************************/
+
+FAR struct inode *inode_cache_lookup(FAR struct inode *parent,
+                                     FAR const char *name, uint32_t hash,
+                                     FAR struct inode **left)
+{
+  FAR struct inode_cache_s *entry = &g_inode_cache[hash & INODE_CACHE_MASK];
+
+  DEBUGASSERT(name != NULL && left != NULL);
+
+  if (g_inode_cacheoff)
+    {
+      return NULL;
+    }
+
+  if (entry->gen == g_inode_cachegen && entry->hash == hash &&
+      entry->parent == parent && inode_cache_match(name, entry->node))
+    {
+      g_inode_cachestats.hits++;
+      *left = entry->left;
+      return entry->node;
+    }
+
+  g_inode_cachestats.misses++;
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: inode_cache_add
+ ****************************************************************************/
+
+void inode_cache_add(FAR struct inode *parent, uint32_t hash,
+                     FAR struct inode *node, FAR struct inode *left)
+{
+  FAR struct inode_cache_s *entry = &g_inode_cache[hash & INODE_CACHE_MASK];
+
+  DEBUGASSERT(node != NULL);
+
+  if (g_inode_cacheoff)
+    {
+      return;
+    }
+
+  entry->parent = parent;
+  entry->node   = node;
+  entry->left   = left;
+  entry->hash   = hash;
+  entry->gen    = g_inode_cachegen;
+}
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ ****************************************************************************/
+
+void inode_cache_invalidate(void)
+{
+  g_inode_cachestats.invalidations++;
+
+  /* Generation zero is never valid.  If the counter wraps, old entries could
+   * appear valid again, so clear the table explicitly in that case.
+   */
+
+  if (++g_inode_cachegen == 0)
+    {
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cachegen = 1;
+    }
+}
+
+/****************************************************************************
+ * Name: inode_cache_enable
+ ****************************************************************************/
+
+void inode_cache_enable(bool enable)
+{
+  g_inode_cacheoff = !enable;
+}
+
+#endif /* CONFIG_FS_INODE_CACHE */
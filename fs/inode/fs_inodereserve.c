@@ -135,6 +135,8 @@ static void inode_insert(FAR struct inode *node,
       node->i_peer = g_root_inode;
       g_root_inode = node;
     }
+
+  inode_cache_invalidate();
 }
 
 /****************************************************************************
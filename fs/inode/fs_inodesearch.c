@@ -241,6 +241,10 @@ static int _inode_search(FAR struct inode_search_s *desc)
   FAR struct inode *left    = NULL;
   FAR struct inode *above   = NULL;
   FAR const char   *relpath = NULL;
+#ifdef CONFIG_FS_INODE_CACHE
+  FAR struct inode *cached;
+  uint32_t hash = 0;
+#endif
   int ret = -ENOENT;
 
   /* Get the search path, skipping over the leading '/'.  The leading '/' is
@@ -280,7 +284,30 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
   while (node != NULL)
     {
-      int result = _inode_compare(name, node);
+      int result;
+
+#ifdef CONFIG_FS_INODE_CACHE
+      /* On entry to each level of the tree, try the lookup cache before
+       * falling back to a scan of the ordered list of peers.
+       */
+
+      cached = NULL;
+      if (left == NULL)
+        {
+          hash   = inode_cache_hash(above, name);
+          cached = inode_cache_lookup(above, name, hash, &left);
+        }
+
+      if (cached != NULL)
+        {
+          node   = cached;
+          result = 0;
+        }
+      else
+#endif
+        {
+          result = _inode_compare(name, node);
+        }
 
       /* Case 1:  The name is less than the name of the node.
        * Since the names are ordered, these means that there
@@ -318,6 +345,13 @@ static int _inode_search(FAR struct inode_search_s *desc)
            *       below this one
            */
 
+#ifdef CONFIG_FS_INODE_CACHE
+          if (cached == NULL)
+            {
+              inode_cache_add(above, hash, node, left);
+            }
+#endif
+
           name = inode_nextname(name);
           if (*name == '\0' || INODE_IS_MOUNTPT(node))
             {
@@ -136,6 +136,19 @@ typedef int (*foreach_inode_t)(FAR struct inode *node,
                                FAR char dirpath[PATH_MAX],
                                FAR void *arg);
 
+#ifdef CONFIG_FS_INODE_CACHE
+/* Statistics maintained by the inode lookup cache.  These are reported by
+ * the procfs fs/inodecache entry.
+ */
+
+struct inode_cachestats_s
+{
+  uint32_t hits;             /* Path components resolved from the cache */
+  uint32_t misses;           /* Path components resolved by a peer scan */
+  uint32_t invalidations;    /* Number of tree modifications */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -151,6 +164,10 @@ extern "C"
 
 EXTERN FAR struct inode *g_root_inode;
 
+#ifdef CONFIG_FS_INODE_CACHE
+EXTERN struct inode_cachestats_s g_inode_cachestats;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -222,6 +239,80 @@ int inode_checkflags(FAR struct inode *inode, int oflags);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cache_hash
+ *
+ * Description:
+ *   Return the hash of the first path segment of 'name' in the directory
+ *   'parent' (NULL for the top level of the tree).  The hash is passed to
+ *   inode_cache_lookup() and inode_cache_add().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODE_CACHE
+uint32_t inode_cache_hash(FAR struct inode *parent, FAR const char *name);
+
+/****************************************************************************
+ * Name: inode_cache_lookup
+ *
+ * Description:
+ *   Look up the first path segment of 'name' in the directory 'parent'.
+ *   On a hit, the cached inode is returned and the inode to its "left" is
+ *   returned in 'left'.  NULL is returned on a miss.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+FAR struct inode *inode_cache_lookup(FAR struct inode *parent,
+                                     FAR const char *name, uint32_t hash,
+                                     FAR struct inode **left);
+
+/****************************************************************************
+ * Name: inode_cache_add
+ *
+ * Description:
+ *   Remember that 'node', with 'left' to its left, was found in the
+ *   directory 'parent' under the name with the given hash.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_add(FAR struct inode *parent, uint32_t hash,
+                     FAR struct inode *node, FAR struct inode *left);
+
+/****************************************************************************
+ * Name: inode_cache_invalidate
+ *
+ * Description:
+ *   Discard every cached lookup.  This must be called whenever an inode is
+ *   linked into or unlinked from the tree.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cache_invalidate(void);
+
+/****************************************************************************
+ * Name: inode_cache_enable
+ *
+ * Description:
+ *   Turn the lookup cache on or off at run time, so that its effect can be
+ *   measured without rebuilding.  The cache is on by default.  Tree
+ *   modifications still invalidate the cache while it is off.
+ *
+ ****************************************************************************/
+
+void inode_cache_enable(bool enable);
+#else
+#  define inode_cache_invalidate()
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
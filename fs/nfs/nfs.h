@@ -49,6 +49,7 @@
  ****************************************************************************/
 
 #include "nfs_mount.h"
+#include "nfs_node.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -124,6 +125,14 @@ EXTERN int nfs_finddir(FAR struct nfsmount *nmp, FAR const char *relpath,
               FAR struct nfs_fattr *attributes, FAR char *filename);
 EXTERN void nfs_attrupdate(FAR struct nfsnode *np,
               FAR struct nfs_fattr *attributes);
+EXTERN int  nfs_checkreply(FAR void *response);
+
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+EXTERN void nfs_attrcache_invalidate(FAR struct nfsmount *nmp,
+              FAR struct nfsnode *np);
+#else
+#  define nfs_attrcache_invalidate(nmp, np)
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
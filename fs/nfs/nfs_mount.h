@@ -49,6 +49,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <time.h>
 #include <nuttx/semaphore.h>
 
 #include "rpc.h"
@@ -61,6 +62,18 @@
  * Public Types
  ****************************************************************************/
 
+/* One entry of the lookup/attribute cache */
+
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+struct nfs_attrcache_s
+{
+  FAR char                 *ac_path;          /* Path or NULL if unused */
+  clock_t                   ac_time;          /* Time the entry was filled */
+  struct file_handle        ac_fhandle;       /* File handle of the object */
+  struct nfs_fattr          ac_fattr;         /* Attributes of the object */
+};
+#endif
+
 /* Mount structure. One mount structure is allocated for each NFS mount. This
  * structure holds NFS specific information for mount.
  */
@@ -79,6 +92,10 @@ struct nfsmount
   uint16_t                  nm_wsize;         /* Max size of write RPC */
   uint16_t                  nm_readdirsize;   /* Size of a readdir RPC */
   uint16_t                  nm_buflen;        /* Size of I/O buffer */
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+  uint8_t                   nm_acnext;        /* Next entry to replace */
+  struct nfs_attrcache_s    nm_attrcache[CONFIG_NFS_ATTRCACHE_ENTRIES];
+#endif
 
   /* Set aside memory on the stack to hold the largest call message.  NOTE
    * that for the case of the write call message, it is the reply message that
@@ -98,6 +115,7 @@ struct nfsmount
     struct rpc_call_fs      fsstat;
     struct rpc_call_setattr setattr;
     struct rpc_call_fs      fsinfo;
+    struct rpc_call_commit  commit;
     struct rpc_reply_write  write;
   } nm_msgbuffer;
 
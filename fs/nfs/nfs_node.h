@@ -50,6 +50,15 @@
 
 #include "nfs_proto.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bit definitions for n_flags */
+
+#define NFSNODE_UNSTABLE  (1 << 0)  /* UNSTABLE data needs a COMMIT */
+#define NFSNODE_WRITEERR  (1 << 1)  /* UNSTABLE data may have been lost */
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -70,6 +79,22 @@ struct nfsnode
   time_t              n_ctime;      /* File creation time */
   nfsfh_t             n_fhandle;    /* NFS File Handle */
   uint64_t            n_size;       /* Current size of file */
+  uint8_t             n_flags;      /* See NFSNODE_* definitions */
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+  FAR uint8_t        *n_rabuf;      /* Read-ahead buffer */
+  uint64_t            n_raoffset;   /* File offset of n_rabuf[0] */
+  uint32_t            n_ralen;      /* Number of valid bytes in n_rabuf */
+  uint64_t            n_rdnext;     /* File offset following the last read */
+#endif
+#ifdef CONFIG_NFS_WRITEBEHIND
+  FAR uint8_t        *n_wbbuf;      /* Write-behind buffer */
+  uint64_t            n_wboffset;   /* File offset of n_wbbuf[0] */
+  uint32_t            n_wblen;      /* Number of dirty bytes in n_wbbuf */
+
+  /* Write verifier returned by the first UNSTABLE write */
+
+  uint8_t             n_wverf[NFSX_V3WRITEVERF];
+#endif
 };
 
 #endif /* __FS_NFS_NFS_NODE_H */
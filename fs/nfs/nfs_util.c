@@ -50,6 +50,9 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+
 #include "rpc.h"
 #include "nfs.h"
 #include "nfs_proto.h"
@@ -113,6 +116,96 @@ static inline int nfs_pathsegment(FAR const char **path, FAR char *buffer,
     }
 }
 
+/****************************************************************************
+ * Name: nfs_attrcache_lookup
+ *
+ * Description:
+ *   Look up the file handle and attributes of 'relpath' in the lookup
+ *   cache.  Returns true if a valid entry was found.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+static bool nfs_attrcache_lookup(FAR struct nfsmount *nmp,
+                                 FAR const char *relpath,
+                                 FAR struct file_handle *fhandle,
+                                 FAR struct nfs_fattr *obj_attributes)
+{
+  FAR struct nfs_attrcache_s *ac;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_ENTRIES; i++)
+    {
+      ac = &nmp->nm_attrcache[i];
+      if (ac->ac_path == NULL || strcmp(ac->ac_path, relpath) != 0)
+        {
+          continue;
+        }
+
+      /* Found it.  Discard the entry if it has expired. */
+
+      if (now - ac->ac_time >= MSEC2TICK(CONFIG_NFS_ATTRCACHE_TIMEO))
+        {
+          kmm_free(ac->ac_path);
+          ac->ac_path = NULL;
+          return false;
+        }
+
+      fhandle->length = ac->ac_fhandle.length;
+      memcpy(&fhandle->handle, &ac->ac_fhandle.handle, fhandle->length);
+
+      if (obj_attributes != NULL)
+        {
+          memcpy(obj_attributes, &ac->ac_fattr, sizeof(struct nfs_fattr));
+        }
+
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: nfs_attrcache_add
+ *
+ * Description:
+ *   Remember the file handle and attributes of 'relpath', replacing the
+ *   oldest entry of the cache.
+ *
+ ****************************************************************************/
+
+static void nfs_attrcache_add(FAR struct nfsmount *nmp,
+                              FAR const char *relpath,
+                              FAR const struct file_handle *fhandle,
+                              FAR const struct nfs_fattr *obj_attributes)
+{
+  FAR struct nfs_attrcache_s *ac;
+
+  ac = &nmp->nm_attrcache[nmp->nm_acnext];
+  if (++nmp->nm_acnext >= CONFIG_NFS_ATTRCACHE_ENTRIES)
+    {
+      nmp->nm_acnext = 0;
+    }
+
+  if (ac->ac_path != NULL)
+    {
+      kmm_free(ac->ac_path);
+    }
+
+  ac->ac_path = strdup(relpath);
+  if (ac->ac_path == NULL)
+    {
+      return;
+    }
+
+  ac->ac_time = clock_systime_ticks();
+  ac->ac_fhandle.length = fhandle->length;
+  memcpy(&ac->ac_fhandle.handle, &fhandle->handle, fhandle->length);
+  memcpy(&ac->ac_fattr, obj_attributes, sizeof(struct nfs_fattr));
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -134,7 +227,6 @@ int nfs_request(FAR struct nfsmount *nmp, int procnum,
                 FAR void *response, size_t resplen)
 {
   FAR struct rpcclnt *clnt = nmp->nm_rpcclnt;
-  struct nfs_reply_header replyh;
   int error;
 
   error = rpcclnt_request(clnt, procnum, NFS_PROG, NFS_VER3,
@@ -145,6 +237,26 @@ int nfs_request(FAR struct nfsmount *nmp, int procnum,
       return error;
     }
 
+  return nfs_checkreply(response);
+}
+
+/****************************************************************************
+ * Name: nfs_checkreply
+ *
+ * Description:
+ *   Verify the NFS level status of a reply that has already passed the RPC
+ *   level checks.
+ *
+ * Returned Value:
+ *   Zero on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+int nfs_checkreply(FAR void *response)
+{
+  struct nfs_reply_header replyh;
+  int error;
+
   memcpy(&replyh, response, sizeof(struct nfs_reply_header));
 
   if (replyh.nfs_status != 0)
@@ -337,6 +449,18 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
       return OK;
     }
 
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+  /* Check if the path was looked up recently.  The cache does not hold the
+   * attributes of the parent directory.
+   */
+
+  if (dir_attributes == NULL &&
+      nfs_attrcache_lookup(nmp, relpath, fhandle, obj_attributes))
+    {
+      return OK;
+    }
+#endif
+
   /* This is not the root directory. Loop until the directory entry corresponding
    * to the path is found.
    */
@@ -376,6 +500,13 @@ int nfs_findnode(FAR struct nfsmount *nmp, FAR const char *relpath,
            * directory entry is in fhandle, obj_attributes, and dir_attributes.
            */
 
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+          if (obj_attributes != NULL)
+            {
+              nfs_attrcache_add(nmp, relpath, fhandle, obj_attributes);
+            }
+#endif
+
           return OK;
         }
 
@@ -515,3 +646,43 @@ void nfs_attrupdate(FAR struct nfsnode *np, FAR struct nfs_fattr *attributes)
   fxdr_nfsv3time(&attributes->fa_ctime, &ts);
   np->n_ctime  = ts.tv_sec;
 }
+
+/****************************************************************************
+ * Name: nfs_attrcache_invalidate
+ *
+ * Description:
+ *   Discard the lookup cache entries that refer to the file of 'np' or, if
+ *   'np' is NULL, all entries.  Called whenever this client changes a file
+ *   or the name space.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFS_ATTRCACHE_ENTRIES > 0
+void nfs_attrcache_invalidate(FAR struct nfsmount *nmp,
+                              FAR struct nfsnode *np)
+{
+  FAR struct nfs_attrcache_s *ac;
+  int i;
+
+  for (i = 0; i < CONFIG_NFS_ATTRCACHE_ENTRIES; i++)
+    {
+      ac = &nmp->nm_attrcache[i];
+      if (ac->ac_path == NULL)
+        {
+          continue;
+        }
+
+      if (np == NULL ||
+          (ac->ac_fhandle.length == np->n_fhsize &&
+           memcmp(&ac->ac_fhandle.handle, &np->n_fhandle,
+                  np->n_fhsize) == 0))
+        {
+          kmm_free(ac->ac_path);
+          ac->ac_path = NULL;
+        }
+    }
+}
+#endif
@@ -96,6 +96,41 @@
 #  error "Length of cookie verify in fs_dirent_s is incorrect"
 #endif
 
+/* Maximum number of READ or WRITE RPCs prepared for one pipelined batch */
+
+#define NFS_MAXBATCH       (2 * CONFIG_NFS_PIPELINE_DEPTH)
+
+/* Values of nfs_iorpc_s::state */
+
+#define NFS_IORPC_IDLE     0  /* Not sent (or the remainder must be re-sent) */
+#define NFS_IORPC_SENT     1  /* Waiting for the reply */
+#define NFS_IORPC_DONE     2  /* Completed */
+
+/* Stability requested for WRITE RPCs */
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+#  define NFS_WRITE_STABLE NFSV3WRITE_UNSTABLE
+#else
+#  define NFS_WRITE_STABLE NFSV3WRITE_FILESYNC
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Describes one READ or WRITE RPC of a pipelined transfer */
+
+struct nfs_iorpc_s
+{
+  FAR uint8_t *buffer;     /* Data destination (READ) or source (WRITE) */
+  uint64_t     offset;     /* File offset corresponding to buffer[0] */
+  uint32_t     count;      /* Number of bytes to transfer */
+  uint32_t     nbytes;     /* Number of bytes transferred so far */
+  uint32_t     xid;        /* RPC transaction ID (zero if none yet) */
+  uint8_t      state;      /* See NFS_IORPC_* definitions */
+  bool         eof;        /* READ: The server reported end-of-file */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -116,6 +151,24 @@ static int     nfs_filecreate(FAR struct nfsmount *nmp,
                    mode_t mode);
 static int     nfs_filetruncate(FAR struct nfsmount *nmp,
                    FAR struct nfsnode *np, uint32_t length);
+static uint32_t nfs_rchunk(FAR struct nfsmount *nmp);
+static uint32_t nfs_wchunk(FAR struct nfsmount *nmp);
+static int     nfs_iosend(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                          int procnum, FAR struct nfs_iorpc_s *io);
+static void    nfs_ioreply(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                           int procnum, FAR struct nfs_iorpc_s *io,
+                           FAR uint32_t *ptr);
+static int     nfs_iotransfer(FAR struct nfsmount *nmp,
+                              FAR struct nfsnode *np, int procnum,
+                              FAR struct nfs_iorpc_s *io, int nio);
+static ssize_t nfs_iodata(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                          int procnum, FAR uint8_t *buffer, uint64_t offset,
+                          size_t buflen);
+#ifdef CONFIG_NFS_WRITEBEHIND
+static int     nfs_flush(FAR struct nfsmount *nmp, FAR struct nfsnode *np);
+static int     nfs_commit(FAR struct nfsmount *nmp, FAR struct nfsnode *np);
+#endif
+static void    nfs_freenode(FAR struct nfsnode *np);
 static int     nfs_fileopen(FAR struct nfsmount *nmp,
                    FAR struct nfsnode *np, FAR const char *relpath,
                    int oflags, mode_t mode);
@@ -127,6 +180,7 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
                         size_t buflen);
 static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
                    size_t buflen);
+static int     nfs_sync(FAR struct file *filep);
 static int     nfs_dup(FAR const struct file *oldp, FAR struct file *newp);
 static int     nfs_fsinfo(FAR struct nfsmount *nmp);
 static int     nfs_fstat(FAR const struct file *filep, FAR struct stat *buf);
@@ -161,62 +215,667 @@ static int     nfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
  * Public Data
  ****************************************************************************/
 
-#ifdef CONFIG_NFS_STATISTICS
-struct nfsstats nfsstats;
-#endif
+#ifdef CONFIG_NFS_STATISTICS
+struct nfsstats nfsstats;
+#endif
+
+/* nfs vfs operations. */
+
+const struct mountpt_operations nfs_operations =
+{
+  nfs_open,                     /* open */
+  nfs_close,                    /* close */
+  nfs_read,                     /* read */
+  nfs_write,                    /* write */
+  NULL,                         /* seek */
+  NULL,                         /* ioctl */
+
+  nfs_sync,                     /* sync */
+  nfs_dup,                      /* dup */
+  nfs_fstat,                    /* fstat */
+  nfs_truncate,                 /* truncate */
+
+  nfs_opendir,                  /* opendir */
+  NULL,                         /* closedir */
+  nfs_readdir,                  /* readdir */
+  nfs_rewinddir,                /* rewinddir */
+
+  nfs_bind,                     /* bind */
+  nfs_unbind,                   /* unbind */
+  nfs_statfs,                   /* statfs */
+
+  nfs_remove,                   /* unlink */
+  nfs_mkdir,                    /* mkdir */
+  nfs_rmdir,                    /* rmdir */
+  nfs_rename,                   /* rename */
+  nfs_stat                      /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nfs_semtake
+ ****************************************************************************/
+
+static int nfs_semtake(FAR struct nfsmount *nmp)
+{
+  return nxsem_wait_uninterruptible(&nmp->nm_sem);
+}
+
+/****************************************************************************
+ * Name: nfs_semgive
+ ****************************************************************************/
+
+static void nfs_semgive(FAR struct nfsmount *nmp)
+{
+  nxsem_post(&nmp->nm_sem);
+}
+
+/****************************************************************************
+ * Name: nfs_rchunk and nfs_wchunk
+ *
+ * Description:
+ *   Return the number of data bytes carried by one READ or WRITE RPC.  This
+ *   is the negotiated rsize/wsize, limited by the size of the I/O buffer.
+ *
+ ****************************************************************************/
+
+static uint32_t nfs_rchunk(FAR struct nfsmount *nmp)
+{
+  uint32_t max = nmp->nm_buflen - SIZEOF_rpc_reply_read(0);
+
+  return nmp->nm_rsize < max ? nmp->nm_rsize : max;
+}
+
+static uint32_t nfs_wchunk(FAR struct nfsmount *nmp)
+{
+  uint32_t max = nmp->nm_buflen - SIZEOF_rpc_call_write(0);
+
+  return nmp->nm_wsize < max ? nmp->nm_wsize : max;
+}
+
+/****************************************************************************
+ * Name: nfs_iosend
+ *
+ * Description:
+ *   Format and send the READ or WRITE call for the untransferred part of
+ *   'io' without waiting for the reply.  An RPC that is already outstanding
+ *   keeps its transaction ID so that this acts as a retransmission.
+ *
+ *   The READ call is formatted in nm_msgbuffer and its reply is received in
+ *   nm_iobuffer.  The WRITE call is formatted in nm_iobuffer (it carries the
+ *   data) and its reply is received in nm_msgbuffer.
+ *
+ * Returned Value:
+ *   0 on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_iosend(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                      int procnum, FAR struct nfs_iorpc_s *io)
+{
+  FAR void     *request;
+  FAR uint32_t *ptr;
+  uint32_t      count;
+  size_t        reqlen;
+
+  if (procnum == NFSPROC_READ)
+    {
+      request = &nmp->nm_msgbuffer.read;
+      ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
+    }
+  else
+    {
+      request = nmp->nm_iobuffer;
+      ptr     = (FAR uint32_t *)&((FAR struct rpc_call_write *)
+                  nmp->nm_iobuffer)->write;
+    }
+
+  count   = io->count - io->nbytes;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  /* Copy the file offset and the count */
+
+  txdr_hyper(io->offset + io->nbytes, ptr);
+  ptr    += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  *ptr++  = txdr_unsigned(count);
+  reqlen += sizeof(uint32_t);
+
+  if (procnum == NFSPROC_WRITE)
+    {
+      /* Copy the stable value and the data */
+
+      *ptr++  = txdr_unsigned(NFS_WRITE_STABLE);
+      *ptr++  = txdr_unsigned(count);
+      reqlen += 2*sizeof(uint32_t);
+
+      memcpy(ptr, io->buffer + io->nbytes, count);
+      reqlen += uint32_alignup(count);
+    }
+
+  nfs_statistics(procnum);
+  io->state = NFS_IORPC_SENT;
+  return rpcclnt_send(nmp->nm_rpcclnt, procnum, NFS_PROG, NFS_VER3,
+                      request, reqlen, &io->xid);
+}
+
+/****************************************************************************
+ * Name: nfs_ioreply
+ *
+ * Description:
+ *   Process the successful reply to the READ or WRITE RPC 'io'.  'ptr'
+ *   points to the beginning of the NFS response data.  If the server
+ *   transferred less than requested, the RPC is marked to be re-sent for
+ *   the remainder.
+ *
+ ****************************************************************************/
+
+static void nfs_ioreply(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                        int procnum, FAR struct nfs_iorpc_s *io,
+                        FAR uint32_t *ptr)
+{
+  uint64_t size = np->n_size;
+  uint32_t count = io->count - io->nbytes;
+  uint32_t nbytes;
+  uint32_t commit;
+
+  if (procnum == NFSPROC_READ)
+    {
+      /* Check if attributes are included in the responses */
+
+      if (*ptr++ != 0)
+        {
+          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+          ptr += uint32_increment(sizeof(struct nfs_fattr));
+        }
+
+      /* Skip the count, get the EOF indication and the data length */
+
+      ptr++;
+      io->eof = (*ptr++ != 0);
+      nbytes  = fxdr_unsigned(uint32_t, *ptr);
+      ptr++;
+
+      if (nbytes > count)
+        {
+          nbytes = count;
+        }
+
+      memcpy(io->buffer + io->nbytes, ptr, nbytes);
+
+      /* A read returning no data ends the transfer even without EOF */
+
+      if (nbytes == 0)
+        {
+          io->eof = true;
+        }
+    }
+  else
+    {
+      /* Parse file_wcc.  Skip over the WCC attributes */
+
+      if (*ptr++ != 0)
+        {
+          ptr += uint32_increment(sizeof(struct wcc_attr));
+        }
+
+      /* Update the cached attributes.  Replies may arrive out of order so
+       * never let an older reply shrink the file.
+       */
+
+      if (*ptr++ != 0)
+        {
+          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+          ptr += uint32_increment(sizeof(struct nfs_fattr));
+
+          if (np->n_size < size)
+            {
+              np->n_size = size;
+            }
+        }
+
+      nbytes = fxdr_unsigned(uint32_t, *ptr);
+      ptr++;
+
+      if (nbytes < 1 || nbytes > count)
+        {
+          /* Treat a bogus count like an error from the server */
+
+          nbytes  = 0;
+          io->eof = true;
+        }
+
+      commit = fxdr_unsigned(uint32_t, *ptr);
+      ptr++;
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+      /* UNSTABLE data must be committed later.  Remember the write verifier
+       * of the server;  if it changes, the server restarted and may have
+       * lost data that was not committed.
+       */
+
+      if (nbytes > 0 && commit != NFSV3WRITE_FILESYNC)
+        {
+          if ((np->n_flags & NFSNODE_UNSTABLE) == 0)
+            {
+              memcpy(np->n_wverf, ptr, NFSX_V3WRITEVERF);
+              np->n_flags |= NFSNODE_UNSTABLE;
+            }
+          else if (memcmp(np->n_wverf, ptr, NFSX_V3WRITEVERF) != 0)
+            {
+              np->n_flags |= NFSNODE_WRITEERR;
+            }
+        }
+#else
+      UNUSED(commit);
+#endif
+    }
+
+  io->nbytes += nbytes;
+  if (io->eof || io->nbytes >= io->count)
+    {
+      io->state = NFS_IORPC_DONE;
+    }
+  else
+    {
+      /* Short transfer.  Send the remainder with a new transaction ID. */
+
+      io->state = NFS_IORPC_IDLE;
+      io->xid   = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: nfs_iotransfer
+ *
+ * Description:
+ *   Perform the READ or WRITE RPCs described by 'io' with up to
+ *   CONFIG_NFS_PIPELINE_DEPTH calls outstanding at any time.  The replies
+ *   may arrive in any order and are matched to the calls by transaction
+ *   ID.  If no reply arrives within the RPC timeout, all outstanding calls
+ *   are retransmitted.
+ *
+ * Returned Value:
+ *   0 on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_iotransfer(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                          int procnum, FAR struct nfs_iorpc_s *io, int nio)
+{
+  FAR struct rpcclnt *rpc = nmp->nm_rpcclnt;
+  FAR void *response;
+  FAR uint32_t *ptr;
+  size_t resplen;
+  uint32_t xid;
+  int outstanding = 0;
+  int retries = 0;
+  int ndone = 0;
+  int ret;
+  int i;
+
+  if (procnum == NFSPROC_READ)
+    {
+      response = nmp->nm_iobuffer;
+      resplen  = nmp->nm_buflen;
+      ptr      = (FAR uint32_t *)
+                 &((FAR struct rpc_reply_read *)response)->read;
+    }
+  else
+    {
+      response = &nmp->nm_msgbuffer.write;
+      resplen  = sizeof(struct rpc_reply_write);
+      ptr      = (FAR uint32_t *)&nmp->nm_msgbuffer.write.write;
+    }
+
+  while (ndone < nio)
+    {
+      /* Keep the pipeline full */
+
+      for (i = 0; i < nio && outstanding < CONFIG_NFS_PIPELINE_DEPTH; i++)
+        {
+          if (io[i].state == NFS_IORPC_IDLE)
+            {
+              ret = nfs_iosend(nmp, np, procnum, &io[i]);
+              if (ret < 0)
+                {
+                  ferr("ERROR: rpcclnt_send failed: %d\n", ret);
+                  return ret;
+                }
+
+              outstanding++;
+            }
+        }
+
+      /* Wait for the next reply */
+
+      ret = rpcclnt_receive(rpc, &xid, response, resplen);
+      if (ret == -EAGAIN || ret == -ETIMEDOUT)
+        {
+          if (++retries >= rpc->rc_retry)
+            {
+              ferr("ERROR: No reply from the server\n");
+              return ret;
+            }
+
+          /* Retransmit everything that is still outstanding */
+
+          for (i = 0; i < nio; i++)
+            {
+              if (io[i].state == NFS_IORPC_SENT)
+                {
+                  ret = nfs_iosend(nmp, np, procnum, &io[i]);
+                  if (ret < 0)
+                    {
+                      return ret;
+                    }
+                }
+            }
+
+          continue;
+        }
+      else if (ret < 0)
+        {
+          ferr("ERROR: rpcclnt_receive failed: %d\n", ret);
+          return ret;
+        }
+
+      /* Find the call that this reply belongs to.  Late or duplicate
+       * replies to calls that already completed are ignored.
+       */
+
+      for (i = 0; i < nio; i++)
+        {
+          if (io[i].state == NFS_IORPC_SENT && io[i].xid == xid)
+            {
+              break;
+            }
+        }
+
+      if (i >= nio)
+        {
+          finfo("Ignoring reply with XID %u\n", xid);
+          continue;
+        }
+
+      ret = nfs_checkreply(response);
+      if (ret < 0)
+        {
+          ferr("ERROR: NFS request failed: %d\n", ret);
+          return ret;
+        }
+
+      nfs_ioreply(nmp, np, procnum, &io[i], ptr);
+
+      outstanding--;
+      retries = 0;
+
+      if (io[i].state == NFS_IORPC_DONE)
+        {
+          ndone++;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_iodata
+ *
+ * Description:
+ *   Read or write 'buflen' bytes at file offset 'offset', splitting the
+ *   transfer into pipelined READ or WRITE RPCs.
+ *
+ * Returned Value:
+ *   The number of bytes transferred.  For READ, this is less than 'buflen'
+ *   only at the end of the file.  A negative errno value is returned if an
+ *   error occurs before any data was transferred.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_iodata(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                          int procnum, FAR uint8_t *buffer, uint64_t offset,
+                          size_t buflen)
+{
+  struct nfs_iorpc_s io[NFS_MAXBATCH];
+  uint32_t chunk;
+  size_t total = 0;
+  size_t pos;
+  int nio;
+  int ret;
+  int i;
+
+  chunk = procnum == NFSPROC_READ ? nfs_rchunk(nmp) : nfs_wchunk(nmp);
+
+  while (total < buflen)
+    {
+      /* Describe the next batch of RPCs */
+
+      for (nio = 0, pos = total; nio < NFS_MAXBATCH && pos < buflen; nio++)
+        {
+          io[nio].buffer = buffer + pos;
+          io[nio].offset = offset + pos;
+          io[nio].count  = buflen - pos < chunk ? buflen - pos : chunk;
+          io[nio].nbytes = 0;
+          io[nio].xid    = 0;
+          io[nio].state  = NFS_IORPC_IDLE;
+          io[nio].eof    = false;
+          pos           += io[nio].count;
+        }
+
+      ret = nfs_iotransfer(nmp, np, procnum, io, nio);
+
+      /* Only the data up to the first incomplete RPC is contiguous */
+
+      for (i = 0; i < nio; i++)
+        {
+          total += io[i].nbytes;
+          if (io[i].nbytes < io[i].count)
+            {
+              break;
+            }
+        }
+
+      if (ret < 0)
+        {
+          return total > 0 ? (ssize_t)total : ret;
+        }
+
+      if (i < nio)
+        {
+          /* End of file (READ) or the server refused the data (WRITE) */
+
+          if (procnum == NFSPROC_WRITE && total == 0)
+            {
+              return -EIO;
+            }
+
+          break;
+        }
+    }
+
+  return total;
+}
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+/****************************************************************************
+ * Name: nfs_flush
+ *
+ * Description:
+ *   Send the data held in the write-behind buffer of the file to the
+ *   server.
+ *
+ * Returned Value:
+ *   0 on success; a negative errno value on failure.
+ *
+ ****************************************************************************/
+
+static int nfs_flush(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  ssize_t nwritten;
+
+  if (np->n_wblen == 0)
+    {
+      return OK;
+    }
+
+  nwritten = nfs_iodata(nmp, np, NFSPROC_WRITE, np->n_wbbuf,
+                        np->n_wboffset, np->n_wblen);
+  if (nwritten < 0)
+    {
+      return (int)nwritten;
+    }
+
+  /* Keep any data that the server did not accept so that a later flush
+   * will retry it.
+   */
+
+  if (nwritten < np->n_wblen)
+    {
+      memmove(np->n_wbbuf, np->n_wbbuf + nwritten, np->n_wblen - nwritten);
+      np->n_wboffset += nwritten;
+      np->n_wblen    -= nwritten;
+      return -EIO;
+    }
+
+  np->n_wblen = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nfs_commit
+ *
+ * Description:
+ *   Flush the write-behind buffer and, if UNSTABLE data was written, ask
+ *   the server to commit it to stable storage.
+ *
+ * Returned Value:
+ *   0 on success; a negative errno value on failure.  -EIO is returned if
+ *   the server restarted since the data was written and the data may have
+ *   been lost.
+ *
+ ****************************************************************************/
+
+static int nfs_commit(FAR struct nfsmount *nmp, FAR struct nfsnode *np)
+{
+  FAR uint32_t *ptr;
+  uint64_t      size;
+  int           reqlen;
+  int           ret;
+
+  ret = nfs_flush(nmp, np);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((np->n_flags & NFSNODE_UNSTABLE) == 0)
+    {
+      return OK;
+    }
+
+  /* Create the COMMIT RPC call arguments: commit the whole file */
+
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.commit.commit;
+  reqlen  = 0;
+
+  *ptr++  = txdr_unsigned(np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  txdr_hyper((uint64_t)0, ptr);
+  ptr    += 2;
+  *ptr++  = 0;
+  reqlen += 3*sizeof(uint32_t);
+
+  nfs_statistics(NFSPROC_COMMIT);
+  ret = nfs_request(nmp, NFSPROC_COMMIT,
+                    (FAR void *)&nmp->nm_msgbuffer.commit, reqlen,
+                    (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
+  if (ret != OK)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", ret);
+      return ret;
+    }
+
+  /* Parse file_wcc */
 
-/* nfs vfs operations. */
+  ptr = (FAR uint32_t *)&((FAR struct rpc_reply_commit *)
+    nmp->nm_iobuffer)->commit;
 
-const struct mountpt_operations nfs_operations =
-{
-  nfs_open,                     /* open */
-  nfs_close,                    /* close */
-  nfs_read,                     /* read */
-  nfs_write,                    /* write */
-  NULL,                         /* seek */
-  NULL,                         /* ioctl */
+  if (*ptr++ != 0)
+    {
+      ptr += uint32_increment(sizeof(struct wcc_attr));
+    }
 
-  NULL,                         /* sync */
-  nfs_dup,                      /* dup */
-  nfs_fstat,                    /* fstat */
-  nfs_truncate,                 /* truncate */
+  if (*ptr++ != 0)
+    {
+      size = np->n_size;
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
 
-  nfs_opendir,                  /* opendir */
-  NULL,                         /* closedir */
-  nfs_readdir,                  /* readdir */
-  nfs_rewinddir,                /* rewinddir */
+      if (np->n_size < size)
+        {
+          np->n_size = size;
+        }
+    }
 
-  nfs_bind,                     /* bind */
-  nfs_unbind,                   /* unbind */
-  nfs_statfs,                   /* statfs */
+  /* A different verifier means that the server restarted after some of the
+   * data was written.  That data may be lost.
+   */
 
-  nfs_remove,                   /* unlink */
-  nfs_mkdir,                    /* mkdir */
-  nfs_rmdir,                    /* rmdir */
-  nfs_rename,                   /* rename */
-  nfs_stat                      /* stat */
-};
+  if (memcmp(np->n_wverf, ptr, NFSX_V3WRITEVERF) != 0)
+    {
+      np->n_flags |= NFSNODE_WRITEERR;
+    }
 
-/****************************************************************************
- * Private Functions
- ****************************************************************************/
+  ret = (np->n_flags & NFSNODE_WRITEERR) != 0 ? -EIO : OK;
+  np->n_flags &= ~(NFSNODE_UNSTABLE | NFSNODE_WRITEERR);
+  return ret;
+}
+#endif
 
 /****************************************************************************
- * Name: nfs_semtake
+ * Name: nfs_freenode
+ *
+ * Description:
+ *   Free an nfsnode and its buffers.
+ *
  ****************************************************************************/
 
-static int nfs_semtake(FAR struct nfsmount *nmp)
+static void nfs_freenode(FAR struct nfsnode *np)
 {
-  return nxsem_wait_uninterruptible(&nmp->nm_sem);
-}
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+  if (np->n_rabuf != NULL)
+    {
+      kmm_free(np->n_rabuf);
+    }
+#endif
 
-/****************************************************************************
- * Name: nfs_semgive
- ****************************************************************************/
+#ifdef CONFIG_NFS_WRITEBEHIND
+  if (np->n_wbbuf != NULL)
+    {
+      kmm_free(np->n_wbbuf);
+    }
+#endif
 
-static void nfs_semgive(FAR struct nfsmount *nmp)
-{
-  nxsem_post(&nmp->nm_sem);
+  kmm_free(np);
 }
 
 /****************************************************************************
@@ -650,6 +1309,13 @@ static int nfs_open(FAR struct file *filep, FAR const char *relpath,
 
   np->n_crefs = 1;
 
+  /* Truncating or creating the file changed its attributes */
+
+  if ((oflags & (O_CREAT | O_TRUNC)) != 0)
+    {
+      nfs_attrcache_invalidate(nmp, np);
+    }
+
   /* Attach the private data to the struct file instance */
 
   filep->f_priv = np;
@@ -733,6 +1399,14 @@ static int nfs_close(FAR struct file *filep)
 
   else
     {
+#ifdef CONFIG_NFS_WRITEBEHIND
+      /* Send any buffered data and commit it to stable storage.  An error
+       * here is reported but the file is closed anyway.
+       */
+
+      int commitret = nfs_commit(nmp, np);
+#endif
+
       /* Assume file structure will not be found.  This should never happen. */
 
       ret = -EINVAL;
@@ -762,11 +1436,18 @@ static int nfs_close(FAR struct file *filep)
 
               /* Then deallocate the file structure and return success */
 
-              kmm_free(np);
+              nfs_freenode(np);
               ret = OK;
               break;
             }
         }
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+      if (ret == OK && commitret < 0)
+        {
+          ret = commitret;
+        }
+#endif
     }
 
   filep->f_priv = NULL;
@@ -788,12 +1469,15 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct nfsmount       *nmp;
   FAR struct nfsnode        *np;
-  ssize_t                    readsize;
-  ssize_t                    tmp;
   ssize_t                    bytesread;
-  size_t                     reqlen;
-  FAR uint32_t              *ptr;
+  ssize_t                    nread;
+  size_t                     remaining;
+  off_t                      pos;
+  bool                       eof;
   int                        ret = 0;
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+  size_t                     rasize;
+#endif
 
   finfo("Read %d bytes from offset %d\n", buflen, filep->f_pos);
 
@@ -814,129 +1498,122 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
       return (ssize_t)ret;
     }
 
+#ifdef CONFIG_NFS_WRITEBEHIND
+  /* The server must see any buffered data before we read from it */
+
+  ret = nfs_flush(nmp, np);
+  if (ret < 0)
+    {
+      goto errout_with_semaphore;
+    }
+#endif
+
   /* Get the number of bytes left in the file and truncate read count so that
    * it does not exceed the number of bytes left in the file.
    */
 
-  tmp = np->n_size - filep->f_pos;
-  if (buflen > tmp)
+  if ((uint64_t)filep->f_pos >= np->n_size)
     {
-      buflen = tmp;
+      buflen = 0;
+    }
+  else if (buflen > np->n_size - filep->f_pos)
+    {
+      buflen = np->n_size - filep->f_pos;
       finfo("Read size truncated to %d\n", buflen);
     }
 
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+  rasize = CONFIG_NFS_READAHEAD_BLOCKS * nfs_rchunk(nmp);
+#endif
+
   /* Now loop until we fill the user buffer (or hit the end of the file) */
 
   for (bytesread = 0; bytesread < buflen; )
     {
-      /* Make sure that the attempted read size does not exceed the RPC maximum */
-
-      readsize = buflen - bytesread;
-      if (readsize > nmp->nm_rsize)
-        {
-          readsize = nmp->nm_rsize;
-        }
+      pos       = filep->f_pos;
+      remaining = buflen - bytesread;
 
-      /* Make sure that the attempted read size does not exceed the IO buffer size */
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+      /* Copy what we can from the read-ahead buffer */
 
-      tmp = SIZEOF_rpc_reply_read(readsize);
-      if (tmp > nmp->nm_buflen)
+      if (np->n_ralen > 0 && pos >= np->n_raoffset &&
+          pos < np->n_raoffset + np->n_ralen)
         {
-          readsize -= (tmp - nmp->nm_buflen);
-        }
-
-      /* Initialize the request */
-
-      ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
-      reqlen  = 0;
-
-      /* Copy the variable length, file handle */
-
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
-
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += uint32_alignup(np->n_fhsize);
-      ptr    += uint32_increment(np->n_fhsize);
-
-      /* Copy the file offset */
-
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr += 2;
-      reqlen += 2*sizeof(uint32_t);
-
-      /* Set the readsize */
-
-      *ptr = txdr_unsigned(readsize);
-      reqlen += sizeof(uint32_t);
-
-      /* Perform the read */
+          nread = np->n_raoffset + np->n_ralen - pos;
+          if (nread > remaining)
+            {
+              nread = remaining;
+            }
 
-      finfo("Reading %d bytes\n", readsize);
-      nfs_statistics(NFSPROC_READ);
-      ret = nfs_request(nmp, NFSPROC_READ,
-                        (FAR void *)&nmp->nm_msgbuffer.read, reqlen,
-                        (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
-      if (ret)
-        {
-          ferr("ERROR: nfs_request failed: %d\n", ret);
-          goto errout_with_semaphore;
+          memcpy(buffer, np->n_rabuf + (pos - np->n_raoffset), nread);
+          eof = false;
         }
 
-      /* The read was successful.  Get a pointer to the beginning of the NFS
-       * response data.
+      /* A small read that continues where the last one ended refills the
+       * read-ahead buffer with the data that follows.
        */
 
-      ptr = (FAR uint32_t *)
-        &((FAR struct rpc_reply_read *)nmp->nm_iobuffer)->read;
-
-      /* Check if attributes are included in the responses */
-
-      tmp = *ptr++;
-      if (tmp != 0)
+      else if (pos == np->n_rdnext && remaining < rasize &&
+               (np->n_rabuf != NULL ||
+                (np->n_rabuf = kmm_malloc(rasize)) != NULL))
         {
-          /* Yes.. Update the cached file status in the file structure. */
-
-          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
-        }
-
-      /* This is followed by the count of data read.  Isn't this
-       * the same as the length that is included in the read data?
-       *
-       * Just skip over if for now.
-       */
-
-      ptr++;
-
-      /* Next comes an EOF indication.  Save that in tmp for now. */
+          np->n_ralen    = 0;
+          np->n_raoffset = pos;
 
-      tmp = *ptr++;
+          nread = rasize;
+          if (nread > np->n_size - pos)
+            {
+              nread = np->n_size - pos;
+            }
 
-      /* Then the length of the read data followed by the read data itself */
+          nread = nfs_iodata(nmp, np, NFSPROC_READ, np->n_rabuf,
+                             pos, nread);
+          if (nread <= 0)
+            {
+              ret = nread;
+              break;
+            }
 
-      readsize = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
+          np->n_ralen = nread;
+          continue;
+        }
+      else
+#endif
+        {
+          /* Read directly into the user buffer */
 
-      /* Copy the read data into the user buffer */
+          nread = nfs_iodata(nmp, np, NFSPROC_READ, (FAR uint8_t *)buffer,
+                             pos, remaining);
+          if (nread <= 0)
+            {
+              ret = nread;
+              break;
+            }
 
-      memcpy(buffer, ptr, readsize);
+          eof = (nread < remaining);
+        }
 
       /* Update the read state data */
 
-      filep->f_pos += readsize;
-      bytesread    += readsize;
-      buffer       += readsize;
+      filep->f_pos += nread;
+      bytesread    += nread;
+      buffer       += nread;
 
       /* Check if we hit the end of file */
 
-      if (tmp != 0)
+      if (eof)
         {
           break;
         }
     }
 
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+  np->n_rdnext = filep->f_pos;
+#endif
+
+#ifdef CONFIG_NFS_WRITEBEHIND
 errout_with_semaphore:
+#endif
   nfs_semgive(nmp);
   return bytesread > 0 ? bytesread : ret;
 }
@@ -955,15 +1632,13 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
 {
   FAR struct nfsmount   *nmp;
   FAR struct nfsnode    *np;
-  ssize_t                writesize;
-  ssize_t                bufsize;
   ssize_t                byteswritten = 0;
-  size_t                 reqlen;
-  FAR uint32_t          *ptr;
-  uint32_t               tmp;
-  int                    commit = 0;
-  int                    committed = NFSV3WRITE_FILESYNC;
+  ssize_t                nwritten;
+  size_t                 remaining;
   int                    ret;
+#ifdef CONFIG_NFS_WRITEBEHIND
+  uint32_t               wbsize;
+#endif
 
   finfo("Write %d bytes to offset %d\n", buflen, filep->f_pos);
 
@@ -992,141 +1667,143 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
       goto errout_with_semaphore;
     }
 
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+  /* Any read-ahead data is now stale */
+
+  np->n_ralen = 0;
+#endif
+
+#ifdef CONFIG_NFS_WRITEBEHIND
+  wbsize = nfs_wchunk(nmp);
+#endif
+
   /* Now loop until we send the entire user buffer */
 
   for (byteswritten = 0; byteswritten < buflen; )
     {
-      /* Make sure that the attempted write size does not exceed the RPC
-       * maximum.
-       */
-
-      writesize = buflen - byteswritten;
-      if (writesize > nmp->nm_wsize)
-        {
-          writesize = nmp->nm_wsize;
-        }
+      remaining = buflen - byteswritten;
+      nwritten  = 0;
 
-      /* Make sure that the attempted read size does not exceed the IO
-       * buffer size.
+#ifdef CONFIG_NFS_WRITEBEHIND
+      /* Flush the write-behind buffer if it is full or if this write does
+       * not continue the buffered data.
        */
 
-      bufsize = SIZEOF_rpc_call_write(writesize);
-      if (bufsize > nmp->nm_buflen)
+      if (np->n_wblen > 0 &&
+          (np->n_wblen >= wbsize ||
+           filep->f_pos != np->n_wboffset + np->n_wblen))
         {
-          writesize -= (bufsize - nmp->nm_buflen);
+          ret = nfs_flush(nmp, np);
+          if (ret < 0)
+            {
+              break;
+            }
         }
 
-      /* Initialize the request.  Here we need an offset pointer to the write
-       * arguments, skipping over the RPC header.  Write is unique among the
-       * RPC calls in that the entry RPC calls message lies in the I/O buffer
+      /* Small writes are collected in the write-behind buffer and sent in
+       * full sized WRITE RPCs.
        */
 
-      ptr     = (FAR uint32_t *)&((FAR struct rpc_call_write *)
-                  nmp->nm_iobuffer)->write;
-      reqlen  = 0;
-
-      /* Copy the variable length, file handle */
-
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
-
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += uint32_alignup(np->n_fhsize);
-      ptr    += uint32_increment(np->n_fhsize);
-
-      /* Copy the file offset */
-
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr    += 2;
-      reqlen += 2*sizeof(uint32_t);
-
-      /* Copy the count and stable values */
+      if (np->n_wblen > 0 || remaining < wbsize)
+        {
+          if (np->n_wbbuf == NULL)
+            {
+              np->n_wbbuf = kmm_malloc(wbsize);
+            }
 
-      *ptr++  = txdr_unsigned(writesize);
-      *ptr++  = txdr_unsigned(committed);
-      reqlen += 2*sizeof(uint32_t);
+          if (np->n_wbbuf != NULL)
+            {
+              if (np->n_wblen == 0)
+                {
+                  np->n_wboffset = filep->f_pos;
+                }
 
-      /* Copy a chunk of the user data into the I/O buffer */
+              nwritten = wbsize - np->n_wblen;
+              if (nwritten > remaining)
+                {
+                  nwritten = remaining;
+                }
 
-      *ptr++  = txdr_unsigned(writesize);
-      reqlen += sizeof(uint32_t);
-      memcpy(ptr, buffer, writesize);
-      reqlen += uint32_alignup(writesize);
+              memcpy(np->n_wbbuf + np->n_wblen, buffer, nwritten);
+              np->n_wblen += nwritten;
+            }
+        }
+#endif
 
-      /* Perform the write */
+      /* Otherwise send the data directly from the user buffer */
 
-      nfs_statistics(NFSPROC_WRITE);
-      ret = nfs_request(nmp, NFSPROC_WRITE,
-                        (FAR void *)nmp->nm_iobuffer, reqlen,
-                        (FAR void *)&nmp->nm_msgbuffer.write,
-                        sizeof(struct rpc_reply_write));
-      if (ret)
+      if (nwritten == 0)
         {
-          ferr("ERROR: nfs_request failed: %d\n", ret);
-          goto errout_with_semaphore;
+          nwritten = nfs_iodata(nmp, np, NFSPROC_WRITE,
+                                (FAR uint8_t *)buffer, filep->f_pos,
+                                remaining);
+          if (nwritten <= 0)
+            {
+              ret = nwritten < 0 ? nwritten : -EIO;
+              break;
+            }
         }
 
-      /* Get a pointer to the WRITE reply data */
+      /* Update the write state data */
 
-      ptr = (FAR uint32_t *)&nmp->nm_msgbuffer.write.write;
+      filep->f_pos += nwritten;
+      byteswritten += nwritten;
+      buffer       += nwritten;
 
-      /* Parse file_wcc.  First, check if WCC attributes follow. */
-
-      tmp = *ptr++;
-      if (tmp != 0)
+      if (filep->f_pos > np->n_size)
         {
-          /* Yes.. WCC attributes follow.  But we just skip over them. */
-
-          ptr += uint32_increment(sizeof(struct wcc_attr));
+          np->n_size = filep->f_pos;
         }
+    }
 
-      /* Check if normal file attributes follow */
-
-      tmp = *ptr++;
-      if (tmp != 0)
-        {
-          /* Yes.. Update the cached file status in the file structure. */
+  nfs_attrcache_invalidate(nmp, np);
 
-          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
-        }
+errout_with_semaphore:
+  nfs_semgive(nmp);
+  return byteswritten > 0 ? byteswritten : ret;
+}
 
-      /* Get the count of bytes actually written */
+/****************************************************************************
+ * Name: nfs_sync
+ *
+ * Description:
+ *   Synchronize the file state on disk to match internal, in-memory state.
+ *
+ ****************************************************************************/
 
-      tmp = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
+static int nfs_sync(FAR struct file *filep)
+{
+#ifdef CONFIG_NFS_WRITEBEHIND
+  FAR struct nfsmount *nmp;
+  FAR struct nfsnode *np;
+  int ret;
 
-      if (tmp < 1 || tmp > writesize)
-        {
-          ret = -EIO;
-          goto errout_with_semaphore;
-        }
+  /* Sanity checks */
 
-      writesize = tmp;
+  DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
 
-      /* Determine the lowest commitment level obtained by any of the RPCs. */
+  /* Recover our private data from the struct file instance */
 
-      commit = *ptr++;
-      if (committed == NFSV3WRITE_FILESYNC)
-        {
-          committed = commit;
-        }
-      else if (committed == NFSV3WRITE_DATASYNC &&
-               commit == NFSV3WRITE_UNSTABLE)
-        {
-          committed = commit;
-        }
+  nmp = (FAR struct nfsmount *)filep->f_inode->i_private;
+  np  = (FAR struct nfsnode *)filep->f_priv;
 
-      /* Update the read state data */
+  DEBUGASSERT(nmp != NULL);
 
-      filep->f_pos += writesize;
-      byteswritten += writesize;
-      buffer       += writesize;
+  ret = nfs_semtake(nmp);
+  if (ret < 0)
+    {
+      return ret;
     }
 
-errout_with_semaphore:
+  ret = nfs_commit(nmp, np);
+
   nfs_semgive(nmp);
-  return byteswritten > 0 ? byteswritten : ret;
+  return ret;
+#else
+  /* All data is written with FILE_SYNC stability */
+
+  return OK;
+#endif
 }
 
 /****************************************************************************
@@ -1254,10 +1931,22 @@ static int nfs_truncate(FAR struct file *filep, off_t length)
   ret = nfs_semtake(nmp);
   if (ret >= 0)
     {
-      /* Then perform the SETATTR RPC to set the new file size */
+#ifdef CONFIG_NFS_WRITEBEHIND
+      /* Buffered data must reach the server before the size changes */
+
+      ret = nfs_flush(nmp, np);
+      if (ret >= 0)
+#endif
+        {
+          /* Then perform the SETATTR RPC to set the new file size */
 
-      ret = nfs_filetruncate(nmp, np, length);
+          ret = nfs_filetruncate(nmp, np, length);
+        }
 
+#if CONFIG_NFS_READAHEAD_BLOCKS > 0
+      np->n_ralen = 0;
+#endif
+      nfs_attrcache_invalidate(nmp, np);
       nfs_semgive(nmp);
     }
 
@@ -1989,6 +2678,8 @@ static int nfs_unbind(FAR void *handle, FAR struct inode **blkdriver,
 
   /* And free any allocated resources */
 
+  nfs_attrcache_invalidate(nmp, NULL);
+
   nxsem_destroy(&nmp->nm_sem);
   kmm_free(nmp->nm_rpcclnt);
   kmm_free(nmp);
@@ -2256,6 +2947,10 @@ static int nfs_remove(FAR struct inode *mountpt, FAR const char *relpath)
                     (FAR void *)&nmp->nm_msgbuffer.removef, reqlen,
                     (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
 
+  /* Cached lookups below the affected path are no longer valid */
+
+  nfs_attrcache_invalidate(nmp, NULL);
+
 errout_with_semaphore:
   nfs_semgive(nmp);
   return ret;
@@ -2381,6 +3076,10 @@ static int nfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
       ferr("ERROR: nfs_request failed: %d\n", ret);
     }
 
+  /* Cached lookups below the affected path are no longer valid */
+
+  nfs_attrcache_invalidate(nmp, NULL);
+
 errout_with_semaphore:
   nfs_semgive(nmp);
   return ret;
@@ -2462,6 +3161,10 @@ static int nfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
                         (FAR void *)&nmp->nm_msgbuffer.rmdir, reqlen,
                         (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
 
+  /* Cached lookups below the affected path are no longer valid */
+
+  nfs_attrcache_invalidate(nmp, NULL);
+
 errout_with_semaphore:
   nfs_semgive(nmp);
   return ret;
@@ -2575,6 +3278,10 @@ static int nfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
                     (FAR void *)&nmp->nm_msgbuffer.renamef, reqlen,
                     (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
 
+  /* Cached lookups below the affected path are no longer valid */
+
+  nfs_attrcache_invalidate(nmp, NULL);
+
 errout_with_semaphore:
   nfs_semgive(nmp);
   return ret;
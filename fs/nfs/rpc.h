@@ -284,6 +284,12 @@ struct rpc_call_write
 };
 #define SIZEOF_rpc_call_write(n) (sizeof(struct rpc_call_header) + SIZEOF_WRITE3args(n))
 
+struct rpc_call_commit
+{
+  struct rpc_call_header ch;
+  struct COMMIT3args commit;
+};
+
 struct rpc_call_remove
 {
   struct rpc_call_header ch;
@@ -378,6 +384,12 @@ struct rpc_reply_write
   struct WRITE3resok write;      /* Variable length */
 };
 
+struct rpc_reply_commit
+{
+  struct nfs_reply_header rh;
+  struct COMMIT3resok commit;
+};
+
 struct rpc_reply_read
 {
   struct nfs_reply_header rh;
@@ -469,5 +481,10 @@ void rpcclnt_disconnect(FAR struct rpcclnt *rpc);
 int  rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
                      int version, FAR void *request, size_t reqlen,
                      FAR void *response, size_t resplen);
+int  rpcclnt_send(FAR struct rpcclnt *rpc, int procnum, int prog,
+                  int version, FAR void *request, size_t reqlen,
+                  FAR uint32_t *xid);
+int  rpcclnt_receive(FAR struct rpcclnt *rpc, FAR uint32_t *xid,
+                     FAR void *response, size_t resplen);
 
 #endif /* __FS_NFS_RPC_H */
@@ -142,12 +142,13 @@ static struct rpcstats rpcstats;
  ****************************************************************************/
 
 static int rpcclnt_socket(FAR struct rpcclnt *rpc, in_port_t rport);
-static int rpcclnt_send(FAR struct rpcclnt *rpc,
-                        FAR void *call, int reqlen);
-static int rpcclnt_receive(FAR struct rpcclnt *rpc,
+static int rpcclnt_sendmsg(FAR struct rpcclnt *rpc,
+                           FAR void *call, int reqlen);
+static int rpcclnt_recvmsg(FAR struct rpcclnt *rpc,
                            FAR void *reply, size_t resplen);
 static int rpcclnt_reply(FAR struct rpcclnt *rpc, uint32_t xid,
                          FAR void *reply, size_t resplen);
+static int rpcclnt_checkreply(FAR void *reply);
 static void rpcclnt_fmtheader(FAR struct rpc_call_header *ch,
                               uint32_t xid, int procid, int prog, int vers);
 
@@ -282,7 +283,7 @@ bad:
 }
 
 /****************************************************************************
- * Name: rpcclnt_send
+ * Name: rpcclnt_sendmsg
  *
  * Description:
  *   This is the nfs send routine.
@@ -292,8 +293,8 @@ bad:
  *
  ****************************************************************************/
 
-static int rpcclnt_send(FAR struct rpcclnt *rpc,
-                        FAR void *call, int reqlen)
+static int rpcclnt_sendmsg(FAR struct rpcclnt *rpc,
+                           FAR void *call, int reqlen)
 {
   uint32_t mark;
   int ret = OK;
@@ -328,14 +329,14 @@ static int rpcclnt_send(FAR struct rpcclnt *rpc,
 }
 
 /****************************************************************************
- * Name: rpcclnt_receive
+ * Name: rpcclnt_recvmsg
  *
  * Description:
  *   Receive a Sun RPC Request/Reply.
  *
  ****************************************************************************/
 
-static int rpcclnt_receive(FAR struct rpcclnt *rpc,
+static int rpcclnt_recvmsg(FAR struct rpcclnt *rpc,
                            FAR void *reply, size_t resplen)
 {
   uint32_t mark;
@@ -366,7 +367,29 @@ static int rpcclnt_receive(FAR struct rpcclnt *rpc,
           return -E2BIG;
         }
 
-      resplen = mark;
+      /* A stream may deliver the record in pieces.  Read all of it so that
+       * the next record mark is found where it is expected; this matters
+       * when several calls are outstanding.
+       */
+
+      while (mark > 0)
+        {
+          error = psock_recv(&rpc->rc_so, reply, mark, 0);
+          if (error < 0)
+            {
+              ferr("ERROR: psock_recv response failed: %d\n", error);
+              return error;
+            }
+          else if (error == 0)
+            {
+              return -ECONNRESET;
+            }
+
+          reply = (FAR uint8_t *)reply + error;
+          mark -= error;
+        }
+
+      return OK;
     }
 
   error = psock_recv(&rpc->rc_so, reply, resplen, 0);
@@ -395,10 +418,10 @@ static int rpcclnt_reply(FAR struct rpcclnt *rpc, uint32_t xid,
 retry:
   /* Get the next RPC reply from the socket */
 
-  error = rpcclnt_receive(rpc, reply, resplen);
+  error = rpcclnt_recvmsg(rpc, reply, resplen);
   if (error != 0)
     {
-      ferr("ERROR: rpcclnt_receive returned: %d\n", error);
+      ferr("ERROR: rpcclnt_recvmsg returned: %d\n", error);
     }
 
   /* Get the xid and check that it is an RPC replysvr */
@@ -425,6 +448,42 @@ retry:
   return error;
 }
 
+/****************************************************************************
+ * Name: rpcclnt_checkreply
+ *
+ * Description:
+ *   Verify the RPC level status of a reply.  There may still be NFS layer
+ *   errors that will be detected by calling logic.
+ *
+ ****************************************************************************/
+
+static int rpcclnt_checkreply(FAR void *reply)
+{
+  FAR struct rpc_reply_header *replymsg;
+  uint32_t tmp;
+
+  replymsg = (FAR struct rpc_reply_header *)reply;
+
+  tmp = fxdr_unsigned(uint32_t, replymsg->type);
+  if (tmp != RPC_MSGACCEPTED)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  tmp = fxdr_unsigned(uint32_t, replymsg->status);
+  if (tmp == RPC_SUCCESS)
+    {
+      finfo("RPC_SUCCESS\n");
+    }
+  else
+    {
+      ferr("ERROR: Unsupported RPC type: %d\n", tmp);
+      return -EOPNOTSUPP;
+    }
+
+  return OK;
+}
+
 /****************************************************************************
  * Name: rpcclnt_fmtheader
  *
@@ -700,9 +759,9 @@ bad:
  *
  * Description:
  *   Perform the RPC request.  Logic formats the RPC CALL message and calls
- *   rpcclnt_send to send the RPC CALL message.  It then calls rpcclnt_reply()
- *   to get the response.  It may attempt to re-send the CALL message on
- *   certain errors.
+ *   rpcclnt_sendmsg to send the RPC CALL message.  It then calls
+ *   rpcclnt_reply() to get the response.  It may attempt to re-send the
+ *   CALL message on certain errors.
  *
  *   On successful receipt, it verifies the RPC level of the returned values.
  *   (There may still be be NFS layer errors that will be detected by calling
@@ -714,8 +773,6 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
                     int version, FAR void *request, size_t reqlen,
                     FAR void *response, size_t resplen)
 {
-  FAR struct rpc_reply_header *replymsg;
-  uint32_t tmp;
   uint32_t xid;
   int retries = 0;
   int error = 0;
@@ -748,10 +805,10 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
 
       /* Send the RPC CALL message */
 
-      error = rpcclnt_send(rpc, request, reqlen);
+      error = rpcclnt_sendmsg(rpc, request, reqlen);
       if (error != OK)
         {
-          finfo("ERROR rpcclnt_send failed: %d\n", error);
+          finfo("ERROR rpcclnt_sendmsg failed: %d\n", error);
         }
 
       /* Wait for the reply from our send */
@@ -790,24 +847,80 @@ int rpcclnt_request(FAR struct rpcclnt *rpc, int procnum, int prog,
 
   /* Break down the RPC header and check if it is OK */
 
-  replymsg = (FAR struct rpc_reply_header *)response;
+  return rpcclnt_checkreply(response);
+}
 
-  tmp = fxdr_unsigned(uint32_t, replymsg->type);
-  if (tmp != RPC_MSGACCEPTED)
+/****************************************************************************
+ * Name: rpcclnt_send
+ *
+ * Description:
+ *   Format and send an RPC CALL message without waiting for the reply.
+ *   This permits several calls to be outstanding at the same time; the
+ *   replies are collected with rpcclnt_receive().
+ *
+ *   If *xid is zero, a new transaction ID is allocated and returned in
+ *   *xid.  Otherwise the call is a retransmission and *xid is re-used so
+ *   that a late reply to the original call is still accepted.
+ *
+ ****************************************************************************/
+
+int rpcclnt_send(FAR struct rpcclnt *rpc, int procnum, int prog,
+                 int version, FAR void *request, size_t reqlen,
+                 FAR uint32_t *xid)
+{
+  if (*xid == 0)
     {
-      return -EOPNOTSUPP;
+      *xid = ++rpc->rc_xid;
+      if (*xid == 0)
+        {
+          *xid = ++rpc->rc_xid;
+        }
     }
 
-  tmp = fxdr_unsigned(uint32_t, replymsg->status);
-  if (tmp == RPC_SUCCESS)
+  rpcclnt_fmtheader((FAR struct rpc_call_header *)request,
+                    *xid, prog, version, procnum);
+
+  rpc_statistics(rpcrequests);
+  return rpcclnt_sendmsg(rpc, request,
+                         reqlen + sizeof(struct rpc_call_header));
+}
+
+/****************************************************************************
+ * Name: rpcclnt_receive
+ *
+ * Description:
+ *   Receive the next RPC REPLY message for any outstanding call and return
+ *   its transaction ID in *xid.  The RPC level status is verified.  A
+ *   receive timeout is returned as -EAGAIN or -ETIMEDOUT;  the caller is
+ *   responsible for retransmitting its outstanding calls.
+ *
+ ****************************************************************************/
+
+int rpcclnt_receive(FAR struct rpcclnt *rpc, FAR uint32_t *xid,
+                    FAR void *response, size_t resplen)
+{
+  FAR struct rpc_reply_header *replyheader;
+  int error;
+
+  error = rpcclnt_recvmsg(rpc, response, resplen);
+  if (error != OK)
     {
-      finfo("RPC_SUCCESS\n");
+      if (error == -EAGAIN || error == -ETIMEDOUT)
+        {
+          rpc_statistics(rpctimeouts);
+        }
+
+      return error;
     }
-  else
+
+  replyheader = (FAR struct rpc_reply_header *)response;
+  if (replyheader->rp_direction != rpc_reply)
     {
-      ferr("ERROR: Unsupported RPC type: %d\n", tmp);
-      return -EOPNOTSUPP;
+      ferr("ERROR: Different RPC REPLY returned\n");
+      rpc_statistics(rpcinvalid);
+      return -EPROTO;
     }
 
-  return OK;
+  *xid = fxdr_unsigned(uint32_t, replyheader->rp_xid);
+  return rpcclnt_checkreply(response);
 }
@@ -65,11 +65,14 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations latency_operations;
 extern const struct procfs_operations meminfo_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations inodecache_operations;
 extern const struct procfs_operations module_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
+extern const struct procfs_operations wqueue_operations;
 
 /* This is not good.  These are implemented in other sub-systems.  Having to
  * deal with them here is not a good coupling. What is really needed is a
@@ -121,6 +124,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
 #endif
 
+#ifdef CONFIG_SCHED_LATENCYMON
+  { "latency",       &latency_operations,         PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MEMINFO
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
 #endif
@@ -137,6 +144,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "fs/blocks",     &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_FS_INODE_CACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_INODECACHE)
+  { "fs/inodecache", &inodecache_operations,      PROCFS_FILE_TYPE   },
+#endif
+
 #ifndef CONFIG_FS_PROCFS_EXCLUDE_MOUNT
   { "fs/mount",      &mount_procfsoperations,     PROCFS_FILE_TYPE   },
 #endif
@@ -174,6 +185,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_VERSION)
   { "version",       &version_operations,         PROCFS_FILE_TYPE   },
 #endif
+
+#ifdef CONFIG_WQUEUE_STATISTICS
+  { "wqueue",        &wqueue_operations,          PROCFS_FILE_TYPE   },
+#endif
 };
 
 #ifdef CONFIG_FS_PROCFS_REGISTER
@@ -455,9 +470,21 @@ static ssize_t procfs_write(FAR struct file *filep, FAR const char *buffer,
 
 static int procfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
+  FAR struct procfs_file_s *handler;
+
   finfo("cmd: %d arg: %08lx\n", cmd, arg);
 
-  /* No IOCTL commands supported */
+  /* Recover our private data from the struct file instance */
+
+  handler = (FAR struct procfs_file_s *)filep->f_priv;
+  DEBUGASSERT(handler);
+
+  /* Call the handler's ioctl routine, if it has one */
+
+  if (handler->procfsentry->ops->ioctl)
+    {
+      return handler->procfsentry->ops->ioctl(filep, cmd, arg);
+    }
 
   return -ENOTTY;
 }
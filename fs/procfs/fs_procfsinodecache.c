@@ -0,0 +1,294 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsinodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#include "inode/inode.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_FS_INODE_CACHE) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_INODECACHE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define INODECACHE_LINELEN 128
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct inodecache_file_s
+{
+  struct procfs_file_s base;       /* Base open file structure */
+  char line[INODECACHE_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     inodecache_open(FAR struct file *filep,
+                 FAR const char *relpath, int oflags, mode_t mode);
+static int     inodecache_close(FAR struct file *filep);
+static ssize_t inodecache_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     inodecache_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     inodecache_stat(FAR const char *relpath,
+                 FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations inodecache_operations =
+{
+  inodecache_open,   /* open */
+  inodecache_close,  /* close */
+  inodecache_read,   /* read */
+  NULL,              /* write */
+  inodecache_dup,    /* dup */
+  NULL,              /* opendir */
+  NULL,              /* closedir */
+  NULL,              /* readdir */
+  NULL,              /* rewinddir */
+  inodecache_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inodecache_open
+ ****************************************************************************/
+
+static int inodecache_open(FAR struct file *filep, FAR const char *relpath,
+                           int oflags, mode_t mode)
+{
+  FAR struct inodecache_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "fs/inodecache" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "fs/inodecache") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct inodecache_file_s *)
+    kmm_zalloc(sizeof(struct inodecache_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: inodecache_close
+ ****************************************************************************/
+
+static int inodecache_close(FAR struct file *filep)
+{
+  FAR struct inodecache_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct inodecache_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: inodecache_read
+ ****************************************************************************/
+
+static ssize_t inodecache_read(FAR struct file *filep, FAR char *buffer,
+                               size_t buflen)
+{
+  FAR struct inodecache_file_s *procfile;
+  struct inode_cachestats_s stats;
+  unsigned long total;
+  unsigned int ratio;
+  size_t linesize;
+  size_t copysize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+  offset = filep->f_pos;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct inodecache_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Take a snapshot of the counters.  They are only modified with the
+   * inode semaphore held, but a slightly stale view is harmless here.
+   */
+
+  stats = g_inode_cachestats;
+  total = (unsigned long)stats.hits + stats.misses;
+  ratio = total > 0 ? (unsigned int)(((uint64_t)stats.hits * 100) / total) :
+          0;
+
+  linesize = snprintf(procfile->line, INODECACHE_LINELEN,
+                      "%-16s%lu\n%-16s%lu\n%-16s%u%%\n%-16s%lu\n",
+                      "Hits:", (unsigned long)stats.hits,
+                      "Misses:", (unsigned long)stats.misses,
+                      "HitRatio:", ratio,
+                      "Invalidations:", (unsigned long)stats.invalidations);
+
+  copysize = procfs_memcpy(procfile->line, linesize, buffer, buflen,
+                           &offset);
+
+  /* Update the file offset */
+
+  filep->f_pos += copysize;
+  return copysize;
+}
+
+/****************************************************************************
+ * Name: inodecache_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int inodecache_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct inodecache_file_s *oldattr;
+  FAR struct inodecache_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct inodecache_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct inodecache_file_s *)
+    kmm_malloc(sizeof(struct inodecache_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct inodecache_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: inodecache_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int inodecache_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "fs/inodecache" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "fs/inodecache") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "fs/inodecache" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_FS_INODE_CACHE && !CONFIG_FS_PROCFS_EXCLUDE_INODECACHE */
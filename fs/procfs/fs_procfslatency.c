@@ -0,0 +1,417 @@
+/****************************************************************************
+ * fs/procfs/fs_procfslatency.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_SCHED_LATENCYMON)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define LATENCY_LINELEN 48
+
+#ifdef CONFIG_SMP_NCPUS
+#  define LATENCY_NCPUS   CONFIG_SMP_NCPUS
+#else
+#  define LATENCY_NCPUS   1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct latency_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  char line[LATENCY_LINELEN];   /* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     latency_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     latency_close(FAR struct file *filep);
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     latency_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     latency_stat(FAR const char *relpath, FAR struct stat *buf);
+static int     latency_ioctl(FAR struct file *filep, int cmd,
+                 unsigned long arg);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations latency_operations =
+{
+  latency_open,       /* open */
+  latency_close,      /* close */
+  latency_read,       /* read */
+  NULL,               /* write */
+
+  latency_dup,        /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  latency_stat,       /* stat */
+
+  latency_ioctl       /* ioctl */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: latency_convert
+ ****************************************************************************/
+
+static void latency_convert(uint32_t elapsed, FAR struct timespec *ts)
+{
+  if (elapsed > 0)
+    {
+      up_critmon_convert(elapsed, ts);
+    }
+  else
+    {
+      ts->tv_sec  = 0;
+      ts->tv_nsec = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: latency_open
+ ****************************************************************************/
+
+static int latency_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct latency_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "latency" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "latency") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct latency_file_s *)
+    kmm_zalloc(sizeof(struct latency_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_close
+ ****************************************************************************/
+
+static int latency_close(FAR struct file *filep)
+{
+  FAR struct latency_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_read
+ ****************************************************************************/
+
+static ssize_t latency_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  FAR struct latency_file_s *attr;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int cpu;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct latency_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  totalsize = 0;
+  offset    = filep->f_pos;
+
+  /* Get the statistics of each CPU */
+
+  for (cpu = 0; cpu < LATENCY_NCPUS; cpu++)
+    {
+      linesize   = snprintf(attr->line, LATENCY_LINELEN, "cpu:       %d\n",
+                            cpu);
+      copysize   = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, &offset);
+      totalsize += copysize;
+
+      totalsize += procfs_latency(&g_latency[cpu], buffer + totalsize,
+                                  buflen - totalsize, &offset);
+      if (totalsize >= buflen)
+        {
+          break;
+        }
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: latency_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int latency_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct latency_file_s *oldattr;
+  FAR struct latency_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct latency_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct latency_file_s *)
+    kmm_malloc(sizeof(struct latency_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct latency_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int latency_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "latency" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "latency") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "latency" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: latency_ioctl
+ *
+ * Description: FIOC_RESETSTAT clears the statistics of all CPUs.
+ *
+ ****************************************************************************/
+
+static int latency_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  irqstate_t flags;
+
+  if (cmd != FIOC_RESETSTAT)
+    {
+      return -ENOTTY;
+    }
+
+  flags = enter_critical_section();
+  memset(g_latency, 0, sizeof(g_latency));
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: procfs_latency
+ *
+ * Description:
+ *   Format a set of scheduling latency statistics for a procfs/ file.
+ *
+ ****************************************************************************/
+
+size_t procfs_latency(FAR const struct latencymon_s *latency,
+                      FAR char *buffer, size_t buflen, FAR off_t *offset)
+{
+  char line[LATENCY_LINELEN];
+  struct timespec ts;
+  size_t linesize;
+  size_t totalsize;
+  uint32_t bound;
+  int shift;
+  int i;
+
+  /* Generate the counters and the maximum wakeup latency */
+
+  linesize  = snprintf(line, LATENCY_LINELEN, "switches:  %lu\n",
+                       (unsigned long)latency->nswitch);
+  totalsize = procfs_memcpy(line, linesize, buffer, buflen, offset);
+
+  linesize   = snprintf(line, LATENCY_LINELEN, "preempts:  %lu\n",
+                        (unsigned long)latency->npreempt);
+  totalsize += procfs_memcpy(line, linesize, buffer + totalsize,
+                             buflen - totalsize, offset);
+
+  latency_convert(latency->wakeup_max, &ts);
+  linesize   = snprintf(line, LATENCY_LINELEN, "maxwakeup: %lu.%09lu\n",
+                        (unsigned long)ts.tv_sec,
+                        (unsigned long)ts.tv_nsec);
+  totalsize += procfs_memcpy(line, linesize, buffer + totalsize,
+                             buflen - totalsize, offset);
+
+  /* Generate one line for each histogram bucket: its lower bound, then the
+   * wakeup latency and run slice counts.
+   */
+
+  for (i = 0; i < CONFIG_SCHED_LATENCYMON_NBUCKETS; i++)
+    {
+      /* Buckets whose lower bound does not fit in 32 bits are never
+       * used.
+       */
+
+      shift = i - 1 + CONFIG_SCHED_LATENCYMON_SHIFT;
+      if (totalsize >= buflen || shift >= 32)
+        {
+          break;
+        }
+
+      bound = i > 0 ? (uint32_t)1 << shift : 0;
+      latency_convert(bound, &ts);
+
+      linesize   = snprintf(line, LATENCY_LINELEN, "%lu.%09lu %lu %lu\n",
+                            (unsigned long)ts.tv_sec,
+                            (unsigned long)ts.tv_nsec,
+                            (unsigned long)latency->wakeup[i],
+                            (unsigned long)latency->slice[i]);
+      totalsize += procfs_memcpy(line, linesize, buffer + totalsize,
+                                 buflen - totalsize, offset);
+    }
+
+  return totalsize;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_LATENCYMON */
@@ -48,6 +48,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/environ.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/fs/procfs.h>
 #include <nuttx/fs/dirent.h>
 
@@ -98,6 +99,9 @@ enum proc_node_e
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
+#endif
+#ifdef CONFIG_SCHED_LATENCYMON
+  PROC_SCHEDSTAT,                     /* Scheduling latency statistics */
 #endif
   PROC_STACK,                         /* Task stack info */
   PROC_GROUP,                         /* Group directory */
@@ -184,6 +188,11 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
 #endif
+#ifdef CONFIG_SCHED_LATENCYMON
+static ssize_t proc_schedstat(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
+#endif
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
@@ -219,6 +228,11 @@ static int     proc_rewinddir(FAR struct fs_dirent_s *dir);
 
 static int     proc_stat(FAR const char *relpath, FAR struct stat *buf);
 
+#ifdef CONFIG_SCHED_LATENCYMON
+static int     proc_ioctl(FAR struct file *filep, int cmd,
+                 unsigned long arg);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -246,7 +260,13 @@ const struct procfs_operations proc_operations =
   proc_readdir,       /* readdir */
   proc_rewinddir,     /* rewinddir */
 
-  proc_stat           /* stat */
+  proc_stat,          /* stat */
+
+#ifdef CONFIG_SCHED_LATENCYMON
+  proc_ioctl          /* ioctl */
+#else
+  NULL                /* ioctl */
+#endif
 };
 
 /* These structures provide information about every node */
@@ -280,6 +300,13 @@ static const struct proc_node_s g_critmon =
 };
 #endif
 
+#ifdef CONFIG_SCHED_LATENCYMON
+static const struct proc_node_s g_schedstat =
+{
+  "schedstat",   "schedstat", (uint8_t)PROC_SCHEDSTAT,   DTYPE_FILE        /* Scheduling latency statistics */
+};
+#endif
+
 static const struct proc_node_s g_stack =
 {
   "stack",        "stack",   (uint8_t)PROC_STACK,        DTYPE_FILE        /* Task stack info */
@@ -319,6 +346,9 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
+#endif
+#ifdef CONFIG_SCHED_LATENCYMON
+  &g_schedstat,    /* Scheduling latency statistics */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -342,6 +372,9 @@ static const struct proc_node_s * const g_level0info[] =
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
+#endif
+#ifdef CONFIG_SCHED_LATENCYMON
+  &g_schedstat,    /* Scheduling latency statistics */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -854,6 +887,19 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_schedstat
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCYMON
+static ssize_t proc_schedstat(FAR struct proc_file_s *procfile,
+                              FAR struct tcb_s *tcb, FAR char *buffer,
+                              size_t buflen, off_t offset)
+{
+  return procfs_latency(&tcb->latency, buffer, buflen, &offset);
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -1454,6 +1500,11 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
     case PROC_CRITMON: /* Critical section monitor */
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
+#endif
+#ifdef CONFIG_SCHED_LATENCYMON
+    case PROC_SCHEDSTAT: /* Scheduling latency statistics */
+      ret = proc_schedstat(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
 #endif
     case PROC_STACK: /* Task stack info */
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
@@ -1488,6 +1539,47 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
   return ret;
 }
 
+/****************************************************************************
+ * Name: proc_ioctl
+ *
+ * Description:
+ *   FIOC_RESETSTAT on the "schedstat" file clears the scheduling latency
+ *   statistics of the task.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCYMON
+static int proc_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct proc_file_s *procfile;
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct proc_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile != NULL);
+
+  if (procfile->node->node != PROC_SCHEDSTAT || cmd != FIOC_RESETSTAT)
+    {
+      return -ENOTTY;
+    }
+
+  flags = enter_critical_section();
+
+  /* Verify that the thread is still valid */
+
+  tcb = nxsched_get_tcb(procfile->pid);
+  if (tcb != NULL)
+    {
+      memset(&tcb->latency, 0, sizeof(struct latencymon_s));
+    }
+
+  leave_critical_section(flags);
+  return tcb != NULL ? OK : -ENODEV;
+}
+#endif
+
 /****************************************************************************
  * Name: proc_dup
  *
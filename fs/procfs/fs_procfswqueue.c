@@ -0,0 +1,369 @@
+/****************************************************************************
+ * fs/procfs/fs_procfswqueue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+     defined(CONFIG_WQUEUE_STATISTICS)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define WQUEUE_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s
+{
+  struct procfs_file_s  base;   /* Base open file structure */
+  char line[WQUEUE_LINELEN];    /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure names one kernel work queue */
+
+struct wqueue_name_s
+{
+  FAR const char *name;         /* The name shown for the work queue */
+  int qid;                      /* The work queue ID */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     wqueue_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+static int     wqueue_ioctl(FAR struct file *filep, int cmd,
+                 unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The kernel work queues */
+
+static const struct wqueue_name_s g_wqueue_names[] =
+{
+#ifdef CONFIG_SCHED_HPWORK
+  { "hpwork", HPWORK },
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  { "lpwork", LPWORK },
+#endif
+};
+
+#define WQUEUE_NQUEUES (sizeof(g_wqueue_names) / sizeof(g_wqueue_names[0]))
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wqueue_operations =
+{
+  wqueue_open,        /* open */
+  wqueue_close,       /* close */
+  wqueue_read,        /* read */
+  NULL,               /* write */
+
+  wqueue_dup,         /* dup */
+
+  NULL,               /* opendir */
+  NULL,               /* closedir */
+  NULL,               /* readdir */
+  NULL,               /* rewinddir */
+
+  wqueue_stat,        /* stat */
+
+  wqueue_ioctl        /* ioctl */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath,
+                       int oflags, mode_t mode)
+{
+  FAR struct wqueue_file_s *attr;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "wqueue" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "wqueue") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  attr = (FAR struct wqueue_file_s *)
+    kmm_zalloc(sizeof(struct wqueue_file_s));
+  if (!attr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)attr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+  FAR struct wqueue_file_s *attr;
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  /* Release the file attributes structure */
+
+  kmm_free(attr);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct wqueue_file_s *attr;
+  struct work_stats_s stats;
+  unsigned long avglatency;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  /* Recover our private data from the struct file instance */
+
+  attr = (FAR struct wqueue_file_s *)filep->f_priv;
+  DEBUGASSERT(attr);
+
+  offset = filep->f_pos;
+
+  /* The header line.  Latencies are in microseconds. */
+
+  linesize  = snprintf(attr->line, WQUEUE_LINELEN,
+                       "%-8s %6s %8s %8s %10s %10s %10s\n",
+                       "QUEUE", "READY", "DELAYED", "MAXREADY",
+                       "PROCESSED", "MAXLAT", "AVGLAT");
+  totalsize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+
+  /* Then one line for each work queue */
+
+  for (i = 0; i < WQUEUE_NQUEUES && totalsize < buflen; i++)
+    {
+      if (work_getstats(g_wqueue_names[i].qid, &stats) < 0)
+        {
+          continue;
+        }
+
+      avglatency = 0;
+      if (stats.nprocessed > 0)
+        {
+          avglatency = (unsigned long)
+            (stats.totlatency * USEC_PER_TICK / stats.nprocessed);
+        }
+
+      linesize   = snprintf(attr->line, WQUEUE_LINELEN,
+                            "%-8s %6lu %8lu %8lu %10lu %10lu %10lu\n",
+                            g_wqueue_names[i].name,
+                            (unsigned long)stats.nready,
+                            (unsigned long)stats.ndelayed,
+                            (unsigned long)stats.maxready,
+                            (unsigned long)stats.nprocessed,
+                            (unsigned long)TICK2USEC(stats.maxlatency),
+                            avglatency);
+      copysize   = procfs_memcpy(attr->line, linesize, buffer + totalsize,
+                                 buflen - totalsize, &offset);
+      totalsize += copysize;
+    }
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct wqueue_file_s *oldattr;
+  FAR struct wqueue_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct wqueue_file_s *)
+    kmm_malloc(sizeof(struct wqueue_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "wqueue" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "wqueue") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "wqueue" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_ioctl
+ *
+ * Description: FIOC_RESETSTAT clears the statistics of all work queues.
+ *
+ ****************************************************************************/
+
+static int wqueue_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  int i;
+
+  if (cmd != FIOC_RESETSTAT)
+    {
+      return -ENOTTY;
+    }
+
+  for (i = 0; i < WQUEUE_NQUEUES; i++)
+    {
+      work_resetstats(g_wqueue_names[i].qid);
+    }
+
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_WQUEUE_STATISTICS */
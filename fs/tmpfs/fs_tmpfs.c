@@ -51,10 +51,20 @@
 #  warning CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
-#if CONFIG_FS_TMPFS_FILE_FREEGUARD <= CONFIG_FS_TMPFS_FILE_ALLOCGUARD
-#  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
+#if (CONFIG_FS_TMPFS_PAGESIZE & (CONFIG_FS_TMPFS_PAGESIZE - 1)) != 0
+#  error CONFIG_FS_TMPFS_PAGESIZE must be a power of two
 #endif
 
+/* File page geometry */
+
+#define TMPFS_PAGESIZE      CONFIG_FS_TMPFS_PAGESIZE
+#define TMPFS_PAGEMASK      (TMPFS_PAGESIZE - 1)
+#define TMPFS_NPAGES(n)     (((n) + TMPFS_PAGEMASK) / TMPFS_PAGESIZE)
+
+/* Minimum number of entries in a file page table */
+
+#define TMPFS_MINPAGETABLE  4
+
 #define tmpfs_lock_file(tfo) \
            (tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -78,8 +88,16 @@ static int  tmpfs_lock_object(FAR struct tmpfs_object_s *to);
 static void tmpfs_unlock_object(FAR struct tmpfs_object_s *to);
 static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
               unsigned int nentries);
-static int  tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
+static int  tmpfs_grow_pagetable(FAR struct tmpfs_file_s *tfo,
+              size_t npages);
+static FAR uint8_t *tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+              size_t index);
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo, size_t first);
+static void tmpfs_shrink_file(FAR struct tmpfs_file_s *tfo,
               size_t newsize);
+static int  tmpfs_map_file(FAR struct tmpfs_file_s *tfo,
+              FAR void **ppv);
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo);
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -350,74 +368,283 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
 }
 
 /****************************************************************************
- * Name: tmpfs_realloc_file
+ * Name: tmpfs_grow_pagetable
+ *
+ * Description:
+ *   Make sure that the page table of the file has at least 'npages'
+ *   entries.  The table is doubled in size so that appending to a file
+ *   reallocates the table only O(log n) times.  Only the table of page
+ *   pointers is copied, never the file data.
+ *
  ****************************************************************************/
 
-static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
-                              size_t newsize)
+static int tmpfs_grow_pagetable(FAR struct tmpfs_file_s *tfo,
+                                size_t npages)
 {
-  FAR struct tmpfs_file_s *oldtfo = *tfo;
-  FAR struct tmpfs_file_s *newtfo;
-  size_t objsize;
-  size_t allocsize;
-  size_t delta;
+  FAR uint8_t **pages;
+  size_t newpages;
 
-  /* Check if the current allocation is sufficient */
+  if (npages <= tfo->tfo_npages)
+    {
+      return OK;
+    }
 
-  objsize = SIZEOF_TMPFS_FILE(newsize);
+  newpages = tfo->tfo_npages << 1;
+  if (newpages < npages)
+    {
+      newpages = npages;
+    }
 
-  /* Are we growing or shrinking the object? */
+  if (newpages < TMPFS_MINPAGETABLE)
+    {
+      newpages = TMPFS_MINPAGETABLE;
+    }
 
-  if (objsize <= oldtfo->tfo_alloc)
+  pages = (FAR uint8_t **)kmm_realloc(tfo->tfo_pages,
+                                      newpages * sizeof(FAR uint8_t *));
+  if (pages == NULL)
     {
-      /* Shrinking ... Shrink unconditionally if the size is shrinking to
-       * zero.
-       */
+      return -ENOMEM;
+    }
+
+  /* The new entries are all holes */
+
+  memset(&pages[tfo->tfo_npages], 0,
+         (newpages - tfo->tfo_npages) * sizeof(FAR uint8_t *));
+
+  tfo->tfo_alloc += (newpages - tfo->tfo_npages) * sizeof(FAR uint8_t *);
+  tfo->tfo_pages  = pages;
+  tfo->tfo_npages = newpages;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tmpfs_alloc_page
+ *
+ * Description:
+ *   Return the page at 'index', allocating a zeroed page if that part of
+ *   the file is a hole.  NULL is returned if memory is exhausted.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_alloc_page(FAR struct tmpfs_file_s *tfo,
+                                     size_t index)
+{
+  FAR uint8_t *page;
+
+  if (tmpfs_grow_pagetable(tfo, index + 1) < 0)
+    {
+      return NULL;
+    }
 
-      if (newsize > 0)
+  page = tfo->tfo_pages[index];
+  if (page == NULL)
+    {
+      page = (FAR uint8_t *)kmm_zalloc(TMPFS_PAGESIZE);
+      if (page != NULL)
         {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
-           */
+          tfo->tfo_pages[index] = page;
+          tfo->tfo_alloc       += TMPFS_PAGESIZE;
+        }
+    }
 
-          delta = oldtfo->tfo_alloc - objsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
-            {
-              /* Hasn't shrunk enough.. Return doing nothing for now */
+  return page;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_pages
+ *
+ * Description:
+ *   Release every page of the file starting with page 'first'.  Pages that
+ *   are part of a FIOC_MMAP mapping cannot be freed individually;  they are
+ *   zeroed instead so that the mapping stays valid.  Releasing all pages
+ *   also releases the mapping and the page table.
+ *
+ ****************************************************************************/
+
+static void tmpfs_free_pages(FAR struct tmpfs_file_s *tfo, size_t first)
+{
+  FAR uint8_t *page;
+  size_t i;
+
+  for (i = first; i < tfo->tfo_npages; i++)
+    {
+      page = tfo->tfo_pages[i];
+      if (page == NULL)
+        {
+          continue;
+        }
 
-              oldtfo->tfo_size = newsize;
-              return OK;
+      if (tfo->tfo_map != NULL && page >= tfo->tfo_map &&
+          page < tfo->tfo_map + tfo->tfo_mapsize)
+        {
+          if (first > 0)
+            {
+              memset(page, 0, TMPFS_PAGESIZE);
+              continue;
             }
         }
+      else
+        {
+          kmm_free(page);
+          tfo->tfo_alloc -= TMPFS_PAGESIZE;
+        }
+
+      tfo->tfo_pages[i] = NULL;
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
+  if (first == 0)
+    {
+      if (tfo->tfo_map != NULL)
+        {
+          kmm_free(tfo->tfo_map);
+          tfo->tfo_alloc  -= tfo->tfo_mapsize;
+          tfo->tfo_map     = NULL;
+          tfo->tfo_mapsize = 0;
+        }
+
+      if (tfo->tfo_pages != NULL)
+        {
+          kmm_free(tfo->tfo_pages);
+          tfo->tfo_alloc -= tfo->tfo_npages * sizeof(FAR uint8_t *);
+          tfo->tfo_pages  = NULL;
+          tfo->tfo_npages = 0;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: tmpfs_shrink_file
+ *
+ * Description:
+ *   Reduce the size of the file to 'newsize' bytes, releasing the pages
+ *   that are no longer needed.
+ *
+ ****************************************************************************/
+
+static void tmpfs_shrink_file(FAR struct tmpfs_file_s *tfo,
+                              size_t newsize)
+{
+  FAR uint8_t *page;
+  size_t index;
+  size_t offset;
+
+  DEBUGASSERT(newsize <= tfo->tfo_size);
+
+  tmpfs_free_pages(tfo, TMPFS_NPAGES(newsize));
+
+  /* Keep the tail of a partial last page zeroed so that extending the
+   * file again exposes zeros, not the old data.
    */
 
-  allocsize = objsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+  index  = newsize / TMPFS_PAGESIZE;
+  offset = newsize & TMPFS_PAGEMASK;
+
+  if (offset > 0 && index < tfo->tfo_npages)
+    {
+      page = tfo->tfo_pages[index];
+      if (page != NULL)
+        {
+          memset(page + offset, 0, TMPFS_PAGESIZE - offset);
+        }
+    }
 
-  /* Realloc the file object */
+  tfo->tfo_size = newsize;
+}
 
-  newtfo = (FAR struct tmpfs_file_s *)kmm_realloc(oldtfo, allocsize);
-  if (newtfo == NULL)
+/****************************************************************************
+ * Name: tmpfs_map_file
+ *
+ * Description:
+ *   FIOC_MMAP needs the file contents at one contiguous address.  Move the
+ *   pages into a single allocation and leave the page table pointing into
+ *   it.  Later appends allocate ordinary pages again;  the file is only
+ *   moved again if it is re-mapped after it has outgrown the mapping.
+ *
+ ****************************************************************************/
+
+static int tmpfs_map_file(FAR struct tmpfs_file_s *tfo, FAR void **ppv)
+{
+  FAR uint8_t *map;
+  FAR uint8_t *page;
+  size_t mapsize;
+  size_t npages;
+  size_t i;
+  int ret;
+
+  npages = TMPFS_NPAGES(tfo->tfo_size);
+  if (npages == 0)
+    {
+      npages = 1;
+    }
+
+  mapsize = npages * TMPFS_PAGESIZE;
+
+  /* Pages inside an existing mapping never move, so the mapping is still
+   * good if it covers the whole file.
+   */
+
+  if (tfo->tfo_map != NULL && mapsize <= tfo->tfo_mapsize)
+    {
+      *ppv = tfo->tfo_map;
+      return OK;
+    }
+
+  ret = tmpfs_grow_pagetable(tfo, npages);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  map = (FAR uint8_t *)kmm_zalloc(mapsize);
+  if (map == NULL)
     {
       return -ENOMEM;
     }
 
-  /* Adjust the reference in the parent directory entry */
+  for (i = 0; i < npages; i++)
+    {
+      page = tfo->tfo_pages[i];
+      if (page != NULL)
+        {
+          memcpy(map + i * TMPFS_PAGESIZE, page, TMPFS_PAGESIZE);
+
+          if (tfo->tfo_map == NULL || page < tfo->tfo_map ||
+              page >= tfo->tfo_map + tfo->tfo_mapsize)
+            {
+              kmm_free(page);
+              tfo->tfo_alloc -= TMPFS_PAGESIZE;
+            }
+        }
+
+      tfo->tfo_pages[i] = map + i * TMPFS_PAGESIZE;
+    }
 
-  DEBUGASSERT(newtfo->tfo_dirent);
-  newtfo->tfo_dirent->tde_object = (FAR struct tmpfs_object_s *)newtfo;
+  if (tfo->tfo_map != NULL)
+    {
+      kmm_free(tfo->tfo_map);
+      tfo->tfo_alloc -= tfo->tfo_mapsize;
+    }
 
-  /* Return the new address of the reallocated file object */
+  tfo->tfo_map     = map;
+  tfo->tfo_mapsize = mapsize;
+  tfo->tfo_alloc  += mapsize;
 
-  newtfo->tfo_alloc = allocsize;
-  newtfo->tfo_size  = newsize;
-  *tfo              = newtfo;
+  *ppv = map;
   return OK;
 }
 
+/****************************************************************************
+ * Name: tmpfs_free_file
+ ****************************************************************************/
+
+static void tmpfs_free_file(FAR struct tmpfs_file_s *tfo)
+{
+  tmpfs_free_pages(tfo, 0);
+  nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
+  kmm_free(tfo);
+}
+
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
  ****************************************************************************/
@@ -453,8 +680,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
 
   if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0)
     {
-      nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
-      kmm_free(tfo);
+      tmpfs_free_file(tfo);
     }
 
   /* Otherwise, just decrement the reference count on the file object */
@@ -600,12 +826,12 @@ static int tmpfs_add_dirent(FAR struct tmpfs_directory_s **tdo,
 static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
 {
   FAR struct tmpfs_file_s *tfo;
-  size_t allocsize;
 
-  /* Create a new zero length file object */
+  /* Create a new zero length file object.  No pages are allocated until
+   * data is written.
+   */
 
-  allocsize = SIZEOF_TMPFS_FILE(CONFIG_FS_TMPFS_FILE_ALLOCGUARD);
-  tfo = (FAR struct tmpfs_file_s *)kmm_malloc(allocsize);
+  tfo = (FAR struct tmpfs_file_s *)kmm_malloc(sizeof(struct tmpfs_file_s));
   if (tfo == NULL)
     {
       return NULL;
@@ -615,11 +841,15 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
    * locked with one reference count.
    */
 
-  tfo->tfo_alloc = allocsize;
-  tfo->tfo_type  = TMPFS_REGULAR;
-  tfo->tfo_refs  = 1;
-  tfo->tfo_flags = 0;
-  tfo->tfo_size  = 0;
+  tfo->tfo_alloc   = sizeof(struct tmpfs_file_s);
+  tfo->tfo_type    = TMPFS_REGULAR;
+  tfo->tfo_refs    = 1;
+  tfo->tfo_flags   = 0;
+  tfo->tfo_size    = 0;
+  tfo->tfo_npages  = 0;
+  tfo->tfo_mapsize = 0;
+  tfo->tfo_pages   = NULL;
+  tfo->tfo_map     = NULL;
 
   tfo->tfo_exclsem.ts_holder = getpid();
   tfo->tfo_exclsem.ts_count  = 1;
@@ -1280,6 +1510,11 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
           tfo->tfo_flags |= TFO_FLAG_UNLINKED;
           return TMPFS_UNLINKED;
         }
+
+      /* No.. Free the file object and all of its pages now */
+
+      tmpfs_free_file(tfo);
+      return TMPFS_DELETED;
     }
 
   /* Free the object now */
@@ -1446,11 +1681,7 @@ static int tmpfs_open(FAR struct file *filep, FAR const char *relpath,
 
           if (tfo->tfo_size > 0)
             {
-              ret = tmpfs_realloc_file(&tfo, 0);
-              if (ret < 0)
-                {
-                  goto errout_with_filelock;
-                }
+              tmpfs_shrink_file(tfo, 0);
             }
         }
     }
@@ -1566,7 +1797,7 @@ static int tmpfs_close(FAR struct file *filep)
        * have any other references.
        */
 
-      kmm_free(tfo);
+      tmpfs_free_file(tfo);
       return OK;
     }
 
@@ -1584,9 +1815,13 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
                           size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nread;
   off_t startpos;
-  off_t endpos;
+  size_t remaining;
+  size_t index;
+  size_t offset;
+  size_t ncopy;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1608,18 +1843,46 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
   /* Handle attempts to read beyond the end of the file. */
 
   startpos = filep->f_pos;
-  nread    = buflen;
-  endpos   = startpos + buflen;
+  nread    = 0;
 
-  if (endpos > tfo->tfo_size)
+  if (startpos < tfo->tfo_size)
     {
-      endpos = tfo->tfo_size;
-      nread  = endpos - startpos;
+      nread = buflen;
+      if (nread > tfo->tfo_size - startpos)
+        {
+          nread = tfo->tfo_size - startpos;
+        }
     }
 
-  /* Copy data from the memory object to the user buffer */
+  /* Copy data from the file pages to the user buffer, one page at a time.
+   * Holes read back as zeros.
+   */
+
+  for (remaining = nread; remaining > 0; remaining -= ncopy)
+    {
+      index  = startpos / TMPFS_PAGESIZE;
+      offset = startpos & TMPFS_PAGEMASK;
+      ncopy  = TMPFS_PAGESIZE - offset;
+
+      if (ncopy > remaining)
+        {
+          ncopy = remaining;
+        }
+
+      page = index < tfo->tfo_npages ? tfo->tfo_pages[index] : NULL;
+      if (page != NULL)
+        {
+          memcpy(buffer, page + offset, ncopy);
+        }
+      else
+        {
+          memset(buffer, 0, ncopy);
+        }
+
+      buffer   += ncopy;
+      startpos += ncopy;
+    }
 
-  memcpy(buffer, &tfo->tfo_data[startpos], nread);
   filep->f_pos += nread;
 
   /* Release the lock on the file */
@@ -1636,9 +1899,12 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
                            size_t buflen)
 {
   FAR struct tmpfs_file_s *tfo;
+  FAR uint8_t *page;
   ssize_t nwritten;
   off_t startpos;
-  off_t endpos;
+  size_t remaining;
+  size_t offset;
+  size_t ncopy;
   int ret;
 
   finfo("filep: %p buffer: %p buflen: %lu\n",
@@ -1657,28 +1923,50 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
       return ret;
     }
 
-  /* Handle attempts to write beyond the end of the file */
+  /* Copy data from the user buffer to the file pages, allocating pages
+   * as needed.  Writing past the end of the file only allocates the pages
+   * that are written;  any gap is left as a hole.
+   */
 
   startpos = filep->f_pos;
-  nwritten = buflen;
-  endpos   = startpos + buflen;
+  nwritten = 0;
 
-  if (endpos > tfo->tfo_size)
+  for (remaining = buflen; remaining > 0; remaining -= ncopy)
     {
-      /* Reallocate the file to handle the write past the end of the file. */
+      offset = startpos & TMPFS_PAGEMASK;
+      ncopy  = TMPFS_PAGESIZE - offset;
 
-      ret = tmpfs_realloc_file(&tfo, (size_t)endpos);
-      if (ret < 0)
+      if (ncopy > remaining)
         {
-          goto errout_with_lock;
+          ncopy = remaining;
+        }
+
+      page = tmpfs_alloc_page(tfo, startpos / TMPFS_PAGESIZE);
+      if (page == NULL)
+        {
+          /* Out of memory.  Report a partial write, if any */
+
+          if (nwritten == 0)
+            {
+              ret = -ENOMEM;
+              goto errout_with_lock;
+            }
+
+          break;
         }
 
-      filep->f_priv = tfo;
+      memcpy(page + offset, buffer, ncopy);
+
+      buffer   += ncopy;
+      startpos += ncopy;
+      nwritten += ncopy;
     }
 
-  /* Copy data from the memory object to the user buffer */
+  if (startpos > tfo->tfo_size)
+    {
+      tfo->tfo_size = startpos;
+    }
 
-  memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
   filep->f_pos += nwritten;
 
   /* Release the lock on the file */
@@ -1759,6 +2047,7 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   FAR struct tmpfs_file_s *tfo;
   FAR void **ppv = (FAR void**)arg;
+  int ret;
 
   finfo("filep: %p cmd: %d arg: %08lx\n", filep, cmd, arg);
   DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
@@ -1774,11 +2063,18 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   if (cmd == FIOC_MMAP && ppv != NULL)
     {
       /* Return the address on the media corresponding to the start of
-       * the file.
+       * the file.  This requires that the file pages be contiguous.
        */
 
-      *ppv = (FAR void *)tfo->tfo_data;
-      return OK;
+      ret = tmpfs_lock_file(tfo);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      ret = tmpfs_map_file(tfo, ppv);
+      tmpfs_unlock_file(tfo);
+      return ret;
     }
 
   ferr("ERROR: Invalid cmd: %d\n", cmd);
@@ -1870,7 +2166,6 @@ static int tmpfs_fstat(FAR const struct file *filep, FAR struct stat *buf)
 static int tmpfs_truncate(FAR struct file *filep, off_t length)
 {
   FAR struct tmpfs_file_s *tfo;
-  size_t oldsize;
   int ret;
 
   finfo("filep: %p length: %ld\n", filep, (long)length);
@@ -1888,40 +2183,24 @@ static int tmpfs_truncate(FAR struct file *filep, off_t length)
       return ret;
     }
 
-  /* Get the old size of the file.  Do nothing if the file size is not
-   * changing.
+  /* Shrinking the file releases the pages beyond the new end of the file.
+   * Growing the file just extends it with a hole;  no memory is allocated
+   * until the new region is written.
    */
 
-  oldsize = tfo->tfo_size;
-  if (oldsize != length)
+  if ((size_t)length < tfo->tfo_size)
     {
-      /* The size is changing.. up or down.  Reallocate the file memory. */
-
-      ret = tmpfs_realloc_file(&tfo, (size_t)length);
-      if (ret < 0)
-        {
-          goto errout_with_lock;
-        }
-
-      filep->f_priv = tfo;
-
-      /* If the size has increased, then we need to zero the newly added
-       * memory.
-       */
-
-      if (length > oldsize)
-        {
-          memset(&tfo->tfo_data[oldsize], 0, length - oldsize);
-        }
-
-      ret = OK;
+      tmpfs_shrink_file(tfo, (size_t)length);
+    }
+  else
+    {
+      tfo->tfo_size = (size_t)length;
     }
 
   /* Release the lock on the file */
 
-errout_with_lock:
   tmpfs_unlock_file(tfo);
-  return ret;
+  return OK;
 }
 
 /****************************************************************************
@@ -2338,8 +2617,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
   else
     {
-      nxsem_destroy(&tfo->tfo_exclsem.ts_sem);
-      kmm_free(tfo);
+      tmpfs_free_file(tfo);
     }
 
   /* Release the reference and lock on the parent directory */
@@ -104,7 +104,7 @@ struct tmpfs_object_s
   FAR struct tmpfs_dirent_s *to_dirent;
   struct tmpfs_sem_s to_exclsem;
 
-  size_t   to_alloc;     /* Allocated size of the memory object */
+  size_t   to_alloc;     /* Memory allocated for the object */
   uint8_t  to_type;      /* See enum tmpfs_objtype_e */
   uint8_t  to_refs;      /* Reference count */
 };
@@ -132,6 +132,13 @@ struct tmpfs_directory_s
   (sizeof(struct tmpfs_directory_s) + ((n) - 1) * sizeof(struct tmpfs_dirent_s))
 
 /* The form of a regular file memory object
+ *
+ * File data is held in fixed-size pages of CONFIG_FS_TMPFS_PAGESIZE bytes
+ * that are referenced by a page table.  Pages are allocated on the first
+ * write and never move, so appending only ever allocates new pages and
+ * (occasionally) grows the page table.  Pages that have never been
+ * written are holes that read back as zeros.  Bytes beyond tfo_size in
+ * an allocated page are always zero.
  *
  * NOTE that in this very simplified implementation, there is no per-open
  * state.  The file memory object also serves as the open file object,
@@ -150,14 +157,20 @@ struct tmpfs_file_s
   uint8_t  tfo_type;     /* See enum tmpfs_objtype_e */
   uint8_t  tfo_refs;     /* Reference count */
 
-  /* Remaining fields are unique to a directory object */
+  /* Remaining fields are unique to a file object */
 
   uint8_t  tfo_flags;    /* See TFO_FLAG_* definitions */
   size_t   tfo_size;     /* Valid file size */
-  uint8_t  tfo_data[1];  /* File data starts here */
-};
+  size_t   tfo_npages;   /* Number of entries in tfo_pages[] */
+  size_t   tfo_mapsize;  /* Size of the tfo_map allocation */
 
-#define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
+  /* The page table (NULL entries are holes) and the contiguous copy of
+   * the pages created by FIOC_MMAP, if any.
+   */
+
+  FAR uint8_t **tfo_pages;
+  FAR uint8_t *tfo_map;
+};
 
 /* This structure represents one instance of a TMPFS file system */
 
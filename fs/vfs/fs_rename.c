@@ -269,6 +269,7 @@ next_subdir:
   /* Remove all of the children from the unlinked inode */
 
   oldinode->i_child = NULL;
+  inode_cache_invalidate();
   ret = OK;
 
 errout_with_sem:
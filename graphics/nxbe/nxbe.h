@@ -43,6 +43,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -80,6 +81,22 @@
 #define NXBE_STATE_CLRMODAL(nxbe) \
   do { (nxbe)->flags &= ~NXBE_STATE_MODAL; } while (0)
 
+/* Compositor ***************************************************************/
+
+#ifdef CONFIG_NX_COMPOSITOR
+#  ifndef CONFIG_NX_COMPOSITOR_NRECTS
+#    define CONFIG_NX_COMPOSITOR_NRECTS 8
+#  endif
+
+#  if defined(CONFIG_FB_SYNC) && !defined(CONFIG_NX_LCDDRIVER)
+#    define NXBE_HAVE_VSYNC 1
+#  endif
+
+/* True if there are damaged regions waiting for the compositor */
+
+#  define NXBE_ISDAMAGED(nxbe) ((nxbe)->ndamage > 0)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -113,6 +130,16 @@ struct nxbe_dev_vtable_s
                              FAR const void *src,
                              FAR const struct nxgl_point_s *origin,
                              unsigned int srcstride);
+#ifdef CONFIG_NX_ALPHABLEND
+  CODE void (*blendrectangle)(FAR NX_PLANEINFOTYPE *pinfo,
+                              FAR const struct nxgl_rect_s *rect,
+                              nxgl_mxpixel_t color, uint8_t alpha);
+  CODE void (*blendbitmap)(FAR NX_PLANEINFOTYPE *pinfo,
+                           FAR const struct nxgl_rect_s *dest,
+                           FAR const void *src,
+                           FAR const struct nxgl_point_s *origin,
+                           unsigned int srcstride, uint8_t alpha);
+#endif
 };
 
 #ifdef CONFIG_NX_RAMBACKED
@@ -270,6 +297,20 @@ struct nxbe_state_s
   /* Rasterizing functions selected to match the BPP reported in pinfo[] */
 
   struct nxbe_plane_s plane[CONFIG_NX_NPLANES];
+
+#ifdef CONFIG_NX_COMPOSITOR
+  /* Regions of the display (in device coordinates) that must be refreshed
+   * from the per-window framebuffers on the next composited frame.
+   */
+
+  uint8_t ndamage;                   /* Number of damaged regions */
+  struct nxgl_rect_s damage[CONFIG_NX_COMPOSITOR_NRECTS];
+  clock_t frametime;                 /* Time of the last composited frame */
+
+#ifdef NXBE_HAVE_VSYNC
+  FAR NX_DRIVERTYPE *dev;            /* Used to wait for vertical sync */
+#endif
+#endif
 };
 
 /****************************************************************************
@@ -688,6 +729,62 @@ void nxbe_bitmap(FAR struct nxbe_window_s *wnd,
                  FAR const struct nxgl_point_s *origin,
                  unsigned int stride);
 
+/****************************************************************************
+ * Name: nxbe_blendrectangle
+ *
+ * Description:
+ *  Blend the specified color with the given opacity over the specified
+ *  rectangle in the window.  Nothing is drawn if the plane has no blend
+ *  operation for its color format.
+ *
+ * Input Parameters:
+ *   wnd   - The window structure reference
+ *   rect  - The location to be blended
+ *   color - The color to blend
+ *   alpha - The opacity of the color (0-255)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_ALPHABLEND
+void nxbe_blendrectangle(FAR struct nxbe_window_s *wnd,
+                         FAR const struct nxgl_rect_s *rect,
+                         nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                         uint8_t alpha);
+
+/****************************************************************************
+ * Name: nxbe_blendbitmap
+ *
+ * Description:
+ *   Blend a rectangular region of a larger image with the given opacity
+ *   into the rectangle in the specified window.  Nothing is drawn if the
+ *   plane has no blend operation for its color format.
+ *
+ * Input Parameters:
+ *   wnd    - The window that will receive the bitmap image
+ *   dest   - Describes the rectangular region on the display that will
+ *            receive the the bit map (window coordinate frame).
+ *   src    - The start of the source image.
+ *   origin - The origin of the upper, left-most corner of the full bitmap.
+ *            Both dest and origin are in window coordinates, however, origin
+ *            may lie outside of the display.
+ *   stride - The width of the full source image in bytes.
+ *   alpha  - The opacity of the image (0-255)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_blendbitmap(FAR struct nxbe_window_s *wnd,
+                      FAR const struct nxgl_rect_s *dest,
+                      FAR const void *src[CONFIG_NX_NPLANES],
+                      FAR const struct nxgl_point_s *origin,
+                      unsigned int stride, uint8_t alpha);
+#endif
+
 /****************************************************************************
  * Name: nxbe_flush
  *
@@ -755,6 +852,44 @@ void nxbe_redrawbelow(FAR struct nxbe_state_s *be,
                       FAR struct nxbe_window_s *wnd,
                       FAR const struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: nxbe_damage
+ *
+ * Description:
+ *   Record a region of the display that must be refreshed from the per-
+ *   window framebuffers by the next call to nxbe_composite().
+ *
+ * Input Parameters:
+ *   be   - The back-end state structure instance
+ *   rect - The damaged region in graphics device coordinates
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_COMPOSITOR
+void nxbe_damage(FAR struct nxbe_state_s *be,
+                 FAR const struct nxgl_rect_s *rect);
+
+/****************************************************************************
+ * Name: nxbe_composite
+ *
+ * Description:
+ *   Refresh all damaged regions of the display from the per-window
+ *   framebuffers in one pass and clear the damage list.
+ *
+ * Input Parameters:
+ *   be - The back-end state structure instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_composite(FAR struct nxbe_state_s *be);
+#endif
+
 /****************************************************************************
  * Name: nxbe_isvisible
  *
@@ -328,6 +328,22 @@ void nxbe_bitmap(FAR struct nxbe_window_s *wnd,
       /* Update the per-window framebuffer */
 
       nxbe_bitmap_pwfb(wnd, dest, src, origin, stride);
+
+#ifdef CONFIG_NX_COMPOSITOR
+      /* The compositor will update the device on the next frame */
+
+      if (!NXBE_ISHIDDEN(wnd))
+        {
+          struct nxgl_rect_s bounds;
+
+          nxgl_rectoffset(&bounds, dest,
+                          wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+          nxgl_rectintersect(&bounds, &bounds, &wnd->bounds);
+          nxbe_damage(wnd->be, &bounds);
+        }
+
+      return;
+#endif
     }
 #endif
 
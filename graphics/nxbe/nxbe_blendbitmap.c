@@ -0,0 +1,307 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_blendbitmap.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/nx/nxglib.h>
+#include <nuttx/nx/nx.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_ALPHABLEND
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct nxbe_blendbitmap_s
+{
+  struct nxbe_clipops_s cops;
+  FAR const void *src;              /* The start of the source image. */
+  struct nxgl_point_s origin;       /* Offset into the source image data */
+  unsigned int stride;              /* The width of the full source image in bytes. */
+  uint8_t alpha;                    /* Opacity of the image */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_clipblendbitmap
+ *
+ * Description:
+ *  Called from nxbe_clipper() to performed the blend operation on visible
+ *  portions of the rectangle.
+ *
+ ****************************************************************************/
+
+static void nxbe_clipblendbitmap(FAR struct nxbe_clipops_s *cops,
+                                 FAR struct nxbe_plane_s *plane,
+                                 FAR const struct nxgl_rect_s *rect)
+{
+  struct nxbe_blendbitmap_s *bminfo = (struct nxbe_blendbitmap_s *)cops;
+
+  /* Blend the rectangular region into the graphics device. */
+
+  plane->dev.blendbitmap(&plane->pinfo, rect, bminfo->src,
+                         &bminfo->origin, bminfo->stride, bminfo->alpha);
+
+#ifdef CONFIG_NX_UPDATE
+  /* Notify external logic that the display has been updated */
+
+  nx_notify_rectangle(&plane->pinfo, rect);
+#endif
+}
+
+/****************************************************************************
+ * Name: nxbe_blendbitmap_dev
+ *
+ * Description:
+ *  Blend the image into the window in device memory, performing clipping
+ *  as needed.
+ *
+ ****************************************************************************/
+
+static void nxbe_blendbitmap_dev(FAR struct nxbe_window_s *wnd,
+                                 FAR const struct nxgl_rect_s *dest,
+                                 FAR const void *src[CONFIG_NX_NPLANES],
+                                 FAR const struct nxgl_point_s *origin,
+                                 unsigned int stride, uint8_t alpha)
+{
+  struct nxbe_blendbitmap_s info;
+  struct nxgl_rect_s bounds;
+  struct nxgl_point_s offset;
+  struct nxgl_rect_s remaining;
+  int i;
+
+  /* Offset the rectangle and image origin by the window origin */
+
+  nxgl_rectoffset(&bounds, dest, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+  nxgl_vectoradd(&offset, origin, &wnd->bounds.pt1);
+
+  /* Clip to the limits of the window and of the background screen */
+
+  nxgl_rectintersect(&remaining, &bounds, &wnd->bounds);
+  nxgl_rectintersect(&remaining, &remaining, &wnd->be->bkgd.bounds);
+
+  if (nxgl_nullrect(&remaining))
+    {
+      return;
+    }
+
+  /* Then perform the clipped blend */
+
+#if CONFIG_NX_NPLANES > 1
+  for (i = 0; i < wnd->be->vinfo.nplanes; i++)
+#else
+  i = 0;
+#endif
+    {
+      info.cops.visible  = nxbe_clipblendbitmap;
+      info.cops.obscured = nxbe_clipnull;
+      info.src           = src[i];
+      info.origin.x      = offset.x;
+      info.origin.y      = offset.y;
+      info.stride        = stride;
+      info.alpha         = alpha;
+
+      nxbe_clipper(wnd->above, &remaining, NX_CLIPORDER_DEFAULT,
+                   &info.cops, &wnd->be->plane[i]);
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_blendbitmap_pwfb
+ *
+ * Description:
+ *  Blend the image into the per-window framebuffer with no clipping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_RAMBACKED
+static inline void
+nxbe_blendbitmap_pwfb(FAR struct nxbe_window_s *wnd,
+                      FAR const struct nxgl_rect_s *dest,
+                      FAR const void *src[CONFIG_NX_NPLANES],
+                      FAR const struct nxgl_point_s *origin,
+                      unsigned int stride, uint8_t alpha)
+{
+  struct fb_planeinfo_s pinfo;
+  struct nxgl_rect_s destrect;
+
+  /* Clip to the limits of the window and of the background screen (in
+   * device coordinates) and then restore the destination rectangle to
+   * relative window coordinates.
+   */
+
+  nxgl_rectoffset(&destrect, dest, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+  nxgl_rectintersect(&destrect, &destrect, &wnd->bounds);
+  nxgl_rectintersect(&destrect, &destrect, &wnd->be->bkgd.bounds);
+
+  if (nxgl_nullrect(&destrect))
+    {
+      return;
+    }
+
+  nxgl_rectoffset(&destrect, &destrect,
+                  -wnd->bounds.pt1.x, -wnd->bounds.pt1.y);
+
+  /* The per-window framebuffer has the pixel format of the device, so the
+   * device rasterizer can blend into it once it is described as a plane.
+   * REVISIT:  Assumes a single color plane.
+   */
+
+  memcpy(&pinfo, &wnd->be->plane[0].pinfo, sizeof(struct fb_planeinfo_s));
+  pinfo.fbmem  = wnd->fbmem;
+  pinfo.stride = wnd->stride;
+  pinfo.fblen  = wnd->stride *
+                 (wnd->bounds.pt2.y - wnd->bounds.pt1.y + 1);
+
+  wnd->be->plane[0].dev.blendbitmap(&pinfo, &destrect, src[0], origin,
+                                    stride, alpha);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_blendbitmap
+ *
+ * Description:
+ *   Blend a rectangular region of a larger image with the given opacity
+ *   into the rectangle in the specified window.
+ *
+ * Input Parameters:
+ *   wnd    - The window that will receive the bitmap image
+ *   dest   - Describes the rectangular region on the display that will
+ *            receive the the bit map (window coordinate frame).
+ *   src    - The start of the source image.
+ *   origin - The origin of the upper, left-most corner of the full bitmap.
+ *            Both dest and origin are in window coordinates, however, origin
+ *            may lie outside of the display.
+ *   stride - The width of the full source image in bytes.
+ *   alpha  - The opacity of the image (0-255)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_blendbitmap(FAR struct nxbe_window_s *wnd,
+                      FAR const struct nxgl_rect_s *dest,
+                      FAR const void *src[CONFIG_NX_NPLANES],
+                      FAR const struct nxgl_point_s *origin,
+                      unsigned int stride, uint8_t alpha)
+{
+  unsigned int deststride;
+
+  DEBUGASSERT(wnd != NULL && dest != NULL && src != NULL && origin != NULL);
+  DEBUGASSERT(wnd->be != NULL && wnd->be->plane != NULL);
+
+  /* Blending is only available for RGB color formats */
+
+  if (wnd->be->plane[0].dev.blendbitmap == NULL)
+    {
+      gwarn("WARNING: No blending at %d bpp\n", wnd->be->plane[0].pinfo.bpp);
+      return;
+    }
+
+  /* Verify that the destination rectangle begins "below" and to the "right"
+   * of the origin
+   */
+
+  if (dest->pt1.x < origin->x || dest->pt1.y < origin->y)
+    {
+      gerr("ERROR: Bad dest start position\n");
+      return;
+    }
+
+  /* Verify that the width of the destination rectangle does not exceed the
+   * width of the source bitmap data (taking into account the bitmap origin)
+   */
+
+  deststride = (((dest->pt2.x - origin->x + 1) *
+                 wnd->be->plane[0].pinfo.bpp + 7) >> 3);
+  if (deststride > stride)
+    {
+      gerr("ERROR: Bad dest width\n");
+      return;
+    }
+
+#ifdef CONFIG_NX_RAMBACKED
+  /* If this window supports a pre-window frame buffer then blend into that
+   * framebuffer too.
+   */
+
+  if (NXBE_ISRAMBACKED(wnd))
+    {
+      nxbe_blendbitmap_pwfb(wnd, dest, src, origin, stride, alpha);
+
+#ifdef CONFIG_NX_COMPOSITOR
+      /* The compositor will update the device on the next frame */
+
+      if (!NXBE_ISHIDDEN(wnd))
+        {
+          struct nxgl_rect_s bounds;
+
+          nxgl_rectoffset(&bounds, dest,
+                          wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+          nxgl_rectintersect(&bounds, &bounds, &wnd->bounds);
+          nxbe_damage(wnd->be, &bounds);
+        }
+
+      return;
+#endif
+    }
+#endif
+
+  /* Don't update hidden windows */
+
+  if (!NXBE_ISHIDDEN(wnd))
+    {
+      /* Blend directly into the graphics device */
+
+      nxbe_blendbitmap_dev(wnd, dest, src, origin, stride, alpha);
+
+#ifdef CONFIG_NX_SWCURSOR
+      /* Update cursor backup memory and redraw the cursor in the modified
+       * window region.
+       *
+       * REVISIT:  The cursor image is blended along with the window, so
+       * the backup taken here still contains a trace of it.
+       */
+
+      nxbe_cursor_backupdraw_all(wnd, dest);
+#endif
+    }
+}
+
+#endif /* CONFIG_NX_ALPHABLEND */
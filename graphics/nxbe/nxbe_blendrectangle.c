@@ -0,0 +1,254 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_blendrectangle.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/nx/nxglib.h>
+#include <nuttx/nx/nx.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_ALPHABLEND
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct nxbe_blend_s
+{
+  struct nxbe_clipops_s cops;
+  nxgl_mxpixel_t color;
+  uint8_t alpha;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_clipblend
+ *
+ * Description:
+ *  Called from nxbe_clipper() to performed the blend operation on visible
+ *  portions of the rectangle.
+ *
+ ****************************************************************************/
+
+static void nxbe_clipblend(FAR struct nxbe_clipops_s *cops,
+                           FAR struct nxbe_plane_s *plane,
+                           FAR const struct nxgl_rect_s *rect)
+{
+  struct nxbe_blend_s *blendinfo = (struct nxbe_blend_s *)cops;
+
+  /* Blend the rectangle into the graphics device. */
+
+  plane->dev.blendrectangle(&plane->pinfo, rect, blendinfo->color,
+                            blendinfo->alpha);
+
+#ifdef CONFIG_NX_UPDATE
+  /* Notify external logic that the display has been updated */
+
+  nx_notify_rectangle(&plane->pinfo, rect);
+#endif
+}
+
+/****************************************************************************
+ * Name: nxbe_blendrectangle_dev
+ *
+ * Description:
+ *  Blend the color into the specified rectangle in the window in device
+ *  memory, performing clipping as needed.
+ *
+ ****************************************************************************/
+
+static inline void
+nxbe_blendrectangle_dev(FAR struct nxbe_window_s *wnd,
+                        FAR const struct nxgl_rect_s *rect,
+                        nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                        uint8_t alpha)
+{
+  struct nxbe_blend_s info;
+  int i;
+
+#if CONFIG_NX_NPLANES > 1
+  for (i = 0; i < wnd->be->vinfo.nplanes; i++)
+#else
+  i = 0;
+#endif
+    {
+      /* Blend into the visible part of the rectangle */
+
+      info.cops.visible  = nxbe_clipblend;
+      info.cops.obscured = nxbe_clipnull;
+      info.color         = color[i];
+      info.alpha         = alpha;
+
+      nxbe_clipper(wnd->above, rect, NX_CLIPORDER_DEFAULT,
+                   &info.cops, &wnd->be->plane[i]);
+
+#ifdef CONFIG_NX_SWCURSOR
+      /* Backup and redraw the cursor in the affected region.
+       *
+       * REVISIT:  The cursor image is blended along with the window, so
+       * the backup taken here still contains a trace of it.
+       */
+
+      nxbe_cursor_backupdraw_dev(wnd->be, rect, i);
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_blendrectangle_pwfb
+ *
+ * Description:
+ *  Blend the color into the specified rectangle in the per-window frame
+ *  buffer with no clipping.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_RAMBACKED
+static inline void
+nxbe_blendrectangle_pwfb(FAR struct nxbe_window_s *wnd,
+                         FAR const struct nxgl_rect_s *rect,
+                         nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                         uint8_t alpha)
+{
+  struct fb_planeinfo_s pinfo;
+  struct nxgl_rect_s relrect;
+
+  /* The rectangle that we receive here is in absolute device coordinates.
+   * We need to restore this to windows relative coordinates.
+   */
+
+  nxgl_rectoffset(&relrect, rect, -wnd->bounds.pt1.x, -wnd->bounds.pt1.y);
+
+  /* The per-window framebuffer has the pixel format of the device, so the
+   * device rasterizer can blend into it once it is described as a plane.
+   * REVISIT:  Assumes a single color plane.
+   */
+
+  memcpy(&pinfo, &wnd->be->plane[0].pinfo, sizeof(struct fb_planeinfo_s));
+  pinfo.fbmem  = wnd->fbmem;
+  pinfo.stride = wnd->stride;
+  pinfo.fblen  = wnd->stride *
+                 (wnd->bounds.pt2.y - wnd->bounds.pt1.y + 1);
+
+  wnd->be->plane[0].dev.blendrectangle(&pinfo, &relrect, color[0], alpha);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_blendrectangle
+ *
+ * Description:
+ *  Blend the specified color with the given opacity over the specified
+ *  rectangle in the window.
+ *
+ * Input Parameters:
+ *   wnd   - The window structure reference
+ *   rect  - The location to be blended
+ *   color - The color to blend
+ *   alpha - The opacity of the color (0-255)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_blendrectangle(FAR struct nxbe_window_s *wnd,
+                         FAR const struct nxgl_rect_s *rect,
+                         nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                         uint8_t alpha)
+{
+  struct nxgl_rect_s remaining;
+
+  DEBUGASSERT(wnd != NULL && rect != NULL && color != NULL);
+  DEBUGASSERT(wnd->be != NULL && wnd->be->plane != NULL);
+
+  /* Blending is only available for RGB color formats */
+
+  if (wnd->be->plane[0].dev.blendrectangle == NULL)
+    {
+      gwarn("WARNING: No blending at %d bpp\n", wnd->be->plane[0].pinfo.bpp);
+      return;
+    }
+
+  /* Offset the rectangle by the window origin to convert it into a
+   * bounding box
+   */
+
+  nxgl_rectoffset(&remaining, rect, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+
+  /* Clip to the bounding box to the limits of the window and of the
+   * background screen
+   */
+
+  nxgl_rectintersect(&remaining, &remaining, &wnd->bounds);
+  nxgl_rectintersect(&remaining, &remaining, &wnd->be->bkgd.bounds);
+
+  if (!nxgl_nullrect(&remaining))
+    {
+#ifdef CONFIG_NX_RAMBACKED
+      /* If this window supports a pre-window frame buffer then blend into
+       * that framebuffer too.
+       */
+
+      if (NXBE_ISRAMBACKED(wnd))
+        {
+          nxbe_blendrectangle_pwfb(wnd, &remaining, color, alpha);
+
+#ifdef CONFIG_NX_COMPOSITOR
+          /* The compositor will update the device on the next frame */
+
+          if (!NXBE_ISHIDDEN(wnd))
+            {
+              nxbe_damage(wnd->be, &remaining);
+            }
+
+          return;
+#endif
+        }
+#endif
+
+      /* Don't update hidden windows */
+
+      if (!NXBE_ISHIDDEN(wnd))
+        {
+          /* Blend directly into the graphics device */
+
+          nxbe_blendrectangle_dev(wnd, &remaining, color, alpha);
+        }
+    }
+}
+
+#endif /* CONFIG_NX_ALPHABLEND */
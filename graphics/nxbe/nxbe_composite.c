@@ -0,0 +1,234 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_composite.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/nx/nxglib.h>
+#include <nuttx/nx/nxbe.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_COMPOSITOR
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_rectarea
+ *
+ * Description:
+ *   Return the number of pixels in a rectangle
+ *
+ ****************************************************************************/
+
+static uint32_t nxbe_rectarea(FAR const struct nxgl_rect_s *rect)
+{
+  return (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+         (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+
+/****************************************************************************
+ * Name: nxbe_composite_window
+ *
+ * Description:
+ *   Copy the visible part of one damaged region of a RAM-backed window from
+ *   its per-window framebuffer into device graphics memory.
+ *
+ ****************************************************************************/
+
+static void nxbe_composite_window(FAR struct nxbe_window_s *wnd,
+                                  FAR const struct nxgl_rect_s *damage)
+{
+  FAR const void *src[CONFIG_NX_NPLANES];
+  struct nxgl_rect_s wndrect;
+  struct nxgl_point_s origin;
+
+  nxgl_rectintersect(&wndrect, damage, &wnd->bounds);
+  if (nxgl_nullrect(&wndrect))
+    {
+      return;
+    }
+
+  /* nxbe_bitmap_dev() works in window coordinates and clips the copy to
+   * the parts of the window that are not obscured by the windows above.
+   * REVISIT:  Assumes a single color plane.
+   */
+
+  nxgl_rectoffset(&wndrect, &wndrect,
+                  -wnd->bounds.pt1.x, -wnd->bounds.pt1.y);
+
+  src[0]   = wnd->fbmem;
+  origin.x = 0;
+  origin.y = 0;
+
+  nxbe_bitmap_dev(wnd, &wndrect, src, &origin, wnd->stride);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_damage
+ *
+ * Description:
+ *   Record a region of the display that must be refreshed from the per-
+ *   window framebuffers by the next call to nxbe_composite().  Overlapping
+ *   regions are merged.  If the damage list is full, the region is merged
+ *   into the entry whose bounding box grows the least.
+ *
+ * Input Parameters:
+ *   be   - The back-end state structure instance
+ *   rect - The damaged region in graphics device coordinates
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_damage(FAR struct nxbe_state_s *be,
+                 FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s damage;
+  struct nxgl_rect_s merged;
+  uint32_t growth;
+  uint32_t best;
+  int index;
+  int i;
+
+  DEBUGASSERT(be != NULL && rect != NULL);
+
+  nxgl_rectintersect(&damage, rect, &be->bkgd.bounds);
+  if (nxgl_nullrect(&damage))
+    {
+      return;
+    }
+
+  /* Absorb the region into any damaged region that it overlaps */
+
+  for (i = 0; i < be->ndamage; i++)
+    {
+      if (nxgl_rectoverlap(&be->damage[i], &damage))
+        {
+          nxgl_rectunion(&be->damage[i], &be->damage[i], &damage);
+          return;
+        }
+    }
+
+  /* Otherwise add a new entry */
+
+  if (be->ndamage < CONFIG_NX_COMPOSITOR_NRECTS)
+    {
+      nxgl_rectcopy(&be->damage[be->ndamage], &damage);
+      be->ndamage++;
+      return;
+    }
+
+  /* The list is full.  Merge with the entry that grows the least. */
+
+  index = 0;
+  best  = UINT32_MAX;
+
+  for (i = 0; i < be->ndamage; i++)
+    {
+      nxgl_rectunion(&merged, &be->damage[i], &damage);
+      growth = nxbe_rectarea(&merged) - nxbe_rectarea(&be->damage[i]);
+      if (growth < best)
+        {
+          best  = growth;
+          index = i;
+        }
+    }
+
+  nxgl_rectunion(&be->damage[index], &be->damage[index], &damage);
+}
+
+/****************************************************************************
+ * Name: nxbe_composite
+ *
+ * Description:
+ *   Refresh all damaged regions of the display in one pass.  For each
+ *   damaged region, the visible part of every RAM-backed window is copied
+ *   from its per-window framebuffer into device graphics memory.  Windows
+ *   that are not RAM-backed draw directly into device memory and are not
+ *   touched.  If the framebuffer driver can wait for vertical sync, the
+ *   pass is started at the beginning of the vertical blanking interval.
+ *
+ * Input Parameters:
+ *   be - The back-end state structure instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_composite(FAR struct nxbe_state_s *be)
+{
+  FAR struct nxbe_window_s *wnd;
+  int i;
+
+  DEBUGASSERT(be != NULL);
+
+  if (be->ndamage == 0)
+    {
+      return;
+    }
+
+#ifdef NXBE_HAVE_VSYNC
+  if (be->dev != NULL && be->dev->waitforvsync != NULL)
+    {
+      be->dev->waitforvsync(be->dev);
+    }
+#endif
+
+  for (i = 0; i < be->ndamage; i++)
+    {
+      for (wnd = be->topwnd; wnd != NULL; wnd = wnd->below)
+        {
+          if (NXBE_ISRAMBACKED(wnd) && !NXBE_ISHIDDEN(wnd))
+            {
+              nxbe_composite_window(wnd, &be->damage[i]);
+            }
+        }
+
+#ifdef CONFIG_NX_SWCURSOR
+      /* Update cursor backup memory and redraw the cursor in the damaged
+       * region.
+       */
+
+      nxbe_cursor_backupdraw_devall(be, &be->damage[i]);
+#endif
+    }
+
+  be->ndamage   = 0;
+  be->frametime = clock_systime_ticks();
+}
+
+#endif /* CONFIG_NX_COMPOSITOR */
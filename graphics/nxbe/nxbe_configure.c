@@ -94,6 +94,12 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
       return ret;
     }
 
+#ifdef NXBE_HAVE_VSYNC
+  /* Remember the driver so that the compositor can wait for vertical sync */
+
+  be->dev = dev;
+#endif
+
   /* Set the initial background color */
 
   nxgl_colorcopy(be->bgcolor, g_bgcolor);
@@ -231,6 +237,10 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
           be->plane[i].dev.filltrapezoid  = nxgl_filltrapezoid_16bpp;
           be->plane[i].dev.moverectangle  = nxgl_moverectangle_16bpp;
           be->plane[i].dev.copyrectangle  = nxgl_copyrectangle_16bpp;
+#ifdef CONFIG_NX_ALPHABLEND
+          be->plane[i].dev.blendrectangle = nxgl_blendrectangle_16bpp;
+          be->plane[i].dev.blendbitmap    = nxgl_blendbitmap_16bpp;
+#endif
 
 #ifdef CONFIG_NX_RAMBACKED
           be->plane[i].pwfb.setpixel      = pwfb_setpixel_16bpp;
@@ -258,6 +268,10 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
           be->plane[i].dev.filltrapezoid  = nxgl_filltrapezoid_24bpp;
           be->plane[i].dev.moverectangle  = nxgl_moverectangle_24bpp;
           be->plane[i].dev.copyrectangle  = nxgl_copyrectangle_24bpp;
+#ifdef CONFIG_NX_ALPHABLEND
+          be->plane[i].dev.blendrectangle = nxgl_blendrectangle_24bpp;
+          be->plane[i].dev.blendbitmap    = nxgl_blendbitmap_24bpp;
+#endif
 
 #ifdef CONFIG_NX_RAMBACKED
           be->plane[i].pwfb.setpixel      = pwfb_setpixel_24bpp;
@@ -285,6 +299,10 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
           be->plane[i].dev.filltrapezoid  = nxgl_filltrapezoid_32bpp;
           be->plane[i].dev.moverectangle  = nxgl_moverectangle_32bpp;
           be->plane[i].dev.copyrectangle  = nxgl_copyrectangle_32bpp;
+#ifdef CONFIG_NX_ALPHABLEND
+          be->plane[i].dev.blendrectangle = nxgl_blendrectangle_32bpp;
+          be->plane[i].dev.blendbitmap    = nxgl_blendbitmap_32bpp;
+#endif
 
 #ifdef CONFIG_NX_RAMBACKED
           be->plane[i].pwfb.setpixel      = pwfb_setpixel_1bpp;
@@ -234,6 +234,17 @@ void nxbe_fill(FAR struct nxbe_window_s *wnd,
       if (NXBE_ISRAMBACKED(wnd))
         {
           nxbe_fill_pwfb(wnd, &remaining, color);
+
+#ifdef CONFIG_NX_COMPOSITOR
+          /* The compositor will update the device on the next frame */
+
+          if (!NXBE_ISHIDDEN(wnd))
+            {
+              nxbe_damage(wnd->be, &remaining);
+            }
+
+          return;
+#endif
         }
 #endif
 
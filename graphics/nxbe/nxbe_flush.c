@@ -90,10 +90,23 @@ void nxbe_flush(FAR struct nxbe_window_s *wnd,
                 FAR const struct nxgl_point_s *origin,
                 unsigned int stride)
 {
+#ifdef CONFIG_NX_COMPOSITOR
+  struct nxgl_rect_s bounds;
+#endif
+
   /* Don't update hidden windows */
 
   if (!NXBE_ISHIDDEN(wnd))
     {
+#ifdef CONFIG_NX_COMPOSITOR
+      /* The compositor will copy the modified region to device memory on
+       * the next frame.
+       */
+
+      nxgl_rectoffset(&bounds, dest, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+      nxgl_rectintersect(&bounds, &bounds, &wnd->bounds);
+      nxbe_damage(wnd->be, &bounds);
+#else
       /* Copy the modified per-window framebuffer into device memory. */
 
       nxbe_bitmap_dev(wnd, dest, src, origin, stride);
@@ -105,6 +118,7 @@ void nxbe_flush(FAR struct nxbe_window_s *wnd,
 
       nxbe_cursor_backupdraw_all(wnd, dest);
 #endif
+#endif /* CONFIG_NX_COMPOSITOR */
     }
 }
 
@@ -64,8 +64,25 @@ void nxbe_redrawbelow(FAR struct nxbe_state_s *be, FAR struct nxbe_window_s *wnd
 {
   FAR struct nxbe_window_s *currwnd;
 
+#ifdef CONFIG_NX_COMPOSITOR
+  /* RAM-backed windows are refreshed by the compositor in a single pass on
+   * the next frame.  Only windows without a per-window framebuffer need to
+   * be asked to redraw the exposed region.
+   */
+
+  nxbe_damage(be, rect);
+
+  for (currwnd = wnd; currwnd; currwnd = currwnd->below)
+    {
+      if (!NXBE_ISRAMBACKED(currwnd))
+        {
+          nxbe_redraw(be, currwnd, rect);
+        }
+    }
+#else
   for (currwnd = wnd; currwnd; currwnd = currwnd->below)
     {
       nxbe_redraw(be, currwnd, rect);
     }
+#endif
 }
@@ -0,0 +1,157 @@
+/****************************************************************************
+ * graphics/nxglib/fb/nxglib_blendbitmap.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/video/fb.h>
+#include <nuttx/nx/nxglib.h>
+
+#include "nxglib_bitblit.h"
+#include "nxglib.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef NXGLIB_SUFFIX
+#  error "NXGLIB_SUFFIX must be defined before including this header file"
+#endif
+
+#if NXGLIB_BITSPERPIXEL < 16
+#  error "Alpha blending requires an RGB pixel format"
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_blendrun
+ *
+ * Description:
+ *   Blend one row of bitmap pixels over one row of framebuffer pixels.
+ *
+ ****************************************************************************/
+
+static inline void nxgl_blendrun(FAR uint8_t *dest, FAR const uint8_t *src,
+                                 uint32_t alpha, unsigned int npixels)
+{
+#if NXGLIB_BITSPERPIXEL == 16
+  FAR const uint16_t *sptr = (FAR const uint16_t *)src;
+  FAR uint16_t *dptr = (FAR uint16_t *)dest;
+
+  while (npixels-- > 0)
+    {
+      *dptr = nxgl_alpha_rgb565(*sptr++, *dptr, alpha);
+      dptr++;
+    }
+
+#elif NXGLIB_BITSPERPIXEL == 24
+  uint32_t fg;
+  uint32_t bg;
+
+  while (npixels-- > 0)
+    {
+      fg      = (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+                ((uint32_t)src[2] << 16);
+      bg      = (uint32_t)dest[0] | ((uint32_t)dest[1] << 8) |
+                ((uint32_t)dest[2] << 16);
+      bg      = nxgl_alpha_rgb24(fg, bg, alpha);
+      *dest++ = bg;
+      *dest++ = bg >> 8;
+      *dest++ = bg >> 16;
+      src    += 3;
+    }
+
+#else
+  FAR const uint32_t *sptr = (FAR const uint32_t *)src;
+  FAR uint32_t *dptr = (FAR uint32_t *)dest;
+
+  while (npixels-- > 0)
+    {
+      *dptr = nxgl_alpha_rgb24(*sptr++, *dptr, alpha);
+      dptr++;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_blendbitmap_*bpp
+ *
+ * Description:
+ *   Blend a rectangular bitmap image with the given opacity (0-255) into
+ *   the specific position in the framebuffer memory.  The bitmap must have
+ *   the same pixel format as the framebuffer.  An opaque bitmap reduces to
+ *   nxgl_copyrectangle_*bpp().
+ *
+ ****************************************************************************/
+
+void NXGL_FUNCNAME(nxgl_blendbitmap, NXGLIB_SUFFIX)
+  (FAR struct fb_planeinfo_s *pinfo,
+   FAR const struct nxgl_rect_s *dest,
+   FAR const void *src, FAR const struct nxgl_point_s *origin,
+   unsigned int srcstride, uint8_t alpha)
+{
+  FAR const uint8_t *sline;
+  FAR uint8_t *dline;
+  unsigned int width;
+  unsigned int deststride;
+  uint32_t alpha256;
+  int rows;
+
+  if (alpha == 0)
+    {
+      return;
+    }
+  else if (alpha == 255)
+    {
+      NXGL_FUNCNAME(nxgl_copyrectangle, NXGLIB_SUFFIX)
+        (pinfo, dest, src, origin, srcstride);
+      return;
+    }
+
+  deststride = pinfo->stride;
+  width      = dest->pt2.x - dest->pt1.x + 1;
+  rows       = dest->pt2.y - dest->pt1.y + 1;
+  alpha256   = NXGL_ALPHA256(alpha);
+
+  sline      = (FAR const uint8_t *)src +
+               NXGL_SCALEX(dest->pt1.x - origin->x) +
+               (dest->pt1.y - origin->y) * srcstride;
+  dline      = pinfo->fbmem + dest->pt1.y * deststride +
+               NXGL_SCALEX(dest->pt1.x);
+
+  while (rows-- > 0)
+    {
+      nxgl_blendrun(dline, sline, alpha256, width);
+      dline += deststride;
+      sline += srcstride;
+    }
+}
@@ -0,0 +1,142 @@
+/****************************************************************************
+ * graphics/nxglib/fb/nxglib_blendrectangle.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/video/fb.h>
+#include <nuttx/nx/nxglib.h>
+
+#include "nxglib_bitblit.h"
+#include "nxglib.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef NXGLIB_SUFFIX
+#  error "NXGLIB_SUFFIX must be defined before including this header file"
+#endif
+
+#if NXGLIB_BITSPERPIXEL < 16
+#  error "Alpha blending requires an RGB pixel format"
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_blendrun
+ *
+ * Description:
+ *   Blend a fixed color over one row of framebuffer pixels.
+ *
+ ****************************************************************************/
+
+static inline void nxgl_blendrun(FAR uint8_t *dest, NXGL_PIXEL_T color,
+                                 uint32_t alpha, unsigned int npixels)
+{
+#if NXGLIB_BITSPERPIXEL == 16
+  FAR uint16_t *ptr = (FAR uint16_t *)dest;
+
+  while (npixels-- > 0)
+    {
+      *ptr = nxgl_alpha_rgb565(color, *ptr, alpha);
+      ptr++;
+    }
+
+#elif NXGLIB_BITSPERPIXEL == 24
+  uint32_t pixel;
+
+  while (npixels-- > 0)
+    {
+      pixel   = (uint32_t)dest[0] | ((uint32_t)dest[1] << 8) |
+                ((uint32_t)dest[2] << 16);
+      pixel   = nxgl_alpha_rgb24(color, pixel, alpha);
+      *dest++ = pixel;
+      *dest++ = pixel >> 8;
+      *dest++ = pixel >> 16;
+    }
+
+#else
+  FAR uint32_t *ptr = (FAR uint32_t *)dest;
+
+  while (npixels-- > 0)
+    {
+      *ptr = nxgl_alpha_rgb24(color, *ptr, alpha);
+      ptr++;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_blendrectangle_*bpp
+ *
+ * Description:
+ *   Blend a fixed color with the given opacity (0-255) over a rectangular
+ *   region of the framebuffer memory.  An opaque color reduces to
+ *   nxgl_fillrectangle_*bpp().
+ *
+ ****************************************************************************/
+
+void NXGL_FUNCNAME(nxgl_blendrectangle, NXGLIB_SUFFIX)
+  (FAR struct fb_planeinfo_s *pinfo,
+   FAR const struct nxgl_rect_s *rect,
+   NXGL_PIXEL_T color, uint8_t alpha)
+{
+  FAR uint8_t *line;
+  unsigned int width;
+  unsigned int stride;
+  uint32_t alpha256;
+  int rows;
+
+  if (alpha == 0)
+    {
+      return;
+    }
+  else if (alpha == 255)
+    {
+      NXGL_FUNCNAME(nxgl_fillrectangle, NXGLIB_SUFFIX)(pinfo, rect, color);
+      return;
+    }
+
+  stride   = pinfo->stride;
+  width    = rect->pt2.x - rect->pt1.x + 1;
+  rows     = rect->pt2.y - rect->pt1.y + 1;
+  alpha256 = NXGL_ALPHA256(alpha);
+
+  line     = pinfo->fbmem + rect->pt1.y * stride + NXGL_SCALEX(rect->pt1.x);
+
+  while (rows-- > 0)
+    {
+      nxgl_blendrun(line, color, alpha256, width);
+      line += stride;
+    }
+}
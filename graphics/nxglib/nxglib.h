@@ -453,6 +453,52 @@ void pwfb_copyrectangle_32bpp(FAR struct nxbe_window_s *bwnd,
                               unsigned int srcstride);
 #endif
 
+#ifdef CONFIG_NX_ALPHABLEND
+/****************************************************************************
+ * Name: nxgl_blendrectangle_*bpp
+ *
+ * Description:
+ *   Blend a fixed color with the given opacity (0-255) over a rectangular
+ *   region of the graphics memory.
+ *
+ ****************************************************************************/
+
+void nxgl_blendrectangle_16bpp(FAR NX_PLANEINFOTYPE *pinfo,
+                               FAR const struct nxgl_rect_s *rect,
+                               uint16_t color, uint8_t alpha);
+void nxgl_blendrectangle_24bpp(FAR NX_PLANEINFOTYPE *pinfo,
+                               FAR const struct nxgl_rect_s *rect,
+                               uint32_t color, uint8_t alpha);
+void nxgl_blendrectangle_32bpp(FAR NX_PLANEINFOTYPE *pinfo,
+                               FAR const struct nxgl_rect_s *rect,
+                               uint32_t color, uint8_t alpha);
+
+/****************************************************************************
+ * Name: nxgl_blendbitmap_*bpp
+ *
+ * Description:
+ *   Blend a rectangular bitmap image with the given opacity (0-255) into
+ *   the specific position in the graphics memory.
+ *
+ ****************************************************************************/
+
+void nxgl_blendbitmap_16bpp(FAR NX_PLANEINFOTYPE *pinfo,
+                            FAR const struct nxgl_rect_s *dest,
+                            FAR const void *src,
+                            FAR const struct nxgl_point_s *origin,
+                            unsigned int srcstride, uint8_t alpha);
+void nxgl_blendbitmap_24bpp(FAR NX_PLANEINFOTYPE *pinfo,
+                            FAR const struct nxgl_rect_s *dest,
+                            FAR const void *src,
+                            FAR const struct nxgl_point_s *origin,
+                            unsigned int srcstride, uint8_t alpha);
+void nxgl_blendbitmap_32bpp(FAR NX_PLANEINFOTYPE *pinfo,
+                            FAR const struct nxgl_rect_s *dest,
+                            FAR const void *src,
+                            FAR const struct nxgl_point_s *origin,
+                            unsigned int srcstride, uint8_t alpha);
+#endif
+
 /****************************************************************************
  * Name: nxgl_cursor_draw_*bpp
  *
@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -120,55 +121,39 @@
 #  define NXGL_ALIGNDOWN(x)        ((x) & ~NXGL_PIXELMASK)
 #  define NXGL_ALIGNUP(x)          (((x) + NXGL_PIXELMASK) & ~NXGL_PIXELMASK)
 
-#  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr = (FAR uint8_t*)(dest); \
-     int        _nby = NXGL_SCALEX(width); \
-     while (_nby--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+#endif
 
-#  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     int        _nby  = NXGL_SCALEX(width); \
-     while (_nby--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+/* Row fill and copy operations.  Fills of 8-bit and smaller pixels reduce
+ * to a byte memset().  Wider pixels are replicated across a native machine
+ * word by the nxgl_wide_memset*() helpers below so that the bulk of each
+ * row is written one word at a time.  Copies are always byte copies of the
+ * scaled row width and so are left to the (possibly architecture-optimized)
+ * C library memcpy() and memmove().  NXGL_MEMMOVE must be used whenever the
+ * source and destination rows may overlap.
+ */
 
+#if NXGLIB_BITSPERPIXEL <= 8
+#  define NXGL_MEMSET(dest,value,width) \
+     memset((dest), (value), NXGL_SCALEX(width))
+#elif NXGLIB_BITSPERPIXEL == 16
+#  define NXGL_MEMSET(dest,value,width) \
+     nxgl_wide_memset16((FAR uint8_t *)(dest), (value), (width))
 #elif NXGLIB_BITSPERPIXEL == 24
-
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR uint8_t *_ptr  = (FAR uint8_t*)(dest); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-         *_ptr++ = (value) >> 8; \
-         *_ptr++ = (value) >> 16; \
-       } \
-   }
+     nxgl_wide_memset24((FAR uint8_t *)(dest), (value), (width))
+#else
+#  define NXGL_MEMSET(dest,value,width) \
+     nxgl_wide_memset32((FAR uint8_t *)(dest), (value), (width))
+#endif
 
-#  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR uint8_t *_dptr = (FAR uint8_t*)(dest); \
-     FAR uint8_t *_sptr = (FAR uint8_t*)(src); \
-     nxgl_coord_t _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+#define NXGL_MEMCPY(dest,src,width) \
+   memcpy((dest), (src), NXGL_SCALEX(width))
+
+#define NXGL_MEMMOVE(dest,src,width) \
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #ifdef CONFIG_NX_ANTIALIASING
+#if NXGLIB_BITSPERPIXEL == 24
 
 #  define NXGL_BLEND(dest,color1,frac) \
    { \
@@ -184,31 +169,7 @@
      *_dptr++ =  blend        & 0xff; \
    }
 
-#endif /* CONFIG_NX_ANTIALIASING */
-#else /* NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32 */
-
-#  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR NXGL_PIXEL_T *_ptr = (FAR NXGL_PIXEL_T*)(dest); \
-     nxgl_coord_t     _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
-
-#  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR NXGL_PIXEL_T *_dptr = (FAR NXGL_PIXEL_T*)(dest); \
-     FAR NXGL_PIXEL_T *_sptr = (FAR NXGL_PIXEL_T*)(src); \
-     nxgl_coord_t      _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
-
-#ifdef CONFIG_NX_ANTIALIASING
+#elif NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32
 
 #  define NXGL_BLEND(dest,color1,frac) \
    { \
@@ -217,14 +178,245 @@
      *_dptr = NXGL_BLENDER(color1, color2, frac); \
    }
 
-#endif /* CONFIG_NX_ANTIALIASING */
 #endif /* NXGLIB_BITSPERPIXEL */
+#endif /* CONFIG_NX_ANTIALIASING */
+
+/* The native word used by the wide fill operations and the mask used to
+ * test for alignment to that word.
+ */
+
+#define NXGL_WORD_T                uintptr_t
+#define NXGL_WORDSIZE              sizeof(uintptr_t)
+#define NXGL_WORDMASK              (sizeof(uintptr_t) - 1)
+
+/* Replicate an 8-, 16- or 32-bit value across every lane of a native
+ * word.  UINTPTR_MAX / 0xffff, for example, is 0x00010001 on a 32-bit
+ * machine and 0x0001000100010001 on a 64-bit machine.
+ */
+
+#define NXGL_WIDE16(p)             ((NXGL_WORD_T)(uint16_t)(p) * \
+                                    (UINTPTR_MAX / 0xffff))
+#define NXGL_WIDE32(p)             ((NXGL_WORD_T)(uint32_t)(p) * \
+                                    (UINTPTR_MAX / 0xffffffff))
+
+/* Convert an 8-bit alpha value (0-255) to the 0-256 range used by the
+ * blend helpers so that 255 is fully opaque.
+ */
+
+#define NXGL_ALPHA256(a)           ((uint32_t)(a) + ((uint32_t)(a) >> 7))
 
 /* Form a function name by concatenating two strings */
 
 #define _NXGL_FUNCNAME(a,b) a ## b
 #define NXGL_FUNCNAME(a,b)  _NXGL_FUNCNAME(a,b)
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_wide_memset16
+ *
+ * Description:
+ *   Fill a run of 16-bit pixels.  The destination is first brought to
+ *   native word alignment one pixel at a time; the bulk of the run is then
+ *   written with word-wide stores, four words per iteration.
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL == 16
+static inline void nxgl_wide_memset16(FAR uint8_t *dest, uint16_t color,
+                                      size_t npixels)
+{
+  FAR uint16_t *ptr = (FAR uint16_t *)dest;
+  FAR NXGL_WORD_T *wptr;
+  NXGL_WORD_T wide;
+
+  while (npixels > 0 && ((uintptr_t)ptr & NXGL_WORDMASK) != 0)
+    {
+      *ptr++ = color;
+      npixels--;
+    }
+
+  wide = NXGL_WIDE16(color);
+  wptr = (FAR NXGL_WORD_T *)ptr;
+
+  while (npixels >= 4 * (NXGL_WORDSIZE / 2))
+    {
+      wptr[0]  = wide;
+      wptr[1]  = wide;
+      wptr[2]  = wide;
+      wptr[3]  = wide;
+      wptr    += 4;
+      npixels -= 4 * (NXGL_WORDSIZE / 2);
+    }
+
+  while (npixels >= NXGL_WORDSIZE / 2)
+    {
+      *wptr++  = wide;
+      npixels -= NXGL_WORDSIZE / 2;
+    }
+
+  ptr = (FAR uint16_t *)wptr;
+  while (npixels-- > 0)
+    {
+      *ptr++ = color;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxgl_wide_memset24
+ *
+ * Description:
+ *   Fill a run of packed 24-bit pixels.  Four pixels occupy exactly three
+ *   32-bit words so, once the destination is 32-bit aligned, the run is
+ *   written as a repeating pattern of three words.  The pattern is built
+ *   in memory so that the result is independent of the CPU byte order.
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL == 24
+static inline void nxgl_wide_memset24(FAR uint8_t *dest, uint32_t color,
+                                      size_t npixels)
+{
+  FAR uint32_t *wptr;
+  uint32_t pattern[3];
+  FAR uint8_t *pptr;
+  int i;
+
+  while (npixels > 0 && ((uintptr_t)dest & 3) != 0)
+    {
+      *dest++ = color;
+      *dest++ = color >> 8;
+      *dest++ = color >> 16;
+      npixels--;
+    }
+
+  pptr = (FAR uint8_t *)pattern;
+  for (i = 0; i < 4; i++)
+    {
+      *pptr++ = color;
+      *pptr++ = color >> 8;
+      *pptr++ = color >> 16;
+    }
+
+  wptr = (FAR uint32_t *)dest;
+  while (npixels >= 4)
+    {
+      wptr[0]  = pattern[0];
+      wptr[1]  = pattern[1];
+      wptr[2]  = pattern[2];
+      wptr    += 3;
+      npixels -= 4;
+    }
+
+  dest = (FAR uint8_t *)wptr;
+  while (npixels-- > 0)
+    {
+      *dest++ = color;
+      *dest++ = color >> 8;
+      *dest++ = color >> 16;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxgl_wide_memset32
+ *
+ * Description:
+ *   Fill a run of 32-bit pixels using word-wide stores.  This is also used
+ *   for the unpacked, 32-bit runs of 24-bit pixels used with LCD devices.
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL >= 24
+static inline void nxgl_wide_memset32(FAR uint8_t *dest, uint32_t color,
+                                      size_t npixels)
+{
+  FAR uint32_t *ptr = (FAR uint32_t *)dest;
+  FAR NXGL_WORD_T *wptr;
+  NXGL_WORD_T wide;
+
+  while (npixels > 0 && ((uintptr_t)ptr & NXGL_WORDMASK) != 0)
+    {
+      *ptr++ = color;
+      npixels--;
+    }
+
+  wide = NXGL_WIDE32(color);
+  wptr = (FAR NXGL_WORD_T *)ptr;
+
+  while (npixels >= 4 * (NXGL_WORDSIZE / 4))
+    {
+      wptr[0]  = wide;
+      wptr[1]  = wide;
+      wptr[2]  = wide;
+      wptr[3]  = wide;
+      wptr    += 4;
+      npixels -= 4 * (NXGL_WORDSIZE / 4);
+    }
+
+  ptr = (FAR uint32_t *)wptr;
+  while (npixels-- > 0)
+    {
+      *ptr++ = color;
+    }
+}
+#endif
+
+#ifdef CONFIG_NX_ALPHABLEND
+/****************************************************************************
+ * Name: nxgl_alpha_rgb565 / nxgl_alpha_rgb24
+ *
+ * Description:
+ *   Blend color1 over color2 with the given opacity.  Color components are
+ *   spread out in a 32-bit word so that all three are scaled with two
+ *   multiplications rather than one per component.
+ *
+ * Input Parameters:
+ *   color1 - The foreground color
+ *   color2 - The background color
+ *   alpha  - Foreground opacity in the range 0 (transparent) through 256
+ *            (opaque).  See NXGL_ALPHA256().
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL == 16
+static inline uint16_t nxgl_alpha_rgb565(uint16_t color1, uint16_t color2,
+                                         uint32_t alpha)
+{
+  /* RGB565 spread as -----GGGGGG-----RRRRR------BBBBB leaves enough guard
+   * bits between components for a 5-bit multiply.
+   */
+
+  uint32_t a5  = (alpha + 4) >> 3;
+  uint32_t fg  = ((uint32_t)color1 | ((uint32_t)color1 << 16)) & 0x07e0f81f;
+  uint32_t bg  = ((uint32_t)color2 | ((uint32_t)color2 << 16)) & 0x07e0f81f;
+  uint32_t mix = ((fg * a5 + bg * (32 - a5)) >> 5) & 0x07e0f81f;
+
+  return (uint16_t)(mix | (mix >> 16));
+}
+#elif NXGLIB_BITSPERPIXEL >= 24
+static inline uint32_t nxgl_alpha_rgb24(uint32_t color1, uint32_t color2,
+                                        uint32_t alpha)
+{
+  uint32_t inv = 256 - alpha;
+  uint32_t rb;
+  uint32_t g;
+
+  rb = (((color1 & 0x00ff00ff) * alpha +
+         (color2 & 0x00ff00ff) * inv) >> 8) & 0x00ff00ff;
+  g  = (((color1 & 0x0000ff00) * alpha +
+         (color2 & 0x0000ff00) * inv) >> 8) & 0x0000ff00;
+
+  /* Any bits above the RGB components are left unchanged */
+
+  return (color2 & 0xff000000) | rb | g;
+}
+#endif
+#endif /* CONFIG_NX_ALPHABLEND */
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -94,7 +94,7 @@ static inline void pwfb_lowresmemcpy(FAR uint8_t *dline,
 
    if (lnlen > 0)
      {
-       NXGL_MEMCPY(dptr, sptr, lnlen);
+       NXGL_MEMMOVE(dptr, sptr, lnlen);
      }
 }
 #endif
@@ -193,7 +193,7 @@ void NXGL_FUNCNAME(pwfb_moverectangle,NXGLIB_SUFFIX)
 #if NXGLIB_BITSPERPIXEL < 8
           pwfb_lowresmemcpy(dline, sline, width, leadmask, tailmask);
 #else
-          NXGL_MEMCPY(dline, sline, width);
+          NXGL_MEMMOVE(dline, sline, width);
 #endif
           /* Point to the next source/dest row below the current one */
 
@@ -232,7 +232,7 @@ void NXGL_FUNCNAME(pwfb_moverectangle,NXGLIB_SUFFIX)
 #if NXGLIB_BITSPERPIXEL < 8
           pwfb_lowresmemcpy(dline, sline, width, leadmask, tailmask);
 #else
-          NXGL_MEMCPY(dline, sline, width);
+          NXGL_MEMMOVE(dline, sline, width);
 #endif
         }
     }
@@ -48,11 +48,25 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/mqueue.h>
+#include <nuttx/signal.h>
 #include <nuttx/nx/nx.h>
 
 #include "nxmu.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_COMPOSITOR
+#  ifndef CONFIG_NX_COMPOSITOR_FRAMEMS
+#    define CONFIG_NX_COMPOSITOR_FRAMEMS 16
+#  endif
+
+#  define NXMU_FRAMETICKS MSEC2TICK(CONFIG_NX_COMPOSITOR_FRAMEMS)
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -159,6 +173,52 @@ static void nxmu_event(FAR struct nxbe_window_s *wnd, enum nx_event_e event,
     }
 }
 
+/****************************************************************************
+ * Name: nxmu_composite
+ *
+ * Description:
+ *   Run the compositor if any part of the display is damaged.  Messages
+ *   that are already queued are processed first so that all of their
+ *   updates land in the same frame, but no more than one frame period may
+ *   pass before the display is refreshed.  If the driver cannot wait for
+ *   vertical sync, frames are paced to CONFIG_NX_COMPOSITOR_FRAMEMS.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_COMPOSITOR
+static void nxmu_composite(FAR struct nxmu_state_s *nxmu)
+{
+  FAR struct nxbe_state_s *be = &nxmu->be;
+  struct mq_attr attr;
+  clock_t elapsed;
+
+  if (!NXBE_ISDAMAGED(be))
+    {
+      return;
+    }
+
+  elapsed = clock_systime_ticks() - be->frametime;
+  if (elapsed < NXMU_FRAMETICKS)
+    {
+      /* Keep batching while there are more messages to process */
+
+      if (mq_getattr(nxmu->conn.crdmq, &attr) == OK && attr.mq_curmsgs > 0)
+        {
+          return;
+        }
+
+#ifdef NXBE_HAVE_VSYNC
+      if (be->dev->waitforvsync == NULL)
+#endif
+        {
+          nxsig_usleep(TICK2USEC(NXMU_FRAMETICKS - elapsed));
+        }
+    }
+
+  nxbe_composite(be);
+}
+#endif
+
 /****************************************************************************
  * Name: nxmu_setup
  ****************************************************************************/
@@ -308,6 +368,12 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
 
   for (; ; )
     {
+#ifdef CONFIG_NX_COMPOSITOR
+       /* Refresh any damaged regions of the display */
+
+       nxmu_composite(&nxmu);
+
+#endif
        /* Receive the next server message */
 
        nbytes = nxmq_receive(nxmu.conn.crdmq, buffer, NX_MXSVRMSGLEN, 0);
@@ -513,6 +579,27 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
            }
            break;
 
+#ifdef CONFIG_NX_ALPHABLEND
+         case NX_SVRMSG_BLENDRECT: /* Blend a color over a rectangle in the window */
+           {
+             FAR struct nxsvrmsg_blendrect_s *blendmsg = (FAR struct nxsvrmsg_blendrect_s *)buffer;
+             nxbe_blendrectangle(blendmsg->wnd, &blendmsg->rect, blendmsg->color, blendmsg->alpha);
+           }
+           break;
+
+         case NX_SVRMSG_BLENDBITMAP: /* Blend a rectangular bitmap into the window */
+           {
+             FAR struct nxsvrmsg_blendbitmap_s *bmpmsg = (FAR struct nxsvrmsg_blendbitmap_s *)buffer;
+             nxbe_blendbitmap(bmpmsg->wnd, &bmpmsg->dest, bmpmsg->src, &bmpmsg->origin, bmpmsg->stride, bmpmsg->alpha);
+
+             if (bmpmsg->sem_done)
+              {
+                nxsem_post(bmpmsg->sem_done);
+              }
+           }
+           break;
+#endif
+
          case NX_SVRMSG_SETBGCOLOR: /* Set the color of the background */
            {
              FAR struct nxsvrmsg_setbgcolor_s *bgcolormsg =
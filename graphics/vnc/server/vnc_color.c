@@ -45,6 +45,40 @@
 
 #include "vnc_server.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_wide_rgbNN
+ *
+ * Description:
+ *  Wrappers that return the result of the vnc_convert_rgbNN() functions
+ *  as a 32-bit value so that they may all be called through the same
+ *  function pointer type.
+ *
+ ****************************************************************************/
+
+static uint32_t vnc_wide_rgb8_222(lfb_color_t rgb)
+{
+  return vnc_convert_rgb8_222(rgb);
+}
+
+static uint32_t vnc_wide_rgb8_332(lfb_color_t rgb)
+{
+  return vnc_convert_rgb8_332(rgb);
+}
+
+static uint32_t vnc_wide_rgb16_555(lfb_color_t rgb)
+{
+  return vnc_convert_rgb16_555(rgb);
+}
+
+static uint32_t vnc_wide_rgb16_565(lfb_color_t rgb)
+{
+  return vnc_convert_rgb16_565(rgb);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -416,3 +450,121 @@ int vnc_colors(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect,
 
   return ncolors;
 }
+
+/****************************************************************************
+ * Name: vnc_convert_select
+ *
+ * Description:
+ *  Return a color conversion function that converts from the local
+ *  framebuffer color format to the remote framebuffer color format,
+ *  returning the result as a 32-bit value of any remote pixel width.
+ *
+ * Input Parameters:
+ *   colorfmt - The remote color format
+ *
+ * Returned Value:
+ *   The conversion function or NULL if the color format is not supported.
+ *
+ ****************************************************************************/
+
+vnc_convert_t vnc_convert_select(uint8_t colorfmt)
+{
+  switch (colorfmt)
+    {
+      case FB_FMT_RGB8_222:
+        return vnc_wide_rgb8_222;
+
+      case FB_FMT_RGB8_332:
+        return vnc_wide_rgb8_332;
+
+      case FB_FMT_RGB16_555:
+        return vnc_wide_rgb16_555;
+
+      case FB_FMT_RGB16_565:
+        return vnc_wide_rgb16_565;
+
+      case FB_FMT_RGB32:
+        return vnc_convert_rgb32_888;
+
+      default:
+        return NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: vnc_put_pixel
+ *
+ * Description:
+ *  Store one remote pixel in the byte order expected by the client.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   dest    - The location to store the pixel
+ *   pixel   - The pixel in the remote color format
+ *   nbytes  - The size of the pixel in bytes (1, 2, 3 or 4).  A size of 3
+ *             selects the compressed 24-bit pixel (CPIXEL) of ZRLE.
+ *
+ * Returned Value:
+ *   A pointer to the byte following the stored pixel.
+ *
+ ****************************************************************************/
+
+FAR uint8_t *vnc_put_pixel(FAR struct vnc_session_s *session,
+                           FAR uint8_t *dest, uint32_t pixel,
+                           unsigned int nbytes)
+{
+  switch (nbytes)
+    {
+      case 1:
+        *dest++ = (uint8_t)pixel;
+        break;
+
+      case 2:
+        if (session->bigendian)
+          {
+            rfb_putbe16(dest, (uint16_t)pixel);
+          }
+        else
+          {
+            rfb_putle16(dest, (uint16_t)pixel);
+          }
+
+        dest += 2;
+        break;
+
+      case 3:
+
+        /* The 24 least significant bits of the pixel in the remote byte
+         * order.
+         */
+
+        if (session->bigendian)
+          {
+            *dest++ = (uint8_t)(pixel >> 16);
+            *dest++ = (uint8_t)(pixel >> 8);
+            *dest++ = (uint8_t)pixel;
+          }
+        else
+          {
+            *dest++ = (uint8_t)pixel;
+            *dest++ = (uint8_t)(pixel >> 8);
+            *dest++ = (uint8_t)(pixel >> 16);
+          }
+        break;
+
+      default:
+        if (session->bigendian)
+          {
+            rfb_putbe32(dest, pixel);
+          }
+        else
+          {
+            rfb_putle32(dest, pixel);
+          }
+
+        dest += 4;
+        break;
+    }
+
+  return dest;
+}
@@ -0,0 +1,413 @@
+/****************************************************************************
+ * graphics/vnc/server/vnc_hextile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  undef  CONFIG_DEBUG_GRAPHICS_ERROR
+#  undef  CONFIG_DEBUG_GRAPHICS_WARN
+#  undef  CONFIG_DEBUG_GRAPHICS_INFO
+#  define CONFIG_DEBUG_ERROR          1
+#  define CONFIG_DEBUG_WARN           1
+#  define CONFIG_DEBUG_INFO           1
+#  define CONFIG_DEBUG_GRAPHICS       1
+#  define CONFIG_DEBUG_GRAPHICS_ERROR 1
+#  define CONFIG_DEBUG_GRAPHICS_WARN  1
+#  define CONFIG_DEBUG_GRAPHICS_INFO  1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Background and foreground colors carried over from the previous tile */
+
+struct hextile_state_s
+{
+  uint32_t bg;                 /* Last background color */
+  uint32_t fg;                 /* Last foreground color */
+  bool bgvalid;                /* True: bg may be carried over */
+  bool fgvalid;                /* True: fg may be carried over */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile_load
+ *
+ * Description:
+ *  Convert the pixels of one tile from the local framebuffer into
+ *  session->tile[].
+ *
+ ****************************************************************************/
+
+static void vnc_hextile_load(FAR struct vnc_session_s *session,
+                             vnc_convert_t convert,
+                             nxgl_coord_t x, nxgl_coord_t y,
+                             nxgl_coord_t width, nxgl_coord_t height)
+{
+  FAR const lfb_color_t *src;
+  FAR uint32_t *dest = session->tile;
+  nxgl_coord_t col;
+  nxgl_coord_t row;
+
+  for (row = 0; row < height; row++)
+    {
+      src = (FAR const lfb_color_t *)
+        (session->fb + RFB_STRIDE * (y + row) + RFB_BYTESPERPIXEL * x);
+
+      for (col = 0; col < width; col++)
+        {
+          *dest++ = convert(*src++);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_tile
+ *
+ * Description:
+ *  Encode one tile.  Single color tiles are sent as a background color
+ *  only; two color tiles as foreground sub-rectangles; other tiles as
+ *  colored sub-rectangles.  Raw encoding is used if the sub-rectangles
+ *  would not be smaller than the raw pixel data.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   state   - Colors carried over from the previous tile
+ *   bpp     - Remote bytes per pixel
+ *   width, height - The size of the tile (already in session->tile[])
+ *   dest    - The location to store the encoded tile
+ *
+ * Returned Value:
+ *   The size of the encoded tile in bytes.
+ *
+ ****************************************************************************/
+
+static size_t vnc_hextile_tile(FAR struct vnc_session_s *session,
+                               FAR struct hextile_state_s *state,
+                               unsigned int bpp,
+                               nxgl_coord_t width, nxgl_coord_t height,
+                               FAR uint8_t *dest)
+{
+  FAR const uint32_t *tile = session->tile;
+  FAR uint8_t *start = dest;
+  FAR uint8_t *limit;
+  FAR uint8_t *subenc;
+  FAR uint8_t *nsubrects;
+  uint16_t done[VNC_TILE_SIZE];
+  uint32_t colors[2];
+  uint32_t pixel;
+  uint32_t bg;
+  uint32_t fg = 0;
+  unsigned int counts[2];
+  unsigned int ncolors;
+  unsigned int npixels;
+  unsigned int nrects;
+  unsigned int i;
+  nxgl_coord_t row;
+  nxgl_coord_t col;
+  nxgl_coord_t w;
+  nxgl_coord_t h;
+  uint16_t mask;
+  uint8_t flags;
+
+  /* Count the colors in the tile, stopping after the third one */
+
+  npixels   = width * height;
+  colors[0] = tile[0];
+  counts[0] = 0;
+  counts[1] = 0;
+  ncolors   = 1;
+
+  for (i = 0; i < npixels && ncolors < 3; i++)
+    {
+      pixel = tile[i];
+      if (pixel == colors[0])
+        {
+          counts[0]++;
+        }
+      else if (ncolors == 1)
+        {
+          colors[1] = pixel;
+          counts[1] = 1;
+          ncolors   = 2;
+        }
+      else if (pixel == colors[1])
+        {
+          counts[1]++;
+        }
+      else
+        {
+          ncolors = 3;
+        }
+    }
+
+  /* The most frequent of the two colors is the background */
+
+  if (ncolors == 2 && counts[1] > counts[0])
+    {
+      bg = colors[1];
+      fg = colors[0];
+    }
+  else
+    {
+      bg = colors[0];
+      fg = colors[1];
+    }
+
+  subenc = dest++;
+  flags  = 0;
+
+  if (!state->bgvalid || state->bg != bg)
+    {
+      flags         |= RFB_SUBENCODING_BACK;
+      dest           = vnc_put_pixel(session, dest, bg, bpp);
+      state->bg      = bg;
+      state->bgvalid = true;
+    }
+
+  if (ncolors == 1)
+    {
+      /* Solid tile.  The background says it all. */
+
+      *subenc = flags;
+      return dest - start;
+    }
+
+  flags |= RFB_SUBENCODING_ANY;
+  if (ncolors == 2)
+    {
+      if (!state->fgvalid || state->fg != fg)
+        {
+          flags         |= RFB_SUBENCODING_FORE;
+          dest           = vnc_put_pixel(session, dest, fg, bpp);
+          state->fg      = fg;
+          state->fgvalid = true;
+        }
+    }
+  else
+    {
+      flags         |= RFB_SUBENCODING_COLORED;
+      state->fgvalid = false;
+    }
+
+  /* Extract sub-rectangles:  Extend each non-background pixel not yet
+   * covered to the right and then down as far as the color matches.
+   * Give up as soon as the result would not be smaller than raw data.
+   */
+
+  nsubrects = dest++;
+  nrects    = 0;
+  limit     = start + 1 + npixels * bpp;
+  memset(done, 0, sizeof(done));
+
+  for (row = 0; row < height; row++)
+    {
+      for (col = 0; col < width; col++)
+        {
+          pixel = tile[row * width + col];
+          if (pixel == bg || (done[row] & (1 << col)) != 0)
+            {
+              continue;
+            }
+
+          for (w = 1;
+               col + w < width &&
+               tile[row * width + col + w] == pixel &&
+               (done[row] & (1 << (col + w))) == 0;
+               w++)
+            {
+            }
+
+          mask = (uint16_t)(((1 << w) - 1) << col);
+          for (h = 1; row + h < height; h++)
+            {
+              for (i = col; i < col + w; i++)
+                {
+                  if (tile[(row + h) * width + i] != pixel)
+                    {
+                      break;
+                    }
+                }
+
+              if (i < col + w || (done[row + h] & mask) != 0)
+                {
+                  break;
+                }
+            }
+
+          for (i = row; i < row + h; i++)
+            {
+              done[i] |= mask;
+            }
+
+          if (nrects >= 255 ||
+              dest + 2 + (ncolors > 2 ? bpp : 0) >= limit)
+            {
+              goto raw;
+            }
+
+          if (ncolors > 2)
+            {
+              dest = vnc_put_pixel(session, dest, pixel, bpp);
+            }
+
+          *dest++ = (uint8_t)((col << 4) | row);
+          *dest++ = (uint8_t)(((w - 1) << 4) | (h - 1));
+          nrects++;
+        }
+    }
+
+  *nsubrects = (uint8_t)nrects;
+  *subenc    = flags;
+  return dest - start;
+
+raw:
+
+  /* Raw tile.  Neither color may be carried over to the next tile. */
+
+  dest    = start;
+  *dest++ = RFB_SUBENCODING_RAW;
+
+  for (i = 0; i < npixels; i++)
+    {
+      dest = vnc_put_pixel(session, dest, tile[i], bpp);
+    }
+
+  state->bgvalid = false;
+  state->fgvalid = false;
+  return dest - start;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.  A failure is only returned
+ *   in cases of a network failure and unexpected internal failures.
+ *
+ ****************************************************************************/
+
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect)
+{
+  struct hextile_state_s state;
+  vnc_convert_t convert;
+  nxgl_coord_t width;
+  nxgl_coord_t height;
+  nxgl_coord_t tilew;
+  nxgl_coord_t tileh;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+  unsigned int bpp;
+  size_t outlen;
+  int ret;
+
+  /* The pixel format may change asynchronously, but it must not change
+   * within one FramebufferUpdate message.
+   */
+
+  convert = vnc_convert_select(session->colorfmt);
+  if (convert == NULL)
+    {
+      gerr("ERROR: Unrecognized color format: %d\n", session->colorfmt);
+      return -EINVAL;
+    }
+
+  bpp    = (session->bpp + 7) >> 3;
+  width  = rect->pt2.x - rect->pt1.x + 1;
+  height = rect->pt2.y - rect->pt1.y + 1;
+
+  outlen = vnc_update_header(session, rect->pt1.x, rect->pt1.y,
+                             width, height, RFB_ENCODING_HEXTILE);
+
+  state.bgvalid = false;
+  state.fgvalid = false;
+
+  /* Encode the tiles left-to-right, top-to-bottom.  The output buffer is
+   * sent whenever it might not hold the next tile.
+   */
+
+  for (y = rect->pt1.y; y <= rect->pt2.y; y += VNC_TILE_SIZE)
+    {
+      tileh = MIN(VNC_TILE_SIZE, rect->pt2.y - y + 1);
+
+      for (x = rect->pt1.x; x <= rect->pt2.x; x += VNC_TILE_SIZE)
+        {
+          tilew = MIN(VNC_TILE_SIZE, rect->pt2.x - x + 1);
+
+          if (outlen + HEXTILE_MAXTILE > VNCSERVER_UPDATE_BUFSIZE)
+            {
+              ret = vnc_send_update(session, session->outbuf, outlen);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              outlen = 0;
+            }
+
+          vnc_hextile_load(session, convert, x, y, tilew, tileh);
+          outlen += vnc_hextile_tile(session, &state, bpp, tilew, tileh,
+                                     &session->outbuf[outlen]);
+        }
+    }
+
+  ret = vnc_send_update(session, session->outbuf, outlen);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+  return OK;
+}
@@ -479,6 +479,10 @@ int vnc_client_pixelformat(FAR struct vnc_session_s *session,
       return -ENOSYS;
     }
 
+  /* The depth determines whether ZRLE/Tight may use 24-bit pixels */
+
+  session->depth = pixelfmt->depth;
+
   if (pixelfmt->bpp == 8 && pixelfmt->depth == 6)
     {
       ginfo("Client pixel format: RGB8 2:2:2\n");
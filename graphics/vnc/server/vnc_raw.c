@@ -292,8 +292,6 @@ static size_t vnc_copy32(FAR struct vnc_session_s *session,
 
 int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
 {
-  FAR struct rfb_framebufferupdate_s *update;
-  FAR const uint8_t *src;
   nxgl_coord_t srcwidth;
   nxgl_coord_t srcheight;
   nxgl_coord_t destwidth;
@@ -307,8 +305,8 @@ int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
   unsigned int bytesperpixel;
   unsigned int maxwidth;
   size_t size;
-  ssize_t nsent;
   uint8_t colorfmt;
+  int ret;
 
   union
   {
@@ -454,23 +452,9 @@ int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
 
           /* Format the FramebufferUpdate message */
 
-          update          = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
-          update->msgtype = RFB_FBUPDATE_MSG;
-          update->padding = 0;
-          rfb_putbe16(update->nrect, 1);
-
-          rfb_putbe16(update->rect[0].xpos, x);
-          rfb_putbe16(update->rect[0].ypos, y);
-          rfb_putbe16(update->rect[0].width, updwidth);
-          rfb_putbe16(update->rect[0].height, updheight);
-          rfb_putbe32(update->rect[0].encoding, RFB_ENCODING_RAW);
-
           DEBUGASSERT(size <= CONFIG_VNCSERVER_UPDATE_BUFSIZE);
-
-          /* We are ready to send the update packet to the VNC client */
-
-          size += SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0));
-          src   = session->outbuf;
+          size += vnc_update_header(session, x, y, updwidth, updheight,
+                                    RFB_ENCODING_RAW);
 
           /* At the very last most, make certain that the color format
            * has not changed asynchronously.
@@ -478,26 +462,13 @@ int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
 
           if (colorfmt == session->colorfmt)
             {
-              /* Okay send until all of the bytes are out.  This may
-               * loop for the case where TCP write buffering is enabled
-               * and there are a limited number of IOBs available.
-               */
+              /* We are ready to send the update packet to the VNC client */
 
-              do
+              ret = vnc_send_update(session, session->outbuf, size);
+              if (ret < 0)
                 {
-                  nsent = psock_send(&session->connect, src, size, 0);
-                  if (nsent < 0)
-                    {
-                      gerr("ERROR: Send FrameBufferUpdate failed: %d\n",
-                           (int)nsent);
-                      return (int)nsent;
-                    }
-
-                  DEBUGASSERT(nsent <= size);
-                  src  += nsent;
-                  size -= nsent;
+                  return ret;
                 }
-              while (size > 0);
 
               updinfo("Sent {(%d, %d),(%d, %d)}\n",
                       x, y, x + updwidth -1, y + updheight - 1);
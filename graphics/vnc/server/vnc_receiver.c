@@ -464,12 +464,14 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
   uint32_t encoding;
   unsigned int nencodings;
   unsigned int i;
+  int8_t preferred;
 
   DEBUGASSERT(session != NULL && encodings != NULL);
 
   /* Assume that there are no common encodings (other than RAW) */
 
   session->rre = false;
+  preferred    = RFB_ENCODING_RAW;
 
   /* Loop for each client supported encoding */
 
@@ -486,8 +488,36 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
         {
           session->rre = true;
         }
+
+      /* The encodings are listed in the order of the client's preference.
+       * Use the first one that we support.
+       */
+
+      else if (preferred == RFB_ENCODING_RAW)
+        {
+          switch (encoding)
+            {
+#ifdef CONFIG_VNCSERVER_HEXTILE
+              case RFB_ENCODING_HEXTILE:
+#endif
+#ifdef CONFIG_VNCSERVER_ZRLE
+              case RFB_ENCODING_ZRLE:
+#endif
+#ifdef CONFIG_VNCSERVER_TIGHT
+              case RFB_ENCODING_TIGHT:
+#endif
+                preferred = (int8_t)encoding;
+                break;
+
+              default:
+                break;
+            }
+        }
     }
 
+  ginfo("Preferred encoding: %d\n", preferred);
+  session->encoding = preferred;
+
   session->change = true;
   return OK;
 }
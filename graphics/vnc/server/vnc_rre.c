@@ -212,7 +212,6 @@ int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
   nxgl_coord_t width;
   nxgl_coord_t height;
   size_t nbytes;
-  ssize_t nsent;
   int ret;
 
   /* Check if the client supports the RRE encoding */
@@ -231,22 +230,14 @@ int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
            * rectangle.
            */
 
-          rre           = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
-          rre->msgtype  = RFB_FBUPDATE_MSG;
-          rre->padding  = 0;
-          rfb_putbe16(rre->nrect,          1);
+          nbytes = vnc_update_header(session, rect->pt1.x, rect->pt1.y,
+                                     width, height, RFB_ENCODING_RRE);
 
-          rrect         = (FAR struct rfb_rectangle_s *)&rre->rect;
-          rfb_putbe16(rrect->xpos,         rect->pt1.x);
-          rfb_putbe16(rrect->ypos,         rect->pt1.y);
-          rfb_putbe16(rrect->width,        width);
-          rfb_putbe16(rrect->height,       height);
-          rfb_putbe32(rrect->encoding,     RFB_ENCODING_RRE);
+          rre    = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+          rrect  = (FAR struct rfb_rectangle_s *)&rre->rect;
 
           /* The sub-rectangle encoding depends of the remote pixel width */
 
-          nbytes = SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0));
-
           switch (session->colorfmt)
             {
               case FB_FMT_RGB8_222:
@@ -296,15 +287,14 @@ int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
                * and there are a limited number of IOBs available.
                */
 
-              nsent = psock_send(&session->connect, rre, nbytes, 0);
-              if (nsent < 0)
+              ret = vnc_send_update(session, rre, nbytes);
+              if (ret < 0)
                 {
                   gerr("ERROR: Send RRE FrameBufferUpdate failed: %d\n",
-                       (int)nsent);
-                  return (int)nsent;
+                       ret);
+                  return ret;
                 }
 
-              DEBUGASSERT(nsent == nbytes);
               updinfo("Sent {(%d, %d),(%d, %d)}\n",
                       rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
               return nbytes;
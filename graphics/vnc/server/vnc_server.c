@@ -43,6 +43,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <queue.h>
+#include <sched.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -66,6 +67,7 @@
 #include <arpa/inet.h>
 #include <netinet/in.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 
@@ -104,7 +106,9 @@ FAR struct vnc_session_s *g_vnc_sessions[RFB_MAX_DISPLAYS];
 static void vnc_reset_session(FAR struct vnc_session_s *session,
                               FAR uint8_t *fb, int display)
 {
+#ifndef CONFIG_VNCSERVER_DIRTYMAP
   int i;
+#endif
 
   /* Close any open sockets */
 
@@ -119,6 +123,12 @@ static void vnc_reset_session(FAR struct vnc_session_s *session,
   memset(&session->connect, 0, sizeof(struct socket));
   memset(&session->listen, 0, sizeof(struct socket));
 
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+  /* Nothing is dirty yet */
+
+  memset(session->dirty, 0, sizeof(session->dirty));
+  session->dirtypend = false;
+#else
   /* Put all of the pre-allocated update structures into the freelist */
 
   sq_init(&session->updqueue);
@@ -129,16 +139,30 @@ static void vnc_reset_session(FAR struct vnc_session_s *session,
       sq_addlast((FAR sq_entry_t *)&session->updpool[i], &session->updfree);
     }
 
+  nxsem_reset(&session->freesem, CONFIG_VNCSERVER_NUPDATES);
+#endif
+
   /* Set the INITIALIZED state */
 
-  nxsem_reset(&session->freesem, CONFIG_VNCSERVER_NUPDATES);
   nxsem_reset(&session->queuesem, 0);
 
-  session->fb      = fb;
-  session->display = display;
-  session->state   = VNCSERVER_INITIALIZED;
-  session->nwhupd  = 0;
-  session->change  = true;
+  session->fb       = fb;
+  session->display  = display;
+  session->state    = VNCSERVER_INITIALIZED;
+  session->nwhupd   = 0;
+  session->change   = true;
+  session->encoding = RFB_ENCODING_RAW;
+
+#if defined(CONFIG_VNCSERVER_ZRLE) || defined(CONFIG_VNCSERVER_TIGHT)
+  /* A new connection starts new zlib streams */
+
+  session->zstreams = 0;
+#endif
+
+#ifdef CONFIG_VNCSERVER_STATS
+  memset(&session->stats, 0, sizeof(struct vnc_stats_s));
+  session->statstart = clock_systime_ticks();
+#endif
 
   /* Careful not to disturb the keyboard/mouse callouts set by
    * vnc_fbinitialize().  Client related data left in garbage state.
@@ -208,6 +232,10 @@ static int vnc_connect(FAR struct vnc_session_s *session, int port)
 
   ginfo("Display %d connected\n", session->display);
   session->state = VNCSERVER_CONNECTED;
+
+#ifdef CONFIG_VNCSERVER_STATS
+  session->statstart = clock_systime_ticks();
+#endif
   return OK;
 
 errout_with_listener:
@@ -291,7 +319,9 @@ int vnc_server(int argc, FAR char *argv[])
     }
 
   g_vnc_sessions[display] = session;
+#ifndef CONFIG_VNCSERVER_DIRTYMAP
   nxsem_init(&session->freesem, 0, CONFIG_VNCSERVER_NUPDATES);
+#endif
   nxsem_init(&session->queuesem, 0, 0);
 
   /* Inform any waiter that we have started */
@@ -381,3 +411,60 @@ errout_with_post:
 errout_with_hang:
   return EXIT_FAILURE;
 }
+
+/****************************************************************************
+ * Name: vnc_stats
+ *
+ * Description:
+ *   Return the statistics of the current session on the display.  The
+ *   average bandwidth is nbytes / elapsed and the average latency is
+ *   totlatency / nlatency.
+ *
+ * Input Parameters:
+ *   display - The display number of the session
+ *   stats   - The location to return the statistics
+ *   reset   - True: Reset the counters after they have been returned
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.  -ENOTCONN is returned if there is no connected client.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_STATS
+int vnc_stats(int display, FAR struct vnc_stats_s *stats, bool reset)
+{
+  FAR struct vnc_session_s *session;
+  clock_t now;
+
+  if (display < 0 || display >= RFB_MAX_DISPLAYS || stats == NULL)
+    {
+      return -EINVAL;
+    }
+
+  session = g_vnc_sessions[display];
+  if (session == NULL || session->state < VNCSERVER_CONNECTED)
+    {
+      return -ENOTCONN;
+    }
+
+  /* The counters are updated by the updater thread with the scheduler
+   * locked.
+   */
+
+  sched_lock();
+  now = clock_systime_ticks();
+
+  memcpy(stats, &session->stats, sizeof(struct vnc_stats_s));
+  stats->elapsed = TICK2MSEC(now - session->statstart);
+
+  if (reset)
+    {
+      memset(&session->stats, 0, sizeof(struct vnc_stats_s));
+      session->statstart = now;
+    }
+
+  sched_unlock();
+  return OK;
+}
+#endif
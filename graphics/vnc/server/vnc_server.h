@@ -45,6 +45,7 @@
 #include <stdint.h>
 #include <pthread.h>
 #include <queue.h>
+#include <time.h>
 
 #include <nuttx/video/fb.h>
 #include <nuttx/video/rfb.h>
@@ -156,12 +157,47 @@
 #define VNCSERVER_UPDATE_BUFSIZE \
   (CONFIG_VNCSERVER_UPDATE_BUFSIZE + SIZEOF_RFB_FRAMEBUFFERUPDATE_S(0))
 
+/* A raw Hextile tile at 32 BPP must fit into the update buffer */
+
+#define HEXTILE_MAXTILE     (1 + 16 * 16 * 4)
+
+#if defined(CONFIG_VNCSERVER_HEXTILE) && \
+    CONFIG_VNCSERVER_UPDATE_BUFSIZE < HEXTILE_MAXTILE
+#  error CONFIG_VNCSERVER_UPDATE_BUFSIZE is too small for Hextile
+#endif
+
+/* zlib stream identifiers.  Tight uses up to four independent streams; ZRLE
+ * uses one stream per connection.  A bit is set in session->zstreams when
+ * the zlib header for the stream has been sent.
+ */
+
+#define VNC_ZSTREAM_TIGHT(n) (1 << (n))
+#define VNC_ZSTREAM_ZRLE     (1 << 4)
+
+/* Size of the zlib stream header and of a stored deflate block header */
+
+#define VNC_ZLIB_HDRSIZE    2
+#define VNC_ZLIB_BLKSIZE    5
+
 /* Local framebuffer characteristics in bytes */
 
 #define RFB_BYTESPERPIXEL   ((RFB_BITSPERPIXEL + 7) >> 3)
 #define RFB_STRIDE          (RFB_BYTESPERPIXEL * CONFIG_VNCSERVER_SCREENWIDTH)
 #define RFB_SIZE            (RFB_STRIDE * CONFIG_VNCSERVER_SCREENHEIGHT)
 
+/* Dirty tile bitmap.  Each bit represents one 16x16 region of the local
+ * framebuffer.  Bits are numbered row-by-row from the upper left tile.
+ */
+
+#define VNC_TILE_SHIFT      4
+#define VNC_TILE_SIZE       (1 << VNC_TILE_SHIFT)
+#define VNC_TILE_NX \
+  ((CONFIG_VNCSERVER_SCREENWIDTH + VNC_TILE_SIZE - 1) >> VNC_TILE_SHIFT)
+#define VNC_TILE_NY \
+  ((CONFIG_VNCSERVER_SCREENHEIGHT + VNC_TILE_SIZE - 1) >> VNC_TILE_SHIFT)
+#define VNC_TILE_NTILES     (VNC_TILE_NX * VNC_TILE_NY)
+#define VNC_DIRTY_NWORDS    ((VNC_TILE_NTILES + 31) >> 5)
+
 /* RFB Port Number */
 
 #define RFB_PORT_BASE       5900
@@ -216,6 +252,9 @@ struct vnc_fbupdate_s
   FAR struct vnc_fbupdate_s *flink;
   bool whupd;                  /* True: whole screen update */
   struct nxgl_rect_s rect;     /* The enqueued update rectangle */
+#ifdef CONFIG_VNCSERVER_STATS
+  clock_t time;                /* Time that the update was queued */
+#endif
 };
 
 struct vnc_session_s
@@ -233,8 +272,13 @@ struct vnc_session_s
   uint8_t display;             /* Display number (for debug) */
   volatile uint8_t colorfmt;   /* Remote color format (See include/nuttx/fb.h) */
   volatile uint8_t bpp;        /* Remote bits per pixel */
+  volatile uint8_t depth;      /* Remote color depth */
   volatile bool bigendian;     /* True: Remote expect data in big-endian format */
   volatile bool rre;           /* True: Remote supports RRE encoding */
+  volatile int8_t encoding;    /* Preferred encoding (RFB_ENCODING_*) */
+#if defined(CONFIG_VNCSERVER_ZRLE) || defined(CONFIG_VNCSERVER_TIGHT)
+  uint8_t zstreams;            /* zlib streams started, see VNC_ZSTREAM_* */
+#endif
   FAR uint8_t *fb;             /* Allocated local frame buffer */
 
   /* VNC client input support */
@@ -247,6 +291,20 @@ struct vnc_session_s
 
   pthread_t updater;           /* Updater thread ID */
 
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+  /* Dirty tile information.  The updater takes a snapshot of the dirty
+   * bitmap and clears it so that new updates can be accumulated while the
+   * snapshot is being sent.
+   */
+
+  uint32_t dirty[VNC_DIRTY_NWORDS];
+  uint32_t snapshot[VNC_DIRTY_NWORDS];
+  volatile bool dirtypend;     /* True: queuesem has been posted */
+#ifdef CONFIG_VNCSERVER_STATS
+  clock_t dirtytime;           /* Time that the first tile became dirty */
+#endif
+  sem_t queuesem;
+#else
   /* Update list information */
 
   struct vnc_fbupdate_s updpool[CONFIG_VNCSERVER_NUPDATES];
@@ -254,6 +312,20 @@ struct vnc_session_s
   sq_queue_t updqueue;
   sem_t freesem;
   sem_t queuesem;
+#endif
+
+#ifdef CONFIG_VNCSERVER_STATS
+  /* Session statistics */
+
+  clock_t statstart;           /* Time of connection or of last reset */
+  struct vnc_stats_s stats;
+#endif
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  /* Remote color pixels of one Hextile tile */
+
+  uint32_t tile[VNC_TILE_SIZE * VNC_TILE_SIZE];
+#endif
 
   /* I/O buffers for misc network send/receive */
 
@@ -290,6 +362,10 @@ typedef CODE uint8_t  (*vnc_convert8_t) (lfb_color_t rgb);
 typedef CODE uint16_t (*vnc_convert16_t)(lfb_color_t rgb);
 typedef CODE uint32_t (*vnc_convert32_t)(lfb_color_t rgb);
 
+/* Color conversion function that works for any remote pixel width */
+
+typedef CODE uint32_t (*vnc_convert_t)(lfb_color_t rgb);
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -502,6 +578,159 @@ int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
 int vnc_raw(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.  A failure is only returned
+ *   in cases of a network failure and unexpected internal failures.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: vnc_zrle
+ *
+ * Description:
+ *  Send the framebuffer update using the ZRLE encoding.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_ZRLE
+int vnc_zrle(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: vnc_tight
+ *
+ * Description:
+ *  Send the framebuffer update using the Tight encoding (without JPEG).
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TIGHT
+int vnc_tight(FAR struct vnc_session_s *session,
+              FAR struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: vnc_zlib_header
+ *
+ * Description:
+ *  Store the zlib stream header if the stream has not yet been started.
+ *  There is no deflate implementation in the OS so all data is sent in
+ *  uncompressed (stored) deflate blocks.  Each block must be preceded by
+ *  a block header formatted with vnc_zlib_block().
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   stream  - The stream identifier, see VNC_ZSTREAM_*
+ *   dest    - The location to store the header.  Must provide space for
+ *             VNC_ZLIB_HDRSIZE bytes.
+ *
+ * Returned Value:
+ *   The number of bytes stored:  Zero or VNC_ZLIB_HDRSIZE.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_VNCSERVER_ZRLE) || defined(CONFIG_VNCSERVER_TIGHT)
+size_t vnc_zlib_header(FAR struct vnc_session_s *session, uint8_t stream,
+                       FAR uint8_t *dest);
+#endif
+
+/****************************************************************************
+ * Name: vnc_zlib_block
+ *
+ * Description:
+ *  Format the header of one non-final, stored deflate block.  The block
+ *  data of 'len' bytes follows the VNC_ZLIB_BLKSIZE header bytes.
+ *
+ * Input Parameters:
+ *   dest - The location to store the block header
+ *   len  - The length of the block data (less than 65536 bytes)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_VNCSERVER_ZRLE) || defined(CONFIG_VNCSERVER_TIGHT)
+void vnc_zlib_block(FAR uint8_t *dest, size_t len);
+#endif
+
+/****************************************************************************
+ * Name: vnc_send_update
+ *
+ * Description:
+ *  Send a FramebufferUpdate message (or a portion of one) to the VNC
+ *  client, looping until all of the bytes have been sent.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   buffer  - The data to send
+ *   size    - The number of bytes to send
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on a network
+ *   failure.
+ *
+ ****************************************************************************/
+
+int vnc_send_update(FAR struct vnc_session_s *session,
+                    FAR const void *buffer, size_t size);
+
+/****************************************************************************
+ * Name: vnc_update_header
+ *
+ * Description:
+ *  Format a FramebufferUpdate message header with one rectangle in the
+ *  beginning of session->outbuf.
+ *
+ * Input Parameters:
+ *   session  - An instance of the session structure.
+ *   x, y     - The position of the rectangle
+ *   width    - The width of the rectangle
+ *   height   - The height of the rectangle
+ *   encoding - The encoding of the rectangle data
+ *
+ * Returned Value:
+ *   The size of the header.  The rectangle data follows.
+ *
+ ****************************************************************************/
+
+size_t vnc_update_header(FAR struct vnc_session_s *session,
+                         nxgl_coord_t x, nxgl_coord_t y,
+                         nxgl_coord_t width, nxgl_coord_t height,
+                         int32_t encoding);
+
 /****************************************************************************
  * Name: vnc_key_map
  *
@@ -547,6 +776,46 @@ uint16_t vnc_convert_rgb16_555(lfb_color_t rgb);
 uint16_t vnc_convert_rgb16_565(lfb_color_t rgb);
 uint32_t vnc_convert_rgb32_888(lfb_color_t rgb);
 
+/****************************************************************************
+ * Name: vnc_convert_select
+ *
+ * Description:
+ *  Return a color conversion function that converts from the local
+ *  framebuffer color format to the remote framebuffer color format,
+ *  returning the result as a 32-bit value of any remote pixel width.
+ *
+ * Input Parameters:
+ *   colorfmt - The remote color format
+ *
+ * Returned Value:
+ *   The conversion function or NULL if the color format is not supported.
+ *
+ ****************************************************************************/
+
+vnc_convert_t vnc_convert_select(uint8_t colorfmt);
+
+/****************************************************************************
+ * Name: vnc_put_pixel
+ *
+ * Description:
+ *  Store one remote pixel in the byte order expected by the client.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   dest    - The location to store the pixel
+ *   pixel   - The pixel in the remote color format
+ *   nbytes  - The size of the pixel in bytes (1, 2, 3 or 4).  A size of 3
+ *             selects the compressed 24-bit pixel (CPIXEL) of ZRLE.
+ *
+ * Returned Value:
+ *   A pointer to the byte following the stored pixel.
+ *
+ ****************************************************************************/
+
+FAR uint8_t *vnc_put_pixel(FAR struct vnc_session_s *session,
+                           FAR uint8_t *dest, uint32_t pixel,
+                           unsigned int nbytes);
+
 /****************************************************************************
  * Name: vnc_colors
  *
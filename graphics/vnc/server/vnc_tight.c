@@ -0,0 +1,473 @@
+/****************************************************************************
+ * graphics/vnc/server/vnc_tight.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  undef  CONFIG_DEBUG_GRAPHICS_ERROR
+#  undef  CONFIG_DEBUG_GRAPHICS_WARN
+#  undef  CONFIG_DEBUG_GRAPHICS_INFO
+#  define CONFIG_DEBUG_ERROR          1
+#  define CONFIG_DEBUG_WARN           1
+#  define CONFIG_DEBUG_INFO           1
+#  define CONFIG_DEBUG_GRAPHICS       1
+#  define CONFIG_DEBUG_GRAPHICS_ERROR 1
+#  define CONFIG_DEBUG_GRAPHICS_WARN  1
+#  define CONFIG_DEBUG_GRAPHICS_INFO  1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Compression control byte */
+
+#define TIGHT_FILL          0x80  /* Fill compression */
+#define TIGHT_EXPLICIT      0x40  /* Basic compression with explicit filter */
+#define TIGHT_STREAM(n)     ((n) << 4)
+
+/* Filter IDs */
+
+#define TIGHT_FILTER_COPY    0
+#define TIGHT_FILTER_PALETTE 1
+
+/* zlib streams used for each kind of data */
+
+#define TIGHT_STREAM_COPY   0
+#define TIGHT_STREAM_MONO   1
+#define TIGHT_STREAM_INDEX  2
+
+/* Data smaller than this is sent without zlib framing */
+
+#define TIGHT_MIN_COMPRESS  12
+
+/* Limits */
+
+#define TIGHT_MAXWIDTH      2048
+#define TIGHT_MAXPALETTE    16
+
+/* Space needed in the output buffer ahead of the pixel data:  Control and
+ * filter bytes, palette, compact length and zlib headers.
+ */
+
+#define TIGHT_HDRSIZE \
+  SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0))
+#define TIGHT_OVERHEAD \
+  (TIGHT_HDRSIZE + 3 + 4 * TIGHT_MAXPALETTE + 3 + VNC_ZLIB_HDRSIZE + \
+   VNC_ZLIB_BLKSIZE)
+#define TIGHT_MAXDATA \
+  (VNCSERVER_UPDATE_BUFSIZE - TIGHT_OVERHEAD)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_tight_pixel
+ *
+ * Description:
+ *  Store one TPIXEL.  32-bit pixels with a depth of 24 are sent as three
+ *  bytes in red, green, blue order; other pixels as usual.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *vnc_tight_pixel(FAR struct vnc_session_s *session,
+                                    FAR uint8_t *dest, uint32_t pixel,
+                                    unsigned int tpb)
+{
+  if (tpb == 3)
+    {
+      *dest++ = (uint8_t)(pixel >> 16);
+      *dest++ = (uint8_t)(pixel >> 8);
+      *dest++ = (uint8_t)pixel;
+      return dest;
+    }
+
+  return vnc_put_pixel(session, dest, pixel, tpb);
+}
+
+/****************************************************************************
+ * Name: vnc_tight_palette
+ *
+ * Description:
+ *  Collect up to TIGHT_MAXPALETTE colors of a rectangle.
+ *
+ * Returned Value:
+ *   The number of colors or TIGHT_MAXPALETTE + 1 if there are more.
+ *
+ ****************************************************************************/
+
+static unsigned int vnc_tight_palette(FAR struct vnc_session_s *session,
+                                      vnc_convert_t convert,
+                                      nxgl_coord_t x, nxgl_coord_t y,
+                                      nxgl_coord_t width,
+                                      nxgl_coord_t height,
+                                      FAR uint32_t *palette)
+{
+  FAR const lfb_color_t *src;
+  unsigned int npalette = 0;
+  unsigned int i;
+  uint32_t pixel;
+  nxgl_coord_t row;
+  nxgl_coord_t col;
+
+  for (row = 0; row < height; row++)
+    {
+      src = (FAR const lfb_color_t *)
+        (session->fb + RFB_STRIDE * (y + row) + RFB_BYTESPERPIXEL * x);
+
+      for (col = 0; col < width; col++)
+        {
+          pixel = convert(*src++);
+
+          for (i = 0; i < npalette && palette[i] != pixel; i++)
+            {
+            }
+
+          if (i >= npalette)
+            {
+              if (npalette >= TIGHT_MAXPALETTE)
+                {
+                  return TIGHT_MAXPALETTE + 1;
+                }
+
+              palette[npalette++] = pixel;
+            }
+        }
+    }
+
+  return npalette;
+}
+
+/****************************************************************************
+ * Name: vnc_tight_data
+ *
+ * Description:
+ *  Encode the pixel data of a rectangle either as TPIXELs (npalette == 0)
+ *  or as palette indices:  One bit per pixel for two colors, one byte per
+ *  pixel otherwise.
+ *
+ * Returned Value:
+ *   The location following the data.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *vnc_tight_data(FAR struct vnc_session_s *session,
+                                   vnc_convert_t convert,
+                                   nxgl_coord_t x, nxgl_coord_t y,
+                                   nxgl_coord_t width, nxgl_coord_t height,
+                                   unsigned int tpb,
+                                   FAR const uint32_t *palette,
+                                   unsigned int npalette,
+                                   FAR uint8_t *dest)
+{
+  FAR const lfb_color_t *src;
+  unsigned int index;
+  uint32_t pixel;
+  nxgl_coord_t row;
+  nxgl_coord_t col;
+  uint8_t accum;
+  int nbits;
+
+  for (row = 0; row < height; row++)
+    {
+      src = (FAR const lfb_color_t *)
+        (session->fb + RFB_STRIDE * (y + row) + RFB_BYTESPERPIXEL * x);
+
+      accum = 0;
+      nbits = 0;
+
+      for (col = 0; col < width; col++)
+        {
+          pixel = convert(*src++);
+
+          if (npalette == 0)
+            {
+              dest = vnc_tight_pixel(session, dest, pixel, tpb);
+              continue;
+            }
+
+          for (index = 0; palette[index] != pixel; index++)
+            {
+              DEBUGASSERT(index < npalette);
+            }
+
+          if (npalette > 2)
+            {
+              *dest++ = (uint8_t)index;
+            }
+          else
+            {
+              /* Monochrome:  Leftmost pixel in the MS bit */
+
+              accum = (uint8_t)((accum << 1) | index);
+              if (++nbits >= 8)
+                {
+                  *dest++ = accum;
+                  accum   = 0;
+                  nbits   = 0;
+                }
+            }
+        }
+
+      if (nbits > 0)
+        {
+          *dest++ = (uint8_t)(accum << (8 - nbits));
+        }
+    }
+
+  return dest;
+}
+
+/****************************************************************************
+ * Name: vnc_tight_fill
+ *
+ * Description:
+ *  Send one Tight rectangle of a single color using Fill compression.
+ *
+ ****************************************************************************/
+
+static int vnc_tight_fill(FAR struct vnc_session_s *session,
+                          nxgl_coord_t x, nxgl_coord_t y,
+                          nxgl_coord_t width, nxgl_coord_t height,
+                          unsigned int tpb, uint32_t pixel)
+{
+  FAR uint8_t *dest;
+
+  dest    = session->outbuf;
+  dest   += vnc_update_header(session, x, y, width, height,
+                              RFB_ENCODING_TIGHT);
+  *dest++ = TIGHT_FILL;
+  dest    = vnc_tight_pixel(session, dest, pixel, tpb);
+
+  return vnc_send_update(session, session->outbuf, dest - session->outbuf);
+}
+
+/****************************************************************************
+ * Name: vnc_tight_rect
+ *
+ * Description:
+ *  Encode and send one Tight rectangle that fits into the output buffer.
+ *
+ ****************************************************************************/
+
+static int vnc_tight_rect(FAR struct vnc_session_s *session,
+                          vnc_convert_t convert,
+                          nxgl_coord_t x, nxgl_coord_t y,
+                          nxgl_coord_t width, nxgl_coord_t height,
+                          unsigned int tpb)
+{
+  uint32_t palette[TIGHT_MAXPALETTE];
+  FAR uint8_t *dest;
+  FAR uint8_t *data;
+  FAR uint8_t *block;
+  unsigned int npalette;
+  unsigned int stream;
+  unsigned int i;
+  size_t datalen;
+  size_t zlen;
+
+  npalette = vnc_tight_palette(session, convert, x, y, width, height,
+                               palette);
+  if (npalette == 1)
+    {
+      return vnc_tight_fill(session, x, y, width, height, tpb, palette[0]);
+    }
+
+  dest  = session->outbuf;
+  dest += vnc_update_header(session, x, y, width, height,
+                            RFB_ENCODING_TIGHT);
+
+  if (npalette > TIGHT_MAXPALETTE)
+    {
+      /* Too many colors.  Use the copy filter (implicit). */
+
+      stream   = TIGHT_STREAM_COPY;
+      npalette = 0;
+      *dest++  = TIGHT_STREAM(stream);
+    }
+  else
+    {
+      stream  = npalette == 2 ? TIGHT_STREAM_MONO : TIGHT_STREAM_INDEX;
+      *dest++ = TIGHT_STREAM(stream) | TIGHT_EXPLICIT;
+      *dest++ = TIGHT_FILTER_PALETTE;
+      *dest++ = (uint8_t)(npalette - 1);
+
+      for (i = 0; i < npalette; i++)
+        {
+          dest = vnc_tight_pixel(session, dest, palette[i], tpb);
+        }
+    }
+
+  /* Encode the data after the space for the longest possible compact
+   * length and zlib headers.
+   */
+
+  block   = dest + 3 + VNC_ZLIB_HDRSIZE;
+  data    = block + VNC_ZLIB_BLKSIZE;
+  datalen = vnc_tight_data(session, convert, x, y, width, height, tpb,
+                           palette, npalette, data) - data;
+  DEBUGASSERT(datalen <= TIGHT_MAXDATA);
+
+  if (datalen < TIGHT_MIN_COMPRESS)
+    {
+      /* Short data is sent as is */
+
+      memmove(dest, data, datalen);
+      dest += datalen;
+    }
+  else
+    {
+      /* Wrap the data in a stored deflate block and close the gap between
+       * the compact length and the zlib data.
+       */
+
+      vnc_zlib_block(block, datalen);
+      block -= vnc_zlib_header(session, VNC_ZSTREAM_TIGHT(stream),
+                               block - VNC_ZLIB_HDRSIZE);
+
+      zlen = data + datalen - block;
+
+      /* Compact length:  7 bits per byte, LS bits first, up to 3 bytes */
+
+      if (zlen <= 0x7f)
+        {
+          *dest++ = (uint8_t)zlen;
+        }
+      else if (zlen <= 0x3fff)
+        {
+          *dest++ = (uint8_t)((zlen & 0x7f) | 0x80);
+          *dest++ = (uint8_t)(zlen >> 7);
+        }
+      else
+        {
+          *dest++ = (uint8_t)((zlen & 0x7f) | 0x80);
+          *dest++ = (uint8_t)(((zlen >> 7) & 0x7f) | 0x80);
+          *dest++ = (uint8_t)(zlen >> 14);
+        }
+
+      memmove(dest, block, zlen);
+      dest += zlen;
+    }
+
+  return vnc_send_update(session, session->outbuf, dest - session->outbuf);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_tight
+ *
+ * Description:
+ *  Send the framebuffer update using the Tight encoding (without JPEG).
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+int vnc_tight(FAR struct vnc_session_s *session,
+              FAR struct nxgl_rect_s *rect)
+{
+  vnc_convert_t convert;
+  lfb_color_t color;
+  nxgl_coord_t width;
+  nxgl_coord_t height;
+  nxgl_coord_t maxw;
+  nxgl_coord_t maxh;
+  nxgl_coord_t updw;
+  nxgl_coord_t updh;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+  unsigned int bpp;
+  unsigned int tpb;
+  int ret;
+
+  convert = vnc_convert_select(session->colorfmt);
+  if (convert == NULL)
+    {
+      gerr("ERROR: Unrecognized color format: %d\n", session->colorfmt);
+      return -EINVAL;
+    }
+
+  bpp    = (session->bpp + 7) >> 3;
+  tpb    = (bpp == 4 && session->depth == 24) ? 3 : bpp;
+  width  = rect->pt2.x - rect->pt1.x + 1;
+  height = rect->pt2.y - rect->pt1.y + 1;
+
+  /* A solid rectangle is sent with one Fill, regardless of its size */
+
+  if (width <= TIGHT_MAXWIDTH &&
+      vnc_colors(session, rect, 1, &color) == 1)
+    {
+      return vnc_tight_fill(session, rect->pt1.x, rect->pt1.y,
+                            width, height, tpb, convert(color));
+    }
+
+  /* Otherwise, split the update into rectangles whose uncompressed data
+   * fits into the output buffer.
+   */
+
+  maxw = MIN(width, MIN(TIGHT_MAXWIDTH, TIGHT_MAXDATA / tpb));
+  maxh = TIGHT_MAXDATA / (maxw * tpb);
+
+  for (y = rect->pt1.y; y <= rect->pt2.y; y += updh)
+    {
+      updh = MIN(maxh, rect->pt2.y - y + 1);
+
+      for (x = rect->pt1.x; x <= rect->pt2.x; x += updw)
+        {
+          updw = MIN(maxw, rect->pt2.x - x + 1);
+
+          ret = vnc_tight_rect(session, convert, x, y, updw, updh, tpb);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+  return OK;
+}
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <string.h>
+#include <strings.h>
 #include <sched.h>
 #include <pthread.h>
 #include <queue.h>
@@ -48,6 +49,8 @@
 #endif
 #include <debug.h>
 
+#include <nuttx/clock.h>
+
 #include "vnc_server.h"
 
 /****************************************************************************
@@ -57,6 +60,10 @@
 #undef VNCSERVER_SEM_DEBUG          /* Define to dump queue/semaphore state */
 #undef VNCSERVER_SEM_DEBUG_SILENT   /* Define to dump only suspicious conditions */
 
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+#  undef VNCSERVER_SEM_DEBUG
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -165,6 +172,7 @@ static void vnc_sem_debug(FAR struct vnc_session_s *session,
 #  define vnc_sem_debug(s,m,u)
 #endif
 
+#ifndef CONFIG_VNCSERVER_DIRTYMAP
 /****************************************************************************
  * Name: vnc_alloc_update
  *
@@ -335,6 +343,242 @@ static void vnc_add_queue(FAR struct vnc_session_s *session,
 
   sched_unlock();
 }
+#endif /* !CONFIG_VNCSERVER_DIRTYMAP */
+
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+/****************************************************************************
+ * Name: vnc_mark_dirty
+ *
+ * Description:
+ *   Mark all of the tiles touched by a rectangle as dirty.  Called with the
+ *   scheduler locked.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The (clipped) rectangle that has changed.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void vnc_mark_dirty(FAR struct vnc_session_s *session,
+                           FAR const struct nxgl_rect_s *rect)
+{
+  unsigned int tx0 = (unsigned int)rect->pt1.x >> VNC_TILE_SHIFT;
+  unsigned int tx1 = (unsigned int)rect->pt2.x >> VNC_TILE_SHIFT;
+  unsigned int ty0 = (unsigned int)rect->pt1.y >> VNC_TILE_SHIFT;
+  unsigned int ty1 = (unsigned int)rect->pt2.y >> VNC_TILE_SHIFT;
+  unsigned int tx;
+  unsigned int ty;
+  unsigned int bit;
+
+  for (ty = ty0; ty <= ty1; ty++)
+    {
+      bit = ty * VNC_TILE_NX + tx0;
+      for (tx = tx0; tx <= tx1; tx++, bit++)
+        {
+          session->dirty[bit >> 5] |= (uint32_t)1 << (bit & 31);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vnc_dirty_row
+ *
+ * Description:
+ *   Test if the tiles tx0..tx1 of tile row ty are all set in the snapshot
+ *   and, optionally, clear them.
+ *
+ ****************************************************************************/
+
+static bool vnc_dirty_row(FAR uint32_t *map, unsigned int ty,
+                          unsigned int tx0, unsigned int tx1, bool clear)
+{
+  unsigned int bit = ty * VNC_TILE_NX + tx0;
+  unsigned int tx;
+
+  for (tx = tx0; tx <= tx1; tx++, bit++)
+    {
+      if (clear)
+        {
+          map[bit >> 5] &= ~((uint32_t)1 << (bit & 31));
+        }
+      else if ((map[bit >> 5] & ((uint32_t)1 << (bit & 31))) == 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: vnc_dirty_next
+ *
+ * Description:
+ *   Extract the next rectangle from the snapshot of the dirty tile bitmap.
+ *   The first dirty tile is extended to the right as far as the tiles are
+ *   dirty and then down as long as the same span of tiles is dirty in the
+ *   next row.  The tiles of the rectangle are then removed from the
+ *   snapshot.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   index   - The index of the first word of the snapshot that may be
+ *             non-zero.  Updated on return.
+ *   rect    - The location to return the rectangle (in pixels)
+ *
+ * Returned Value:
+ *   True if a rectangle was returned; false if the snapshot is empty.
+ *
+ ****************************************************************************/
+
+static bool vnc_dirty_next(FAR struct vnc_session_s *session,
+                           FAR unsigned int *index,
+                           FAR struct nxgl_rect_s *rect)
+{
+  FAR uint32_t *map = session->snapshot;
+  unsigned int bit;
+  unsigned int tx0;
+  unsigned int tx1;
+  unsigned int ty0;
+  unsigned int ty1;
+
+  /* Find the first non-zero word in the snapshot */
+
+  while (*index < VNC_DIRTY_NWORDS && map[*index] == 0)
+    {
+      (*index)++;
+    }
+
+  if (*index >= VNC_DIRTY_NWORDS)
+    {
+      return false;
+    }
+
+  /* Then the first dirty tile in that word */
+
+  bit = (*index << 5) + (ffs(map[*index]) - 1);
+  ty0 = bit / VNC_TILE_NX;
+  tx0 = bit - ty0 * VNC_TILE_NX;
+
+  /* Extend the span to the right... */
+
+  for (tx1 = tx0;
+       tx1 + 1 < VNC_TILE_NX && vnc_dirty_row(map, ty0, tx1 + 1, tx1 + 1,
+                                              false);
+       tx1++)
+    {
+    }
+
+  /* ...and then downward */
+
+  for (ty1 = ty0;
+       ty1 + 1 < VNC_TILE_NY && vnc_dirty_row(map, ty1 + 1, tx0, tx1, false);
+       ty1++)
+    {
+    }
+
+  for (bit = ty0; bit <= ty1; bit++)
+    {
+      vnc_dirty_row(map, bit, tx0, tx1, true);
+    }
+
+  /* Convert to pixels, clipping to the framebuffer */
+
+  rect->pt1.x = tx0 << VNC_TILE_SHIFT;
+  rect->pt1.y = ty0 << VNC_TILE_SHIFT;
+  rect->pt2.x = MIN(((tx1 + 1) << VNC_TILE_SHIFT) - 1,
+                    CONFIG_VNCSERVER_SCREENWIDTH - 1);
+  rect->pt2.y = MIN(((ty1 + 1) << VNC_TILE_SHIFT) - 1,
+                    CONFIG_VNCSERVER_SCREENHEIGHT - 1);
+  return true;
+}
+#endif /* CONFIG_VNCSERVER_DIRTYMAP */
+
+/****************************************************************************
+ * Name: vnc_update_latency
+ *
+ * Description:
+ *   Account for the latency between a change in the local framebuffer and
+ *   the time that the last byte of the update was sent.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_STATS
+static void vnc_update_latency(FAR struct vnc_session_s *session,
+                               clock_t time)
+{
+  uint32_t latency = TICK2MSEC(clock_systime_ticks() - time);
+
+  sched_lock();
+  session->stats.nlatency++;
+  session->stats.totlatency += latency;
+  if (latency > session->stats.maxlatency)
+    {
+      session->stats.maxlatency = latency;
+    }
+
+  sched_unlock();
+}
+#else
+#  define vnc_update_latency(s,t)
+#endif
+
+/****************************************************************************
+ * Name: vnc_send_rectangle
+ *
+ * Description:
+ *   Send one rectangle to the client using the preferred encoding.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   A non-negative value on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int vnc_send_rectangle(FAR struct vnc_session_s *session,
+                              FAR struct nxgl_rect_s *rect)
+{
+  int ret;
+
+  switch (session->encoding)
+    {
+#ifdef CONFIG_VNCSERVER_HEXTILE
+      case RFB_ENCODING_HEXTILE:
+        return vnc_hextile(session, rect);
+#endif
+
+#ifdef CONFIG_VNCSERVER_ZRLE
+      case RFB_ENCODING_ZRLE:
+        return vnc_zrle(session, rect);
+#endif
+
+#ifdef CONFIG_VNCSERVER_TIGHT
+      case RFB_ENCODING_TIGHT:
+        return vnc_tight(session, rect);
+#endif
+
+      default:
+        break;
+    }
+
+  /* Attempt to use RRE encoding */
+
+  ret = vnc_rre(session, rect);
+  if (ret == 0)
+    {
+      /* Perform the framebuffer update using the default RAW encoding */
+
+      ret = vnc_raw(session, rect);
+    }
+
+  return ret;
+}
 
 /****************************************************************************
  * Name: vnc_updater
@@ -354,8 +598,16 @@ static void vnc_add_queue(FAR struct vnc_session_s *session,
 static FAR void *vnc_updater(FAR void *arg)
 {
   FAR struct vnc_session_s *session = (FAR struct vnc_session_s *)arg;
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+  struct nxgl_rect_s rect;
+  unsigned int index;
+#ifdef CONFIG_VNCSERVER_STATS
+  clock_t time;
+#endif
+#else
   FAR struct vnc_fbupdate_s *srcrect;
-  int ret;
+#endif
+  int ret = OK;
 
   DEBUGASSERT(session != NULL);
   ginfo("Updater running for Display %d\n", session->display);
@@ -368,6 +620,44 @@ static FAR void *vnc_updater(FAR void *arg)
 
   while (session->state == VNCSERVER_RUNNING)
     {
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+      /* Wait until some tiles are dirty */
+
+      nxsem_wait_uninterruptible(&session->queuesem);
+
+      /* Take a snapshot of the dirty tiles and clear the bitmap so that
+       * new changes can accumulate while the snapshot is sent.
+       */
+
+      sched_lock();
+      memcpy(session->snapshot, session->dirty, sizeof(session->dirty));
+      memset(session->dirty, 0, sizeof(session->dirty));
+      session->dirtypend = false;
+#ifdef CONFIG_VNCSERVER_STATS
+      time = session->dirtytime;
+#endif
+      sched_unlock();
+
+      /* Send the merged rectangles */
+
+      index = 0;
+      while (vnc_dirty_next(session, &index, &rect))
+        {
+          updinfo("Dirty {(%d, %d),(%d, %d)}\n",
+                  rect.pt1.x, rect.pt1.y, rect.pt2.x, rect.pt2.y);
+
+          ret = vnc_send_rectangle(session, &rect);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+
+      if (ret >= 0)
+        {
+          vnc_update_latency(session, time);
+        }
+#else
       /* Get the next queued rectangle update.  This call will block until an
        * update is available for the case where the update queue is empty.
        */
@@ -379,19 +669,16 @@ static FAR void *vnc_updater(FAR void *arg)
               srcrect->rect.pt1.x, srcrect->rect.pt1.y,
               srcrect->rect.pt2.x, srcrect->rect.pt2.y);
 
-      /* Attempt to use RRE encoding */
-
-      ret = vnc_rre(session, &srcrect->rect);
-      if (ret == 0)
+      ret = vnc_send_rectangle(session, &srcrect->rect);
+      if (ret >= 0)
         {
-          /* Perform the framebuffer update using the default RAW encoding */
-
-          ret = vnc_raw(session, &srcrect->rect);
+          vnc_update_latency(session, srcrect->time);
         }
 
       /* Release the update structure */
 
       vnc_free_update(session, srcrect);
+#endif
 
       /* Break out and terminate the server if the encoding failed */
 
@@ -517,6 +804,66 @@ int vnc_stop_updater(FAR struct vnc_session_s *session)
  *
  ****************************************************************************/
 
+#ifdef CONFIG_VNCSERVER_DIRTYMAP
+int vnc_update_rectangle(FAR struct vnc_session_s *session,
+                         FAR const struct nxgl_rect_s *rect, bool change)
+{
+  struct nxgl_rect_s intersection;
+
+  /* Clip rectangle to the screen dimensions */
+
+  nxgl_rectintersect(&intersection, rect, &g_wholescreen);
+  if (nxgl_nullrect(&intersection))
+    {
+      return OK;
+    }
+
+  sched_lock();
+
+  /* Ignore client update requests if there have been no changes to the
+   * framebuffer since the last whole screen update.
+   */
+
+  if (change || session->change)
+    {
+      if (change)
+        {
+          session->change = true;
+        }
+      else if (memcmp(&intersection, &g_wholescreen,
+                      sizeof(struct nxgl_rect_s)) == 0)
+        {
+          /* The client asked for the whole screen.  There are no further
+           * changes to report after this update.
+           */
+
+          session->change = false;
+        }
+
+      /* Merge the rectangle into the dirty tile bitmap and wake up the
+       * updater if it has not already been notified.
+       */
+
+      vnc_mark_dirty(session, &intersection);
+
+      if (!session->dirtypend)
+        {
+#ifdef CONFIG_VNCSERVER_STATS
+          session->dirtytime = clock_systime_ticks();
+#endif
+          session->dirtypend = true;
+          nxsem_post(&session->queuesem);
+        }
+
+      updinfo("Dirty {(%d, %d),(%d, %d)}\n",
+              intersection.pt1.x, intersection.pt1.y,
+              intersection.pt2.x, intersection.pt2.y);
+    }
+
+  sched_unlock();
+  return OK;
+}
+#else
 int vnc_update_rectangle(FAR struct vnc_session_s *session,
                          FAR const struct nxgl_rect_s *rect, bool change)
 {
@@ -604,6 +951,9 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
 
           update->whupd = whupd;
           nxgl_rectcopy(&update->rect, &intersection);
+#ifdef CONFIG_VNCSERVER_STATS
+          update->time = clock_systime_ticks();
+#endif
 
           /* Add the update to the end of the update queue. */
 
@@ -623,3 +973,104 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
 
   return OK;
 }
+#endif /* CONFIG_VNCSERVER_DIRTYMAP */
+
+/****************************************************************************
+ * Name: vnc_update_header
+ *
+ * Description:
+ *  Format a FramebufferUpdate message header with one rectangle in the
+ *  beginning of session->outbuf.
+ *
+ * Input Parameters:
+ *   session  - An instance of the session structure.
+ *   x, y     - The position of the rectangle
+ *   width    - The width of the rectangle
+ *   height   - The height of the rectangle
+ *   encoding - The encoding of the rectangle data
+ *
+ * Returned Value:
+ *   The size of the header.  The rectangle data follows.
+ *
+ ****************************************************************************/
+
+size_t vnc_update_header(FAR struct vnc_session_s *session,
+                         nxgl_coord_t x, nxgl_coord_t y,
+                         nxgl_coord_t width, nxgl_coord_t height,
+                         int32_t encoding)
+{
+  FAR struct rfb_framebufferupdate_s *update;
+
+  update          = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+  update->msgtype = RFB_FBUPDATE_MSG;
+  update->padding = 0;
+  rfb_putbe16(update->nrect, 1);
+
+  rfb_putbe16(update->rect[0].xpos, x);
+  rfb_putbe16(update->rect[0].ypos, y);
+  rfb_putbe16(update->rect[0].width, width);
+  rfb_putbe16(update->rect[0].height, height);
+  rfb_putbe32(update->rect[0].encoding, encoding);
+
+#ifdef CONFIG_VNCSERVER_STATS
+  sched_lock();
+  session->stats.nupdates++;
+  session->stats.nrects++;
+  session->stats.npixels += (uint32_t)width * height;
+  sched_unlock();
+#endif
+
+  return SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0));
+}
+
+/****************************************************************************
+ * Name: vnc_send_update
+ *
+ * Description:
+ *  Send a FramebufferUpdate message (or a portion of one) to the VNC
+ *  client, looping until all of the bytes have been sent.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   buffer  - The data to send
+ *   size    - The number of bytes to send
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on a network
+ *   failure.
+ *
+ ****************************************************************************/
+
+int vnc_send_update(FAR struct vnc_session_s *session,
+                    FAR const void *buffer, size_t size)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)buffer;
+  ssize_t nsent;
+
+  /* Send until all of the bytes are out.  This may loop for the case where
+   * TCP write buffering is enabled and there are a limited number of IOBs
+   * available.
+   */
+
+  while (size > 0)
+    {
+      nsent = psock_send(&session->connect, src, size, 0);
+      if (nsent < 0)
+        {
+          gerr("ERROR: Send FrameBufferUpdate failed: %d\n", (int)nsent);
+          return (int)nsent;
+        }
+
+      DEBUGASSERT(nsent <= size);
+      src  += nsent;
+      size -= nsent;
+
+#ifdef CONFIG_VNCSERVER_STATS
+      sched_lock();
+      session->stats.nbytes += nsent;
+      sched_unlock();
+#endif
+    }
+
+  return OK;
+}
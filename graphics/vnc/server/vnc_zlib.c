@@ -0,0 +1,118 @@
+/****************************************************************************
+ * graphics/vnc/server/vnc_zlib.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* zlib stream header:  CM=8 (deflate), CINFO=7 (32K window), FLEVEL=0,
+ * no preset dictionary.  FCHECK makes CMF*256 + FLG a multiple of 31.
+ */
+
+#define ZLIB_CMF           0x78
+#define ZLIB_FLG           0x01
+
+/* Deflate block header:  BFINAL=0, BTYPE=00 (stored).  The remaining five
+ * bits pad the header to a byte boundary.  Since every stored block ends
+ * on a byte boundary, every block header is a single zero byte.
+ */
+
+#define DEFLATE_STORED     0x00
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_zlib_header
+ *
+ * Description:
+ *  Store the zlib stream header if the stream has not yet been started.
+ *  There is no deflate implementation in the OS so all data is sent in
+ *  uncompressed (stored) deflate blocks.  Each block must be preceded by
+ *  a block header formatted with vnc_zlib_block().
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   stream  - The stream identifier, see VNC_ZSTREAM_*
+ *   dest    - The location to store the header.  Must provide space for
+ *             VNC_ZLIB_HDRSIZE bytes.
+ *
+ * Returned Value:
+ *   The number of bytes stored:  Zero or VNC_ZLIB_HDRSIZE.
+ *
+ ****************************************************************************/
+
+size_t vnc_zlib_header(FAR struct vnc_session_s *session, uint8_t stream,
+                       FAR uint8_t *dest)
+{
+  if ((session->zstreams & stream) != 0)
+    {
+      return 0;
+    }
+
+  /* The stream is never finished so no Adler-32 checksum is ever sent */
+
+  dest[0] = ZLIB_CMF;
+  dest[1] = ZLIB_FLG;
+
+  session->zstreams |= stream;
+  return VNC_ZLIB_HDRSIZE;
+}
+
+/****************************************************************************
+ * Name: vnc_zlib_block
+ *
+ * Description:
+ *  Format the header of one non-final, stored deflate block.  The block
+ *  data of 'len' bytes follows the VNC_ZLIB_BLKSIZE header bytes.
+ *
+ * Input Parameters:
+ *   dest - The location to store the block header
+ *   len  - The length of the block data (less than 65536 bytes)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void vnc_zlib_block(FAR uint8_t *dest, size_t len)
+{
+  DEBUGASSERT(len <= UINT16_MAX);
+
+  /* LEN and NLEN are little-endian */
+
+  dest[0] = DEFLATE_STORED;
+  dest[1] = (uint8_t)(len & 0xff);
+  dest[2] = (uint8_t)(len >> 8);
+  dest[3] = (uint8_t)(~len & 0xff);
+  dest[4] = (uint8_t)((~len >> 8) & 0xff);
+}
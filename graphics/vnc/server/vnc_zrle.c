@@ -0,0 +1,561 @@
+/****************************************************************************
+ * graphics/vnc/server/vnc_zrle.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  undef  CONFIG_DEBUG_GRAPHICS_ERROR
+#  undef  CONFIG_DEBUG_GRAPHICS_WARN
+#  undef  CONFIG_DEBUG_GRAPHICS_INFO
+#  define CONFIG_DEBUG_ERROR          1
+#  define CONFIG_DEBUG_WARN           1
+#  define CONFIG_DEBUG_INFO           1
+#  define CONFIG_DEBUG_GRAPHICS       1
+#  define CONFIG_DEBUG_GRAPHICS_ERROR 1
+#  define CONFIG_DEBUG_GRAPHICS_WARN  1
+#  define CONFIG_DEBUG_GRAPHICS_INFO  1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ZRLE_TILE_SIZE     64
+#define ZRLE_MAXPALETTE    127
+#define ZRLE_MAXPACKED     16
+
+/* Everything that precedes the tile data in the output buffer:  The
+ * FramebufferUpdate header, the ZRLE length, the zlib stream header (the
+ * first time only) and the stored deflate block header.
+ */
+
+#define ZRLE_HDRSIZE \
+  (SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0)) + 4)
+#define ZRLE_OVERHEAD \
+  (ZRLE_HDRSIZE + VNC_ZLIB_HDRSIZE + VNC_ZLIB_BLKSIZE)
+#define ZRLE_MAXDATA \
+  (VNCSERVER_UPDATE_BUFSIZE - ZRLE_OVERHEAD)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The result of the analysis of one tile */
+
+struct zrle_tile_s
+{
+  uint32_t palette[ZRLE_MAXPALETTE];
+  unsigned int npalette;       /* > ZRLE_MAXPALETTE: Too many colors */
+  unsigned int last;           /* Index of the last palette hit */
+  uint8_t subenc;              /* Selected sub-encoding */
+  size_t size;                 /* Size of the encoded tile */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_zrle_lookup
+ *
+ * Description:
+ *  Return the palette index of a pixel or -1 if it is not in the palette.
+ *  Neighboring pixels are usually the same color, so the last hit is
+ *  checked first.
+ *
+ ****************************************************************************/
+
+static int vnc_zrle_lookup(FAR struct zrle_tile_s *tile, uint32_t pixel)
+{
+  unsigned int i;
+
+  if (tile->last < tile->npalette && tile->palette[tile->last] == pixel)
+    {
+      return tile->last;
+    }
+
+  for (i = 0; i < tile->npalette; i++)
+    {
+      if (tile->palette[i] == pixel)
+        {
+          tile->last = i;
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: vnc_zrle_runlength
+ *
+ * Description:
+ *  Store a run length in the ZRLE format:  (length - 1) as a sequence of
+ *  255's followed by the remainder.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *vnc_zrle_runlength(FAR uint8_t *dest, unsigned int len)
+{
+  len--;
+  while (len >= 255)
+    {
+      *dest++ = 255;
+      len    -= 255;
+    }
+
+  *dest++ = (uint8_t)len;
+  return dest;
+}
+
+/****************************************************************************
+ * Name: vnc_zrle_analyze
+ *
+ * Description:
+ *  Build the palette of the tile, count the runs, and select the
+ *  sub-encoding that gives the smallest result.
+ *
+ ****************************************************************************/
+
+static void vnc_zrle_analyze(FAR struct vnc_session_s *session,
+                             vnc_convert_t convert,
+                             nxgl_coord_t x, nxgl_coord_t y,
+                             nxgl_coord_t width, nxgl_coord_t height,
+                             unsigned int cpb, FAR struct zrle_tile_s *tile)
+{
+  FAR const lfb_color_t *src;
+  uint32_t pixel;
+  uint32_t prev = 0;
+  unsigned int runlen = 0;
+  unsigned int lenbytes;
+  unsigned int bits;
+  size_t rlesize = 1;
+  size_t palrlesize = 1;
+  size_t size;
+  nxgl_coord_t row;
+  nxgl_coord_t col;
+
+  tile->npalette = 0;
+  tile->last     = 0;
+
+  for (row = 0; row < height; row++)
+    {
+      src = (FAR const lfb_color_t *)
+        (session->fb + RFB_STRIDE * (y + row) + RFB_BYTESPERPIXEL * x);
+
+      for (col = 0; col < width; col++)
+        {
+          pixel = convert(*src++);
+
+          /* Add new colors to the palette until it overflows */
+
+          if (tile->npalette <= ZRLE_MAXPALETTE &&
+              vnc_zrle_lookup(tile, pixel) < 0)
+            {
+              if (tile->npalette < ZRLE_MAXPALETTE)
+                {
+                  tile->palette[tile->npalette] = pixel;
+                }
+
+              tile->npalette++;
+            }
+
+          /* Runs may continue from one row to the next */
+
+          if (runlen > 0 && pixel == prev)
+            {
+              runlen++;
+              continue;
+            }
+
+          if (runlen > 0)
+            {
+              lenbytes    = (runlen - 1) / 255 + 1;
+              rlesize    += cpb + lenbytes;
+              palrlesize += runlen == 1 ? 1 : 1 + lenbytes;
+            }
+
+          prev   = pixel;
+          runlen = 1;
+        }
+    }
+
+  lenbytes    = (runlen - 1) / 255 + 1;
+  rlesize    += cpb + lenbytes;
+  palrlesize += runlen == 1 ? 1 : 1 + lenbytes;
+
+  /* Raw is the fallback */
+
+  tile->subenc = RFB_ZRLE_RAW;
+  tile->size   = 1 + (size_t)width * height * cpb;
+
+  if (tile->npalette == 1)
+    {
+      tile->subenc = RFB_ZRLE_SOLID;
+      tile->size   = 1 + cpb;
+      return;
+    }
+
+  if (rlesize < tile->size)
+    {
+      tile->subenc = RFB_ZRLE_RLE;
+      tile->size   = rlesize;
+    }
+
+  if (tile->npalette <= ZRLE_MAXPACKED)
+    {
+      bits = tile->npalette <= 2 ? 1 : tile->npalette <= 4 ? 2 : 4;
+      size = 1 + tile->npalette * cpb +
+             height * ((width * bits + 7) >> 3);
+
+      if (size < tile->size)
+        {
+          tile->subenc = (uint8_t)tile->npalette;
+          tile->size   = size;
+        }
+    }
+
+  if (tile->npalette <= ZRLE_MAXPALETTE)
+    {
+      size = palrlesize + tile->npalette * cpb;
+      if (size < tile->size)
+        {
+          tile->subenc = RFB_ZRLE_PALRLE(tile->npalette);
+          tile->size   = size;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: vnc_zrle_encode
+ *
+ * Description:
+ *  Encode one tile with the sub-encoding selected by vnc_zrle_analyze().
+ *
+ * Returned Value:
+ *   The location following the encoded tile.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *vnc_zrle_encode(FAR struct vnc_session_s *session,
+                                    vnc_convert_t convert,
+                                    nxgl_coord_t x, nxgl_coord_t y,
+                                    nxgl_coord_t width, nxgl_coord_t height,
+                                    unsigned int cpb,
+                                    FAR struct zrle_tile_s *tile,
+                                    FAR uint8_t *dest)
+{
+  FAR const lfb_color_t *src;
+  uint32_t pixel;
+  uint32_t prev = 0;
+  unsigned int runlen = 0;
+  unsigned int bits = 0;
+  unsigned int i;
+  nxgl_coord_t row;
+  nxgl_coord_t col;
+  uint8_t subenc = tile->subenc;
+  uint8_t accum;
+  int nbits;
+  int index;
+
+  *dest++ = subenc;
+
+  if (subenc == RFB_ZRLE_SOLID)
+    {
+      return vnc_put_pixel(session, dest, tile->palette[0], cpb);
+    }
+
+  /* All palette types start with the palette */
+
+  if (subenc != RFB_ZRLE_RAW && subenc != RFB_ZRLE_RLE)
+    {
+      for (i = 0; i < tile->npalette; i++)
+        {
+          dest = vnc_put_pixel(session, dest, tile->palette[i], cpb);
+        }
+
+      if (subenc <= ZRLE_MAXPACKED)
+        {
+          bits = tile->npalette <= 2 ? 1 : tile->npalette <= 4 ? 2 : 4;
+        }
+    }
+
+  for (row = 0; row < height; row++)
+    {
+      src = (FAR const lfb_color_t *)
+        (session->fb + RFB_STRIDE * (y + row) + RFB_BYTESPERPIXEL * x);
+
+      accum = 0;
+      nbits = 0;
+
+      for (col = 0; col < width; col++)
+        {
+          pixel = convert(*src++);
+
+          if (subenc == RFB_ZRLE_RAW)
+            {
+              dest = vnc_put_pixel(session, dest, pixel, cpb);
+            }
+          else if (bits > 0)
+            {
+              /* Packed palette:  Leftmost pixel in the MS bits */
+
+              index  = vnc_zrle_lookup(tile, pixel);
+              accum  = (uint8_t)((accum << bits) | index);
+              nbits += bits;
+
+              if (nbits >= 8)
+                {
+                  *dest++ = accum;
+                  accum   = 0;
+                  nbits   = 0;
+                }
+            }
+          else if (runlen > 0 && pixel == prev)
+            {
+              runlen++;
+            }
+          else
+            {
+              /* Flush the previous run */
+
+              if (runlen > 0)
+                {
+                  if (subenc == RFB_ZRLE_RLE)
+                    {
+                      dest = vnc_put_pixel(session, dest, prev, cpb);
+                      dest = vnc_zrle_runlength(dest, runlen);
+                    }
+                  else
+                    {
+                      index = vnc_zrle_lookup(tile, prev);
+                      if (runlen == 1)
+                        {
+                          *dest++ = (uint8_t)index;
+                        }
+                      else
+                        {
+                          *dest++ = (uint8_t)(index | 0x80);
+                          dest    = vnc_zrle_runlength(dest, runlen);
+                        }
+                    }
+                }
+
+              prev   = pixel;
+              runlen = 1;
+            }
+        }
+
+      /* Packed rows are padded to a byte boundary */
+
+      if (nbits > 0)
+        {
+          *dest++ = (uint8_t)(accum << (8 - nbits));
+        }
+    }
+
+  /* Flush the final run */
+
+  if (runlen > 0)
+    {
+      if (subenc == RFB_ZRLE_RLE)
+        {
+          dest = vnc_put_pixel(session, dest, prev, cpb);
+          dest = vnc_zrle_runlength(dest, runlen);
+        }
+      else
+        {
+          index = vnc_zrle_lookup(tile, prev);
+          if (runlen == 1)
+            {
+              *dest++ = (uint8_t)index;
+            }
+          else
+            {
+              *dest++ = (uint8_t)(index | 0x80);
+              dest    = vnc_zrle_runlength(dest, runlen);
+            }
+        }
+    }
+
+  return dest;
+}
+
+/****************************************************************************
+ * Name: vnc_zrle_send
+ *
+ * Description:
+ *  Complete and send one ZRLE rectangle whose tile data has been encoded
+ *  into session->outbuf.
+ *
+ ****************************************************************************/
+
+static int vnc_zrle_send(FAR struct vnc_session_s *session,
+                         nxgl_coord_t x, nxgl_coord_t y,
+                         nxgl_coord_t width, nxgl_coord_t height,
+                         FAR uint8_t *block, size_t datalen)
+{
+  FAR uint8_t *zdata = &session->outbuf[ZRLE_HDRSIZE];
+  size_t zlen;
+
+  vnc_zlib_block(block, datalen);
+  zlen = block + VNC_ZLIB_BLKSIZE + datalen - zdata;
+
+  vnc_update_header(session, x, y, width, height, RFB_ENCODING_ZRLE);
+  rfb_putbe32(zdata - 4, zlen);
+
+  return vnc_send_update(session, session->outbuf, ZRLE_HDRSIZE + zlen);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_zrle
+ *
+ * Description:
+ *  Send the framebuffer update using the ZRLE encoding.
+ *
+ *  Each rectangle must be sent in one zlib block whose length precedes the
+ *  data.  The update is therefore split into rectangles that fit into the
+ *  output buffer:  If a whole 64x64 tile fits, each rectangle holds a row
+ *  of as many tiles as fit.  Otherwise each rectangle holds a single
+ *  smaller tile.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; A negated errno value is returned on failure that
+ *   indicates the nature of the failure.
+ *
+ ****************************************************************************/
+
+int vnc_zrle(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect)
+{
+  struct zrle_tile_s tile;
+  vnc_convert_t convert;
+  FAR uint8_t *block;
+  FAR uint8_t *data;
+  nxgl_coord_t tilew;
+  nxgl_coord_t tileh;
+  nxgl_coord_t maxh;
+  nxgl_coord_t x0;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+  nxgl_coord_t w;
+  unsigned int bpp;
+  unsigned int cpb;
+  size_t datalen;
+  int ret;
+
+  convert = vnc_convert_select(session->colorfmt);
+  if (convert == NULL)
+    {
+      gerr("ERROR: Unrecognized color format: %d\n", session->colorfmt);
+      return -EINVAL;
+    }
+
+  /* CPIXELs are 3 bytes if the 32-bit pixel has a depth of 24 or less */
+
+  bpp = (session->bpp + 7) >> 3;
+  cpb = (bpp == 4 && session->depth <= 24) ? 3 : bpp;
+
+  /* Select the largest tile whose raw encoding fits in the buffer */
+
+  tilew = MIN(ZRLE_TILE_SIZE, rect->pt2.x - rect->pt1.x + 1);
+  if (1 + tilew * cpb > ZRLE_MAXDATA)
+    {
+      tilew = (ZRLE_MAXDATA - 1) / cpb;
+    }
+
+  maxh = MIN(ZRLE_TILE_SIZE, (ZRLE_MAXDATA - 1) / (tilew * cpb));
+
+  for (y = rect->pt1.y; y <= rect->pt2.y; y += tileh)
+    {
+      tileh = MIN(maxh, rect->pt2.y - y + 1);
+
+      /* Start a new rectangle at the left edge */
+
+      x0      = rect->pt1.x;
+      block   = &session->outbuf[ZRLE_HDRSIZE];
+      block  += vnc_zlib_header(session, VNC_ZSTREAM_ZRLE, block);
+      data    = block + VNC_ZLIB_BLKSIZE;
+      datalen = 0;
+
+      for (x = rect->pt1.x; x <= rect->pt2.x; x += tilew)
+        {
+          w = MIN(tilew, rect->pt2.x - x + 1);
+          vnc_zrle_analyze(session, convert, x, y, w, tileh, cpb, &tile);
+
+          /* A rectangle may hold more than one tile only if they are the
+           * full ZRLE tile width.  Send the rectangle if it is full.
+           */
+
+          if (x > x0 &&
+              (tilew < ZRLE_TILE_SIZE || datalen + tile.size > ZRLE_MAXDATA))
+            {
+              ret = vnc_zrle_send(session, x0, y, x - x0, tileh,
+                                  block, datalen);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              x0      = x;
+              block   = &session->outbuf[ZRLE_HDRSIZE];
+              data    = block + VNC_ZLIB_BLKSIZE;
+              datalen = 0;
+            }
+
+          datalen = vnc_zrle_encode(session, convert, x, y, w, tileh, cpb,
+                                    &tile, &data[datalen]) - data;
+          DEBUGASSERT(datalen <= ZRLE_MAXDATA);
+        }
+
+      ret = vnc_zrle_send(session, x0, y, rect->pt2.x - x0 + 1, tileh,
+                          block, datalen);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+  return OK;
+}
@@ -43,6 +43,19 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CRC-32C (Castagnoli).  CRC32C_CHECK is the CRC32C of the string
+ * "123456789" without the null byte.
+ */
+
+#define CRC32C_POLY   ((uint32_t)0x82f63b78) /* Reflected form of 0x1edc6f41 */
+#define CRC32C_INIT   ((uint32_t)0xffffffff)
+#define CRC32C_XOROUT ((uint32_t)0xffffffff)
+#define CRC32C_CHECK  ((uint32_t)0xe3069283)
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -75,6 +88,29 @@ uint32_t crc32part(FAR const uint8_t *src, size_t len, uint32_t crc32val);
 
 uint32_t crc32(FAR const uint8_t *src, size_t len);
 
+/****************************************************************************
+ * Name: crc32cpart
+ *
+ * Description:
+ *   Continue CRC-32C calculation on a part of the buffer.  The initial
+ *   value is CRC32C_INIT and the final value must be XOR'ed with
+ *   CRC32C_XOROUT.
+ *
+ ****************************************************************************/
+
+uint32_t crc32cpart(FAR const uint8_t *src, size_t len, uint32_t crc32cval);
+
+/****************************************************************************
+ * Name: crc32c
+ *
+ * Description:
+ *   Return the CRC-32C (Castagnoli) of the contents of the 'src' buffer,
+ *   length 'len'.
+ *
+ ****************************************************************************/
+
+uint32_t crc32c(FAR const uint8_t *src, size_t len);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
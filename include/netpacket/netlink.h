@@ -306,6 +306,12 @@
 #define IFA_F_SECONDARY      0x01
 #define IFA_F_PERMANENT      0x80
 
+/* Values for rta_type */
+
+#define IFA_UNSPEC           0
+#define IFA_ADDRESS          1    /* Argument:  Interface address */
+#define IFA_LOCAL            2    /* Argument:  Local address (IPv4) */
+
 /* Definitions for struct ifinfomsg *****************************************/
 
 #define IFLA_RTA(r)          ((FAR struct rtattr *) \
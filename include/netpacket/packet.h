@@ -47,6 +47,39 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Packet socket options (level SOL_PACKET) */
+
+#define PACKET_RX_RING         5        /* Set up a receive ring (set only) */
+#define PACKET_TX_RING         13       /* Set up a transmit ring (set only) */
+
+/* Status of a frame slot in a receive ring */
+
+#define TP_STATUS_KERNEL       0        /* The slot belongs to the kernel */
+#define TP_STATUS_USER         (1 << 0) /* The slot holds a received frame */
+#define TP_STATUS_COPY         (1 << 1) /* The frame did not fit the slot */
+#define TP_STATUS_LOSING       (1 << 2) /* Frames were lost before this one */
+
+/* Status of a frame slot in a transmit ring */
+
+#define TP_STATUS_AVAILABLE    0        /* The slot belongs to the user */
+#define TP_STATUS_SEND_REQUEST (1 << 0) /* The frame is ready to send */
+#define TP_STATUS_SENDING      (1 << 1) /* The frame is being sent */
+#define TP_STATUS_WRONG_FORMAT (1 << 2) /* The frame could not be sent */
+
+/* Frame slots and the frame data within them are aligned to this */
+
+#define TPACKET_ALIGNMENT      16
+#define TPACKET_ALIGN(x) \
+  (((x) + TPACKET_ALIGNMENT - 1) & ~(TPACKET_ALIGNMENT - 1))
+
+/* Offset of the frame data from the start of a frame slot */
+
+#define TPACKET_HDRLEN         TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -58,4 +91,44 @@ struct sockaddr_ll
   int16_t  sll_ifindex;
 };
 
+/* Describes the ring passed with PACKET_RX_RING or PACKET_TX_RING.  The
+ * ring is tp_frame_nr slots of tp_frame_size bytes each.
+ *
+ * Unlike Linux, where the kernel allocates the ring and the user maps it
+ * with mmap(), the caller provides the memory here.  It must stay valid
+ * until the ring is removed again (tp_frame_nr of zero) or the socket is
+ * closed.
+ */
+
+struct tpacket_req
+{
+  FAR void *tp_ring;          /* Memory that holds the ring */
+  unsigned int tp_frame_size; /* Slot size, a multiple of TPACKET_ALIGNMENT */
+  unsigned int tp_frame_nr;   /* Number of slots */
+};
+
+/* Each frame slot begins with this header.  The frame itself follows at
+ * offset TPACKET_HDRLEN.
+ *
+ * The kernel fills a receive slot that is TP_STATUS_KERNEL and then hands
+ * it to the user by setting TP_STATUS_USER.  The user gives it back by
+ * setting TP_STATUS_KERNEL again.
+ *
+ * The user fills a transmit slot that is TP_STATUS_AVAILABLE, sets tp_len
+ * and then TP_STATUS_SEND_REQUEST.  send() with a zero length sends all of
+ * the requested slots in ring order, and hands each back as
+ * TP_STATUS_AVAILABLE.
+ */
+
+struct tpacket_hdr
+{
+  volatile uint32_t tp_status; /* TP_STATUS_* */
+  uint32_t tp_len;             /* Length of the frame */
+  uint32_t tp_snaplen;         /* Length of the frame data in the slot */
+  uint16_t tp_mac;             /* Offset of the frame data in the slot */
+  uint16_t tp_net;             /* Offset of the network header */
+  uint32_t tp_sec;             /* Time when the frame was received */
+  uint32_t tp_usec;
+};
+
 #endif /* __INCLUDE_NETPACKET_PACKET_H */
@@ -2438,7 +2438,7 @@ void arch_sporadic_resume(FAR struct tcb_s *tcb);
  *   units.
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_CRITMONITOR
+#if defined(CONFIG_SCHED_CRITMONITOR) || defined(CONFIG_SCHED_LATENCYMON)
 uint32_t up_critmon_gettime(void);
 void up_critmon_convert(uint32_t elapsed, FAR struct timespec *ts);
 #endif
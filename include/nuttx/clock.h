@@ -219,6 +219,23 @@ typedef int64_t sclock_t;
 typedef int32_t sclock_t;
 #endif
 
+/* The time page is a read-only view of the system time that the OS keeps
+ * up to date on every timer tick and on every change of the time-of-day.
+ * It lives in memory that user space can read, so the C library can
+ * implement clock_gettime() without a system call.  'seq' is odd while
+ * the OS is updating the page; a reader must retry if it saw an odd value
+ * or if 'seq' changed while it was copying the times out.
+ */
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+struct clock_timepage_s
+{
+  volatile uint32_t seq;      /* Update sequence number */
+  struct timespec monotonic;  /* Time since power up */
+  struct timespec basetime;   /* Time-of-day at power up */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -413,6 +430,43 @@ clock_t clock_systime_ticks(void);
 
 int clock_systime_timespec(FAR struct timespec *ts);
 
+/****************************************************************************
+ * Name: nx_clock_gettime
+ *
+ * Description:
+ *   Return the current value of the clock 'clock_id'.  This is the OS
+ *   side of clock_gettime() and behaves the same way, including setting
+ *   the errno value on failure.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to be read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   OK (0) on success; ERROR (-1) on failure with the errno value set.
+ *
+ ****************************************************************************/
+
+int nx_clock_gettime(clockid_t clock_id, FAR struct timespec *tp);
+
+/****************************************************************************
+ * Name: clock_timepage
+ *
+ * Description:
+ *   Return the address of the time page.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The address of the time page or NULL if it could not be allocated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+FAR const struct clock_timepage_s *clock_timepage(void);
+#endif
+
 /****************************************************************************
  * Name:  clock_cpuload
  *
@@ -97,6 +97,7 @@
 #define _NXTERMBASE     (0x2900) /* NxTerm character driver ioctl commands */
 #define _RFIOCBASE      (0x2a00) /* RF devices ioctl commands */
 #define _RPTUNBASE      (0x2b00) /* Remote processor tunnel ioctl commands */
+#define _USRSOCKBASE    (0x2c00) /* User-space socket daemon ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -176,6 +177,11 @@
                                            *      int value.
                                            * OUT: Origin option.
                                            */
+#define FIOC_RESETSTAT  _FIOC(0x000c)     /* Clear the statistics reported by
+                                           *      a procfs file.
+                                           * IN:  None
+                                           * OUT: None
+                                           */
 
 /* NuttX file system ioctl definitions **************************************/
 
@@ -270,6 +276,12 @@
                                            * IN:  None
                                            * OUT: None (ioctl return value provides
                                            *      success/failure indication). */
+#define BIOC_FTLSTATS   _BIOC(0x000e)     /* Return log-structured FTL statistics
+                                           * IN:  Pointer to writable instance
+                                           *      of struct ftl_stats_s (see
+                                           *      include/nuttx/mtd/mtd.h)
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -510,6 +522,11 @@
 #define _RPTUNIOCVALID(c)   (_IOC_TYPE(c)==_RPTUNBASE)
 #define _RPTUNIOC(nr)       _IOC(_RPTUNBASE,nr)
 
+/* User-space socket daemon driver (see nuttx/net/usrsock.h) ***************/
+
+#define _USRSOCKIOCVALID(c) (_IOC_TYPE(c)==_USRSOCKBASE)
+#define _USRSOCKIOC(nr)     _IOC(_USRSOCKBASE,nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
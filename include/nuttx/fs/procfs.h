@@ -89,6 +89,10 @@ struct procfs_operations
   /* Operations on paths */
 
   int     (*stat)(FAR const char *relpath, FAR struct stat *buf);
+
+  /* Optional ioctl method of an open file */
+
+  int     (*ioctl)(FAR struct file *filep, int cmd, unsigned long arg);
 };
 
 /* Procfs handler prototypes ************************************************/
@@ -212,6 +216,30 @@ size_t procfs_memcpy(FAR const char *src, size_t srclen,
 int procfs_register(FAR const struct procfs_entry_s *entry);
 #endif
 
+/****************************************************************************
+ * Name: procfs_latency
+ *
+ * Description:
+ *   Format a set of scheduling latency statistics for a procfs/ file.
+ *   This is the common part of the "latency" and "<pid>/schedstat" files.
+ *
+ * Input Parameters:
+ *   latency - The statistics to be formatted
+ *   buffer  - The address of the user's receive buffer.
+ *   buflen  - The size (in bytes) of the user's receive buffer.
+ *   offset  - The number of bytes to skip, as for procfs_memcpy().
+ *
+ * Returned Value:
+ *   The number of bytes actually transferred into the user's receive buffer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LATENCYMON
+struct latencymon_s;
+size_t procfs_latency(FAR const struct latencymon_s *latency,
+                      FAR char *buffer, size_t buflen, FAR off_t *offset);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -142,6 +142,24 @@ struct mtd_byte_write_s
   const uint8_t *buffer;  /* Pointer to the data to write */
 };
 
+/* Statistics returned by the log-structured FTL in response to the
+ * BIOC_FTLSTATS ioctl command.  The write amplification is flashwrites /
+ * hostwrites.
+ */
+
+struct ftl_stats_s
+{
+  uint32_t hostwrites;    /* Sectors written through the block driver */
+  uint32_t flashwrites;   /* Pages programmed, including GC and summaries */
+  uint32_t erases;        /* Erase blocks erased */
+  uint32_t collections;   /* Erase blocks reclaimed by garbage collection */
+  uint32_t wlmoves;       /* Cold erase blocks moved by static wear leveling */
+  uint32_t checkpoints;   /* Summaries written before the block was full */
+  uint32_t minerase;      /* Lowest erase count of any erase block */
+  uint32_t maxerase;      /* Highest erase count of any erase block */
+  uint32_t freeblocks;    /* Erase blocks available for allocation */
+};
+
 /* This structure defines the interface to a simple memory technology device.
  * It will likely need to be extended in the future to support more complex
  * devices.
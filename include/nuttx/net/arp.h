@@ -87,6 +87,18 @@ struct arp_entry_s
   clock_t           at_time;     /* Time of last usage */
 };
 
+#ifdef CONFIG_NET_STATISTICS
+/* ARP table statistics */
+
+struct arp_stats_s
+{
+  net_stats_t hit;       /* Number of successful ARP table lookups */
+  net_stats_t miss;      /* Number of ARP table lookups that failed */
+  net_stats_t evict;     /* Number of entries replaced to make room */
+  net_stats_t refresh;   /* Number of ARP requests sent to refresh entries */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
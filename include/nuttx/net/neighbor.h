@@ -102,6 +102,17 @@ struct neighbor_entry_s
   clock_t                ne_time;    /* For aging, units of tick */
 };
 
+#ifdef CONFIG_NET_STATISTICS
+/* Neighbor table statistics */
+
+struct neighbor_stats_s
+{
+  net_stats_t hit;       /* Number of successful Neighbor table lookups */
+  net_stats_t miss;      /* Number of Neighbor table lookups that failed */
+  net_stats_t evict;     /* Number of entries replaced to make room */
+};
+#endif
+
 #ifdef __cplusplus
 #define EXTERN extern "C"
 extern "C"
@@ -181,6 +181,7 @@ typedef uint8_t sockcaps_t;
 struct file;    /* Forward reference */
 struct socket;  /* Forward reference */
 struct pollfd;  /* Forward reference */
+struct msghdr;  /* Forward reference */
 
 struct sock_intf_s
 {
@@ -219,6 +220,10 @@ struct sock_intf_s
   CODE int        (*si_ioctl)(FAR struct socket *psock, int cmd,
                     FAR void *arg, size_t arglen);
 #endif
+  CODE ssize_t    (*si_sendmsg)(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
+  CODE ssize_t    (*si_recvmsg)(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
 };
 
 /* Each socket refers to a connection structure of type FAR void *.  Each
@@ -600,6 +605,28 @@ FAR struct socket *sockfd_socket(int sockfd);
 int psock_socket(int domain, int type, int protocol,
                  FAR struct socket *psock);
 
+/****************************************************************************
+ * Name: psock_socketpair
+ *
+ * Description:
+ *   Create an unnamed pair of connected sockets.  This is the internal OS
+ *   interface of socketpair().
+ *
+ * Input Parameters:
+ *   domain   (see sys/socket.h)
+ *   type     (see sys/socket.h)
+ *   protocol (see sys/socket.h)
+ *   psocks   Two user allocated socket structures to be initialized.
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.
+ *
+ ****************************************************************************/
+
+int psock_socketpair(int domain, int type, int protocol,
+                     FAR struct socket *psocks[2]);
+
 /****************************************************************************
  * Name: net_close
  *
@@ -1016,6 +1043,62 @@ ssize_t psock_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 #define psock_recv(psock,buf,len,flags) \
   psock_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_sendmsg
+ *
+ * Description:
+ *   psock_sendmsg() sends a message described by a msghdr structure on a
+ *   socket.  This is an internal OS interface.  It is functionally
+ *   equivalent to sendmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - The message to send
+ *   flags - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On any failure, a
+ *   negated errno value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_sendmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives a message into the buffers described by a
+ *   msghdr structure.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Describes the buffers to receive the message
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly
+ *   shutdown, zero is returned.  Otherwise, on any failure, a negated errno
+ *   value is returned.
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
 /****************************************************************************
  * Name: nx_recvfrom
  *
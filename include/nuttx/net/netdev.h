@@ -214,6 +214,22 @@ struct netdev_varaddr_s
 };
 #endif
 
+#ifdef CONFIG_NET_TXREADY
+/* A connection with pending output is queued on the TX-ready list of the
+ * device that it will send on.  devif_poll() then offers a TX opportunity
+ * only to the connections on that list.
+ */
+
+struct net_driver_s; /* Forward reference */
+
+struct devif_txready_s
+{
+  dq_entry_t node;                  /* Link in the d_txready list */
+  FAR struct net_driver_s *dev;     /* Queued on this device, NULL if none */
+  uint8_t proto;                    /* IP_PROTO_TCP or IP_PROTO_UDP */
+};
+#endif
+
 /* This structure collects information that is specific to a specific network
  * interface driver.  If the hardware platform supports only a single instance
  * of this structure.
@@ -381,6 +397,25 @@ struct net_driver_s
   FAR struct devif_callback_s *d_conncb;
   FAR struct devif_callback_s *d_devcb;
 
+#ifdef CONFIG_NET_TXREADY
+  /* Connections that have pending output for this device.  See struct
+   * devif_txready_s.
+   */
+
+  dq_queue_t d_txready;
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  /* TCP connections bound to this device that have a timer running, hashed
+   * by the half-second tick at which tcp_timer() has to see them next.
+   * Those that are due but have not been served yet wait in d_tcpdue.
+   */
+
+  uint32_t   d_tcptick;     /* Half-seconds counted by devif_timer() */
+  dq_queue_t d_tcpdue;      /* Due TCP connections */
+  dq_queue_t d_tcpwheel[CONFIG_NET_TCP_TIMERWHEEL_SLOTS];
+#endif
+
   /* Driver callbacks */
 
   int (*d_ifup)(FAR struct net_driver_s *dev);
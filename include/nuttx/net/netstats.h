@@ -57,6 +57,12 @@
 #ifdef CONFIG_NET_UDP
 #  include <nuttx/net/udp.h>
 #endif
+#ifdef CONFIG_NET_ARP
+#  include <nuttx/net/arp.h>
+#endif
+#ifdef CONFIG_NET_IPv6
+#  include <nuttx/net/neighbor.h>
+#endif
 #ifdef CONFIG_NET_ICMP
 #  include <nuttx/net/icmp.h>
 #endif
@@ -80,6 +86,36 @@
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_NET_IPFORWARD
+/* The structure holding the IP forwarding statistics.  Forwarded packets
+ * that are dropped are counted with the IPv4 and IPv6 statistics.
+ */
+
+struct ipfwd_stats_s
+{
+  net_stats_t forward;          /* Number of packets queued for forwarding */
+  net_stats_t hit;              /* Number of flow cache hits */
+  net_stats_t miss;             /* Number of flow cache misses */
+};
+#endif
+
+#ifdef CONFIG_NET_6LOWPAN
+/* The structure holding the 6LoWPAN fragmentation and reassembly
+ * statistics.
+ */
+
+struct sixlowpan_stats_s
+{
+  net_stats_t txframe;          /* Number of frames sent */
+  net_stats_t txfrag;           /* Number of packets sent as fragments */
+  net_stats_t rxframe;          /* Number of frames received */
+  net_stats_t rxfrag;           /* Number of fragments received */
+  net_stats_t reass;            /* Number of packets reassembled */
+  net_stats_t timeout;          /* Number of reassemblies timed out */
+  net_stats_t drop;             /* Number of fragments dropped */
+};
+#endif
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -94,6 +130,22 @@ struct net_stats_s
   struct ipv6_stats_s ipv6;     /* IPv6 statistics */
 #endif
 
+#ifdef CONFIG_NET_ARP
+  struct arp_stats_s  arp;      /* ARP table statistics */
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  struct neighbor_stats_s nd;   /* Neighbor table statistics */
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD
+  struct ipfwd_stats_s ipfwd;   /* IP forwarding statistics */
+#endif
+
+#ifdef CONFIG_NET_6LOWPAN
+  struct sixlowpan_stats_s sixlowpan; /* 6LoWPAN statistics */
+#endif
+
 #ifdef CONFIG_NET_ICMP
   struct icmp_stats_s icmp;     /* ICMP statistics */
 #endif
@@ -47,6 +47,7 @@
 
 #include <nuttx/net/netconfig.h>
 #include <nuttx/compiler.h>
+#include <nuttx/fs/ioctl.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -74,6 +75,38 @@
 #define USRSOCK_MESSAGE_REQ_COMPLETED(flags) \
                           (!USRSOCK_MESSAGE_REQ_IN_PROGRESS(flags))
 
+/* /dev/usrsock ioctl commands
+ *
+ * USRSOCKIOC_SETRING
+ *   Description: Attach the shared-memory request rings described by a
+ *                struct usrsock_ring_s.  From then on requests are put in
+ *                the submission ring instead of being read().  A ring with
+ *                no slots detaches the current rings.
+ *   Argument:    A pointer to a struct usrsock_ring_s
+ *   Return:      Zero (OK) on success, a negated errno value on failure
+ *
+ * USRSOCKIOC_KICK
+ *   Description: Handle all messages in the completion ring, in order, as
+ *                if they had been written to /dev/usrsock.  This also tells
+ *                the kernel that submission slots have been handed back.
+ *   Argument:    None
+ *   Return:      The number of messages handled, or a negated errno value
+ */
+
+#define USRSOCKIOC_SETRING     _USRSOCKIOC(0x0001)
+#define USRSOCKIOC_KICK        _USRSOCKIOC(0x0002)
+
+/* Ownership of a ring slot, see struct usrsock_ringslot_s */
+
+#define USRSOCK_SLOT_FREE      0  /* Owned by the producer */
+#define USRSOCK_SLOT_READY     1  /* Holds a message for the consumer */
+
+/* The position of slot 'i' in a ring with slots of 'size' bytes */
+
+#define USRSOCK_RING_SLOT(base, size, i) \
+  ((FAR struct usrsock_ringslot_s *)((FAR uint8_t *)(base) + \
+                                     (size_t)(i) * (size)))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -267,4 +300,32 @@ begin_packed_struct struct usrsock_message_socket_event_s
   uint16_t events;
 } end_packed_struct;
 
+/* Shared-memory request rings.  Each ring is an array of 'nslots' slots of
+ * 'slotsize' bytes in memory provided by the daemon.  A slot starts with a
+ * struct usrsock_ringslot_s which is followed by one message in the same
+ * format as used with read() and write().  The producer fills the slots in
+ * ring order and marks them USRSOCK_SLOT_READY; the consumer takes them in
+ * the same order and marks them USRSOCK_SLOT_FREE again.
+ *
+ * The kernel produces requests into the submission ring and reports POLLIN
+ * on /dev/usrsock while any are pending.  The daemon produces responses and
+ * events into the completion ring and issues USRSOCKIOC_KICK to have a
+ * whole batch of them handled at once.  A data response may continue in
+ * the following slots.
+ */
+
+struct usrsock_ringslot_s
+{
+  volatile uint16_t status;   /* USRSOCK_SLOT_FREE or USRSOCK_SLOT_READY */
+  uint16_t len;               /* Length of the message in the slot */
+};
+
+struct usrsock_ring_s
+{
+  FAR void *sq;               /* Submission ring (kernel => daemon) */
+  FAR void *cq;               /* Completion ring (kernel <= daemon) */
+  uint16_t slotsize;          /* Size of one slot, including its header */
+  uint16_t nslots;            /* Number of slots in each ring */
+};
+
 #endif /* __INCLUDE_NUTTX_NET_USRSOCK_H */
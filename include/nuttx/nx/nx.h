@@ -943,6 +943,61 @@ int nx_bitmap(NXWINDOW hwnd, FAR const struct nxgl_rect_s *dest,
               FAR const void *src[CONFIG_NX_NPLANES],
               FAR const struct nxgl_point_s *origin, unsigned int stride);
 
+/****************************************************************************
+ * Name: nx_blendrectangle
+ *
+ * Description:
+ *   Blend a color with the given opacity over the specified rectangle in
+ *   the window.  The window must be on a 16-, 24- or 32-bit RGB
+ *   framebuffer; nothing is drawn otherwise.
+ *
+ * Input Parameters:
+ *   hwnd  - The window handle
+ *   rect  - The location to be blended
+ *   color - The color to blend
+ *   alpha - The opacity of the color, from 0 (transparent) to 255 (opaque)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_ALPHABLEND
+int nx_blendrectangle(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
+                      nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                      uint8_t alpha);
+
+/****************************************************************************
+ * Name: nx_blendbitmap
+ *
+ * Description:
+ *   Blend a rectangular region of a larger image with the given opacity
+ *   into the rectangle in the specified window.  The image must have the
+ *   pixel format of the display.
+ *
+ * Input Parameters:
+ *   hwnd   - The window that will receive the bitmap image
+ *   dest   - Describes the rectangular region on the display that will
+ *            receive the bit map.
+ *   src    - The start of the source image.  This is an array source
+ *            images of size CONFIG_NX_NPLANES.
+ *   origin - The origin of the upper, left-most corner of the full bitmap.
+ *            Both dest and origin are in window coordinates, however, origin
+ *            may lie outside of the display.
+ *   stride - The width of the full source image in bytes.
+ *   alpha  - The opacity of the image, from 0 (transparent) to 255 (opaque)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nx_blendbitmap(NXWINDOW hwnd, FAR const struct nxgl_rect_s *dest,
+                   FAR const void *src[CONFIG_NX_NPLANES],
+                   FAR const struct nxgl_point_s *origin,
+                   unsigned int stride, uint8_t alpha);
+#endif
+
 /****************************************************************************
  * Name: nx_notify_rectangle
  *
@@ -158,6 +158,8 @@ enum nxmsg_e
   NX_SVRMSG_FILLTRAP,         /* Fill a trapezoidal region in the window with a color */
   NX_SVRMSG_MOVE,             /* Move a rectangular region within the window */
   NX_SVRMSG_BITMAP,           /* Copy a rectangular bitmap into the window */
+  NX_SVRMSG_BLENDRECT,        /* Blend a color over a rectangle in the window */
+  NX_SVRMSG_BLENDBITMAP,      /* Blend a rectangular bitmap into the window */
   NX_SVRMSG_SETBGCOLOR,       /* Set the color of the background */
   NX_SVRMSG_MOUSEIN,          /* New mouse report from mouse client */
   NX_SVRMSG_KBDIN,            /* New keyboard report from keyboard client */
@@ -475,6 +477,31 @@ struct nxsvrmsg_bitmap_s
   sem_t *sem_done;                /* Semaphore to report when command is done. */
 };
 
+/* Blend a color over a rectangle in the window */
+
+struct nxsvrmsg_blendrect_s
+{
+  uint32_t msgid;                  /* NX_SVRMSG_BLENDRECT */
+  FAR struct nxbe_window_s *wnd;   /* The window to blend into */
+  struct nxgl_rect_s rect;         /* The rectangle in the window to blend */
+  nxgl_mxpixel_t color[CONFIG_NX_NPLANES]; /* Color to blend */
+  uint8_t alpha;                   /* Opacity of the color (0-255) */
+};
+
+/* Blend a rectangular bitmap into the window */
+
+struct nxsvrmsg_blendbitmap_s
+{
+  uint32_t msgid;                 /* NX_SVRMSG_BLENDBITMAP */
+  FAR struct nxbe_window_s *wnd;  /* The window with will receive the bitmap image  */
+  struct nxgl_rect_s dest;        /* Destination location of the bitmap in the window */
+  FAR const void *src[CONFIG_NX_NPLANES]; /* The start of the source image. */
+  struct nxgl_point_s origin;     /* Offset into the source image data */
+  unsigned int stride;            /* The width of the full source image in bytes. */
+  uint8_t alpha;                  /* Opacity of the bitmap (0-255) */
+  sem_t *sem_done;                /* Semaphore to report when command is done. */
+};
+
 /* Set the color of the background */
 
 struct nxsvrmsg_setbgcolor_s
@@ -573,6 +573,60 @@ int nxtk_bitmapwindow(NXTKWINDOW hfwnd, FAR const struct nxgl_rect_s *dest,
                       FAR const struct nxgl_point_s *origin,
                       unsigned int stride);
 
+/****************************************************************************
+ * Name: nxtk_blendwindow
+ *
+ * Description:
+ *   Blend a color with the given opacity over the specified rectangle in
+ *   the client window.
+ *
+ * Input Parameters:
+ *   hfwnd - The window handle returned by nxtk_openwindow
+ *   rect  - The location within the client window to be blended
+ *   color - The color to blend
+ *   alpha - The opacity of the color, from 0 (transparent) to 255 (opaque)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_ALPHABLEND
+int nxtk_blendwindow(NXTKWINDOW hfwnd, FAR const struct nxgl_rect_s *rect,
+                     nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                     uint8_t alpha);
+
+/****************************************************************************
+ * Name: nxtk_blendbitmapwindow
+ *
+ * Description:
+ *   Blend a rectangular region of a larger image with the given opacity
+ *   into the rectangle in the specified client sub-window.
+ *
+ * Input Parameters:
+ *   hfwnd    The client sub-window that will receive the bitmap image
+ *   dest   - Describes the rectangular region on in the client sub-window
+ *            will receive the bit map.
+ *   src    - The start of the source image(s). This is an array source
+ *            images of size CONFIG_NX_NPLANES.
+ *   origin - The origin of the upper, left-most corner of the full bitmap.
+ *            Both dest and origin are in sub-window coordinates, however, the
+ *            origin may lie outside of the sub-window display.
+ *   stride - The width of the full source image in bytes.
+ *   alpha  - The opacity of the image, from 0 (transparent) to 255 (opaque)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nxtk_blendbitmapwindow(NXTKWINDOW hfwnd,
+                           FAR const struct nxgl_rect_s *dest,
+                           FAR const void **src,
+                           FAR const struct nxgl_point_s *origin,
+                           unsigned int stride, uint8_t alpha);
+#endif
+
 /****************************************************************************
  * Name: nxtk_opentoolbar
  *
@@ -43,8 +43,16 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
+#include <stdint.h>
 #include <pthread.h>
 #include <sched.h>
+#include <unistd.h>
+
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && defined(CONFIG_TLS_ALIGNED) && \
+    !defined(__KERNEL__)
+#  include <arch/tls.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -110,6 +118,31 @@
   }
 #endif
 
+/* Mutex fast path **********************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+#  ifndef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+#    error CONFIG_PTHREAD_MUTEX_FASTPATH needs a lock-free 32-bit cmpxchg
+#  endif
+
+/* Only mutexes that need no owner tracking by the OS may be locked from
+ * user space:  A robust mutex must be found and marked inconsistent when
+ * its holder exits, so those always go through the OS.  When both forms
+ * are supported, all non-NORMAL mutex types are also treated as robust.
+ */
+
+#  if defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
+#    define pthread_mutex_isfast(m) true
+#  elif defined(CONFIG_PTHREAD_MUTEX_TYPES)
+#    define pthread_mutex_isfast(m) \
+       (((m)->flags & _PTHREAD_MFLAGS_ROBUST) == 0 && \
+        (m)->type == PTHREAD_MUTEX_NORMAL)
+#  else
+#    define pthread_mutex_isfast(m) \
+       (((m)->flags & _PTHREAD_MFLAGS_ROBUST) == 0)
+#  endif
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -128,10 +161,86 @@ extern "C"
 
 EXTERN const pthread_attr_t g_default_pthread_attr;
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Name: pthread_mutex_cmpxchg
+ *
+ * Description:
+ *   Atomically replace the mutex lock word with 'newval' if it still holds
+ *   'oldval'.
+ *
+ * Returned Value:
+ *   true if the lock word was replaced.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_cmpxchg(FAR pthread_mutex_t *mutex,
+                                         uint32_t oldval, uint32_t newval)
+{
+  return __atomic_compare_exchange_n(&mutex->lock, &oldval, newval, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_self
+ *
+ * Description:
+ *   Return the lock word value that marks the mutex as held by the calling
+ *   thread.  In user space the thread ID is read from the TLS area when it
+ *   is available, so that no system call is needed.
+ *
+ ****************************************************************************/
+
+static inline uint32_t pthread_mutex_self(void)
+{
+#if defined(CONFIG_TLS_ALIGNED) && !defined(__KERNEL__)
+  FAR struct tls_info_s *info = up_tls_info();
+
+  if (info->tl_pid == 0)
+    {
+      info->tl_pid = getpid();
+    }
+
+  return _PTHREAD_MLOCK_LOCKED |
+         ((uint32_t)info->tl_pid & _PTHREAD_MLOCK_PIDMASK);
+#else
+  return _PTHREAD_MLOCK_LOCKED |
+         ((uint32_t)getpid() & _PTHREAD_MLOCK_PIDMASK);
+#endif
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: nx_pthread_mutex_timedlock, nx_pthread_mutex_trylock,
+ *       nx_pthread_mutex_unlock
+ *
+ * Description:
+ *   These are the OS halves of pthread_mutex_timedlock(),
+ *   pthread_mutex_trylock() and pthread_mutex_unlock().  The C library
+ *   versions try to complete the operation in user space first and call
+ *   these only when the caller must block, must wake a waiter, or the
+ *   mutex is one that the OS must track.
+ *
+ * Returned Value:
+ *   Same as the corresponding standard interface.
+ *
+ ****************************************************************************/
+
+int nx_pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                               FAR const struct timespec *abs_timeout);
+int nx_pthread_mutex_trylock(FAR pthread_mutex_t *mutex);
+int nx_pthread_mutex_unlock(FAR pthread_mutex_t *mutex);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
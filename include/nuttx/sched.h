@@ -399,6 +399,28 @@ struct stackinfo_s
                                          /* The initial stack pointer value     */
 };
 
+/* struct latencymon_s **********************************************************/
+
+/* Scheduling latency statistics of one task or of one CPU.  Times are in the
+ * units of up_critmon_gettime().  Histogram entry n counts the events whose
+ * time t satisfies flsl(t >> CONFIG_SCHED_LATENCYMON_SHIFT) == n; the last
+ * entry also counts everything longer.
+ */
+
+#ifdef CONFIG_SCHED_LATENCYMON
+struct latencymon_s
+{
+  uint32_t nswitch;                      /* Number of times switched in         */
+  uint32_t npreempt;                     /* Number of involuntary switches out  */
+  uint32_t wakeup_max;                   /* Max time from ready to running      */
+
+  /* Histograms of the time from ready to running and of the run slices */
+
+  uint32_t wakeup[CONFIG_SCHED_LATENCYMON_NBUCKETS];
+  uint32_t slice[CONFIG_SCHED_LATENCYMON_NBUCKETS];
+};
+#endif
+
 /* struct task_group_s **********************************************************/
 
 /* All threads created by pthread_create belong in the same task group (along
@@ -708,6 +730,14 @@ struct tcb_s
   uint32_t crit_max;                     /* Max time in critical section        */
 #endif
 
+  /* Scheduling latency monitor support *****************************************/
+
+#ifdef CONFIG_SCHED_LATENCYMON
+  uint32_t ready_start;                  /* Time when made ready-to-run         */
+  uint32_t run_start;                    /* Time when switched in               */
+  struct latencymon_s latency;           /* Scheduling latency statistics       */
+#endif
+
   /* State save areas ***********************************************************/
 
   /* The form and content of these fields are platform-specific.                */
@@ -822,6 +852,16 @@ EXTERN uint32_t g_crit_max[1];
 #endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
+#ifdef CONFIG_SCHED_LATENCYMON
+/* Scheduling latency statistics of each CPU */
+
+#ifdef CONFIG_SMP_NCPUS
+EXTERN struct latencymon_s g_latency[CONFIG_SMP_NCPUS];
+#else
+EXTERN struct latencymon_s g_latency[1];
+#endif
+#endif /* CONFIG_SCHED_LATENCYMON */
+
 /********************************************************************************
  * Public Function Prototypes
  ********************************************************************************/
@@ -79,6 +79,7 @@ struct tls_info_s
   uintptr_t tl_elem[CONFIG_TLS_NELEM]; /* TLS elements */
 #endif
   int tl_errno;                        /* Per-thread error number */
+  pid_t tl_pid;                        /* Cached ID of this thread */
 };
 
 /****************************************************************************
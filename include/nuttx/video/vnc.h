@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -61,6 +62,24 @@ typedef CODE void (*vnc_mouseout_t)(FAR void *arg, nxgl_coord_t x,
 typedef CODE void (*vnc_kbdout_t)(FAR void *arg, uint8_t nch,
                                   FAR const uint8_t *ch);
 
+#ifdef CONFIG_VNCSERVER_STATS
+/* Per-session statistics returned by vnc_stats().  Counts are accumulated
+ * from the time that the client connected or from the last reset.
+ */
+
+struct vnc_stats_s
+{
+  uint32_t elapsed;              /* Time since connection/reset (msec) */
+  uint32_t nupdates;             /* Number of FramebufferUpdate messages */
+  uint32_t nrects;               /* Number of rectangles sent */
+  uint32_t npixels;              /* Number of pixels sent */
+  uint64_t nbytes;               /* Number of bytes sent */
+  uint32_t nlatency;             /* Number of latency samples */
+  uint32_t totlatency;           /* Sum of latency samples (msec) */
+  uint32_t maxlatency;           /* Maximum change-to-send latency (msec) */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -204,6 +223,29 @@ void vnc_mouseout(FAR void *arg, nxgl_coord_t x, nxgl_coord_t y,
 
 #endif
 
+/****************************************************************************
+ * Name: vnc_stats
+ *
+ * Description:
+ *   Return the statistics of the current session on the display.  The
+ *   average bandwidth is nbytes / elapsed and the average latency is
+ *   totlatency / nlatency.
+ *
+ * Input Parameters:
+ *   display - The display number of the session
+ *   stats   - The location to return the statistics
+ *   reset   - True: Reset the counters after they have been returned
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.  -ENOTCONN is returned if there is no connected client.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_STATS
+int vnc_stats(int display, FAR struct vnc_stats_s *stats, bool reset);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
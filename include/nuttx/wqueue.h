@@ -265,6 +265,19 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   clock_t qtime;         /* Time work queued */
   clock_t delay;         /* Delay until work performed */
+  clock_t deadline;      /* Time by which the work should be performed */
+};
+
+/* Statistics of one kernel work queue, as returned by work_getstats() */
+
+struct work_stats_s
+{
+  size_t   nready;       /* Number of work items ready to run now */
+  size_t   ndelayed;     /* Number of work items waiting for their delay */
+  size_t   maxready;     /* Largest number of work items ever ready */
+  uint32_t nprocessed;   /* Number of work items performed */
+  clock_t  maxlatency;   /* Longest time from ready to performed (ticks) */
+  uint64_t totlatency;   /* Sum of those times, for the average (ticks) */
 };
 
 /* This is an enumeration of the various events that may be
@@ -365,6 +378,42 @@ int work_usrstart(void);
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_deadline
+ *
+ * Description:
+ *   Queue work like work_queue(), but allow it to wait up to 'slack' clock
+ *   ticks after its delay has expired.  Work that is ready to run is
+ *   performed in order of deadline, so work with less slack is performed
+ *   before work with more.  work_queue() is the same as a slack of zero.
+ *
+ *   The user-space work queue does not order work by deadline and ignores
+ *   the slack.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the worker callback when
+ *            it is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *   slack  - How long (in clock ticks) the work may wait once it is ready.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_LIB_USRWORK) && !defined(__KERNEL__)
+#  define work_queue_deadline(qid, work, worker, arg, delay, slack) \
+     work_queue(qid, work, worker, arg, delay)
+#else
+int work_queue_deadline(int qid, FAR struct work_s *work, worker_t worker,
+                        FAR void *arg, clock_t delay, clock_t slack);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -422,6 +471,44 @@ int work_signal(int qid);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Get the depth and latency statistics of a kernel work queue.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WQUEUE_STATISTICS
+int work_getstats(int qid, FAR struct work_stats_s *stats);
+#endif
+
+/****************************************************************************
+ * Name: work_resetstats
+ *
+ * Description:
+ *   Clear the high-water mark and the latency statistics of a kernel work
+ *   queue.  The current depths are kept.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WQUEUE_STATISTICS
+int work_resetstats(int qid);
+#endif
+
 /****************************************************************************
  * Name: lpwork_boostpriority
  *
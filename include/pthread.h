@@ -200,6 +200,17 @@
 #define _PTHREAD_MFLAGS_INCONSISTENT  (1 << 1) /* Mutex is in an inconsistent state */
 #define _PTHREAD_MFLAGS_NRECOVERABLE  (1 << 2) /* Inconsistent mutex has been unlocked */
 
+/* Values for the struct pthread_mutex_s lock word used by the user-space
+ * fast path (CONFIG_PTHREAD_MUTEX_FASTPATH).  Zero means that the mutex is
+ * free.  Otherwise, the word holds the ID of the holder together with
+ * these flags.  These are non-standard and intended only for internal use
+ * within the OS.
+ */
+
+#define _PTHREAD_MLOCK_PIDMASK        0x0000ffff /* ID of the holder */
+#define _PTHREAD_MLOCK_LOCKED         0x40000000 /* Mutex is held */
+#define _PTHREAD_MLOCK_WAITERS        0x80000000 /* Owned via the semaphore */
+
 /* Definitions to map some non-standard, BSD thread management interfaces to
  * the non-standard Linux-like prctl() interface.  Since these are simple
  * mappings to prctl, they will return 0 on success and -1 on failure with the
@@ -325,6 +336,9 @@ struct pthread_mutex_s
   uint8_t type;     /* Type of the mutex.  See PTHREAD_MUTEX_* definitions */
   int16_t nlocks;   /* The number of recursive locks held */
 #endif
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  volatile uint32_t lock; /* Lock word.  See _PTHREAD_MLOCK_* */
+#endif
 };
 
 #ifndef __PTHREAD_MUTEX_T_DEFINED
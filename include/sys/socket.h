@@ -200,6 +200,10 @@
                             * return: int
                             */
 
+/* Control message types for the SOL_SOCKET level (cmsg_type) */
+
+#define SCM_RIGHTS       1 /* Pass open descriptors (array of int) */
+
 /* Protocol-level socket operations. */
 
 #define SOL_IP          1 /* See options in include/netinet/ip.h */
@@ -210,6 +214,7 @@
 #define SOL_L2CAP       6 /* See options in include/netpacket/bluetooth.h */
 #define SOL_SCO         7 /* See options in include/netpacket/bluetooth.h */
 #define SOL_RFCOMM      8 /* See options in include/netpacket/bluetooth.h */
+#define SOL_PACKET      9 /* See options in include/netpacket/packet.h */
 
 /* Protocol-level socket options may begin with this value */
 
@@ -354,6 +359,7 @@ extern "C"
 #endif
 
 int socket(int domain, int type, int protocol);
+int socketpair(int domain, int type, int protocol, int sv[2]);
 int bind(int sockfd, FAR const struct sockaddr *addr, socklen_t addrlen);
 int connect(int sockfd, FAR const struct sockaddr *addr, socklen_t addrlen);
 
@@ -165,8 +165,11 @@ SYSCALL_LOOKUP(clock_nanosleep,            4)
 
 SYSCALL_LOOKUP(clock,                      0)
 SYSCALL_LOOKUP(clock_getres,               2)
-SYSCALL_LOOKUP(clock_gettime,              2)
+SYSCALL_LOOKUP(nx_clock_gettime,           2)
 SYSCALL_LOOKUP(clock_settime,              2)
+#ifdef CONFIG_CLOCK_TIMEPAGE
+  SYSCALL_LOOKUP(clock_timepage,           0)
+#endif
 #ifdef CONFIG_CLOCK_TIMEKEEPING
   SYSCALL_LOOKUP(adjtime,                  2)
 #endif
@@ -302,9 +305,9 @@ SYSCALL_LOOKUP(telldir,                    1)
   SYSCALL_LOOKUP(pthread_join,             2)
   SYSCALL_LOOKUP(pthread_mutex_destroy,    1)
   SYSCALL_LOOKUP(pthread_mutex_init,       2)
-  SYSCALL_LOOKUP(pthread_mutex_timedlock,  2)
-  SYSCALL_LOOKUP(pthread_mutex_trylock,    1)
-  SYSCALL_LOOKUP(pthread_mutex_unlock,     1)
+  SYSCALL_LOOKUP(nx_pthread_mutex_timedlock, 2)
+  SYSCALL_LOOKUP(nx_pthread_mutex_trylock, 1)
+  SYSCALL_LOOKUP(nx_pthread_mutex_unlock,  1)
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
   SYSCALL_LOOKUP(pthread_mutex_consistent, 1)
 #endif
@@ -360,10 +363,13 @@ SYSCALL_LOOKUP(telldir,                    1)
   SYSCALL_LOOKUP(listen,                   2)
   SYSCALL_LOOKUP(recv,                     4)
   SYSCALL_LOOKUP(recvfrom,                 6)
+  SYSCALL_LOOKUP(recvmsg,                  3)
   SYSCALL_LOOKUP(send,                     4)
+  SYSCALL_LOOKUP(sendmsg,                  3)
   SYSCALL_LOOKUP(sendto,                   6)
   SYSCALL_LOOKUP(setsockopt,               5)
   SYSCALL_LOOKUP(socket,                   3)
+  SYSCALL_LOOKUP(socketpair,               4)
 #endif
 
 /* The following is defined only if CONFIG_TASK_NAME_SIZE > 0 */
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * libs/libc/machine/sim/arch_crc32c.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <crc32.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: crc32cpart
+ *
+ * Description:
+ *   Continue CRC-32C calculation on a part of the buffer using the CRC32
+ *   instruction of SSE4.2.  The instruction implements exactly the
+ *   reflected CRC-32C register update, without any pre- or
+ *   post-inversion.
+ *
+ ****************************************************************************/
+
+__attribute__((target("sse4.2")))
+uint32_t crc32cpart(FAR const uint8_t *src, size_t len, uint32_t crc32cval)
+{
+#ifdef __x86_64__
+  uint64_t crc64val = crc32cval;
+  uint64_t data;
+
+  for (; len >= sizeof(data); len -= sizeof(data), src += sizeof(data))
+    {
+      memcpy(&data, src, sizeof(data));
+      crc64val = __builtin_ia32_crc32di(crc64val, data);
+    }
+
+  crc32cval = (uint32_t)crc64val;
+#else
+  uint32_t data;
+
+  for (; len >= sizeof(data); len -= sizeof(data), src += sizeof(data))
+    {
+      memcpy(&data, src, sizeof(data));
+      crc32cval = __builtin_ia32_crc32si(crc32cval, data);
+    }
+#endif
+
+  for (; len > 0; len--)
+    {
+      crc32cval = __builtin_ia32_crc32qi(crc32cval, *src++);
+    }
+
+  return crc32cval;
+}
+
+/****************************************************************************
+ * Name: crc32c
+ *
+ * Description:
+ *   Return the CRC-32C (Castagnoli) of the contents of the 'src' buffer,
+ *   length 'len'.
+ *
+ ****************************************************************************/
+
+uint32_t crc32c(FAR const uint8_t *src, size_t len)
+{
+  return crc32cpart(src, len, CRC32C_INIT) ^ CRC32C_XOROUT;
+}
@@ -0,0 +1,97 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_timedlock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include <nuttx/pthread.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_timedlock
+ *
+ * Description:
+ *   The pthread_mutex_timedlock() function will lock the mutex object
+ *   referenced by mutex. If the mutex is already locked, the calling
+ *   thread will block until the mutex becomes available or the absolute
+ *   time abs_timeout passes.
+ *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, a free mutex is taken here with a
+ *   single compare-and-swap and the OS is entered only if the caller has
+ *   to wait.
+ *
+ * Input Parameters:
+ *   mutex - A reference to the mutex to be locked.
+ *   abs_timeout - max wait time (NULL wait forever)
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                            FAR const struct timespec *abs_timeout)
+{
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  if (mutex != NULL && pthread_mutex_isfast(mutex))
+    {
+      uint32_t self = pthread_mutex_self();
+
+      if (pthread_mutex_cmpxchg(mutex, 0, self))
+        {
+          mutex->pid    = (pid_t)(self & _PTHREAD_MLOCK_PIDMASK);
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          mutex->nlocks = 1;
+#endif
+          return OK;
+        }
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+      /* Only the holder changes the lock count of a recursive mutex, so no
+       * atomic operation is needed to take it again.
+       */
+
+      if (mutex->type == PTHREAD_MUTEX_RECURSIVE &&
+          (mutex->lock & ~_PTHREAD_MLOCK_WAITERS) == self)
+        {
+          if (mutex->nlocks < INT16_MAX)
+            {
+              mutex->nlocks++;
+              return OK;
+            }
+
+          return EOVERFLOW;
+        }
+#endif
+    }
+#endif
+
+  return nx_pthread_mutex_timedlock(mutex, abs_timeout);
+}
@@ -0,0 +1,98 @@
+/****************************************************************************
+ * libs/libc/pthread/pthread_mutex_unlock.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include <nuttx/pthread.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_unlock
+ *
+ * Description:
+ *   The pthread_mutex_unlock() function releases the mutex object
+ *   referenced by mutex.
+ *
+ *   With CONFIG_PTHREAD_MUTEX_FASTPATH, a mutex that nobody waits for is
+ *   released here with a single compare-and-swap.  The OS is entered only
+ *   to wake a waiter or to report an error.
+ *
+ * Input Parameters:
+ *   mutex - A reference to the mutex to be unlocked.
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+{
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  if (mutex != NULL && pthread_mutex_isfast(mutex))
+    {
+      uint32_t self = pthread_mutex_self();
+
+      if (mutex->lock == self)
+        {
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          if (mutex->type == PTHREAD_MUTEX_RECURSIVE && mutex->nlocks > 1)
+            {
+              mutex->nlocks--;
+              return OK;
+            }
+
+          mutex->nlocks = 0;
+#endif
+
+          /* The holder fields must be cleared before the mutex is released
+           * because the next holder sets them right after taking it.
+           */
+
+          mutex->pid = -1;
+          if (pthread_mutex_cmpxchg(mutex, self, 0))
+            {
+              return OK;
+            }
+
+          /* A waiter appeared.  We still hold the mutex, so restore the
+           * holder fields and let the OS hand it over.
+           */
+
+          mutex->pid    = (pid_t)(self & _PTHREAD_MLOCK_PIDMASK);
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+          mutex->nlocks = 1;
+#endif
+        }
+    }
+#endif
+
+  return nx_pthread_mutex_unlock(mutex);
+}
@@ -0,0 +1,158 @@
+/****************************************************************************
+ * libs/libc/time/lib_clockgettime.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+/* The address of the OS time page, looked up on first use */
+
+static FAR const struct clock_timepage_s *g_timepage;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_timepage_read
+ *
+ * Description:
+ *   Read the time from the time page without entering the OS.  The copy is
+ *   repeated until it was not overlapped by an update.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to be read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   true if the time was read from the time page; false if the caller must
+ *   ask the OS instead.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+static bool clock_timepage_read(clockid_t clock_id,
+                                FAR struct timespec *tp)
+{
+  FAR const struct clock_timepage_s *page;
+  struct timespec base;
+  uint32_t seq;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+  if (clock_id != CLOCK_REALTIME && clock_id != CLOCK_MONOTONIC)
+#else
+  if (clock_id != CLOCK_REALTIME)
+#endif
+    {
+      return false;
+    }
+
+  page = g_timepage;
+  if (page == NULL)
+    {
+      /* The page is allocated while the clock is initialized.  Until then
+       * the OS has to answer.
+       */
+
+      page = clock_timepage();
+      if (page == NULL)
+        {
+          return false;
+        }
+
+      g_timepage = page;
+    }
+
+  do
+    {
+      seq = page->seq;
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+      *tp  = page->monotonic;
+      base = page->basetime;
+
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    }
+  while ((seq & 1) != 0 || seq != page->seq);
+
+  if (clock_id == CLOCK_REALTIME)
+    {
+      /* Add the time-of-day at power up, as the OS does */
+
+      tp->tv_sec  += base.tv_sec;
+      tp->tv_nsec += base.tv_nsec;
+      if (tp->tv_nsec >= NSEC_PER_SEC)
+        {
+          tp->tv_sec++;
+          tp->tv_nsec -= NSEC_PER_SEC;
+        }
+    }
+
+  return true;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_gettime
+ *
+ * Description:
+ *   Return the current value of the clock 'clock_id'.  With
+ *   CONFIG_CLOCK_TIMEPAGE, CLOCK_REALTIME and CLOCK_MONOTONIC are read from
+ *   the OS time page without a system call.  All other cases are handled
+ *   by the OS.
+ *
+ * Input Parameters:
+ *   clock_id - The clock to be read
+ *   tp       - Location to return the time
+ *
+ * Returned Value:
+ *   OK (0) on success; ERROR (-1) on failure with the errno value set.
+ *
+ ****************************************************************************/
+
+int clock_gettime(clockid_t clock_id, FAR struct timespec *tp)
+{
+#ifdef CONFIG_CLOCK_TIMEPAGE
+  if (tp != NULL && clock_timepage_read(clock_id, tp))
+    {
+      return OK;
+    }
+#endif
+
+  return nx_clock_gettime(clock_id, tp);
+}
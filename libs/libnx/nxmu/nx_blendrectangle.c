@@ -0,0 +1,95 @@
+/****************************************************************************
+ * libs/libnx/nxmu/nx_blendrectangle.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/nx/nxglib.h>
+#include <nuttx/nx/nx.h>
+#include <nuttx/nx/nxbe.h>
+#include <nuttx/nx/nxmu.h>
+
+#ifdef CONFIG_NX_ALPHABLEND
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_blendrectangle
+ *
+ * Description:
+ *   Blend a color with the given opacity over the specified rectangle in
+ *   the window.
+ *
+ * Input Parameters:
+ *   hwnd  - The window handle
+ *   rect  - The location to be blended
+ *   color - The color to blend
+ *   alpha - The opacity of the color, from 0 (transparent) to 255 (opaque)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nx_blendrectangle(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
+                      nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                      uint8_t alpha)
+{
+  FAR struct nxbe_window_s *wnd = (FAR struct nxbe_window_s *)hwnd;
+  struct nxsvrmsg_blendrect_s outmsg;
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (wnd == NULL || rect == NULL || color == NULL)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+#endif
+
+  /* Nothing to do for a fully transparent color */
+
+  if (alpha == 0)
+    {
+      return OK;
+    }
+
+  /* Format the blend command */
+
+  outmsg.msgid = NX_SVRMSG_BLENDRECT;
+  outmsg.wnd   = wnd;
+  outmsg.alpha = alpha;
+
+  nxgl_rectcopy(&outmsg.rect, rect);
+  nxgl_colorcopy(outmsg.color, color);
+
+  /* Forward the blend command to the server */
+
+  return nxmu_sendwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_blendrect_s));
+}
+
+#endif /* CONFIG_NX_ALPHABLEND */
@@ -0,0 +1,87 @@
+/****************************************************************************
+ * libs/libnx/nxtk/nxtk_blendwindow.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/nx/nx.h>
+#include <nuttx/nx/nxtk.h>
+
+#include "nxtk.h"
+
+#ifdef CONFIG_NX_ALPHABLEND
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxtk_blendwindow
+ *
+ * Description:
+ *   Blend a color with the given opacity over the specified rectangle in
+ *   the client window.
+ *
+ * Input Parameters:
+ *   hfwnd - The window handle returned by nxtk_openwindow
+ *   rect  - The location within the client window to be blended
+ *   color - The color to blend
+ *   alpha - The opacity of the color, from 0 (transparent) to 255 (opaque)
+ *
+ * Returned Value:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nxtk_blendwindow(NXTKWINDOW hfwnd, FAR const struct nxgl_rect_s *rect,
+                     nxgl_mxpixel_t color[CONFIG_NX_NPLANES],
+                     uint8_t alpha)
+{
+  FAR struct nxtk_framedwindow_s *fwnd =
+    (FAR struct nxtk_framedwindow_s *)hfwnd;
+  struct nxgl_rect_s blendrect;
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (!hfwnd || !rect || !color)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+#endif
+
+  /* Clip the rectangle so that it lies within the sub-window bounds
+   * then move the rectangle to that it is relative to the containing
+   * window.
+   */
+
+  nxtk_subwindowclip(fwnd, &blendrect, rect, &fwnd->fwrect);
+
+  /* Then blend it */
+
+  return nx_blendrectangle((NXWINDOW)hfwnd, &blendrect, color, alpha);
+}
+
+#endif /* CONFIG_NX_ALPHABLEND */
@@ -47,22 +47,31 @@
 #ifdef CONFIG_NET
 
 #include <sys/ioctl.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include <queue.h>
+#include <errno.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <netinet/in.h>
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
 #include <nuttx/net/arp.h>
 #include <nuttx/net/ip.h>
 
+#include <devif/devif.h>
 #include <arp/arp.h>
 #include <netdev/netdev.h>
+#include <netlink/netlink.h>
 
 #ifdef CONFIG_NET_ARP
 
@@ -72,6 +81,27 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+#ifndef CONFIG_NET_ARP_HASHSIZE
+#  define CONFIG_NET_ARP_HASHSIZE 16
+#endif
+
+/* Entries that are still in use are re-resolved when they reach 3/4 of
+ * their maximum age.  The table is scanned eight times per maximum age so
+ * that there are at least a second and third chance before the entry
+ * expires.
+ */
+
+#ifdef CONFIG_NET_ARP_REFRESH
+#  define ARP_REFRESH_TICK (ARP_MAXAGE_TICK - ARP_MAXAGE_TICK / 4)
+#  define ARP_SCAN_TICK    (ARP_MAXAGE_TICK / 8)
+#endif
+
+#ifdef CONFIG_NET_STATISTICS
+#  define ARP_STATS(f) (g_netstats.arp.f++)
+#else
+#  define ARP_STATS(f)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -82,13 +112,38 @@ struct arp_table_info_s
   FAR struct ether_addr *ai_ethaddr;  /* Location to return the MAC address */
 };
 
+/* One allocated ARP table entry */
+
+struct arp_cache_s
+{
+  dq_entry_t ac_lru;                  /* LRU list link.  Must be first */
+  FAR struct arp_cache_s *ac_hnext;   /* Next entry in the hash chain */
+  struct arp_entry_s ac_entry;        /* The address mapping */
+#ifdef CONFIG_NET_ARP_REFRESH
+  bool ac_used;                       /* Looked up since the last scan */
+  FAR struct net_driver_s *ac_dev;    /* Device sending the refresh */
+  FAR struct devif_callback_s *ac_cb; /* Pending refresh request */
+#endif
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* The table of known address mappings */
+/* The table of known address mappings.  Entries are allocated on demand,
+ * indexed by a hash of the IP address, and kept on a list ordered from the
+ * most to the least recently used.
+ */
 
-static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static FAR struct arp_cache_s *g_arphash[CONFIG_NET_ARP_HASHSIZE];
+static dq_queue_t g_arplru;
+static unsigned int g_arpcount;
+
+#ifdef CONFIG_NET_ARP_REFRESH
+/* Background aging and refresh of the ARP table */
+
+static struct work_s g_arpwork;
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -141,32 +196,274 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_hash
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Return the hash chain that holds an IP address.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static FAR struct arp_cache_s **arp_hash(in_addr_t ipaddr)
 {
-  if (e1->at_ipaddr == 0)
+  uint32_t hash = (uint32_t)ipaddr;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_arphash[hash % CONFIG_NET_ARP_HASHSIZE];
+}
+
+/****************************************************************************
+ * Name: arp_cache_find
+ *
+ * Description:
+ *   Return the table entry for an IP address, whatever its age, or NULL.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_cache_s *arp_cache_find(in_addr_t ipaddr)
+{
+  FAR struct arp_cache_s *entry;
+
+  for (entry = *arp_hash(ipaddr); entry != NULL; entry = entry->ac_hnext)
     {
-      return e1;
+      if (net_ipv4addr_cmp(entry->ac_entry.at_ipaddr, ipaddr))
+        {
+          break;
+        }
     }
-  else if (e2->at_ipaddr == 0)
+
+  return entry;
+}
+
+/****************************************************************************
+ * Name: arp_cache_unlink
+ *
+ * Description:
+ *   Remove an entry from its hash chain and from the LRU list and cancel
+ *   any refresh that it has pending.
+ *
+ ****************************************************************************/
+
+static void arp_cache_unlink(FAR struct arp_cache_s *entry)
+{
+  FAR struct arp_cache_s **link;
+
+  for (link = arp_hash(entry->ac_entry.at_ipaddr); *link != entry;
+       link = &(*link)->ac_hnext)
     {
-      return e2;
+      DEBUGASSERT(*link != NULL);
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  *link = entry->ac_hnext;
+  dq_rem(&entry->ac_lru, &g_arplru);
+
+  /* Tell Netlink listeners that the mapping is gone */
+
+  netlink_neigh_notify(&entry->ac_entry, RTM_DELNEIGH, AF_INET);
+
+#ifdef CONFIG_NET_ARP_REFRESH
+  if (entry->ac_cb != NULL)
     {
-      return e1;
+      arp_callback_free(entry->ac_dev, entry->ac_cb);
+      entry->ac_cb = NULL;
     }
-  else
+#endif
+}
+
+/****************************************************************************
+ * Name: arp_cache_free
+ *
+ * Description:
+ *   Remove an entry from the table and free it.
+ *
+ ****************************************************************************/
+
+static void arp_cache_free(FAR struct arp_cache_s *entry)
+{
+  arp_cache_unlink(entry);
+  kmm_free(entry);
+  g_arpcount--;
+}
+
+#ifdef CONFIG_NET_ARP_REFRESH
+/****************************************************************************
+ * Name: arp_refresh_eventhandler
+ *
+ * Description:
+ *   Send the ARP request that refreshes one table entry when the device is
+ *   next polled.
+ *
+ ****************************************************************************/
+
+static uint16_t arp_refresh_eventhandler(FAR struct net_driver_s *dev,
+                                         FAR void *pvconn,
+                                         FAR void *priv, uint16_t flags)
+{
+  FAR struct arp_cache_s *entry = (FAR struct arp_cache_s *)priv;
+
+  DEBUGASSERT(entry != NULL && entry->ac_dev == dev);
+
+  /* Wait for the next poll if the buffer is already in use */
+
+  if ((flags & NETDEV_DOWN) == 0 &&
+      (dev->d_len > 0 || dev->d_sndlen > 0 || (flags & PKT_NEWDATA) != 0))
+    {
+      return flags;
+    }
+
+  if ((flags & NETDEV_DOWN) == 0)
+    {
+      arp_format(dev, entry->ac_entry.at_ipaddr);
+
+      /* Make sure no ARP request overwrites this ARP request.  This flag
+       * will be cleared in arp_out().
+       */
+
+      IFF_SET_NOARP(dev->d_flags);
+      ARP_STATS(refresh);
+    }
+
+  /* The entry is updated when the reply is received */
+
+  arp_callback_free(dev, entry->ac_cb);
+  entry->ac_cb = NULL;
+  return flags;
+}
+
+/****************************************************************************
+ * Name: arp_refresh
+ *
+ * Description:
+ *   Arrange for an ARP request to be sent for an entry that is about to
+ *   expire.
+ *
+ ****************************************************************************/
+
+static void arp_refresh(FAR struct arp_cache_s *entry)
+{
+  FAR struct net_driver_s *dev;
+
+  dev = netdev_findby_ripv4addr(INADDR_ANY, entry->ac_entry.at_ipaddr);
+  if (dev == NULL ||
+      (dev->d_lltype != NET_LL_ETHERNET &&
+       dev->d_lltype != NET_LL_IEEE80211))
+    {
+      return;
+    }
+
+  entry->ac_cb = arp_callback_alloc(dev);
+  if (entry->ac_cb == NULL)
     {
-      return e2;
+      /* Try again with the next scan */
+
+      return;
     }
+
+  entry->ac_dev        = dev;
+  entry->ac_cb->flags  = ARP_POLL | NETDEV_DOWN;
+  entry->ac_cb->priv   = entry;
+  entry->ac_cb->event  = arp_refresh_eventhandler;
+
+  netdev_txnotify_dev(dev);
+}
+
+/****************************************************************************
+ * Name: arp_refresh_work
+ *
+ * Description:
+ *   Periodically free expired entries and refresh entries that are still
+ *   in use before they expire.
+ *
+ ****************************************************************************/
+
+static void arp_refresh_work(FAR void *arg)
+{
+  FAR struct arp_cache_s *entry;
+  FAR struct arp_cache_s *next;
+  clock_t now;
+  clock_t age;
+
+  net_lock();
+
+  now = clock_systime_ticks();
+  for (entry = (FAR struct arp_cache_s *)dq_peek(&g_arplru);
+       entry != NULL;
+       entry = next)
+    {
+      next = (FAR struct arp_cache_s *)dq_next(&entry->ac_lru);
+      age  = now - entry->ac_entry.at_time;
+
+      if (age > ARP_MAXAGE_TICK)
+        {
+          arp_cache_free(entry);
+          continue;
+        }
+
+      if (age >= ARP_REFRESH_TICK && entry->ac_used && entry->ac_cb == NULL)
+        {
+          arp_refresh(entry);
+        }
+
+      entry->ac_used = false;
+    }
+
+  /* Keep scanning for as long as there is something to age */
+
+  if (!dq_empty(&g_arplru))
+    {
+      work_queue(LPWORK, &g_arpwork, arp_refresh_work, NULL, ARP_SCAN_TICK);
+    }
+
+  net_unlock();
+}
+#endif /* CONFIG_NET_ARP_REFRESH */
+
+/****************************************************************************
+ * Name: arp_cache_alloc
+ *
+ * Description:
+ *   Allocate a new table entry.  If the table is full or there is no
+ *   memory, the least recently used entry is recycled.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_cache_s *arp_cache_alloc(void)
+{
+  FAR struct arp_cache_s *entry = NULL;
+
+  if (g_arpcount < CONFIG_NET_ARPTAB_SIZE)
+    {
+      entry = (FAR struct arp_cache_s *)
+        kmm_zalloc(sizeof(struct arp_cache_s));
+      if (entry != NULL)
+        {
+          g_arpcount++;
+        }
+    }
+
+  if (entry == NULL)
+    {
+      entry = (FAR struct arp_cache_s *)dq_tail(&g_arplru);
+      if (entry == NULL)
+        {
+          return NULL;
+        }
+
+      arp_cache_unlink(entry);
+      memset(entry, 0, sizeof(struct arp_cache_s));
+      ARP_STATS(evict);
+    }
+
+#ifdef CONFIG_NET_ARP_REFRESH
+  /* Start background aging with the first entry */
+
+  if (work_available(&g_arpwork))
+    {
+      work_queue(LPWORK, &g_arpwork, arp_refresh_work, NULL, ARP_SCAN_TICK);
+    }
+#endif
+
+  return entry;
 }
 
 /****************************************************************************
@@ -195,43 +492,53 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
-  int i;
+  FAR struct arp_cache_s **chain;
+  FAR struct arp_cache_s *entry;
+  bool changed = true;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Try to find an entry to update.  If none is found, the IP -> MAC
+   * address mapping is inserted in the ARP table.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  entry = arp_cache_find(ipaddr);
+  if (entry != NULL)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
-
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
+      dq_rem(&entry->ac_lru, &g_arplru);
+      changed = memcmp(entry->ac_entry.at_ethaddr.ether_addr_octet, ethaddr,
+                       ETHER_ADDR_LEN) != 0;
+    }
+  else
+    {
+      entry = arp_cache_alloc();
+      if (entry == NULL)
         {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
+          return -ENOMEM;
         }
-      else
-        {
-          /* Record the oldest entry. */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      chain                     = arp_hash(ipaddr);
+      entry->ac_hnext           = *chain;
+      *chain                    = entry;
+      entry->ac_entry.at_ipaddr = ipaddr;
     }
 
-  /* Now, tabptr is the ARP table entry which we will fill with the new
-   * information.
+  /* Fill in the new information and make the entry the most recently
+   * used.
+   */
+
+  memcpy(entry->ac_entry.at_ethaddr.ether_addr_octet, ethaddr,
+         ETHER_ADDR_LEN);
+  entry->ac_entry.at_time = clock_systime_ticks();
+  dq_addfirst(&entry->ac_lru, &g_arplru);
+
+  /* Tell Netlink listeners about new and changed mappings, but not about
+   * refreshes of the same mapping.
    */
 
-  tabptr->at_ipaddr = ipaddr;
-  memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_time = clock_systime_ticks();
+  if (changed)
+    {
+      netlink_neigh_notify(&entry->ac_entry, RTM_NEWNEIGH, AF_INET);
+    }
+
   return OK;
 }
 
@@ -281,24 +588,40 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
 
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
-  int i;
+  FAR struct arp_cache_s *entry;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  entry = arp_cache_find(ipaddr);
+  if (entry != NULL &&
+      clock_systime_ticks() - entry->ac_entry.at_time > ARP_MAXAGE_TICK)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
-        {
-          return tabptr;
-        }
+      /* It has expired.  Free it now. */
+
+      arp_cache_free(entry);
+      entry = NULL;
     }
 
-  /* Not found */
+  if (entry == NULL)
+    {
+      ARP_STATS(miss);
+      return NULL;
+    }
 
-  return NULL;
+  /* Make it the most recently used entry */
+
+  if (dq_peek(&g_arplru) != &entry->ac_lru)
+    {
+      dq_rem(&entry->ac_lru, &g_arplru);
+      dq_addfirst(&entry->ac_lru, &g_arplru);
+    }
+
+#ifdef CONFIG_NET_ARP_REFRESH
+  entry->ac_used = true;
+#endif
+
+  ARP_STATS(hit);
+  return &entry->ac_entry;
 }
 
 /****************************************************************************
@@ -380,16 +703,16 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
 void arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_cache_s *entry;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
-  if (tabptr != NULL)
+  entry = arp_cache_find(ipaddr);
+  if (entry != NULL)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Remove it and free the memory */
 
-      tabptr->at_ipaddr = 0;
+      arp_cache_free(entry);
     }
 }
 
@@ -417,22 +740,23 @@ void arp_delete(in_addr_t ipaddr)
 unsigned int arp_snapshot(FAR struct arp_entry_s *snapshot,
                           unsigned int nentries)
 {
-  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_cache_s *entry;
   clock_t now;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-expired entries in the ARP table, most recently used
+   * first.
+   */
 
-  for (i = 0, now = clock_systime_ticks(), ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
-       i++)
+  for (entry = (FAR struct arp_cache_s *)dq_peek(&g_arplru),
+       now = clock_systime_ticks(), ncopied = 0;
+       nentries > ncopied && entry != NULL;
+       entry = (FAR struct arp_cache_s *)dq_next(&entry->ac_lru))
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
-          now - tabptr->at_time <= ARP_MAXAGE_TICK)
+      if (now - entry->ac_entry.at_time <= ARP_MAXAGE_TICK)
         {
-          memcpy(&snapshot[ncopied], tabptr, sizeof(struct arp_entry_s));
+          memcpy(&snapshot[ncopied], &entry->ac_entry,
+                 sizeof(struct arp_entry_s));
           ncopied++;
         }
     }
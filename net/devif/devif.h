@@ -497,6 +497,62 @@ void devif_pkt_send(FAR struct net_driver_s *dev, FAR const void *buf,
                     unsigned int len);
 #endif
 
+/****************************************************************************
+ * Name: devif_txready
+ *
+ * Description:
+ *   Queue a connection on the TX-ready list of the device that it will
+ *   send on.  Nothing is done if it is already queued there.  A connection
+ *   queued on a different device is moved.
+ *
+ * Input Parameters:
+ *   dev   - The device that the connection will send on
+ *   ready - The TX-ready entry of the connection
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXREADY
+void devif_txready(FAR struct net_driver_s *dev,
+                   FAR struct devif_txready_s *ready);
+#endif
+
+/****************************************************************************
+ * Name: devif_txready_remove
+ *
+ * Description:
+ *   Remove a connection from the TX-ready list that it is queued on, if
+ *   any.  This must be done before the connection is freed.
+ *
+ * Input Parameters:
+ *   ready - The TX-ready entry of the connection
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXREADY
+void devif_txready_remove(FAR struct devif_txready_s *ready);
+#endif
+
+/****************************************************************************
+ * Name: devif_txready_flush
+ *
+ * Description:
+ *   Empty the TX-ready list of a device that is going away.
+ *
+ * Input Parameters:
+ *   dev - The device being unregistered
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXREADY
+void devif_txready_flush(FAR struct net_driver_s *dev);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -43,6 +43,7 @@
 
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/clock.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
@@ -393,18 +394,32 @@ static inline int devif_poll_icmpv6(FAR struct net_driver_s *dev,
 static inline int devif_poll_forward(FAR struct net_driver_s *dev,
                                      devif_poll_callback_t callback)
 {
-  /* Perform the forwarding poll */
+  bool more;
+  int bstop;
 
-  ipfwd_poll(dev);
-
-  /* NOTE: that 6LoWPAN packet conversions are handled differently for
-   * forwarded packets.  That is because we don't know what the packet
-   * type is at this point; not within peeking into the device's d_buf.
+  /* Each poll forwards one packet.  Keep handing them to the driver for as
+   * long as there are more and the driver can take them, so that a burst
+   * of forwarded packets goes out in one pass.
    */
 
-  /* Call back into the driver */
+  do
+    {
+      /* Perform the forwarding poll */
 
-  return callback(dev);
+      more = ipfwd_poll(dev);
+
+      /* NOTE: that 6LoWPAN packet conversions are handled differently for
+       * forwarded packets.  That is because we don't know what the packet
+       * type is at this point; not within peeking into the device's d_buf.
+       */
+
+      /* Call back into the driver */
+
+      bstop = callback(dev);
+    }
+  while (more && !bstop);
+
+  return bstop;
 }
 #endif /* CONFIG_NET_ICMPv6_SOCKET || CONFIG_NET_ICMPv6_NEIGHBOR*/
 
@@ -520,7 +535,7 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-#ifdef NET_TCP_HAVE_STACK
+#if defined(NET_TCP_HAVE_STACK) && !defined(CONFIG_NET_TXREADY)
 static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
                                              devif_poll_callback_t callback)
 {
@@ -550,12 +565,98 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 # define devif_poll_tcp_connections(dev, callback) (0)
 #endif
 
+/****************************************************************************
+ * Name: devif_poll_txready
+ *
+ * Description:
+ *   Poll the TCP and UDP connections on the TX-ready list of the device.
+ *   Each connection that was on the list on entry is polled once, in the
+ *   order in which it became ready.  A connection that sent something goes
+ *   to the end of the list to wait for its next turn.  One that had
+ *   nothing to send is removed from the list.
+ *
+ * Assumptions:
+ *   This function is called from the MAC device driver with the network
+ *   locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TXREADY
+static int devif_poll_txready(FAR struct net_driver_s *dev,
+                              devif_poll_callback_t callback)
+{
+  FAR struct devif_txready_s *ready;
+  FAR dq_entry_t *entry;
+  unsigned int count = 0;
+  int bstop = 0;
+
+  for (entry = dq_peek(&dev->d_txready); entry != NULL;
+       entry = dq_next(entry))
+    {
+      count++;
+    }
+
+  while (!bstop && count-- > 0 &&
+         (ready = (FAR struct devif_txready_s *)
+                  dq_peek(&dev->d_txready)) != NULL)
+    {
+      /* Move the connection to the end of the list before polling it so
+       * that the others get their turn first next time.
+       */
+
+      dq_rem(&ready->node, &dev->d_txready);
+      dq_addlast(&ready->node, &dev->d_txready);
+
+      switch (ready->proto)
+        {
+#ifdef NET_TCP_HAVE_STACK
+          case IP_PROTO_TCP:
+            tcp_poll(dev, container_of(ready, struct tcp_conn_s, txready));
+            break;
+#endif
+
+#ifdef NET_UDP_HAVE_STACK
+          case IP_PROTO_UDP:
+            udp_poll(dev, container_of(ready, struct udp_conn_s, txready));
+            break;
+#endif
+
+          default:
+            dev->d_len = 0;
+            break;
+        }
+
+      /* A connection with nothing to send is not ready any more.  The poll
+       * may also have freed the connection, which removes it from the list.
+       */
+
+      if (dev->d_len == 0 && ready->dev == dev)
+        {
+          dq_rem(&ready->node, &dev->d_txready);
+          ready->dev = NULL;
+        }
+
+      /* Perform any necessary conversions on outgoing packets */
+
+      devif_packet_conversion(dev, ready->proto == IP_PROTO_TCP ?
+                                   DEVIF_TCP : DEVIF_UDP);
+
+      /* Call back into the driver */
+
+      bstop = callback(dev);
+    }
+
+  return bstop;
+}
+#endif /* CONFIG_NET_TXREADY */
+
 /****************************************************************************
  * Name: devif_poll_tcp_timer
  *
  * Description:
  *   The TCP timer has expired.  Update TCP timing state in each active,
- *   TCP connection.
+ *   TCP connection, or with CONFIG_NET_TCP_TIMERWHEEL in each one bound to
+ *   the device whose timer is due.
  *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
@@ -563,7 +664,42 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-#ifdef NET_TCP_HAVE_STACK
+#if defined(NET_TCP_HAVE_STACK) && defined(CONFIG_NET_TCP_TIMERWHEEL)
+static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
+                                       devif_poll_callback_t callback,
+                                       int hsec)
+{
+  FAR struct tcp_conn_s *conn;
+  int elapsed;
+  int bstop = 0;
+
+  /* Collect the connections whose timer has become due.  Those that are
+   * not served because the driver stops the poll remain due.
+   */
+
+  tcp_timer_advance(dev, hsec);
+
+  while (!bstop && (conn = tcp_timer_due(dev, &elapsed)) != NULL)
+    {
+      /* Perform the TCP timer poll and queue the connection for its next
+       * timer, if any.
+       */
+
+      tcp_timer(dev, conn, elapsed);
+      tcp_timer_arm(conn);
+
+      /* Perform any necessary conversions on outgoing packets */
+
+      devif_packet_conversion(dev, DEVIF_TCP);
+
+      /* Call back into the driver */
+
+      bstop = callback(dev);
+    }
+
+  return bstop;
+}
+#elif defined(NET_TCP_HAVE_STACK)
 static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
                                        devif_poll_callback_t callback,
                                        int hsec)
@@ -617,6 +753,9 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
  *   is set to a value larger than zero. The device driver should then send
  *   out the packet.
  *
+ *   If CONFIG_NET_TXREADY is enabled, only the TCP and UDP connections that
+ *   have queued themselves on the TX-ready list of the device are polled.
+ *
  * Assumptions:
  *   This function is called from the MAC device driver with the network
  *   locked.
@@ -682,6 +821,15 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 
   if (!bstop)
 #endif
+#ifdef CONFIG_NET_TXREADY
+    {
+      /* Poll only the TCP and UDP connections with pending output */
+
+      bstop = devif_poll_txready(dev, callback);
+    }
+
+  if (!bstop)
+#else
 #ifdef NET_TCP_HAVE_STACK
     {
       /* Traverse all of the active TCP connections and perform the poll
@@ -704,6 +852,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 
   if (!bstop)
 #endif
+#endif /* CONFIG_NET_TXREADY */
 #if defined(CONFIG_NET_ICMP) && defined(CONFIG_NET_ICMP_SOCKET)
     {
       /* Traverse all of the tasks waiting to send an ICMP ECHO request. */
@@ -788,6 +937,18 @@ int devif_timer(FAR struct net_driver_s *dev, int delay,
   bstop = devif_poll_tcp_timer(dev, callback, hsec);
 #endif
 
+#if defined(CONFIG_NET_TXREADY) && defined(NET_UDP_HAVE_STACK)
+  /* devif_poll() only serves the connections that asked for it.  Poll the
+   * rest of the UDP connections here, as the TCP timer does for TCP, so
+   * that one that was not queued still sends eventually.
+   */
+
+  if (!bstop)
+    {
+      bstop = devif_poll_udp_connections(dev, callback);
+    }
+#endif
+
   /* If possible, continue with a normal poll checking for pending
    * network driver actions.
    */
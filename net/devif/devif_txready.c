@@ -0,0 +1,124 @@
+/****************************************************************************
+ * net/devif/devif_txready.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "devif/devif.h"
+
+#ifdef CONFIG_NET_TXREADY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: devif_txready
+ *
+ * Description:
+ *   Queue a connection on the TX-ready list of the device that it will
+ *   send on.  Nothing is done if it is already queued there.  A connection
+ *   queued on a different device is moved.
+ *
+ * Input Parameters:
+ *   dev   - The device that the connection will send on
+ *   ready - The TX-ready entry of the connection
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void devif_txready(FAR struct net_driver_s *dev,
+                   FAR struct devif_txready_s *ready)
+{
+  DEBUGASSERT(dev != NULL && ready != NULL);
+
+  if (ready->dev != dev)
+    {
+      if (ready->dev != NULL)
+        {
+          dq_rem(&ready->node, &ready->dev->d_txready);
+        }
+
+      dq_addlast(&ready->node, &dev->d_txready);
+      ready->dev = dev;
+    }
+}
+
+/****************************************************************************
+ * Name: devif_txready_remove
+ *
+ * Description:
+ *   Remove a connection from the TX-ready list that it is queued on, if
+ *   any.  This must be done before the connection is freed.
+ *
+ * Input Parameters:
+ *   ready - The TX-ready entry of the connection
+ *
+ ****************************************************************************/
+
+void devif_txready_remove(FAR struct devif_txready_s *ready)
+{
+  net_lock();
+  if (ready->dev != NULL)
+    {
+      dq_rem(&ready->node, &ready->dev->d_txready);
+      ready->dev = NULL;
+    }
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: devif_txready_flush
+ *
+ * Description:
+ *   Empty the TX-ready list of a device that is going away.
+ *
+ * Input Parameters:
+ *   dev - The device being unregistered
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void devif_txready_flush(FAR struct net_driver_s *dev)
+{
+  FAR struct devif_txready_s *ready;
+
+  while ((ready = (FAR struct devif_txready_s *)
+                  dq_remfirst(&dev->d_txready)) != NULL)
+    {
+      ready->dev = NULL;
+    }
+}
+
+#endif /* CONFIG_NET_TXREADY */
@@ -38,6 +38,7 @@
 #include "devif/devif.h"
 #include "netdev/netdev.h"
 #include "inet/inet.h"
+#include "netlink/netlink.h"
 #include "icmpv6/icmpv6.h"
 
 #ifdef CONFIG_NET_ICMPv6_AUTOCONF
@@ -350,6 +351,7 @@ int icmpv6_autoconfig(FAR struct net_driver_s *dev)
    */
 
   net_ipv6addr_copy(dev->d_ipv6addr, lladdr);
+  netlink_ipaddr_notify(dev, RTM_NEWADDR, AF_INET6);
 
   /* 4. Router Contact: The node next attempts to contact a local router for
    *    more information on continuing the configuration. This is done either
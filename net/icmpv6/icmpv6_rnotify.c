@@ -36,6 +36,7 @@
 
 #include "netdev/netdev.h"
 #include "utils/utils.h"
+#include "netlink/netlink.h"
 #include "icmpv6/icmpv6.h"
 
 #ifdef CONFIG_NET_ICMPv6_AUTOCONF
@@ -128,6 +129,7 @@ static void icmpv6_setaddresses(FAR struct net_driver_s *dev,
   /* Finally, copy the router address */
 
   net_ipv6addr_copy(dev->d_ipv6draddr, draddr);
+  netlink_ipaddr_notify(dev, RTM_NEWADDR, AF_INET6);
 
   ninfo("DR address=%04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x\n",
         ntohs(dev->d_ipv6draddr[0]), ntohs(dev->d_ipv6draddr[1]),
@@ -125,6 +125,7 @@ typedef FAR struct wdog_s *WDOG_ID;
 struct igmp_group_s
 {
   struct igmp_group_s *next;    /* Implements a singly-linked list */
+  struct igmp_group_s *hnext;   /* Next group in the same hash bucket */
   struct work_s        work;    /* For deferred timeout operations */
   in_addr_t            grpaddr; /* Group IPv4 address */
   WDOG_ID              wdog;    /* WDOG used to detect timeouts */
@@ -132,6 +133,7 @@ struct igmp_group_s
   uint8_t              ifindex; /* Interface index */
   uint8_t              flags;   /* See IGMP_ flags definitions */
   uint8_t              msgid;   /* Pending message ID (if non-zero) */
+  uint8_t              njoins;  /* Number of joins from this host */
 };
 
 /****************************************************************************
@@ -70,6 +70,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#if (CONFIG_NET_IGMP_HASHSIZE & (CONFIG_NET_IGMP_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_IGMP_HASHSIZE must be a power of two
+#endif
+
 /* Debug ********************************************************************/
 
 #undef IGMP_GRPDEBUG /* Define to enable detailed IGMP group debug */
@@ -86,6 +90,38 @@
 #  define grpinfo   _none
 #endif
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Groups of all devices hashed by group address and interface index.  Each
+ * bucket is a list linked through hnext.
+ */
+
+static FAR struct igmp_group_s *g_igmp_grphash[CONFIG_NET_IGMP_HASHSIZE];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  igmp_grphash
+ *
+ * Description:
+ *   Return the hash bucket of a group address on an interface.
+ *
+ ****************************************************************************/
+
+static FAR struct igmp_group_s **igmp_grphash(in_addr_t addr,
+                                              uint8_t ifindex)
+{
+  uint32_t hash = (uint32_t)addr ^ ifindex;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_igmp_grphash[hash & (CONFIG_NET_IGMP_HASHSIZE - 1)];
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -104,6 +140,7 @@
 FAR struct igmp_group_s *igmp_grpalloc(FAR struct net_driver_s *dev,
                                        FAR const in_addr_t *addr)
 {
+  FAR struct igmp_group_s **bucket;
   FAR struct igmp_group_s *group;
 
   ninfo("addr: %08x dev: %p\n", *addr, dev);
@@ -138,6 +175,12 @@ FAR struct igmp_group_s *igmp_grpalloc(FAR struct net_driver_s *dev,
       /* Add the group structure to the list in the device structure */
 
       sq_addfirst((FAR sq_entry_t *)group, &dev->d_igmp_grplist);
+
+      /* And to its hash bucket */
+
+      bucket       = igmp_grphash(group->grpaddr, group->ifindex);
+      group->hnext = *bucket;
+      *bucket      = group;
     }
 
   return group;
@@ -161,15 +204,15 @@ FAR struct igmp_group_s *igmp_grpfind(FAR struct net_driver_s *dev,
 
   grpinfo("Searching for addr %08x\n", (int)*addr);
 
-  for (group = (FAR struct igmp_group_s *)dev->d_igmp_grplist.head;
+  for (group = *igmp_grphash(*addr, dev->d_ifindex);
        group;
-       group = group->next)
+       group = group->hnext)
     {
       grpinfo("Compare: %08x vs. %08x\n", group->grpaddr, *addr);
-      if (net_ipv4addr_cmp(group->grpaddr, *addr))
+      if (net_ipv4addr_cmp(group->grpaddr, *addr) &&
+          group->ifindex == dev->d_ifindex)
         {
           grpinfo("Match!\n");
-          DEBUGASSERT(group->ifindex == dev->d_ifindex);
           break;
         }
     }
@@ -218,6 +261,8 @@ FAR struct igmp_group_s *igmp_grpallocfind(FAR struct net_driver_s *dev,
 void igmp_grpfree(FAR struct net_driver_s *dev,
                   FAR struct igmp_group_s *group)
 {
+  FAR struct igmp_group_s **link;
+
   grpinfo("Free: %p flags: %02x\n", group, group->flags);
 
   /* Cancel the wdog */
@@ -228,6 +273,19 @@ void igmp_grpfree(FAR struct net_driver_s *dev,
 
   sq_rem((FAR sq_entry_t *)group, &dev->d_igmp_grplist);
 
+  /* And from its hash bucket */
+
+  for (link = igmp_grphash(group->grpaddr, group->ifindex);
+       *link != NULL;
+       link = &(*link)->hnext)
+    {
+      if (*link == group)
+        {
+          *link = group->hnext;
+          break;
+        }
+    }
+
   /* Destroy the wait semaphore */
 
   nxsem_destroy(&group->sem);
@@ -93,12 +93,20 @@ void igmp_initialize(void)
 
 void igmp_devinit(struct net_driver_s *dev)
 {
+  FAR struct igmp_group_s *group;
+
   ninfo("IGMP initializing dev %p\n", dev);
   DEBUGASSERT(dev->d_igmp_grplist.head == NULL);
 
-  /* Add the all systems address to the group */
+  /* Add the all systems address to the group.  The host is a permanent
+   * member of this group.
+   */
 
-  igmp_grpalloc(dev, &g_ipv4_allsystems);
+  group = igmp_grpalloc(dev, &g_ipv4_allsystems);
+  if (group != NULL)
+    {
+      group->njoins = 1;
+    }
 
   /* Allow the IGMP messages at the MAC level */
 
@@ -43,11 +43,14 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <assert.h>
+#include <errno.h>
 #include <debug.h>
 
 #include <netinet/in.h>
 
+#include <nuttx/wdog.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netstats.h>
 #include <nuttx/net/ip.h>
@@ -126,38 +129,67 @@ int igmp_joingroup(struct net_driver_s *dev, FAR const struct in_addr *grpaddr)
   /* Check if a this address is already in the group */
 
   group = igmp_grpfind(dev, &grpaddr->s_addr);
-  if (!group)
+  if (group != NULL && group->njoins > 0)
+    {
+      /* The group already exists; a task from this host is joining an
+       * existing group.  Indicate one more request to join the group from
+       * this host.
+       */
+
+      DEBUGASSERT(group->njoins < UINT8_MAX);
+      group->njoins++;
+      return OK;
+    }
+
+  if (group == NULL)
     {
       /* No... allocate a new entry */
 
       ninfo("Join to new group: %08x\n", grpaddr->s_addr);
       group = igmp_grpalloc(dev, &grpaddr->s_addr);
-      IGMP_STATINCR(g_netstats.igmp.joins);
-
-      /* Send the Membership Report */
-
-      IGMP_STATINCR(g_netstats.igmp.report_sched);
-      ret = igmp_waitmsg(group, IGMPv2_MEMBERSHIP_REPORT);
-      if (ret < 0)
+      if (group == NULL)
         {
-          nerr("ERROR: Failed to schedule message: %d\n", ret);
-          igmp_grpfree(dev, group);
-          return ret;
+          return -ENOMEM;
         }
+    }
+  else
+    {
+      /* igmp_input() created the group for a query or report that it
+       * received, but no task on this host has joined it yet.  Discard the
+       * state from the received messages; the join starts over as for a
+       * new group.
+       */
+
+      ninfo("Join to unjoined group: %08x\n", grpaddr->s_addr);
+      wd_cancel(group->wdog);
+      CLR_SCHEDMSG(group->flags);
+      CLR_IDLEMEMBER(group->flags);
+    }
 
-      /* And start the timer at 10*100 msec */
+  /* Indicate one request to join the group from this this host */
 
-      igmp_starttimer(group, 10);
+  group->njoins = 1;
+  IGMP_STATINCR(g_netstats.igmp.joins);
 
-      /* Add the group (MAC) address to the ether drivers MAC filter list */
+  /* Send the Membership Report */
 
-      igmp_addmcastmac(dev, (FAR in_addr_t *)&grpaddr->s_addr);
-      return OK;
+  IGMP_STATINCR(g_netstats.igmp.report_sched);
+  ret = igmp_waitmsg(group, IGMPv2_MEMBERSHIP_REPORT);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to schedule message: %d\n", ret);
+      igmp_grpfree(dev, group);
+      return ret;
     }
 
-  /* Return EEXIST if the address is already a member of the group */
+  /* And start the timer at 10*100 msec */
+
+  igmp_starttimer(group, 10);
+
+  /* Add the group (MAC) address to the ether drivers MAC filter list */
 
-  return -EEXIST;
+  igmp_addmcastmac(dev, (FAR in_addr_t *)&grpaddr->s_addr);
+  return OK;
 }
 
 #endif /* CONFIG_NET_IGMP */
@@ -138,6 +138,17 @@ int igmp_leavegroup(struct net_driver_s *dev,
   ninfo("Leaving group: %p\n", group);
   if (group)
     {
+      /* Indicate one fewer members of the group from this host.  Take no
+       * further actions if there are other members of this group on this
+       * host.
+       */
+
+      if (group->njoins > 1)
+        {
+          group->njoins--;
+          return OK;
+        }
+
       /* Cancel the timer and discard any queued Membership Reports.  Canceling
        * the timer will prevent any new Membership Reports from being sent;
        * clearing the flags will discard any pending Membership Reports that
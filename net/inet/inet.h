@@ -69,6 +69,15 @@
 #  endif
 #endif
 
+/* True if a PF_INET or PF_INET6 socket is a UDP socket.  ICMP datagram
+ * sockets have the same type but a different socket interface.
+ */
+
+#define _INET_ISUDP(psock) \
+  ((psock)->s_type == SOCK_DGRAM && \
+   (psock)->s_sockif == inet_sockif((psock)->s_domain, SOCK_DGRAM, \
+                                    IPPROTO_UDP))
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
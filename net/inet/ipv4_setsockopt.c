@@ -50,10 +50,71 @@
 
 #include "netdev/netdev.h"
 #include "igmp/igmp.h"
+#include "udp/udp.h"
 #include "inet/inet.h"
 
 #ifdef CONFIG_NET_IPv4
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_udp_mcast
+ *
+ * Description:
+ *   Handle the multicast membership options of a UDP socket.  The
+ *   memberships are kept with the socket so that it only receives the
+ *   groups and sources it asked for.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_MCASTFILTER) && defined(CONFIG_NET_IGMP)
+static int ipv4_udp_mcast(FAR struct udp_conn_s *conn,
+                          FAR struct net_driver_s *dev, int option,
+                          FAR const struct in_addr *grpaddr,
+                          FAR const struct in_addr *srcaddr)
+{
+  union ip_addr_u group;
+  union ip_addr_u source;
+
+  if (!IN_MULTICAST(NTOHL(grpaddr->s_addr)))
+    {
+      return -EINVAL;
+    }
+
+  group.ipv4 = grpaddr->s_addr;
+  if (srcaddr != NULL)
+    {
+      source.ipv4 = srcaddr->s_addr;
+    }
+
+  switch (option)
+    {
+      case IP_ADD_MEMBERSHIP:
+        return udp_mcast_join(conn, dev, PF_INET, &group, NULL);
+
+      case IP_DROP_MEMBERSHIP:
+        return udp_mcast_leave(conn, dev, PF_INET, &group, NULL);
+
+      case IP_ADD_SOURCE_MEMBERSHIP:
+        return udp_mcast_join(conn, dev, PF_INET, &group, &source);
+
+      case IP_DROP_SOURCE_MEMBERSHIP:
+        return udp_mcast_leave(conn, dev, PF_INET, &group, &source);
+
+      case IP_BLOCK_SOURCE:
+        return udp_mcast_block(conn, dev, PF_INET, &group, &source, true);
+
+      case IP_UNBLOCK_SOURCE:
+        return udp_mcast_block(conn, dev, PF_INET, &group, &source, false);
+
+      default:
+        return -ENOPROTOOPT;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -172,6 +233,13 @@ int ipv4_setsockopt(FAR struct socket *psock, int option,
                   nwarn("WARNING: Could not find device for imr_interface\n");
                   ret = -ENODEV;
                 }
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+              else if (_INET_ISUDP(psock))
+                {
+                  ret = ipv4_udp_mcast(psock->s_conn, dev, option,
+                                       &mrec->imr_multiaddr, NULL);
+                }
+#endif
               else if (option == IP_ADD_MEMBERSHIP)
                 {
                   ret = igmp_joingroup(dev, &mrec->imr_multiaddr);
@@ -184,6 +252,59 @@ int ipv4_setsockopt(FAR struct socket *psock, int option,
         }
         break;
 
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+      case IP_ADD_SOURCE_MEMBERSHIP:  /* Join a multicast group; allow receive
+                                       * only from source */
+      case IP_DROP_SOURCE_MEMBERSHIP: /* Leave a source-specific group */
+      case IP_BLOCK_SOURCE:           /* Stop receiving multicast data from
+                                       * source */
+      case IP_UNBLOCK_SOURCE:         /* Unblock previously blocked multicast
+                                       * source */
+        {
+          FAR const struct ip_mreq_source *mrec;
+          FAR struct net_driver_s *dev;
+
+          /* Source filters are kept per socket and only UDP sockets
+           * receive multicast data.
+           */
+
+          mrec = (FAR const struct ip_mreq_source *)value;
+          if (mrec == NULL || value_len < sizeof(struct ip_mreq_source))
+            {
+              nerr("ERROR: Bad value or value_len\n");
+              ret = -EINVAL;
+            }
+          else if (!_INET_ISUDP(psock))
+            {
+              ret = -EOPNOTSUPP;
+            }
+          else
+            {
+              if (mrec->imr_interface.s_addr == INADDR_ANY)
+                {
+                  dev = netdev_default();
+                }
+              else
+                {
+                  dev = netdev_findby_lipv4addr(mrec->imr_interface.s_addr);
+                }
+
+              if (dev == NULL)
+                {
+                  nwarn("WARNING: No device for imr_interface\n");
+                  ret = -ENODEV;
+                }
+              else
+                {
+                  ret = ipv4_udp_mcast(psock->s_conn, dev, option,
+                                       &mrec->imr_multiaddr,
+                                       &mrec->imr_sourceaddr);
+                }
+            }
+        }
+        break;
+#endif
+
       /* The following IPv4 socket options are defined, but not implemented */
 
       case IP_MULTICAST_IF:           /* Set local device for a multicast
@@ -194,6 +315,7 @@ int ipv4_setsockopt(FAR struct socket *psock, int option,
                                        * whether sent multicast packets
                                        * should be looped back to local
                                        * sockets. */
+#ifndef CONFIG_NET_UDP_MCASTFILTER
       case IP_UNBLOCK_SOURCE:         /* Unblock previously blocked multicast
                                        * source */
       case IP_BLOCK_SOURCE:           /* Stop receiving multicast data from
@@ -203,6 +325,7 @@ int ipv4_setsockopt(FAR struct socket *psock, int option,
       case IP_DROP_SOURCE_MEMBERSHIP: /* Leave a source-specific group.  Stop
                                        * receiving data from a given multicast
                                        * group that come from a given source */
+#endif
       case IP_MULTICAST_ALL:          /* Modify the delivery policy of
                                        * multicast messages bound to
                                        * INADDR_ANY */
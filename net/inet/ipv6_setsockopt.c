@@ -47,11 +47,62 @@
 
 #include <nuttx/net/net.h>
 
+#include "netdev/netdev.h"
 #include "mld/mld.h"
+#include "udp/udp.h"
 #include "inet/inet.h"
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv6_udp_mcast
+ *
+ * Description:
+ *   Join or leave a multicast group on a UDP socket.  The memberships are
+ *   kept with the socket so that it only receives the groups it asked for.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_UDP_MCASTFILTER) && defined(CONFIG_NET_MLD)
+static int ipv6_udp_mcast(FAR struct udp_conn_s *conn,
+                          FAR const struct ipv6_mreq *mrec, bool join)
+{
+  FAR struct net_driver_s *dev;
+  union ip_addr_u group;
+
+  if (!net_is_addr_mcast(mrec->ipv6mr_multiaddr.s6_addr16))
+    {
+      return -EINVAL;
+    }
+
+  /* Use the default network device if an interface index of 0 is
+   * provided.
+   */
+
+  if (mrec->ipv6mr_interface == 0)
+    {
+      dev = netdev_default();
+    }
+  else
+    {
+      dev = netdev_findbyindex(mrec->ipv6mr_interface);
+    }
+
+  if (dev == NULL)
+    {
+      return -ENODEV;
+    }
+
+  net_ipv6addr_copy(group.ipv6, mrec->ipv6mr_multiaddr.s6_addr16);
+  return join ? udp_mcast_join(conn, dev, PF_INET6, &group, NULL) :
+                udp_mcast_leave(conn, dev, PF_INET6, &group, NULL);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -102,6 +153,12 @@ int ipv6_setsockopt(FAR struct socket *psock, int option,
             {
               ret = -EINVAL;
             }
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+          else if (_INET_ISUDP(psock))
+            {
+              ret = ipv6_udp_mcast(psock->s_conn, mrec, true);
+            }
+#endif
           else
             {
               ret = mld_joingroup(mrec);
@@ -118,6 +175,12 @@ int ipv6_setsockopt(FAR struct socket *psock, int option,
             {
               ret = -EINVAL;
             }
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+          else if (_INET_ISUDP(psock))
+            {
+              ret = ipv6_udp_mcast(psock->s_conn, mrec, false);
+            }
+#endif
           else
             {
               ret = mld_leavegroup(mrec);
@@ -43,6 +43,11 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/net/ip.h>
 
 #undef HAVE_FWDALLOC
 #ifdef CONFIG_NET_IPFORWARD
@@ -245,13 +250,77 @@ int ipfwd_forward(FAR struct forward_s *fwd);
  * Description:
  *   Poll all pending transfer for ARP requests to send.
  *
+ * Returned Value:
+ *   True if a forwarded packet was taken from the pending transfers.  There
+ *   may be more, so the caller should poll again after it has sent it.
+ *
  * Assumptions:
  *   This function is called from the MAC device driver indirectly through
  *   devif_poll() and devif_timer().
  *
  ****************************************************************************/
 
-void ipfwd_poll(FAR struct net_driver_s *dev);
+bool ipfwd_poll(FAR struct net_driver_s *dev);
+
+/****************************************************************************
+ * Name: ipv4_flowcache_lookup and ipv6_flowcache_lookup
+ *
+ * Description:
+ *   Return the output device last chosen for packets from 'src' to 'dest',
+ *   or NULL if there is no valid decision in the flow cache.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv4)
+FAR struct net_driver_s *ipv4_flowcache_lookup(in_addr_t src,
+                                               in_addr_t dest);
+#endif
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv6)
+FAR struct net_driver_s *ipv6_flowcache_lookup(const net_ipv6addr_t src,
+                                               const net_ipv6addr_t dest);
+#endif
+
+/****************************************************************************
+ * Name: ipv4_flowcache_add and ipv6_flowcache_add
+ *
+ * Description:
+ *   Remember the output device chosen for packets from 'src' to 'dest'.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv4)
+void ipv4_flowcache_add(in_addr_t src, in_addr_t dest,
+                        FAR struct net_driver_s *dev);
+#endif
+
+#if defined(CONFIG_NET_IPFORWARD_FLOWCACHE) && defined(CONFIG_NET_IPv6)
+void ipv6_flowcache_add(const net_ipv6addr_t src, const net_ipv6addr_t dest,
+                        FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: ipfwd_flowcache_flush
+ *
+ * Description:
+ *   Forget all cached forwarding decisions.  This must be called whenever
+ *   the routing tables change, or the addresses or the state of a network
+ *   device.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipfwd_flowcache_flush(void);
+#endif
 
 /****************************************************************************
  * Name: ipfwd_dropstats
@@ -0,0 +1,295 @@
+/****************************************************************************
+ * net/ipforward/ipfwd_flowcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
+
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_NET_IPFORWARD_FLOWCACHE_SIZE & \
+     (CONFIG_NET_IPFORWARD_FLOWCACHE_SIZE - 1)) != 0
+#  error CONFIG_NET_IPFORWARD_FLOWCACHE_SIZE must be a power of two
+#endif
+
+#define FLOW_MASK (CONFIG_NET_IPFORWARD_FLOWCACHE_SIZE - 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A flow cache entry is valid only while its generation is the current
+ * one.  Bumping the generation flushes the whole cache at once.
+ */
+
+#ifdef CONFIG_NET_IPv4
+struct ipv4_flow_s
+{
+  in_addr_t f_src;                     /* Source address */
+  in_addr_t f_dest;                    /* Destination address */
+  FAR struct net_driver_s *f_dev;      /* Output device */
+  uint16_t f_gen;                      /* Generation of the entry */
+};
+#endif
+
+#ifdef CONFIG_NET_IPv6
+struct ipv6_flow_s
+{
+  net_ipv6addr_t f_src;                /* Source address */
+  net_ipv6addr_t f_dest;               /* Destination address */
+  FAR struct net_driver_s *f_dev;      /* Output device */
+  uint16_t f_gen;                      /* Generation of the entry */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static struct ipv4_flow_s g_ipv4_flows[CONFIG_NET_IPFORWARD_FLOWCACHE_SIZE];
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static struct ipv6_flow_s g_ipv6_flows[CONFIG_NET_IPFORWARD_FLOWCACHE_SIZE];
+#endif
+
+/* The current generation.  Zero is never current, so zeroed entries are
+ * always invalid.
+ */
+
+static uint16_t g_flowgen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipfwd_flowhash
+ *
+ * Description:
+ *   Mix a 32-bit value into a flow cache index.
+ *
+ ****************************************************************************/
+
+static inline unsigned int ipfwd_flowhash(uint32_t key)
+{
+  return (unsigned int)((key * 2654435761u) >> 16) & FLOW_MASK;
+}
+
+/****************************************************************************
+ * Name: ipv4_flowentry and ipv6_flowentry
+ *
+ * Description:
+ *   Return the flow cache entry for a pair of addresses.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static inline FAR struct ipv4_flow_s *ipv4_flowentry(in_addr_t src,
+                                                     in_addr_t dest)
+{
+  return &g_ipv4_flows[ipfwd_flowhash(src ^ dest)];
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static inline FAR struct ipv6_flow_s *
+ipv6_flowentry(const net_ipv6addr_t src, const net_ipv6addr_t dest)
+{
+  uint32_t key = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      key ^= ((uint32_t)(src[i] ^ dest[i]) << 16) |
+             (uint32_t)(src[i + 1] ^ dest[i + 1]);
+    }
+
+  return &g_ipv6_flows[ipfwd_flowhash(key)];
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flowcache_lookup
+ *
+ * Description:
+ *   Return the output device last chosen for packets from 'src' to 'dest',
+ *   or NULL if there is no valid decision in the cache.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+FAR struct net_driver_s *ipv4_flowcache_lookup(in_addr_t src,
+                                               in_addr_t dest)
+{
+  FAR struct ipv4_flow_s *flow = ipv4_flowentry(src, dest);
+
+  if (flow->f_gen == g_flowgen && flow->f_src == src &&
+      flow->f_dest == dest)
+    {
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.ipfwd.hit++;
+#endif
+      return flow->f_dev;
+    }
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.ipfwd.miss++;
+#endif
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ipv4_flowcache_add
+ *
+ * Description:
+ *   Remember the output device chosen for packets from 'src' to 'dest'.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipv4_flowcache_add(in_addr_t src, in_addr_t dest,
+                        FAR struct net_driver_s *dev)
+{
+  FAR struct ipv4_flow_s *flow = ipv4_flowentry(src, dest);
+
+  flow->f_src  = src;
+  flow->f_dest = dest;
+  flow->f_dev  = dev;
+  flow->f_gen  = g_flowgen;
+}
+#endif /* CONFIG_NET_IPv4 */
+
+/****************************************************************************
+ * Name: ipv6_flowcache_lookup
+ *
+ * Description:
+ *   Return the output device last chosen for packets from 'src' to 'dest',
+ *   or NULL if there is no valid decision in the cache.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6
+FAR struct net_driver_s *ipv6_flowcache_lookup(const net_ipv6addr_t src,
+                                               const net_ipv6addr_t dest)
+{
+  FAR struct ipv6_flow_s *flow = ipv6_flowentry(src, dest);
+
+  if (flow->f_gen == g_flowgen && net_ipv6addr_cmp(flow->f_src, src) &&
+      net_ipv6addr_cmp(flow->f_dest, dest))
+    {
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.ipfwd.hit++;
+#endif
+      return flow->f_dev;
+    }
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.ipfwd.miss++;
+#endif
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ipv6_flowcache_add
+ *
+ * Description:
+ *   Remember the output device chosen for packets from 'src' to 'dest'.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipv6_flowcache_add(const net_ipv6addr_t src, const net_ipv6addr_t dest,
+                        FAR struct net_driver_s *dev)
+{
+  FAR struct ipv6_flow_s *flow = ipv6_flowentry(src, dest);
+
+  net_ipv6addr_copy(flow->f_src, src);
+  net_ipv6addr_copy(flow->f_dest, dest);
+  flow->f_dev = dev;
+  flow->f_gen = g_flowgen;
+}
+#endif /* CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Name: ipfwd_flowcache_flush
+ *
+ * Description:
+ *   Forget all cached forwarding decisions.  This must be called whenever
+ *   something changes that the decisions depend on:  The routing tables,
+ *   the addresses of a network device or whether it is up or registered.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipfwd_flowcache_flush(void)
+{
+  if (++g_flowgen == 0)
+    {
+      /* The generation wrapped.  Clear the entries so that none of them
+       * can become valid again.
+       */
+
+#ifdef CONFIG_NET_IPv4
+      memset(g_ipv4_flows, 0, sizeof(g_ipv4_flows));
+#endif
+#ifdef CONFIG_NET_IPv6
+      memset(g_ipv6_flows, 0, sizeof(g_ipv6_flows));
+#endif
+      g_flowgen = 1;
+    }
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
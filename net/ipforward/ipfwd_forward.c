@@ -253,6 +253,10 @@ int ipfwd_forward(FAR struct forward_s *fwd)
       fwd->f_cb->priv    = (FAR void *)fwd;
       fwd->f_cb->event   = ipfwd_eventhandler;
 
+#ifdef CONFIG_NET_STATISTICS
+      g_netstats.ipfwd.forward++;
+#endif
+
       /* Notify the device driver of the availability of TX data */
 
       netdev_txnotify_dev(fwd->f_dev);
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <debug.h>
 
 #include <nuttx/net/netdev.h>
@@ -166,13 +167,17 @@ static void ipfwd_packet_conversion(FAR struct net_driver_s *dev, int proto)
  * Description:
  *   Poll all pending transfer for ARP requests to send.
  *
+ * Returned Value:
+ *   True if a forwarded packet was taken from the pending transfers.  There
+ *   may be more, so the caller should poll again after it has sent it.
+ *
  * Assumptions:
  *   This function is called from the MAC device driver indirectly through
  *   devif_poll() and devif_timer().
  *
  ****************************************************************************/
 
-void ipfwd_poll(FAR struct net_driver_s *dev)
+bool ipfwd_poll(FAR struct net_driver_s *dev)
 {
   uint16_t flags;
 
@@ -201,9 +206,11 @@ void ipfwd_poll(FAR struct net_driver_s *dev)
           ipfwd_packet_conversion(dev, proto);
         }
     }
-#else
-  UNUSED(flags);
 #endif
+
+  /* The handler that forwarded a packet cleared the poll flags */
+
+  return (flags & DEVPOLL_MASK) == 0;
 }
 
 #endif /* CONFIG_NET_ARP_SEND */
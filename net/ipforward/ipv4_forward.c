@@ -152,8 +152,7 @@ static int ipv4_hdrsize(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 {
-  uint16_t iphdrlen;
-  uint16_t sum;
+  uint32_t sum;
   int ttl;
 
   /* Check time-to-live (TTL) */
@@ -176,27 +175,14 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 
   ipv4->ttl = ttl;
 
-  /* Get the IP header length (accounting for possible options). */
-
-  iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
-
-  /* Re-calculate the IPv4 checksum.  This checksum is the Internet checksum
-   * of the 20 bytes of the IPv4 header.  This checksum will be different
-   * because we just modify the IPv4 TTL.
+  /* Update the IPv4 checksum.  Only the TTL changed and it is the upper byte
+   * of a 16-bit header word that just decreased by one, so the checksum can
+   * be adjusted incrementally (RFC 1624) instead of being re-calculated over
+   * the whole header.
    */
 
-  ipv4->ipchksum = 0;
-  sum            = chksum(0, (FAR const uint8_t *)ipv4, iphdrlen);
-  if (sum == 0)
-    {
-      sum = 0xffff;
-    }
-  else
-    {
-      sum = htons(sum);
-    }
-
-  ipv4->ipchksum = ~sum;
+  sum            = (uint32_t)ipv4->ipchksum + htons(0x0100);
+  ipv4->ipchksum = (uint16_t)(sum + (sum >= 0xffff));
   return ttl;
 }
 
@@ -451,7 +437,22 @@ int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
   destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
   srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Reuse the decision made for earlier packets between the same hosts */
+
+  fwddev     = ipv4_flowcache_lookup(srcipaddr, destipaddr);
+  if (fwddev == NULL)
+    {
+      fwddev = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      if (fwddev != NULL)
+        {
+          ipv4_flowcache_add(srcipaddr, destipaddr, fwddev);
+        }
+    }
+#else
   fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+#endif
+
   if (fwddev == NULL)
     {
       nwarn("WARNING: Not routable\n");
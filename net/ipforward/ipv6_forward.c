@@ -583,7 +583,22 @@ int ipv6_forward(FAR struct net_driver_s *dev, FAR struct ipv6_hdr_s *ipv6)
 
   /* Search for a device that can forward this packet. */
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Reuse the decision made for earlier packets between the same hosts */
+
+  fwddev = ipv6_flowcache_lookup(ipv6->srcipaddr, ipv6->destipaddr);
+  if (fwddev == NULL)
+    {
+      fwddev = netdev_findby_ripv6addr(ipv6->srcipaddr, ipv6->destipaddr);
+      if (fwddev != NULL)
+        {
+          ipv6_flowcache_add(ipv6->srcipaddr, ipv6->destipaddr, fwddev);
+        }
+    }
+#else
   fwddev = netdev_findby_ripv6addr(ipv6->srcipaddr, ipv6->destipaddr);
+#endif
+
   if (fwddev == NULL)
     {
       nwarn("WARNING: Not routable\n");
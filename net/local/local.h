@@ -1,5 +1,5 @@
 /****************************************************************************
- * net/local/loal.h
+ * net/local/local.h
  *
  *   Copyright (C) 2015, 2019 Gregory Nutt. All rights reserved.
  *   Author: Gregory Nutt <gnutt@nuttx.org>
@@ -47,8 +47,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <queue.h>
-#include <stdint.h>
 #include <poll.h>
+#include <assert.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/net/net.h>
@@ -63,16 +63,9 @@
 #define HAVE_LOCAL_POLL 1
 #define LOCAL_NPOLLWAITERS 2
 
-/* Packet format in FIFO:
- *
- * 1. Sync bytes (7 at most)
- * 2. End/Start byte
- * 3. 16-bit packet length (in host order)
- * 4. Packet data (in host order)
- */
+/* Size of a datagram container holding 'n' bytes of payload */
 
-#define LOCAL_SYNC_BYTE   0x42     /* Byte in sync sequence */
-#define LOCAL_END_BYTE    0xbd     /* End of sync sequence */
+#define SIZEOF_LOCAL_DGRAM_S(n) (sizeof(struct local_dgram_s) + (n) - 1)
 
 /****************************************************************************
  * Public Type Definitions
@@ -108,6 +101,52 @@ enum local_state_s
   LOCAL_STATE_DISCONNECTED     /* Peer disconnected */
 };
 
+#ifdef CONFIG_NET_LOCAL_SCM
+/* One descriptor in flight.  The sender's descriptor is duplicated into
+ * one of these when the message is sent and the duplicate is installed in
+ * the receiver's descriptor table when the message is received.
+ */
+
+struct local_fd_s
+{
+  bool lf_issock;              /* True: lf_sock is valid, else lf_file */
+  union
+  {
+    struct file lf_file;       /* Reference to a passed file */
+    struct socket lf_sock;     /* Reference to a passed socket */
+  } u;
+};
+#endif
+
+/* The descriptors passed with one SCM_RIGHTS message */
+
+struct local_rights_s
+{
+  FAR struct local_rights_s *lr_flink;
+#ifdef CONFIG_NET_LOCAL_SCM
+  uint32_t lr_pos;             /* SOCK_STREAM: Stream position of the first
+                                * byte sent with the descriptors */
+  uint8_t lr_nfds;             /* Number of valid entries in lr_fds */
+  struct local_fd_s lr_fds[CONFIG_NET_LOCAL_SCM_MAXFD];
+#endif
+};
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+/* One queued datagram */
+
+struct local_dgram_s
+{
+  FAR struct local_dgram_s *ld_flink;
+
+  /* Passed descriptors or NULL */
+
+  FAR struct local_rights_s *ld_rights;
+  uint16_t ld_len;             /* Length of the payload in ld_data */
+  char ld_from[UNIX_PATH_MAX]; /* Path bound to the sender (may be empty) */
+  uint8_t ld_data[1];          /* Payload (actually variable length) */
+};
+#endif
+
 /* Representation of a local connection.  There are four types of
  * connection structures:
  *
@@ -122,8 +161,12 @@ enum local_state_s
  * And
  *
  * 4. Connectionless.  Like a peer but using a connectionless datagram
- *    style of communication.  SOCK_DRAM support has not yet been
- *    implemented.
+ *    style of communication.
+ *
+ * Connected peers point at each other.  Each peer owns a ring buffer that
+ * the other side copies into directly, so data never passes through the
+ * file system.  Datagrams are queued on the bound receiver in the same
+ * way.  All of this state is protected by the network lock.
  */
 
 struct devif_callback_s;       /* Forward reference */
@@ -134,7 +177,8 @@ struct local_conn_s
 
   /* lc_node supports a doubly linked list: Listening SOCK_STREAM servers
    * will be linked into a list of listeners; SOCK_STREAM clients will be
-   * linked to the lc_waiters and lc_conn lists.
+   * linked to the lc_waiters and lc_conn lists; bound SOCK_DGRAM sockets
+   * are linked into the list of datagram receivers.
    */
 
   dq_entry_t lc_node;          /* Supports a doubly linked list */
@@ -155,29 +199,32 @@ struct local_conn_s
   uint8_t lc_proto;            /* SOCK_STREAM or SOCK_DGRAM */
   uint8_t lc_type;             /* See enum local_type_e */
   uint8_t lc_state;            /* See enum local_state_e */
-  struct file lc_infile;       /* File for read-only FIFO (peers) */
-  struct file lc_outfile;      /* File descriptor of write-only FIFO (peers) */
   char lc_path[UNIX_PATH_MAX]; /* Path assigned by bind() */
-  int32_t lc_instance_id;      /* Connection instance ID for stream
-                                * server<->client connection pair */
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-  /* SOCK_STREAM fields common to both client and server */
-
-  sem_t lc_waitsem;            /* Use to wait for a connection to be accepted */
+  sem_t lc_rxsem;              /* Readers waiting for incoming data */
+  sem_t lc_txsem;              /* Writers waiting for space at a receiver */
 
 #ifdef HAVE_LOCAL_POLL
   /* The following is a list if poll structures of threads waiting for
    * socket events.
    */
 
-  struct pollfd *lc_accept_fds[LOCAL_NPOLLWAITERS];
-  struct pollfd lc_inout_fds[2*LOCAL_NPOLLWAITERS];
+  FAR struct pollfd *lc_fds[LOCAL_NPOLLWAITERS];
 #endif
 
-  /* Union of fields unique to SOCK_STREAM client, server, and connected
-   * peers.
-   */
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  /* SOCK_DGRAM receive queue */
+
+  sq_queue_t lc_dgrams;        /* Queued struct local_dgram_s */
+  uint16_t lc_dgramlen;        /* Total payload bytes in lc_dgrams */
+#endif
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+  /* SOCK_STREAM fields common to both client and server */
+
+  sem_t lc_waitsem;            /* Wait for a connection to be accepted */
+  volatile int lc_result;      /* Result of a connection attempt (client) */
+
+  /* Union of fields unique to SOCK_STREAM servers and connected peers */
 
   union
   {
@@ -190,19 +237,21 @@ struct local_conn_s
       dq_queue_t lc_waiters;   /* List of connections waiting to be accepted */
     } server;
 
-    /* Fields unique to the connecting client side */
-
-    struct
-    {
-      uint16_t lc_remaining;   /* (For binary compatibility with peer) */
-      volatile int lc_result;  /* Result of the connection operation (client) */
-    } client;
-
     /* Fields common to connected peers (connected or accepted) */
 
     struct
     {
-      uint16_t lc_remaining;   /* Bytes remaining in the incoming stream */
+      /* The other end, NULL once it has been closed */
+
+      FAR struct local_conn_s *lc_peer;
+      FAR uint8_t *lc_rxbuf;   /* Receive ring written by lc_peer */
+      uint16_t lc_rxhead;      /* Index of the oldest byte in lc_rxbuf */
+      uint16_t lc_rxlen;       /* Number of bytes in lc_rxbuf */
+      uint32_t lc_rxpos;       /* Stream position of the byte at lc_rxhead */
+#ifdef CONFIG_NET_LOCAL_SCM
+      sq_queue_t lc_rights;    /* Descriptors passed along with the data,
+                                * ordered by lr_pos */
+#endif
     } peer;
   } u;
 #endif /* CONFIG_NET_LOCAL_STREAM */
@@ -230,12 +279,20 @@ EXTERN const struct sock_intf_s g_local_sockif;
 EXTERN dq_queue_t g_local_listeners;
 #endif
 
+#ifdef CONFIG_NET_LOCAL_DGRAM
+/* A list of all SOCK_DGRAM connections bound to a path */
+
+EXTERN dq_queue_t g_local_receivers;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
 struct sockaddr; /* Forward reference */
 struct socket;   /* Forward reference */
+struct iovec;    /* Forward reference */
+struct msghdr;   /* Forward reference */
 
 /****************************************************************************
  * Name: local_initialize
@@ -270,6 +327,42 @@ FAR struct local_conn_s *local_alloc(void);
 
 void local_free(FAR struct local_conn_s *conn);
 
+/****************************************************************************
+ * Name: local_wakeup
+ *
+ * Description:
+ *   Wake up every thread waiting on one of the lc_rxsem or lc_txsem
+ *   semaphores.  The waiters re-check their condition when they run, so
+ *   the count of the semaphore never becomes positive.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_wakeup(FAR sem_t *sem);
+
+/****************************************************************************
+ * Name: local_stream_link
+ *
+ * Description:
+ *   Connect two SOCK_STREAM connection structures to each other and give
+ *   each one its receive ring buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM is returned if the ring
+ *   buffers could not be allocated.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+int local_stream_link(FAR struct local_conn_s *conn1,
+                      FAR struct local_conn_s *conn2);
+#endif
+
 /****************************************************************************
  * Name: psock_local_bind
  *
@@ -304,6 +397,25 @@ int psock_local_bind(FAR struct socket *psock,
 int psock_local_connect(FAR struct socket *psock,
                         FAR const struct sockaddr *addr);
 
+/****************************************************************************
+ * Name: local_socketpair
+ *
+ * Description:
+ *   Connect two newly created, unbound Unix domain sockets to each other.
+ *   This implements the address family specific part of socketpair().
+ *
+ * Input Parameters:
+ *   psock1 - The first socket of the pair
+ *   psock2 - The second socket of the pair
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int local_socketpair(FAR struct socket *psock1, FAR struct socket *psock2);
+
 /****************************************************************************
  * Name: local_release
  *
@@ -375,6 +487,34 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
                  FAR socklen_t *addrlen, FAR struct socket *newsock);
 #endif
 
+/****************************************************************************
+ * Name: local_stream_send
+ *
+ * Description:
+ *   Copy data into the receive ring of the connected peer, waiting for
+ *   space as necessary.
+ *
+ * Input Parameters:
+ *   conn     The sending connection
+ *   iov      The data to send
+ *   iovcnt   Number of entries in iov
+ *   nonblock True: Return -EAGAIN rather than wait for space
+ *   rights   Descriptors to pass along with the data (may be NULL).  On
+ *            success, ownership passes to the peer.
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes sent.  Otherwise, a negated
+ *   errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+ssize_t local_stream_send(FAR struct local_conn_s *conn,
+                          FAR const struct iovec *iov, int iovcnt,
+                          bool nonblock,
+                          FAR struct local_rights_s *rights);
+#endif
+
 /****************************************************************************
  * Name: psock_local_send
  *
@@ -385,12 +525,12 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
  *   psock    An instance of the internal socket structure.
  *   buf      Data to send
  *   len      Length of data to send
- *   flags    Send flags (ignored for now)
+ *   flags    Send flags
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   -1 is returned, and errno is set appropriately (see send() for the
- *   list of errno numbers).
+ *   On success, returns the number of characters sent.  On  error, a
+ *   negated errno value is returned (see send() for the list of errno
+ *   numbers).
  *
  ****************************************************************************/
 
@@ -399,6 +539,36 @@ ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
                          size_t len, int flags);
 #endif
 
+/****************************************************************************
+ * Name: local_dgram_send
+ *
+ * Description:
+ *   Queue one datagram on the socket bound to the destination path,
+ *   waiting for space as necessary.
+ *
+ * Input Parameters:
+ *   psock    The sending socket
+ *   iov      The payload of the datagram
+ *   iovcnt   Number of entries in iov
+ *   flags    Send flags
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *   rights   Descriptors to pass along with the datagram (may be NULL).  On
+ *            success, ownership passes to the receiver.
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes sent.  Otherwise, a negated
+ *   errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+ssize_t local_dgram_send(FAR struct socket *psock,
+                         FAR const struct iovec *iov, int iovcnt, int flags,
+                         FAR const struct sockaddr *to, socklen_t tolen,
+                         FAR struct local_rights_s *rights);
+#endif
+
 /****************************************************************************
  * Name: psock_local_sendto
  *
@@ -431,24 +601,33 @@ ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
 #endif
 
 /****************************************************************************
- * Name: local_send_packet
+ * Name: local_recv
  *
  * Description:
- *   Send a packet on the write-only FIFO.
+ *   Receive data from a stream or datagram socket into an I/O vector.  This
+ *   is the common part of local_recvfrom() and recvmsg().
  *
  * Input Parameters:
- *   filep    File structure of write-only FIFO.
- *   buf      Data to send
- *   len      Length of data to send
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iov      Buffers to receive data
+ *   iovcnt   Number of entries in iov
+ *   flags    Receive flags
+ *   from     Address of source (may be NULL)
+ *   fromlen  The length of the address structure
+ *   rights   Location to return descriptors passed with the data.  If
+ *            NULL, such descriptors are closed.
  *
  * Returned Value:
- *   Zero is returned on success; a negated errno value is returned on any
- *   failure.
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly shutdown,
+ *   zero is returned.  Otherwise, a negated errno value is returned.
  *
  ****************************************************************************/
 
-int local_send_packet(FAR struct file *filep, FAR const uint8_t *buf,
-                      size_t len);
+ssize_t local_recv(FAR struct socket *psock, FAR const struct iovec *iov,
+                   int iovcnt, int flags, FAR struct sockaddr *from,
+                   FAR socklen_t *fromlen,
+                   FAR struct local_rights_s **rights);
 
 /****************************************************************************
  * Name: local_recvfrom
@@ -482,36 +661,14 @@ ssize_t local_recvfrom(FAR struct socket *psock, FAR void *buf,
                        size_t len, int flags, FAR struct sockaddr *from,
                        FAR socklen_t *fromlen);
 
-/****************************************************************************
- * Name: local_fifo_read
- *
- * Description:
- *   Read a data from the read-only FIFO.
- *
- * Input Parameters:
- *   filep - File structure of write-only FIFO.
- *   buf   - Local to store the received data
- *   len   - Length of data to receive [in]
- *           Length of data actually received [out]
- *
- * Returned Value:
- *   Zero is returned on success; a negated errno value is returned on any
- *   failure.  If -ECONNRESET is received, then the sending side has closed
- *   the FIFO. In this case, the returned data may still be valid (if the
- *   returned len > 0).
- *
- ****************************************************************************/
-
-int local_fifo_read(FAR struct file *filep, FAR uint8_t *buf, size_t *len);
-
 /****************************************************************************
  * Name: local_getaddr
  *
  * Description:
- *   Return the Unix domain address of a connection.
+ *   Return a Unix domain address for a path.
  *
  * Input Parameters:
- *   conn - The connection
+ *   path - The path, possibly empty
  *   addr - The location to return the address
  *   addrlen - The size of the memory allocate by the caller to receive the
  *             address.
@@ -521,157 +678,74 @@ int local_fifo_read(FAR struct file *filep, FAR uint8_t *buf, size_t *len);
  *
  ****************************************************************************/
 
-int local_getaddr(FAR struct local_conn_s *conn, FAR struct sockaddr *addr,
+int local_getaddr(FAR const char *path, FAR struct sockaddr *addr,
                   FAR socklen_t *addrlen);
 
 /****************************************************************************
- * Name: local_sync
+ * Name: local_rights_get
  *
  * Description:
- *   Read a sync bytes until the start of the packet is found.
+ *   Take references to the descriptors named in the SCM_RIGHTS control
+ *   message of 'msg'.
  *
  * Input Parameters:
- *   filep - File structure of write-only FIFO.
+ *   msg    - The message passed to sendmsg()
+ *   rights - The location to return the new rights, or NULL if 'msg' does
+ *            not pass any descriptors.
  *
  * Returned Value:
- *   The non-zero size of the following packet is returned on success; a
- *   negated errno value is returned on any failure.
- *
- ****************************************************************************/
-
-int local_sync(FAR struct file *filep);
-
-/****************************************************************************
- * Name: local_create_fifos
- *
- * Description:
- *   Create the FIFO pair needed for a SOCK_STREAM connection.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_create_fifos(FAR struct local_conn_s *conn);
-#endif
-
-/****************************************************************************
- * Name: local_create_halfduplex
- *
- * Description:
- *   Create the half-duplex FIFO needed for SOCK_DGRAM communication.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_DGRAM
-int local_create_halfduplex(FAR struct local_conn_s *conn,
-                            FAR const char *path);
-#endif
-
-/****************************************************************************
- * Name: local_release_fifos
- *
- * Description:
- *   Release references to the FIFO pair used for a SOCK_STREAM connection.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_release_fifos(FAR struct local_conn_s *conn);
-#endif
-
-/****************************************************************************
- * Name: local_release_halfduplex
- *
- * Description:
- *   Release a reference to the FIFO used for SOCK_DGRAM communication
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_DGRAM
-int local_release_halfduplex(FAR struct local_conn_s *conn);
-#endif
-
-/****************************************************************************
- * Name: local_open_client_rx
- *
- * Description:
- *   Only the client-side Rx FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_client_rx(FAR struct local_conn_s *client, bool nonblock);
-#endif
-
-/****************************************************************************
- * Name: local_open_client_tx
- *
- * Description:
- *   Only the client-side Tx FIFO.
- *
- ****************************************************************************/
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_client_tx(FAR struct local_conn_s *client, bool nonblock);
-#endif
-
-/****************************************************************************
- * Name: local_open_server_rx
- *
- * Description:
- *   Only the server-side Rx FIFO.
+ *   Zero (OK) on success; a negated errno value on failure.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_server_rx(FAR struct local_conn_s *server, bool nonblock);
+#ifdef CONFIG_NET_LOCAL_SCM
+int local_rights_get(FAR struct msghdr *msg,
+                     FAR struct local_rights_s **rights);
 #endif
 
 /****************************************************************************
- * Name: local_open_server_tx
+ * Name: local_rights_put
  *
  * Description:
- *   Only the server-side Tx FIFO.
+ *   Install received descriptors in the descriptor table of the caller and
+ *   return their numbers in the control buffer of 'msg'.  Descriptors that
+ *   do not fit are closed and MSG_CTRUNC is reported.  'rights' is freed
+ *   in any case.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-int local_open_server_tx(FAR struct local_conn_s *server, bool nonblock);
+#ifdef CONFIG_NET_LOCAL_SCM
+void local_rights_put(FAR struct local_rights_s *rights,
+                      FAR struct msghdr *msg);
 #endif
 
 /****************************************************************************
- * Name: local_open_receiver
+ * Name: local_rights_free
  *
  * Description:
- *   Only the receiving side of the half duplex FIFO.
+ *   Close the descriptors of a set of rights that will never be received
+ *   and free it.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_DGRAM
-int local_open_receiver(FAR struct local_conn_s *conn, bool nonblock);
+#ifdef CONFIG_NET_LOCAL_SCM
+void local_rights_free(FAR struct local_rights_s *rights);
+#else
+#  define local_rights_free(r) DEBUGASSERT((r) == NULL)
 #endif
 
 /****************************************************************************
- * Name: local_open_sender
+ * Name: local_pollnotify
  *
  * Description:
- *   Only the sending side of the half duplex FIFO.
+ *   Report events to the threads polling a Unix domain socket.
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_DGRAM
-int local_open_sender(FAR struct local_conn_s *conn, FAR const char *path,
-                      bool nonblock);
-#endif
-
-/****************************************************************************
- * Name: local_accept_pollnotify
- ****************************************************************************/
-
 #ifdef HAVE_LOCAL_POLL
-void local_accept_pollnotify(FAR struct local_conn_s *conn,
-                             pollevent_t eventset);
+void local_pollnotify(FAR struct local_conn_s *conn, pollevent_t eventset);
 #else
-#define local_accept_pollnotify(conn, eventset) ((void)(conn))
+#  define local_pollnotify(conn, eventset) ((void)(conn))
 #endif
 
 /****************************************************************************
@@ -160,7 +160,7 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
           server->u.server.lc_pending--;
 
           /* Create a new connection structure for the server side of the
-           * connection.
+           * connection and link it directly to the client.
            */
 
           conn = local_alloc();
@@ -174,59 +174,24 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               /* Initialize the new connection structure */
 
               conn->lc_crefs  = 1;
-              conn->lc_proto  = SOCK_STREAM;
               conn->lc_type   = LOCAL_TYPE_PATHNAME;
-              conn->lc_state  = LOCAL_STATE_CONNECTED;
 
               strncpy(conn->lc_path, client->lc_path, UNIX_PATH_MAX - 1);
               conn->lc_path[UNIX_PATH_MAX - 1] = '\0';
-              conn->lc_instance_id = client->lc_instance_id;
 
-              /* Open the server-side write-only FIFO.  This should not
-               * block.
-               */
-
-              ret = local_open_server_tx(conn,
-                                         _SS_ISNONBLOCK(psock->s_flags));
-              if (ret < 0)
-                {
-                   nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
-                        conn->lc_path, ret);
-                }
-            }
-
-          /* Do we have a connection?  Is the write-side FIFO opened? */
-
-          if (ret == OK)
-            {
-              DEBUGASSERT(conn->lc_outfile.f_inode != NULL);
-
-              /* Open the server-side read-only FIFO.  This should not
-               * block because the client side has already opening it
-               * for writing.
-               */
-
-              ret = local_open_server_rx(conn,
-                                         _SS_ISNONBLOCK(psock->s_flags));
+              ret = local_stream_link(conn, client);
               if (ret < 0)
                 {
-                   nerr("ERROR: Failed to open read-only FIFOs for %s: %d\n",
-                        conn->lc_path, ret);
+                  nerr("ERROR: Failed to link %s: %d\n", conn->lc_path, ret);
+                  local_free(conn);
                 }
             }
 
-          /* Do we have a connection?  Are the FIFOs opened? */
+          /* Return the address family */
 
-          if (ret == OK)
+          if (ret == OK && addr != NULL)
             {
-              DEBUGASSERT(conn->lc_infile.f_inode != NULL);
-
-              /* Return the address family */
-
-              if (addr != NULL)
-                {
-                  ret = local_getaddr(client, addr, addrlen);
-                }
+              ret = local_getaddr(client->lc_path, addr, addrlen);
             }
 
           if (ret == OK)
@@ -242,7 +207,7 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
 
           /* Signal the client with the result of the connection */
 
-          client->u.client.lc_result = ret;
+          client->lc_result = ret;
           nxsem_post(&client->lc_waitsem);
           return ret;
         }
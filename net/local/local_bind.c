@@ -43,6 +43,7 @@
 #include <sys/socket.h>
 #include <string.h>
 #include <assert.h>
+#include <errno.h>
 
 #include <nuttx/net/net.h>
 
@@ -75,6 +76,13 @@ int psock_local_bind(FAR struct socket *psock,
 
   conn = (FAR struct local_conn_s *)psock->s_conn;
 
+  /* A socket can only be bound once */
+
+  if (conn->lc_state != LOCAL_STATE_UNBOUND)
+    {
+      return -EINVAL;
+    }
+
   /* Save the address family */
 
   conn->lc_proto = psock->s_type;
@@ -109,7 +117,35 @@ int psock_local_bind(FAR struct socket *psock,
 
           strncpy(conn->lc_path, unaddr->sun_path, UNIX_PATH_MAX - 1);
           conn->lc_path[UNIX_PATH_MAX - 1] = '\0';
-          conn->lc_instance_id = -1;
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+          /* Datagrams are delivered to the socket bound to the path, so
+           * only one socket may be bound to it.
+           */
+
+          if (conn->lc_proto == SOCK_DGRAM)
+            {
+              FAR struct local_conn_s *other;
+
+              net_lock();
+              for (other = (FAR struct local_conn_s *)g_local_receivers.head;
+                   other != NULL;
+                   other = (FAR struct local_conn_s *)
+                           dq_next(&other->lc_node))
+                {
+                  if (strcmp(other->lc_path, conn->lc_path) == 0)
+                    {
+                      net_unlock();
+                      conn->lc_type    = LOCAL_TYPE_UNTYPED;
+                      conn->lc_path[0] = '\0';
+                      return -EADDRINUSE;
+                    }
+                }
+
+              dq_addlast(&conn->lc_node, &g_local_receivers);
+              net_unlock();
+            }
+#endif
         }
     }
 
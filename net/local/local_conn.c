@@ -68,6 +68,9 @@ void local_initialize(void)
 #ifdef CONFIG_NET_LOCAL_STREAM
   dq_init(&g_local_listeners);
 #endif
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  dq_init(&g_local_receivers);
+#endif
 }
 
 /****************************************************************************
@@ -92,11 +95,16 @@ FAR struct local_conn_s *local_alloc(void)
        * necessary to zerio-ize any structure elements.
        */
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-      /* This semaphore is used for signaling and, hence, should not have
-       * priority inheritance enabled.
+      /* These semaphores are used for signaling and, hence, should not
+       * have priority inheritance enabled.
        */
 
+      nxsem_init(&conn->lc_rxsem, 0, 0);
+      nxsem_set_protocol(&conn->lc_rxsem, SEM_PRIO_NONE);
+      nxsem_init(&conn->lc_txsem, 0, 0);
+      nxsem_set_protocol(&conn->lc_txsem, SEM_PRIO_NONE);
+
+#ifdef CONFIG_NET_LOCAL_STREAM
       nxsem_init(&conn->lc_waitsem, 0, 0);
       nxsem_set_protocol(&conn->lc_waitsem, SEM_PRIO_NONE);
 #endif
@@ -118,32 +126,132 @@ void local_free(FAR struct local_conn_s *conn)
 {
   DEBUGASSERT(conn != NULL);
 
-  /* Make sure that the read-only FIFO is closed */
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  /* Discard any datagrams that were never received */
 
-  if (conn->lc_infile.f_inode != NULL)
+  if (conn->lc_proto == SOCK_DGRAM)
     {
-      file_close(&conn->lc_infile);
-      conn->lc_infile.f_inode = NULL;
+      FAR struct local_dgram_s *pkt;
+
+      while ((pkt = (FAR struct local_dgram_s *)
+                    sq_remfirst(&conn->lc_dgrams)) != NULL)
+        {
+          local_rights_free(pkt->ld_rights);
+          kmm_free(pkt);
+        }
     }
+#endif
 
-  /* Make sure that the write-only FIFO is closed */
+#ifdef CONFIG_NET_LOCAL_STREAM
+  /* Free the receive ring of a connected peer along with any descriptors
+   * that were passed but never received.
+   */
 
-  if (conn->lc_outfile.f_inode != NULL)
+  if (conn->lc_proto == SOCK_STREAM &&
+      (conn->lc_state == LOCAL_STATE_CONNECTED ||
+       conn->lc_state == LOCAL_STATE_DISCONNECTED))
     {
-      file_close(&conn->lc_outfile);
-      conn->lc_outfile.f_inode = NULL;
-    }
+#ifdef CONFIG_NET_LOCAL_SCM
+      FAR struct local_rights_s *rights;
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-  /* Destroy all FIFOs associted with the connection */
+      while ((rights = (FAR struct local_rights_s *)
+                       sq_remfirst(&conn->u.peer.lc_rights)) != NULL)
+        {
+          local_rights_free(rights);
+        }
+#endif
+
+      if (conn->u.peer.lc_rxbuf != NULL)
+        {
+          kmm_free(conn->u.peer.lc_rxbuf);
+        }
+    }
 
-  local_release_fifos(conn);
   nxsem_destroy(&conn->lc_waitsem);
 #endif
 
+  nxsem_destroy(&conn->lc_rxsem);
+  nxsem_destroy(&conn->lc_txsem);
+
   /* And free the connection structure */
 
   kmm_free(conn);
 }
 
+/****************************************************************************
+ * Name: local_wakeup
+ *
+ * Description:
+ *   Wake up every thread waiting on one of the lc_rxsem or lc_txsem
+ *   semaphores.  The waiters re-check their condition when they run, so
+ *   the count of the semaphore never becomes positive.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void local_wakeup(FAR sem_t *sem)
+{
+  int sval;
+
+  while (nxsem_get_value(sem, &sval) >= 0 && sval < 0)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_stream_link
+ *
+ * Description:
+ *   Connect two SOCK_STREAM connection structures to each other and give
+ *   each one its receive ring buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM is returned if the ring
+ *   buffers could not be allocated.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM
+int local_stream_link(FAR struct local_conn_s *conn1,
+                      FAR struct local_conn_s *conn2)
+{
+  FAR uint8_t *rxbuf1;
+  FAR uint8_t *rxbuf2;
+
+  rxbuf1 = (FAR uint8_t *)kmm_malloc(CONFIG_NET_LOCAL_STREAM_BUFSIZE);
+  if (rxbuf1 == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  rxbuf2 = (FAR uint8_t *)kmm_malloc(CONFIG_NET_LOCAL_STREAM_BUFSIZE);
+  if (rxbuf2 == NULL)
+    {
+      kmm_free(rxbuf1);
+      return -ENOMEM;
+    }
+
+  /* The union now holds the peer fields */
+
+  memset(&conn1->u.peer, 0, sizeof(conn1->u.peer));
+  conn1->u.peer.lc_peer  = conn2;
+  conn1->u.peer.lc_rxbuf = rxbuf1;
+  conn1->lc_proto        = SOCK_STREAM;
+  conn1->lc_state        = LOCAL_STATE_CONNECTED;
+
+  memset(&conn2->u.peer, 0, sizeof(conn2->u.peer));
+  conn2->u.peer.lc_peer  = conn1;
+  conn2->u.peer.lc_rxbuf = rxbuf2;
+  conn2->lc_proto        = SOCK_STREAM;
+  conn2->lc_state        = LOCAL_STATE_CONNECTED;
+  return OK;
+}
+#endif /* CONFIG_NET_LOCAL_STREAM */
+
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL */
@@ -33,9 +33,6 @@
 
 #include <nuttx/net/net.h>
 
-#include <arch/irq.h>
-
-#include "utils/utils.h"
 #include "socket/socket.h"
 #include "local/local.h"
 
@@ -45,47 +42,12 @@
  * Private Functions
  ****************************************************************************/
 
-/****************************************************************************
- * Name: local_generate_instance_id
- ****************************************************************************/
-
-static int32_t local_generate_instance_id(void)
-{
-  static int32_t g_next_instance_id = 0;
-  int32_t id;
-
-  /* Called from local_connect with net_lock held. */
-
-  id = g_next_instance_id++;
-  if (g_next_instance_id < 0)
-    {
-      g_next_instance_id = 0;
-    }
-
-  return id;
-}
-
-/****************************************************************************
- * Name: _local_semtake() and _local_semgive()
- *
- * Description:
- *   Take/give semaphore
- *
- ****************************************************************************/
-
-static inline void _local_semtake(sem_t *sem)
-{
-  net_lockedwait_uninterruptible(sem);
-}
-
-#define _local_semgive(sem) nxsem_post(sem)
-
 /****************************************************************************
  * Name: local_stream_connect
  *
  * Description:
- *   Find a local connection structure that is the appropriate "server"
- *   connection to be used with the provided "client" connection.
+ *   Queue the "client" connection on the "server" connection and wait for
+ *   the server to accept it.  The accepting side links the two peers.
  *
  * Returned Value:
  *   Zero (OK) returned on success; A negated errno value is returned on a
@@ -99,8 +61,7 @@ static inline void _local_semtake(sem_t *sem)
  ****************************************************************************/
 
 static int inline local_stream_connect(FAR struct local_conn_s *client,
-                                       FAR struct local_conn_s *server,
-                                       bool nonblock)
+                                       FAR struct local_conn_s *server)
 {
   int ret;
   int sval;
@@ -126,89 +87,39 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
   server->u.server.lc_pending++;
   DEBUGASSERT(server->u.server.lc_pending != 0);
 
-  /* Create the FIFOs needed for the connection */
-
-  ret = local_create_fifos(client);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to create FIFOs for %s: %d\n",
-           client->lc_path, ret);
-
-      net_unlock();
-      return ret;
-    }
-
-  /* Open the client-side write-only FIFO.  This should not block and should
-   * prevent the server-side from blocking as well.
-   */
-
-  ret = local_open_client_tx(client, nonblock);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
-           client->lc_path, ret);
-
-      net_unlock();
-      goto errout_with_fifos;
-    }
-
-  DEBUGASSERT(client->lc_outfile.f_inode != NULL);
-
   /* Set the busy "result" before giving the semaphore. */
 
-  client->u.client.lc_result = -EBUSY;
+  client->lc_result = -EBUSY;
 
   /* Add ourself to the list of waiting connections and notify the server. */
 
   dq_addlast(&client->lc_node, &server->u.server.lc_waiters);
   client->lc_state = LOCAL_STATE_ACCEPT;
-  local_accept_pollnotify(server, POLLIN);
+  local_pollnotify(server, POLLIN);
 
   if (nxsem_get_value(&server->lc_waitsem, &sval) >= 0 && sval < 1)
     {
-      _local_semgive(&server->lc_waitsem);
+      nxsem_post(&server->lc_waitsem);
     }
 
-  net_unlock();
-
-  /* Wait for the server to accept the connections */
+  /* Wait for the server to accept the connection.  The server sets the
+   * client state when it links the two peers.
+   */
 
   do
     {
-      _local_semtake(&client->lc_waitsem);
-      ret = client->u.client.lc_result;
+      net_lockedwait_uninterruptible(&client->lc_waitsem);
+      ret = client->lc_result;
     }
   while (ret == -EBUSY);
 
-  /* Did we successfully connect? */
-
   if (ret < 0)
     {
       nerr("ERROR: Failed to connect: %d\n", ret);
-      goto errout_with_outfd;
+      client->lc_state = LOCAL_STATE_BOUND;
     }
 
-  /* Yes.. open the read-only FIFO */
-
-  ret = local_open_client_rx(client, nonblock);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to open write-only FIFOs for %s: %d\n",
-           client->lc_path, ret);
-      goto errout_with_outfd;
-    }
-
-  DEBUGASSERT(client->lc_infile.f_inode != NULL);
-  client->lc_state = LOCAL_STATE_CONNECTED;
-  return OK;
-
-errout_with_outfd:
-  file_close(&client->lc_outfile);
-  client->lc_outfile.f_inode = NULL;
-
-errout_with_fifos:
-  local_release_fifos(client);
-  client->lc_state = LOCAL_STATE_BOUND;
+  net_unlock();
   return ret;
 }
 
@@ -293,7 +204,6 @@ int psock_local_connect(FAR struct socket *psock,
                 strncpy(client->lc_path, unaddr->sun_path,
                         UNIX_PATH_MAX - 1);
                 client->lc_path[UNIX_PATH_MAX - 1] = '\0';
-                client->lc_instance_id = local_generate_instance_id();
 
                 /* The client is now bound to an address */
 
@@ -303,9 +213,7 @@ int psock_local_connect(FAR struct socket *psock,
 
                 if (conn->lc_proto == SOCK_STREAM)
                   {
-                    ret =
-                      local_stream_connect(client, conn,
-                                           _SS_ISNONBLOCK(psock->s_flags));
+                    ret = local_stream_connect(client, conn);
                   }
                 else
                   {
@@ -39,14 +39,12 @@
 
 #include <nuttx/config.h>
 
-#include <unistd.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
-#include <nuttx/fs/fs.h>
 
 #include "socket/socket.h"
 #include "local/local.h"
@@ -54,101 +52,102 @@
 #ifdef HAVE_LOCAL_POLL
 
 /****************************************************************************
- * Name: local_accept_pollsetup
+ * Private Functions
  ****************************************************************************/
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-static int local_accept_pollsetup(FAR struct local_conn_s *conn,
-                                  FAR struct pollfd *fds,
-                                  bool setup)
+/****************************************************************************
+ * Name: local_pollevents
+ *
+ * Description:
+ *   Return the set of events that are currently true for a connection.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static pollevent_t local_pollevents(FAR struct local_conn_s *conn)
 {
-  pollevent_t eventset;
-  int ret = OK;
-  int i;
+  pollevent_t eventset = 0;
 
-  net_lock();
-  if (setup)
+#ifdef CONFIG_NET_LOCAL_STREAM
+  if (conn->lc_proto == SOCK_STREAM)
     {
-      /* This is a request to set up the poll.  Find an available
-       * slot for the poll structure reference
-       */
+      FAR struct local_conn_s *peer;
 
-      for (i = 0; i < LOCAL_NPOLLWAITERS; i++)
+      switch (conn->lc_state)
         {
-          /* Find an available slot */
-
-          if (!conn->lc_accept_fds[i])
-            {
-              /* Bind the poll structure and this slot */
-
-              conn->lc_accept_fds[i] = fds;
-              fds->priv = &conn->lc_accept_fds[i];
-              break;
-            }
-        }
-
-      if (i >= LOCAL_NPOLLWAITERS)
-        {
-          fds->priv = NULL;
-          ret = -EBUSY;
-          goto errout;
-        }
-
-      eventset = 0;
-      if (dq_peek(&conn->u.server.lc_waiters) != NULL)
-        {
-          eventset |= POLLIN;
-        }
-
-      if (eventset)
-        {
-          local_accept_pollnotify(conn, eventset);
+          case LOCAL_STATE_LISTENING:
+            if (!dq_empty(&conn->u.server.lc_waiters))
+              {
+                eventset |= POLLIN;
+              }
+            break;
+
+          case LOCAL_STATE_CONNECTED:
+          case LOCAL_STATE_DISCONNECTED:
+            peer = conn->u.peer.lc_peer;
+            if (conn->u.peer.lc_rxlen > 0 || peer == NULL)
+              {
+                eventset |= POLLIN;
+              }
+
+            if (peer == NULL)
+              {
+                eventset |= POLLHUP;
+              }
+            else if (peer->u.peer.lc_rxlen < CONFIG_NET_LOCAL_STREAM_BUFSIZE)
+              {
+                eventset |= POLLOUT;
+              }
+            break;
+
+          default:
+            break;
         }
     }
-  else
-    {
-      /* This is a request to tear down the poll. */
+#endif
 
-      struct pollfd **slot = (struct pollfd **)fds->priv;
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  if (conn->lc_proto == SOCK_DGRAM)
+    {
+      /* A datagram socket can always try to send */
 
-      if (!slot)
+      eventset |= POLLOUT;
+      if (!sq_empty(&conn->lc_dgrams))
         {
-          ret = -EIO;
-          goto errout;
+          eventset |= POLLIN;
         }
-
-      /* Remove all memory of the poll setup */
-
-      *slot = NULL;
-      fds->priv = NULL;
     }
+#endif
 
-errout:
-  net_unlock();
-  return ret;
+  return eventset;
 }
-#endif
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: local_accept_pollnotify
+ * Name: local_pollnotify
+ *
+ * Description:
+ *   Report events to the threads polling a Unix domain socket.
+ *
  ****************************************************************************/
 
-void local_accept_pollnotify(FAR struct local_conn_s *conn,
-                             pollevent_t eventset)
+void local_pollnotify(FAR struct local_conn_s *conn, pollevent_t eventset)
 {
-#ifdef CONFIG_NET_LOCAL_STREAM
   int i;
 
   for (i = 0; i < LOCAL_NPOLLWAITERS; i++)
     {
-      struct pollfd *fds = conn->lc_accept_fds[i];
+      struct pollfd *fds = conn->lc_fds[i];
       if (fds)
         {
-          fds->revents |= (fds->events & eventset);
+          /* POLLHUP and POLLERR are always reported */
+
+          fds->revents |= eventset & (fds->events | POLLHUP | POLLERR);
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
@@ -156,7 +155,6 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
             }
         }
     }
-#endif
 }
 
 /****************************************************************************
@@ -178,135 +176,44 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
 int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 {
   FAR struct local_conn_s *conn;
-  int ret = -ENOSYS;
+  pollevent_t eventset;
+  int i;
 
   conn = (FAR struct local_conn_s *)psock->s_conn;
 
-  if (conn->lc_proto == SOCK_DGRAM)
-    {
-      return ret;
-    }
+  net_lock();
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-  if (conn->lc_state == LOCAL_STATE_LISTENING &&
-      conn->lc_type  == LOCAL_TYPE_PATHNAME)
-    {
-      return local_accept_pollsetup(conn, fds, true);
-    }
+  /* Find an available slot for the poll structure reference */
 
-  if (conn->lc_state == LOCAL_STATE_DISCONNECTED)
-    {
-      fds->priv = NULL;
-      goto pollerr;
-    }
-
-  switch (fds->events & (POLLIN | POLLOUT))
+  for (i = 0; i < LOCAL_NPOLLWAITERS; i++)
     {
-      case (POLLIN | POLLOUT):
+      if (conn->lc_fds[i] == NULL)
         {
-          FAR struct pollfd *shadowfds;
-
-          /* Poll wants to check state for both input and output. */
-
-          if (conn->lc_infile.f_inode == NULL ||
-              conn->lc_outfile.f_inode == NULL)
-            {
-              fds->priv = NULL;
-              goto pollerr;
-            }
-
-          /* Find shadow pollfds. */
-
-          net_lock();
-
-          shadowfds = conn->lc_inout_fds;
-          while (shadowfds->fd != 0)
-            {
-              shadowfds += 2;
-              if (shadowfds >= &conn->lc_inout_fds[2*LOCAL_NPOLLWAITERS])
-                {
-                  net_unlock();
-                  return -ENOMEM;
-                }
-            }
-
-          shadowfds[0].fd     = 1; /* Does not matter */
-          shadowfds[0].sem    = fds->sem;
-          shadowfds[0].events = fds->events & ~POLLOUT;
-
-          shadowfds[1].fd     = 0; /* Does not matter */
-          shadowfds[1].sem    = fds->sem;
-          shadowfds[1].events = fds->events & ~POLLIN;
-
-          net_unlock();
-
-          /* Setup poll for both shadow pollfds. */
+          /* Bind the poll structure and this slot */
 
-          ret = file_poll(&conn->lc_infile, &shadowfds[0], true);
-          if (ret >= 0)
-            {
-              ret = file_poll(&conn->lc_outfile, &shadowfds[1], true);
-              if (ret < 0)
-                {
-                  file_poll(&conn->lc_infile, &shadowfds[0], false);
-                }
-            }
-
-          if (ret < 0)
-            {
-              shadowfds[0].fd = 0;
-              fds->priv = NULL;
-              goto pollerr;
-            }
-          else
-            {
-              fds->priv = shadowfds;
-            }
-        }
-        break;
-
-      case POLLIN:
-        {
-          /* Poll wants to check state for input only. */
-
-          if (conn->lc_infile.f_inode == NULL)
-            {
-              fds->priv = NULL;
-              goto pollerr;
-            }
-
-          ret = file_poll(&conn->lc_infile, fds, true);
+          conn->lc_fds[i] = fds;
+          fds->priv = &conn->lc_fds[i];
+          break;
         }
-        break;
-
-      case POLLOUT:
-        {
-          /* Poll wants to check state for output only. */
+    }
 
-          if (conn->lc_outfile.f_inode == NULL)
-            {
-              fds->priv = NULL;
-              goto pollerr;
-            }
+  if (i >= LOCAL_NPOLLWAITERS)
+    {
+      fds->priv = NULL;
+      net_unlock();
+      return -EBUSY;
+    }
 
-          ret = file_poll(&conn->lc_outfile, fds, true);
-        }
-        break;
+  /* Report any events that are already true */
 
-      default:
-        ret = OK;
-        break;
+  eventset = local_pollevents(conn);
+  if (eventset != 0)
+    {
+      local_pollnotify(conn, eventset);
     }
-#endif
 
-  return ret;
-
-#ifdef CONFIG_NET_LOCAL_STREAM
-pollerr:
-  fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  net_unlock();
   return OK;
-#endif
 }
 
 /****************************************************************************
@@ -327,83 +234,20 @@ pollerr:
 
 int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
 {
-  FAR struct local_conn_s *conn;
-  int ret = OK;
-
-  conn = (FAR struct local_conn_s *)psock->s_conn;
+  FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
 
-  if (conn->lc_proto == SOCK_DGRAM)
+  if (slot == NULL)
     {
-      return -ENOSYS;
+      return -EIO;
     }
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-  if (conn->lc_state == LOCAL_STATE_LISTENING &&
-      conn->lc_type  == LOCAL_TYPE_PATHNAME)
-    {
-      return local_accept_pollsetup(conn, fds, false);
-    }
-
-  if (conn->lc_state == LOCAL_STATE_DISCONNECTED)
-    {
-      return OK;
-    }
-
-  switch (fds->events & (POLLIN | POLLOUT))
-    {
-      case (POLLIN | POLLOUT):
-        {
-          FAR struct pollfd *shadowfds = fds->priv;
-          int ret2;
-
-          if (shadowfds == NULL)
-            {
-              return OK;
-            }
-
-          /* Teardown for both shadow pollfds. */
-
-          ret = file_poll(&conn->lc_infile, &shadowfds[0], false);
-          ret2 = file_poll(&conn->lc_outfile, &shadowfds[1], false);
-          if (ret2 < 0)
-            {
-              ret = ret2;
-            }
-
-          fds->revents |= shadowfds[0].revents | shadowfds[1].revents;
-          fds->priv = NULL;
-          shadowfds[0].fd = 0;
-        }
-        break;
-
-      case POLLIN:
-        {
-          if (fds->priv == NULL)
-            {
-              return OK;
-            }
-
-          ret = file_poll(&conn->lc_infile, fds, false);
-        }
-        break;
-
-      case POLLOUT:
-        {
-          if (fds->priv == NULL)
-            {
-              return OK;
-            }
+  /* Remove all memory of the poll setup */
 
-          ret = file_poll(&conn->lc_outfile, fds, false);
-        }
-        break;
-
-      default:
-        break;
-    }
-#endif
-
-  return ret;
+  net_lock();
+  *slot = NULL;
+  fds->priv = NULL;
+  net_unlock();
+  return OK;
 }
 
 #endif /* HAVE_LOCAL_POLL */
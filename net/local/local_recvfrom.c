@@ -42,11 +42,13 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
-#include <unistd.h>
+#include <sys/uio.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
@@ -65,146 +67,177 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: psock_fifo_read
+ * Name: local_iov_copy
  *
  * Description:
- *   A thin layer around local_fifo_read that handles socket-related loss-of-
- *   connection events.
+ *   Scatter 'len' bytes from 'buf' into an I/O vector, starting 'offset'
+ *   bytes into the vector.
  *
  ****************************************************************************/
 
-static int psock_fifo_read(FAR struct socket *psock, FAR void *buf,
-                           FAR size_t *readlen)
+static void local_iov_copy(FAR const struct iovec *iov, int iovcnt,
+                           size_t offset, FAR const uint8_t *buf, size_t len)
 {
-  FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
-  int ret;
+  size_t ncopy;
 
-  ret = local_fifo_read(&conn->lc_infile, buf, readlen);
-  if (ret < 0)
+  for (; iovcnt > 0 && len > 0; iov++, iovcnt--)
     {
-      /* -ECONNRESET is a special case.  We may or not have received
-       * data, then the peer closed the connection.
-       */
-
-      if (ret == -ECONNRESET)
+      if (offset >= iov->iov_len)
         {
-          nerr("ERROR: Lost connection: %d\n", ret);
-
-          /* Report an ungraceful loss of connection.  This should
-           * eventually be reported as ENOTCONN.
-           */
-
-          psock->s_flags &= ~(_SF_CONNECTED | _SF_CLOSED);
-          conn->lc_state  = LOCAL_STATE_DISCONNECTED;
-
-          /* Did we receive any data? */
+          offset -= iov->iov_len;
+          continue;
+        }
 
-          if (*readlen <= 0)
-            {
-              /* No.. return the ECONNRESET error now.  Otherwise,
-               * process the received data and return ENOTCONN the
-               * next time that psock_recvfrom() is called.
-               */
+      ncopy = MIN(len, iov->iov_len - offset);
+      memcpy((FAR uint8_t *)iov->iov_base + offset, buf, ncopy);
 
-              return ret;
-            }
-        }
-      else
-        {
-          nerr("ERROR: Failed to read packet: %d\n", ret);
-          return ret;
-        }
+      buf   += ncopy;
+      len   -= ncopy;
+      offset = 0;
     }
-
-  return OK;
 }
 
 /****************************************************************************
  * Name: psock_stream_recvfrom
  *
  * Description:
- *   psock_stream_recvfrom() receives messages from a local stream socket.
+ *   psock_stream_recvfrom() receives data from the ring buffer of a local
+ *   stream socket.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
- *   buf      Buffer to receive data
- *   len      Length of buffer
+ *   iov      Buffers to receive data
+ *   iovcnt   Number of entries in iov
+ *   len      Total length of the buffers
  *   flags    Receive flags
  *   from     Address of source (may be NULL)
  *   fromlen  The length of the address structure
+ *   rights   Location to return passed descriptors (may be NULL)
  *
  * Returned Value:
  *   On success, returns the number of characters received.  If no data is
  *   available to be received and the peer has performed an orderly shutdown,
- *   recv() will return 0.  Otherwise, on errors, -1 is returned, and errno
- *   is set appropriately (see receive from for the complete list).
+ *   zero is returned.  Otherwise, a negated errno value is returned.
+ *
+ * Assumptions:
+ *   The network is locked.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_LOCAL_STREAM
 static inline ssize_t
-psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                      int flags, FAR struct sockaddr *from,
-                      FAR socklen_t *fromlen)
+psock_stream_recvfrom(FAR struct socket *psock, FAR const struct iovec *iov,
+                      int iovcnt, size_t len, int flags,
+                      FAR struct sockaddr *from, FAR socklen_t *fromlen,
+                      FAR struct local_rights_s **rights)
 {
   FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
+  FAR struct local_conn_s *peer;
   size_t readlen;
+  size_t chunk;
   int ret;
 
   /* Verify that this is a connected peer socket */
 
-  if (conn->lc_state != LOCAL_STATE_CONNECTED)
+  if (conn->lc_state != LOCAL_STATE_CONNECTED &&
+      conn->lc_state != LOCAL_STATE_DISCONNECTED)
     {
       nerr("ERROR: not connected\n");
       return -ENOTCONN;
     }
 
-  /* The incoming FIFO should be open */
-
-  DEBUGASSERT(conn->lc_infile.f_inode != NULL);
-
-  /* Are there still bytes in the FIFO from the last packet? */
+  /* Wait for data.  Once the peer has gone and the ring is drained, this
+   * is the end of the stream.
+   */
 
-  if (conn->u.peer.lc_remaining == 0)
+  while (conn->u.peer.lc_rxlen == 0)
     {
-      /* No.. Sync to the start of the next packet in the stream and get
-       * the size of the next packet.
-       */
+      if (conn->u.peer.lc_peer == NULL)
+        {
+          return 0;
+        }
 
-      ret = local_sync(&conn->lc_infile);
+      if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+        {
+          return -EAGAIN;
+        }
+
+      ret = net_lockedwait(&conn->lc_rxsem);
       if (ret < 0)
         {
-          nerr("ERROR: Failed to get packet length: %d\n", ret);
           return ret;
         }
-      else if (ret > UINT16_MAX)
+    }
+
+  readlen = MIN(len, conn->u.peer.lc_rxlen);
+
+#ifdef CONFIG_NET_LOCAL_SCM
+  /* Descriptors are returned with the data they were sent with.  Take the
+   * ones that start here and stop short of the next ones.  A read that
+   * returns no data leaves them for the read that does.
+   */
+
+    {
+      FAR struct local_rights_s *next;
+
+      next = (FAR struct local_rights_s *)sq_peek(&conn->u.peer.lc_rights);
+      if (readlen > 0 && next != NULL &&
+          next->lr_pos == conn->u.peer.lc_rxpos)
         {
-          nerr("ERROR: Packet is too big: %d\n", ret);
-          return -E2BIG;
+          sq_remfirst(&conn->u.peer.lc_rights);
+          if (rights != NULL && *rights == NULL)
+            {
+              *rights = next;
+            }
+          else
+            {
+              local_rights_free(next);
+            }
+
+          next = (FAR struct local_rights_s *)
+                 sq_peek(&conn->u.peer.lc_rights);
         }
 
-      conn->u.peer.lc_remaining = (uint16_t)ret;
+      if (next != NULL &&
+          next->lr_pos - conn->u.peer.lc_rxpos < readlen)
+        {
+          readlen = next->lr_pos - conn->u.peer.lc_rxpos;
+        }
     }
+#endif
+
+  /* Copy out of the ring, up to its end and then from its beginning */
 
-  /* Read the packet */
+  chunk = MIN(readlen,
+              CONFIG_NET_LOCAL_STREAM_BUFSIZE - conn->u.peer.lc_rxhead);
+  local_iov_copy(iov, iovcnt, 0,
+                 &conn->u.peer.lc_rxbuf[conn->u.peer.lc_rxhead], chunk);
+  local_iov_copy(iov, iovcnt, chunk, conn->u.peer.lc_rxbuf,
+                 readlen - chunk);
 
-  readlen = MIN(conn->u.peer.lc_remaining, len);
-  ret     = psock_fifo_read(psock, buf, &readlen);
-  if (ret < 0)
+  conn->u.peer.lc_rxhead += readlen;
+  if (conn->u.peer.lc_rxhead >= CONFIG_NET_LOCAL_STREAM_BUFSIZE)
     {
-      return ret;
+      conn->u.peer.lc_rxhead -= CONFIG_NET_LOCAL_STREAM_BUFSIZE;
     }
 
-  /* Adjust the number of bytes remaining to be read from the packet */
+  conn->u.peer.lc_rxlen -= readlen;
+  conn->u.peer.lc_rxpos += readlen;
 
-  DEBUGASSERT(readlen <= conn->u.peer.lc_remaining);
-  conn->u.peer.lc_remaining -= readlen;
+  /* Wake up the writers of the peer */
+
+  peer = conn->u.peer.lc_peer;
+  if (peer != NULL)
+    {
+      local_wakeup(&peer->lc_txsem);
+      local_pollnotify(peer, POLLOUT);
+    }
 
   /* Return the address family */
 
   if (from)
     {
-      ret = local_getaddr(conn, from, fromlen);
+      ret = local_getaddr(conn->lc_path, from, fromlen);
       if (ret < 0)
         {
           return ret;
@@ -219,40 +252,40 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
  * Name: psock_dgram_recvfrom
  *
  * Description:
- *   psock_dgram_recvfrom() receives messages from a local datagram socket.
+ *   psock_dgram_recvfrom() receives the next datagram queued on a local
+ *   datagram socket.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
- *   buf      Buffer to receive data
- *   len      Length of buffer
+ *   iov      Buffers to receive data
+ *   iovcnt   Number of entries in iov
+ *   len      Total length of the buffers
  *   flags    Receive flags
  *   from     Address of source (may be NULL)
  *   fromlen  The length of the address structure
+ *   rights   Location to return passed descriptors (may be NULL)
  *
  * Returned Value:
- *   On success, returns the number of characters received.  Otherwise, on
- *   errors, -1 is returned, and errno is set appropriately (see receive
- *   from for the complete list).
+ *   On success, returns the number of characters received.  Otherwise, a
+ *   negated errno value is returned.
+ *
+ * Assumptions:
+ *   The network is locked.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_NET_LOCAL_DGRAM
 static inline ssize_t
-psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                     int flags, FAR struct sockaddr *from,
-                     FAR socklen_t *fromlen)
+psock_dgram_recvfrom(FAR struct socket *psock, FAR const struct iovec *iov,
+                     int iovcnt, size_t len, int flags,
+                     FAR struct sockaddr *from, FAR socklen_t *fromlen,
+                     FAR struct local_rights_s **rights)
 {
   FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
-  uint16_t pktlen;
+  FAR struct local_dgram_s *pkt;
   size_t readlen;
   int ret;
 
-  /* We keep packet sizes in a uint16_t, so there is a upper limit to the
-   * 'len' that can be supported.
-   */
-
-  DEBUGASSERT(len <= UINT16_MAX);
-
   /* Verify that this is a bound, un-connected peer socket */
 
   if (conn->lc_state != LOCAL_STATE_BOUND)
@@ -263,131 +296,130 @@ psock_dgram_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return -EISCONN;
     }
 
-  /* The incoming FIFO should not be open */
+  /* Wait for a datagram */
 
-  DEBUGASSERT(conn->lc_infile.f_inode == NULL);
-
-  /* Make sure that half duplex FIFO has been created */
-
-  ret = local_create_halfduplex(conn, conn->lc_path);
-  if (ret < 0)
+  while (sq_empty(&conn->lc_dgrams))
     {
-      nerr("ERROR: Failed to create FIFO for %s: %d\n",
-           conn->lc_path, ret);
-      return ret;
+      if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+        {
+          return -EAGAIN;
+        }
+
+      ret = net_lockedwait(&conn->lc_rxsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
     }
 
-  /* Open the receiving side of the transfer */
+  pkt = (FAR struct local_dgram_s *)sq_remfirst(&conn->lc_dgrams);
+  conn->lc_dgramlen -= pkt->ld_len;
 
-  ret = local_open_receiver(conn, _SS_ISNONBLOCK(psock->s_flags) ||
-                            (flags & MSG_DONTWAIT) != 0);
-  if (ret < 0)
-    {
-      nerr("ERROR: Failed to open FIFO for %s: %d\n",
-           conn->lc_path, ret);
-      goto errout_with_halfduplex;
-      return ret;
-    }
+  /* Copy the datagram.  Any part that does not fit is discarded. */
 
-  /* Sync to the start of the next packet in the stream and get the size of
-   * the next packet.
-   */
+  readlen = MIN(pkt->ld_len, len);
+  local_iov_copy(iov, iovcnt, 0, pkt->ld_data, readlen);
 
-  ret = local_sync(&conn->lc_infile);
-  if (ret < 0)
+  if (rights != NULL && *rights == NULL)
     {
-      nerr("ERROR: Failed to get packet length: %d\n", ret);
-      goto errout_with_infd;
+      *rights = pkt->ld_rights;
     }
-  else if (ret > UINT16_MAX)
+  else
     {
-      nerr("ERROR: Packet is too big: %d\n", ret);
-      goto errout_with_infd;
+      local_rights_free(pkt->ld_rights);
     }
 
-  pktlen = ret;
+  /* Return the address of the sender */
 
-  /* Read the packet */
-
-  readlen = MIN(pktlen, len);
-  ret     = psock_fifo_read(psock, buf, &readlen);
-  if (ret < 0)
+  ret = OK;
+  if (from)
     {
-      goto errout_with_infd;
+      ret = local_getaddr(pkt->ld_from, from, fromlen);
     }
 
-  /* If there are unread bytes remaining in the packet, flush the remainder
-   * of the packet to the bit bucket.
-   */
-
-  DEBUGASSERT(readlen <= pktlen);
-  if (readlen < pktlen)
-    {
-      uint8_t bitbucket[32];
-      uint16_t remaining;
-      size_t tmplen;
-
-      remaining = pktlen - readlen;
-      do
-        {
-          /* Read 32 bytes into the bit bucket */
-
-          readlen = MIN(remaining, 32);
-          ret     = psock_fifo_read(psock, bitbucket, &tmplen);
-          if (ret < 0)
-            {
-              goto errout_with_infd;
-            }
-
-          /* Adjust the number of bytes remaining to be read from the packet */
+  kmm_free(pkt);
 
-          DEBUGASSERT(tmplen <= remaining);
-          remaining -= tmplen;
-        }
-      while (remaining > 0);
-    }
+  /* There is space for more datagrams now */
 
-  /* Now we can close the read-only file descriptor */
+  local_wakeup(&conn->lc_txsem);
+  return ret < 0 ? ret : readlen;
+}
+#endif /* CONFIG_NET_LOCAL_DGRAM */
 
-  file_close(&conn->lc_infile);
-  conn->lc_infile.f_inode = NULL;
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
 
-  /* Release our reference to the half duplex FIFO */
+/****************************************************************************
+ * Name: local_recv
+ *
+ * Description:
+ *   Receive data from a stream or datagram socket into an I/O vector.  This
+ *   is the common part of local_recvfrom() and recvmsg().
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   iov      Buffers to receive data
+ *   iovcnt   Number of entries in iov
+ *   flags    Receive flags
+ *   from     Address of source (may be NULL)
+ *   fromlen  The length of the address structure
+ *   rights   Location to return descriptors passed with the data.  If
+ *            NULL, such descriptors are closed.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly shutdown,
+ *   zero is returned.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
 
-  local_release_halfduplex(conn);
+ssize_t local_recv(FAR struct socket *psock, FAR const struct iovec *iov,
+                   int iovcnt, int flags, FAR struct sockaddr *from,
+                   FAR socklen_t *fromlen,
+                   FAR struct local_rights_s **rights)
+{
+  ssize_t ret;
+  size_t len = 0;
+  int i;
 
-  /* Return the address family */
+  DEBUGASSERT(psock && psock->s_conn && iov);
 
-  if (from)
+  for (i = 0; i < iovcnt; i++)
     {
-      ret = local_getaddr(conn, from, fromlen);
-      if (ret < 0)
-        {
-          return ret;
-        }
+      len += iov[i].iov_len;
     }
 
-  return readlen;
+  net_lock();
 
-errout_with_infd:
-
-  /* Close the read-only file descriptor */
-
-  file_close(&conn->lc_infile);
-  conn->lc_infile.f_inode = NULL;
+  /* Check for a stream socket */
 
-errout_with_halfduplex:
+#ifdef CONFIG_NET_LOCAL_STREAM
+  if (psock->s_type == SOCK_STREAM)
+    {
+      ret = psock_stream_recvfrom(psock, iov, iovcnt, len, flags,
+                                  from, fromlen, rights);
+    }
+  else
+#endif
 
-  /* Release our reference to the half duplex FIFO */
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      ret = psock_dgram_recvfrom(psock, iov, iovcnt, len, flags,
+                                 from, fromlen, rights);
+    }
+  else
+#endif
+    {
+      DEBUGPANIC();
+      nerr("ERROR: Unrecognized socket type: %d\n", psock->s_type);
+      ret = -EINVAL;
+    }
 
-  local_release_halfduplex(conn);
+  net_unlock();
   return ret;
 }
-#endif /* CONFIG_NET_LOCAL_STREAM */
-
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
 
 /****************************************************************************
  * Name: local_recvfrom
@@ -422,30 +454,14 @@ ssize_t local_recvfrom(FAR struct socket *psock, FAR void *buf,
                        size_t len, int flags, FAR struct sockaddr *from,
                        FAR socklen_t *fromlen)
 {
-  DEBUGASSERT(psock && psock->s_conn && buf);
+  struct iovec iov;
 
-  /* Check for a stream socket */
+  DEBUGASSERT(buf);
 
-#ifdef CONFIG_NET_LOCAL_STREAM
-  if (psock->s_type == SOCK_STREAM)
-    {
-      return psock_stream_recvfrom(psock, buf, len, flags, from, fromlen);
-    }
-  else
-#endif
+  iov.iov_base = buf;
+  iov.iov_len  = len;
 
-#ifdef CONFIG_NET_LOCAL_DGRAM
-  if (psock->s_type == SOCK_DGRAM)
-    {
-      return psock_dgram_recvfrom(psock, buf, len, flags, from, fromlen);
-    }
-  else
-#endif
-    {
-      DEBUGPANIC();
-      nerr("ERROR: Unrecognized socket type: %s\n", psock->s_type);
-      return -EINVAL;
-    }
+  return local_recv(psock, &iov, 1, flags, from, fromlen, NULL);
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL */
@@ -85,9 +85,26 @@ int local_release(FAR struct local_conn_s *conn)
   if (conn->lc_state == LOCAL_STATE_CONNECTED ||
       conn->lc_state == LOCAL_STATE_DISCONNECTED)
     {
+      FAR struct local_conn_s *peer = conn->u.peer.lc_peer;
+
       DEBUGASSERT(conn->lc_proto == SOCK_STREAM);
 
-      /* Just free the connection structure */
+      /* Detach from the peer, if it is still open.  Data already in the
+       * ring of the peer remains readable; after that it will see the end
+       * of the stream and any writer will get EPIPE.
+       */
+
+      if (peer != NULL)
+        {
+          DEBUGASSERT(peer->u.peer.lc_peer == conn);
+
+          peer->u.peer.lc_peer = NULL;
+          peer->lc_state       = LOCAL_STATE_DISCONNECTED;
+
+          local_wakeup(&peer->lc_rxsem);
+          local_wakeup(&peer->lc_txsem);
+          local_pollnotify(peer, POLLIN | POLLHUP);
+        }
     }
 
   /* Is the socket is listening socket (SOCK_STREAM server) */
@@ -104,7 +121,7 @@ int local_release(FAR struct local_conn_s *conn)
            client;
            client = (FAR struct local_conn_s *)dq_next(&client->lc_node))
         {
-          client->u.client.lc_result = -ENOTCONN;
+          client->lc_result = -ENOTCONN;
           nxsem_post(&client->lc_waitsem);
         }
 
@@ -116,6 +133,20 @@ int local_release(FAR struct local_conn_s *conn)
     }
 #endif /* CONFIG_NET_LOCAL_STREAM */
 
+#ifdef CONFIG_NET_LOCAL_DGRAM
+  /* Is this a datagram socket bound to a path? */
+
+  if (conn->lc_proto == SOCK_DGRAM && conn->lc_type == LOCAL_TYPE_PATHNAME)
+    {
+      /* Remove it from the list of receivers.  Senders waiting for space
+       * will look up the path again and fail.
+       */
+
+      dq_rem(&conn->lc_node, &g_local_receivers);
+      local_wakeup(&conn->lc_txsem);
+    }
+#endif /* CONFIG_NET_LOCAL_DGRAM */
+
   /* For the remaining states (LOCAL_STATE_UNBOUND and LOCAL_STATE_UNBOUND),
    * we simply free the connection structure.
    */
@@ -0,0 +1,311 @@
+/****************************************************************************
+ * net/local/local_rights.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_LOCAL_SCM)
+
+#include <sys/socket.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_fd_get
+ *
+ * Description:
+ *   Take a reference to the file or socket open on descriptor 'fd' of the
+ *   calling task.
+ *
+ ****************************************************************************/
+
+static int local_fd_get(int fd, FAR struct local_fd_s *lfd)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  if (fd >= 0 && fd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      ret = fs_getfilep(fd, &filep);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      lfd->lf_issock = false;
+      return file_dup2(filep, &lfd->u.lf_file);
+    }
+
+  psock = sockfd_socket(fd);
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  lfd->lf_issock = true;
+  return psock_dup2(psock, &lfd->u.lf_sock);
+}
+
+/****************************************************************************
+ * Name: local_fd_close
+ *
+ * Description:
+ *   Release a reference taken by local_fd_get().
+ *
+ ****************************************************************************/
+
+static void local_fd_close(FAR struct local_fd_s *lfd)
+{
+  if (lfd->lf_issock)
+    {
+      psock_close(&lfd->u.lf_sock);
+    }
+  else
+    {
+      file_close(&lfd->u.lf_file);
+    }
+}
+
+/****************************************************************************
+ * Name: local_fd_install
+ *
+ * Description:
+ *   Allocate a descriptor for a passed file or socket in the calling task.
+ *
+ * Returned Value:
+ *   The new descriptor on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int local_fd_install(FAR struct local_fd_s *lfd)
+{
+  if (lfd->lf_issock)
+    {
+      return psock_dup(&lfd->u.lf_sock, 0);
+    }
+  else
+    {
+      return file_dup(&lfd->u.lf_file, 0);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_rights_get
+ *
+ * Description:
+ *   Take references to the descriptors named in the SCM_RIGHTS control
+ *   message of 'msg'.
+ *
+ * Input Parameters:
+ *   msg    - The message passed to sendmsg()
+ *   rights - The location to return the new rights, or NULL if 'msg' does
+ *            not pass any descriptors.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int local_rights_get(FAR struct msghdr *msg,
+                     FAR struct local_rights_s **rights)
+{
+  FAR struct local_rights_s *lr = NULL;
+  FAR struct cmsghdr *cmsg;
+  FAR int *fds;
+  int nfds;
+  int ret;
+  int i;
+
+  *rights = NULL;
+
+  for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL;
+       cmsg = CMSG_NXTHDR(msg, cmsg))
+    {
+      if (cmsg->cmsg_len < CMSG_LEN(0) ||
+          cmsg->cmsg_len > msg->msg_controllen)
+        {
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      /* Other kinds of control messages are ignored */
+
+      if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+        {
+          continue;
+        }
+
+      /* Only one set of descriptors may be passed with a message */
+
+      nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      if (lr != NULL || nfds > CONFIG_NET_LOCAL_SCM_MAXFD)
+        {
+          ret = -ETOOMANYREFS;
+          goto errout;
+        }
+
+      if (nfds == 0)
+        {
+          continue;
+        }
+
+      lr = (FAR struct local_rights_s *)
+        kmm_zalloc(sizeof(struct local_rights_s));
+      if (lr == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      fds = (FAR int *)CMSG_DATA(cmsg);
+      for (i = 0; i < nfds; i++)
+        {
+          ret = local_fd_get(fds[i], &lr->lr_fds[i]);
+          if (ret < 0)
+            {
+              nerr("ERROR: Cannot pass descriptor %d: %d\n", fds[i], ret);
+              goto errout;
+            }
+
+          lr->lr_nfds++;
+        }
+    }
+
+  *rights = lr;
+  return OK;
+
+errout:
+  if (lr != NULL)
+    {
+      local_rights_free(lr);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_rights_put
+ *
+ * Description:
+ *   Install received descriptors in the descriptor table of the caller and
+ *   return their numbers in the control buffer of 'msg'.  Descriptors that
+ *   do not fit are closed and MSG_CTRUNC is reported.  'rights' is freed
+ *   in any case.
+ *
+ ****************************************************************************/
+
+void local_rights_put(FAR struct local_rights_s *rights,
+                      FAR struct msghdr *msg)
+{
+  FAR struct cmsghdr *cmsg;
+  FAR int *fds = NULL;
+  int space = 0;
+  int nfds = 0;
+  int fd;
+  int i;
+
+  cmsg = CMSG_FIRSTHDR(msg);
+  if (cmsg != NULL && msg->msg_controllen >= CMSG_LEN(sizeof(int)))
+    {
+      fds   = (FAR int *)CMSG_DATA(cmsg);
+      space = (msg->msg_controllen - CMSG_LEN(0)) / sizeof(int);
+    }
+
+  for (i = 0; i < rights->lr_nfds; i++)
+    {
+      fd = -EMFILE;
+      if (nfds < space)
+        {
+          fd = local_fd_install(&rights->lr_fds[i]);
+        }
+
+      if (fd >= 0)
+        {
+          fds[nfds++] = fd;
+        }
+      else
+        {
+          msg->msg_flags |= MSG_CTRUNC;
+        }
+
+      /* The receiver holds its own reference now, if any */
+
+      local_fd_close(&rights->lr_fds[i]);
+    }
+
+  if (nfds > 0)
+    {
+      cmsg->cmsg_len      = CMSG_LEN(nfds * sizeof(int));
+      cmsg->cmsg_level    = SOL_SOCKET;
+      cmsg->cmsg_type     = SCM_RIGHTS;
+      msg->msg_controllen = CMSG_SPACE(nfds * sizeof(int));
+    }
+  else
+    {
+      msg->msg_controllen = 0;
+    }
+
+  kmm_free(rights);
+}
+
+/****************************************************************************
+ * Name: local_rights_free
+ *
+ * Description:
+ *   Close the descriptors of a set of rights that will never be received
+ *   and free it.
+ *
+ ****************************************************************************/
+
+void local_rights_free(FAR struct local_rights_s *rights)
+{
+  int i;
+
+  if (rights != NULL)
+    {
+      for (i = 0; i < rights->lr_nfds; i++)
+        {
+          local_fd_close(&rights->lr_fds[i]);
+        }
+
+      kmm_free(rights);
+    }
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_LOCAL_SCM */
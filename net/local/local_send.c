@@ -40,66 +40,229 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
 #include <nuttx/net/net.h>
 
+#include "socket/socket.h"
 #include "local/local.h"
 
 #ifdef CONFIG_NET_LOCAL_STREAM
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef MIN
+#  define MIN(a,b) ((a) < (b) ? (a) : (b))
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_ring_write
+ *
+ * Description:
+ *   Append up to 'len' bytes to the receive ring of 'peer'.
+ *
+ * Returned Value:
+ *   The number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t local_ring_write(FAR struct local_conn_s *peer,
+                               FAR const uint8_t *buf, size_t len)
+{
+  size_t tail;
+  size_t ncopy;
+  size_t chunk;
+
+  ncopy = MIN(len, CONFIG_NET_LOCAL_STREAM_BUFSIZE - peer->u.peer.lc_rxlen);
+  tail  = peer->u.peer.lc_rxhead + peer->u.peer.lc_rxlen;
+  if (tail >= CONFIG_NET_LOCAL_STREAM_BUFSIZE)
+    {
+      tail -= CONFIG_NET_LOCAL_STREAM_BUFSIZE;
+    }
+
+  /* Copy up to the end of the ring, then wrap to the beginning */
+
+  chunk = MIN(ncopy, CONFIG_NET_LOCAL_STREAM_BUFSIZE - tail);
+  memcpy(&peer->u.peer.lc_rxbuf[tail], buf, chunk);
+  memcpy(peer->u.peer.lc_rxbuf, buf + chunk, ncopy - chunk);
+
+  peer->u.peer.lc_rxlen += ncopy;
+  return ncopy;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: psock_local_send
+ * Name: local_stream_send
  *
  * Description:
- *   Send a local packet as a stream.
+ *   Copy data into the receive ring of the connected peer, waiting for
+ *   space as necessary.
  *
  * Input Parameters:
- *   psock    An instance of the internal socket structure.
- *   buf      Data to send
- *   len      Length of data to send
- *   flags    Send flags (ignored for now)
+ *   conn     The sending connection
+ *   iov      The data to send
+ *   iovcnt   Number of entries in iov
+ *   nonblock True: Return -EAGAIN rather than wait for space
+ *   rights   Descriptors to pass along with the data (may be NULL).  On
+ *            success, ownership passes to the peer.
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   -1 is returned, and errno is set appropriately (see send() for the
- *   list of errno numbers).
+ *   On success, returns the number of bytes sent.  Otherwise, a negated
+ *   errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
-                         size_t len, int flags)
+ssize_t local_stream_send(FAR struct local_conn_s *conn,
+                          FAR const struct iovec *iov, int iovcnt,
+                          bool nonblock,
+                          FAR struct local_rights_s *rights)
 {
   FAR struct local_conn_s *peer;
-  int ret;
+  ssize_t nsent = 0;
+  size_t offset = 0;
+  int ret = OK;
 
-  DEBUGASSERT(psock && psock->s_conn && buf);
-  peer = (FAR struct local_conn_s *)psock->s_conn;
+  net_lock();
 
-  /* Verify that this is a connected peer socket and that it has opened the
-   * outgoing FIFO for write-only access.
-   */
-
-  if (peer->lc_state != LOCAL_STATE_CONNECTED ||
-      peer->lc_outfile.f_inode == NULL)
+  if (conn->lc_state != LOCAL_STATE_CONNECTED &&
+      conn->lc_state != LOCAL_STATE_DISCONNECTED)
     {
       nerr("ERROR: not connected\n");
+      net_unlock();
       return -ENOTCONN;
     }
 
-  /* Send the packet */
+  while (iovcnt > 0)
+    {
+      size_t ncopy;
+
+      /* Skip over empty or fully sent buffers */
+
+      if (offset >= iov->iov_len)
+        {
+          iov++;
+          iovcnt--;
+          offset = 0;
+          continue;
+        }
+
+      /* The peer may have gone away while we were waiting */
+
+      peer = conn->u.peer.lc_peer;
+      if (peer == NULL)
+        {
+          ret = -EPIPE;
+          break;
+        }
+
+      /* Wait for space in the ring of the peer */
+
+      if (peer->u.peer.lc_rxlen >= CONFIG_NET_LOCAL_STREAM_BUFSIZE)
+        {
+          if (nonblock)
+            {
+              ret = -EAGAIN;
+              break;
+            }
+
+          ret = net_lockedwait(&conn->lc_txsem);
+          if (ret < 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+#ifdef CONFIG_NET_LOCAL_SCM
+      /* The descriptors are received with the first byte of this send */
+
+      if (rights != NULL)
+        {
+          rights->lr_pos = peer->u.peer.lc_rxpos + peer->u.peer.lc_rxlen;
+          sq_addlast((FAR sq_entry_t *)rights, &peer->u.peer.lc_rights);
+          rights = NULL;
+        }
+#endif
+
+      ncopy   = local_ring_write(peer,
+                                 (FAR const uint8_t *)iov->iov_base + offset,
+                                 iov->iov_len - offset);
+      offset += ncopy;
+      nsent  += ncopy;
+
+      /* Wake up the readers of the peer */
+
+      local_wakeup(&peer->lc_rxsem);
+      local_pollnotify(peer, POLLIN);
+    }
+
+  net_unlock();
+
+  if (nsent > 0)
+    {
+      return nsent;
+    }
+
+  /* Nothing was sent.  Descriptors can only be passed along with data and
+   * are still owned by the caller.
+   */
+
+  if (ret == OK && rights != NULL)
+    {
+      ret = -EINVAL;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: psock_local_send
+ *
+ * Description:
+ *   Send a local packet as a stream.
+ *
+ * Input Parameters:
+ *   psock    An instance of the internal socket structure.
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a
+ *   negated errno value is returned (see send() for the list of errno
+ *   numbers).
+ *
+ ****************************************************************************/
+
+ssize_t psock_local_send(FAR struct socket *psock, FAR const void *buf,
+                         size_t len, int flags)
+{
+  struct iovec iov;
 
-  ret = local_send_packet(&peer->lc_outfile, (FAR uint8_t *)buf, len);
+  DEBUGASSERT(psock && psock->s_conn && buf);
 
-  /* If the send was successful, then the full packet will have been sent */
+  iov.iov_base = (FAR void *)buf;
+  iov.iov_len  = len;
 
-  return ret < 0 ? ret : len;
+  return local_stream_send((FAR struct local_conn_s *)psock->s_conn,
+                           &iov, 1,
+                           _SS_ISNONBLOCK(psock->s_flags) ||
+                           (flags & MSG_DONTWAIT) != 0,
+                           NULL);
 }
 
 #endif /* CONFIG_NET_LOCAL_STREAM */
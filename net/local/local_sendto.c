@@ -42,59 +42,99 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
-#include <unistd.h>
+#include <sys/uio.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
 #include "local/local.h"
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* A list of all SOCK_DGRAM connections bound to a path */
+
+dq_queue_t g_local_receivers;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_find_receiver
+ *
+ * Description:
+ *   Find the datagram socket bound to 'path'.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static FAR struct local_conn_s *local_find_receiver(FAR const char *path)
+{
+  FAR struct local_conn_s *conn;
+
+  for (conn = (FAR struct local_conn_s *)g_local_receivers.head;
+       conn != NULL;
+       conn = (FAR struct local_conn_s *)dq_next(&conn->lc_node))
+    {
+      if (strncmp(conn->lc_path, path, UNIX_PATH_MAX - 1) == 0)
+        {
+          return conn;
+        }
+    }
+
+  return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: psock_local_sendto
+ * Name: local_dgram_send
  *
  * Description:
- *   This function implements the Unix domain-specific logic of the
- *   standard sendto() socket operation.
+ *   Queue one datagram on the socket bound to the destination path,
+ *   waiting for space as necessary.
  *
  * Input Parameters:
- *   psock    A pointer to a NuttX-specific, internal socket structure
- *   buf      Data to send
- *   len      Length of data to send
+ *   psock    The sending socket
+ *   iov      The payload of the datagram
+ *   iovcnt   Number of entries in iov
  *   flags    Send flags
  *   to       Address of recipient
  *   tolen    The length of the address structure
- *
- *   NOTE: All input parameters were verified by sendto() before this
- *   function was called.
+ *   rights   Descriptors to pass along with the datagram (may be NULL).  On
+ *            success, ownership passes to the receiver.
  *
  * Returned Value:
- *   On success, returns the number of characters sent.  On  error,
- *   a negated errno value is returned.  See the description in
- *   net/socket/sendto.c for the list of appropriate return value.
+ *   On success, returns the number of bytes sent.  Otherwise, a negated
+ *   errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
-                           size_t len, int flags, FAR const struct sockaddr *to,
-                           socklen_t tolen)
+ssize_t local_dgram_send(FAR struct socket *psock,
+                         FAR const struct iovec *iov, int iovcnt, int flags,
+                         FAR const struct sockaddr *to, socklen_t tolen,
+                         FAR struct local_rights_s *rights)
 {
   FAR struct local_conn_s *conn = (FAR struct local_conn_s *)psock->s_conn;
   FAR struct sockaddr_un *unaddr = (FAR struct sockaddr_un *)to;
-  ssize_t nsent;
+  FAR struct local_conn_s *receiver;
+  FAR struct local_dgram_s *pkt;
+  char path[UNIX_PATH_MAX];
+  size_t len = 0;
+  size_t offset;
   int ret;
-
-  /* We keep packet sizes in a uint16_t, so there is a upper limit to the
-   * 'len' that can be supported.
-   */
-
-  DEBUGASSERT(buf && len <= UINT16_MAX);
+  int i;
 
   /* Verify that this is not a connected peer socket.  It need not be
    * bound, however.  If unbound, recvfrom will see this as a nameless
@@ -110,10 +150,6 @@ ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
       return -EISCONN;
     }
 
-  /* The outgoing FIFO should not be open */
-
-  DEBUGASSERT(conn->lc_outfile.f_inode == 0);
-
   /* At present, only standard pathname type address are support */
 
   if (tolen < sizeof(sa_family_t) + 2)
@@ -123,57 +159,135 @@ ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
       return -EFAULT;
     }
 
-  /* Make sure that half duplex FIFO has been created.
-   * REVISIT:  Or should be just make sure that it already exists?
-   */
+  /* The whole datagram must fit in the queue of the receiver */
 
-  ret = local_create_halfduplex(conn, unaddr->sun_path);
-  if (ret < 0)
+  for (i = 0; i < iovcnt; i++)
     {
-      nerr("ERROR: Failed to create FIFO for %s: %d\n",
-           conn->lc_path, ret);
-      return ret;
+      len += iov[i].iov_len;
     }
 
-  /* Open the sending side of the transfer */
+  if (len > CONFIG_NET_LOCAL_DGRAM_BUFSIZE)
+    {
+      return -EMSGSIZE;
+    }
+
+  strncpy(path, unaddr->sun_path, UNIX_PATH_MAX - 1);
+  path[UNIX_PATH_MAX - 1] = '\0';
+
+  /* Find the receiver and wait until it can take the datagram */
 
-  ret = local_open_sender(conn, unaddr->sun_path,
-                          _SS_ISNONBLOCK(psock->s_flags) ||
-                          (flags & MSG_DONTWAIT) != 0);
-  if (ret < 0)
+  net_lock();
+  for (; ; )
     {
-      nerr("ERROR: Failed to open FIFO for %s: %d\n",
-           unaddr->sun_path, ret);
+      receiver = local_find_receiver(path);
+      if (receiver == NULL)
+        {
+          nerr("ERROR: Nobody is bound to %s\n", path);
+          ret = -ECONNREFUSED;
+          goto errout_with_lock;
+        }
+
+      if (receiver->lc_dgramlen + len <= CONFIG_NET_LOCAL_DGRAM_BUFSIZE)
+        {
+          break;
+        }
+
+      if (_SS_ISNONBLOCK(psock->s_flags) || (flags & MSG_DONTWAIT) != 0)
+        {
+          ret = -EAGAIN;
+          goto errout_with_lock;
+        }
+
+      /* Wait on the receiver.  It may be closed while we wait, so it has
+       * to be looked up again.
+       */
+
+      ret = net_lockedwait(&receiver->lc_txsem);
+      if (ret < 0)
+        {
+          goto errout_with_lock;
+        }
+    }
+
+  /* Copy the datagram and queue it */
 
-      nsent = ret;
-      goto errout_with_halfduplex;
+  pkt = (FAR struct local_dgram_s *)kmm_malloc(SIZEOF_LOCAL_DGRAM_S(len));
+  if (pkt == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_lock;
     }
 
-  /* Send the packet */
+  for (i = 0, offset = 0; i < iovcnt; i++)
+    {
+      memcpy(&pkt->ld_data[offset], iov[i].iov_base, iov[i].iov_len);
+      offset += iov[i].iov_len;
+    }
+
+  pkt->ld_rights = rights;
+  pkt->ld_len    = len;
 
-  nsent = local_send_packet(&conn->lc_outfile, buf, len);
-  if (nsent < 0)
+  if (conn->lc_type == LOCAL_TYPE_PATHNAME)
     {
-      nerr("ERROR: Failed to send the packet: %d\n", ret);
+      strncpy(pkt->ld_from, conn->lc_path, UNIX_PATH_MAX);
     }
   else
     {
-      /* local_send_packet returns 0 if all 'len' bytes were sent */
-
-      nsent = len;
+      pkt->ld_from[0] = '\0';
     }
 
-  /* Now we can close the write-only socket descriptor */
+  sq_addlast((FAR sq_entry_t *)pkt, &receiver->lc_dgrams);
+  receiver->lc_dgramlen += len;
+
+  /* Wake up the readers of the receiver */
 
-  file_close(&conn->lc_outfile);
-  conn->lc_outfile.f_inode = NULL;
+  local_wakeup(&receiver->lc_rxsem);
+  local_pollnotify(receiver, POLLIN);
+  net_unlock();
+  return len;
+
+errout_with_lock:
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: psock_local_sendto
+ *
+ * Description:
+ *   This function implements the Unix domain-specific logic of the
+ *   standard sendto() socket operation.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   flags    Send flags
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *
+ *   NOTE: All input parameters were verified by sendto() before this
+ *   function was called.
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error,
+ *   a negated errno value is returned.  See the description in
+ *   net/socket/sendto.c for the list of appropriate return value.
+ *
+ ****************************************************************************/
+
+ssize_t psock_local_sendto(FAR struct socket *psock, FAR const void *buf,
+                           size_t len, int flags, FAR const struct sockaddr *to,
+                           socklen_t tolen)
+{
+  struct iovec iov;
 
-errout_with_halfduplex:
+  DEBUGASSERT(buf);
 
-  /* Release our reference to the half duplex FIFO */
+  iov.iov_base = (FAR void *)buf;
+  iov.iov_len  = len;
 
-  local_release_halfduplex(conn);
-  return nsent;
+  return local_dgram_send(psock, &iov, 1, flags, to, tolen, NULL);
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_LOCAL_DGRAM */
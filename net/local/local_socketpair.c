@@ -0,0 +1,97 @@
+/****************************************************************************
+ * net/local/local_socketpair.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_LOCAL)
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+
+#include "local/local.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_socketpair
+ *
+ * Description:
+ *   Connect two newly created, unbound Unix domain sockets to each other.
+ *   This implements the address family specific part of socketpair().
+ *
+ * Input Parameters:
+ *   psock1 - The first socket of the pair
+ *   psock2 - The second socket of the pair
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int local_socketpair(FAR struct socket *psock1, FAR struct socket *psock2)
+{
+#ifdef CONFIG_NET_LOCAL_STREAM
+  FAR struct local_conn_s *conn1;
+  FAR struct local_conn_s *conn2;
+  int ret;
+
+  DEBUGASSERT(psock1 != NULL && psock1->s_conn != NULL &&
+              psock2 != NULL && psock2->s_conn != NULL);
+
+  /* Only connected stream pairs are supported.  Datagram sockets are
+   * addressed by the path they are bound to.
+   */
+
+  if (psock1->s_type != SOCK_STREAM || psock2->s_type != SOCK_STREAM)
+    {
+      return -EOPNOTSUPP;
+    }
+
+  conn1 = (FAR struct local_conn_s *)psock1->s_conn;
+  conn2 = (FAR struct local_conn_s *)psock2->s_conn;
+
+  net_lock();
+  ret = local_stream_link(conn1, conn2);
+  if (ret >= 0)
+    {
+      conn1->lc_type   = LOCAL_TYPE_UNNAMED;
+      conn2->lc_type   = LOCAL_TYPE_UNNAMED;
+
+      psock1->s_flags |= _SF_CONNECTED;
+      psock2->s_flags |= _SF_CONNECTED;
+    }
+
+  net_unlock();
+  return ret;
+#else
+  return -EOPNOTSUPP;
+#endif
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_LOCAL */
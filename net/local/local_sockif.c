@@ -87,6 +87,10 @@ static ssize_t    local_sendto(FAR struct socket *psock, FAR const void *buf,
                     size_t len, int flags, FAR const struct sockaddr *to,
                     socklen_t tolen);
 static int        local_close(FAR struct socket *psock);
+static ssize_t    local_sendmsg(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
+static ssize_t    local_recvmsg(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
 
 /****************************************************************************
  * Public Data
@@ -110,7 +114,12 @@ const struct sock_intf_s g_local_sockif =
   NULL,              /* si_sendfile */
 #endif
   local_recvfrom,    /* si_recvfrom */
-  local_close        /* si_close */
+  local_close,       /* si_close */
+#ifdef CONFIG_NET_USRSOCK
+  NULL,              /* si_ioctl */
+#endif
+  local_sendmsg,     /* si_sendmsg */
+  local_recvmsg      /* si_recvmsg */
 };
 
 /****************************************************************************
@@ -825,6 +834,154 @@ static int local_close(FAR struct socket *psock)
     }
 }
 
+/****************************************************************************
+ * Name: local_sendmsg
+ *
+ * Description:
+ *   Implements the sendmsg() operation for the case of the local, Unix
+ *   socket.  The I/O vector is copied straight to the receiver and the
+ *   descriptors of an SCM_RIGHTS control message are passed along with it.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message to send
+ *   flags    Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters sent.  On  error, a negated
+ *   errno value is returned (see sendmsg() for the list of appropriate error
+ *   values.
+ *
+ ****************************************************************************/
+
+static ssize_t local_sendmsg(FAR struct socket *psock,
+                             FAR struct msghdr *msg, int flags)
+{
+  FAR struct local_rights_s *rights = NULL;
+  ssize_t ret;
+
+#ifdef CONFIG_NET_LOCAL_SCM
+  ret = local_rights_get(msg, &rights);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
+  switch (psock->s_type)
+    {
+#ifdef CONFIG_NET_LOCAL_STREAM
+      case SOCK_STREAM:
+        ret = local_stream_send((FAR struct local_conn_s *)psock->s_conn,
+                                msg->msg_iov, msg->msg_iovlen,
+                                _SS_ISNONBLOCK(psock->s_flags) ||
+                                (flags & MSG_DONTWAIT) != 0,
+                                rights);
+        break;
+#endif /* CONFIG_NET_LOCAL_STREAM */
+
+#ifdef CONFIG_NET_LOCAL_DGRAM
+      case SOCK_DGRAM:
+        {
+          FAR const struct sockaddr *to = msg->msg_name;
+
+          if (to == NULL || msg->msg_namelen <= 0)
+            {
+              ret = -EDESTADDRREQ;
+            }
+          else if (to->sa_family != AF_LOCAL)
+            {
+              ret = -EAFNOSUPPORT;
+            }
+          else
+            {
+              ret = local_dgram_send(psock, msg->msg_iov, msg->msg_iovlen,
+                                     flags, to, msg->msg_namelen, rights);
+            }
+        }
+        break;
+#endif /* CONFIG_NET_LOCAL_DGRAM */
+
+      default:
+        ret = -EOPNOTSUPP;
+        break;
+    }
+
+  /* On failure, the descriptors were not passed on */
+
+  if (ret < 0)
+    {
+      local_rights_free(rights);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_recvmsg
+ *
+ * Description:
+ *   Implements the recvmsg() operation for the case of the local, Unix
+ *   socket.  Descriptors passed by the sender are installed in the
+ *   descriptor table of the caller and returned in an SCM_RIGHTS control
+ *   message.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      Receives the message
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error, a
+ *   negated errno value is returned (see recvmsg() for the list of
+ *   appropriate error values.
+ *
+ ****************************************************************************/
+
+static ssize_t local_recvmsg(FAR struct socket *psock,
+                             FAR struct msghdr *msg, int flags)
+{
+  FAR struct local_rights_s *rights = NULL;
+  FAR struct sockaddr *from = msg->msg_name;
+  socklen_t fromlen = 0;
+  ssize_t ret;
+
+  if (from != NULL && msg->msg_namelen > 0)
+    {
+      fromlen = msg->msg_namelen;
+    }
+  else
+    {
+      from = NULL;
+    }
+
+  ret = local_recv(psock, msg->msg_iov, msg->msg_iovlen, flags,
+                   from, &fromlen, &rights);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msg->msg_flags = 0;
+  if (from != NULL)
+    {
+      msg->msg_namelen = fromlen;
+    }
+
+#ifdef CONFIG_NET_LOCAL_SCM
+  if (rights != NULL)
+    {
+      local_rights_put(rights, msg);
+    }
+  else
+#endif
+    {
+      msg->msg_controllen = 0;
+    }
+
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -205,6 +205,7 @@ typedef FAR struct wdog_s *WDOG_ID;
 struct mld_group_s
 {
   struct mld_group_s *next;    /* Implements a singly-linked list */
+  struct mld_group_s *hnext;   /* Next group in the same hash bucket */
   net_ipv6addr_t      grpaddr; /* Group IPv6 address */
   struct work_s       work;    /* For deferred timeout operations */
   WDOG_ID             polldog; /* Timer used for periodic or delayed events */
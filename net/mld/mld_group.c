@@ -59,10 +59,48 @@
 
 #ifdef CONFIG_NET_MLD
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if (CONFIG_NET_MLD_HASHSIZE & (CONFIG_NET_MLD_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_MLD_HASHSIZE must be a power of two
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Groups of all devices hashed by group address and interface index.  Each
+ * bucket is a list linked through hnext.
+ */
+
+static FAR struct mld_group_s *g_mld_grphash[CONFIG_NET_MLD_HASHSIZE];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name:  mld_grphash
+ *
+ * Description:
+ *   Return the hash bucket of a group address on an interface.  Only the
+ *   low 32 bits of the group address are used; they hold the group ID of
+ *   nearly all multicast addresses.
+ *
+ ****************************************************************************/
+
+static FAR struct mld_group_s **mld_grphash(FAR const net_ipv6addr_t addr,
+                                            uint8_t ifindex)
+{
+  uint32_t hash = ((uint32_t)addr[6] << 16) ^ addr[7] ^ ifindex;
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return &g_mld_grphash[hash & (CONFIG_NET_MLD_HASHSIZE - 1)];
+}
+
 /****************************************************************************
  * Name:  mld_ngroups
  *
@@ -111,6 +149,7 @@ static int mld_ngroups(FAR struct net_driver_s *dev)
 FAR struct mld_group_s *mld_grpalloc(FAR struct net_driver_s *dev,
                                      FAR const net_ipv6addr_t addr)
 {
+  FAR struct mld_group_s **bucket;
   FAR struct mld_group_s *group;
 
   mldinfo("addr: %08x dev: %p\n", *addr, dev);
@@ -160,6 +199,12 @@ FAR struct mld_group_s *mld_grpalloc(FAR struct net_driver_s *dev,
       /* Add the group structure to the list in the device structure */
 
       sq_addfirst((FAR sq_entry_t *)group, &dev->d_mld.grplist);
+
+      /* And to its hash bucket */
+
+      bucket       = mld_grphash(group->grpaddr, group->ifindex);
+      group->hnext = *bucket;
+      *bucket      = group;
     }
 
   return group;
@@ -190,19 +235,19 @@ FAR struct mld_group_s *mld_grpfind(FAR struct net_driver_s *dev,
           addr[0], addr[1], addr[2], addr[3], addr[4], addr[5], addr[6],
           addr[7]);
 
-  for (group = (FAR struct mld_group_s *)dev->d_mld.grplist.head;
+  for (group = *mld_grphash(addr, dev->d_ifindex);
        group;
-       group = group->next)
+       group = group->hnext)
     {
       mldinfo("Compare: %04x:%04x:%04x:%04x:%04x:%04x:%04x:%04x\n",
               group->grpaddr[0], group->grpaddr[1], group->grpaddr[2],
               group->grpaddr[3], group->grpaddr[4], group->grpaddr[5],
               group->grpaddr[6], group->grpaddr[7]);
 
-      if (net_ipv6addr_cmp(group->grpaddr, addr))
+      if (net_ipv6addr_cmp(group->grpaddr, addr) &&
+          group->ifindex == dev->d_ifindex)
         {
           mldinfo("Match!\n");
-          DEBUGASSERT(group->ifindex == dev->d_ifindex);
           break;
         }
     }
@@ -247,6 +292,8 @@ FAR struct mld_group_s *mld_grpallocfind(FAR struct net_driver_s *dev,
 
 void mld_grpfree(FAR struct net_driver_s *dev, FAR struct mld_group_s *group)
 {
+  FAR struct mld_group_s **link;
+
   mldinfo("Free: %p flags: %02x\n", group, group->flags);
 
   /* Cancel the timers */
@@ -257,6 +304,19 @@ void mld_grpfree(FAR struct net_driver_s *dev, FAR struct mld_group_s *group)
 
   sq_rem((FAR sq_entry_t *)group, &dev->d_mld.grplist);
 
+  /* And from its hash bucket */
+
+  for (link = mld_grphash(group->grpaddr, group->ifindex);
+       *link != NULL;
+       link = &(*link)->hnext)
+    {
+      if (*link == group)
+        {
+          *link = group->hnext;
+          break;
+        }
+    }
+
   /* Destroy the wait semaphore */
 
   nxsem_destroy(&group->sem);
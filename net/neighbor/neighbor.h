@@ -46,6 +46,7 @@
  ****************************************************************************/
 
 #include <stdint.h>
+#include <queue.h>
 
 #include <net/ethernet.h>
 
@@ -53,18 +54,51 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
 #include <nuttx/net/neighbor.h>
+#include <nuttx/net/netstats.h>
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_IPv6_NCONF_HASHSIZE
+#  define CONFIG_NET_IPv6_NCONF_HASHSIZE 8
+#endif
+
+#ifdef CONFIG_NET_STATISTICS
+#  define NEIGHBOR_STATS(f) (g_netstats.nd.f++)
+#else
+#  define NEIGHBOR_STATS(f)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One allocated entry of the Neighbor table */
+
+struct neighbor_cache_s
+{
+  dq_entry_t nc_lru;                     /* LRU list link.  Must be first */
+  FAR struct neighbor_cache_s *nc_hnext; /* Next entry in the hash chain */
+  struct neighbor_entry_s nc_entry;      /* The address mapping */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table.  Entries are allocated on demand, indexed by
+ * a hash of the IPv6 address, and kept on a list ordered from the most to
+ * the least recently used.  The network should be locked when accessing
  * this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern FAR struct neighbor_cache_s *
+  g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+extern dq_queue_t g_neighbor_lru;
+extern unsigned int g_neighbor_count;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -72,6 +106,23 @@ extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
 struct net_driver_s; /* Forward reference */
 
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain of the Neighbor table that holds an IPv6
+ *   address.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address
+ *
+ * Returned Value:
+ *   A reference to the head of the hash chain.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_cache_s **neighbor_hash(const net_ipv6addr_t ipaddr);
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
@@ -43,20 +43,75 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
+#include <queue.h>
 #include <assert.h>
 #include <debug.h>
 
 #include <net/if.h>
 
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/neighbor.h>
 
 #include "netdev/netdev.h"
+#include "netlink/netlink.h"
 #include "neighbor/neighbor.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_alloc
+ *
+ * Description:
+ *   Allocate a new Neighbor table entry.  If the table is full or there is
+ *   no memory, the least recently used entry is recycled.
+ *
+ ****************************************************************************/
+
+static FAR struct neighbor_cache_s *neighbor_alloc(void)
+{
+  FAR struct neighbor_cache_s *entry = NULL;
+  FAR struct neighbor_cache_s **link;
+
+  if (g_neighbor_count < CONFIG_NET_IPv6_NCONF_ENTRIES)
+    {
+      entry = (FAR struct neighbor_cache_s *)
+        kmm_zalloc(sizeof(struct neighbor_cache_s));
+      if (entry != NULL)
+        {
+          g_neighbor_count++;
+          return entry;
+        }
+    }
+
+  /* Recycle the least recently used entry */
+
+  entry = (FAR struct neighbor_cache_s *)dq_tail(&g_neighbor_lru);
+  if (entry != NULL)
+    {
+      for (link = neighbor_hash(entry->nc_entry.ne_ipaddr); *link != entry;
+           link = &(*link)->nc_hnext)
+        {
+          DEBUGASSERT(*link != NULL);
+        }
+
+      *link = entry->nc_hnext;
+      dq_rem(&entry->nc_lru, &g_neighbor_lru);
+
+      netlink_neigh_notify(&entry->nc_entry, RTM_DELNEIGH, AF_INET6);
+      memset(entry, 0, sizeof(struct neighbor_cache_s));
+      NEIGHBOR_STATS(evict);
+    }
+
+  return entry;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -81,53 +136,69 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
-  uint8_t lltype;
-  clock_t oldest_time;
-  int     oldest_ndx;
-  int     i;
+  FAR struct neighbor_cache_s **chain;
+  FAR struct neighbor_cache_s *entry;
+  FAR struct neighbor_entry_s *neighbor;
+  uint8_t llsize;
+  bool changed = true;
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
-   */
+  /* Find the matching entry or allocate a new one */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
-
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  chain = neighbor_hash(ipaddr);
+  for (entry = *chain; entry != NULL; entry = entry->nc_hnext)
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      if (net_ipv6addr_cmp(entry->nc_entry.ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
+          dq_rem(&entry->nc_lru, &g_neighbor_lru);
           break;
         }
+    }
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+  if (entry == NULL)
+    {
+      entry = neighbor_alloc();
+      if (entry == NULL)
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          nerr("ERROR: Failed to allocate a Neighbor table entry\n");
+          return;
         }
+
+      net_ipv6addr_copy(entry->nc_entry.ne_ipaddr, ipaddr);
+      entry->nc_hnext = *chain;
+      *chain          = entry;
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
+  /* Fill in the new information and make the entry the most recently
+   * used.
    */
 
-  g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+  neighbor = &entry->nc_entry;
+  neighbor->ne_time = clock_systime_ticks();
+
+  llsize = netdev_lladdrsize(dev);
+  if (neighbor->ne_addr.na_lltype == dev->d_lltype &&
+      neighbor->ne_addr.na_llsize == llsize &&
+      memcmp(&neighbor->ne_addr.u, addr, llsize) == 0)
+    {
+      changed = false;
+    }
 
-  g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
-  g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
+  neighbor->ne_addr.na_lltype = dev->d_lltype;
+  neighbor->ne_addr.na_llsize = llsize;
 
-  memcpy(&g_neighbors[oldest_ndx].ne_addr.u, addr,
-         g_neighbors[oldest_ndx].ne_addr.na_llsize);
+  memcpy(&neighbor->ne_addr.u, addr, llsize);
+  dq_addfirst(&entry->nc_lru, &g_neighbor_lru);
 
   /* Dump the contents of the new entry */
 
-  neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+  neighbor_dumpentry("Added entry", neighbor);
+
+  /* Tell Netlink listeners about new and changed mappings */
+
+  if (changed)
+    {
+      netlink_neigh_notify(neighbor, RTM_NEWNEIGH, AF_INET6);
+    }
 }
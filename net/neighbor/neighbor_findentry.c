@@ -44,6 +44,7 @@
 #include <nuttx/config.h>
 
 #include <string.h>
+#include <queue.h>
 #include <debug.h>
 
 #include "neighbor/neighbor.h"
@@ -70,19 +71,28 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_cache_s *entry;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (entry = *neighbor_hash(ipaddr); entry != NULL;
+       entry = entry->nc_hnext)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
+      if (net_ipv6addr_cmp(entry->nc_entry.ne_ipaddr, ipaddr))
         {
-          neighbor_dumpentry("Entry found", neighbor);
-          return neighbor;
+          /* Make it the most recently used entry */
+
+          if (dq_peek(&g_neighbor_lru) != &entry->nc_lru)
+            {
+              dq_rem(&entry->nc_lru, &g_neighbor_lru);
+              dq_addfirst(&entry->nc_lru, &g_neighbor_lru);
+            }
+
+          NEIGHBOR_STATS(hit);
+          neighbor_dumpentry("Entry found", &entry->nc_entry);
+          return &entry->nc_entry;
         }
     }
 
+  NEIGHBOR_STATS(miss);
   neighbor_dumpipaddr("Not found", ipaddr);
   return NULL;
 }
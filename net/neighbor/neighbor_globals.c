@@ -44,6 +44,9 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+#include <queue.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -54,8 +57,43 @@
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+FAR struct neighbor_cache_s *g_neighbor_hash[CONFIG_NET_IPv6_NCONF_HASHSIZE];
+dq_queue_t g_neighbor_lru;
+unsigned int g_neighbor_count;
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain of the Neighbor table that holds an IPv6
+ *   address.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address
+ *
+ * Returned Value:
+ *   A reference to the head of the hash chain.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_cache_s **neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash = 0;
+  int i;
+
+  /* Neighbors usually differ in the interface identifier, so weight the
+   * low-order half of the address the most.
+   */
+
+  for (i = 0; i < 8; i++)
+    {
+      hash = (hash << 5) + hash + ipaddr[i];
+    }
+
+  hash ^= hash >> 16;
+  return &g_neighbor_hash[hash % CONFIG_NET_IPv6_NCONF_HASHSIZE];
+}
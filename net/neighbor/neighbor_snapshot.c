@@ -38,6 +38,7 @@
 #include <nuttx/config.h>
 
 #include <string.h>
+#include <queue.h>
 #include <debug.h>
 
 #include <nuttx/net/ip.h>
@@ -74,27 +75,19 @@
 unsigned int neighbor_snapshot(FAR struct neighbor_entry_s *snapshot,
                                unsigned int nentries)
 {
+  FAR struct neighbor_cache_s *entry;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty entries in the Neighbor table. */
+  /* Copy all entries in the Neighbor table, most recently used first. */
 
-  for (i = 0, ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_IPv6_NCONF_ENTRIES;
-       i++)
+  for (entry = (FAR struct neighbor_cache_s *)dq_peek(&g_neighbor_lru),
+       ncopied = 0;
+       nentries > ncopied && entry != NULL;
+       entry = (FAR struct neighbor_cache_s *)dq_next(&entry->nc_lru))
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      /* An unused entry table entry will be nullified.  In particularly,
-       * the Neighbor IP address will be all zero (i.e., the unspecified
-       * IPv6 address).
-       */
-
-      if (!net_ipv6addr_cmp(neighbor->ne_ipaddr, g_ipv6_unspecaddr))
-        {
-          memcpy(&snapshot[ncopied], neighbor, sizeof(struct neighbor_entry_s));
-          ncopied++;
-        }
+      memcpy(&snapshot[ncopied], &entry->nc_entry,
+             sizeof(struct neighbor_entry_s));
+      ncopied++;
     }
 
   /* Return the number of entries copied into the user buffer */
@@ -90,6 +90,7 @@
 #include "icmpv6/icmpv6.h"
 #include "route/route.h"
 #include "netlink/netlink.h"
+#include "ipforward/ipforward.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -691,6 +692,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           if (dev)
             {
               ioctl_set_ipv4addr(&dev->d_ipaddr, &req->ifr_addr);
+              netlink_ipaddr_notify(dev, RTM_NEWADDR, AF_INET);
               ret = OK;
             }
         }
@@ -765,6 +767,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           if (dev)
             {
               ioctl_set_ipv4addr(&dev->d_netmask, &req->ifr_addr);
+              netlink_ipaddr_notify(dev, RTM_NEWADDR, AF_INET);
               ret = OK;
             }
         }
@@ -795,6 +798,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
               FAR struct lifreq *lreq = (FAR struct lifreq *)req;
 
               ioctl_set_ipv6addr(dev->d_ipv6addr, &lreq->lifr_addr);
+              netlink_ipaddr_notify(dev, RTM_NEWADDR, AF_INET6);
               ret = OK;
             }
         }
@@ -863,6 +867,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
             {
               FAR struct lifreq *lreq = (FAR struct lifreq *)req;
               ioctl_set_ipv6addr(dev->d_ipv6netmask, &lreq->lifr_addr);
+              netlink_ipaddr_notify(dev, RTM_NEWADDR, AF_INET6);
               ret = OK;
             }
         }
@@ -1025,10 +1030,14 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           dev = netdev_ifr_dev(req);
           if (dev)
             {
+              /* Report the addresses before they are cleared */
+
 #ifdef CONFIG_NET_IPv4
+              netlink_ipaddr_notify(dev, RTM_DELADDR, AF_INET);
               dev->d_ipaddr = 0;
 #endif
 #ifdef CONFIG_NET_IPv6
+              netlink_ipaddr_notify(dev, RTM_DELADDR, AF_INET6);
               memset(&dev->d_ipv6addr, 0, sizeof(net_ipv6addr_t));
 #endif
               ret = OK;
@@ -1097,6 +1106,31 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
         break;
     }
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarding decisions depend on the device addresses */
+
+  if (ret >= 0)
+    {
+      switch (cmd)
+        {
+          case SIOCSIFADDR:
+          case SIOCSIFDSTADDR:
+          case SIOCSIFNETMASK:
+          case SIOCSLIFADDR:
+          case SIOCSLIFDSTADDR:
+          case SIOCSLIFNETMASK:
+          case SIOCDIFADDR:
+            net_lock();
+            ipfwd_flowcache_flush();
+            net_unlock();
+            break;
+
+          default:
+            break;
+        }
+    }
+#endif
+
   return ret;
 }
 
@@ -1230,8 +1264,10 @@ static int netdev_arp_ioctl(FAR struct socket *psock, int cmd,
                * address -OR- add a new ARP table entry if there is not.
                */
 
+              net_lock();
               ret = arp_update(addr->sin_addr.s_addr,
                                (FAR uint8_t *)req->arp_ha.sa_data);
+              net_unlock();
             }
           else
             {
@@ -1249,21 +1285,20 @@ static int netdev_arp_ioctl(FAR struct socket *psock, int cmd,
 
               /* Find the existing ARP entry for this protocol address. */
 
-              FAR struct arp_entry_s *entry =
-                arp_lookup(addr->sin_addr.s_addr);
-              if (entry != NULL)
+              net_lock();
+              if (arp_lookup(addr->sin_addr.s_addr) != NULL)
                 {
-                  /* The ARP table is fixed size; an entry is deleted
-                   * by nullifying its protocol address.
-                   */
+                  /* Remove it from the table */
 
-                  entry->at_ipaddr = 0;
+                  arp_delete(addr->sin_addr.s_addr);
                   ret = OK;
                 }
               else
                 {
                   ret = -ENOENT;
                 }
+
+              net_unlock();
             }
           else
             {
@@ -1283,8 +1318,10 @@ static int netdev_arp_ioctl(FAR struct socket *psock, int cmd,
                * matching this protocol address.
                */
 
+              net_lock();
               ret = arp_find(addr->sin_addr.s_addr,
                             (FAR struct ether_addr *)req->arp_ha.sa_data);
+              net_unlock();
               if (ret >= 0)
                 {
                   /* Return the mapped hardware address. */
@@ -1788,6 +1825,14 @@ void netdev_ifup(FAR struct net_driver_s *dev)
 
               dev->d_flags |= IFF_UP;
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+              /* Forwarding decisions depend on which devices are up */
+
+              net_lock();
+              ipfwd_flowcache_flush();
+              net_unlock();
+#endif
+
               /* Update the driver status */
 
               netlink_device_notify(dev);
@@ -1814,6 +1859,14 @@ void netdev_ifdown(FAR struct net_driver_s *dev)
 
               dev->d_flags &= ~IFF_UP;
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+              /* Forwarding decisions depend on which devices are up */
+
+              net_lock();
+              ipfwd_flowcache_flush();
+              net_unlock();
+#endif
+
               /* Update the driver status */
 
               netlink_device_notify(dev);
@@ -243,6 +243,9 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 #ifdef CONFIG_NETDEV_IFINDEX
   int ifindex;
 #endif
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  int i;
+#endif
 
   if (dev != NULL)
     {
@@ -343,6 +346,17 @@ int netdev_register(FAR struct net_driver_s *dev, enum net_lltype_e lltype)
 
       dev->d_conncb = NULL;
       dev->d_devcb = NULL;
+#ifdef CONFIG_NET_TXREADY
+      dq_init(&dev->d_txready);
+#endif
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+      dev->d_tcptick = 0;
+      dq_init(&dev->d_tcpdue);
+      for (i = 0; i < CONFIG_NET_TCP_TIMERWHEEL_SLOTS; i++)
+        {
+          dq_init(&dev->d_tcpwheel[i]);
+        }
+#endif
 
       /* We need exclusive access for the following operations */
 
@@ -51,7 +51,10 @@
 #include <nuttx/net/netdev.h>
 
 #include "utils/utils.h"
+#include "devif/devif.h"
 #include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
+#include "tcp/tcp.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -160,6 +163,24 @@ int netdev_unregister(FAR struct net_driver_s *dev)
           curr->flink = NULL;
         }
 
+#ifdef CONFIG_NET_TXREADY
+      /* Forget any connections that were waiting to send on the device */
+
+      devif_txready_flush(dev);
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+      /* Stop the TCP timers that were running on the device */
+
+      tcp_timer_flush(dev);
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Forget any flows that were forwarded on the device */
+
+      ipfwd_flowcache_flush();
+#endif
+
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
@@ -49,6 +49,7 @@
 #include <netpacket/netlink.h>
 #include <nuttx/net/netlink.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 
 #include "devif/devif.h"
 #include "socket/socket.h"
@@ -57,8 +58,40 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#ifndef CONFIG_NETLINK_ROUTE
-  #define netlink_device_notify(dev)
+/* Configuration ************************************************************/
+
+#if !defined(CONFIG_NET_ARP) && !defined(CONFIG_NET_IPv6)
+#  undef CONFIG_NETLINK_DISABLE_GETNEIGH
+#  define CONFIG_NETLINK_DISABLE_GETNEIGH 1
+#endif
+
+#if !defined(CONFIG_NET_ROUTE) || (!defined(CONFIG_NET_IPv4) && \
+    !defined(CONFIG_NET_IPv6))
+#  undef CONFIG_NETLINK_DISABLE_GETROUTE
+#  define CONFIG_NETLINK_DISABLE_GETROUTE 1
+#endif
+
+#if !defined(CONFIG_NET_IPv4) && !defined(CONFIG_NET_IPv6)
+#  undef CONFIG_NETLINK_DISABLE_GETADDR
+#  define CONFIG_NETLINK_DISABLE_GETADDR 1
+#endif
+
+/* Change notifications are only sent for the tables that can be dumped */
+
+#if !defined(CONFIG_NETLINK_ROUTE) || defined(CONFIG_NETLINK_DISABLE_GETLINK)
+#  define netlink_device_notify(dev)
+#endif
+
+#if !defined(CONFIG_NETLINK_ROUTE) || defined(CONFIG_NETLINK_DISABLE_GETADDR)
+#  define netlink_ipaddr_notify(dev, type, domain)
+#endif
+
+#if !defined(CONFIG_NETLINK_ROUTE) || defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+#  define netlink_route_notify(route, type, domain)
+#endif
+
+#if !defined(CONFIG_NETLINK_ROUTE) || defined(CONFIG_NETLINK_DISABLE_GETNEIGH)
+#  define netlink_neigh_notify(neigh, type, domain)
 #endif
 
 #ifdef CONFIG_NET_NETLINK
@@ -271,6 +304,30 @@ netlink_get_response(FAR struct netlink_conn_s *conn);
 
 bool netlink_check_response(FAR struct netlink_conn_s *conn);
 
+/****************************************************************************
+ * Name: netlink_tryget_multipart
+ *
+ * Description:
+ *   Return the next part of a multipart response if it is at the head of
+ *   the pending response list and fits in the remaining receive buffer.
+ *   This lets recvfrom() return a dump in as few calls as the buffer
+ *   permits.
+ *
+ * Input Parameters:
+ *   conn  - The Netlink connection
+ *   seq   - The sequence number of the multipart response
+ *   space - Space left in the receive buffer
+ *
+ * Returned Value:
+ *   The next part of the response or NULL if there is no part that can be
+ *   returned in the same buffer.
+ *
+ ****************************************************************************/
+
+FAR struct netlink_response_s *
+netlink_tryget_multipart(FAR struct netlink_conn_s *conn, uint32_t seq,
+                         size_t space);
+
 /****************************************************************************
  * Name: netlink_route_sendto()
  *
@@ -294,9 +351,70 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
  *
  ****************************************************************************/
 
+#ifndef CONFIG_NETLINK_DISABLE_GETLINK
 void netlink_device_notify(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipaddr_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWADDR or RTM_DELADDR message for the IPv4 or IPv6
+ *   address of a device to the RTNLGRP_IPV4_IFADDR or RTNLGRP_IPV6_IFADDR
+ *   group.
+ *
+ * Input Parameters:
+ *   dev    - The device whose address changed
+ *   type   - RTM_NEWADDR or RTM_DELADDR
+ *   domain - AF_INET or AF_INET6
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+void netlink_ipaddr_notify(FAR struct net_driver_s *dev, int type,
+                           int domain);
+#endif
+
+/****************************************************************************
+ * Name: netlink_route_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWROUTE or RTM_DELROUTE message to the
+ *   RTNLGRP_IPV4_ROUTE or RTNLGRP_IPV6_ROUTE group.
+ *
+ * Input Parameters:
+ *   route  - The struct net_route_ipv4_s or net_route_ipv6_s that was
+ *            added or removed
+ *   type   - RTM_NEWROUTE or RTM_DELROUTE
+ *   domain - AF_INET or AF_INET6
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETROUTE
+void netlink_route_notify(FAR const void *route, int type, int domain);
+#endif
+
+/****************************************************************************
+ * Name: netlink_neigh_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWNEIGH or RTM_DELNEIGH message to the RTNLGRP_NEIGH
+ *   group.  The message has the same layout as an RTM_GETNEIGH response
+ *   holding a single table entry.
+ *
+ * Input Parameters:
+ *   neigh  - The struct arp_entry_s or neighbor_entry_s that was added,
+ *            changed or removed
+ *   type   - RTM_NEWNEIGH or RTM_DELNEIGH
+ *   domain - AF_INET or AF_INET6
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETNEIGH
+void netlink_neigh_notify(FAR const void *neigh, int type, int domain);
+#endif
+#endif /* CONFIG_NETLINK_ROUTE */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -471,6 +471,50 @@ netlink_get_response(FAR struct netlink_conn_s *conn)
   return resp;
 }
 
+/****************************************************************************
+ * Name: netlink_tryget_multipart
+ *
+ * Description:
+ *   Return the next part of a multipart response if it is at the head of
+ *   the pending response list and fits in the remaining receive buffer.
+ *   This lets recvfrom() return a dump in as few calls as the buffer
+ *   permits.
+ *
+ * Input Parameters:
+ *   conn  - The Netlink connection
+ *   seq   - The sequence number of the multipart response
+ *   space - Space left in the receive buffer
+ *
+ * Returned Value:
+ *   The next part of the response or NULL if there is no part that can be
+ *   returned in the same buffer.
+ *
+ ****************************************************************************/
+
+FAR struct netlink_response_s *
+netlink_tryget_multipart(FAR struct netlink_conn_s *conn, uint32_t seq,
+                         size_t space)
+{
+  FAR struct netlink_response_s *resp;
+
+  DEBUGASSERT(conn != NULL);
+
+  net_lock();
+  resp = (FAR struct netlink_response_s *)sq_peek(&conn->resplist);
+  if (resp != NULL && (resp->msg.nlmsg_flags & NLM_F_MULTI) != 0 &&
+      resp->msg.nlmsg_seq == seq && resp->msg.nlmsg_len <= space)
+    {
+      sq_remfirst(&conn->resplist);
+    }
+  else
+    {
+      resp = NULL;
+    }
+
+  net_unlock();
+  return resp;
+}
+
 /****************************************************************************
  * Name: netlink_check_response
  *
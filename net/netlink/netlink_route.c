@@ -55,30 +55,15 @@
 #include <nuttx/net/netlink.h>
 
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "arp/arp.h"
 #include "neighbor/neighbor.h"
 #include "route/route.h"
+#include "utils/utils.h"
 #include "netlink/netlink.h"
 
 #ifdef CONFIG_NETLINK_ROUTE
 
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-/* Configuration ************************************************************/
-
-#if !defined(CONFIG_NET_ARP) && !defined(CONFIG_NET_IPv6)
-#  undef CONFIG_NETLINK_DISABLE_GETNEIGH
-#  define CONFIG_NETLINK_DISABLE_GETNEIGH 1
-#endif
-
-#if !defined(CONFIG_NET_ROUTE) || (!defined(CONFIG_NET_IPv4) && \
-    !defined(CONFIG_NET_IPv6))
-#  undef CONFIG_NETLINK_DISABLE_GETROUTE
-#  define CONFIG_NETLINK_DISABLE_GETROUTE 1
-#endif
-
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -165,6 +150,35 @@ struct getroute_recvfrom_ipv6resplist_s
   struct getroute_recvfrom_ipv6response_s payload;
 };
 
+/* RTM_GETADDR:  Get the IP addresses of network devices */
+
+struct getaddr_recvfrom_ipv4response_s
+{
+  struct nlmsghdr  hdr;
+  struct ifaddrmsg ifa;
+  struct getroute_recvfrom_ipv4addr_s local;
+  struct getroute_recvfrom_ipv4addr_s addr;
+};
+
+struct getaddr_recvfrom_ipv4resplist_s
+{
+  sq_entry_t flink;
+  struct getaddr_recvfrom_ipv4response_s payload;
+};
+
+struct getaddr_recvfrom_ipv6response_s
+{
+  struct nlmsghdr  hdr;
+  struct ifaddrmsg ifa;
+  struct getroute_recvfrom_ipv6addr_s addr;
+};
+
+struct getaddr_recvfrom_ipv6resplist_s
+{
+  sq_entry_t flink;
+  struct getaddr_recvfrom_ipv6response_s payload;
+};
+
 /* netdev_foreach() callback */
 
 struct nlroute_sendto_request_s
@@ -216,7 +230,7 @@ netlink_get_device(FAR struct net_driver_s *dev,
 
   resp->hdr.nlmsg_len    = sizeof(struct getlink_recvfrom_response_s);
   resp->hdr.nlmsg_type   = up ? RTM_NEWLINK : RTM_DELLINK;
-  resp->hdr.nlmsg_flags  = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_flags  = req ? NLM_F_MULTI : 0;
   resp->hdr.nlmsg_seq    = req ? req->hdr.nlmsg_seq : 0;
   resp->hdr.nlmsg_pid    = req ? req->hdr.nlmsg_pid : 0;
 
@@ -267,7 +281,7 @@ netlink_get_terminator(FAR const struct nlroute_sendto_request_s *req)
   hdr              = &resp->msg;
   hdr->nlmsg_len   = sizeof(struct nlmsghdr);
   hdr->nlmsg_type  = NLMSG_DONE;
-  hdr->nlmsg_flags = req ? req->hdr.nlmsg_flags : 0;
+  hdr->nlmsg_flags = req ? NLM_F_MULTI : 0;
   hdr->nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
   hdr->nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
@@ -347,11 +361,58 @@ static int netlink_get_devlist(NETLINK_HANDLE handle,
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_neigh_response
+ *
+ * Description:
+ *   Generate one neighbor table entry response.  'req' is NULL for a change
+ *   notification.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETNEIGH
+static FAR struct netlink_response_s *
+netlink_neigh_response(FAR const void *neigh, size_t size, int type,
+                       int domain,
+                       FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getneigh_recvfrom_rsplist_s *alloc;
+  FAR struct getneigh_recvfrom_response_s *resp;
+
+  /* Allocate the response */
+
+  alloc = (FAR struct getneigh_recvfrom_rsplist_s *)
+    kmm_zalloc(SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(size));
+  if (alloc == NULL)
+    {
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
+    }
+
+  /* Format the response */
+
+  resp                  = &alloc->payload;
+  resp->hdr.nlmsg_len   = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(size);
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
+  resp->msg.ndm_family  = domain;
+  resp->attr.rta_len    = RTA_LENGTH(size);
+
+  memcpy(resp->data, neigh, size);
+
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
 /****************************************************************************
  * Name: netlink_get_arptable()
  *
  * Description:
- *   Return the entire ARP table.
+ *   Dump the ARP table, one RTM_NEWNEIGH message per valid entry.
  *
  ****************************************************************************/
 
@@ -359,73 +420,47 @@ static int netlink_get_devlist(NETLINK_HANDLE handle,
 static int netlink_get_arptable(NETLINK_HANDLE handle,
                               FAR const struct nlroute_sendto_request_s *req)
 {
-  FAR struct getneigh_recvfrom_rsplist_s *entry;
+  FAR struct netlink_response_s *resp;
+  FAR struct arp_entry_s *table;
   unsigned int ncopied;
-  size_t allocsize;
-  size_t tabsize;
-  size_t rspsize;
-
-  /* Preallocate memory to hold the maximum sized ARP table
-   * REVISIT:  This is probably excessively large and could cause false
-   * memory out conditions.  A better approach would be to actually count
-   * the number of valid entries in the ARP table.
-   */
+  unsigned int i;
 
-  tabsize   = CONFIG_NET_ARPTAB_SIZE * sizeof(struct arp_entry_s);
-  rspsize   = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(tabsize);
-  allocsize = SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(tabsize);
-
-  entry = (FAR struct getneigh_recvfrom_rsplist_s *)kmm_zalloc(allocsize);
-  if (entry == NULL)
+  table = (FAR struct arp_entry_s *)
+    kmm_malloc(CONFIG_NET_ARPTAB_SIZE * sizeof(struct arp_entry_s));
+  if (table == NULL)
     {
-      nerr("ERROR: Failed to allocate response buffer.\n");
+      nerr("ERROR: Failed to allocate ARP table snapshot.\n");
       return -ENOMEM;
     }
 
-  /* Populate the entry */
-
-  memcpy(&entry->payload.hdr, &req->hdr, sizeof(struct nlmsghdr));
-  entry->payload.hdr.nlmsg_len  = rspsize;
-  entry->payload.msg.ndm_family = req->gen.rtgen_family;
-  entry->payload.attr.rta_len   = RTA_LENGTH(tabsize);
-
-  /* Lock the network so that the ARP table will be stable, then copy
-   * the ARP table into the allocated memory.
+  /* Lock the network so that the ARP table will be stable while it is
+   * copied.
    */
 
   net_lock();
-  ncopied = arp_snapshot((FAR struct arp_entry_s *)entry->payload.data,
-                         CONFIG_NET_ARPTAB_SIZE);
+  ncopied = arp_snapshot(table, CONFIG_NET_ARPTAB_SIZE);
   net_unlock();
 
-  /* Now we have the real number of valid entries in the ARP table and
-   * we can trim the allocation.
-   */
+  /* Queue one response for each valid entry */
 
-  if (ncopied < CONFIG_NET_ARPTAB_SIZE)
+  for (i = 0; i < ncopied; i++)
     {
-      FAR struct getneigh_recvfrom_rsplist_s *newentry;
-
-      tabsize = ncopied * sizeof(struct arp_entry_s);
-      rspsize = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(tabsize);
-      allocsize = SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(tabsize);
-
-      newentry = (FAR struct getneigh_recvfrom_rsplist_s *)
-        kmm_realloc(entry, allocsize);
-
-      if (newentry != NULL)
+      resp = netlink_neigh_response(&table[i], sizeof(struct arp_entry_s),
+                                    RTM_NEWNEIGH, AF_INET, req);
+      if (resp == NULL)
         {
-           entry = newentry;
+          kmm_free(table);
+          return -ENOMEM;
         }
 
-      entry->payload.hdr.nlmsg_len = rspsize;
-      entry->payload.attr.rta_len  = RTA_LENGTH(tabsize);
+      netlink_add_response(handle, resp);
     }
 
-  /* Finally, add the data to the list of pending responses */
+  kmm_free(table);
 
-  netlink_add_response(handle, (FAR struct netlink_response_s *)entry);
-  return OK;
+  /* Terminate the ARP table */
+
+  return netlink_add_terminator(handle, req);
 }
 #endif
 
@@ -433,7 +468,7 @@ static int netlink_get_arptable(NETLINK_HANDLE handle,
  * Name: netlink_get_nbtable()
  *
  * Description:
- *   Return the entire IPv6 neighbor table.
+ *   Dump the IPv6 neighbor table, one RTM_NEWNEIGH message per valid entry.
  *
  ****************************************************************************/
 
@@ -441,96 +476,69 @@ static int netlink_get_arptable(NETLINK_HANDLE handle,
 static int netlink_get_nbtable(NETLINK_HANDLE handle,
                               FAR const struct nlroute_sendto_request_s *req)
 {
-  FAR struct getneigh_recvfrom_rsplist_s *entry;
+  FAR struct netlink_response_s *resp;
+  FAR struct neighbor_entry_s *table;
   unsigned int ncopied;
-  size_t allocsize;
-  size_t tabsize;
-  size_t rspsize;
-
-  /* Preallocate memory to hold the maximum sized Neighbor table
-   * REVISIT:  This is probably excessively large and could cause false
-   * memory out conditions.  A better approach would be to actually count
-   * the number of valid entries in the Neighbor table.
-   */
-
-  tabsize   = CONFIG_NET_IPv6_NCONF_ENTRIES *
-              sizeof(struct neighbor_entry_s);
-  rspsize   = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(tabsize);
-  allocsize = SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(tabsize);
+  unsigned int i;
 
-  entry = (FAR struct getneigh_recvfrom_rsplist_s *)kmm_zalloc(allocsize);
-  if (entry == NULL)
+  table = (FAR struct neighbor_entry_s *)
+    kmm_malloc(CONFIG_NET_IPv6_NCONF_ENTRIES *
+               sizeof(struct neighbor_entry_s));
+  if (table == NULL)
     {
-      nerr("ERROR: Failed to allocate response buffer.\n");
+      nerr("ERROR: Failed to allocate Neighbor table snapshot.\n");
       return -ENOMEM;
     }
 
-  /* Populate the entry */
-
-  memcpy(&entry->payload.hdr, &req->hdr, sizeof(struct nlmsghdr));
-  entry->payload.hdr.nlmsg_len  = rspsize;
-  entry->payload.msg.ndm_family = req->gen.rtgen_family;
-  entry->payload.attr.rta_len   = RTA_LENGTH(tabsize);
-
-  /* Lock the network so that the Neighbor table will be stable, then
-   * copy the Neighbor table into the allocated memory.
+  /* Lock the network so that the Neighbor table will be stable while it
+   * is copied.
    */
 
   net_lock();
-  ncopied = neighbor_snapshot(
-    (FAR struct neighbor_entry_s *)entry->payload.data,
-    CONFIG_NET_IPv6_NCONF_ENTRIES);
+  ncopied = neighbor_snapshot(table, CONFIG_NET_IPv6_NCONF_ENTRIES);
   net_unlock();
 
-  /* Now we have the real number of valid entries in the Neighbor table
-   * and we can trim the allocation.
-   */
+  /* Queue one response for each valid entry */
 
-  if (ncopied < CONFIG_NET_IPv6_NCONF_ENTRIES)
+  for (i = 0; i < ncopied; i++)
     {
-      FAR struct getneigh_recvfrom_rsplist_s *newentry;
-
-      tabsize   = ncopied * sizeof(struct neighbor_entry_s);
-      rspsize   = SIZEOF_NLROUTE_RECVFROM_RESPONSE_S(tabsize);
-      allocsize = SIZEOF_NLROUTE_RECVFROM_RSPLIST_S(tabsize);
-
-      newentry = (FAR struct getneigh_recvfrom_rsplist_s *)
-        kmm_realloc(entry, allocsize);
-
-      if (newentry != NULL)
+      resp = netlink_neigh_response(&table[i],
+                                    sizeof(struct neighbor_entry_s),
+                                    RTM_NEWNEIGH, AF_INET6, req);
+      if (resp == NULL)
         {
-           entry = newentry;
+          kmm_free(table);
+          return -ENOMEM;
         }
 
-      entry->payload.hdr.nlmsg_len = rspsize;
-      entry->payload.attr.rta_len  = RTA_LENGTH(tabsize);
+      netlink_add_response(handle, resp);
     }
 
-  /* Finally, add the response to the list of pending responses */
+  kmm_free(table);
 
-  netlink_add_response(handle, (FAR struct netlink_response_s *)entry);
-  return OK;
+  /* Terminate the Neighbor table */
+
+  return netlink_add_terminator(handle, req);
 }
 #endif
 
 /****************************************************************************
- * Name: netlink_ipv4_route
+ * Name: netlink_ipv4route_response
  *
  * Description:
- *   Dump a list of all network devices of the specified type.
+ *   Generate one IPv4 route response.  'req' is NULL for a change
+ *   notification.
  *
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
-                              FAR void *arg)
+static FAR struct netlink_response_s *
+netlink_ipv4route_response(FAR const struct net_route_ipv4_s *route,
+                           int type,
+                           FAR const struct nlroute_sendto_request_s *req)
 {
   FAR struct getroute_recvfrom_ipv4resplist_s *alloc;
   FAR struct getroute_recvfrom_ipv4response_s *resp;
-  FAR struct nlroute_info_s *info;
-
-  DEBUGASSERT(route != NULL && arg != NULL);
-  info = (FAR struct nlroute_info_s *)arg;
 
   /* Allocate the response */
 
@@ -538,19 +546,19 @@ static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
     kmm_zalloc(sizeof(struct getroute_recvfrom_ipv4resplist_s));
   if (alloc == NULL)
     {
-      return -ENOMEM;
+      return NULL;
     }
 
   /* Format the response */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = sizeof(struct getroute_recvfrom_ipv4response_s);
-  resp->hdr.nlmsg_type  = RTM_NEWROUTE;
-  resp->hdr.nlmsg_flags = info->req->hdr.nlmsg_flags;
-  resp->hdr.nlmsg_seq   = info->req->hdr.nlmsg_seq;
-  resp->hdr.nlmsg_pid   = info->req->hdr.nlmsg_pid;
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
-  resp->rte.rtm_family   = info->req->gen.rtgen_family;
+  resp->rte.rtm_family   = AF_INET;
   resp->rte.rtm_table    = RT_TABLE_MAIN;
   resp->rte.rtm_protocol = RTPROT_STATIC;
   resp->rte.rtm_scope    = RT_SCOPE_SITE;
@@ -567,9 +575,39 @@ static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
   resp->gateway.attr.rta_type = RTA_GATEWAY;
   resp->gateway.addr          = route->router;
 
-  /* Finally, add the response to the list of pending responses */
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4_route
+ *
+ * Description:
+ *   Add one IPv4 routing table entry to a routing table dump.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
+                              FAR void *arg)
+{
+  FAR struct netlink_response_s *resp;
+  FAR struct nlroute_info_s *info;
+
+  DEBUGASSERT(route != NULL && arg != NULL);
+  info = (FAR struct nlroute_info_s *)arg;
+
+  resp = netlink_ipv4route_response(route, RTM_NEWROUTE, info->req);
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
 
-  netlink_add_response(info->handle, (FAR struct netlink_response_s *)alloc);
+  /* Add the response to the list of pending responses */
+
+  netlink_add_response(info->handle, resp);
   return OK;
 }
 #endif
@@ -607,23 +645,22 @@ static int netlink_get_ipv4route(NETLINK_HANDLE handle,
 #endif
 
 /****************************************************************************
- * Name: netlink_ipv6_route
+ * Name: netlink_ipv6route_response
  *
  * Description:
- *   Dump a list of all network devices of the specified type.
+ *   Generate one IPv6 route response.  'req' is NULL for a change
+ *   notification.
  *
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
-                              FAR void *arg)
+static FAR struct netlink_response_s *
+netlink_ipv6route_response(FAR const struct net_route_ipv6_s *route,
+                           int type,
+                           FAR const struct nlroute_sendto_request_s *req)
 {
   FAR struct getroute_recvfrom_ipv6resplist_s *alloc;
   FAR struct getroute_recvfrom_ipv6response_s *resp;
-  FAR struct nlroute_info_s *info;
-
-  DEBUGASSERT(route != NULL && arg != NULL);
-  info = (FAR struct nlroute_info_s *)arg;
 
   /* Allocate the response */
 
@@ -631,19 +668,19 @@ static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
     kmm_zalloc(sizeof(struct getroute_recvfrom_ipv6resplist_s));
   if (alloc == NULL)
     {
-      return -ENOMEM;
+      return NULL;
     }
 
   /* Format the response */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = sizeof(struct getroute_recvfrom_ipv6response_s);
-  resp->hdr.nlmsg_type  = RTM_NEWROUTE;
-  resp->hdr.nlmsg_flags = info->req->hdr.nlmsg_flags;
-  resp->hdr.nlmsg_seq   = info->req->hdr.nlmsg_seq;
-  resp->hdr.nlmsg_pid   = info->req->hdr.nlmsg_pid;
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
-  resp->rte.rtm_family   = info->req->gen.rtgen_family;
+  resp->rte.rtm_family   = AF_INET6;
   resp->rte.rtm_table    = RT_TABLE_MAIN;
   resp->rte.rtm_protocol = RTPROT_STATIC;
   resp->rte.rtm_scope    = RT_SCOPE_SITE;
@@ -660,9 +697,39 @@ static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
   resp->gateway.attr.rta_type = RTA_GATEWAY;
   net_ipv6addr_copy(resp->gateway.addr, route->router);
 
-  /* Finally, add the response to the list of pending responses */
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6_route
+ *
+ * Description:
+ *   Add one IPv6 routing table entry to a routing table dump.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
+                              FAR void *arg)
+{
+  FAR struct netlink_response_s *resp;
+  FAR struct nlroute_info_s *info;
+
+  DEBUGASSERT(route != NULL && arg != NULL);
+  info = (FAR struct nlroute_info_s *)arg;
+
+  resp = netlink_ipv6route_response(route, RTM_NEWROUTE, info->req);
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Add the response to the list of pending responses */
 
-  netlink_add_response(info->handle, (FAR struct netlink_response_s *)alloc);
+  netlink_add_response(info->handle, resp);
   return OK;
 }
 #endif
@@ -699,6 +766,203 @@ static int netlink_get_ip6vroute(NETLINK_HANDLE handle,
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipv4addr_response
+ *
+ * Description:
+ *   Generate one response for the IPv4 address of a device.  'req' is NULL
+ *   for a change notification.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETADDR)
+static FAR struct netlink_response_s *
+netlink_ipv4addr_response(FAR struct net_driver_s *dev, int type,
+                          FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getaddr_recvfrom_ipv4resplist_s *alloc;
+  FAR struct getaddr_recvfrom_ipv4response_s *resp;
+  uint32_t mask;
+  uint8_t preflen;
+
+  /* Allocate the response */
+
+  alloc = (FAR struct getaddr_recvfrom_ipv4resplist_s *)
+    kmm_zalloc(sizeof(struct getaddr_recvfrom_ipv4resplist_s));
+  if (alloc == NULL)
+    {
+      return NULL;
+    }
+
+  /* The prefix length is the number of leading ones in the netmask */
+
+  mask    = NTOHL(dev->d_netmask);
+  preflen = 0;
+
+  while ((mask & 0x80000000) != 0)
+    {
+      mask <<= 1;
+      preflen++;
+    }
+
+  /* Format the response */
+
+  resp                    = &alloc->payload;
+  resp->hdr.nlmsg_len     = sizeof(struct getaddr_recvfrom_ipv4response_s);
+  resp->hdr.nlmsg_type    = type;
+  resp->hdr.nlmsg_flags   = req ? NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq     = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid     = req ? req->hdr.nlmsg_pid : 0;
+
+  resp->ifa.ifa_family    = AF_INET;
+  resp->ifa.ifa_prefixlen = preflen;
+  resp->ifa.ifa_flags     = IFA_F_PERMANENT;
+  resp->ifa.ifa_scope     = RT_SCOPE_UNIVERSE;
+#ifdef CONFIG_NETDEV_IFINDEX
+  resp->ifa.ifa_index     = dev->d_ifindex;
+#endif
+
+  resp->local.attr.rta_len  = RTA_LENGTH(sizeof(in_addr_t));
+  resp->local.attr.rta_type = IFA_LOCAL;
+  resp->local.addr          = dev->d_ipaddr;
+
+  resp->addr.attr.rta_len   = RTA_LENGTH(sizeof(in_addr_t));
+  resp->addr.attr.rta_type  = IFA_ADDRESS;
+  resp->addr.addr           = dev->d_ipaddr;
+
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6addr_response
+ *
+ * Description:
+ *   Generate one response for the IPv6 address of a device.  'req' is NULL
+ *   for a change notification.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETADDR)
+static FAR struct netlink_response_s *
+netlink_ipv6addr_response(FAR struct net_driver_s *dev, int type,
+                          FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getaddr_recvfrom_ipv6resplist_s *alloc;
+  FAR struct getaddr_recvfrom_ipv6response_s *resp;
+
+  /* Allocate the response */
+
+  alloc = (FAR struct getaddr_recvfrom_ipv6resplist_s *)
+    kmm_zalloc(sizeof(struct getaddr_recvfrom_ipv6resplist_s));
+  if (alloc == NULL)
+    {
+      return NULL;
+    }
+
+  /* Format the response */
+
+  resp                    = &alloc->payload;
+  resp->hdr.nlmsg_len     = sizeof(struct getaddr_recvfrom_ipv6response_s);
+  resp->hdr.nlmsg_type    = type;
+  resp->hdr.nlmsg_flags   = req ? NLM_F_MULTI : 0;
+  resp->hdr.nlmsg_seq     = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid     = req ? req->hdr.nlmsg_pid : 0;
+
+  resp->ifa.ifa_family    = AF_INET6;
+  resp->ifa.ifa_prefixlen = net_ipv6_mask2pref(dev->d_ipv6netmask);
+  resp->ifa.ifa_flags     = IFA_F_PERMANENT;
+  resp->ifa.ifa_scope     =
+    (NTOHS(dev->d_ipv6addr[0]) & 0xffc0) == 0xfe80 ?
+    RT_SCOPE_LINK : RT_SCOPE_UNIVERSE;
+#ifdef CONFIG_NETDEV_IFINDEX
+  resp->ifa.ifa_index     = dev->d_ifindex;
+#endif
+
+  resp->addr.attr.rta_len  = RTA_LENGTH(sizeof(net_ipv6addr_t));
+  resp->addr.attr.rta_type = IFA_ADDRESS;
+  net_ipv6addr_copy(resp->addr.addr, dev->d_ipv6addr);
+
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_get_addrlist
+ *
+ * Description:
+ *   Dump the IPv4 or IPv6 addresses of all network devices.  Devices
+ *   without an address of the requested family are skipped.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+static int netlink_addr_callback(FAR struct net_driver_s *dev,
+                                 FAR void *arg)
+{
+  FAR struct nlroute_info_s *info = arg;
+  FAR struct netlink_response_s *resp = NULL;
+
+#ifdef CONFIG_NET_IPv4
+  if (info->req->gen.rtgen_family == AF_INET)
+    {
+      if (net_ipv4addr_cmp(dev->d_ipaddr, INADDR_ANY))
+        {
+          return OK;
+        }
+
+      resp = netlink_ipv4addr_response(dev, RTM_NEWADDR, info->req);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (info->req->gen.rtgen_family == AF_INET6)
+    {
+      if (net_ipv6addr_cmp(dev->d_ipv6addr, g_ipv6_unspecaddr))
+        {
+          return OK;
+        }
+
+      resp = netlink_ipv6addr_response(dev, RTM_NEWADDR, info->req);
+    }
+#endif
+
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  netlink_add_response(info->handle, resp);
+  return OK;
+}
+
+static int netlink_get_addrlist(NETLINK_HANDLE handle,
+                              FAR const struct nlroute_sendto_request_s *req)
+{
+  struct nlroute_info_s info;
+  int ret;
+
+  /* Visit each device */
+
+  info.handle = handle;
+  info.req    = req;
+
+  net_lock();
+  ret = netdev_foreach(netlink_addr_callback, &info);
+  net_unlock();
+  if (ret != 0)
+    {
+      return -ENOMEM;
+    }
+
+  return netlink_add_terminator(handle, req);
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -742,6 +1006,30 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
         break;
 #endif
 
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+      /* Dump the IPv4 or IPv6 addresses of all devices */
+
+      case RTM_GETADDR:
+#ifdef CONFIG_NET_IPv4
+        if (req->gen.rtgen_family == AF_INET)
+          {
+            ret = netlink_get_addrlist(handle, req);
+          }
+        else
+#endif
+#ifdef CONFIG_NET_IPv6
+        if (req->gen.rtgen_family == AF_INET6)
+          {
+            ret = netlink_get_addrlist(handle, req);
+          }
+        else
+#endif
+          {
+            ret = -EAFNOSUPPORT;
+          }
+        break;
+#endif
+
 #ifndef CONFIG_NETLINK_DISABLE_GETNEIGH
       /* Retrieve ARP/Neighbor Tables */
 
@@ -839,4 +1127,130 @@ void netlink_device_notify(FAR struct net_driver_s *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipaddr_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWADDR or RTM_DELADDR message for the IPv4 or IPv6
+ *   address of a device to the RTNLGRP_IPV4_IFADDR or RTNLGRP_IPV6_IFADDR
+ *   group.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+void netlink_ipaddr_notify(FAR struct net_driver_s *dev, int type,
+                           int domain)
+{
+  FAR struct netlink_response_s *resp = NULL;
+  int group = RTNLGRP_NONE;
+
+  DEBUGASSERT(dev != NULL);
+
+#ifdef CONFIG_NET_IPv4
+  if (domain == AF_INET)
+    {
+      resp  = netlink_ipv4addr_response(dev, type, NULL);
+      group = RTNLGRP_IPV4_IFADDR;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (domain == AF_INET6)
+    {
+      resp  = netlink_ipv6addr_response(dev, type, NULL);
+      group = RTNLGRP_IPV6_IFADDR;
+    }
+#endif
+
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(group, resp);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_route_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWROUTE or RTM_DELROUTE message to the
+ *   RTNLGRP_IPV4_ROUTE or RTNLGRP_IPV6_ROUTE group.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETROUTE
+void netlink_route_notify(FAR const void *route, int type, int domain)
+{
+  FAR struct netlink_response_s *resp = NULL;
+  int group = RTNLGRP_NONE;
+
+  DEBUGASSERT(route != NULL);
+
+#ifdef CONFIG_NET_IPv4
+  if (domain == AF_INET)
+    {
+      resp  = netlink_ipv4route_response(route, type, NULL);
+      group = RTNLGRP_IPV4_ROUTE;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (domain == AF_INET6)
+    {
+      resp  = netlink_ipv6route_response(route, type, NULL);
+      group = RTNLGRP_IPV6_ROUTE;
+    }
+#endif
+
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(group, resp);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_neigh_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWNEIGH or RTM_DELNEIGH message to the RTNLGRP_NEIGH
+ *   group.  The message has the same layout as an RTM_GETNEIGH response
+ *   holding a single table entry.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETNEIGH
+void netlink_neigh_notify(FAR const void *neigh, int type, int domain)
+{
+  FAR struct netlink_response_s *resp;
+  size_t size;
+
+  DEBUGASSERT(neigh != NULL);
+
+#ifdef CONFIG_NET_ARP
+  if (domain == AF_INET)
+    {
+      size = sizeof(struct arp_entry_s);
+    }
+  else
+#endif
+#ifdef CONFIG_NET_IPv6
+  if (domain == AF_INET6)
+    {
+      size = sizeof(struct neighbor_entry_s);
+    }
+  else
+#endif
+    {
+      return;
+    }
+
+  resp = netlink_neigh_response(neigh, size, type, domain, NULL);
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(RTNLGRP_NEIGH, resp);
+    }
+}
+#endif
+
 #endif /* CONFIG_NETLINK_ROUTE */
@@ -803,6 +803,9 @@ static ssize_t netlink_recvfrom(FAR struct socket *psock, FAR void *buf,
                                 FAR socklen_t *fromlen)
 {
   FAR struct netlink_response_s *entry;
+  FAR struct netlink_response_s *next;
+  size_t offset;
+  size_t nrecv;
 
   DEBUGASSERT(psock != NULL && psock->s_conn != NULL && buf != NULL);
   DEBUGASSERT(from == NULL ||
@@ -832,14 +835,49 @@ static ssize_t netlink_recvfrom(FAR struct socket *psock, FAR void *buf,
         }
     }
 
-  if (len > entry->msg.nlmsg_len)
+  nrecv = entry->msg.nlmsg_len;
+  if (nrecv > len)
     {
-      len = entry->msg.nlmsg_len;
+      nrecv = len;
     }
 
   /* Copy the payload to the user buffer */
 
-  memcpy(buf, &entry->msg, len);
+  memcpy(buf, &entry->msg, nrecv);
+
+  /* A dump is queued as a sequence of NLM_F_MULTI messages ending with
+   * NLMSG_DONE.  Pack as many of the following parts as fit behind the
+   * first one so that a large table takes only a few calls.
+   */
+
+  if (nrecv == entry->msg.nlmsg_len)
+    {
+      while ((entry->msg.nlmsg_flags & NLM_F_MULTI) != 0 &&
+             entry->msg.nlmsg_type != NLMSG_DONE)
+        {
+          offset = NLMSG_ALIGN(nrecv);
+          if (offset >= len)
+            {
+              break;
+            }
+
+          next = netlink_tryget_multipart(psock->s_conn,
+                                          entry->msg.nlmsg_seq,
+                                          len - offset);
+          if (next == NULL)
+            {
+              break;
+            }
+
+          memcpy((FAR uint8_t *)buf + offset, &next->msg,
+                 next->msg.nlmsg_len);
+          nrecv = offset + next->msg.nlmsg_len;
+
+          kmm_free(entry);
+          entry = next;
+        }
+    }
+
   kmm_free(entry);
 
   if (from != NULL)
@@ -847,7 +885,7 @@ static ssize_t netlink_recvfrom(FAR struct socket *psock, FAR void *buf,
       netlink_getpeername(psock, from, fromlen);
     }
 
-  return len;
+  return nrecv;
 }
 
 /****************************************************************************
@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <queue.h>
 
 #ifdef CONFIG_NET_PKT
@@ -66,6 +67,22 @@
 
 struct devif_callback_s; /* Forward reference */
 
+#ifdef CONFIG_NET_PKT_RING
+/* A ring of frame slots in user memory.  See struct tpacket_req in
+ * include/netpacket/packet.h.
+ */
+
+struct pkt_ring_s
+{
+  FAR uint8_t *pr_base;   /* Start of the ring, NULL if there is none */
+  uint16_t pr_framesize;  /* Size of one frame slot */
+  uint16_t pr_nframes;    /* Number of frame slots */
+  uint16_t pr_head;       /* The next slot that the kernel will use */
+};
+
+struct pollfd;           /* Forward reference */
+#endif
+
 struct pkt_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -84,6 +101,17 @@ struct pkt_conn_s
   uint8_t    ifindex;
   uint16_t   proto;
   uint8_t    crefs;    /* Reference counts on this instance */
+
+#ifdef CONFIG_NET_PKT_RING
+  struct pkt_ring_s rxring; /* Receive ring */
+  struct pkt_ring_s txring; /* Transmit ring */
+  bool       rxlosing;      /* Frames were dropped because rxring was full */
+  bool       txbusy;        /* A send() is draining txring */
+
+  /* The threads polling the socket */
+
+  FAR struct pollfd *fds[CONFIG_NET_PKT_NPOLLWAITERS];
+#endif
 };
 
 /****************************************************************************
@@ -308,6 +336,101 @@ struct socket;
 ssize_t psock_pkt_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the packet socket option specified by the
+ *   'option' argument to the value pointed to by the 'value' argument for
+ *   the socket specified by the 'psock' argument.
+ *
+ *   See <netpacket/packet.h> for the a complete list of values of packet
+ *   socket options.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_setcockopt() for
+ *   the list of possible error values.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame in the device buffer into the next slot of the receive
+ *   ring of a packet socket.  The frame is dropped if that slot has not
+ *   been handed back by the user yet.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received frame
+ *   conn - The packet socket connection with a receive ring
+ *
+ * Assumptions:
+ *   Called from the network diver with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send every frame of the transmit ring of a packet socket that is
+ *   marked TP_STATUS_SEND_REQUEST, in ring order, and wait until all have
+ *   been handed to the driver.
+ *
+ * Input Parameters:
+ *   psock - The packet socket with a transmit ring
+ *   dev   - The device to send on
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+ssize_t pkt_ring_send(FAR struct socket *psock,
+                      FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: pkt_pollsetup and pkt_pollteardown
+ *
+ * Description:
+ *   Set up or tear down the monitoring of the rings of a packet socket.
+ *   POLLIN is reported while the most recently received frame has not been
+ *   handed back, and POLLOUT while the next transmit slot is available.
+ *
+ * Input Parameters:
+ *   psock - The packet socket of interest
+ *   fds   - The structure describing the events to be monitored
+ *
+ * Returned Value:
+ *   0: Success; Negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RING
+int pkt_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds);
+int pkt_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
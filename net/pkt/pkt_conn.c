@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_PKT)
 
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
@@ -158,6 +159,16 @@ FAR struct pkt_conn_s *pkt_alloc(void)
 
       conn->ifindex = 0;
 
+#ifdef CONFIG_NET_PKT_RING
+      /* No rings are attached to a new connection */
+
+      memset(&conn->rxring, 0, sizeof(struct pkt_ring_s));
+      memset(&conn->txring, 0, sizeof(struct pkt_ring_s));
+      memset(conn->fds, 0, sizeof(conn->fds));
+      conn->rxlosing = false;
+      conn->txbusy   = false;
+#endif
+
       /* Enqueue the connection into the active list */
 
       dq_addlast(&conn->node, &g_active_pkt_connections);
@@ -182,6 +193,15 @@ void pkt_free(FAR struct pkt_conn_s *conn)
 
   DEBUGASSERT(conn->crefs == 0);
 
+#ifdef CONFIG_NET_PKT_RING
+  /* Detach the rings so that input stops writing to user memory */
+
+  net_lock();
+  conn->rxring.pr_base = NULL;
+  conn->txring.pr_base = NULL;
+  net_unlock();
+#endif
+
   _pkt_semtake(&g_free_sem);
 
   /* Remove the connection from the active list */
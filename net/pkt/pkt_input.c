@@ -91,6 +91,15 @@ int pkt_input(struct net_driver_s *dev)
   int ret = OK;
 
   conn = pkt_active(pbuf);
+#ifdef CONFIG_NET_PKT_RING
+  if (conn && conn->rxring.pr_base != NULL)
+    {
+      /* The frame goes straight into the receive ring of the socket */
+
+      pkt_ring_input(dev, conn);
+    }
+  else
+#endif
   if (conn)
     {
       uint16_t flags;
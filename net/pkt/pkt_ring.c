@@ -0,0 +1,638 @@
+/****************************************************************************
+ * net/pkt/pkt_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_PKT_RING)
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ethernet.h>
+
+#include "netdev/netdev.h"
+#include "devif/devif.h"
+#include "socket/socket.h"
+#include "pkt/pkt.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The header of frame slot 'i' of a ring and the frame data of a slot */
+
+#define PKT_RING_SLOT(r,i) \
+  ((FAR struct tpacket_hdr *)((r)->pr_base + (size_t)(i) * (r)->pr_framesize))
+#define PKT_RING_DATA(h) ((FAR uint8_t *)(h) + TPACKET_HDRLEN)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of a pkt_ring_send() until the event handler is done with it */
+
+struct pkt_ringsend_s
+{
+  FAR struct pkt_conn_s *rs_conn;      /* The sending connection */
+  FAR struct devif_callback_s *rs_cb;  /* Reference to callback instance */
+  sem_t rs_sem;                        /* Wakes up the sending thread */
+  ssize_t rs_sent;                     /* The number of bytes sent */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_advance
+ *
+ * Description:
+ *   Move the kernel's position in a ring to the next slot.
+ *
+ ****************************************************************************/
+
+static inline void pkt_ring_advance(FAR struct pkt_ring_s *ring)
+{
+  if (++ring->pr_head >= ring->pr_nframes)
+    {
+      ring->pr_head = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_pollevents
+ *
+ * Description:
+ *   Return the set of events that are currently true for a packet socket.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static pollevent_t pkt_ring_pollevents(FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring;
+  pollevent_t eventset = 0;
+  uint16_t prev;
+
+  /* The user hands receive slots back in ring order, so there is something
+   * to read for as long as the most recently filled slot is not back.
+   */
+
+  ring = &conn->rxring;
+  if (ring->pr_base != NULL)
+    {
+      prev = ring->pr_head > 0 ? ring->pr_head - 1 : ring->pr_nframes - 1;
+      if (PKT_RING_SLOT(ring, prev)->tp_status != TP_STATUS_KERNEL)
+        {
+          eventset |= POLLIN;
+        }
+    }
+
+  ring = &conn->txring;
+  if (ring->pr_base != NULL &&
+      PKT_RING_SLOT(ring, ring->pr_head)->tp_status == TP_STATUS_AVAILABLE)
+    {
+      eventset |= POLLOUT;
+    }
+
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_pollnotify
+ *
+ * Description:
+ *   Report events to the threads polling a packet socket.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void pkt_ring_pollnotify(FAR struct pkt_conn_s *conn,
+                                pollevent_t eventset)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NET_PKT_NPOLLWAITERS; i++)
+    {
+      struct pollfd *fds = conn->fds[i];
+      if (fds)
+        {
+          fds->revents |= eventset & (fds->events | POLLHUP | POLLERR);
+          if (fds->revents != 0)
+            {
+              ninfo("Report events: %02x\n", fds->revents);
+              nxsem_post(fds->sem);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Attach the ring described by 'req' to a connection, or detach the
+ *   current one if the request has no frames.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int pkt_ring_setup(FAR struct pkt_ring_s *ring,
+                          FAR const struct tpacket_req *req)
+{
+  unsigned int i;
+
+  if (req->tp_frame_nr == 0)
+    {
+      memset(ring, 0, sizeof(struct pkt_ring_s));
+      return OK;
+    }
+
+  /* Each slot must hold the header and at least an Ethernet header, and
+   * the headers must be aligned.
+   */
+
+  if (req->tp_ring == NULL ||
+      ((uintptr_t)req->tp_ring & (sizeof(uint32_t) - 1)) != 0 ||
+      req->tp_frame_size < TPACKET_HDRLEN + ETH_HDRLEN ||
+      req->tp_frame_size > UINT16_MAX ||
+      (req->tp_frame_size & (TPACKET_ALIGNMENT - 1)) != 0 ||
+      req->tp_frame_nr > UINT16_MAX)
+    {
+      return -EINVAL;
+    }
+
+  ring->pr_base      = (FAR uint8_t *)req->tp_ring;
+  ring->pr_framesize = req->tp_frame_size;
+  ring->pr_nframes   = req->tp_frame_nr;
+  ring->pr_head      = 0;
+
+  /* TP_STATUS_KERNEL and TP_STATUS_AVAILABLE are both zero */
+
+  for (i = 0; i < ring->pr_nframes; i++)
+    {
+      PKT_RING_SLOT(ring, i)->tp_status = TP_STATUS_KERNEL;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send_eventhandler
+ *
+ * Description:
+ *   Send the next requested frame of the transmit ring on each poll of the
+ *   device, until there are no more.  The driver is asked to poll again
+ *   right away while frames remain.
+ *
+ ****************************************************************************/
+
+static uint16_t pkt_ring_send_eventhandler(FAR struct net_driver_s *dev,
+                                           FAR void *pvconn,
+                                           FAR void *pvpriv, uint16_t flags)
+{
+  FAR struct pkt_ringsend_s *pstate = (FAR struct pkt_ringsend_s *)pvpriv;
+  FAR struct pkt_ring_s *ring;
+  FAR struct tpacket_hdr *hdr;
+
+  if (pstate == NULL)
+    {
+      return flags;
+    }
+
+  /* Wait for the next polling cycle if the device buffer is in use */
+
+  if (dev->d_sndlen > 0 || (flags & PKT_NEWDATA) != 0)
+    {
+      return flags;
+    }
+
+  ring = &pstate->rs_conn->txring;
+  for (; ; )
+    {
+      hdr = PKT_RING_SLOT(ring, ring->pr_head);
+      if (hdr->tp_status != TP_STATUS_SEND_REQUEST)
+        {
+          break;
+        }
+
+      /* Hand back a frame that cannot be sent and try the next one */
+
+      if (hdr->tp_len < ETH_HDRLEN ||
+          hdr->tp_len > ring->pr_framesize - TPACKET_HDRLEN ||
+          hdr->tp_len >= NETDEV_PKTSIZE(dev))
+        {
+          nwarn("WARNING: Bad frame length: %u\n", hdr->tp_len);
+          hdr->tp_status = TP_STATUS_WRONG_FORMAT;
+          pkt_ring_advance(ring);
+          continue;
+        }
+
+      /* Copy the frame into the device packet buffer.  The slot can then
+       * be handed back right away.
+       */
+
+      devif_pkt_send(dev, PKT_RING_DATA(hdr), hdr->tp_len);
+      pstate->rs_sent += hdr->tp_len;
+
+      /* Make sure no ARP request overwrites this frame.  This flag will be
+       * cleared in arp_out().
+       */
+
+      IFF_SET_NOARP(dev->d_flags);
+
+      hdr->tp_status = TP_STATUS_AVAILABLE;
+      pkt_ring_advance(ring);
+      pkt_ring_pollnotify(pstate->rs_conn, POLLOUT);
+
+      /* The device buffer holds only one frame, so the next one has to go
+       * on the next poll.  Connections are only polled once per pass, so
+       * ask the driver for another poll now rather than waiting for the
+       * poll timer.
+       */
+
+      if (PKT_RING_SLOT(ring, ring->pr_head)->tp_status ==
+          TP_STATUS_SEND_REQUEST)
+        {
+          netdev_txnotify_dev(dev);
+          return flags;
+        }
+
+      break;
+    }
+
+  /* Nothing more to send.  Don't allow any further call backs. */
+
+  pstate->rs_cb->flags = 0;
+  pstate->rs_cb->priv  = NULL;
+  pstate->rs_cb->event = NULL;
+
+  /* Wake up the waiting thread */
+
+  nxsem_post(&pstate->rs_sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   pkt_setsockopt() sets the packet socket option specified by the
+ *   'option' argument to the value pointed to by the 'value' argument for
+ *   the socket specified by the 'psock' argument.
+ *
+ *   See <netpacket/packet.h> for the a complete list of values of packet
+ *   socket options.
+ *
+ * Input Parameters:
+ *   psock     Socket structure of socket to operate on
+ *   option    identifies the option to set
+ *   value     Points to the argument value
+ *   value_len The length of the argument value
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error.  See psock_setcockopt() for
+ *   the list of possible error values.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len)
+{
+  FAR struct pkt_conn_s *conn;
+  FAR const struct tpacket_req *req;
+  int ret;
+
+  if (psock->s_domain != PF_PACKET)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  if (value == NULL || value_len != sizeof(struct tpacket_req))
+    {
+      return -EINVAL;
+    }
+
+  conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  req  = (FAR const struct tpacket_req *)value;
+
+  net_lock();
+  switch (option)
+    {
+      case PACKET_RX_RING:
+        ret = pkt_ring_setup(&conn->rxring, req);
+        conn->rxlosing = false;
+        break;
+
+      case PACKET_TX_RING:
+        if (conn->txbusy)
+          {
+            ret = -EBUSY;
+          }
+        else
+          {
+            ret = pkt_ring_setup(&conn->txring, req);
+          }
+        break;
+
+      default:
+        nerr("ERROR: Unrecognized packet socket option: %d\n", option);
+        ret = -ENOPROTOOPT;
+        break;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame in the device buffer into the next slot of the receive
+ *   ring of a packet socket.  The frame is dropped if that slot has not
+ *   been handed back by the user yet.
+ *
+ * Input Parameters:
+ *   dev  - The device driver structure containing the received frame
+ *   conn - The packet socket connection with a receive ring
+ *
+ * Assumptions:
+ *   Called from the network diver with the network locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn)
+{
+  FAR struct pkt_ring_s *ring = &conn->rxring;
+  FAR struct tpacket_hdr *hdr;
+  struct timespec ts;
+  uint32_t snaplen;
+  uint32_t status;
+
+  hdr = PKT_RING_SLOT(ring, ring->pr_head);
+  if (hdr->tp_status != TP_STATUS_KERNEL)
+    {
+      /* The ring is full.  Drop the frame and tell the user later. */
+
+      conn->rxlosing = true;
+      return;
+    }
+
+  status  = TP_STATUS_USER;
+  snaplen = dev->d_len;
+  if (snaplen > ring->pr_framesize - TPACKET_HDRLEN)
+    {
+      snaplen = ring->pr_framesize - TPACKET_HDRLEN;
+      status |= TP_STATUS_COPY;
+    }
+
+  if (conn->rxlosing)
+    {
+      conn->rxlosing = false;
+      status |= TP_STATUS_LOSING;
+    }
+
+  memcpy(PKT_RING_DATA(hdr), dev->d_buf, snaplen);
+  clock_gettime(CLOCK_REALTIME, &ts);
+
+  hdr->tp_len     = dev->d_len;
+  hdr->tp_snaplen = snaplen;
+  hdr->tp_mac     = TPACKET_HDRLEN;
+  hdr->tp_net     = TPACKET_HDRLEN + ETH_HDRLEN;
+  hdr->tp_sec     = ts.tv_sec;
+  hdr->tp_usec    = ts.tv_nsec / 1000;
+
+  /* Hand the slot to the user only after all of it has been written */
+
+  __atomic_store_n(&hdr->tp_status, status, __ATOMIC_RELEASE);
+
+  pkt_ring_advance(ring);
+  pkt_ring_pollnotify(conn, POLLIN);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_send
+ *
+ * Description:
+ *   Send every frame of the transmit ring of a packet socket that is
+ *   marked TP_STATUS_SEND_REQUEST, in ring order, and wait until all have
+ *   been handed to the driver.
+ *
+ * Input Parameters:
+ *   psock - The packet socket with a transmit ring
+ *   dev   - The device to send on
+ *
+ * Returned Value:
+ *   The number of bytes sent, or a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t pkt_ring_send(FAR struct socket *psock, FAR struct net_driver_s *dev)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  FAR struct pkt_ring_s *ring = &conn->txring;
+  struct pkt_ringsend_s state;
+  int ret;
+
+  net_lock();
+  if (conn->txbusy)
+    {
+      net_unlock();
+      return -EBUSY;
+    }
+
+  /* Is there anything to send? */
+
+  if (ring->pr_base == NULL ||
+      PKT_RING_SLOT(ring, ring->pr_head)->tp_status !=
+      TP_STATUS_SEND_REQUEST)
+    {
+      net_unlock();
+      return 0;
+    }
+
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  memset(&state, 0, sizeof(struct pkt_ringsend_s));
+  nxsem_init(&state.rs_sem, 0, 0);
+  nxsem_set_protocol(&state.rs_sem, SEM_PRIO_NONE);
+  state.rs_conn = conn;
+
+  state.rs_cb = pkt_callback_alloc(dev, conn);
+  if (state.rs_cb == NULL)
+    {
+      ret = -EBUSY;
+    }
+  else
+    {
+      conn->txbusy = true;
+
+      state.rs_cb->flags = PKT_POLL;
+      state.rs_cb->priv  = (FAR void *)&state;
+      state.rs_cb->event = pkt_ring_send_eventhandler;
+
+      /* Notify the device driver that new TX data is available and wait
+       * for the whole batch to go out.
+       */
+
+      netdev_txnotify_dev(dev);
+      ret = net_lockedwait(&state.rs_sem);
+
+      pkt_callback_free(dev, conn, state.rs_cb);
+      conn->txbusy = false;
+    }
+
+  nxsem_destroy(&state.rs_sem);
+  net_unlock();
+
+  /* Report what was sent before any interruption */
+
+  return state.rs_sent > 0 ? state.rs_sent : ret;
+}
+
+/****************************************************************************
+ * Name: pkt_pollsetup
+ *
+ * Description:
+ *   Set up the monitoring of the rings of a packet socket.
+ *
+ * Input Parameters:
+ *   psock - The packet socket of interest
+ *   fds   - The structure describing the events to be monitored
+ *
+ * Returned Value:
+ *   0: Success; Negated errno on failure
+ *
+ ****************************************************************************/
+
+int pkt_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  pollevent_t eventset;
+  int i;
+
+  net_lock();
+
+  /* Only the rings report events */
+
+  if (conn->rxring.pr_base == NULL && conn->txring.pr_base == NULL)
+    {
+      net_unlock();
+      return -ENOSYS;
+    }
+
+  /* Find an available slot for the poll structure reference */
+
+  for (i = 0; i < CONFIG_NET_PKT_NPOLLWAITERS; i++)
+    {
+      if (conn->fds[i] == NULL)
+        {
+          /* Bind the poll structure and this slot */
+
+          conn->fds[i] = fds;
+          fds->priv = &conn->fds[i];
+          break;
+        }
+    }
+
+  if (i >= CONFIG_NET_PKT_NPOLLWAITERS)
+    {
+      fds->priv = NULL;
+      net_unlock();
+      return -EBUSY;
+    }
+
+  /* Report any events that are already true */
+
+  eventset = pkt_ring_pollevents(conn);
+  if (eventset != 0)
+    {
+      pkt_ring_pollnotify(conn, eventset);
+    }
+
+  net_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_pollteardown
+ *
+ * Description:
+ *   Tear down the monitoring of the rings of a packet socket.
+ *
+ * Input Parameters:
+ *   psock - The packet socket of interest
+ *   fds   - The structure describing the events to be monitored
+ *
+ * Returned Value:
+ *   0: Success; Negated errno on failure
+ *
+ ****************************************************************************/
+
+int pkt_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
+{
+  FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+  if (slot == NULL)
+    {
+      return -EIO;
+    }
+
+  /* Remove all memory of the poll setup */
+
+  net_lock();
+  *slot = NULL;
+  fds->priv = NULL;
+  net_unlock();
+  return OK;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_PKT_RING */
@@ -190,6 +190,18 @@ ssize_t psock_pkt_send(FAR struct socket *psock, FAR const void *buf,
       return -ENODEV;
     }
 
+#ifdef CONFIG_NET_PKT_RING
+  /* A zero-length send on a socket with a transmit ring sends every frame
+   * that is queued in the ring.
+   */
+
+  if (len == 0 &&
+      ((FAR struct pkt_conn_s *)psock->s_conn)->txring.pr_base != NULL)
+    {
+      return pkt_ring_send(psock, dev);
+    }
+#endif
+
   /* Perform the send operation */
 
   /* Initialize the state structure. This is done with the network locked
@@ -516,7 +516,11 @@ int pkt_listen(FAR struct socket *psock, int backlog)
 static int pkt_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
                           bool setup)
 {
+#ifdef CONFIG_NET_PKT_RING
+  return setup ? pkt_pollsetup(psock, fds) : pkt_pollteardown(psock, fds);
+#else
   return -ENOSYS;
+#endif
 }
 
 /****************************************************************************
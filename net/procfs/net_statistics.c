@@ -80,6 +80,19 @@ static int     netprocfs_sent(FAR struct netprocfs_file_s *netfile);
 #ifdef CONFIG_NET_TCP
 static int     netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile);
 #endif /* CONFIG_NET_TCP */
+#ifdef CONFIG_NET_ARP
+static int     netprocfs_arp(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_ARP */
+#ifdef CONFIG_NET_IPv6
+static int     netprocfs_neighbor(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_IPv6 */
+#ifdef CONFIG_NET_IPFORWARD
+static int     netprocfs_ipforward(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_IPFORWARD */
+#ifdef CONFIG_NET_6LOWPAN
+static int     netprocfs_sixlowpan_tx(FAR struct netprocfs_file_s *netfile);
+static int     netprocfs_sixlowpan_rx(FAR struct netprocfs_file_s *netfile);
+#endif /* CONFIG_NET_6LOWPAN */
 
 /****************************************************************************
  * Private Data
@@ -114,6 +127,23 @@ static const linegen_t g_stat_linegen[] =
 #ifdef CONFIG_NET_TCP
   , netprocfs_retransmissions
 #endif /* CONFIG_NET_TCP */
+
+#ifdef CONFIG_NET_ARP
+  , netprocfs_arp
+#endif /* CONFIG_NET_ARP */
+
+#ifdef CONFIG_NET_IPv6
+  , netprocfs_neighbor
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPFORWARD
+  , netprocfs_ipforward
+#endif /* CONFIG_NET_IPFORWARD */
+
+#ifdef CONFIG_NET_6LOWPAN
+  , netprocfs_sixlowpan_tx
+  , netprocfs_sixlowpan_rx
+#endif /* CONFIG_NET_6LOWPAN */
 };
 
 #define NSTAT_LINES (sizeof(g_stat_linegen) / sizeof(linegen_t))
@@ -436,6 +466,75 @@ static int netprocfs_retransmissions(FAR struct netprocfs_file_s *netfile)
 }
 #endif /* CONFIG_NET_STATISTICS && CONFIG_NET_TCP */
 
+/****************************************************************************
+ * Name: netprocfs_arp
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_ARP)
+static int netprocfs_arp(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "ARP         Hit: %04x  Miss: %04x  Evict: %04x  "
+                  "Refresh: %04x\n",
+                  g_netstats.arp.hit, g_netstats.arp.miss,
+                  g_netstats.arp.evict, g_netstats.arp.refresh);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_ARP */
+
+/****************************************************************************
+ * Name: netprocfs_neighbor
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_IPv6)
+static int netprocfs_neighbor(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Neighbor    Hit: %04x  Miss: %04x  Evict: %04x\n",
+                  g_netstats.nd.hit, g_netstats.nd.miss,
+                  g_netstats.nd.evict);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_IPv6 */
+
+/****************************************************************************
+ * Name: netprocfs_ipforward
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_IPFORWARD)
+static int netprocfs_ipforward(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "Forward     Fwd: %04x  Hit: %04x  Miss: %04x\n",
+                  g_netstats.ipfwd.forward, g_netstats.ipfwd.hit,
+                  g_netstats.ipfwd.miss);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_IPFORWARD */
+
+/****************************************************************************
+ * Name: netprocfs_sixlowpan_tx and netprocfs_sixlowpan_rx
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_STATISTICS) && defined(CONFIG_NET_6LOWPAN)
+static int netprocfs_sixlowpan_tx(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "6LoWPAN TX  Frame: %04x  Frag: %04x\n",
+                  g_netstats.sixlowpan.txframe,
+                  g_netstats.sixlowpan.txfrag);
+}
+
+static int netprocfs_sixlowpan_rx(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "6LoWPAN RX  Frame: %04x  Frag: %04x  Reass: %04x  "
+                  "Tmo: %04x  Drop: %04x\n",
+                  g_netstats.sixlowpan.rxframe,
+                  g_netstats.sixlowpan.rxfrag,
+                  g_netstats.sixlowpan.reass,
+                  g_netstats.sixlowpan.timeout,
+                  g_netstats.sixlowpan.drop);
+}
+#endif /* CONFIG_NET_STATISTICS && CONFIG_NET_6LOWPAN */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
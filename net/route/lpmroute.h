@@ -0,0 +1,167 @@
+/****************************************************************************
+ * net/route/lpmroute.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_LPMROUTE_H
+#define __NET_ROUTE_LPMROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_LPM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The prefix trie indexes the in-memory routing tables only */
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+#  define HAVE_LPMROUTE_IPv4 1
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+#  define HAVE_LPMROUTE_IPv6 1
+#endif
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match index of the in-memory routing
+ *   tables and the destination caches in front of it.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void);
+
+/****************************************************************************
+ * Name: net_lpmadd_ipv4 and net_lpmadd_ipv6
+ *
+ * Description:
+ *   Add one routing table entry to the prefix trie.
+ *
+ * Input Parameters:
+ *   route - The routing table entry.  It must remain valid until it is
+ *           removed with net_lpmdel_ipv4/6().
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on any failure:
+ *
+ *   EINVAL - The netmask is not a contiguous prefix
+ *   EEXIST - There is already a route to the same network
+ *   ENOMEM - No trie nodes are available
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+int net_lpmadd_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+int net_lpmadd_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmdel_ipv4 and net_lpmdel_ipv6
+ *
+ * Description:
+ *   Remove one routing table entry from the prefix trie.
+ *
+ * Input Parameters:
+ *   route - The routing table entry that was added with net_lpmadd_ipv4/6()
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+void net_lpmdel_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+void net_lpmdel_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4
+ *
+ * Description:
+ *   Return the router of the most specific route to an IPv4 address.
+ *
+ * Input Parameters:
+ *   target - An IPv4 address on a remote network to use in the lookup.
+ *   router - The location to return the router address
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no route to the target.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+int net_lpmroute_ipv4(in_addr_t target, FAR in_addr_t *router);
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv6
+ *
+ * Description:
+ *   Return the router of the most specific route to an IPv6 address.
+ *
+ * Input Parameters:
+ *   target - An IPv6 address on a remote network to use in the lookup.
+ *   router - The location to return the router address
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no route to the target.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target, net_ipv6addr_t router);
+#endif
+
+#endif /* CONFIG_ROUTE_LPM */
+#endif /* __NET_ROUTE_LPMROUTE_H */
@@ -46,10 +46,13 @@
 #include <debug.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
+#include "netlink/netlink.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
 
@@ -97,6 +100,18 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   /* Then append the new entry to the end of the routing table */
 
   nwritten = net_writeroute_ipv4(&fshandle, &route);
+  if (nwritten >= 0)
+    {
+      netlink_route_notify(&route, RTM_NEWROUTE, AF_INET);
+    }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarded flows may take the new route */
+
+  net_lock();
+  ipfwd_flowcache_flush();
+  net_unlock();
+#endif
 
   net_closeroute_ipv4(&fshandle);
   return nwritten >= 0 ? 0 : (int)nwritten;
@@ -131,6 +146,18 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   /* Then append the new entry to the end of the routing table */
 
   nwritten = net_writeroute_ipv6(&fshandle, &route);
+  if (nwritten >= 0)
+    {
+      netlink_route_notify(&route, RTM_NEWROUTE, AF_INET6);
+    }
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarded flows may take the new route */
+
+  net_lock();
+  ipfwd_flowcache_flush();
+  net_unlock();
+#endif
 
   net_closeroute_ipv6(&fshandle);
   return nwritten >= 0 ? 0 : (int)nwritten;
@@ -50,7 +50,10 @@
 #include <arch/irq.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
+#include "netlink/netlink.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 
@@ -75,6 +78,9 @@
 int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 {
   FAR struct net_route_ipv4_s *route;
+#ifdef HAVE_LPMROUTE_IPv4
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -96,10 +102,31 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   net_lock();
 
+#ifdef HAVE_LPMROUTE_IPv4
+  /* Index the new entry for longest-prefix-match lookups */
+
+  ret = net_lpmadd_ipv4(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      nerr("ERROR: Failed to index the route: %d\n", ret);
+      net_freeroute_ipv4(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
+  netlink_route_notify(route, RTM_NEWROUTE, AF_INET);
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarded flows may take the new route */
+
+  ipfwd_flowcache_flush();
+#endif
+
   net_unlock();
   return OK;
 }
@@ -110,6 +137,9 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
                       net_ipv6addr_t router)
 {
   FAR struct net_route_ipv6_s *route;
+#ifdef HAVE_LPMROUTE_IPv6
+  int ret;
+#endif
 
   /* Allocate a route entry */
 
@@ -131,10 +161,31 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   net_lock();
 
+#ifdef HAVE_LPMROUTE_IPv6
+  /* Index the new entry for longest-prefix-match lookups */
+
+  ret = net_lpmadd_ipv6(route);
+  if (ret < 0)
+    {
+      net_unlock();
+      nerr("ERROR: Failed to index the route: %d\n", ret);
+      net_freeroute_ipv6(route);
+      return ret;
+    }
+#endif
+
   /* Then add the new entry to the table */
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
+  netlink_route_notify(route, RTM_NEWROUTE, AF_INET6);
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarded flows may take the new route */
+
+  ipfwd_flowcache_flush();
+#endif
+
   net_unlock();
   return OK;
 }
@@ -49,11 +49,14 @@
 #include <arpa/inet.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
 #include "route/fileroute.h"
 #include "route/cacheroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
+#include "netlink/netlink.h"
 
 #if defined(CONFIG_ROUTE_IPv4_FILEROUTE) || defined(CONFIG_ROUTE_IPv6_FILEROUTE)
 
@@ -67,6 +70,7 @@ struct route_match_ipv4_s
   in_addr_t                    target;   /* The target IP address to match */
   in_addr_t                    netmask;  /* The network mask to match */
   unsigned int                 index;    /* Index of match */
+  struct net_route_ipv4_s      entry;    /* Copy of the matching entry */
 };
 #endif
 
@@ -76,6 +80,7 @@ struct route_match_ipv6_s
   net_ipv6addr_t               target;   /* The target IP address to match */
   net_ipv6addr_t               netmask;  /* The network mask to match */
   unsigned int                 index;    /* Index of match */
+  struct net_route_ipv6_s      entry;    /* Copy of the matching entry */
 };
 #endif
 
@@ -119,6 +124,7 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
        * value of index is the index to the matching entry.
        */
 
+      memcpy(&match->entry, route, sizeof(match->entry));
       return 1;
     }
 
@@ -158,6 +164,7 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
        * value of index is the index to the matching entry.
        */
 
+      memcpy(&match->entry, route, sizeof(match->entry));
       return 1;
     }
 
@@ -264,6 +271,14 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
   net_flushcache_ipv4();
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarded flows may have used the removed route */
+
+  net_lock();
+  ipfwd_flowcache_flush();
+  net_unlock();
+#endif
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -323,6 +338,10 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   filesize = (nentries - 1) * sizeof(struct net_route_ipv4_s);
   ret = file_truncate(&fshandle, filesize);
+  if (ret >= 0)
+    {
+      netlink_route_notify(&match.entry, RTM_DELROUTE, AF_INET);
+    }
 
 errout_with_fshandle:
   net_closeroute_ipv4(&fshandle);
@@ -413,6 +432,14 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
   net_flushcache_ipv6();
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Forwarded flows may have used the removed route */
+
+  net_lock();
+  ipfwd_flowcache_flush();
+  net_unlock();
+#endif
+
   /* Loop, copying each entry, to the previous entry thus removing the entry
    * to be deleted.
    */
@@ -472,6 +499,10 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   filesize = (nentries - 1) * sizeof(struct net_route_ipv6_s);
   ret = file_truncate(&fshandle, filesize);
+  if (ret >= 0)
+    {
+      netlink_route_notify(&match.entry, RTM_DELROUTE, AF_INET6);
+    }
 
 errout_with_fshandle:
   net_closeroute_ipv6(&fshandle);
@@ -48,7 +48,10 @@
 #include <nuttx/net/ip.h>
 
 #include "route/ramroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
+#include "ipforward/ipforward.h"
+#include "netlink/netlink.h"
 
 #if defined(CONFIG_ROUTE_IPv4_RAMROUTE) || defined(CONFIG_ROUTE_IPv6_RAMROUTE)
 
@@ -122,10 +125,23 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef HAVE_LPMROUTE_IPv4
+      /* Remove it from the longest-prefix-match index */
+
+      net_lpmdel_ipv4(route);
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
+      netlink_route_notify(route, RTM_DELROUTE, AF_INET);
       net_freeroute_ipv4(route);
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Forwarded flows may have used the removed route */
+
+      ipfwd_flowcache_flush();
+#endif
+
       /* Return a non-zero value to terminate the traversal */
 
       return 1;
@@ -175,10 +191,23 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef HAVE_LPMROUTE_IPv6
+      /* Remove it from the longest-prefix-match index */
+
+      net_lpmdel_ipv6(route);
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
+      netlink_route_notify(route, RTM_DELROUTE, AF_INET6);
       net_freeroute_ipv6(route);
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Forwarded flows may have used the removed route */
+
+      ipfwd_flowcache_flush();
+#endif
+
       /* Return a non-zero value to terminate the traversal */
 
       return 1;
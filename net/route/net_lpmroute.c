@@ -0,0 +1,823 @@
+/****************************************************************************
+ * net/route/net_lpmroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/lpmroute.h"
+#include "route/route.h"
+
+#ifdef CONFIG_ROUTE_LPM
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size of the largest key (i.e., address) held in a trie node */
+
+#ifdef HAVE_LPMROUTE_IPv6
+#  define LPM_KEYSIZE 16
+#else
+#  define LPM_KEYSIZE 4
+#endif
+
+/* A path-compressed trie holding N prefixes never needs more than 2N - 1
+ * nodes:  Each node without a route of its own has two children.
+ */
+
+#define LPM_IPv4_NNODES (2 * CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+#define LPM_IPv6_NNODES (2 * CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+
+/* The destination caches are direct-mapped and indexed by a hash of the
+ * target address.
+ */
+
+#ifndef CONFIG_ROUTE_LPM_CACHESIZE
+#  define CONFIG_ROUTE_LPM_CACHESIZE 0
+#endif
+
+#define LPM_CACHEMASK (CONFIG_ROUTE_LPM_CACHESIZE - 1)
+
+#if (CONFIG_ROUTE_LPM_CACHESIZE & LPM_CACHEMASK) != 0
+#  error CONFIG_ROUTE_LPM_CACHESIZE must be a power of two
+#endif
+
+/* Value of bit 'n' of a key, counting from the most significant bit of the
+ * first byte (i.e., in network order).
+ */
+
+#define LPM_BIT(key,n) (((key)[(n) >> 3] >> (7 - ((n) & 7))) & 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One node of the prefix trie.  Nodes are either routes or branch points
+ * where two longer prefixes diverge.
+ */
+
+struct lpm_node_s
+{
+  FAR struct lpm_node_s *child[2]; /* Longer prefixes, by the next bit */
+  FAR void *route;                 /* Route to this prefix or NULL */
+  uint8_t plen;                    /* Prefix length in bits */
+  uint8_t key[LPM_KEYSIZE];        /* Prefix.  Bits past plen are zero */
+};
+
+/* A prefix trie and its pool of nodes */
+
+struct lpm_trie_s
+{
+  FAR struct lpm_node_s *root;     /* Node with the shortest prefix */
+  FAR struct lpm_node_s *free;     /* Unused nodes, linked by child[0] */
+  uint8_t keysize;                 /* Size of the keys in bytes */
+};
+
+/* Destination cache entries.  The cache is flushed whenever the routing
+ * table changes, so the routes they refer to are always valid.
+ */
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+#ifdef HAVE_LPMROUTE_IPv4
+struct lpm_cache_ipv4_s
+{
+  in_addr_t target;                     /* Target IPv4 address */
+  FAR struct net_route_ipv4_s *route;   /* Route to target or NULL */
+};
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+struct lpm_cache_ipv6_s
+{
+  net_ipv6addr_t target;                /* Target IPv6 address */
+  FAR struct net_route_ipv6_s *route;   /* Route to target or NULL */
+};
+#endif
+#endif /* CONFIG_ROUTE_LPM_CACHESIZE > 0 */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+static struct lpm_trie_s g_ipv4_trie;
+static struct lpm_node_s g_ipv4_nodes[LPM_IPv4_NNODES];
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+static struct lpm_cache_ipv4_s g_ipv4_dstcache[CONFIG_ROUTE_LPM_CACHESIZE];
+#endif
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+static struct lpm_trie_s g_ipv6_trie;
+static struct lpm_node_s g_ipv6_nodes[LPM_IPv6_NNODES];
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+static struct lpm_cache_ipv6_s g_ipv6_dstcache[CONFIG_ROUTE_LPM_CACHESIZE];
+#endif
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lpm_init
+ *
+ * Description:
+ *   Initialize an empty trie and put all of its nodes on the free list.
+ *
+ ****************************************************************************/
+
+static void lpm_init(FAR struct lpm_trie_s *trie,
+                     FAR struct lpm_node_s *nodes, unsigned int nnodes,
+                     unsigned int keysize)
+{
+  unsigned int i;
+
+  trie->root    = NULL;
+  trie->free    = NULL;
+  trie->keysize = keysize;
+
+  for (i = 0; i < nnodes; i++)
+    {
+      nodes[i].child[0] = trie->free;
+      trie->free        = &nodes[i];
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_alloc
+ *
+ * Description:
+ *   Take a node from the free list and initialize it with the first 'plen'
+ *   bits of 'key'.  NULL is returned if the free list is empty.
+ *
+ ****************************************************************************/
+
+static FAR struct lpm_node_s *lpm_alloc(FAR struct lpm_trie_s *trie,
+                                        FAR const uint8_t *key,
+                                        unsigned int plen,
+                                        FAR void *route)
+{
+  FAR struct lpm_node_s *node;
+  unsigned int nbytes;
+
+  node = trie->free;
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  trie->free     = node->child[0];
+  node->child[0] = NULL;
+  node->child[1] = NULL;
+  node->route    = route;
+  node->plen     = plen;
+
+  /* Keep only the prefix bits of the key */
+
+  nbytes = (plen + 7) >> 3;
+  memcpy(node->key, key, nbytes);
+  memset(&node->key[nbytes], 0, LPM_KEYSIZE - nbytes);
+
+  if ((plen & 7) != 0)
+    {
+      node->key[nbytes - 1] &= (uint8_t)(0xff << (8 - (plen & 7)));
+    }
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: lpm_release
+ *
+ * Description:
+ *   Return a node to the free list.
+ *
+ ****************************************************************************/
+
+static void lpm_release(FAR struct lpm_trie_s *trie,
+                        FAR struct lpm_node_s *node)
+{
+  node->child[0] = trie->free;
+  trie->free     = node;
+}
+
+/****************************************************************************
+ * Name: lpm_common
+ *
+ * Description:
+ *   Return the number of leading bits that two keys have in common, up to
+ *   'nbits'.  The caller guarantees that the keys are equal before bit
+ *   'start'.
+ *
+ ****************************************************************************/
+
+static unsigned int lpm_common(FAR const uint8_t *key1,
+                               FAR const uint8_t *key2,
+                               unsigned int start, unsigned int nbits)
+{
+  unsigned int n;
+  uint8_t diff;
+
+  for (n = start & ~7; n < nbits; n += 8)
+    {
+      diff = key1[n >> 3] ^ key2[n >> 3];
+      if (diff != 0)
+        {
+          while ((diff & 0x80) == 0)
+            {
+              diff <<= 1;
+              n++;
+            }
+
+          break;
+        }
+    }
+
+  return n < nbits ? n : nbits;
+}
+
+/****************************************************************************
+ * Name: lpm_prefixlen
+ *
+ * Description:
+ *   Convert a network mask to a prefix length.  -EINVAL is returned if the
+ *   mask is not contiguous.
+ *
+ ****************************************************************************/
+
+static int lpm_prefixlen(FAR const uint8_t *mask, unsigned int keysize)
+{
+  unsigned int plen = 0;
+  unsigned int i;
+  uint8_t bits;
+
+  for (i = 0; i < keysize && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < keysize)
+    {
+      for (bits = mask[i]; (bits & 0x80) != 0; bits <<= 1)
+        {
+          plen++;
+        }
+
+      if (bits != 0)
+        {
+          return -EINVAL;
+        }
+
+      for (i++; i < keysize; i++)
+        {
+          if (mask[i] != 0)
+            {
+              return -EINVAL;
+            }
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: lpm_insert
+ *
+ * Description:
+ *   Add a route to the prefix 'key'/'plen'.
+ *
+ ****************************************************************************/
+
+static int lpm_insert(FAR struct lpm_trie_s *trie, FAR const uint8_t *key,
+                      unsigned int plen, FAR void *route)
+{
+  FAR struct lpm_node_s **link = &trie->root;
+  FAR struct lpm_node_s *branch;
+  FAR struct lpm_node_s *node;
+  FAR struct lpm_node_s *leaf;
+  unsigned int common = 0;
+
+  /* Descend while the node's prefix is a prefix of the new one */
+
+  while ((node = *link) != NULL)
+    {
+      common = lpm_common(node->key, key, 0,
+                          node->plen < plen ? node->plen : plen);
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->plen == plen)
+        {
+          /* The prefix is already in the trie, maybe as a branch point */
+
+          if (node->route != NULL)
+            {
+              return -EEXIST;
+            }
+
+          node->route = route;
+          return OK;
+        }
+
+      link = &node->child[LPM_BIT(key, node->plen)];
+    }
+
+  leaf = lpm_alloc(trie, key, plen, route);
+  if (leaf == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  if (node == NULL)
+    {
+      /* Nothing more specific here.  Just add the new leaf. */
+
+      *link = leaf;
+    }
+  else if (common == plen)
+    {
+      /* The new prefix covers the node.  It becomes the node's parent. */
+
+      leaf->child[LPM_BIT(node->key, plen)] = node;
+      *link = leaf;
+    }
+  else
+    {
+      /* The two prefixes diverge.  Join them with a new branch node. */
+
+      branch = lpm_alloc(trie, key, common, NULL);
+      if (branch == NULL)
+        {
+          lpm_release(trie, leaf);
+          return -ENOMEM;
+        }
+
+      branch->child[LPM_BIT(key, common)]       = leaf;
+      branch->child[LPM_BIT(node->key, common)] = node;
+      *link = branch;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lpm_prune
+ *
+ * Description:
+ *   Remove the node at '*link' if it has no route and no longer separates
+ *   two subtries.
+ *
+ ****************************************************************************/
+
+static void lpm_prune(FAR struct lpm_trie_s *trie,
+                      FAR struct lpm_node_s **link)
+{
+  FAR struct lpm_node_s *node = *link;
+
+  if (node->route == NULL &&
+      (node->child[0] == NULL || node->child[1] == NULL))
+    {
+      *link = node->child[0] != NULL ? node->child[0] : node->child[1];
+      lpm_release(trie, node);
+    }
+}
+
+/****************************************************************************
+ * Name: lpm_remove
+ *
+ * Description:
+ *   Remove the route to the prefix 'key'/'plen' and return it.  NULL is
+ *   returned if there is no such route.
+ *
+ ****************************************************************************/
+
+static FAR void *lpm_remove(FAR struct lpm_trie_s *trie,
+                            FAR const uint8_t *key, unsigned int plen)
+{
+  FAR struct lpm_node_s **plink = NULL;
+  FAR struct lpm_node_s **link = &trie->root;
+  FAR struct lpm_node_s *node;
+  FAR void *route;
+
+  while ((node = *link) != NULL && node->plen <= plen)
+    {
+      if (lpm_common(node->key, key, 0, node->plen) < node->plen)
+        {
+          return NULL;
+        }
+
+      if (node->plen == plen)
+        {
+          break;
+        }
+
+      plink = link;
+      link  = &node->child[LPM_BIT(key, node->plen)];
+    }
+
+  if (node == NULL || node->plen != plen || node->route == NULL)
+    {
+      return NULL;
+    }
+
+  /* Drop the route.  That may leave this node and then its parent without
+   * a reason to exist.
+   */
+
+  route       = node->route;
+  node->route = NULL;
+
+  lpm_prune(trie, link);
+  if (plink != NULL)
+    {
+      lpm_prune(trie, plink);
+    }
+
+  return route;
+}
+
+/****************************************************************************
+ * Name: lpm_lookup
+ *
+ * Description:
+ *   Return the route with the longest prefix matching 'key' or NULL.
+ *
+ ****************************************************************************/
+
+static FAR void *lpm_lookup(FAR const struct lpm_trie_s *trie,
+                            FAR const uint8_t *key)
+{
+  FAR const struct lpm_node_s *node = trie->root;
+  FAR void *best = NULL;
+  unsigned int keybits = trie->keysize << 3;
+  unsigned int matched = 0;
+
+  while (node != NULL &&
+         lpm_common(node->key, key, matched, node->plen) == node->plen)
+    {
+      if (node->route != NULL)
+        {
+          best = node->route;
+        }
+
+      if (node->plen >= keybits)
+        {
+          break;
+        }
+
+      matched = node->plen;
+      node    = node->child[LPM_BIT(key, matched)];
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Name: lpm_hash
+ *
+ * Description:
+ *   Return the destination cache index of an address.
+ *
+ ****************************************************************************/
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+static unsigned int lpm_hash(FAR const uint8_t *key, unsigned int keysize)
+{
+  uint32_t hash = 0;
+  unsigned int i;
+
+  for (i = 0; i < keysize; i++)
+    {
+      hash = hash * 31 + key[i];
+    }
+
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash & LPM_CACHEMASK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_init_lpmroute
+ *
+ * Description:
+ *   Initialize the longest-prefix-match index of the in-memory routing
+ *   tables and the destination caches in front of it.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called early in initialization so that no special protection is needed.
+ *
+ ****************************************************************************/
+
+void net_init_lpmroute(void)
+{
+#ifdef HAVE_LPMROUTE_IPv4
+  lpm_init(&g_ipv4_trie, g_ipv4_nodes, LPM_IPv4_NNODES,
+           sizeof(in_addr_t));
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  memset(g_ipv4_dstcache, 0, sizeof(g_ipv4_dstcache));
+#endif
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+  lpm_init(&g_ipv6_trie, g_ipv6_nodes, LPM_IPv6_NNODES,
+           sizeof(net_ipv6addr_t));
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  memset(g_ipv6_dstcache, 0, sizeof(g_ipv6_dstcache));
+#endif
+#endif
+}
+
+/****************************************************************************
+ * Name: net_lpmadd_ipv4 and net_lpmadd_ipv6
+ *
+ * Description:
+ *   Add one routing table entry to the prefix trie.
+ *
+ * Input Parameters:
+ *   route - The routing table entry.  It must remain valid until it is
+ *           removed with net_lpmdel_ipv4/6().
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on any failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+int net_lpmadd_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  int plen;
+  int ret;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)&route->netmask,
+                       sizeof(in_addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  ret = lpm_insert(&g_ipv4_trie, (FAR const uint8_t *)&route->target,
+                   plen, route);
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  if (ret >= 0)
+    {
+      /* A more specific route may now apply to cached destinations */
+
+      memset(g_ipv4_dstcache, 0, sizeof(g_ipv4_dstcache));
+    }
+#endif
+
+  return ret;
+}
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+int net_lpmadd_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  int plen;
+  int ret;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)route->netmask,
+                       sizeof(net_ipv6addr_t));
+  if (plen < 0)
+    {
+      return plen;
+    }
+
+  ret = lpm_insert(&g_ipv6_trie, (FAR const uint8_t *)route->target,
+                   plen, route);
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  if (ret >= 0)
+    {
+      /* A more specific route may now apply to cached destinations */
+
+      memset(g_ipv6_dstcache, 0, sizeof(g_ipv6_dstcache));
+    }
+#endif
+
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmdel_ipv4 and net_lpmdel_ipv6
+ *
+ * Description:
+ *   Remove one routing table entry from the prefix trie.
+ *
+ * Input Parameters:
+ *   route - The routing table entry that was added with net_lpmadd_ipv4/6()
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+void net_lpmdel_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  FAR void *removed;
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)&route->netmask,
+                       sizeof(in_addr_t));
+  DEBUGASSERT(plen >= 0);
+
+  removed = lpm_remove(&g_ipv4_trie, (FAR const uint8_t *)&route->target,
+                       plen);
+  DEBUGASSERT(removed == route);
+  UNUSED(removed);
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  memset(g_ipv4_dstcache, 0, sizeof(g_ipv4_dstcache));
+#endif
+}
+#endif
+
+#ifdef HAVE_LPMROUTE_IPv6
+void net_lpmdel_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  FAR void *removed;
+  int plen;
+
+  plen = lpm_prefixlen((FAR const uint8_t *)route->netmask,
+                       sizeof(net_ipv6addr_t));
+  DEBUGASSERT(plen >= 0);
+
+  removed = lpm_remove(&g_ipv6_trie, (FAR const uint8_t *)route->target,
+                       plen);
+  DEBUGASSERT(removed == route);
+  UNUSED(removed);
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  memset(g_ipv6_dstcache, 0, sizeof(g_ipv6_dstcache));
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv4
+ *
+ * Description:
+ *   Return the router of the most specific route to an IPv4 address.
+ *
+ * Input Parameters:
+ *   target - An IPv4 address on a remote network to use in the lookup.
+ *   router - The location to return the router address
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no route to the target.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv4
+int net_lpmroute_ipv4(in_addr_t target, FAR in_addr_t *router)
+{
+  FAR struct net_route_ipv4_s *route;
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  FAR struct lpm_cache_ipv4_s *cache;
+#endif
+
+  net_lock();
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  /* Try the destination cache first */
+
+  cache = &g_ipv4_dstcache[lpm_hash((FAR const uint8_t *)&target,
+                                    sizeof(in_addr_t))];
+  if (cache->route != NULL && net_ipv4addr_cmp(cache->target, target))
+    {
+      route = cache->route;
+    }
+  else
+#endif
+    {
+      route = lpm_lookup(&g_ipv4_trie, (FAR const uint8_t *)&target);
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+      if (route != NULL)
+        {
+          net_ipv4addr_copy(cache->target, target);
+          cache->route = route;
+        }
+#endif
+    }
+
+  if (route != NULL)
+    {
+      net_ipv4addr_copy(*router, route->router);
+    }
+
+  net_unlock();
+  return route != NULL ? OK : -ENOENT;
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lpmroute_ipv6
+ *
+ * Description:
+ *   Return the router of the most specific route to an IPv6 address.
+ *
+ * Input Parameters:
+ *   target - An IPv6 address on a remote network to use in the lookup.
+ *   router - The location to return the router address
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if there is no route to the target.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LPMROUTE_IPv6
+int net_lpmroute_ipv6(const net_ipv6addr_t target, net_ipv6addr_t router)
+{
+  FAR struct net_route_ipv6_s *route;
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  FAR struct lpm_cache_ipv6_s *cache;
+#endif
+
+  net_lock();
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+  /* Try the destination cache first */
+
+  cache = &g_ipv6_dstcache[lpm_hash((FAR const uint8_t *)target,
+                                    sizeof(net_ipv6addr_t))];
+  if (cache->route != NULL && net_ipv6addr_cmp(cache->target, target))
+    {
+      route = cache->route;
+    }
+  else
+#endif
+    {
+      route = lpm_lookup(&g_ipv6_trie, (FAR const uint8_t *)target);
+
+#if CONFIG_ROUTE_LPM_CACHESIZE > 0
+      if (route != NULL)
+        {
+          net_ipv6addr_copy(cache->target, target);
+          cache->route = route;
+        }
+#endif
+    }
+
+  if (route != NULL)
+    {
+      net_ipv6addr_copy(router, route->router);
+    }
+
+  net_unlock();
+  return route != NULL ? OK : -ENOENT;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_LPM */
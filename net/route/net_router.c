@@ -49,6 +49,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/lpmroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -73,7 +74,7 @@
  * Private Types
  ****************************************************************************/
 
-#ifdef CONFIG_NET_IPv4
+#if defined(CONFIG_NET_IPv4) && !defined(HAVE_LPMROUTE_IPv4)
 struct route_ipv4_match_s
 {
   in_addr_t target;              /* Target IPv4 address on remote network */
@@ -85,7 +86,7 @@ struct route_ipv4_match_s
 };
 #endif
 
-#ifdef CONFIG_NET_IPv6
+#if defined(CONFIG_NET_IPv6) && !defined(HAVE_LPMROUTE_IPv6)
 struct route_ipv6_match_s
 {
   net_ipv6addr_t target;         /* Target IPv6 address on remote network */
@@ -116,7 +117,7 @@ struct route_ipv6_match_s
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_IPv4
+#if defined(CONFIG_NET_IPv4) && !defined(HAVE_LPMROUTE_IPv4)
 static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
 {
   FAR struct route_ipv4_match_s *match = (FAR struct route_ipv4_match_s *)arg;
@@ -142,7 +143,7 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
 
   return 0;
 }
-#endif /* CONFIG_NET_IPv4 */
+#endif /* CONFIG_NET_IPv4 && !HAVE_LPMROUTE_IPv4 */
 
 /****************************************************************************
  * Name: net_ipv6_match
@@ -159,7 +160,7 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
  *
  ****************************************************************************/
 
-#ifdef CONFIG_NET_IPv6
+#if defined(CONFIG_NET_IPv6) && !defined(HAVE_LPMROUTE_IPv6)
 static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 {
   FAR struct route_ipv6_match_s *match = (FAR struct route_ipv6_match_s *)arg;
@@ -185,7 +186,7 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 
   return 0;
 }
-#endif /* CONFIG_NET_IPv6 */
+#endif /* CONFIG_NET_IPv6 && !HAVE_LPMROUTE_IPv6 */
 
 /****************************************************************************
  * Public Functions
@@ -211,8 +212,10 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 #ifdef CONFIG_NET_IPv4
 int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 {
+#ifndef HAVE_LPMROUTE_IPv4
   struct route_ipv4_match_s match;
   int ret;
+#endif
 
   /* Do not route the special broadcast IP address */
 
@@ -221,6 +224,11 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
       return -ENOENT;
     }
 
+#ifdef HAVE_LPMROUTE_IPv4
+  /* Look up the most specific route in the prefix trie */
+
+  return net_lpmroute_ipv4(target, router);
+#else
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -263,6 +271,7 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 
   net_ipv4addr_copy(*router, match.IPv4_ROUTER);
   return OK;
+#endif
 }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -286,8 +295,10 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 #ifdef CONFIG_NET_IPv6
 int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
 {
+#ifndef HAVE_LPMROUTE_IPv6
   struct route_ipv6_match_s match;
   int ret;
+#endif
 
   /* Do not route to any the special IPv6 multicast addresses */
 
@@ -296,6 +307,11 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
       return -ENOENT;
     }
 
+#ifdef HAVE_LPMROUTE_IPv6
+  /* Look up the most specific route in the prefix trie */
+
+  return net_lpmroute_ipv6(target, router);
+#else
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
@@ -338,6 +354,7 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
 
   net_ipv6addr_copy(router, match.IPv6_ROUTER);
   return OK;
+#endif
 }
 #endif /* CONFIG_NET_IPv6 */
 
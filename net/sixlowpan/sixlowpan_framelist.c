@@ -647,14 +647,15 @@ int sixlowpan_queue_frames(FAR struct radio_driver_s *radio,
 
           /* Copy the HC1/HC06/IPv6 header the frame header from first
            * frame, into the correct location after the FRAGN header
-           * of subsequent frames.
+           * of subsequent frames.  Only the compressed header is copied;
+           * the payload that follows it is written directly below.
            */
 
           fragptr = fptr + framer_hdrlen;
+          fragn_hdrlen = frag1_hdrlen - SIXLOWPAN_FRAG1_HDR_LEN;
           memcpy(fragptr + SIXLOWPAN_FRAGN_HDR_LEN,
                  frame1 + framer_hdrlen + SIXLOWPAN_FRAG1_HDR_LEN,
-                 frag1_hdrlen - framer_hdrlen);
-          fragn_hdrlen = frag1_hdrlen - SIXLOWPAN_FRAG1_HDR_LEN;
+                 fragn_hdrlen - framer_hdrlen);
 
           /* Setup up the FRAGN header after the frame header. */
 
@@ -725,10 +726,15 @@ int sixlowpan_queue_frames(FAR struct radio_driver_s *radio,
             {
               nerr("ERROR: sixlowpan_frame_submit() failed: %d\n", ret);
             }
+          else
+            {
+              SIXLOWPAN_STATS(txframe);
+            }
         }
 
       /* Update the datagram TAG value */
 
+      SIXLOWPAN_STATS(txfrag);
       reass->rb_dgramtag++;
     }
   else
@@ -767,6 +773,10 @@ int sixlowpan_queue_frames(FAR struct radio_driver_s *radio,
         {
           nerr("ERROR: sixlowpan_frame_submit() failed: %d\n", ret);
         }
+      else
+        {
+          SIXLOWPAN_STATS(txframe);
+        }
     }
 
   return OK;
@@ -309,6 +309,8 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
   g_uncomp_hdrlen = 0;
   g_frame_hdrlen  = hdrsize;
 
+  SIXLOWPAN_STATS(rxframe);
+
   /* Since we don't support the mesh and broadcast header, the first header
    * we look for is the fragmentation header.  NOTE that g_frame_hdrlen
    * already includes the fragmentation header, if presetn.
@@ -369,6 +371,8 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
         radio->r_dev.d_len = 0;
         reass->rb_pktlen   = fragsize;
 
+        SIXLOWPAN_STATS(rxfrag);
+
         /* Indicate the first fragment of the reassembly */
 
         bptr               = reass->rb_buf;
@@ -402,6 +406,7 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
           {
             nerr("ERROR: Failed to find a reassembly buffer for tag=%04x\n",
                  fragtag);
+            SIXLOWPAN_STATS(drop);
             return -ENOENT;
           }
 
@@ -411,10 +416,13 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
 
           nwarn("WARNING: Dropping 6LoWPAN packet.  Bad fragsize: %u vs &u\n",
                 fragsize, reass->rb_pktlen);
+          SIXLOWPAN_STATS(drop);
           ret = -EPERM;
           goto errout_with_reass;
         }
 
+        SIXLOWPAN_STATS(rxfrag);
+
         radio->r_dev.d_buf  = reass->rb_buf;
         radio->r_dev.d_len  = 0;
 
@@ -576,6 +584,11 @@ static int sixlowpan_frame_process(FAR struct radio_driver_s *radio,
     {
       ninfo("IP packet ready (length %d)\n", reass->rb_pktlen);
 
+      if (isfrag)
+        {
+          SIXLOWPAN_STATS(reass);
+        }
+
       radio->r_dev.d_buf  = reass->rb_buf;
       radio->r_dev.d_len  = reass->rb_pktlen;
       reass->rb_active    = false;
@@ -67,6 +67,7 @@
 #include <nuttx/net/tcp.h>
 #include <nuttx/net/udp.h>
 #include <nuttx/net/icmpv6.h>
+#include <nuttx/net/netstats.h>
 #include <nuttx/net/sixlowpan.h>
 #include <nuttx/wireless/pktradio.h>
 
@@ -128,6 +129,14 @@
 #define REASS_POOL_DYNAMIC      1
 #define REASS_POOL_RADIO        2
 
+/* Statistics ***************************************************************/
+
+#ifdef CONFIG_NET_STATISTICS
+#  define SIXLOWPAN_STATS(f) (g_netstats.sixlowpan.f++)
+#else
+#  define SIXLOWPAN_STATS(f)
+#endif
+
 /* Debug ********************************************************************/
 
 #ifdef CONFIG_NET_6LOWPAN_DUMPBUFFER
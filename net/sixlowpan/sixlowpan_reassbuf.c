@@ -54,10 +54,21 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+#if (CONFIG_NET_6LOWPAN_REASS_HASHSIZE & \
+     (CONFIG_NET_6LOWPAN_REASS_HASHSIZE - 1)) != 0
+#  error CONFIG_NET_6LOWPAN_REASS_HASHSIZE must be a power of two
+#endif
+
+#define REASS_HASH_MASK (CONFIG_NET_6LOWPAN_REASS_HASHSIZE - 1)
+
 /* Re-assembly timeout in clock ticks */
 
 #define NET_6LOWPAN_TIMEOUT SEC2TICK(CONFIG_NET_6LOWPAN_MAXAGE)
 
+/* Interval between scans of the whole table for expired buffers */
+
+#define REASS_SCAN_INTERVAL SEC2TICK(1)
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -69,9 +80,16 @@
 
 static FAR struct sixlowpan_reassbuf_s *g_free_reass;
 
-/* This is a list of active, allocated reassemby buffers */
+/* Active, allocated reassembly buffers hashed by reassembly tag and source
+ * address.  Each bucket is a list linked through rb_flink.
+ */
+
+static FAR struct sixlowpan_reassbuf_s *
+              g_active_reass[CONFIG_NET_6LOWPAN_REASS_HASHSIZE];
 
-static FAR struct sixlowpan_reassbuf_s *g_active_reass;
+/* Time of the last scan for expired reassembly buffers */
+
+static clock_t g_reass_scantime;
 
 /* Pool of pre-allocated reassembly buffer structures */
 
@@ -79,9 +97,32 @@ static struct sixlowpan_reassbuf_s
               g_metadata_pool[CONFIG_NET_6LOWPAN_NREASSBUF];
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: sixlowpan_reass_hash
+ *
+ * Description:
+ *   Return the hash bucket of a reassembly tag and source address.
+ *
+ ****************************************************************************/
+
+static unsigned int
+  sixlowpan_reass_hash(uint16_t reasstag,
+                       FAR const struct netdev_varaddr_s *fragsrc)
+{
+  unsigned int hash = reasstag;
+  int i;
+
+  for (i = 0; i < fragsrc->nv_addrlen; i++)
+    {
+      hash = hash * 31 + fragsrc->nv_addr[i];
+    }
+
+  return (hash ^ (hash >> 8)) & REASS_HASH_MASK;
+}
+
 /****************************************************************************
  * Name: sixlowpan_compare_fragsrc
  *
@@ -114,14 +155,46 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
   return false;
 }
 
+/****************************************************************************
+ * Name: sixlowpan_reass_expired
+ *
+ * Description:
+ *   Return true if the reassembly buffer is inactive or has timed out.
+ *
+ ****************************************************************************/
+
+static bool sixlowpan_reass_expired(FAR struct sixlowpan_reassbuf_s *reass,
+                                    clock_t now)
+{
+  /* Inactive reassembly buffers are also reclaimed.  This is done because
+   * the life the reassembly buffer is not cerain.
+   */
+
+  if (!reass->rb_active)
+    {
+      return true;
+    }
+
+  if (now - reass->rb_time >= NET_6LOWPAN_TIMEOUT)
+    {
+      nwarn("WARNING: Reassembly timed out\n");
+      SIXLOWPAN_STATS(timeout);
+      return true;
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Name: sixlowpan_reass_expire
  *
  * Description:
- *   Free all expired or inactive reassembly buffers.
+ *   Free all expired or inactive reassembly buffers.  Unless 'force' is
+ *   true, the table is scanned at most once every REASS_SCAN_INTERVAL;
+ *   lookups check the age of the buffer they find themselves.
  *
  * Input Parameters:
- *   None
+ *   force - Scan the table even if it was scanned recently
  *
  * Returned Value:
  *   None
@@ -131,39 +204,32 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
  *
  ****************************************************************************/
 
-static void sixlowpan_reass_expire(void)
+static void sixlowpan_reass_expire(bool force)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
   FAR struct sixlowpan_reassbuf_s *next;
-  clock_t elapsed;
-
-  /* If reassembly timed out, cancel it */
+  clock_t now;
+  int i;
 
-  for (reass = g_active_reass; reass != NULL; reass = next)
+  now = clock_systime_ticks();
+  if (!force && now - g_reass_scantime < REASS_SCAN_INTERVAL)
     {
-      /* Needed if 'reass' is freed */
+      return;
+    }
 
-      next = reass->rb_flink;
+  g_reass_scantime = now;
 
-      /* Free any inactive reassembly buffers.  This is done because the life
-       * the reassembly buffer is not cerain.
-       */
+  /* If reassembly timed out, cancel it */
 
-      if (!reass->rb_active)
-        {
-          sixlowpan_reass_free(reass);
-        }
-      else
+  for (i = 0; i < CONFIG_NET_6LOWPAN_REASS_HASHSIZE; i++)
+    {
+      for (reass = g_active_reass[i]; reass != NULL; reass = next)
         {
-          /* Get the elpased time of the reassembly */
-
-          elapsed = clock_systime_ticks() - reass->rb_time;
-
-          /* If the reassembly has expired, then free the reassembly buffer */
+          /* Needed if 'reass' is freed */
 
-          if (elapsed >= NET_6LOWPAN_TIMEOUT)
+          next = reass->rb_flink;
+          if (sixlowpan_reass_expired(reass, now))
             {
-              nwarn("WARNING: Reassembly timed out\n");
               sixlowpan_reass_free(reass);
             }
         }
@@ -174,7 +240,7 @@ static void sixlowpan_reass_expire(void)
  * Name: sixlowpan_remove_active
  *
  * Description:
- *   Remove a reassembly buffer from the active reassembly buffer list.
+ *   Remove a reassembly buffer from the active reassembly buffer table.
  *
  * Input Parameters:
  *   reass - The reassembly buffer to be removed.
@@ -191,10 +257,12 @@ static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 {
   FAR struct sixlowpan_reassbuf_s *curr;
   FAR struct sixlowpan_reassbuf_s *prev;
+  unsigned int hash;
 
-  /* Find the reassembly buffer in the list of active reassembly buffers */
+  /* Find the reassembly buffer in its bucket of the active table */
 
-  for (prev = NULL, curr = g_active_reass;
+  hash = sixlowpan_reass_hash(reass->rb_reasstag, &reass->rb_fragsrc);
+  for (prev = NULL, curr = g_active_reass[hash];
        curr != NULL && curr != reass;
        prev = curr, curr = curr->rb_flink)
     {
@@ -204,11 +272,11 @@ static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 
   if (curr != NULL)
     {
-      /* Yes.. remove it from the active reassembly buffer list */
+      /* Yes.. remove it from the active reassembly buffer table */
 
       if (prev == NULL)
         {
-          g_active_reass = reass->rb_flink;
+          g_active_reass[hash] = reass->rb_flink;
         }
       else
         {
@@ -294,13 +362,14 @@ FAR struct sixlowpan_reassbuf_s *
                            FAR const struct netdev_varaddr_s *fragsrc)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
+  unsigned int hash;
   uint8_t pool;
 
   /* First, removed any expired or inactive reassembly buffers.  This might
    * free up a pre-allocated buffer for this allocation.
    */
 
-  sixlowpan_reass_expire();
+  sixlowpan_reass_expire(g_free_reass == NULL);
 
   /* Now, try the free list first */
 
@@ -338,10 +407,17 @@ FAR struct sixlowpan_reassbuf_s *
       reass->rb_reasstag = reasstag;
       reass->rb_time     = clock_systime_ticks();
 
-      /* Add the reassembly buffer to the list of active reassembly buffers */
+      /* Add the reassembly buffer to the table of active reassembly
+       * buffers.
+       */
 
-      reass->rb_flink   = g_active_reass;
-      g_active_reass    = reass;
+      hash                 = sixlowpan_reass_hash(reasstag, fragsrc);
+      reass->rb_flink      = g_active_reass[hash];
+      g_active_reass[hash] = reass;
+    }
+  else
+    {
+      SIXLOWPAN_STATS(drop);
     }
 
   return reass;
@@ -372,26 +448,35 @@ FAR struct sixlowpan_reassbuf_s *
 {
   FAR struct sixlowpan_reassbuf_s *reass;
 
-  /* First, removed any expired or inactive reassembly buffers (we don't want
-   * to return old reassembly buffer with the same tag)
-   */
+  /* First, removed any expired or inactive reassembly buffers */
 
-  sixlowpan_reass_expire();
+  sixlowpan_reass_expire(false);
 
-  /* Now search for the matching reassembly buffer in the remainng, active
-   * reassembly buffers.
+  /* Now search for the matching reassembly buffer in the bucket of the
+   * active reassembly buffers.
    */
 
-  for (reass = g_active_reass; reass != NULL; reass = reass->rb_flink)
+  reass = g_active_reass[sixlowpan_reass_hash(reasstag, fragsrc)];
+  for (; reass != NULL; reass = reass->rb_flink)
     {
       /* In order to be a match, it must have the same reassembly tag as
        * well as source address (different sources might use the same
        * reassembly tag).
        */
 
-      if (reass->rb_reasstag == reasstag &&
+      if (reass->rb_active && reass->rb_reasstag == reasstag &&
           sixlowpan_compare_fragsrc(reass, fragsrc))
         {
+          /* We don't want to return an old reassembly buffer with the same
+           * tag.
+           */
+
+          if (sixlowpan_reass_expired(reass, clock_systime_ticks()))
+            {
+              sixlowpan_reass_free(reass);
+              break;
+            }
+
           return reass;
         }
     }
@@ -423,11 +508,15 @@ FAR struct sixlowpan_reassbuf_s *
 
 void sixlowpan_reass_free(FAR struct sixlowpan_reassbuf_s *reass)
 {
-  /* First, remove the reassembly buffer from the list of active reassembly
-   * buffers.
+  /* First, remove the reassembly buffer from the table of active
+   * reassembly buffers.  Buffers provided by the radio are never in the
+   * table.
    */
 
-  sixlowpan_remove_active(reass);
+  if (reass->rb_pool != REASS_POOL_RADIO)
+    {
+      sixlowpan_remove_active(reass);
+    }
 
   /* If this is a pre-allocated reassembly buffer structure, then just put it
    * back in the free list.
@@ -0,0 +1,167 @@
+/****************************************************************************
+ * net/socket/recvmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives a message into the buffers described by a
+ *   msghdr structure.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   Address families that do not provide their own recvmsg() method can
+ *   only receive into a single buffer and return no control data.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - Describes the buffers to receive the message
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly
+ *   shutdown, zero is returned.  Otherwise, on any failure, a negated errno
+ *   value is returned (see comments with recvfrom() for a list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  ssize_t ret;
+
+  /* Verify that non-NULL pointers were passed */
+
+  if (msg == NULL || (msg->msg_iovlen > 0 && msg->msg_iov == NULL))
+    {
+      return -EINVAL;
+    }
+
+  /* Verify that the psock corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      nerr("ERROR: Invalid socket\n");
+      return -EBADF;
+    }
+
+  /* Let the address family's recvmsg() method handle the operation */
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+  if (psock->s_sockif->si_recvmsg != NULL)
+    {
+      return psock->s_sockif->si_recvmsg(psock, msg, flags);
+    }
+
+  /* Otherwise, fall back to recvfrom() */
+
+  if (msg->msg_iovlen != 1)
+    {
+      return -ENOTSUP;
+    }
+
+  ret = psock_recvfrom(psock, msg->msg_iov->iov_base,
+                       msg->msg_iov->iov_len, flags, msg->msg_name,
+                       (FAR socklen_t *)&msg->msg_namelen);
+  if (ret >= 0)
+    {
+      msg->msg_controllen = 0;
+      msg->msg_flags      = 0;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: recvmsg
+ *
+ * Description:
+ *   The recvmsg() call receives a message into the buffers described by
+ *   the I/O vector of 'msg'.  The address of the sender and any control
+ *   data provided by the address family are returned in 'msg' as well.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - Describes the buffers to receive the message
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error, -1
+ *   is returned, and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* recvmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_recvmsg() do all of the work */
+
+  ret = psock_recvmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -56,6 +56,7 @@
 #include "tcp/tcp.h"
 #include "udp/udp.h"
 #include "usrsock/usrsock.h"
+#include "pkt/pkt.h"
 #include "utils/utils.h"
 
 /****************************************************************************
@@ -399,6 +400,12 @@ int psock_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_PKT_RING
+      case SOL_PACKET: /* Packet socket options (see include/netpacket/packet.h) */
+        ret = pkt_setsockopt(psock, option, value, value_len);
+        break;
+#endif
+
       default:         /* The provided level is invalid */
         ret = -EINVAL;
         break;
@@ -0,0 +1,193 @@
+/****************************************************************************
+ * net/socket/socketpair.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_socketpair
+ *
+ * Description:
+ *   Create an unnamed pair of connected sockets.  This is the internal OS
+ *   interface of socketpair().
+ *
+ * Input Parameters:
+ *   domain   (see sys/socket.h)
+ *   type     (see sys/socket.h)
+ *   protocol (see sys/socket.h)
+ *   psocks   Two user allocated socket structures to be initialized.
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success.  On failure, it returns a negated errno
+ *   value to indicate the nature of the error (see psock_socket()).  In
+ *   addition:
+ *
+ *   EAFNOSUPPORT
+ *     The specified address family does not support socket pairs.
+ *   EOPNOTSUPP
+ *     The specified socket type does not support socket pairs.
+ *
+ ****************************************************************************/
+
+int psock_socketpair(int domain, int type, int protocol,
+                     FAR struct socket *psocks[2])
+{
+  int ret;
+
+  if (domain != PF_LOCAL)
+    {
+      return -EAFNOSUPPORT;
+    }
+
+  ret = psock_socket(domain, type, protocol, psocks[0]);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = psock_socket(domain, type, protocol, psocks[1]);
+  if (ret < 0)
+    {
+      psock_close(psocks[0]);
+      return ret;
+    }
+
+#ifdef CONFIG_NET_LOCAL
+  ret = local_socketpair(psocks[0], psocks[1]);
+#else
+  ret = -EAFNOSUPPORT;
+#endif
+
+  if (ret < 0)
+    {
+      psock_close(psocks[1]);
+      psock_close(psocks[0]);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: socketpair
+ *
+ * Description:
+ *   socketpair() creates an unnamed pair of connected sockets and returns
+ *   their descriptors in sv[0] and sv[1].  The two sockets are
+ *   indistinguishable.  Only Unix domain stream sockets are supported.
+ *
+ * Input Parameters:
+ *   domain   (see sys/socket.h)
+ *   type     (see sys/socket.h)
+ *   protocol (see sys/socket.h)
+ *   sv       The location to return the two socket descriptors
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -1 on error with errno set appropriately (see
+ *   psock_socketpair()).
+ *
+ ****************************************************************************/
+
+int socketpair(int domain, int type, int protocol, int sv[2])
+{
+  FAR struct socket *psocks[2];
+  int errcode;
+  int ret;
+
+  if (sv == NULL)
+    {
+      errcode = EFAULT;
+      goto errout;
+    }
+
+  /* Allocate the two socket descriptors */
+
+  sv[0] = sockfd_allocate(0);
+  if (sv[0] < 0)
+    {
+      nerr("ERROR: Failed to allocate a socket descriptor\n");
+      errcode = ENFILE;
+      goto errout;
+    }
+
+  sv[1] = sockfd_allocate(0);
+  if (sv[1] < 0)
+    {
+      nerr("ERROR: Failed to allocate a socket descriptor\n");
+      errcode = ENFILE;
+      goto errout_with_sv0;
+    }
+
+  /* Get the underlying socket structures */
+
+  psocks[0] = sockfd_socket(sv[0]);
+  psocks[1] = sockfd_socket(sv[1]);
+  if (psocks[0] == NULL || psocks[1] == NULL)
+    {
+      errcode = ENOSYS; /* should not happen */
+      goto errout_with_sv1;
+    }
+
+  /* Initialize and connect the socket structures */
+
+  ret = psock_socketpair(domain, type, protocol, psocks);
+  if (ret < 0)
+    {
+      nerr("ERROR: psock_socketpair() failed: %d\n", ret);
+      errcode = -ret;
+      goto errout_with_sv1;
+    }
+
+  /* The sockets have been successfully initialized */
+
+  psocks[0]->s_flags |= _SF_INITD;
+  psocks[1]->s_flags |= _SF_INITD;
+  return OK;
+
+errout_with_sv1:
+  sockfd_release(sv[1]);
+
+errout_with_sv0:
+  sockfd_release(sv[0]);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+}
+
+#endif /* CONFIG_NET */
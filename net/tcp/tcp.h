@@ -48,6 +48,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
 
 #ifdef CONFIG_NET_TCP_NOTIFIER
 #  include <nuttx/wqueue.h>
@@ -164,6 +165,23 @@ struct tcp_conn_s
 
   FAR struct devif_callback_s *list;
 
+#ifdef CONFIG_NET_TXREADY
+  /* Link in the TX-ready list of a device while output is pending */
+
+  struct devif_txready_s txready;
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  /* Link in the timer wheel of the device while a timer is running.  The
+   * timer state (timer, rx_acktimer) is current as of device tick ttick.
+   */
+
+  dq_entry_t tnode;       /* Link in a timer wheel slot or in d_tcpdue */
+  FAR dq_queue_t *tqueue; /* The queue that tnode is on, NULL if none */
+  uint32_t   texpiry;     /* Device tick at which tcp_timer() is due */
+  uint32_t   ttick;       /* Device tick of the last timer update */
+#endif
+
   /* TCP-specific content follows */
 
   union ip_binding_u u;   /* IP address binding */
@@ -814,6 +832,149 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn);
 void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                int hsec);
 
+/****************************************************************************
+ * Name: tcp_timer_sync
+ *
+ * Description:
+ *   Bring the timer state of a connection on the timer wheel up to the
+ *   current tick of its device.  No timer is allowed to expire here; one
+ *   that would is left for the next tcp_timer() visit.  This must be done
+ *   before the state of the connection is changed.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_sync(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_arm
+ *
+ * Description:
+ *   Queue a connection on the timer wheel of its device for the tick at
+ *   which tcp_timer() has to see it next, or remove it from the wheel if
+ *   no timer is running.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_arm(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_kick
+ *
+ * Description:
+ *   Bring the timer state of a connection up to date and have the next
+ *   tick of its device visit it.  This is used where the state of the
+ *   connection may change in many ways, as on packet input; the visit
+ *   re-arms the timer exactly.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_kick(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_cancel
+ *
+ * Description:
+ *   Remove a connection from the timer wheel.  This must be done before
+ *   the connection is freed.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_cancel(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_advance
+ *
+ * Description:
+ *   Advance the timer wheel of a device and move the connections whose
+ *   timer has become due to its due list.
+ *
+ * Input Parameters:
+ *   dev  - The network device
+ *   hsec - The elapsed time in halves of a second
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_advance(FAR struct net_driver_s *dev, int hsec);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_due
+ *
+ * Description:
+ *   Take the next connection from the due list of a device.
+ *
+ * Input Parameters:
+ *   dev  - The network device
+ *   hsec - Location to return the time, in halves of a second, to pass to
+ *          tcp_timer() for the connection
+ *
+ * Returned Value:
+ *   The due connection, or NULL if there is none.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+FAR struct tcp_conn_s *tcp_timer_due(FAR struct net_driver_s *dev,
+                                     FAR int *hsec);
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_flush
+ *
+ * Description:
+ *   Empty the timer wheel of a device that is going away.
+ *
+ * Input Parameters:
+ *   dev - The network device being unregistered
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_flush(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: tcp_listen_initialize
  *
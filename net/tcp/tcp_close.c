@@ -190,6 +190,15 @@ end_wait:
 static inline void tcp_close_txnotify(FAR struct socket *psock,
                                       FAR struct tcp_conn_s *conn)
 {
+#ifdef CONFIG_NET_TXREADY
+  /* Have the next TX poll of the device offer it to this connection */
+
+  if (conn->dev != NULL)
+    {
+      devif_txready(conn->dev, &conn->txready);
+    }
+#endif
+
 #ifdef CONFIG_NET_IPv4
 #ifdef CONFIG_NET_IPv6
   /* If both IPv4 and IPv6 support are enabled, then we will need to select
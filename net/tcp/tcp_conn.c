@@ -725,6 +725,9 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
     {
       memset(conn, 0, sizeof(struct tcp_conn_s));
       conn->tcpstateflags = TCP_ALLOCATED;
+#ifdef CONFIG_NET_TXREADY
+      conn->txready.proto = IP_PROTO_TCP;
+#endif
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       conn->domain        = domain;
 #endif
@@ -774,6 +777,18 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       tcp_callback_free(conn, cb);
     }
 
+#ifdef CONFIG_NET_TXREADY
+  /* Make sure that no device will poll the connection */
+
+  devif_txready_remove(&conn->txready);
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  /* Make sure that no timer will visit the connection */
+
+  tcp_timer_cancel(conn);
+#endif
+
   /* TCP_ALLOCATED means that that the connection is not in the active list
    * yet.
    */
@@ -1044,6 +1059,12 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        */
 
       dq_addlast(&conn->node, &g_active_tcp_connections);
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+      /* Start the SYN-ACK retransmission timer */
+
+      tcp_timer_arm(conn);
+#endif
     }
 
   return conn;
@@ -1309,6 +1330,13 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   /* And, finally, put the connection structure into the active list. */
 
   dq_addlast(&conn->node, &g_active_tcp_connections);
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  /* The SYN is sent when the timer expires */
+
+  tcp_timer_arm(conn);
+#endif
+
   ret = OK;
 
 errout_with_lock:
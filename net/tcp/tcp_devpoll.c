@@ -120,6 +120,12 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
 #else /* if defined(CONFIG_NET_IPv6) */
           tcp_ipv6_select(dev);
 #endif
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+          /* Sending may start the retransmission timer */
+
+          tcp_timer_sync(conn);
+#endif
+
           /* Perform the callback */
 
           result = tcp_callback(dev, conn, TCP_POLL);
@@ -127,6 +133,10 @@ void tcp_poll(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
           /* Handle the callback response */
 
           tcp_appsend(dev, conn, result);
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+          tcp_timer_arm(conn);
+#endif
         }
     }
 }
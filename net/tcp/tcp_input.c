@@ -323,10 +323,30 @@ reset:
 
 found:
 
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  /* The packet may change the timers of the connection in many ways.
+   * Bring them up to date before it does and have the next tick re-arm
+   * them.
+   */
+
+  tcp_timer_kick(conn);
+#endif
+
   /* Update the connection's window size */
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TXREADY
+  /* An ACK may have opened the window or freed up unacknowledged data.
+   * Have the next TX poll offer the connection a chance to send more.
+   */
+
+  if ((tcp->flags & TCP_ACK) != 0 && conn->dev == dev)
+    {
+      devif_txready(dev, &conn->txready);
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -257,6 +257,17 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
         break;
     }
 
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+  /* The keep-alive settings decide when the next probe is due */
+
+  if (ret == OK)
+    {
+      net_lock();
+      tcp_timer_arm(conn);
+      net_unlock();
+    }
+#endif
+
   return ret;
 #else
   return -ENOPROTOOPT;
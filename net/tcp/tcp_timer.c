@@ -47,9 +47,12 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TCP)
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
+#include <nuttx/clock.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
@@ -74,6 +77,161 @@
 
 #define ACK_DELAY (1)
 
+/* The timer wheel slot of a device tick */
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+#  define TCP_WHEEL_SLOT(tick) ((tick) % CONFIG_NET_TCP_TIMERWHEEL_SLOTS)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_timer_dequeue
+ *
+ * Description:
+ *   Remove a connection from the timer wheel slot or due list that it is
+ *   on, if any.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+static void tcp_timer_dequeue(FAR struct tcp_conn_s *conn)
+{
+  if (conn->tqueue != NULL)
+    {
+      dq_rem(&conn->tnode, conn->tqueue);
+      conn->tqueue = NULL;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_enqueue
+ *
+ * Description:
+ *   Queue a connection on the timer wheel of its device for the given
+ *   device tick.  A tick that is not in the future is served by the next
+ *   one.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+static void tcp_timer_enqueue(FAR struct tcp_conn_s *conn, uint32_t expiry)
+{
+  FAR struct net_driver_s *dev = conn->dev;
+  FAR dq_queue_t *queue;
+
+  tcp_timer_dequeue(conn);
+
+  if ((int32_t)(expiry - dev->d_tcptick) <= 0)
+    {
+      expiry = dev->d_tcptick + 1;
+    }
+
+  queue = &dev->d_tcpwheel[TCP_WHEEL_SLOT(expiry)];
+  dq_addlast(&conn->tnode, queue);
+
+  conn->tqueue  = queue;
+  conn->texpiry = expiry;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_flushqueue
+ *
+ * Description:
+ *   Remove all connections from a timer wheel slot or due list.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+static void tcp_timer_flushqueue(FAR dq_queue_t *queue)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+
+  while ((entry = dq_remfirst(queue)) != NULL)
+    {
+      conn         = container_of(entry, struct tcp_conn_s, tnode);
+      conn->tqueue = NULL;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_keepdelay
+ *
+ * Description:
+ *   Return the number of half-seconds until the next keep-alive probe of
+ *   a connection is due, at least one.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_TIMERWHEEL) && defined(CONFIG_NET_TCP_KEEPALIVE)
+static uint32_t tcp_timer_keepdelay(FAR struct tcp_conn_s *conn)
+{
+  clock_t timeo;
+  clock_t elapsed;
+
+  /* This follows the net_timeo() test in tcp_timer() */
+
+  if (conn->keepretries > 0)
+    {
+      timeo = DSEC2TICK(conn->keepintvl);
+    }
+  else
+    {
+      timeo = DSEC2TICK(conn->keepidle);
+    }
+
+  elapsed = clock_systime_ticks() - conn->keeptime;
+  if (elapsed >= timeo)
+    {
+      return 1;
+    }
+
+  return (timeo - elapsed + TICK_PER_HSEC - 1) / TICK_PER_HSEC;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_pollwanted
+ *
+ * Description:
+ *   With CONFIG_NET_TXREADY, devif_poll() serves only the connections that
+ *   queued themselves as ready.  One that still has output waiting, e.g.
+ *   for the peer to open its window, is polled by its timer each tick as
+ *   it would be without the timer wheel.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_TCP_TIMERWHEEL) && defined(CONFIG_NET_TXREADY)
+static bool tcp_timer_pollwanted(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  /* The send callback of a buffered socket asks for TCP_POLL for the life
+   * of the socket.  Only queued data means that there is something to do.
+   */
+
+  return !sq_empty(&conn->write_q);
+#else
+  FAR struct devif_callback_s *cb;
+
+  for (cb = conn->list; cb != NULL; cb = cb->nxtconn)
+    {
+      if ((cb->flags & TCP_POLL) != 0)
+        {
+          return true;
+        }
+    }
+
+  return false;
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -537,4 +695,351 @@ done:
   return;
 }
 
+/****************************************************************************
+ * Name: tcp_timer_sync
+ *
+ * Description:
+ *   Bring the timer state of a connection on the timer wheel up to the
+ *   current tick of its device.  No timer is allowed to expire here; one
+ *   that would is left for the next tcp_timer() visit.  This must be done
+ *   before the state of the connection is changed.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_sync(FAR struct tcp_conn_s *conn)
+{
+  unsigned int elapsed;
+
+  if (conn->dev == NULL)
+    {
+      return;
+    }
+
+  elapsed     = conn->dev->d_tcptick - conn->ttick;
+  conn->ttick = conn->dev->d_tcptick;
+
+  /* A connection that is not on the wheel has no timer running */
+
+  if (conn->tqueue == NULL || elapsed == 0)
+    {
+      return;
+    }
+
+  /* Advance the timers as tcp_timer() does, but stop short of expiry.
+   * The delayed ACK timer is not advanced; a delayed ACK is always due at
+   * the next tick.  The keep-alive timer runs on the system clock.
+   */
+
+  if (conn->tcpstateflags == TCP_TIME_WAIT ||
+      conn->tcpstateflags == TCP_FIN_WAIT_2)
+    {
+      unsigned int newtimer = (unsigned int)conn->timer + elapsed;
+
+      if (newtimer >= (TCP_TIME_WAIT_TIMEOUT * HSEC_PER_SEC))
+        {
+          newtimer = TCP_TIME_WAIT_TIMEOUT * HSEC_PER_SEC - 1;
+        }
+
+      conn->timer = newtimer;
+    }
+  else if (conn->tcpstateflags != TCP_CLOSED && conn->tx_unacked > 0)
+    {
+      if (conn->timer > elapsed)
+        {
+          conn->timer -= elapsed;
+        }
+      else if (conn->timer > 1)
+        {
+          conn->timer = 1;
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_arm
+ *
+ * Description:
+ *   Queue a connection on the timer wheel of its device for the tick at
+ *   which tcp_timer() has to see it next, or remove it from the wheel if
+ *   no timer is running.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_arm(FAR struct tcp_conn_s *conn)
+{
+  uint32_t delay = 0;
+
+  if (conn->dev == NULL)
+    {
+      tcp_timer_dequeue(conn);
+      return;
+    }
+
+  tcp_timer_sync(conn);
+
+  /* Find the number of ticks until tcp_timer() has something to do, in
+   * the same order as tcp_timer() checks for it.  Zero means never.
+   */
+
+  if (conn->tcpstateflags == TCP_TIME_WAIT ||
+      conn->tcpstateflags == TCP_FIN_WAIT_2)
+    {
+      delay = TCP_TIME_WAIT_TIMEOUT * HSEC_PER_SEC - conn->timer;
+      if (delay == 0)
+        {
+          delay = 1;
+        }
+    }
+  else if (conn->tcpstateflags != TCP_CLOSED)
+    {
+      if (conn->tx_unacked > 0)
+        {
+          delay = conn->timer > 0 ? conn->timer : 1;
+        }
+      else if ((conn->tcpstateflags & TCP_STATE_MASK) == TCP_ESTABLISHED)
+        {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
+          if (conn->keepalive)
+            {
+              delay = tcp_timer_keepdelay(conn);
+            }
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+          if (conn->rx_unackseg > 0)
+            {
+              delay = ACK_DELAY;
+            }
+#endif
+
+#ifdef CONFIG_NET_TXREADY
+          if (tcp_timer_pollwanted(conn))
+            {
+              delay = 1;
+            }
+#endif
+        }
+    }
+
+  if (delay == 0)
+    {
+      tcp_timer_dequeue(conn);
+    }
+  else
+    {
+      tcp_timer_enqueue(conn, conn->ttick + delay);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_kick
+ *
+ * Description:
+ *   Bring the timer state of a connection up to date and have the next
+ *   tick of its device visit it.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_kick(FAR struct tcp_conn_s *conn)
+{
+  if (conn->dev != NULL)
+    {
+      tcp_timer_sync(conn);
+      tcp_timer_enqueue(conn, conn->ttick + 1);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_cancel
+ *
+ * Description:
+ *   Remove a connection from the timer wheel.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_cancel(FAR struct tcp_conn_s *conn)
+{
+  tcp_timer_dequeue(conn);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_advance
+ *
+ * Description:
+ *   Advance the timer wheel of a device and move the connections whose
+ *   timer has become due to its due list.
+ *
+ * Input Parameters:
+ *   dev  - The network device
+ *   hsec - The elapsed time in halves of a second
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_advance(FAR struct net_driver_s *dev, int hsec)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+  FAR dq_entry_t *next;
+  FAR dq_queue_t *slot;
+  uint32_t tick;
+  int nslots;
+
+  if (hsec <= 0)
+    {
+      return;
+    }
+
+  /* Visit the slot of each tick that has passed, but each slot only once.
+   * A slot also holds timers for later turns of the wheel; leave those.
+   */
+
+  tick   = dev->d_tcptick;
+  nslots = hsec < CONFIG_NET_TCP_TIMERWHEEL_SLOTS ?
+           hsec : CONFIG_NET_TCP_TIMERWHEEL_SLOTS;
+
+  dev->d_tcptick += hsec;
+
+  while (nslots-- > 0)
+    {
+      slot = &dev->d_tcpwheel[TCP_WHEEL_SLOT(++tick)];
+
+      for (entry = dq_peek(slot); entry != NULL; entry = next)
+        {
+          next = dq_next(entry);
+          conn = container_of(entry, struct tcp_conn_s, tnode);
+
+          if ((int32_t)(conn->texpiry - dev->d_tcptick) <= 0)
+            {
+              dq_rem(entry, slot);
+              dq_addlast(entry, &dev->d_tcpdue);
+              conn->tqueue = &dev->d_tcpdue;
+            }
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_due
+ *
+ * Description:
+ *   Take the next connection from the due list of a device.
+ *
+ * Input Parameters:
+ *   dev  - The network device
+ *   hsec - Location to return the time, in halves of a second, to pass to
+ *          tcp_timer() for the connection
+ *
+ * Returned Value:
+ *   The due connection, or NULL if there is none.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+FAR struct tcp_conn_s *tcp_timer_due(FAR struct net_driver_s *dev,
+                                     FAR int *hsec)
+{
+  FAR struct tcp_conn_s *conn;
+  FAR dq_entry_t *entry;
+
+  entry = dq_remfirst(&dev->d_tcpdue);
+  if (entry == NULL)
+    {
+      return NULL;
+    }
+
+  conn         = container_of(entry, struct tcp_conn_s, tnode);
+  conn->tqueue = NULL;
+
+  *hsec        = (int)(dev->d_tcptick - conn->ttick);
+  conn->ttick  = dev->d_tcptick;
+  return conn;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_timer_flush
+ *
+ * Description:
+ *   Empty the timer wheel of a device that is going away.
+ *
+ * Input Parameters:
+ *   dev - The network device being unregistered
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMERWHEEL
+void tcp_timer_flush(FAR struct net_driver_s *dev)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NET_TCP_TIMERWHEEL_SLOTS; i++)
+    {
+      tcp_timer_flushqueue(&dev->d_tcpwheel[i]);
+    }
+
+  tcp_timer_flushqueue(&dev->d_tcpdue);
+}
+#endif
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
@@ -47,6 +47,7 @@
 #include <queue.h>
 
 #include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
 #include <nuttx/mm/iob.h>
 
 #ifdef CONFIG_NET_UDP_NOTIFIER
@@ -109,6 +110,24 @@ struct udp_poll_s
   FAR struct devif_callback_s *cb; /* Needed to teardown the poll */
 };
 
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+/* One multicast group joined by a UDP socket.  In MCAST_INCLUDE mode only
+ * packets from the listed sources are received; in MCAST_EXCLUDE mode
+ * packets from all but the listed sources are received.
+ */
+
+struct udp_mship_s
+{
+  FAR struct udp_mship_s *flink;   /* Supports a singly linked list */
+  union ip_addr_u group;           /* Group address */
+  uint8_t domain;                  /* PF_INET or PF_INET6 */
+  uint8_t ifindex;                 /* Interface the group was joined on */
+  uint8_t fmode;                   /* MCAST_INCLUDE or MCAST_EXCLUDE */
+  uint8_t nsources;                /* Number of sources in the list */
+  union ip_addr_u sources[CONFIG_NET_UDP_MCAST_NSOURCES];
+};
+#endif
+
 struct udp_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -121,6 +140,12 @@ struct udp_conn_s
 
   FAR struct devif_callback_s *list;
 
+#ifdef CONFIG_NET_TXREADY
+  /* Link in the TX-ready list of a device while output is pending */
+
+  struct devif_txready_s txready;
+#endif
+
   /* UDP-specific content follows */
 
   union ip_binding_u u;   /* IP address binding */
@@ -144,6 +169,12 @@ struct udp_conn_s
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
 
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+  /* Multicast groups joined through this socket */
+
+  FAR struct udp_mship_s *mships;
+#endif
+
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   /* Write buffering
    *
@@ -224,6 +255,111 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain);
 
 void udp_free(FAR struct udp_conn_s *conn);
 
+/****************************************************************************
+ * Name: udp_mcast_join
+ *
+ * Description:
+ *   Join a multicast group on a UDP socket.  With a NULL 'source' the
+ *   group is joined for all sources; otherwise 'source' is added to the
+ *   sources the group is received from.  The device joins the group when
+ *   the socket first joins it.
+ *
+ * Input Parameters:
+ *   conn   - The UDP connection
+ *   dev    - The device to join the group on
+ *   domain - PF_INET or PF_INET6
+ *   group  - The group address
+ *   source - The source address or NULL
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+int udp_mcast_join(FAR struct udp_conn_s *conn,
+                   FAR struct net_driver_s *dev, uint8_t domain,
+                   FAR const union ip_addr_u *group,
+                   FAR const union ip_addr_u *source);
+#endif
+
+/****************************************************************************
+ * Name: udp_mcast_leave
+ *
+ * Description:
+ *   Undo udp_mcast_join().  The device leaves the group when the socket no
+ *   longer receives it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+int udp_mcast_leave(FAR struct udp_conn_s *conn,
+                    FAR struct net_driver_s *dev, uint8_t domain,
+                    FAR const union ip_addr_u *group,
+                    FAR const union ip_addr_u *source);
+#endif
+
+/****************************************************************************
+ * Name: udp_mcast_block
+ *
+ * Description:
+ *   Block or unblock a source of a group that the socket has joined for
+ *   all sources.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+int udp_mcast_block(FAR struct udp_conn_s *conn,
+                    FAR struct net_driver_s *dev, uint8_t domain,
+                    FAR const union ip_addr_u *group,
+                    FAR const union ip_addr_u *source, bool block);
+#endif
+
+/****************************************************************************
+ * Name: udp_mcast_leaveall
+ *
+ * Description:
+ *   Leave all of the groups joined through a UDP socket.  Called when the
+ *   socket is closed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+void udp_mcast_leaveall(FAR struct udp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: udp_mcast_accept
+ *
+ * Description:
+ *   Check if a multicast packet from 'source' to 'group' received on 'dev'
+ *   should be delivered to a UDP connection.  A socket that has not joined
+ *   any group receives all multicast packets to its port; a socket that
+ *   has joined groups receives only those groups, filtered by source.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+bool udp_mcast_accept(FAR struct udp_conn_s *conn,
+                      FAR struct net_driver_s *dev, uint8_t domain,
+                      FAR const void *group, FAR const void *source);
+#endif
+
 /****************************************************************************
  * Name: udp_active
  *
@@ -127,6 +127,12 @@ int udp_close(FAR struct socket *psock)
     }
 #endif
 
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+  /* Leave the multicast groups joined through the socket */
+
+  udp_mcast_leaveall(conn);
+#endif
+
   /* And free the connection structure */
 
   conn->crefs = 0;
@@ -74,6 +74,24 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/* Check the multicast memberships of a connection.  Packets that are not
+ * multicast always pass.
+ */
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+#  define UDP_IPv4_MCAST_ACCEPT(conn,dev,ip) \
+     (!IN_MULTICAST(NTOHL(net_ip4addr_conv32((ip)->destipaddr))) || \
+      udp_mcast_accept(conn, dev, PF_INET, (ip)->destipaddr, \
+                       (ip)->srcipaddr))
+#  define UDP_IPv6_MCAST_ACCEPT(conn,dev,ip) \
+     (!net_is_addr_mcast((ip)->destipaddr) || \
+      udp_mcast_accept(conn, dev, PF_INET6, (ip)->destipaddr, \
+                       (ip)->srcipaddr))
+#else
+#  define UDP_IPv4_MCAST_ACCEPT(conn,dev,ip) true
+#  define UDP_IPv6_MCAST_ACCEPT(conn,dev,ip) true
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -328,7 +346,13 @@ static inline FAR struct udp_conn_s *
            */
 
           (net_ipv4addr_cmp(conn->u.ipv4.laddr, INADDR_ANY) ||
-           net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)))
+           net_ipv4addr_hdrcmp(ip->destipaddr, &conn->u.ipv4.laddr)) &&
+
+          /* A multicast packet must be for a group that the socket has
+           * joined and from a source that it accepts.
+           */
+
+          UDP_IPv4_MCAST_ACCEPT(conn, dev, ip))
         {
           /* Check if the socket is connection mode.  In this case, only
            * packets with source addresses from the connected remote peer
@@ -467,7 +491,13 @@ static inline FAR struct udp_conn_s *
            */
 
           (net_ipv6addr_cmp(conn->u.ipv6.laddr, g_ipv6_unspecaddr) ||
-           net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr))))
+           net_ipv6addr_hdrcmp(ip->destipaddr, conn->u.ipv6.laddr)) &&
+
+          /* A multicast packet must be for a group that the socket has
+           * joined and from a source that it accepts.
+           */
+
+          UDP_IPv6_MCAST_ACCEPT(conn, dev, ip)))
         {
           /* Check if the socket is connection mode.  In this case, only
            * packets with source addresses from the connected remote peer
@@ -585,6 +615,12 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
 #endif
       conn->lport   = 0;
       conn->ttl     = IP_TTL;
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+      conn->mships  = NULL;
+#endif
+#ifdef CONFIG_NET_TXREADY
+      conn->txready.proto = IP_PROTO_UDP;
+#endif
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
       /* Initialize the write buffer lists */
@@ -626,6 +662,12 @@ void udp_free(FAR struct udp_conn_s *conn)
 
   dq_rem(&conn->node, &g_active_udp_connections);
 
+#ifdef CONFIG_NET_TXREADY
+  /* Make sure that no device will poll the connection */
+
+  devif_txready_remove(&conn->txready);
+#endif
+
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_queue(&conn->readahead, IOBUSER_NET_UDP_READAHEAD);
@@ -0,0 +1,505 @@
+/****************************************************************************
+ * net/udp/udp_mcast.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+
+#include "netdev/netdev.h"
+#include "igmp/igmp.h"
+#include "mld/mld.h"
+#include "udp/udp.h"
+
+#ifdef CONFIG_NET_UDP_MCASTFILTER
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: udp_mcast_addrcmp
+ *
+ * Description:
+ *   Compare two addresses of the given domain.
+ *
+ ****************************************************************************/
+
+static bool udp_mcast_addrcmp(uint8_t domain, FAR const void *addr1,
+                              FAR const void *addr2)
+{
+#ifdef CONFIG_NET_IPv4
+  if (domain == PF_INET)
+    {
+      return memcmp(addr1, addr2, sizeof(in_addr_t)) == 0;
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (domain == PF_INET6)
+    {
+      return memcmp(addr1, addr2, sizeof(net_ipv6addr_t)) == 0;
+    }
+#endif
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: udp_mcast_find
+ *
+ * Description:
+ *   Find the membership of a UDP connection in a group.
+ *
+ ****************************************************************************/
+
+static FAR struct udp_mship_s *
+  udp_mcast_find(FAR struct udp_conn_s *conn, uint8_t domain,
+                 FAR const void *group, uint8_t ifindex)
+{
+  FAR struct udp_mship_s *mship;
+
+  for (mship = conn->mships; mship != NULL; mship = mship->flink)
+    {
+      if (mship->domain == domain && mship->ifindex == ifindex &&
+          udp_mcast_addrcmp(domain, &mship->group, group))
+        {
+          break;
+        }
+    }
+
+  return mship;
+}
+
+/****************************************************************************
+ * Name: udp_mcast_findsource
+ *
+ * Description:
+ *   Return the index of a source in the source list of a membership or -1
+ *   if it is not in the list.
+ *
+ ****************************************************************************/
+
+static int udp_mcast_findsource(FAR struct udp_mship_s *mship,
+                                FAR const void *source)
+{
+  int i;
+
+  for (i = 0; i < mship->nsources; i++)
+    {
+      if (udp_mcast_addrcmp(mship->domain, &mship->sources[i], source))
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: udp_mcast_addsource and udp_mcast_delsource
+ *
+ * Description:
+ *   Add a source to or remove a source from the source list of a
+ *   membership.
+ *
+ ****************************************************************************/
+
+static int udp_mcast_addsource(FAR struct udp_mship_s *mship,
+                               FAR const union ip_addr_u *source)
+{
+  if (udp_mcast_findsource(mship, source) >= 0)
+    {
+      return -EADDRNOTAVAIL;
+    }
+
+  if (mship->nsources >= CONFIG_NET_UDP_MCAST_NSOURCES)
+    {
+      return -ENOBUFS;
+    }
+
+  mship->sources[mship->nsources++] = *source;
+  return OK;
+}
+
+static int udp_mcast_delsource(FAR struct udp_mship_s *mship,
+                               FAR const union ip_addr_u *source)
+{
+  int i = udp_mcast_findsource(mship, source);
+
+  if (i < 0)
+    {
+      return -EADDRNOTAVAIL;
+    }
+
+  /* The order of the list does not matter.  Move the last source into the
+   * hole.
+   */
+
+  mship->sources[i] = mship->sources[--mship->nsources];
+  return OK;
+}
+
+/****************************************************************************
+ * Name: udp_mcast_devjoin and udp_mcast_devleave
+ *
+ * Description:
+ *   Join or leave a group on a device through IGMP or MLD.  The device
+ *   counts the joins from all sockets.
+ *
+ ****************************************************************************/
+
+static int udp_mcast_devjoin(FAR struct net_driver_s *dev, uint8_t domain,
+                             FAR const union ip_addr_u *group)
+{
+#ifdef CONFIG_NET_IGMP
+  if (domain == PF_INET)
+    {
+      return igmp_joingroup(dev, (FAR const struct in_addr *)&group->ipv4);
+    }
+#endif
+
+#ifdef CONFIG_NET_MLD
+  if (domain == PF_INET6)
+    {
+      struct ipv6_mreq mrec;
+
+      memcpy(&mrec.ipv6mr_multiaddr, group->ipv6, sizeof(net_ipv6addr_t));
+      mrec.ipv6mr_interface = dev->d_ifindex;
+      return mld_joingroup(&mrec);
+    }
+#endif
+
+  return -EAFNOSUPPORT;
+}
+
+static int udp_mcast_devleave(FAR struct net_driver_s *dev, uint8_t domain,
+                              FAR const union ip_addr_u *group)
+{
+#ifdef CONFIG_NET_IGMP
+  if (domain == PF_INET)
+    {
+      return igmp_leavegroup(dev, (FAR const struct in_addr *)&group->ipv4);
+    }
+#endif
+
+#ifdef CONFIG_NET_MLD
+  if (domain == PF_INET6)
+    {
+      struct ipv6_mreq mrec;
+
+      memcpy(&mrec.ipv6mr_multiaddr, group->ipv6, sizeof(net_ipv6addr_t));
+      mrec.ipv6mr_interface = dev->d_ifindex;
+      return mld_leavegroup(&mrec);
+    }
+#endif
+
+  return -EAFNOSUPPORT;
+}
+
+/****************************************************************************
+ * Name: udp_mcast_free
+ *
+ * Description:
+ *   Remove a membership from a UDP connection and free it.
+ *
+ ****************************************************************************/
+
+static void udp_mcast_free(FAR struct udp_conn_s *conn,
+                           FAR struct udp_mship_s *mship)
+{
+  FAR struct udp_mship_s **link;
+
+  for (link = &conn->mships; *link != NULL; link = &(*link)->flink)
+    {
+      if (*link == mship)
+        {
+          *link = mship->flink;
+          break;
+        }
+    }
+
+  kmm_free(mship);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: udp_mcast_join
+ *
+ * Description:
+ *   Join a multicast group on a UDP socket.  With a NULL 'source' the
+ *   group is joined for all sources; otherwise 'source' is added to the
+ *   sources the group is received from.  The device joins the group when
+ *   the socket first joins it.
+ *
+ * Input Parameters:
+ *   conn   - The UDP connection
+ *   dev    - The device to join the group on
+ *   domain - PF_INET or PF_INET6
+ *   group  - The group address
+ *   source - The source address or NULL
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int udp_mcast_join(FAR struct udp_conn_s *conn,
+                   FAR struct net_driver_s *dev, uint8_t domain,
+                   FAR const union ip_addr_u *group,
+                   FAR const union ip_addr_u *source)
+{
+  FAR struct udp_mship_s *mship;
+  int ret;
+
+  DEBUGASSERT(conn != NULL && dev != NULL && group != NULL);
+
+  mship = udp_mcast_find(conn, domain, group, dev->d_ifindex);
+  if (mship != NULL)
+    {
+      /* Already a member.  Only more sources may be added to a source-
+       * specific membership.
+       */
+
+      if (source == NULL)
+        {
+          return -EADDRINUSE;
+        }
+
+      if (mship->fmode != MCAST_INCLUDE)
+        {
+          return -EINVAL;
+        }
+
+      return udp_mcast_addsource(mship, source);
+    }
+
+  mship = (FAR struct udp_mship_s *)kmm_zalloc(sizeof(struct udp_mship_s));
+  if (mship == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  mship->group   = *group;
+  mship->domain  = domain;
+  mship->ifindex = dev->d_ifindex;
+
+  if (source != NULL)
+    {
+      mship->fmode      = MCAST_INCLUDE;
+      mship->sources[0] = *source;
+      mship->nsources   = 1;
+    }
+  else
+    {
+      mship->fmode      = MCAST_EXCLUDE;
+    }
+
+  ret = udp_mcast_devjoin(dev, domain, group);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to join the group: %d\n", ret);
+      kmm_free(mship);
+      return ret;
+    }
+
+  mship->flink = conn->mships;
+  conn->mships = mship;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: udp_mcast_leave
+ *
+ * Description:
+ *   Undo udp_mcast_join().  The device leaves the group when the socket no
+ *   longer receives it.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int udp_mcast_leave(FAR struct udp_conn_s *conn,
+                    FAR struct net_driver_s *dev, uint8_t domain,
+                    FAR const union ip_addr_u *group,
+                    FAR const union ip_addr_u *source)
+{
+  FAR struct udp_mship_s *mship;
+  int ret;
+
+  DEBUGASSERT(conn != NULL && dev != NULL && group != NULL);
+
+  mship = udp_mcast_find(conn, domain, group, dev->d_ifindex);
+  if (mship == NULL)
+    {
+      return -EADDRNOTAVAIL;
+    }
+
+  if (source != NULL)
+    {
+      /* Drop one source of a source-specific membership.  The group is
+       * left with the last source.
+       */
+
+      if (mship->fmode != MCAST_INCLUDE)
+        {
+          return -EINVAL;
+        }
+
+      ret = udp_mcast_delsource(mship, source);
+      if (ret < 0 || mship->nsources > 0)
+        {
+          return ret;
+        }
+    }
+
+  udp_mcast_free(conn, mship);
+  return udp_mcast_devleave(dev, domain, group);
+}
+
+/****************************************************************************
+ * Name: udp_mcast_block
+ *
+ * Description:
+ *   Block or unblock a source of a group that the socket has joined for
+ *   all sources.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int udp_mcast_block(FAR struct udp_conn_s *conn,
+                    FAR struct net_driver_s *dev, uint8_t domain,
+                    FAR const union ip_addr_u *group,
+                    FAR const union ip_addr_u *source, bool block)
+{
+  FAR struct udp_mship_s *mship;
+
+  DEBUGASSERT(conn != NULL && dev != NULL && group != NULL &&
+              source != NULL);
+
+  mship = udp_mcast_find(conn, domain, group, dev->d_ifindex);
+  if (mship == NULL)
+    {
+      return -EADDRNOTAVAIL;
+    }
+
+  if (mship->fmode != MCAST_EXCLUDE)
+    {
+      return -EINVAL;
+    }
+
+  return block ? udp_mcast_addsource(mship, source) :
+                 udp_mcast_delsource(mship, source);
+}
+
+/****************************************************************************
+ * Name: udp_mcast_leaveall
+ *
+ * Description:
+ *   Leave all of the groups joined through a UDP socket.  Called when the
+ *   socket is closed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void udp_mcast_leaveall(FAR struct udp_conn_s *conn)
+{
+  FAR struct udp_mship_s *mship;
+  FAR struct net_driver_s *dev;
+
+  while ((mship = conn->mships) != NULL)
+    {
+      conn->mships = mship->flink;
+
+      /* The device may have gone away since the group was joined */
+
+      dev = netdev_findbyindex(mship->ifindex);
+      if (dev != NULL)
+        {
+          udp_mcast_devleave(dev, mship->domain, &mship->group);
+        }
+
+      kmm_free(mship);
+    }
+}
+
+/****************************************************************************
+ * Name: udp_mcast_accept
+ *
+ * Description:
+ *   Check if a multicast packet from 'source' to 'group' received on 'dev'
+ *   should be delivered to a UDP connection.  A socket that has not joined
+ *   any group receives all multicast packets to its port; a socket that
+ *   has joined groups receives only those groups, filtered by source.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool udp_mcast_accept(FAR struct udp_conn_s *conn,
+                      FAR struct net_driver_s *dev, uint8_t domain,
+                      FAR const void *group, FAR const void *source)
+{
+  FAR struct udp_mship_s *mship;
+  bool listed;
+
+  if (conn->mships == NULL)
+    {
+      return true;
+    }
+
+  mship = udp_mcast_find(conn, domain, group, dev->d_ifindex);
+  if (mship == NULL)
+    {
+      return false;
+    }
+
+  listed = udp_mcast_findsource(mship, source) >= 0;
+  return mship->fmode == MCAST_INCLUDE ? listed : !listed;
+}
+
+#endif /* CONFIG_NET_UDP_MCASTFILTER */
@@ -338,6 +338,9 @@ static int sendto_next_transfer(FAR struct socket *psock,
 
   /* Notify the device driver of the availability of TX data */
 
+#ifdef CONFIG_NET_TXREADY
+  devif_txready(dev, &conn->txready);
+#endif
   netdev_txnotify_dev(dev);
   return OK;
 }
@@ -460,6 +460,9 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
       /* Notify the device driver of the availability of TX data */
 
+#ifdef CONFIG_NET_TXREADY
+      devif_txready(state.st_dev, &conn->txready);
+#endif
       netdev_txnotify_dev(state.st_dev);
 
       /* Wait for either the receive to complete or for an error/timeout to
@@ -94,6 +94,20 @@ struct usrsockdev_s
   FAR struct usrsock_conn_s *datain_conn; /* Connection instance to receive
                                            * data buffers. */
   struct pollfd *pollfds[CONFIG_NET_USRSOCKDEV_NPOLLWAITERS];
+
+#ifdef CONFIG_NET_USRSOCK_RING
+  struct
+  {
+    FAR uint8_t *sq;             /* Submission ring (NULL: not attached) */
+    FAR uint8_t *cq;             /* Completion ring */
+    uint16_t slotsize;           /* Size of one slot */
+    uint16_t nslots;             /* Number of slots in each ring */
+    uint16_t sqhead;             /* Next submission slot to fill */
+    uint16_t cqtail;             /* Next completion slot to handle */
+    sem_t    slotsem;            /* Wakes requests waiting for a free slot */
+    uint16_t nslotwait;          /* Number of requests waiting for a slot */
+  } ring;
+#endif
 };
 
 /****************************************************************************
@@ -118,6 +132,11 @@ static int usrsockdev_close(FAR struct file *filep);
 static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
 
+#ifdef CONFIG_NET_USRSOCK_RING
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -129,7 +148,11 @@ static const struct file_operations g_usrsockdevops =
   usrsockdev_read,    /* read */
   usrsockdev_write,   /* write */
   usrsockdev_seek,    /* seek */
+#ifdef CONFIG_NET_USRSOCK_RING
+  usrsockdev_ioctl,   /* ioctl */
+#else
   NULL,               /* ioctl */
+#endif
   usrsockdev_poll     /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , NULL              /* unlink */
@@ -825,40 +848,24 @@ static ssize_t usrsockdev_handle_message(FAR struct usrsockdev_s *dev,
 }
 
 /****************************************************************************
- * Name: usrsockdev_write
+ * Name: usrsockdev_handle_buffer
+ *
+ * Description:
+ *   Handle a message, or a part of the data following a data response,
+ *   from the daemon.
+ *
+ * Assumptions:
+ *   Called with the device semaphore held.
+ *
  ****************************************************************************/
 
-static ssize_t usrsockdev_write(FAR struct file *filep,
-                                FAR const char *buffer, size_t len)
+static ssize_t usrsockdev_handle_buffer(FAR struct usrsockdev_s *dev,
+                                        FAR const char *buffer, size_t len)
 {
-  FAR struct inode *inode = filep->f_inode;
   FAR struct usrsock_conn_s *conn;
-  FAR struct usrsockdev_s *dev;
   size_t origlen = len;
   ssize_t ret = 0;
 
-  if (len == 0)
-    {
-      return 0;
-    }
-
-  if (buffer == NULL)
-    {
-      return -EINVAL;
-    }
-
-  DEBUGASSERT(inode);
-
-  dev = inode->i_private;
-
-  DEBUGASSERT(dev);
-
-  ret = (ssize_t)usrsockdev_semtake(&dev->devsem);
-  if (ret < 0)
-    {
-      return ret;
-    }
-
   if (!dev->datain_conn)
     {
       /* Start of message, buffer length should be at least size of common
@@ -923,10 +930,304 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
     }
 
 errout:
+  return ret;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_write
+ ****************************************************************************/
+
+static ssize_t usrsockdev_write(FAR struct file *filep,
+                                FAR const char *buffer, size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  ssize_t ret = 0;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  if (buffer == NULL)
+    {
+      return -EINVAL;
+    }
+
+  DEBUGASSERT(inode);
+
+  dev = inode->i_private;
+
+  DEBUGASSERT(dev);
+
+  ret = (ssize_t)usrsockdev_semtake(&dev->devsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = usrsockdev_handle_buffer(dev, buffer, len);
+
   usrsockdev_semgive(&dev->devsem);
   return ret;
 }
 
+#ifdef CONFIG_NET_USRSOCK_RING
+/****************************************************************************
+ * Name: usrsockdev_ring_pending
+ *
+ * Description:
+ *   Check if the daemon has requests to take from the submission ring.  It
+ *   takes them in ring order, so there are some for as long as the most
+ *   recently filled slot has not been handed back.
+ *
+ ****************************************************************************/
+
+static bool usrsockdev_ring_pending(FAR struct usrsockdev_s *dev)
+{
+  uint16_t prev;
+
+  if (dev->ring.sq == NULL)
+    {
+      return false;
+    }
+
+  prev = dev->ring.sqhead > 0 ? dev->ring.sqhead - 1 : dev->ring.nslots - 1;
+  return USRSOCK_RING_SLOT(dev->ring.sq, dev->ring.slotsize, prev)->status ==
+         USRSOCK_SLOT_READY;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ring_wake
+ *
+ * Description:
+ *   Wake up all requests waiting for a free submission slot.  They check
+ *   the ring again when they run.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void usrsockdev_ring_wake(FAR struct usrsockdev_s *dev)
+{
+  while (dev->ring.nslotwait > 0)
+    {
+      dev->ring.nslotwait--;
+      nxsem_post(&dev->ring.slotsem);
+    }
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ring_setup
+ *
+ * Description:
+ *   Attach the rings in daemon memory, or detach the current rings if the
+ *   description has no slots.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_ring_setup(FAR struct usrsockdev_s *dev,
+                                 FAR const struct usrsock_ring_s *ring)
+{
+  uint16_t i;
+
+  if (ring == NULL)
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+
+  if (ring->nslots == 0)
+    {
+      dev->ring.sq = NULL;
+      dev->ring.cq = NULL;
+      usrsockdev_ring_wake(dev);
+      net_unlock();
+      return OK;
+    }
+
+  /* Every slot must hold at least the largest fixed-size response and keep
+   * the slot headers aligned.
+   */
+
+  if (ring->sq == NULL || ring->cq == NULL ||
+      ((uintptr_t)ring->sq & (sizeof(uint16_t) - 1)) != 0 ||
+      ((uintptr_t)ring->cq & (sizeof(uint16_t) - 1)) != 0 ||
+      (ring->slotsize & (sizeof(uint16_t) - 1)) != 0 ||
+      ring->slotsize < sizeof(struct usrsock_ringslot_s) +
+                       sizeof(struct usrsock_message_datareq_ack_s))
+    {
+      net_unlock();
+      return -EINVAL;
+    }
+
+  for (i = 0; i < ring->nslots; i++)
+    {
+      USRSOCK_RING_SLOT(ring->sq, ring->slotsize, i)->status =
+        USRSOCK_SLOT_FREE;
+      USRSOCK_RING_SLOT(ring->cq, ring->slotsize, i)->status =
+        USRSOCK_SLOT_FREE;
+    }
+
+  dev->ring.sq       = ring->sq;
+  dev->ring.cq       = ring->cq;
+  dev->ring.slotsize = ring->slotsize;
+  dev->ring.nslots   = ring->nslots;
+  dev->ring.sqhead   = 0;
+  dev->ring.cqtail   = 0;
+
+  /* Requests waiting for a slot of the old rings can use the new ones */
+
+  usrsockdev_ring_wake(dev);
+  net_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ring_kick
+ *
+ * Description:
+ *   Handle all messages that the daemon has put in the completion ring.
+ *
+ * Assumptions:
+ *   Called with the device semaphore held.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_ring_kick(FAR struct usrsockdev_s *dev)
+{
+  FAR struct usrsock_ringslot_s *slot;
+  ssize_t ret;
+  int nmsgs = 0;
+
+  if (dev->ring.cq == NULL)
+    {
+      return -ENXIO;
+    }
+
+  for (; ; )
+    {
+      slot = USRSOCK_RING_SLOT(dev->ring.cq, dev->ring.slotsize,
+                               dev->ring.cqtail);
+      if (__atomic_load_n(&slot->status, __ATOMIC_ACQUIRE) !=
+          USRSOCK_SLOT_READY)
+        {
+          break;
+        }
+
+      if (slot->len == 0 ||
+          slot->len > dev->ring.slotsize - sizeof(struct usrsock_ringslot_s))
+        {
+          nwarn("bad message length in completion slot: %u\n", slot->len);
+          ret = -EINVAL;
+        }
+      else
+        {
+          ret = usrsockdev_handle_buffer(dev, (FAR const char *)(slot + 1),
+                                         slot->len);
+        }
+
+      /* Hand the slot back even if the message was bad, so that one bad
+       * message does not stall the ring.
+       */
+
+      slot->status = USRSOCK_SLOT_FREE;
+      if (++dev->ring.cqtail >= dev->ring.nslots)
+        {
+          dev->ring.cqtail = 0;
+        }
+
+      if (ret < 0)
+        {
+          nwarn("completion message failed: %d\n", (int)ret);
+        }
+
+      nmsgs++;
+    }
+
+  /* The daemon has taken requests before it completed them, so there may
+   * be free submission slots now.
+   */
+
+  net_lock();
+  usrsockdev_ring_wake(dev);
+  net_unlock();
+
+  return nmsgs;
+}
+
+/****************************************************************************
+ * Name: usrsockdev_ring_request
+ *
+ * Description:
+ *   Copy a request into the next submission slot, waiting for the daemon to
+ *   hand one back if the ring is full.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int usrsockdev_ring_request(FAR struct usrsockdev_s *dev,
+                                   FAR const struct iovec *iov,
+                                   unsigned int iovcnt)
+{
+  FAR struct usrsock_ringslot_s *slot;
+  unsigned int i;
+  size_t len = 0;
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      len += iov[i].iov_len;
+    }
+
+  for (; ; )
+    {
+      if (dev->ring.sq == NULL || !usrsockdev_is_opened(dev))
+        {
+          return -ENETDOWN;
+        }
+
+      if (len > dev->ring.slotsize - sizeof(struct usrsock_ringslot_s))
+        {
+          nwarn("request does not fit in a slot: %zu\n", len);
+          return -EMSGSIZE;
+        }
+
+      slot = USRSOCK_RING_SLOT(dev->ring.sq, dev->ring.slotsize,
+                               dev->ring.sqhead);
+      if (slot->status == USRSOCK_SLOT_FREE)
+        {
+          break;
+        }
+
+      /* The ring is full.  Wait for the daemon to hand slots back. */
+
+      dev->ring.nslotwait++;
+      net_lockedwait_uninterruptible(&dev->ring.slotsem);
+    }
+
+  iovec_get(slot + 1, len, iov, iovcnt, 0);
+  slot->len = len;
+
+  /* Hand the slot to the daemon only after all of it has been written */
+
+  __atomic_store_n(&slot->status, USRSOCK_SLOT_READY, __ATOMIC_RELEASE);
+
+  if (++dev->ring.sqhead >= dev->ring.nslots)
+    {
+      dev->ring.sqhead = 0;
+    }
+
+  /* Notify daemon of new request. */
+
+  usrsockdev_pollnotify(dev, POLLIN);
+  return OK;
+}
+#endif /* CONFIG_NET_USRSOCK_RING */
+
 /****************************************************************************
  * Name: usrsockdev_open
  ****************************************************************************/
@@ -1023,6 +1324,14 @@ static int usrsockdev_close(FAR struct file *filep)
   DEBUGASSERT(dev->ocount == 0);
   ret = OK;
 
+#ifdef CONFIG_NET_USRSOCK_RING
+  /* The rings are in the memory of the daemon that is going away */
+
+  dev->ring.sq = NULL;
+  dev->ring.cq = NULL;
+  usrsockdev_ring_wake(dev);
+#endif
+
   do
     {
       /* Give other threads short time window to complete recently completed
@@ -1144,6 +1453,13 @@ static int usrsockdev_poll(FAR struct file *filep, FAR struct pollfd *fds,
           eventset |= POLLIN;
         }
 
+#ifdef CONFIG_NET_USRSOCK_RING
+      if (usrsockdev_ring_pending(dev))
+        {
+          eventset |= POLLIN;
+        }
+#endif
+
       if (eventset)
         {
           usrsockdev_pollnotify(dev, eventset);
@@ -1173,6 +1489,52 @@ errout:
   return ret;
 }
 
+#ifdef CONFIG_NET_USRSOCK_RING
+/****************************************************************************
+ * Name: usrsockdev_ioctl
+ ****************************************************************************/
+
+static int usrsockdev_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct usrsockdev_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode);
+
+  dev = inode->i_private;
+
+  DEBUGASSERT(dev);
+
+  ret = usrsockdev_semtake(&dev->devsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case USRSOCKIOC_SETRING:
+        ret = usrsockdev_ring_setup(dev,
+                                    (FAR const struct usrsock_ring_s *)
+                                    ((uintptr_t)arg));
+        break;
+
+      case USRSOCKIOC_KICK:
+        ret = usrsockdev_ring_kick(dev);
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  usrsockdev_semgive(&dev->devsem);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1211,6 +1573,17 @@ int usrsockdev_do_request(FAR struct usrsock_conn_s *conn,
   conn->resp.xid = req_head->xid;
   conn->resp.result = -EACCES;
 
+#ifdef CONFIG_NET_USRSOCK_RING
+  if (dev->ring.sq != NULL)
+    {
+      /* The request is copied into the ring, so there is no need to wait
+       * for the daemon to take it.  The caller waits for the response.
+       */
+
+      return usrsockdev_ring_request(dev, iov, iovcnt);
+    }
+#endif
+
   ++dev->req.nbusy; /* net_lock held. */
 
   /* Set outstanding request for daemon to handle. */
@@ -1267,6 +1640,11 @@ void usrsockdev_register(void)
   nxsem_init(&g_usrsockdev.req.acksem, 0, 0);
   nxsem_set_protocol(&g_usrsockdev.req.acksem, SEM_PRIO_NONE);
 
+#ifdef CONFIG_NET_USRSOCK_RING
+  nxsem_init(&g_usrsockdev.ring.slotsem, 0, 0);
+  nxsem_set_protocol(&g_usrsockdev.ring.slotsem, SEM_PRIO_NONE);
+#endif
+
   register_driver("/dev/usrsock", &g_usrsockdevops, 0666,
                   &g_usrsockdev);
 }
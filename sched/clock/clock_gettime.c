@@ -59,14 +59,14 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: clock_gettime
+ * Name: nx_clock_gettime
  *
  * Description:
  *   Clock Functions based on POSIX APIs
  *
  ****************************************************************************/
 
-int clock_gettime(clockid_t clock_id, struct timespec *tp)
+int nx_clock_gettime(clockid_t clock_id, FAR struct timespec *tp)
 {
   struct timespec ts;
   uint32_t carry;
@@ -0,0 +1,110 @@
+/****************************************************************************
+ * sched/clock/clock_timepage.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <time.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+
+#include "clock/clock.h"
+
+#ifdef CONFIG_CLOCK_TIMEPAGE
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The time page.  It comes from the user heap so that, in the protected
+ * build, user space can read it without entering the OS.
+ */
+
+static FAR struct clock_timepage_s *g_timepage;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: clock_timepage_initialize
+ *
+ * Description:
+ *   Allocate the time page.  Called once from clock_initialize().
+ *
+ ****************************************************************************/
+
+void clock_timepage_initialize(void)
+{
+  g_timepage = kumm_zalloc(sizeof(struct clock_timepage_s));
+  clock_timepage_update();
+}
+
+/****************************************************************************
+ * Name: clock_timepage_update
+ *
+ * Description:
+ *   Copy the current system time and time-of-day base into the time page.
+ *   This must be called whenever either of them changes.
+ *
+ ****************************************************************************/
+
+void clock_timepage_update(void)
+{
+  FAR struct clock_timepage_s *page = g_timepage;
+  irqstate_t flags;
+
+  if (page != NULL)
+    {
+      flags = enter_critical_section();
+
+      page->seq++;
+      __atomic_thread_fence(__ATOMIC_RELEASE);
+
+      clock_systime_timespec(&page->monotonic);
+      page->basetime = g_basetime;
+
+      __atomic_thread_fence(__ATOMIC_RELEASE);
+      page->seq++;
+
+      leave_critical_section(flags);
+    }
+}
+
+/****************************************************************************
+ * Name: clock_timepage
+ *
+ * Description:
+ *   Return the address of the time page.
+ *
+ ****************************************************************************/
+
+FAR const struct clock_timepage_s *clock_timepage(void)
+{
+  return g_timepage;
+}
+
+#endif /* CONFIG_CLOCK_TIMEPAGE */
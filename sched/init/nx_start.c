@@ -522,7 +522,12 @@ void nx_start(void)
 #else
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
+#ifdef CONFIG_SCHED_PRIOQUEUE
+      nxsched_prioq_add(&g_idletcb[cpu].cmn);
+      UNUSED(tasklist);
+#else
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+#endif
 
       /* Mark the idle task as the running task */
 
@@ -50,6 +50,7 @@
 #include <sched.h>
 
 #include <nuttx/compiler.h>
+#include <nuttx/pthread.h>
 
 /****************************************************************************
  * Public Type Declarations
@@ -116,12 +117,25 @@ int pthread_sem_trytake(sem_t *sem);
 #endif
 int pthread_sem_give(sem_t *sem);
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+int pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex,
+                           FAR const struct timespec *abs_timeout,
+                           bool intr);
+int pthread_mutex_fasttrytake(FAR struct pthread_mutex_s *mutex);
+int pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex);
+#endif
+
 #ifndef CONFIG_PTHREAD_MUTEX_UNSAFE
 int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
                        FAR const struct timespec *abs_timeout, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
 void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
+#elif defined(CONFIG_PTHREAD_MUTEX_FASTPATH)
+#  define pthread_mutex_take(m,abs_timeout,i) \
+     pthread_mutex_fasttake((m),(abs_timeout),(i))
+#  define pthread_mutex_trytake(m)             pthread_mutex_fasttrytake(m)
+#  define pthread_mutex_give(m)                pthread_mutex_fastgive(m)
 #else
 #  define pthread_mutex_take(m,abs_timeout,i)  pthread_sem_take(&(m)->sem,(abs_timeout),(i))
 #  define pthread_mutex_trytake(m)             pthread_sem_trytake(&(m)->sem)
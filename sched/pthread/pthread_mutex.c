@@ -184,6 +184,16 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
         {
           ret = EOWNERDEAD;
         }
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      else if (pthread_mutex_isfast(mutex))
+        {
+          /* Non-robust mutexes are not tracked in the list of mutexes
+           * held by this task.
+           */
+
+          ret = pthread_mutex_fasttake(mutex, abs_timeout, intr);
+        }
+#endif
       else
         {
           /* Take semaphore underlying the mutex.  pthread_sem_take
@@ -254,6 +264,12 @@ int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex)
         {
           ret = EOWNERDEAD;
         }
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+      else if (pthread_mutex_isfast(mutex))
+        {
+          ret = pthread_mutex_fasttrytake(mutex);
+        }
+#endif
       else
         {
           /* Try to take the semaphore underlying the mutex */
@@ -299,6 +315,13 @@ int pthread_mutex_give(FAR struct pthread_mutex_s *mutex)
   /* Verify input parameters */
 
   DEBUGASSERT(mutex != NULL);
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  if (mutex != NULL && pthread_mutex_isfast(mutex))
+    {
+      ret = pthread_mutex_fastgive(mutex);
+    }
+  else
+#endif
   if (mutex != NULL)
     {
       /* Remove the mutex from the list of mutexes held by this task */
@@ -94,6 +94,9 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
               /* The thread associated with the PID no longer exists */
 
               mutex->pid = -1;
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+              mutex->lock = 0;
+#endif
 
               /* Reset the semaphore.  If threads are were on this
                * semaphore, then this will awakened them and make
@@ -0,0 +1,278 @@
+/****************************************************************************
+ * sched/pthread/pthread_mutexfast.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/sched.h>
+#include <nuttx/pthread.h>
+
+#include "sched/sched.h"
+#include "semaphore/semaphore.h"
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/* The lock word of a fast mutex is in one of these states:
+ *
+ *   0                        - Free.  The semaphore count is one.
+ *   LOCKED | pid             - Held by 'pid', taken in user space.  The
+ *                              semaphore is not used and its count is
+ *                              still one.
+ *   LOCKED | WAITERS | pid   - Held by 'pid' and owned through the
+ *                              semaphore.  Other threads may be waiting on
+ *                              the semaphore.
+ *   WAITERS                  - Being handed from the last holder to a
+ *                              waiter that has not run yet.
+ *
+ * User space only ever changes the word from 0 to LOCKED | pid and back.
+ * All other transitions happen here inside a critical section, so they
+ * are serialized against each other but must still use compare-and-swap
+ * against the user-space transitions.
+ */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_adopt
+ *
+ * Description:
+ *   The mutex was taken in user space by 'pid' and another thread now has
+ *   to wait for it.  Make the semaphore show that 'pid' holds it so that
+ *   the waiter blocks behind it and, with priority inheritance, boosts it.
+ *
+ * Assumptions:
+ *   Called in a critical section after WAITERS has been set in the lock
+ *   word.
+ *
+ ****************************************************************************/
+
+static void pthread_mutex_adopt(FAR struct pthread_mutex_s *mutex,
+                                pid_t pid)
+{
+  FAR struct tcb_s *htcb;
+
+  DEBUGASSERT(mutex->sem.semcount == 1);
+  mutex->sem.semcount = 0;
+
+  /* If the holder is gone, there is nobody to boost.  A non-robust mutex
+   * just stays locked in that case.
+   */
+
+  htcb = nxsched_get_tcb(pid);
+  if (htcb != NULL)
+    {
+      nxsem_add_holder_tcb(htcb, &mutex->sem);
+    }
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_wait
+ *
+ * Description:
+ *   Wait on the semaphore of a mutex that is owned through the semaphore.
+ *   When the mutex is obtained and nobody else is waiting, hand the
+ *   semaphore back so that the next lock and unlock can be done in user
+ *   space again.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static int pthread_mutex_wait(FAR struct pthread_mutex_s *mutex,
+                              uint32_t self,
+                              FAR const struct timespec *abs_timeout,
+                              bool intr)
+{
+  int ret;
+
+  ret = pthread_sem_take(&mutex->sem, abs_timeout, intr);
+  if (ret == OK)
+    {
+      if (mutex->sem.semcount < 0)
+        {
+          mutex->lock = self | _PTHREAD_MLOCK_WAITERS;
+        }
+      else
+        {
+          mutex->lock = self;
+          pthread_sem_give(&mutex->sem);
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fasttake
+ *
+ * Description:
+ *   Take a mutex that supports the user-space fast path, waiting if
+ *   necessary.  This is the OS side of pthread_mutex_timedlock() and is
+ *   reached when the compare-and-swap in the C library failed.
+ *
+ * Input Parameters:
+ *   mutex       - The mutex to be locked
+ *   abs_timeout - Maximum wait time (NULL wait forever)
+ *   intr        - false: ignore EINTR errors when locking; true treat
+ *                 EINTR as other errors by returning the errno value
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fasttake(FAR struct pthread_mutex_s *mutex,
+                           FAR const struct timespec *abs_timeout,
+                           bool intr)
+{
+  uint32_t self = _PTHREAD_MLOCK_LOCKED | (uint32_t)this_task()->pid;
+  irqstate_t flags;
+  uint32_t lock;
+  int ret;
+
+  flags = enter_critical_section();
+  for (; ; )
+    {
+      lock = mutex->lock;
+      if (lock == 0)
+        {
+          /* Released since the caller looked.  Take it as user space
+           * would.
+           */
+
+          if (pthread_mutex_cmpxchg(mutex, 0, self))
+            {
+              ret = OK;
+              break;
+            }
+        }
+      else if ((lock & _PTHREAD_MLOCK_WAITERS) != 0)
+        {
+          /* Already owned through the semaphore */
+
+          ret = pthread_mutex_wait(mutex, self, abs_timeout, intr);
+          break;
+        }
+      else if (pthread_mutex_cmpxchg(mutex, lock,
+                                     lock | _PTHREAD_MLOCK_WAITERS))
+        {
+          /* Held from user space.  Setting WAITERS makes the holder's
+           * user-space unlock fail, so it will come here to wake us.
+           */
+
+          pthread_mutex_adopt(mutex, lock & _PTHREAD_MLOCK_PIDMASK);
+          ret = pthread_mutex_wait(mutex, self, abs_timeout, intr);
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fasttrytake
+ *
+ * Description:
+ *   Try to take a mutex that supports the user-space fast path without
+ *   waiting.
+ *
+ * Input Parameters:
+ *   mutex - The mutex to be locked
+ *
+ * Returned Value:
+ *   0 on success, EAGAIN if the mutex is held.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fasttrytake(FAR struct pthread_mutex_s *mutex)
+{
+  uint32_t self = _PTHREAD_MLOCK_LOCKED | (uint32_t)this_task()->pid;
+
+  return pthread_mutex_cmpxchg(mutex, 0, self) ? OK : EAGAIN;
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastgive
+ *
+ * Description:
+ *   Release a mutex that supports the user-space fast path and wake the
+ *   next waiter, if any.
+ *
+ * Input Parameters:
+ *   mutex - The mutex to be unlocked
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastgive(FAR struct pthread_mutex_s *mutex)
+{
+  irqstate_t flags;
+  int ret = OK;
+
+  flags = enter_critical_section();
+  if ((mutex->lock & _PTHREAD_MLOCK_WAITERS) == 0)
+    {
+      /* Nobody is waiting.  Only a user-space lock can race with us and
+       * that waits for the word to become zero.
+       */
+
+      __atomic_store_n(&mutex->lock, 0, __ATOMIC_RELEASE);
+    }
+  else
+    {
+      /* Mark the hand-off before posting.  If a waiter took the count, it
+       * will record itself as the holder when it runs.  If the waiters
+       * have all timed out, the semaphore is free again and so is the
+       * mutex.
+       */
+
+      mutex->lock = _PTHREAD_MLOCK_WAITERS;
+      ret = pthread_sem_give(&mutex->sem);
+      if (mutex->sem.semcount > 0)
+        {
+          __atomic_store_n(&mutex->lock, 0, __ATOMIC_RELEASE);
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+#endif /* CONFIG_PTHREAD_MUTEX_FASTPATH */
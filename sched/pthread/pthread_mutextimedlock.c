@@ -55,7 +55,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_timedlock
+ * Name: nx_pthread_mutex_timedlock
  *
  * Description:
  *   The pthread_mutex_timedlock() function will lock the mutex object
@@ -90,8 +90,8 @@
  *
  ****************************************************************************/
 
-int pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
-                            FAR const struct timespec *abs_timeout)
+int nx_pthread_mutex_timedlock(FAR pthread_mutex_t *mutex,
+                               FAR const struct timespec *abs_timeout)
 {
   int mypid = (int)getpid();
   int ret = EINVAL;
@@ -38,7 +38,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_trylock
+ * Name: nx_pthread_mutex_trylock
  *
  * Description:
  *   The function pthread_mutex_trylock() is identical to
@@ -66,7 +66,7 @@
  *
  ****************************************************************************/
 
-int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
+int nx_pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
 {
   int status;
   int ret = EINVAL;
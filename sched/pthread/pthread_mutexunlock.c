@@ -70,6 +70,15 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
 {
   int semcount = mutex->sem.semcount;
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+  /* A mutex taken in user space leaves the semaphore untouched */
+
+  if (pthread_mutex_isfast(mutex))
+    {
+      return mutex->lock != 0;
+    }
+#endif
+
   /* The underlying semaphore should have a count less than 2:
    *
    *  1 == mutex is unlocked.
@@ -86,7 +95,7 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  ****************************************************************************/
 
 /****************************************************************************
- * Name: pthread_mutex_unlock
+ * Name: nx_pthread_mutex_unlock
  *
  * Description:
  *   The pthread_mutex_unlock() function releases the mutex object referenced
@@ -113,7 +122,7 @@ static inline bool pthread_mutex_islocked(FAR struct pthread_mutex_s *mutex)
  *
  ****************************************************************************/
 
-int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
+int nx_pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 {
   int ret = EPERM;
 
@@ -379,6 +379,11 @@ void nxsched_add_blocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 
+#ifdef CONFIG_SCHED_PRIOQUEUE
+bool nxsched_prioq_add(FAR struct tcb_s *tcb);
+void nxsched_prioq_remove(FAR struct tcb_s *tcb);
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -468,6 +473,14 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb);
 void nxsched_suspend_critmon(FAR struct tcb_s *tcb);
 #endif
 
+/* Scheduling latency monitor */
+
+#ifdef CONFIG_SCHED_LATENCYMON
+void nxsched_ready_latency(FAR struct tcb_s *tcb);
+void nxsched_resume_latency(FAR struct tcb_s *tcb);
+void nxsched_suspend_latency(FAR struct tcb_s *tcb);
+#endif
+
 /* TCB operations */
 
 bool nxsched_verify_tcb(FAR struct tcb_s *tcb);
@@ -85,6 +85,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
   FAR struct tcb_s *rtcb = this_task();
   bool ret;
 
+#ifdef CONFIG_SCHED_LATENCYMON
+  /* Start timing the wakeup latency */
+
+  nxsched_ready_latency(btcb);
+#endif
+
   /* Check if pre-emption is disabled for the current running task and if
    * the new ready-to-run task would cause the current running task to be
    * pre-empted.  NOTE that IRQs disabled implies that pre-emption is
@@ -104,7 +110,11 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   /* Otherwise, add the new task to the ready-to-run task list */
 
+#ifdef CONFIG_SCHED_PRIOQUEUE
+  else if (nxsched_prioq_add(btcb))
+#else
   else if (nxsched_add_prioritized(btcb, (FAR dq_queue_t *)&g_readytorun))
+#endif
     {
       /* The new btcb was added at the head of the ready-to-run list.  It
        * is now the new active task!
@@ -178,6 +188,12 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
 
   irqstate_t lock = nxsched_lock_tasklist();
 
+#ifdef CONFIG_SCHED_LATENCYMON
+  /* Start timing the wakeup latency */
+
+  nxsched_ready_latency(btcb);
+#endif
+
   /* Check if the blocked TCB is locked to this CPU */
 
   if ((btcb->flags & TCB_FLAG_CPU_LOCKED) != 0)
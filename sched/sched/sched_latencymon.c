@@ -0,0 +1,192 @@
+/****************************************************************************
+ * sched/sched/sched_latencymon.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <strings.h>
+#include <sched.h>
+
+#include <nuttx/arch.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_LATENCYMON
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Scheduling latency statistics of each CPU */
+
+#ifdef CONFIG_SMP_NCPUS
+struct latencymon_s g_latency[CONFIG_SMP_NCPUS];
+#else
+struct latencymon_s g_latency[1];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_latency_bucket
+ *
+ * Description:
+ *   Return the histogram entry that counts an elapsed time.
+ *
+ ****************************************************************************/
+
+static inline int nxsched_latency_bucket(uint32_t elapsed)
+{
+  int bucket = flsl(elapsed >> CONFIG_SCHED_LATENCYMON_SHIFT);
+
+  if (bucket >= CONFIG_SCHED_LATENCYMON_NBUCKETS)
+    {
+      bucket = CONFIG_SCHED_LATENCYMON_NBUCKETS - 1;
+    }
+
+  return bucket;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_ready_latency
+ *
+ * Description:
+ *   Called when a thread becomes ready-to-run.  Starts timing the wakeup
+ *   latency unless it is already running, as when a ready-to-run thread
+ *   is moved between lists.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_ready_latency(FAR struct tcb_s *tcb)
+{
+  if (tcb->ready_start == 0)
+    {
+      /* Zero means that the timer is not ready */
+
+      tcb->ready_start = up_critmon_gettime();
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_resume_latency
+ *
+ * Description:
+ *   Called when a thread resumes execution.  Records the time that it
+ *   waited to run and starts timing its run slice.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_resume_latency(FAR struct tcb_s *tcb)
+{
+  FAR struct latencymon_s *cpulat = &g_latency[this_cpu()];
+  uint32_t now = up_critmon_gettime();
+  uint32_t elapsed;
+  int bucket;
+
+  tcb->latency.nswitch++;
+  cpulat->nswitch++;
+
+  if (tcb->ready_start != 0 && now != 0)
+    {
+      elapsed = now - tcb->ready_start;
+      bucket  = nxsched_latency_bucket(elapsed);
+
+      tcb->latency.wakeup[bucket]++;
+      cpulat->wakeup[bucket]++;
+
+      if (elapsed > tcb->latency.wakeup_max)
+        {
+          tcb->latency.wakeup_max = elapsed;
+        }
+
+      if (elapsed > cpulat->wakeup_max)
+        {
+          cpulat->wakeup_max = elapsed;
+        }
+    }
+
+  tcb->ready_start = 0;
+  tcb->run_start   = now;
+}
+
+/****************************************************************************
+ * Name: nxsched_suspend_latency
+ *
+ * Description:
+ *   Called when a thread suspends execution.  Records the length of its run
+ *   slice and, if it is still ready-to-run, counts an involuntary switch
+ *   and starts timing until it runs again.
+ *
+ * Assumptions:
+ *   - Called within a critical section.
+ *   - Might be called from an interrupt handler
+ *
+ ****************************************************************************/
+
+void nxsched_suspend_latency(FAR struct tcb_s *tcb)
+{
+  FAR struct latencymon_s *cpulat = &g_latency[this_cpu()];
+  uint32_t now = up_critmon_gettime();
+  int bucket;
+
+  if (tcb->run_start != 0 && now != 0)
+    {
+      bucket = nxsched_latency_bucket(now - tcb->run_start);
+
+      tcb->latency.slice[bucket]++;
+      cpulat->slice[bucket]++;
+    }
+
+  tcb->run_start = 0;
+
+  /* A thread that is still ready-to-run was pre-empted (or yielded) rather
+   * than blocked.
+   */
+
+  if (tcb->task_state >= TSTATE_TASK_PENDING &&
+      tcb->task_state <= TSTATE_TASK_RUNNING)
+    {
+      tcb->latency.npreempt++;
+      cpulat->npreempt++;
+
+      tcb->ready_start = now;
+    }
+}
+
+#endif /* CONFIG_SCHED_LATENCYMON */
@@ -68,7 +68,48 @@
  *
  ****************************************************************************/
 
-#ifndef CONFIG_SMP
+#if !defined(CONFIG_SMP) && defined(CONFIG_SCHED_PRIOQUEUE)
+bool nxsched_merge_pending(void)
+{
+  FAR struct tcb_s *ptcb;
+  FAR struct tcb_s *pnext;
+  FAR struct tcb_s *rtcb;
+  bool ret = false;
+
+  /* Move every TCB in the g_pendingtasks list to the ready-to-run list.
+   * The index of the ready-to-run list gives the insertion point directly.
+   */
+
+  for (ptcb = (FAR struct tcb_s *)g_pendingtasks.head;
+       ptcb;
+       ptcb = pnext)
+    {
+      pnext = ptcb->flink;
+      rtcb  = this_task();
+
+      if (nxsched_prioq_add(ptcb))
+        {
+          /* ptcb was added at the head of the ready-to-run list */
+
+          rtcb->task_state = TSTATE_TASK_READYTORUN;
+          ptcb->task_state = TSTATE_TASK_RUNNING;
+          ret              = true;
+        }
+      else
+        {
+          ptcb->task_state = TSTATE_TASK_READYTORUN;
+        }
+    }
+
+  /* Mark the input list empty */
+
+  g_pendingtasks.head = NULL;
+  g_pendingtasks.tail = NULL;
+
+  return ret;
+}
+
+#elif !defined(CONFIG_SMP)
 bool nxsched_merge_pending(void)
 {
   FAR struct tcb_s *ptcb;
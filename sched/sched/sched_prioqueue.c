@@ -0,0 +1,201 @@
+/****************************************************************************
+ * sched/sched/sched_prioqueue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIOQUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One bit for each priority, 32 priorities in each bitmap word */
+
+#define PRIOQ_NWORDS        ((SCHED_PRIORITY_MAX >> 5) + 1)
+#define PRIOQ_WORD(p)       ((p) >> 5)
+#define PRIOQ_BIT(p)        ((uint32_t)1 << ((p) & 31))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The g_readytorun list is still the one list of ready-to-run tasks in
+ * descending priority order, so everything that walks it keeps working.
+ * What this adds is an index into it:  g_prioq_tail[p] is the last task of
+ * priority p in the list, valid when bit p of g_prioq_bitmap is set.  Bit w
+ * of g_prioq_summary is set when word w of the bitmap is not zero.  This
+ * finds the insertion point of a task without walking the list.
+ */
+
+static FAR struct tcb_s *g_prioq_tail[SCHED_PRIORITY_MAX + 1];
+static uint32_t g_prioq_bitmap[PRIOQ_NWORDS];
+static uint32_t g_prioq_summary;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_prioq_lowest
+ *
+ * Description:
+ *   Return the lowest priority that is not lower than 'priority' and that
+ *   has tasks in the ready-to-run list, or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static inline int nxsched_prioq_lowest(int priority)
+{
+  int word = PRIOQ_WORD(priority);
+  uint32_t bits;
+  uint32_t words;
+
+  bits = g_prioq_bitmap[word] & ~(PRIOQ_BIT(priority) - 1);
+  if (bits == 0)
+    {
+      /* Nothing left in this word.  Find the next word with any bit set. */
+
+      words = g_prioq_summary & ~(((uint32_t)2 << word) - 1);
+      if (words == 0)
+        {
+          return -1;
+        }
+
+      word = ffs((int)words) - 1;
+      bits = g_prioq_bitmap[word];
+    }
+
+  return (word << 5) + ffs((int)bits) - 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_prioq_add
+ *
+ * Description:
+ *   Add a TCB to the g_readytorun list behind all tasks of the same or
+ *   higher priority.  This is the constant-time equivalent of
+ *   nxsched_add_prioritized() for that list.
+ *
+ * Input Parameters:
+ *   tcb - Points to the TCB to add
+ *
+ * Returned Value:
+ *   true if the TCB was added at the head of the list.
+ *
+ * Assumptions:
+ * - Called within a critical section.
+ * - The caller sets the task_state field of the TCB.
+ *
+ ****************************************************************************/
+
+bool nxsched_prioq_add(FAR struct tcb_s *tcb)
+{
+  int priority = tcb->sched_priority;
+  int prev;
+
+  DEBUGASSERT(priority >= SCHED_PRIORITY_MIN &&
+              priority <= SCHED_PRIORITY_MAX);
+
+  prev = nxsched_prioq_lowest(priority);
+  if (prev < 0)
+    {
+      /* Every task in the list has a lower priority */
+
+      dq_addfirst((FAR dq_entry_t *)tcb, (FAR dq_queue_t *)&g_readytorun);
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)g_prioq_tail[prev],
+                  (FAR dq_entry_t *)tcb, (FAR dq_queue_t *)&g_readytorun);
+    }
+
+  g_prioq_tail[priority] = tcb;
+  g_prioq_bitmap[PRIOQ_WORD(priority)] |= PRIOQ_BIT(priority);
+  g_prioq_summary |= PRIOQ_BIT(PRIOQ_WORD(priority));
+
+  return prev < 0;
+}
+
+/****************************************************************************
+ * Name: nxsched_prioq_remove
+ *
+ * Description:
+ *   Remove a TCB from the g_readytorun list.
+ *
+ * Input Parameters:
+ *   tcb - Points to the TCB to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ * - Called within a critical section.
+ * - The priority of the TCB has not changed since it was added.
+ *
+ ****************************************************************************/
+
+void nxsched_prioq_remove(FAR struct tcb_s *tcb)
+{
+  int priority = tcb->sched_priority;
+  int word = PRIOQ_WORD(priority);
+  FAR struct tcb_s *prev;
+
+  if (g_prioq_tail[priority] == tcb)
+    {
+      /* The task before it becomes the last of this priority, if it has the
+       * same priority.  Otherwise, this priority is now empty.
+       */
+
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == priority)
+        {
+          g_prioq_tail[priority] = prev;
+        }
+      else
+        {
+          g_prioq_tail[priority] = NULL;
+          g_prioq_bitmap[word] &= ~PRIOQ_BIT(priority);
+          if (g_prioq_bitmap[word] == 0)
+            {
+              g_prioq_summary &= ~PRIOQ_BIT(word);
+            }
+        }
+    }
+
+  dq_rem((FAR dq_entry_t *)tcb, (FAR dq_queue_t *)&g_readytorun);
+}
+
+#endif /* CONFIG_SCHED_PRIOQUEUE */
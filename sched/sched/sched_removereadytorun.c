@@ -102,7 +102,11 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+#ifdef CONFIG_SCHED_PRIOQUEUE
+  nxsched_prioq_remove(rtcb);
+#else
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
+#endif
 
   /* Since the TCB is not in any list, it is now invalid */
 
@@ -149,9 +149,19 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
+#ifdef CONFIG_SCHED_PRIOQUEUE
+      /* The task stays at the head of the list, but it must be filed under
+       * its new priority.
+       */
+
+      nxsched_prioq_remove(tcb);
+      tcb->sched_priority = (uint8_t)sched_priority;
+      nxsched_prioq_add(tcb);
+#else
       /* Change the task priority */
 
       tcb->sched_priority = (uint8_t)sched_priority;
+#endif
     }
 }
 
@@ -45,6 +45,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/sched_note.h>
+#include <nuttx/tls.h>
 
 /****************************************************************************
  * Public Functions
@@ -71,6 +72,17 @@ int task_activate(FAR struct tcb_s *tcb)
 {
   irqstate_t flags = enter_critical_section();
 
+#ifdef CONFIG_TLS_ALIGNED
+  /* Cache the thread ID in the TLS area so that the C library can get it
+   * without a system call.
+   */
+
+  if (tcb->stack_alloc_ptr != NULL)
+    {
+      ((FAR struct tls_info_s *)tcb->stack_alloc_ptr)->tl_pid = tcb->pid;
+    }
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION
 
   /* Check if this is really a re-start */
@@ -140,7 +140,17 @@ int task_restart(pid_t pid)
   tasklist = TLIST_HEAD(tcb->cmn.task_state);
 #endif
 
-  dq_rem((FAR dq_entry_t *)tcb, tasklist);
+#ifdef CONFIG_SCHED_PRIOQUEUE
+  if (tasklist == (FAR dq_queue_t *)&g_readytorun)
+    {
+      nxsched_prioq_remove((FAR struct tcb_s *)tcb);
+    }
+  else
+#endif
+    {
+      dq_rem((FAR dq_entry_t *)tcb, tasklist);
+    }
+
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
 
   /* Deallocate anything left in the TCB's signal queues */
@@ -77,18 +77,13 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   flags = enter_critical_section();
   if (work->worker != NULL)
     {
-      /* A little test of the integrity of the work queue */
-
-      DEBUGASSERT(work->dq.flink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.tail);
-      DEBUGASSERT(work->dq.blink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.head);
-
       /* Remove the entry from the work queue and make sure that it is
-       * marked as available (i.e., the worker field is nullified).
+       * marked as available (i.e., the worker field is nullified).  If it
+       * was the first delayed work, the timer of the work queue is left
+       * to expire with nothing to do.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      work_dequeue(wqueue, work);
       work->worker = NULL;
       ret = OK;
     }
@@ -101,6 +96,44 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_dequeue
+ *
+ * Description:
+ *   Remove queued work from whichever list of the work queue holds it.
+ *   Only delayed work has a non-zero delay.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue that holds the work
+ *   work   - The queued work
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void work_dequeue(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work)
+{
+  if (work->delay > 0)
+    {
+      dq_rem((FAR dq_entry_t *)work, &wqueue->delayed);
+#ifdef CONFIG_WQUEUE_STATISTICS
+      wqueue->stats.ndelayed--;
+#endif
+    }
+  else
+    {
+      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+#ifdef CONFIG_WQUEUE_STATISTICS
+      wqueue->stats.nready--;
+#endif
+    }
+}
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -124,27 +157,15 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
 
 int work_cancel(int qid, FAR struct work_s *work)
 {
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
-    {
-      /* Cancel high priority work */
+  FAR struct kwork_wqueue_s *wqueue;
 
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_hpwork, work);
-    }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
-    {
-      /* Cancel low priority work */
-
-      return work_qcancel((FAR struct kwork_wqueue_s *)&g_lpwork, work);
-    }
-  else
-#endif
+  wqueue = work_qid2wq(qid);
+  if (wqueue == NULL)
     {
       return -EINVAL;
     }
+
+  return work_qcancel(wqueue, work);
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
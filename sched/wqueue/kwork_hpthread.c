@@ -32,9 +32,11 @@
 #include <debug.h>
 
 #include <nuttx/wqueue.h>
+#include <nuttx/sched.h>
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 
 #include "wqueue/wqueue.h"
 
@@ -131,6 +133,9 @@ static int work_hpthread(int argc, char *argv[])
 
 int work_start_highpri(void)
 {
+#ifdef CONFIG_SCHED_HPWORK_AFFINITY
+  cpu_set_t cpuset;
+#endif
   pid_t pid;
   int wndx;
 
@@ -140,6 +145,10 @@ int work_start_highpri(void)
 
   sched_lock();
 
+  /* The timer of the work queue is part of g_hpwork and is never freed */
+
+  wd_static(&g_hpwork.timer);
+
   /* Start the high-priority, kernel mode worker thread(s) */
 
   sinfo("Starting high-priority kernel worker thread(s)\n");
@@ -161,6 +170,16 @@ int work_start_highpri(void)
 
       g_hpwork.worker[wndx].pid  = pid;
       g_hpwork.worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_HPWORK_AFFINITY
+      /* Bind the worker thread to one CPU.  work_signal() prefers the
+       * idle worker of the CPU that queued the work.
+       */
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(wndx % CONFIG_SMP_NCPUS, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
     }
 
   sched_unlock();
@@ -35,6 +35,7 @@
 #include <nuttx/kthread.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 
 #include "wqueue/wqueue.h"
 
@@ -140,6 +141,10 @@ int work_start_lowpri(void)
 
   sched_lock();
 
+  /* The timer of the work queue is part of g_lpwork and is never freed */
+
+  wd_static(&g_lpwork.timer);
+
   /* Start the low-priority, kernel mode worker thread(s) */
 
   sinfo("Starting low-priority kernel worker thread(s)\n");
@@ -32,89 +32,266 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void work_timer_expiry(int argc, wdparm_t arg1, ...);
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_qqueue
+ * Name: work_ready
  *
  * Description:
- *   Queue work to be performed at a later time.  All queued work will be
- *   performed on the worker thread of execution (not the caller's).
+ *   Add work to the queue of ready work, in order of deadline.  Work with
+ *   equal deadlines is performed in the order that it became ready.
  *
- *   The work structure is allocated by caller, but completely managed by
- *   the work queue logic.  The caller should never modify the contents of
- *   the work queue structure; the caller should not call work_qqueue()
- *   again until either (1) the previous work has been performed and removed
- *   from the queue, or (2) work_cancel() has been called to cancel the work
- *   and remove it from the work queue.
+ * Assumptions:
+ *   Called in a critical section.
  *
- * Input Parameters:
- *   qid    - The work queue ID (index)
- *   work   - The work structure to queue
- *   worker - The worker callback to be invoked.  The callback will invoked
- *            on the worker thread of execution.
- *   arg    - The argument that will be passed to the workder callback when
- *            int is invoked.
- *   delay  - Delay (in clock ticks) from the time queue until the worker
- *            is invoked. Zero means to perform the work immediately.
+ ****************************************************************************/
+
+static void work_ready(FAR struct kwork_wqueue_s *wqueue,
+                       FAR struct work_s *work)
+{
+  FAR struct work_s *prev;
+
+  /* New work usually has the latest deadline, so search from the tail */
+
+  prev = (FAR struct work_s *)wqueue->q.tail;
+  while (prev != NULL && (sclock_t)(work->deadline - prev->deadline) < 0)
+    {
+      prev = (FAR struct work_s *)prev->dq.blink;
+    }
+
+  if (prev == NULL)
+    {
+      dq_addfirst((FAR dq_entry_t *)work, &wqueue->q);
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+                  &wqueue->q);
+    }
+
+#ifdef CONFIG_WQUEUE_STATISTICS
+  if (++wqueue->stats.nready > wqueue->stats.maxready)
+    {
+      wqueue->stats.maxready = wqueue->stats.nready;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: work_delayed
+ *
+ * Description:
+ *   Add work to the queue of delayed work, in order of the time when it is
+ *   due.
  *
  * Returned Value:
- *   None
+ *   true if the work is now the first delayed work to become due.
+ *
+ * Assumptions:
+ *   Called in a critical section.
  *
  ****************************************************************************/
 
-static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
-                        FAR struct work_s *work, worker_t worker,
-                        FAR void *arg, clock_t delay)
+static bool work_delayed(FAR struct kwork_wqueue_s *wqueue,
+                         FAR struct work_s *work)
 {
-  irqstate_t flags;
+  FAR struct work_s *prev;
+  clock_t due = work->qtime + work->delay;
 
-  DEBUGASSERT(work != NULL && worker != NULL);
+  prev = (FAR struct work_s *)wqueue->delayed.tail;
+  while (prev != NULL &&
+         (sclock_t)(due - (prev->qtime + prev->delay)) < 0)
+    {
+      prev = (FAR struct work_s *)prev->dq.blink;
+    }
 
-  /* Interrupts are disabled so that this logic can be called from with
-   * task logic or ifrom nterrupt handling logic.
-   */
+  if (prev == NULL)
+    {
+      dq_addfirst((FAR dq_entry_t *)work, &wqueue->delayed);
+    }
+  else
+    {
+      dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+                  &wqueue->delayed);
+    }
 
-  flags = enter_critical_section();
+#ifdef CONFIG_WQUEUE_STATISTICS
+  wqueue->stats.ndelayed++;
+#endif
 
-  /* Is there already pending work? */
+  return prev == NULL;
+}
 
-  if (work->worker != NULL)
+/****************************************************************************
+ * Name: work_timer_start
+ *
+ * Description:
+ *   Start the timer of the work queue so that it expires when the first
+ *   delayed work is due.
+ *
+ * Assumptions:
+ *   Called in a critical section.  The delayed work queue is not empty and
+ *   its first work is not yet due.
+ *
+ ****************************************************************************/
+
+static void work_timer_start(FAR struct kwork_wqueue_s *wqueue, int qid,
+                             clock_t now)
+{
+  FAR struct work_s *work = (FAR struct work_s *)wqueue->delayed.head;
+  clock_t remaining;
+
+  remaining = work->delay - (now - work->qtime);
+  if (remaining > INT32_MAX)
+    {
+      /* Too long for the timer.  It will be started again on expiry. */
+
+      remaining = INT32_MAX;
+    }
+
+  wd_start(&wqueue->timer, (int32_t)remaining, work_timer_expiry, 1,
+           (wdparm_t)qid);
+}
+
+/****************************************************************************
+ * Name: work_timer_update
+ *
+ * Description:
+ *   Move all delayed work that is due to the queue of ready work and start
+ *   the timer again for the rest.
+ *
+ * Returned Value:
+ *   true if any work was made ready.
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static bool work_timer_update(FAR struct kwork_wqueue_s *wqueue, int qid)
+{
+  FAR struct work_s *work;
+  clock_t now = clock_systime_ticks();
+  bool ready = false;
+
+  while ((work = (FAR struct work_s *)wqueue->delayed.head) != NULL &&
+         now - work->qtime >= work->delay)
     {
-      /* Remove the entry from the work queue.  It will re requeued at the
-       * end of the work queue.
+      dq_remfirst(&wqueue->delayed);
+
+#ifdef CONFIG_WQUEUE_STATISTICS
+      wqueue->stats.ndelayed--;
+#endif
+
+      /* From now on the work is treated as if it had been queued without
+       * a delay at the time when it became due.
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      work->qtime += work->delay;
+      work->delay  = 0;
+
+      work_ready(wqueue, work);
+      ready = true;
     }
 
-  /* Initialize the work structure. */
+  if (work != NULL)
+    {
+      work_timer_start(wqueue, qid, now);
+    }
 
-  work->worker = worker;           /* Work callback. non-NULL means queued */
-  work->arg    = arg;              /* Callback argument */
-  work->delay  = delay;            /* Delay until work performed */
+  return ready;
+}
 
-  /* Now, time-tag that entry and put it in the work queue */
+/****************************************************************************
+ * Name: work_timer_expiry
+ *
+ * Description:
+ *   The timer of a work queue has expired.  Make the delayed work that is
+ *   due ready and wake up a worker thread to perform it.
+ *
+ *   The timer is not stopped when delayed work is cancelled, so there may
+ *   be nothing to do here.
+ *
+ * Input Parameters:
+ *   argc - The number of arguments (one)
+ *   arg1 - The work queue ID
+ *
+ ****************************************************************************/
 
-  work->qtime  = clock_systime_ticks(); /* Time work queued */
+static void work_timer_expiry(int argc, wdparm_t arg1, ...)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+  bool ready;
+  int qid = (int)arg1;
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  wqueue = work_qid2wq(qid);
+  DEBUGASSERT(wqueue != NULL);
 
+  flags = enter_critical_section();
+  ready = work_timer_update(wqueue, qid);
   leave_critical_section(flags);
+
+  if (ready)
+    {
+      work_signal(qid);
+    }
 }
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_qid2wq
+ *
+ * Description:
+ *   Return the kernel work queue with the given ID.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID
+ *
+ * Returned Value:
+ *   The work queue or NULL if the ID is not valid.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_qid2wq(int qid)
+{
+#ifdef CONFIG_SCHED_HPWORK
+  if (qid == HPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_hpwork;
+    }
+  else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+  if (qid == LPWORK)
+    {
+      return (FAR struct kwork_wqueue_s *)&g_lpwork;
+    }
+  else
+#endif
+    {
+      return NULL;
+    }
+}
+
 /****************************************************************************
  * Name: work_queue
  *
@@ -148,33 +325,103 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, clock_t delay)
 {
-  /* Queue the new work */
+  return work_queue_deadline(qid, work, worker, arg, delay, 0);
+}
 
-#ifdef CONFIG_SCHED_HPWORK
-  if (qid == HPWORK)
+/****************************************************************************
+ * Name: work_queue_deadline
+ *
+ * Description:
+ *   Queue kernel-mode work like work_queue(), but allow it to wait up to
+ *   'slack' clock ticks after its delay has expired.  Ready work is
+ *   performed in order of deadline.
+ *
+ *   Work with a delay is kept apart from the ready work, in order of the
+ *   time when it is due, and the timer of the work queue moves it to the
+ *   ready work at that time.  The worker threads never look at delayed
+ *   work.
+ *
+ * Input Parameters:
+ *   qid    - The work queue ID (index)
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the workder callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *   slack  - How long (in clock ticks) the work may wait once it is ready.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_queue_deadline(int qid, FAR struct work_s *work, worker_t worker,
+                        FAR void *arg, clock_t delay, clock_t slack)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+
+  wqueue = work_qid2wq(qid);
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  DEBUGASSERT(work != NULL && worker != NULL);
+
+  /* Interrupts are disabled so that this logic can be called from with
+   * task logic or from interrupt handling logic.
+   */
+
+  flags = enter_critical_section();
+
+  /* Is there already pending work? */
+
+  if (work->worker != NULL)
     {
-      /* Queue high priority work */
+      /* Remove the entry from the work queue.  It will be requeued with
+       * its new parameters.
+       */
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_hpwork, work, worker,
-                  arg, delay);
-      return work_signal(HPWORK);
+      work_dequeue(wqueue, work);
     }
-  else
-#endif
-#ifdef CONFIG_SCHED_LPWORK
-  if (qid == LPWORK)
+
+  /* Initialize the work structure. */
+
+  work->worker = worker;           /* Work callback. non-NULL means queued */
+  work->arg    = arg;              /* Callback argument */
+  work->delay  = delay;            /* Delay until work performed */
+
+  /* Now, time-tag that entry and set the time by which it should be
+   * performed.
+   */
+
+  work->qtime    = clock_systime_ticks();
+  work->deadline = work->qtime + delay + slack;
+
+  if (delay == 0)
     {
-      /* Queue low priority work */
+      work_ready(wqueue, work);
+      leave_critical_section(flags);
 
-      work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker,
-                  arg, delay);
-      return work_signal(LPWORK);
+      /* Wake up a worker thread to perform it */
+
+      return work_signal(qid);
     }
-  else
-#endif
+
+  /* Delayed work needs the timer started again if it is now the first to
+   * become due.
+   */
+
+  if (work_delayed(wqueue, work))
     {
-      return -EINVAL;
+      work_timer_start(wqueue, qid, work->qtime);
     }
+
+  leave_critical_section(flags);
+  return OK;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
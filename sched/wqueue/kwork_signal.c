@@ -27,6 +27,7 @@
 #include <signal.h>
 #include <errno.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/signal.h>
 
@@ -82,6 +83,24 @@ int work_signal(int qid)
       return -EINVAL;
     }
 
+#ifdef CONFIG_SCHED_HPWORK_AFFINITY
+  /* High priority worker thread i is bound to CPU i % CONFIG_SMP_NCPUS.
+   * Prefer an IDLE worker of this CPU, which shares its cache with the
+   * logic that queued the work.
+   */
+
+  if (qid == HPWORK)
+    {
+      for (i = up_cpu_index(); i < threads; i += CONFIG_SMP_NCPUS)
+        {
+          if (!work->worker[i].busy)
+            {
+              return nxsig_kill(work->worker[i].pid, SIGWORK);
+            }
+        }
+    }
+#endif
+
   /* Find an IDLE worker thread */
 
   for (i = 0; i < threads; i++)
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * sched/wqueue/kwork_stats.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+
+#include "wqueue/wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_WQUEUE_STATISTICS)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Get the depth and latency statistics of a kernel work queue.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_getstats(int qid, FAR struct work_stats_s *stats)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  wqueue = work_qid2wq(qid);
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  memcpy(stats, &wqueue->stats, sizeof(struct work_stats_s));
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: work_resetstats
+ *
+ * Description:
+ *   Clear the high-water mark and the latency statistics of a kernel work
+ *   queue.  The current depths are kept.
+ *
+ * Input Parameters:
+ *   qid   - The work queue ID
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+int work_resetstats(int qid)
+{
+  FAR struct kwork_wqueue_s *wqueue;
+  irqstate_t flags;
+
+  wqueue = work_qid2wq(qid);
+  if (wqueue == NULL)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+  wqueue->stats.maxready   = wqueue->stats.nready;
+  wqueue->stats.nprocessed = 0;
+  wqueue->stats.maxlatency = 0;
+  wqueue->stats.totlatency = 0;
+  leave_critical_section(flags);
+  return OK;
+}
+
+#endif /* CONFIG_SCHED_WORKQUEUE && CONFIG_WQUEUE_STATISTICS */
@@ -31,6 +31,8 @@
 #include <queue.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/wdog.h>
+#include <nuttx/wqueue.h>
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
@@ -59,7 +61,12 @@ struct kworker_s
 
 struct kwork_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work, by deadline */
+  struct dq_queue_s delayed;   /* The queue of delayed work, by due time */
+  struct wdog_s     timer;     /* Fires when the first delayed work is due */
+#ifdef CONFIG_WQUEUE_STATISTICS
+  struct work_stats_s stats;   /* Depth and latency statistics */
+#endif
   struct kworker_s  worker[1]; /* Describes a worker thread */
 };
 
@@ -70,7 +77,12 @@ struct kwork_wqueue_s
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s
 {
-  struct dq_queue_s q;         /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work, by deadline */
+  struct dq_queue_s delayed;   /* The queue of delayed work, by due time */
+  struct wdog_s     timer;     /* Fires when the first delayed work is due */
+#ifdef CONFIG_WQUEUE_STATISTICS
+  struct work_stats_s stats;   /* Depth and latency statistics */
+#endif
 
   /* Describes each thread in the high priority queue's thread pool */
 
@@ -85,7 +97,12 @@ struct hp_wqueue_s
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s
 {
-  struct dq_queue_s q;      /* The queue of pending work */
+  struct dq_queue_s q;         /* The queue of ready work, by deadline */
+  struct dq_queue_s delayed;   /* The queue of delayed work, by due time */
+  struct wdog_s     timer;     /* Fires when the first delayed work is due */
+#ifdef CONFIG_WQUEUE_STATISTICS
+  struct work_stats_s stats;   /* Depth and latency statistics */
+#endif
 
   /* Describes each thread in the low priority queue's thread pool */
 
@@ -171,6 +188,43 @@ int work_start_lowpri(void);
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx);
 
+/****************************************************************************
+ * Name: work_qid2wq
+ *
+ * Description:
+ *   Return the kernel work queue with the given ID.
+ *
+ * Input Parameters:
+ *   qid - The work queue ID
+ *
+ * Returned Value:
+ *   The work queue or NULL if the ID is not valid.
+ *
+ ****************************************************************************/
+
+FAR struct kwork_wqueue_s *work_qid2wq(int qid);
+
+/****************************************************************************
+ * Name: work_dequeue
+ *
+ * Description:
+ *   Remove queued work from whichever list of the work queue holds it.
+ *
+ * Input Parameters:
+ *   wqueue - The work queue that holds the work
+ *   work   - The queued work
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+void work_dequeue(FAR struct kwork_wqueue_s *wqueue,
+                  FAR struct work_s *work);
+
 /****************************************************************************
  * Name: work_initialize_notifier
  *